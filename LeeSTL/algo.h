@@ -5,8 +5,1210 @@
 #ifndef _LEESTL_ALGO_H_
 #define _LEESTL_ALGO_H_
 
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <new>
+
 #include "algobase.h"
+#include "allocator.h"
+#include "uninitialized.h"
+
+namespace leestl {
+
+	// 默认的比较仿函数，使用 operator<
+	struct _iter_less {
+		template <typename T, typename U>
+		constexpr bool operator()(const T &a, const U &b) const {
+			return a < b;
+		}
+	};
+
+	// 比较仿函数是否为不会产生副作用的默认比较（operator< 或 operator>）
+	template <typename Compare, typename T>
+	struct _is_default_compare : std::false_type {};
+	template <typename T>
+	struct _is_default_compare<_iter_less, T> : std::true_type {};
+	template <typename T>
+	struct _is_default_compare<std::less<T>, T> : std::true_type {};
+	template <typename T>
+	struct _is_default_compare<std::greater<T>, T> : std::true_type {};
+	template <typename T>
+	struct _is_default_compare<std::less<>, T> : std::true_type {};
+	template <typename T>
+	struct _is_default_compare<std::greater<>, T> : std::true_type {};
+
+	// 算术类型配合默认比较时，比较没有副作用且结果可以无分支地计算，此时使用无分支块划分
+	template <typename _RI, typename Compare>
+	using _use_branchless_partition = std::integral_constant<
+	    bool, std::is_arithmetic<typename iterator_traits<_RI>::value_type>::value &&
+	              _is_default_compare<Compare, typename iterator_traits<_RI>::value_type>::value>;
+
+	// 以 2 为底的对数，向下取整，n 必须大于 0
+	inline int _lg(size_t n) { return int(sizeof(size_t) * 8 - 1) - __builtin_clzl(n); }
+
+	// 交换两个迭代器所指的对象
+	template <typename _FI1, typename _FI2>
+	inline void _iter_swap(_FI1 a, _FI2 b) {
+		leestl::swap(*a, *b);
+	}
+
+	/*---------------------------------------- 查找与计数 ----------------------------------------*/
+
+	// 能否按字节模式查找：数组元素为 1、2、4、8 字节的整数、枚举或指针，查找值为整数
+	// （元素为整数时）或与元素类型相同
+	template <typename _II, typename T>
+	struct _is_pattern_searchable : std::false_type {};
+
+	template <typename U, typename T>
+	struct _is_pattern_searchable<U *, T>
+	        : std::integral_constant<
+	              bool, _is_bytewise_comparable<U *, U *>::value &&
+	                        (sizeof(U) == 1 || sizeof(U) == 2 || sizeof(U) == 4 ||
+	                         sizeof(U) == 8) &&
+	                        (std::is_same_v<std::remove_cv_t<U>, T> ||
+	                         (std::is_integral_v<U> && std::is_integral_v<T>))> {};
+
+	// 逐个比较的 find 实现
+	template <typename _II, typename T>
+	inline _II _find(_II first, _II last, const T &value, std::false_type) {
+		while (first != last && !(*first == value)) ++first;
+		return first;
+	}
+
+	// 针对整数、枚举、指针数组的 find 实现，使用 memchr 或 SIMD 内核
+	template <typename U, typename T>
+	inline U *_find(U *first, U *last, const T &value, std::true_type) {
+		const std::remove_cv_t<U> v = static_cast<std::remove_cv_t<U>>(value);
+		// 转换后取值改变时，数组中不可能有与 value 相等的元素
+		if (!(static_cast<T>(v) == value)) return last;
+		return first + leestl::simd::find_pattern(first, last - first, &v, sizeof(U));
+	}
+
+	/**
+	 * @brief 查找 [first, last) 中第一个等于 value 的元素
+	 *
+	 * @tparam _II 迭代器类型
+	 * @tparam T 查找值的类型
+	 * @param first 起始位置
+	 * @param last 终止位置
+	 * @param value 查找值
+	 * @return _II 该元素的位置，不存在时为 last
+	 */
+	template <typename _II, typename T>
+	inline _II find(_II first, _II last, const T &value) {
+		return leestl::_find(first, last, value, _is_pattern_searchable<_II, T>());
+	}
+
+	/**
+	 * @brief 查找 [first, last) 中第一个满足 pred 的元素
+	 *
+	 * @tparam Predicate 一元谓词
+	 * @param first 起始位置
+	 * @param last 终止位置
+	 * @param pred 一元谓词
+	 * @return _II 该元素的位置，不存在时为 last
+	 */
+	template <typename _II, typename Predicate>
+	inline _II find_if(_II first, _II last, Predicate pred) {
+		while (first != last && !pred(*first)) ++first;
+		return first;
+	}
+
+	// 逐个比较的 count 实现
+	template <typename _II, typename T>
+	inline typename iterator_traits<_II>::difference_type _count(
+	    _II first, _II last, const T &value, std::false_type) {
+		typename iterator_traits<_II>::difference_type n = 0;
+		for (; first != last; ++first)
+			if (*first == value) ++n;
+		return n;
+	}
+
+	// 针对整数、枚举、指针数组的 count 实现，使用 SIMD 内核
+	template <typename U, typename T>
+	inline ptrdiff_t _count(U *first, U *last, const T &value, std::true_type) {
+		const std::remove_cv_t<U> v = static_cast<std::remove_cv_t<U>>(value);
+		if (!(static_cast<T>(v) == value)) return 0;
+		return ptrdiff_t(leestl::simd::count_pattern(first, last - first, &v, sizeof(U)));
+	}
+
+	/**
+	 * @brief 统计 [first, last) 中等于 value 的元素个数
+	 *
+	 * @tparam _II 迭代器类型
+	 * @tparam T 统计值的类型
+	 * @param first 起始位置
+	 * @param last 终止位置
+	 * @param value 统计值
+	 * @return difference_type 元素个数
+	 */
+	template <typename _II, typename T>
+	inline typename iterator_traits<_II>::difference_type count(
+	    _II first, _II last, const T &value) {
+		return leestl::_count(first, last, value, _is_pattern_searchable<_II, T>());
+	}
+
+	/**
+	 * @brief 统计 [first, last) 中满足 pred 的元素个数
+	 *
+	 * @tparam Predicate 一元谓词
+	 * @param first 起始位置
+	 * @param last 终止位置
+	 * @param pred 一元谓词
+	 * @return difference_type 元素个数
+	 */
+	template <typename _II, typename Predicate>
+	inline typename iterator_traits<_II>::difference_type count_if(
+	    _II first, _II last, Predicate pred) {
+		typename iterator_traits<_II>::difference_type n = 0;
+		for (; first != last; ++first)
+			if (pred(*first)) ++n;
+		return n;
+	}
+
+	/*-------------------------------------------- 堆 --------------------------------------------*/
+
+	// 从 hole 处开始把较大的子节点上移，再把 value 从叶子位置上浮，维持 [first, first + len) 的大顶堆
+	template <typename _RI, typename _Distance, typename T, typename Compare>
+	void _adjust_heap(_RI first, _Distance hole, _Distance len, T value, Compare comp) {
+		const _Distance top = hole;
+		_Distance       child = hole;
+		while (child < (len - 1) / 2) {
+			child = 2 * (child + 1);
+			if (comp(*(first + child), *(first + (child - 1)))) --child;
+			*(first + hole) = leestl::move(*(first + child));
+			hole = child;
+		}
+		if ((len & 1) == 0 && child == (len - 2) / 2) {
+			child = 2 * (child + 1);
+			*(first + hole) = leestl::move(*(first + (child - 1)));
+			hole = child - 1;
+		}
+		_Distance parent = (hole - 1) / 2;
+		while (hole > top && comp(*(first + parent), value)) {
+			*(first + hole) = leestl::move(*(first + parent));
+			hole = parent;
+			parent = (hole - 1) / 2;
+		}
+		*(first + hole) = leestl::move(value);
+	}
+
+	// 把 [first, last) 调整为大顶堆
+	template <typename _RI, typename Compare>
+	void _make_heap(_RI first, _RI last, Compare comp) {
+		typedef typename iterator_traits<_RI>::value_type      _Tp;
+		typedef typename iterator_traits<_RI>::difference_type _Distance;
+		const _Distance                                        len = last - first;
+		if (len < 2) return;
+		for (_Distance parent = (len - 2) / 2;; --parent) {
+			_Tp value = leestl::move(*(first + parent));
+			leestl::_adjust_heap(first, parent, len, leestl::move(value), comp);
+			if (parent == 0) return;
+		}
+	}
+
+	// 把堆顶移到 result，原 result 处的元素放入堆 [first, last) 中
+	template <typename _RI, typename Compare>
+	inline void _pop_heap(_RI first, _RI last, _RI result, Compare comp) {
+		typedef typename iterator_traits<_RI>::value_type      _Tp;
+		typedef typename iterator_traits<_RI>::difference_type _Distance;
+		_Tp value = leestl::move(*result);
+		*result = leestl::move(*first);
+		leestl::_adjust_heap(
+		    first, _Distance(0), _Distance(last - first), leestl::move(value), comp);
+	}
+
+	// 依次弹出堆顶，把堆 [first, last) 排为升序
+	template <typename _RI, typename Compare>
+	void _sort_heap(_RI first, _RI last, Compare comp) {
+		while (last - first > 1) {
+			--last;
+			leestl::_pop_heap(first, last, last, comp);
+		}
+	}
+
+	// 把 [first, last) 中最小的 middle - first 个元素以大顶堆的形式放到 [first, middle)
+	template <typename _RI, typename Compare>
+	void _heap_select(_RI first, _RI middle, _RI last, Compare comp) {
+		leestl::_make_heap(first, middle, comp);
+		for (_RI i = middle; i < last; ++i)
+			if (comp(*i, *first)) leestl::_pop_heap(first, middle, i, comp);
+	}
+
+	/*------------------------------------------ pdqsort -----------------------------------------*/
+
+	enum {
+		_INSERTION_SORT_THRESHOLD = 24,       // 小于该长度的区间使用插入排序
+		_NINTHER_THRESHOLD = 128,             // 大于该长度的区间使用 ninther 选择枢轴
+		_PARTIAL_INSERTION_SORT_LIMIT = 8,    // 试探性插入排序最多移动的元素个数
+		_PARTITION_BLOCK_SIZE = 64,           // 无分支划分每块的元素个数
+	};
+
+	// 插入排序
+	template <typename _RI, typename Compare>
+	void _insertion_sort(_RI first, _RI last, Compare comp) {
+		typedef typename iterator_traits<_RI>::value_type _Tp;
+		if (first == last) return;
+		for (_RI cur = first + 1; cur != last; ++cur) {
+			_RI sift = cur, sift_1 = cur - 1;
+			if (comp(*sift, *sift_1)) {
+				_Tp tmp = leestl::move(*sift);
+				do {
+					*sift-- = leestl::move(*sift_1);
+				} while (sift != first && comp(tmp, *--sift_1));
+				*sift = leestl::move(tmp);
+			}
+		}
+	}
+
+	// 无边界检查的插入排序，要求 first 之前存在不大于区间内任何元素的元素
+	template <typename _RI, typename Compare>
+	void _unguarded_insertion_sort(_RI first, _RI last, Compare comp) {
+		typedef typename iterator_traits<_RI>::value_type _Tp;
+		if (first == last) return;
+		for (_RI cur = first + 1; cur != last; ++cur) {
+			_RI sift = cur, sift_1 = cur - 1;
+			if (comp(*sift, *sift_1)) {
+				_Tp tmp = leestl::move(*sift);
+				do { *sift-- = leestl::move(*sift_1); } while (comp(tmp, *--sift_1));
+				*sift = leestl::move(tmp);
+			}
+		}
+	}
+
+	// 试探性插入排序，移动的元素超过 _PARTIAL_INSERTION_SORT_LIMIT 个时放弃并返回 false
+	template <typename _RI, typename Compare>
+	bool _partial_insertion_sort(_RI first, _RI last, Compare comp) {
+		typedef typename iterator_traits<_RI>::value_type _Tp;
+		if (first == last) return true;
+		size_t limit = 0;
+		for (_RI cur = first + 1; cur != last; ++cur) {
+			_RI sift = cur, sift_1 = cur - 1;
+			if (comp(*sift, *sift_1)) {
+				_Tp tmp = leestl::move(*sift);
+				do {
+					*sift-- = leestl::move(*sift_1);
+				} while (sift != first && comp(tmp, *--sift_1));
+				*sift = leestl::move(tmp);
+				limit += cur - sift;
+			}
+			if (limit > _PARTIAL_INSERTION_SORT_LIMIT) return false;
+		}
+		return true;
+	}
+
+	template <typename _RI, typename Compare>
+	inline void _sort2(_RI a, _RI b, Compare comp) {
+		if (comp(*b, *a)) leestl::_iter_swap(a, b);
+	}
+
+	// 排序三个元素，结束后 *b 为三者的中位数
+	template <typename _RI, typename Compare>
+	inline void _sort3(_RI a, _RI b, _RI c, Compare comp) {
+		leestl::_sort2(a, b, comp);
+		leestl::_sort2(b, c, comp);
+		leestl::_sort2(a, b, comp);
+	}
+
+	// 按两个偏移数组交换左右两块中位置错误的元素，元素个数不同时用循环移动代替交换
+	template <typename _RI>
+	inline void _swap_offsets(
+	    _RI first, _RI last, unsigned char *offsets_l, unsigned char *offsets_r, size_t num,
+	    bool use_swaps) {
+		typedef typename iterator_traits<_RI>::value_type _Tp;
+		if (use_swaps) {
+			// 左右个数相同时需要整对交换，避免两端的元素重合
+			for (size_t i = 0; i < num; ++i)
+				leestl::_iter_swap(first + offsets_l[i], last - offsets_r[i]);
+		} else if (num > 0) {
+			_RI l = first + offsets_l[0], r = last - offsets_r[0];
+			_Tp tmp(leestl::move(*l));
+			*l = leestl::move(*r);
+			for (size_t i = 1; i < num; ++i) {
+				l = first + offsets_l[i];
+				*r = leestl::move(*l);
+				r = last - offsets_r[i];
+				*l = leestl::move(*r);
+			}
+			*r = leestl::move(tmp);
+		}
+	}
+
+	/**
+	 * @brief 以 *first 为枢轴划分 [first, last)，小于枢轴的元素在左，不小于的在右。
+	 * 	按块扫描，比较结果只用于累加偏移数组的下标，循环内没有依赖比较结果的分支
+	 *
+	 * @return 枢轴的最终位置，以及划分前区间是否已经有序划分
+	 */
+	template <typename _RI, typename Compare>
+	std::pair<_RI, bool> _partition_right(_RI begin, _RI end, Compare comp, std::true_type) {
+		typedef typename iterator_traits<_RI>::value_type _Tp;
+		_Tp pivot(leestl::move(*begin));
+		_RI first = begin, last = end;
+
+		// 选择枢轴时保证了右侧存在不小于枢轴的元素，向右查找无需边界检查
+		while (comp(*++first, pivot));
+		if (first - 1 == begin) while (first < last && !comp(*--last, pivot));
+		else while (!comp(*--last, pivot));
+
+		const bool already_partitioned = first >= last;
+		if (!already_partitioned) {
+			leestl::_iter_swap(first, last);
+			++first;
+
+			alignas(64) unsigned char offsets_l[_PARTITION_BLOCK_SIZE];
+			alignas(64) unsigned char offsets_r[_PARTITION_BLOCK_SIZE];
+			_RI    offsets_l_base = first, offsets_r_base = last;
+			size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+			while (first < last) {
+				// 决定本轮两侧各扫描多少元素
+				const size_t num_unknown = last - first;
+				const size_t left_split =
+				    num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+				const size_t right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+
+				// 记录左侧不小于枢轴、右侧小于枢轴的元素的偏移
+				if (left_split >= _PARTITION_BLOCK_SIZE) {
+					for (size_t i = 0; i < _PARTITION_BLOCK_SIZE;) {
+						for (int k = 0; k < 8; ++k) {
+							offsets_l[num_l] = (unsigned char)i++;
+							num_l += !comp(*first, pivot);
+							++first;
+						}
+					}
+				} else {
+					for (size_t i = 0; i < left_split;) {
+						offsets_l[num_l] = (unsigned char)i++;
+						num_l += !comp(*first, pivot);
+						++first;
+					}
+				}
+				if (right_split >= _PARTITION_BLOCK_SIZE) {
+					for (size_t i = 0; i < _PARTITION_BLOCK_SIZE;) {
+						for (int k = 0; k < 8; ++k) {
+							offsets_r[num_r] = (unsigned char)++i;
+							num_r += comp(*--last, pivot);
+						}
+					}
+				} else {
+					for (size_t i = 0; i < right_split;) {
+						offsets_r[num_r] = (unsigned char)++i;
+						num_r += comp(*--last, pivot);
+					}
+				}
+
+				// 交换两侧位置错误的元素
+				const size_t num = leestl::min(num_l, num_r);
+				leestl::_swap_offsets(
+				    offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r, num,
+				    num_l == num_r);
+				num_l -= num;
+				num_r -= num;
+				start_l += num;
+				start_r += num;
+				if (num_l == 0) {
+					start_l = 0;
+					offsets_l_base = first;
+				}
+				if (num_r == 0) {
+					start_r = 0;
+					offsets_r_base = last;
+				}
+			}
+
+			// 一侧还有剩余偏移时，把这些元素逐个交换到中间
+			if (num_l) {
+				unsigned char *offsets = offsets_l + start_l;
+				while (num_l--) leestl::_iter_swap(offsets_l_base + offsets[num_l], --last);
+				first = last;
+			}
+			if (num_r) {
+				unsigned char *offsets = offsets_r + start_r;
+				while (num_r--) leestl::_iter_swap(offsets_r_base - offsets[num_r], first), ++first;
+				last = first;
+			}
+		}
+
+		_RI pivot_pos = first - 1;
+		*begin = leestl::move(*pivot_pos);
+		*pivot_pos = leestl::move(pivot);
+		return std::pair<_RI, bool>(pivot_pos, already_partitioned);
+	}
+
+	// 比较开销大或有副作用时使用的分支版本划分，语义同上
+	template <typename _RI, typename Compare>
+	std::pair<_RI, bool> _partition_right(_RI begin, _RI end, Compare comp, std::false_type) {
+		typedef typename iterator_traits<_RI>::value_type _Tp;
+		_Tp pivot(leestl::move(*begin));
+		_RI first = begin, last = end;
+
+		while (comp(*++first, pivot));
+		if (first - 1 == begin) while (first < last && !comp(*--last, pivot));
+		else while (!comp(*--last, pivot));
+
+		const bool already_partitioned = first >= last;
+		while (first < last) {
+			leestl::_iter_swap(first, last);
+			while (comp(*++first, pivot));
+			while (!comp(*--last, pivot));
+		}
+
+		_RI pivot_pos = first - 1;
+		*begin = leestl::move(*pivot_pos);
+		*pivot_pos = leestl::move(pivot);
+		return std::pair<_RI, bool>(pivot_pos, already_partitioned);
+	}
+
+	/**
+	 * @brief 以 *first 为枢轴划分 [first, last)，等于枢轴的元素在左，大于的在右。
+	 * 	用于枢轴等于左侧相邻区间中的元素时，一次把所有相等元素排除在后续排序之外
+	 *
+	 * @return _RI 枢轴的最终位置
+	 */
+	template <typename _RI, typename Compare>
+	_RI _partition_left(_RI begin, _RI end, Compare comp) {
+		typedef typename iterator_traits<_RI>::value_type _Tp;
+		_Tp pivot(leestl::move(*begin));
+		_RI first = begin, last = end;
+
+		while (comp(pivot, *--last));
+		if (last + 1 == end) while (first < last && !comp(pivot, *++first));
+		else while (!comp(pivot, *++first));
+
+		while (first < last) {
+			leestl::_iter_swap(first, last);
+			while (comp(pivot, *--last));
+			while (!comp(pivot, *++first));
+		}
+
+		_RI pivot_pos = last;
+		*begin = leestl::move(*pivot_pos);
+		*pivot_pos = leestl::move(pivot);
+		return pivot_pos;
+	}
+
+	// 选择枢轴并放到 *begin：长区间取 ninther（三组三数中值的中值），短区间取三数中值
+	template <typename _RI, typename Compare>
+	inline void _choose_pivot(_RI begin, _RI end, Compare comp) {
+		typedef typename iterator_traits<_RI>::difference_type _Distance;
+		const _Distance                                        size = end - begin, s2 = size / 2;
+		if (size > _NINTHER_THRESHOLD) {
+			leestl::_sort3(begin, begin + s2, end - 1, comp);
+			leestl::_sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+			leestl::_sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+			leestl::_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+			leestl::_iter_swap(begin, begin + s2);
+		} else {
+			leestl::_sort3(begin + s2, begin, end - 1, comp);
+		}
+	}
+
+	/**
+	 * @brief pdqsort 主循环
+	 *
+	 * @param bad_allowed 还允许出现的极不平衡划分次数，用尽后改用堆排序，保证 O(nlogn)
+	 * @param leftmost 区间是否位于最左侧，否则 begin 之前的元素不大于区间内任何元素
+	 * @param branchless 是否使用无分支块划分
+	 */
+	template <typename _RI, typename Compare, typename _Branchless>
+	void _pdqsort_loop(
+	    _RI begin, _RI end, Compare comp, int bad_allowed, bool leftmost, _Branchless branchless) {
+		typedef typename iterator_traits<_RI>::difference_type _Distance;
+		for (;;) {
+			const _Distance size = end - begin;
+			if (size < _INSERTION_SORT_THRESHOLD) {
+				if (leftmost) leestl::_insertion_sort(begin, end, comp);
+				else leestl::_unguarded_insertion_sort(begin, end, comp);
+				return;
+			}
+
+			leestl::_choose_pivot(begin, end, comp);
+
+			// 枢轴等于左侧相邻元素时，区间中与之相等的元素都已就位，只需排序大于枢轴的部分
+			if (!leftmost && !comp(*(begin - 1), *begin)) {
+				begin = leestl::_partition_left(begin, end, comp) + 1;
+				continue;
+			}
+
+			std::pair<_RI, bool> part = leestl::_partition_right(begin, end, comp, branchless);
+			_RI                  pivot_pos = part.first;
+			const _Distance      l_size = pivot_pos - begin, r_size = end - (pivot_pos + 1);
+
+			if (l_size < size / 8 || r_size < size / 8) {
+				// 划分极不平衡：次数用尽时退回堆排序，否则打乱两侧部分元素，破坏可能的对抗输入
+				if (--bad_allowed == 0) {
+					leestl::_make_heap(begin, end, comp);
+					leestl::_sort_heap(begin, end, comp);
+					return;
+				}
+				if (l_size >= _INSERTION_SORT_THRESHOLD) {
+					leestl::_iter_swap(begin, begin + l_size / 4);
+					leestl::_iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+					if (l_size > _NINTHER_THRESHOLD) {
+						leestl::_iter_swap(begin + 1, begin + (l_size / 4 + 1));
+						leestl::_iter_swap(begin + 2, begin + (l_size / 4 + 2));
+						leestl::_iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+						leestl::_iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+					}
+				}
+				if (r_size >= _INSERTION_SORT_THRESHOLD) {
+					leestl::_iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+					leestl::_iter_swap(end - 1, end - r_size / 4);
+					if (r_size > _NINTHER_THRESHOLD) {
+						leestl::_iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+						leestl::_iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+						leestl::_iter_swap(end - 2, end - (1 + r_size / 4));
+						leestl::_iter_swap(end - 3, end - (2 + r_size / 4));
+					}
+				}
+			} else if (
+			    part.second && leestl::_partial_insertion_sort(begin, pivot_pos, comp) &&
+			    leestl::_partial_insertion_sort(pivot_pos + 1, end, comp)) {
+				// 区间原本就已划分好且两侧几乎有序，试探性插入排序直接完成排序
+				return;
+			}
+
+			// 递归排序左侧，循环处理右侧
+			leestl::_pdqsort_loop(begin, pivot_pos, comp, bad_allowed, leftmost, branchless);
+			begin = pivot_pos + 1;
+			leftmost = false;
+		}
+	}
+
+	/**
+	 * @brief 对 [first, last) 排序，不稳定。pattern-defeating quicksort：平均 O(nlogn)，
+	 * 	最坏 O(nlogn)，对有序、逆序和重复元素多的输入为线性
+	 *
+	 * @tparam _RI 随机访问迭代器类型
+	 * @tparam Compare 比较仿函数类型
+	 * @param first 起始位置
+	 * @param last 终止位置
+	 * @param comp 比较仿函数，comp(a, b) 为 true 表示 a 应排在 b 之前
+	 */
+	template <typename _RI, typename Compare, typename = RequireRandomAccessIterator<_RI>>
+	inline void sort(_RI first, _RI last, Compare comp) {
+		if (last - first < 2) return;
+		leestl::_pdqsort_loop(
+		    first, last, comp, leestl::_lg(size_t(last - first)), true,
+		    _use_branchless_partition<_RI, Compare>());
+	}
+
+	/**
+	 * @brief 按 operator< 对 [first, last) 升序排序，不稳定
+	 *
+	 * @tparam _RI 随机访问迭代器类型
+	 * @param first 起始位置
+	 * @param last 终止位置
+	 */
+	template <typename _RI, typename = RequireRandomAccessIterator<_RI>>
+	inline void sort(_RI first, _RI last) {
+		leestl::sort(first, last, _iter_less());
+	}
+
+	/*---------------------------------------- stable_sort ---------------------------------------*/
+
+	enum { _STABLE_CHUNK_SIZE = 16 };    // 小于该长度的区间使用插入排序
+
+	// 借助缓冲区合并 [first, middle) 与 [middle, last)，缓冲区长度不小于两段中较短者
+	template <typename _RI, typename _Pointer, typename Compare>
+	void _merge_adaptive(_RI first, _RI middle, _RI last, _Pointer buffer, Compare comp) {
+		if (middle - first <= last - middle) {
+			// 左段移入缓冲区，从前向后合并，相等时取左段以保持稳定
+			_Pointer buf_end = leestl::uninitialized_move(first, middle, buffer), buf = buffer;
+			_RI      out = first;
+			for (; buf != buf_end && middle != last; ++out) {
+				if (comp(*middle, *buf)) *out = leestl::move(*middle++);
+				else *out = leestl::move(*buf++);
+			}
+			leestl::move(buf, buf_end, out);
+			leestl::destory(buffer, buf_end);
+		} else {
+			// 右段移入缓冲区，从后向前合并，相等时取右段以保持稳定
+			_Pointer buf_end = leestl::uninitialized_move(middle, last, buffer), buf = buf_end;
+			_RI      out = last;
+			while (buf != buffer && middle != first) {
+				if (comp(*(buf - 1), *(middle - 1))) *--out = leestl::move(*--middle);
+				else *--out = leestl::move(*--buf);
+			}
+			leestl::move_backward(buffer, buf, out);
+			leestl::destory(buffer, buf_end);
+		}
+	}
+
+	// 借助缓冲区稳定排序 [first, last)，缓冲区长度不小于 (last - first) / 2
+	template <typename _RI, typename _Pointer, typename Compare>
+	void _stable_sort_adaptive(_RI first, _RI last, _Pointer buffer, Compare comp) {
+		if (last - first < _STABLE_CHUNK_SIZE) {
+			leestl::_insertion_sort(first, last, comp);
+			return;
+		}
+		_RI middle = first + (last - first) / 2;
+		leestl::_stable_sort_adaptive(first, middle, buffer, comp);
+		leestl::_stable_sort_adaptive(middle, last, buffer, comp);
+		// 两段首尾已经有序时无需合并，有序输入因此为线性
+		if (comp(*middle, *(middle - 1)))
+			leestl::_merge_adaptive(first, middle, last, buffer, comp);
+	}
+
+	// 反转 [first, last)
+	template <typename _RI>
+	void _reverse(_RI first, _RI last) {
+		if (first == last) return;
+		for (--last; first < last; ++first, --last) leestl::_iter_swap(first, last);
+	}
+
+	// 旋转区间使 middle 成为新的起点，返回原 first 所指元素的新位置
+	template <typename _RI>
+	_RI _rotate(_RI first, _RI middle, _RI last) {
+		if (first == middle) return last;
+		if (middle == last) return first;
+		leestl::_reverse(first, middle);
+		leestl::_reverse(middle, last);
+		leestl::_reverse(first, last);
+		return first + (last - middle);
+	}
+
+	// 无缓冲区时用旋转合并 [first, middle) 与 [middle, last)，O(nlogn)
+	template <typename _RI, typename Compare>
+	void _merge_without_buffer(_RI first, _RI middle, _RI last, Compare comp) {
+		typedef typename iterator_traits<_RI>::difference_type _Distance;
+		const _Distance len1 = middle - first, len2 = last - middle;
+		if (len1 == 0 || len2 == 0) return;
+		if (len1 + len2 == 2) {
+			if (comp(*middle, *first)) leestl::_iter_swap(first, middle);
+			return;
+		}
+		// 在较长的一段取中点，在另一段二分查找对应位置
+		_RI first_cut = first, second_cut = middle;
+		if (len1 > len2) {
+			first_cut += len1 / 2;
+			for (_Distance n = len2; n > 0;) {    // 第一个不小于 *first_cut 的位置
+				_Distance half = n / 2;
+				if (comp(*(second_cut + half), *first_cut))
+					second_cut += half + 1, n -= half + 1;
+				else n = half;
+			}
+		} else {
+			second_cut += len2 / 2;
+			for (_Distance n = len1; n > 0;) {    // 第一个大于 *second_cut 的位置
+				_Distance half = n / 2;
+				if (!comp(*second_cut, *(first_cut + half)))
+					first_cut += half + 1, n -= half + 1;
+				else n = half;
+			}
+		}
+		_RI new_middle = leestl::_rotate(first_cut, middle, second_cut);
+		leestl::_merge_without_buffer(first, first_cut, new_middle, comp);
+		leestl::_merge_without_buffer(new_middle, second_cut, last, comp);
+	}
+
+	// 无缓冲区时的稳定排序，O(nlog²n)
+	template <typename _RI, typename Compare>
+	void _inplace_stable_sort(_RI first, _RI last, Compare comp) {
+		if (last - first < _STABLE_CHUNK_SIZE) {
+			leestl::_insertion_sort(first, last, comp);
+			return;
+		}
+		_RI middle = first + (last - first) / 2;
+		leestl::_inplace_stable_sort(first, middle, comp);
+		leestl::_inplace_stable_sort(middle, last, comp);
+		leestl::_merge_without_buffer(first, middle, last, comp);
+	}
+
+	/**
+	 * @brief 对 [first, last) 稳定排序，相等元素保持原有顺序。归并排序，
+	 * 	使用长度为 n / 2 的临时缓冲区，O(nlogn)；缓冲区分配失败时改为原地归并，O(nlog²n)
+	 *
+	 * @tparam _RI 随机访问迭代器类型
+	 * @tparam Compare 比较仿函数类型
+	 * @param first 起始位置
+	 * @param last 终止位置
+	 * @param comp 比较仿函数
+	 */
+	template <typename _RI, typename Compare, typename = RequireRandomAccessIterator<_RI>>
+	void stable_sort(_RI first, _RI last, Compare comp) {
+		typedef typename iterator_traits<_RI>::value_type _Tp;
+		if (last - first < 2) return;
+		const size_t len = size_t(last - first + 1) / 2;
+		_Tp         *buffer = nullptr;
+		try {
+			buffer = leestl::allocator<_Tp>::allocate(len);
+		} catch (const std::bad_alloc &) {
+			leestl::_inplace_stable_sort(first, last, comp);
+			return;
+		}
+		try {
+			leestl::_stable_sort_adaptive(first, last, buffer, comp);
+		} catch (...) {
+			leestl::allocator<_Tp>::deallocate(buffer, len);
+			throw;
+		}
+		leestl::allocator<_Tp>::deallocate(buffer, len);
+	}
+
+	/**
+	 * @brief 按 operator< 对 [first, last) 稳定升序排序
+	 *
+	 * @tparam _RI 随机访问迭代器类型
+	 * @param first 起始位置
+	 * @param last 终止位置
+	 */
+	template <typename _RI, typename = RequireRandomAccessIterator<_RI>>
+	inline void stable_sort(_RI first, _RI last) {
+		leestl::stable_sort(first, last, _iter_less());
+	}
+
+	/*---------------------------------- partial_sort / nth_element ------------------------------*/
+
+	/**
+	 * @brief 把 [first, last) 中最小的 middle - first 个元素按顺序排到 [first, middle)，
+	 * 	其余元素顺序不确定。堆选择，O(nlogk)
+	 *
+	 * @tparam _RI 随机访问迭代器类型
+	 * @tparam Compare 比较仿函数类型
+	 * @param first 起始位置
+	 * @param middle 排序部分的终止位置
+	 * @param last 终止位置
+	 * @param comp 比较仿函数
+	 */
+	template <typename _RI, typename Compare, typename = RequireRandomAccessIterator<_RI>>
+	void partial_sort(_RI first, _RI middle, _RI last, Compare comp) {
+		if (first == middle) return;
+		leestl::_heap_select(first, middle, last, comp);
+		leestl::_sort_heap(first, middle, comp);
+	}
+
+	/**
+	 * @brief 按 operator< 把 [first, last) 中最小的 middle - first 个元素按升序排到 [first, middle)
+	 *
+	 * @tparam _RI 随机访问迭代器类型
+	 * @param first 起始位置
+	 * @param middle 排序部分的终止位置
+	 * @param last 终止位置
+	 */
+	template <typename _RI, typename = RequireRandomAccessIterator<_RI>>
+	inline void partial_sort(_RI first, _RI middle, _RI last) {
+		leestl::partial_sort(first, middle, last, _iter_less());
+	}
+
+	/**
+	 * @brief 重排 [first, last)，使 *nth 为排序后该位置上的元素，且之前的元素都不大于它，
+	 * 	之后的元素都不小于它。使用与 sort 相同的枢轴选择和划分，平均 O(n)；
+	 * 	划分次数过多时改为堆选择，最坏 O(nlogn)
+	 *
+	 * @tparam _RI 随机访问迭代器类型
+	 * @tparam Compare 比较仿函数类型
+	 * @param first 起始位置
+	 * @param nth 要确定的位置
+	 * @param last 终止位置
+	 * @param comp 比较仿函数
+	 */
+	template <typename _RI, typename Compare, typename = RequireRandomAccessIterator<_RI>>
+	void nth_element(_RI first, _RI nth, _RI last, Compare comp) {
+		if (nth == last || last - first < 2) return;
+		_RI begin = first, end = last;
+		int depth = 2 * leestl::_lg(size_t(last - first));
+		while (end - begin >= _INSERTION_SORT_THRESHOLD) {
+			if (depth-- == 0) {
+				leestl::_heap_select(begin, nth + 1, end, comp);
+				leestl::_iter_swap(begin, nth);
+				return;
+			}
+			leestl::_choose_pivot(begin, end, comp);
+			if (begin != first && !comp(*(begin - 1), *begin)) {
+				// 与枢轴相等的元素都落在 [begin, pivot_pos]，它们彼此相等，均已就位
+				_RI pivot_pos = leestl::_partition_left(begin, end, comp);
+				if (nth <= pivot_pos) return;
+				begin = pivot_pos + 1;
+				continue;
+			}
+			_RI pivot_pos =
+			    leestl::_partition_right(
+			        begin, end, comp, _use_branchless_partition<_RI, Compare>())
+			        .first;
+			if (pivot_pos == nth) return;
+			if (nth < pivot_pos) end = pivot_pos;
+			else begin = pivot_pos + 1;
+		}
+		leestl::_insertion_sort(begin, end, comp);
+	}
+
+	/**
+	 * @brief 按 operator< 重排 [first, last)，使 *nth 为升序排序后该位置上的元素
+	 *
+	 * @tparam _RI 随机访问迭代器类型
+	 * @param first 起始位置
+	 * @param nth 要确定的位置
+	 * @param last 终止位置
+	 */
+	template <typename _RI, typename = RequireRandomAccessIterator<_RI>>
+	inline void nth_element(_RI first, _RI nth, _RI last) {
+		leestl::nth_element(first, nth, last, _iter_less());
+	}
+
+	/*----------------------------------------- 二分查找 -----------------------------------------*/
+
+	// 预取迭代器所指的元素；元素不能取地址（代理引用）时不预取
+	template <typename _RI>
+	inline void _prefetch(_RI it) noexcept {
+		if constexpr (std::is_lvalue_reference<typename iterator_traits<_RI>::reference>::value)
+			__builtin_prefetch(leestl::address_of(*it));
+	}
+
+	// 适用于前向迭代器的 lower_bound
+	template <typename _FI, typename T, typename Compare>
+	_FI _lower_bound(_FI first, _FI last, const T &value, Compare comp, forward_interator_tag) {
+		typedef typename iterator_traits<_FI>::difference_type _Distance;
+		for (_Distance len = leestl::distance(first, last); len > 0;) {
+			const _Distance half = len / 2;
+			_FI             middle = first;
+			leestl::advance(middle, half);
+			if (comp(*middle, value)) {
+				first = ++middle;
+				len -= half + 1;
+			} else {
+				len = half;
+			}
+		}
+		return first;
+	}
+
+	// 无分支的 lower_bound：比较结果只用于选择下一段的起点，编译为条件传送，
+	// 不会因分支预测失败而清空流水线；同时预取下一步可能访问的两个中点
+	template <typename _RI, typename T, typename Compare>
+	_RI _lower_bound(
+	    _RI first, _RI last, const T &value, Compare comp, random_acess_interator_tag) {
+		typedef typename iterator_traits<_RI>::difference_type _Distance;
+		_Distance                                              len = last - first;
+		if (len == 0) return first;
+		while (len > 1) {
+			const _Distance half = len / 2;
+			leestl::_prefetch(first + half / 2);
+			leestl::_prefetch(first + (half + half / 2));
+			first = comp(*(first + half), value) ? first + half : first;
+			len -= half;
+		}
+		return first + _Distance(comp(*first, value));
+	}
+
+	/**
+	 * @brief 在有序区间 [first, last) 中查找第一个不小于 value 的元素
+	 *
+	 * @tparam _FI 前向迭代器类型
+	 * @tparam T 查找值的类型
+	 * @tparam Compare 比较仿函数类型
+	 * @param first 起始位置
+	 * @param last 终止位置
+	 * @param value 查找值
+	 * @param comp 比较仿函数，区间须按它有序
+	 * @return _FI 第一个满足 !comp(*it, value) 的位置，不存在时为 last
+	 */
+	template <typename _FI, typename T, typename Compare>
+	inline _FI lower_bound(_FI first, _FI last, const T &value, Compare comp) {
+		return leestl::_lower_bound(first, last, value, comp, iterator_category_types<_FI>());
+	}
+
+	/**
+	 * @brief 在按 operator< 有序的区间 [first, last) 中查找第一个不小于 value 的元素
+	 *
+	 * @tparam _FI 前向迭代器类型
+	 * @tparam T 查找值的类型
+	 * @param first 起始位置
+	 * @param last 终止位置
+	 * @param value 查找值
+	 * @return _FI 第一个不小于 value 的位置，不存在时为 last
+	 */
+	template <typename _FI, typename T>
+	inline _FI lower_bound(_FI first, _FI last, const T &value) {
+		return leestl::lower_bound(first, last, value, _iter_less());
+	}
+
+	// upper_bound 等价于以“value 不小于元素”为条件的 lower_bound
+	template <typename Compare>
+	struct _upper_bound_compare {
+		Compare comp;
+		template <typename T, typename U>
+		constexpr bool operator()(const T &elem, const U &value) const {
+			return !comp(value, elem);
+		}
+	};
+
+	/**
+	 * @brief 在有序区间 [first, last) 中查找第一个大于 value 的元素
+	 *
+	 * @tparam _FI 前向迭代器类型
+	 * @tparam T 查找值的类型
+	 * @tparam Compare 比较仿函数类型
+	 * @param first 起始位置
+	 * @param last 终止位置
+	 * @param value 查找值
+	 * @param comp 比较仿函数，区间须按它有序
+	 * @return _FI 第一个满足 comp(value, *it) 的位置，不存在时为 last
+	 */
+	template <typename _FI, typename T, typename Compare>
+	inline _FI upper_bound(_FI first, _FI last, const T &value, Compare comp) {
+		return leestl::_lower_bound(
+		    first, last, value, _upper_bound_compare<Compare>{comp},
+		    iterator_category_types<_FI>());
+	}
+
+	/**
+	 * @brief 在按 operator< 有序的区间 [first, last) 中查找第一个大于 value 的元素
+	 *
+	 * @tparam _FI 前向迭代器类型
+	 * @tparam T 查找值的类型
+	 * @param first 起始位置
+	 * @param last 终止位置
+	 * @param value 查找值
+	 * @return _FI 第一个大于 value 的位置，不存在时为 last
+	 */
+	template <typename _FI, typename T>
+	inline _FI upper_bound(_FI first, _FI last, const T &value) {
+		return leestl::upper_bound(first, last, value, _iter_less());
+	}
+
+	/**
+	 * @brief 判断有序区间 [first, last) 中是否存在与 value 等价的元素
+	 *
+	 * @tparam _FI 前向迭代器类型
+	 * @tparam T 查找值的类型
+	 * @tparam Compare 比较仿函数类型
+	 * @param first 起始位置
+	 * @param last 终止位置
+	 * @param value 查找值
+	 * @param comp 比较仿函数，区间须按它有序
+	 * @return bool 是否存在
+	 */
+	template <typename _FI, typename T, typename Compare>
+	inline bool binary_search(_FI first, _FI last, const T &value, Compare comp) {
+		first = leestl::lower_bound(first, last, value, comp);
+		return first != last && !comp(value, *first);
+	}
+
+	/**
+	 * @brief 判断按 operator< 有序的区间 [first, last) 中是否存在与 value 相等的元素
+	 *
+	 * @tparam _FI 前向迭代器类型
+	 * @tparam T 查找值的类型
+	 * @param first 起始位置
+	 * @param last 终止位置
+	 * @param value 查找值
+	 * @return bool 是否存在
+	 */
+	template <typename _FI, typename T>
+	inline bool binary_search(_FI first, _FI last, const T &value) {
+		return leestl::binary_search(first, last, value, _iter_less());
+	}
+
+	/*---------------------------------------- radix_sort ----------------------------------------*/
+
+	// 把键映射为无符号整数，映射后按无符号比较的顺序与键原有的顺序一致
+	template <typename K, typename = void>
+	struct _radix_key_traits {
+		static_assert(
+		    sizeof(K) == 0, "radix_sort requires an integral or IEEE float/double key");
+	};
+
+	// 无符号整数：原样使用
+	template <typename K>
+	struct _radix_key_traits<
+	    K, std::enable_if_t<std::is_integral<K>::value && std::is_unsigned<K>::value>> {
+		typedef K unsigned_type;
+		static unsigned_type to_unsigned(K key) noexcept { return key; }
+	};
+
+	// 有符号整数：翻转符号位，负数排在非负数之前
+	template <typename K>
+	struct _radix_key_traits<
+	    K, std::enable_if_t<std::is_integral<K>::value && std::is_signed<K>::value>> {
+		typedef std::make_unsigned_t<K> unsigned_type;
+		static unsigned_type to_unsigned(K key) noexcept {
+			return unsigned_type(key) ^ (unsigned_type(1) << (sizeof(K) * 8 - 1));
+		}
+	};
+
+	// IEEE 浮点数：非负数置符号位，负数按位取反。结果为 -inf < ... < -0.0 < +0.0 < ... < +inf，
+	// NaN 按其二进制排在两端
+	template <typename K>
+	struct _radix_key_traits<
+	    K, std::enable_if_t<
+	           std::is_floating_point<K>::value && std::numeric_limits<K>::is_iec559 &&
+	           (sizeof(K) == 4 || sizeof(K) == 8)>> {
+		typedef std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t> unsigned_type;
+		static unsigned_type to_unsigned(K key) noexcept {
+			unsigned_type bits;
+			std::memcpy(&bits, &key, sizeof(K));
+			const unsigned_type sign = unsigned_type(1) << (sizeof(K) * 8 - 1);
+			return (bits & sign) ? ~bits : (bits | sign);
+		}
+	};
+
+	// 以元素本身为键
+	struct _identity_key {
+		template <typename T>
+		constexpr const T &operator()(const T &value) const noexcept {
+			return value;
+		}
+	};
+
+	// 把 src[0, n) 按键的第 digit 个字节分配到 dst，offset 为各桶的起始下标；construct 为 true 时
+	// dst 是未初始化空间
+	template <bool _Construct, typename _Traits, typename _I1, typename _I2, typename KeyFn>
+	inline void _radix_scatter(_I1 src, _I2 dst, size_t n, size_t *offset, int digit, KeyFn &key) {
+		const int shift = 8 * digit;
+		for (size_t i = 0; i < n; ++i, ++src) {
+			const size_t b = (_Traits::to_unsigned(key(*src)) >> shift) & 0xff;
+			if constexpr (_Construct)
+				leestl::construct(leestl::address_of(*(dst + offset[b]++)), leestl::move(*src));
+			else *(dst + offset[b]++) = leestl::move(*src);
+		}
+	}
+
+	// 统计 [first, first + n) 中键的低 max_digit 个字节的直方图，返回不是所有元素都相同的字节
+	template <typename _Traits, typename _Iter, typename KeyFn>
+	int _radix_histogram(
+	    _Iter first, size_t n, int max_digit, size_t (*count)[256], int *digits, KeyFn &key) {
+		typedef typename _Traits::unsigned_type _U;
+		for (int d = 0; d < max_digit; ++d) std::memset(count[d], 0, sizeof(count[d]));
+		_Iter it = first;
+		for (size_t i = 0; i < n; ++i, ++it) {
+			const _U u = _Traits::to_unsigned(key(*it));
+			for (int d = 0; d < max_digit; ++d) ++count[d][(u >> (8 * d)) & 0xff];
+		}
+		// 所有元素在某个字节上都相同时跳过这一趟，例如较小整数的高位、同一时段的时间戳
+		const _U u0 = _Traits::to_unsigned(key(*first));
+		int      passes = 0;
+		for (int d = 0; d < max_digit; ++d)
+			if (count[d][(u0 >> (8 * d)) & 0xff] != n) digits[passes++] = d;
+		return passes;
+	}
+
+	// 把直方图转为各桶的起始下标
+	inline void _radix_offsets(size_t *count) {
+		for (size_t i = 0, sum = 0; i < 256; ++i) {
+			const size_t c = count[i];
+			count[i] = sum;
+			sum += c;
+		}
+	}
+
+	// 按 digits 中的字节依次在 a、b 之间来回分配 n 个元素，两者都是已构造的空间，结束时结果位于 b
+	template <typename _Traits, typename _I1, typename _I2, typename KeyFn>
+	void _radix_lsd(
+	    _I1 a, _I2 b, size_t n, const int *digits, int passes, size_t (*count)[256], KeyFn &key) {
+		for (int p = 0; p < passes; ++p) {
+			size_t *offset = count[digits[p]];
+			leestl::_radix_offsets(offset);
+			if (p % 2 == 0) leestl::_radix_scatter<false, _Traits>(a, b, n, offset, digits[p], key);
+			else leestl::_radix_scatter<false, _Traits>(b, a, n, offset, digits[p], key);
+		}
+		if (passes % 2 == 0) leestl::move(a, a + n, b);
+	}
+
+	enum {
+		_RADIX_SORT_THRESHOLD = 1024,      // 小于该长度的区间使用比较排序
+		_RADIX_MSD_BYTES = 1024 * 1024,    // 超过该字节数的区间先按最高字节分桶
+	};
+
+	// 基数排序，每趟处理键的一个字节
+	template <typename _RI, typename KeyFn>
+	void _radix_sort(_RI first, _RI last, KeyFn key) {
+		typedef typename iterator_traits<_RI>::value_type _Tp;
+		typedef std::decay_t<decltype(key(*first))>       _Key;
+		typedef _radix_key_traits<_Key>                   _Traits;
+		static_assert(
+		    std::is_nothrow_move_constructible<_Tp>::value &&
+		        std::is_nothrow_move_assignable<_Tp>::value,
+		    "radix_sort requires nothrow move construction and assignment");
+		constexpr int _DIGITS = sizeof(typename _Traits::unsigned_type);
+
+		const size_t n = last - first;
+		if (n < _RADIX_SORT_THRESHOLD) {
+			// 按映射后的键比较，与基数排序的结果一致（例如 -0.0 排在 +0.0 之前）。以元素本身为键时
+			// 键相同的元素无法区分，可以使用不稳定的排序，整数直接按 operator< 排序
+			auto comp = [&key](const _Tp &a, const _Tp &b) {
+				return _Traits::to_unsigned(key(a)) < _Traits::to_unsigned(key(b));
+			};
+			if constexpr (!std::is_same<KeyFn, _identity_key>::value)
+				leestl::stable_sort(first, last, comp);
+			else if constexpr (std::is_integral<_Tp>::value) leestl::sort(first, last);
+			else leestl::sort(first, last, comp);
+			return;
+		}
+
+		size_t count[_DIGITS][256];
+		int    digits[_DIGITS];
+		const int passes = leestl::_radix_histogram<_Traits>(first, n, _DIGITS, count, digits, key);
+		if (passes == 0) return;
+
+		// 第一趟从原区间分配到未初始化的缓冲区，此后两者都是已构造的空间
+		_Tp *buffer = leestl::allocator<_Tp>::allocate(n);
+		// 键只有一个字节时没有 MSD 阶段，不实例化按最高字节分桶的代码
+		bool msd = false;
+		if constexpr (_DIGITS > 1) {
+			msd = passes >= 2 && n * sizeof(_Tp) > _RADIX_MSD_BYTES;
+			if (msd) {
+				// 区间超出缓存时逐字节分配的写入分散到整个区间，缓存与 TLB 缺失很多。
+				// 先按最高的非平凡字节分桶（MSD），每个桶足够小，再在桶内按其余字节做 LSD
+				const int top = digits[passes - 1];
+				size_t    bucket_end[256];
+				leestl::_radix_offsets(count[top]);
+				leestl::_radix_scatter<true, _Traits>(first, buffer, n, count[top], top, key);
+				std::memcpy(bucket_end, count[top], sizeof(bucket_end));
+				for (size_t b = 0, begin = 0; b < 256; begin = bucket_end[b++]) {
+					const size_t len = bucket_end[b] - begin;
+					if (len == 0) continue;
+					int bucket_digits[_DIGITS], bucket_passes = 0;
+					if (len > 1)
+						bucket_passes = leestl::_radix_histogram<_Traits>(
+						    buffer + begin, len, top, count, bucket_digits, key);
+					leestl::_radix_lsd<_Traits>(
+					    buffer + begin, first + begin, len, bucket_digits, bucket_passes, count,
+					    key);
+				}
+			}
+		}
+		if (!msd) {
+			size_t *offset = count[digits[0]];
+			leestl::_radix_offsets(offset);
+			leestl::_radix_scatter<true, _Traits>(first, buffer, n, offset, digits[0], key);
+			leestl::_radix_lsd<_Traits>(buffer, first, n, digits + 1, passes - 1, count, key);
+		}
+		leestl::destory(buffer, buffer + n);
+		leestl::allocator<_Tp>::deallocate(buffer, n);
+	}
+
+	/**
+	 * @brief 按 key(元素) 对 [first, last) 稳定排序。LSD 基数排序，O(n * 键的字节数)，
+	 * 	使用与区间等长的临时缓冲区；所有元素在某个字节上相同时跳过该趟
+	 *
+	 * @tparam _RI 随机访问迭代器类型
+	 * @tparam KeyFn 键提取函数类型，返回整数、float 或 double
+	 * @param first 起始位置
+	 * @param last 终止位置
+	 * @param key 键提取函数，例如按记录的某个字段排序
+	 */
+	template <typename _RI, typename KeyFn, typename = RequireRandomAccessIterator<_RI>>
+	inline void radix_sort(_RI first, _RI last, KeyFn key) {
+		leestl::_radix_sort(first, last, key);
+	}
+
+	/**
+	 * @brief 对整数、float 或 double 的区间 [first, last) 升序排序。LSD 基数排序，
+	 * 	负数、浮点数按数值排序，-0.0 排在 +0.0 之前
+	 *
+	 * @tparam _RI 随机访问迭代器类型
+	 * @param first 起始位置
+	 * @param last 终止位置
+	 */
+	template <typename _RI, typename = RequireRandomAccessIterator<_RI>>
+	inline void radix_sort(_RI first, _RI last) {
+		leestl::_radix_sort(first, last, _identity_key());
+	}
 
-namespace leestl {}    // namespace leestl
+}    // namespace leestl
 
 #endif
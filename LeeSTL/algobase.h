@@ -5,7 +5,10 @@
 #ifndef _LEESTL_ALGOBASE_H_
 #define _LEESTL_ALGOBASE_H_
 
+#include <utility>
+
 #include "iterator.h"
+#include "simd.h"
 #include "utils.h"
 
 namespace leestl {
@@ -66,6 +69,16 @@ namespace leestl {
 		return comp(a, b) ? b : a;
 	}
 
+	// 能否按字节复制：两端都是指针，元素类型（忽略源的 const）相同且可平凡复制赋值
+	template <typename _II, typename _OI>
+	struct _is_memmovable : std::false_type {};
+
+	template <typename T, typename U>
+	struct _is_memmovable<T *, U *>
+	        : std::integral_constant<
+	              bool, std::is_same_v<std::remove_const_t<T>, U> &&
+	                        std::is_trivially_copy_assignable_v<U>> {};
+
 	// 适用于输入迭代器的对象复制
 	template <typename _II, typename _OI>
 	_OI _unchecked_copy_a(_II first, _II last, _OI result, leestl::input_interator_tag) {
@@ -90,7 +103,8 @@ namespace leestl {
 	template <typename _II, typename _OI>
 	constexpr inline _OI *_unchecked_copy(_II *first, _II *last, _OI *result, std::true_type) {
 		const ptrdiff_t _num = last - first;
-		if (__builtin_expect(_num > 1, true)) __builtin_memmove(result, first, sizeof(_II) * _num);
+		if (__builtin_expect(_num > 1, true))
+			leestl::simd::copy_bytes(result, first, sizeof(_II) * _num);
 		else if (_num == 1) *result = *first;
 		return result + _num;
 	}
@@ -109,9 +123,7 @@ namespace leestl {
 	constexpr inline _OI copy(_II first, _II last, _OI result) {
 		return _unchecked_copy(
 		    first, last, result,
-		    std::conditional_t < std::is_same_v<std::remove_const_t<_II>, _OI> &&
-		        std::is_trivially_copy_assignable_v<_OI>,
-		    std::true_type, std::false_type > ());
+		    _is_memmovable<_II, _OI>());
 	}
 
 	// 适用于输入迭代器的对象移动
@@ -154,34 +166,59 @@ namespace leestl {
 	constexpr inline _OI move(_II first, _II last, _OI result) {
 		return _unchecked_move(
 		    first, last, result,
-		    std::conditional_t < std::is_same_v<std::remove_const_t<_II>, _OI> &&
-		        std::is_trivially_copy_assignable_v<_OI>,
-		    std::true_type, std::false_type > ());
+		    _is_memmovable<_II, _OI>());
 	}
 
 	// 用于非标量的 unchecked_fill 实现
 	template <typename _FI, typename T>
-	inline typename std::enable_if_t<!std::is_scalar_v<T>, void> _unchecked_fill(
+	inline typename std::enable_if_t<!std::is_scalar_v<T>, void> _unchecked_fill_a(
 	    _FI first, _FI last, const T &value) {
 		for (; first != last; ++first) *first = value;
 	}
 
 	// 用于标量的 unchecked_fill 实现
 	template <typename _FI, typename T>
-	inline typename std::enable_if_t<std::is_scalar_v<T>, void> _unchecked_fill(
+	inline typename std::enable_if_t<std::is_scalar_v<T>, void> _unchecked_fill_a(
 	    _FI first, _FI last, const T &value) {
 		const T tmp = value;
 		for (; first != last; ++first) *first = tmp;
 	}
 
-	// 针对 单字节类型 提供特化版本的 unchecked_fill 实现
+	// 逐个赋值的 unchecked_fill 实现
 	template <typename _FI, typename T>
-	inline typename std::enable_if_t<leestl::is_byte_v<T>, void> _unchecked_fill(
-	    _FI first, _FI last, const T &value) {
-		const T tmp = value;
-		if (const size_t n = last - first)
-			__builtin_memset(first, static_cast<unsigned char>(tmp), n);
-	}
+	inline void _unchecked_fill(_FI first, _FI last, const T &value, std::false_type) {
+		_unchecked_fill_a(first, last, value);
+	}
+
+	// 针对 1、2、4、8、16 字节平凡可复制类型的 unchecked_fill 实现：
+	// 单字节类型使用 memset，其余足够长时使用 SIMD 内核按字节模式填充
+	template <typename U, typename T>
+	inline void _unchecked_fill(U *first, U *last, const T &value, std::true_type) {
+		const U      tmp = value;
+		const size_t n = last - first;
+		if constexpr (sizeof(U) == 1) {
+			unsigned char byte;
+			__builtin_memcpy(&byte, &tmp, 1);
+			if (n) __builtin_memset(first, byte, n);
+		} else {
+			if (n * sizeof(U) >= size_t(leestl::simd::FILL_MIN_BYTES))
+				leestl::simd::fill_pattern(first, n, leestl::address_of(tmp), sizeof(U));
+			else
+				for (; first != last; ++first) *first = tmp;
+		}
+	}
+
+	// 能否按字节模式填充：目标为指向平凡可复制类型的指针，且元素大小为 1、2、4、8、16 字节
+	template <typename _FI>
+	struct _is_pattern_fillable : std::false_type {};
+
+	template <typename U>
+	struct _is_pattern_fillable<U *>
+	        : std::integral_constant<
+	              bool, !std::is_const_v<U> && std::is_trivially_copyable_v<U> &&
+	                        std::is_trivially_copy_assignable_v<U> &&
+	                        (sizeof(U) == 1 || sizeof(U) == 2 || sizeof(U) == 4 ||
+	                         sizeof(U) == 8 || sizeof(U) == 16)> {};
 
 	/**
 	 * @brief 把 [first, last) 上的内容都填充为 value
@@ -194,7 +231,7 @@ namespace leestl {
 	 */
 	template <typename _FI, typename T>
 	inline void fill(_FI first, _FI last, const T &value) {
-		_unchecked_fill(first, last, value);
+		_unchecked_fill(first, last, value, _is_pattern_fillable<_FI>());
 	}
 
 	// 适用于非标量的 unchecked_fill_n 实现
@@ -231,7 +268,7 @@ namespace leestl {
 	inline _OI _unchecked_fill_n(
 	    _OI first, _Size n, const T &value, leestl::random_acess_interator_tag) {
 		if (n <= 0) return first;
-		_unchecked_fill(first, first + n, value);
+		_unchecked_fill(first, first + n, value, _is_pattern_fillable<_OI>());
 		return first + n;
 	}
 
@@ -280,7 +317,7 @@ namespace leestl {
 	    _BI2 *>
 	_copy_backward(_BI1 *first, _BI1 *last, _BI2 *result) {
 		const size_t n = static_cast<size_t>(last - first);
-		if (n != 0) __builtin_memmove(result - n, first - n, n * sizeof(*first));
+		if (n != 0) __builtin_memmove(result - n, first, n * sizeof(*first));
 		return result - n;
 	}
 
@@ -319,7 +356,7 @@ namespace leestl {
 	    _BI2 *>
 	_move_backward(_BI1 *first, _BI1 *last, _BI2 *result) {
 		const size_t n = static_cast<size_t>(last - first);
-		if (n != 0) __builtin_memmove(result - n, first - n, n * sizeof(*first));
+		if (n != 0) __builtin_memmove(result - n, first, n * sizeof(*first));
 		return result - n;
 	}
 
@@ -329,6 +366,178 @@ namespace leestl {
 		return _move_backward(first, last, result);
 	}
 
+	// 能否逐字节比较：两端都是指针，元素类型（忽略 const）相同，且为整数、枚举或指针。
+	// 这些类型的两个值相等当且仅当对象表示相同；浮点数的 +0.0 与 -0.0、NaN 不满足，不在此列
+	template <typename _I1, typename _I2>
+	struct _is_bytewise_comparable : std::false_type {};
+
+	template <typename T, typename U>
+	struct _is_bytewise_comparable<T *, U *>
+	        : std::integral_constant<
+	              bool, std::is_same_v<std::remove_const_t<T>, std::remove_const_t<U>> &&
+	                        !std::is_volatile_v<T> &&
+	                        (std::is_integral_v<T> || std::is_enum_v<T> ||
+	                         std::is_pointer_v<T>)> {};
+
+	// 逐个比较的 mismatch 实现
+	template <typename _II1, typename _II2>
+	inline std::pair<_II1, _II2> _mismatch(_II1 first1, _II1 last1, _II2 first2, std::false_type) {
+		while (first1 != last1 && *first1 == *first2) ++first1, (void)++first2;
+		return std::pair<_II1, _II2>(first1, first2);
+	}
+
+	// 针对可逐字节比较的数组的 mismatch 实现，使用 SIMD 内核查找第一个不同的字节
+	template <typename T, typename U>
+	inline std::pair<T *, U *> _mismatch(T *first1, T *last1, U *first2, std::true_type) {
+		const size_t n = last1 - first1;
+		const size_t i = leestl::simd::mismatch_bytes(first1, first2, n * sizeof(T)) / sizeof(T);
+		return std::pair<T *, U *>(first1 + i, first2 + i);
+	}
+
+	/**
+	 * @brief 查找 [first1, last1) 与以 first2 为起始处的序列中第一对不相等的元素
+	 *
+	 * @tparam _II1 第一个序列的迭代器类型
+	 * @tparam _II2 第二个序列的迭代器类型
+	 * @param first1 第一个序列的起始位置
+	 * @param last1 第一个序列的终止位置
+	 * @param first2 第二个序列的起始位置，长度不小于第一个序列
+	 * @return std::pair<_II1, _II2> 两个序列中第一对不相等元素的位置
+	 */
+	template <typename _II1, typename _II2>
+	inline std::pair<_II1, _II2> mismatch(_II1 first1, _II1 last1, _II2 first2) {
+		return leestl::_mismatch(first1, last1, first2, _is_bytewise_comparable<_II1, _II2>());
+	}
+
+	/**
+	 * @brief 查找 [first1, last1) 与以 first2 为起始处的序列中第一对不满足 pred 的元素
+	 *
+	 * @tparam BinaryPredicate 判断两个元素是否相等的仿函数
+	 * @param first1 第一个序列的起始位置
+	 * @param last1 第一个序列的终止位置
+	 * @param first2 第二个序列的起始位置，长度不小于第一个序列
+	 * @param pred 判断相等的仿函数
+	 * @return std::pair<_II1, _II2> 两个序列中第一对不相等元素的位置
+	 */
+	template <typename _II1, typename _II2, typename BinaryPredicate>
+	inline std::pair<_II1, _II2> mismatch(
+	    _II1 first1, _II1 last1, _II2 first2, BinaryPredicate pred) {
+		while (first1 != last1 && pred(*first1, *first2)) ++first1, (void)++first2;
+		return std::pair<_II1, _II2>(first1, first2);
+	}
+
+	// 逐个比较的 equal 实现
+	template <typename _II1, typename _II2>
+	inline bool _equal(_II1 first1, _II1 last1, _II2 first2, std::false_type) {
+		for (; first1 != last1; ++first1, (void)++first2)
+			if (!(*first1 == *first2)) return false;
+		return true;
+	}
+
+	// 针对可逐字节比较的数组的 equal 实现
+	template <typename T, typename U>
+	inline bool _equal(T *first1, T *last1, U *first2, std::true_type) {
+		const size_t n = last1 - first1;
+		return n == 0 || __builtin_memcmp(first1, first2, n * sizeof(T)) == 0;
+	}
+
+	/**
+	 * @brief 判断 [first1, last1) 与以 first2 为起始处的序列是否逐个相等
+	 *
+	 * @tparam _II1 第一个序列的迭代器类型
+	 * @tparam _II2 第二个序列的迭代器类型
+	 * @param first1 第一个序列的起始位置
+	 * @param last1 第一个序列的终止位置
+	 * @param first2 第二个序列的起始位置，长度不小于第一个序列
+	 * @return bool 是否相等
+	 */
+	template <typename _II1, typename _II2>
+	inline bool equal(_II1 first1, _II1 last1, _II2 first2) {
+		return leestl::_equal(first1, last1, first2, _is_bytewise_comparable<_II1, _II2>());
+	}
+
+	/**
+	 * @brief 判断 [first1, last1) 与以 first2 为起始处的序列是否逐个满足 pred
+	 *
+	 * @tparam BinaryPredicate 判断两个元素是否相等的仿函数
+	 * @param first1 第一个序列的起始位置
+	 * @param last1 第一个序列的终止位置
+	 * @param first2 第二个序列的起始位置，长度不小于第一个序列
+	 * @param pred 判断相等的仿函数
+	 * @return bool 是否相等
+	 */
+	template <typename _II1, typename _II2, typename BinaryPredicate>
+	inline bool equal(_II1 first1, _II1 last1, _II2 first2, BinaryPredicate pred) {
+		for (; first1 != last1; ++first1, (void)++first2)
+			if (!pred(*first1, *first2)) return false;
+		return true;
+	}
+
+	// 逐个比较的 lexicographical_compare 实现
+	template <typename _II1, typename _II2>
+	inline bool _lexicographical_compare(
+	    _II1 first1, _II1 last1, _II2 first2, _II2 last2, std::false_type) {
+		for (; first1 != last1 && first2 != last2; ++first1, (void)++first2) {
+			if (*first1 < *first2) return true;
+			if (*first2 < *first1) return false;
+		}
+		return first1 == last1 && first2 != last2;
+	}
+
+	// 针对可逐字节比较的数组的 lexicographical_compare 实现：
+	// 无符号单字节类型直接使用 memcmp，其余类型先找到第一对不同的元素再比较这一对
+	template <typename T, typename U>
+	inline bool _lexicographical_compare(
+	    T *first1, T *last1, U *first2, U *last2, std::true_type) {
+		const size_t n1 = last1 - first1, n2 = last2 - first2, n = n1 < n2 ? n1 : n2;
+		if constexpr (sizeof(T) == 1 && std::is_unsigned_v<T>) {
+			const int r = n ? __builtin_memcmp(first1, first2, n) : 0;
+			return r != 0 ? r < 0 : n1 < n2;
+		} else {
+			const size_t i =
+			    leestl::simd::mismatch_bytes(first1, first2, n * sizeof(T)) / sizeof(T);
+			return i != n ? first1[i] < first2[i] : n1 < n2;
+		}
+	}
+
+	/**
+	 * @brief 按字典序判断 [first1, last1) 是否小于 [first2, last2)
+	 *
+	 * @tparam _II1 第一个序列的迭代器类型
+	 * @tparam _II2 第二个序列的迭代器类型
+	 * @param first1 第一个序列的起始位置
+	 * @param last1 第一个序列的终止位置
+	 * @param first2 第二个序列的起始位置
+	 * @param last2 第二个序列的终止位置
+	 * @return bool 第一个序列是否小于第二个序列
+	 */
+	template <typename _II1, typename _II2>
+	inline bool lexicographical_compare(_II1 first1, _II1 last1, _II2 first2, _II2 last2) {
+		return leestl::_lexicographical_compare(
+		    first1, last1, first2, last2, _is_bytewise_comparable<_II1, _II2>());
+	}
+
+	/**
+	 * @brief 按字典序和 comp 判断 [first1, last1) 是否小于 [first2, last2)
+	 *
+	 * @tparam Compare 比较仿函数
+	 * @param first1 第一个序列的起始位置
+	 * @param last1 第一个序列的终止位置
+	 * @param first2 第二个序列的起始位置
+	 * @param last2 第二个序列的终止位置
+	 * @param comp 比较仿函数
+	 * @return bool 第一个序列是否小于第二个序列
+	 */
+	template <typename _II1, typename _II2, typename Compare>
+	inline bool lexicographical_compare(
+	    _II1 first1, _II1 last1, _II2 first2, _II2 last2, Compare comp) {
+		for (; first1 != last1 && first2 != last2; ++first1, (void)++first2) {
+			if (comp(*first1, *first2)) return true;
+			if (comp(*first2, *first1)) return false;
+		}
+		return first1 == last1 && first2 != last2;
+	}
+
 }    // namespace leestl
 
 #endif
@@ -6,6 +6,8 @@
 #define _LEESTL_ALGORITHM_H_
 
 #include "algo.h"
+#include "parallel_algo.h"
+#include "parallel_algobase.h"
 
 namespace leestl {}    // namespace leestl
 
@@ -0,0 +1,315 @@
+/** @file alloc.h
+ * 	这个文件实现 SGI 风格的两级空间配置器
+ *
+ * 	第一级配置器直接使用 malloc/free，并在内存不足时调用用户设置的处理函数；
+ * 	第二级配置器为不超过 128 字节的小区块维护 16 个自由链表（以 8 字节为粒度），
+ * 	自由链表为空时从内存池批量切割区块填充，大区块直接交给第一级配置器。
+ */
+
+#ifndef _LEESTL_ALLOC_H_
+#define _LEESTL_ALLOC_H_ 1
+
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+#include "allocator.h"
+
+namespace leestl {
+
+	// 第一级配置器，直接使用 malloc/free
+	template <int inst>
+	class _malloc_alloc_template {
+	private:
+		static void *_oom_malloc(size_t n);
+		static void *_oom_realloc(void *ptr, size_t n);
+
+		static void (*_malloc_alloc_oom_handler)();
+
+	public:
+		static void *allocate(size_t n) {
+			void *result = std::malloc(n);
+			if (result == nullptr) result = _oom_malloc(n);
+			return result;
+		}
+
+		static void deallocate(void *ptr, size_t /* n */) { std::free(ptr); }
+
+		static void *reallocate(void *ptr, size_t /* old_sz */, size_t new_sz) {
+			void *result = std::realloc(ptr, new_sz);
+			if (result == nullptr) result = _oom_realloc(ptr, new_sz);
+			return result;
+		}
+
+		/**
+		 * @brief 设置内存不足时的处理函数，仿照 std::set_new_handler
+		 *
+		 * @param f 新的处理函数
+		 * @return 旧的处理函数
+		 */
+		static void (*set_malloc_handler(void (*f)()))() {
+			void (*old)() = _malloc_alloc_oom_handler;
+			_malloc_alloc_oom_handler = f;
+			return old;
+		}
+	};
+
+	template <int inst>
+	void (*_malloc_alloc_template<inst>::_malloc_alloc_oom_handler)() = nullptr;
+
+	template <int inst>
+	void *_malloc_alloc_template<inst>::_oom_malloc(size_t n) {
+		for (;;) {    // 不断尝试释放、配置
+			void (*handler)() = _malloc_alloc_oom_handler;
+			if (handler == nullptr) throw std::bad_alloc();
+			handler();
+			if (void *result = std::malloc(n)) return result;
+		}
+	}
+
+	template <int inst>
+	void *_malloc_alloc_template<inst>::_oom_realloc(void *ptr, size_t n) {
+		for (;;) {
+			void (*handler)() = _malloc_alloc_oom_handler;
+			if (handler == nullptr) throw std::bad_alloc();
+			handler();
+			if (void *result = std::realloc(ptr, n)) return result;
+		}
+	}
+
+	typedef _malloc_alloc_template<0> malloc_alloc;
+
+	// 第二级配置器，threads 为 true 时使用互斥锁保护自由链表与内存池
+	template <bool threads, int inst>
+	class _default_alloc_template {
+	private:
+		enum { _ALIGN = 8 };                            // 小区块的上调边界
+		enum { _MAX_BYTES = 128 };                      // 小区块的上限
+		enum { _NFREELISTS = _MAX_BYTES / _ALIGN };     // 自由链表个数
+		enum { _NOBJS = 20 };                           // 每次填充自由链表的默认区块数
+
+		// 自由链表的节点，未分配时存放下一节点的指针，分配后存放用户数据
+		union _obj {
+			union _obj *free_list_link;
+			char        client_data[1];
+		};
+
+		static _obj *volatile _free_list[_NFREELISTS];
+
+		static char  *_start_free;    // 内存池起始位置
+		static char  *_end_free;      // 内存池结束位置
+		static size_t _heap_size;     // 已向系统申请的总量，用于计算下一次申请的附加量
+
+		static std::mutex _lock;
+
+		// 将 bytes 上调至 8 的倍数
+		static constexpr size_t _round_up(size_t bytes) {
+			return (bytes + size_t(_ALIGN) - 1) & ~(size_t(_ALIGN) - 1);
+		}
+
+		// 根据区块大小决定使用第 n 号自由链表，n 从 0 开始
+		static constexpr size_t _freelist_index(size_t bytes) {
+			return (bytes + size_t(_ALIGN) - 1) / size_t(_ALIGN) - 1;
+		}
+
+		static void *_refill(size_t n);
+		static char *_chunk_alloc(size_t size, int &nobjs);
+
+		// 仅在 threads 为 true 时加锁
+		struct _lock_guard {
+			_lock_guard() {
+				if (threads) _lock.lock();
+			}
+			~_lock_guard() {
+				if (threads) _lock.unlock();
+			}
+		};
+
+	public:
+		static void *allocate(size_t n);
+		static void  deallocate(void *ptr, size_t n);
+		static void *reallocate(void *ptr, size_t old_sz, size_t new_sz);
+	};
+
+	template <bool threads, int inst>
+	typename _default_alloc_template<threads, inst>::_obj
+	    *volatile _default_alloc_template<threads, inst>::_free_list[_NFREELISTS] = {};
+
+	template <bool threads, int inst>
+	char *_default_alloc_template<threads, inst>::_start_free = nullptr;
+
+	template <bool threads, int inst>
+	char *_default_alloc_template<threads, inst>::_end_free = nullptr;
+
+	template <bool threads, int inst>
+	size_t _default_alloc_template<threads, inst>::_heap_size = 0;
+
+	template <bool threads, int inst>
+	std::mutex _default_alloc_template<threads, inst>::_lock;
+
+	template <bool threads, int inst>
+	void *_default_alloc_template<threads, inst>::allocate(size_t n) {
+		if (n > size_t(_MAX_BYTES)) return malloc_alloc::allocate(n);
+
+		_lock_guard   guard;
+		_obj *volatile *my_free_list = _free_list + _freelist_index(n);
+		_obj           *result = *my_free_list;
+		if (result == nullptr) return _refill(_round_up(n));    // 自由链表为空，重新填充
+		*my_free_list = result->free_list_link;
+		return result;
+	}
+
+	template <bool threads, int inst>
+	void _default_alloc_template<threads, inst>::deallocate(void *ptr, size_t n) {
+		if (ptr == nullptr) return;
+		if (n > size_t(_MAX_BYTES)) {
+			malloc_alloc::deallocate(ptr, n);
+			return;
+		}
+
+		_lock_guard   guard;
+		_obj *volatile *my_free_list = _free_list + _freelist_index(n);
+		_obj           *q = static_cast<_obj *>(ptr);
+		q->free_list_link = *my_free_list;    // 回收区块到自由链表头部
+		*my_free_list = q;
+	}
+
+	template <bool threads, int inst>
+	void *_default_alloc_template<threads, inst>::reallocate(
+	    void *ptr, size_t old_sz, size_t new_sz) {
+		if (old_sz > size_t(_MAX_BYTES) && new_sz > size_t(_MAX_BYTES))
+			return malloc_alloc::reallocate(ptr, old_sz, new_sz);
+		if (_round_up(old_sz) == _round_up(new_sz)) return ptr;
+
+		void  *result = allocate(new_sz);
+		size_t copy_sz = new_sz > old_sz ? old_sz : new_sz;
+		__builtin_memcpy(result, ptr, copy_sz);
+		deallocate(ptr, old_sz);
+		return result;
+	}
+
+	// 返回一个大小为 n 的区块，并为 n 对应的自由链表填充新的区块，n 已上调至 8 的倍数
+	template <bool threads, int inst>
+	void *_default_alloc_template<threads, inst>::_refill(size_t n) {
+		int   nobjs = _NOBJS;
+		char *chunk = _chunk_alloc(n, nobjs);
+		if (nobjs == 1) return chunk;    // 只获得一个区块，直接交给调用者
+
+		_obj *volatile *my_free_list = _free_list + _freelist_index(n);
+		_obj           *result = reinterpret_cast<_obj *>(chunk);    // 第一块返回给调用者
+		_obj           *next_obj = reinterpret_cast<_obj *>(chunk + n);
+		*my_free_list = next_obj;
+
+		// 将剩余区块串成自由链表
+		for (int i = 1;; ++i) {
+			_obj *current_obj = next_obj;
+			next_obj = reinterpret_cast<_obj *>(reinterpret_cast<char *>(next_obj) + n);
+			if (nobjs - 1 == i) {
+				current_obj->free_list_link = nullptr;
+				break;
+			}
+			current_obj->free_list_link = next_obj;
+		}
+		return result;
+	}
+
+	// 从内存池中取出 nobjs 个大小为 size 的区块，空间不足时 nobjs 会被调小
+	template <bool threads, int inst>
+	char *_default_alloc_template<threads, inst>::_chunk_alloc(size_t size, int &nobjs) {
+		size_t total_bytes = size * nobjs;
+		size_t bytes_left = _end_free - _start_free;
+
+		if (bytes_left >= total_bytes) {    // 内存池剩余空间完全满足需求
+			char *result = _start_free;
+			_start_free += total_bytes;
+			return result;
+		}
+		if (bytes_left >= size) {    // 内存池剩余空间足够供应一个以上的区块
+			nobjs = static_cast<int>(bytes_left / size);
+			total_bytes = size * nobjs;
+			char *result = _start_free;
+			_start_free += total_bytes;
+			return result;
+		}
+
+		// 内存池连一个区块都无法提供，向系统申请，附加量随申请次数增长
+		size_t bytes_to_get = 2 * total_bytes + _round_up(_heap_size >> 4);
+		if (bytes_left > 0) {    // 把内存池的残余零头编入合适的自由链表
+			_obj *volatile *my_free_list = _free_list + _freelist_index(bytes_left);
+			reinterpret_cast<_obj *>(_start_free)->free_list_link = *my_free_list;
+			*my_free_list = reinterpret_cast<_obj *>(_start_free);
+		}
+
+		_start_free = static_cast<char *>(std::malloc(bytes_to_get));
+		if (_start_free == nullptr) {
+			// 系统内存不足，尝试从尚未使用且足够大的自由链表中借用区块
+			for (size_t i = size; i <= size_t(_MAX_BYTES); i += size_t(_ALIGN)) {
+				_obj *volatile *my_free_list = _free_list + _freelist_index(i);
+				_obj           *p = *my_free_list;
+				if (p != nullptr) {
+					*my_free_list = p->free_list_link;
+					_start_free = reinterpret_cast<char *>(p);
+					_end_free = _start_free + i;
+					return _chunk_alloc(size, nobjs);
+				}
+			}
+			_end_free = nullptr;
+			// 交给第一级配置器，利用其内存不足处理机制，失败时抛出 bad_alloc
+			_start_free = static_cast<char *>(malloc_alloc::allocate(bytes_to_get));
+		}
+		_heap_size += bytes_to_get;
+		_end_free = _start_free + bytes_to_get;
+		return _chunk_alloc(size, nobjs);    // 内存池已补充，递归修正 nobjs
+	}
+
+	typedef _default_alloc_template<true, 0> alloc;             // 默认的线程安全第二级配置器
+	typedef _default_alloc_template<false, 0> single_client_alloc;    // 单线程版本
+
+	// 将以字节为单位的配置器包装为以对象为单位的接口
+	template <typename T, typename Alloc>
+	class simple_alloc {
+	public:
+		static T *allocate(size_t n) {
+			return n == 0 ? nullptr : static_cast<T *>(Alloc::allocate(n * sizeof(T)));
+		}
+		static T   *allocate() { return static_cast<T *>(Alloc::allocate(sizeof(T))); }
+		static void deallocate(T *ptr, size_t n) {
+			if (n != 0) Alloc::deallocate(ptr, n * sizeof(T));
+		}
+		static void deallocate(T *ptr) { Alloc::deallocate(ptr, sizeof(T)); }
+	};
+
+	/**
+	 * @brief 基于第二级配置器的对象配置器，接口与 leestl::allocator 一致，
+	 * 	可作为容器的 Alloc 模板参数，例如 leestl::vector<int, leestl::pool_allocator<int>>
+	 *
+	 * @tparam T 对象类型
+	 * @tparam Alloc 底层字节配置器，默认为线程安全的第二级配置器
+	 */
+	template <typename T, typename Alloc = leestl::alloc>
+	class pool_allocator : public allocator<T> {
+		// 自由链表只保证 8 字节对齐，对齐要求更高的类型直接交给第一级配置器
+		typedef std::conditional_t<(alignof(T) > 8), malloc_alloc, Alloc> _byte_alloc;
+		typedef simple_alloc<T, _byte_alloc>                            _data_alloc;
+
+	public:
+		typedef typename allocator<T>::size_type size_type;
+
+		pool_allocator() noexcept = default;
+		template <typename U>
+		pool_allocator(const pool_allocator<U, Alloc> &) noexcept {}
+
+		static T *allocate() { return _data_alloc::allocate(); }
+		static T *allocate(size_type n) { return _data_alloc::allocate(n); }
+
+		static void deallocate(T *ptr) {
+			if (ptr != nullptr) _data_alloc::deallocate(ptr);
+		}
+		static void deallocate(T *ptr, size_type n) {
+			if (ptr != nullptr) _data_alloc::deallocate(ptr, n);
+		}
+	};
+
+}    // namespace leestl
+
+#endif
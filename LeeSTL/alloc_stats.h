@@ -0,0 +1,313 @@
+/** @file alloc_stats.h
+ * 	这个文件实现配置器的分配统计，按类型与全局记录调用次数、字节数、
+ * 	存活字节数、峰值与尺寸直方图，并提供快照与 JSON 输出接口
+ *
+ * 	定义宏 LEESTL_ALLOC_STATS 后 leestl::allocator<T> 的 allocate/deallocate 会自动记录，
+ * 	其他配置器可通过 leestl::instrumented_allocator<T, Alloc> 包装后接入。
+ * 	所有计数器按线程分片并各自占据独立的缓存行，避免多线程下的伪共享。
+ * 	存活字节数的变化先累计在分片中，净变化达到 _FLUSH_BYTES 时才合并到记录并更新峰值，
+ * 	快照时再加上各分片尚未合并的部分，没有并发的分配、释放时存活字节数是精确的。
+ * 	峰值在只有一个线程分配、释放时精确；多线程下以各分片未合并部分的最大值之和估计，
+ * 	误差不超过 _NSHARDS * _FLUSH_BYTES。
+ */
+
+#ifndef _LEESTL_ALLOC_STATS_H_
+#define _LEESTL_ALLOC_STATS_H_ 1
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+#include "alloc_traits.h"
+#include "type_traits.h"
+
+namespace leestl {
+
+	namespace alloc_stats {
+
+		// 第 i 个桶统计 [2^(i-1), 2^i) 字节的分配，最后一桶包含更大者
+		enum { HISTOGRAM_BUCKETS = 32 };
+		enum { _NSHARDS = 16 };
+		enum { _FLUSH_BYTES = 16 * 1024 };    // 分片中存活字节数的净变化达到该值时合并到记录
+
+		// 一个分片的计数器，独占一条缓存行
+		struct alignas(64) _shard {
+			std::atomic<uint64_t> alloc_calls{0};
+			std::atomic<uint64_t> dealloc_calls{0};
+			std::atomic<uint64_t> alloc_bytes{0};
+			std::atomic<uint64_t> dealloc_bytes{0};
+			std::atomic<uint64_t> histogram[HISTOGRAM_BUCKETS] = {};
+			std::atomic<int64_t>  live_delta{0};    // 尚未合并到记录的存活字节数变化
+			std::atomic<int64_t>  delta_peak{0};    // 上次合并以来 live_delta 的最大值
+		};
+
+		// 一组（一个类型或全局）统计记录，所有记录组成侵入式单向链表供快照遍历
+		struct _record {
+			const char          *name;
+			_shard               shards[_NSHARDS];
+			std::atomic<int64_t> live{0};    // 已合并的存活字节数
+			std::atomic<int64_t> peak{0};    // 已合并的存活字节数峰值
+			_record             *next = nullptr;
+
+			explicit _record(const char *_name) : name(_name) {}
+		};
+
+		inline std::atomic<_record *> &_registry() {
+			static std::atomic<_record *> head{nullptr};
+			return head;
+		}
+
+		inline void _register(_record *r) {
+			_record *head = _registry().load(std::memory_order_relaxed);
+			do { r->next = head; } while (!_registry().compare_exchange_weak(
+			    head, r, std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		// 当前线程使用的分片编号
+		inline size_t _shard_index() {
+			thread_local size_t index =
+			    std::hash<std::thread::id>()(std::this_thread::get_id()) % _NSHARDS;
+			return index;
+		}
+
+		inline size_t _bucket(size_t bytes) {
+			size_t b = bytes == 0 ? 0 : size_t(64 - __builtin_clzll(bytes));
+			return b < size_t(HISTOGRAM_BUCKETS) ? b : HISTOGRAM_BUCKETS - 1;
+		}
+
+		// 把峰值提高到至少 value
+		inline void _raise_peak(_record &r, int64_t value) {
+			int64_t peak = r.peak.load(std::memory_order_relaxed);
+			while (value > peak &&
+			       !r.peak.compare_exchange_weak(peak, value, std::memory_order_relaxed)) {}
+		}
+
+		// 把分片中未合并的存活字节数变化合并到记录，并以合并前的存活字节数加上期间的最大变化更新峰值
+		inline void _flush_live(_record &r, _shard &s) {
+			const int64_t delta = s.live_delta.exchange(0, std::memory_order_relaxed);
+			const int64_t high = s.delta_peak.exchange(0, std::memory_order_relaxed);
+			const int64_t base = r.live.fetch_add(delta, std::memory_order_relaxed);
+			_raise_peak(r, base + (high > delta ? high : delta));
+		}
+
+		// 在当前线程的分片中累计存活字节数的变化，净变化达到 _FLUSH_BYTES 时合并到记录
+		inline void _add_live(_record &r, _shard &s, int64_t bytes) {
+			const int64_t delta = s.live_delta.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+			int64_t       high = s.delta_peak.load(std::memory_order_relaxed);
+			while (delta > high &&
+			       !s.delta_peak.compare_exchange_weak(high, delta, std::memory_order_relaxed)) {}
+			if (delta >= _FLUSH_BYTES || delta <= -_FLUSH_BYTES) _flush_live(r, s);
+		}
+
+		inline void _record_alloc(_record &r, size_t bytes) {
+			_shard &s = r.shards[_shard_index()];
+			s.alloc_calls.fetch_add(1, std::memory_order_relaxed);
+			s.alloc_bytes.fetch_add(bytes, std::memory_order_relaxed);
+			s.histogram[_bucket(bytes)].fetch_add(1, std::memory_order_relaxed);
+			_add_live(r, s, int64_t(bytes));
+		}
+
+		inline void _record_dealloc(_record &r, size_t bytes) {
+			_shard &s = r.shards[_shard_index()];
+			s.dealloc_calls.fetch_add(1, std::memory_order_relaxed);
+			s.dealloc_bytes.fetch_add(bytes, std::memory_order_relaxed);
+			_add_live(r, s, -int64_t(bytes));
+		}
+
+		// 全局统计记录
+		inline _record &_global() {
+			static _record *r = [] {
+				_record *g = new _record("<global>");    // 有意不释放，保证退出阶段仍可记录
+				_register(g);
+				return g;
+			}();
+			return *r;
+		}
+
+		// 获取可读的类型名
+		template <typename T>
+		const char *_type_name() {
+			static const char *name = [] {
+				int   status = 0;
+				char *demangled = abi::__cxa_demangle(typeid(T).name(), nullptr, nullptr, &status);
+				return status == 0 ? static_cast<const char *>(demangled) : typeid(T).name();
+			}();
+			return name;
+		}
+
+		// 类型 T 的统计记录
+		template <typename T>
+		_record &_type_record() {
+			static _record *r = [] {
+				_record *t = new _record(_type_name<T>());
+				_register(t);
+				return t;
+			}();
+			return *r;
+		}
+
+		/**
+		 * @brief 记录一次类型 T 的分配
+		 *
+		 * @tparam T 分配的对象类型
+		 * @param bytes 分配的字节数
+		 */
+		template <typename T>
+		inline void record_allocate(size_t bytes) {
+			_record_alloc(_type_record<T>(), bytes);
+			_record_alloc(_global(), bytes);
+		}
+
+		/**
+		 * @brief 记录一次类型 T 的释放
+		 *
+		 * @tparam T 释放的对象类型
+		 * @param bytes 释放的字节数
+		 */
+		template <typename T>
+		inline void record_deallocate(size_t bytes) {
+			_record_dealloc(_type_record<T>(), bytes);
+			_record_dealloc(_global(), bytes);
+		}
+
+		// 某一记录在快照时刻的汇总值
+		struct entry {
+			std::string name;
+			uint64_t    alloc_calls = 0;
+			uint64_t    dealloc_calls = 0;
+			uint64_t    alloc_bytes = 0;
+			uint64_t    dealloc_bytes = 0;
+			int64_t     live_bytes = 0;
+			int64_t     peak_bytes = 0;
+			uint64_t    histogram[HISTOGRAM_BUCKETS] = {};
+		};
+
+		/**
+		 * @brief 汇总所有分片，获取当前的统计快照，第一项为全局统计
+		 *
+		 * @return std::vector<entry> 各记录的统计值
+		 */
+		inline std::vector<entry> snapshot() {
+			_global();
+			std::vector<entry> result;
+			for (_record *r = _registry().load(std::memory_order_acquire); r; r = r->next) {
+				entry   e;
+				int64_t pending = 0, pending_high = 0;
+				e.name = r->name;
+				for (const _shard &s : r->shards) {
+					pending += s.live_delta.load(std::memory_order_relaxed);
+					pending_high += s.delta_peak.load(std::memory_order_relaxed);
+					e.alloc_calls += s.alloc_calls.load(std::memory_order_relaxed);
+					e.dealloc_calls += s.dealloc_calls.load(std::memory_order_relaxed);
+					e.alloc_bytes += s.alloc_bytes.load(std::memory_order_relaxed);
+					e.dealloc_bytes += s.dealloc_bytes.load(std::memory_order_relaxed);
+					for (size_t i = 0; i < size_t(HISTOGRAM_BUCKETS); ++i)
+						e.histogram[i] += s.histogram[i].load(std::memory_order_relaxed);
+				}
+				// 把未合并部分的峰值估计记入记录，使之后的快照中峰值不会下降
+				const int64_t live = r->live.load(std::memory_order_relaxed);
+				_raise_peak(*r, live + pending_high);
+				e.live_bytes = live + pending;
+				e.peak_bytes = r->peak.load(std::memory_order_relaxed);
+				if (r == &_global()) result.insert(result.begin(), e);
+				else result.push_back(e);
+			}
+			return result;
+		}
+
+		// 转义 JSON 字符串
+		inline std::string _json_escape(const std::string &s) {
+			std::string out;
+			for (char c : s) {
+				if (c == '"' || c == '\\') out += '\\';
+				out += c;
+			}
+			return out;
+		}
+
+		/**
+		 * @brief 以 JSON 格式输出统计快照，便于长时间运行的进程定期采集
+		 *
+		 * @return std::string JSON 文本，形如 {"global": {...}, "types": [{...}, ...]}
+		 */
+		inline std::string dump_json() {
+			std::vector<entry> entries = snapshot();
+			std::string        out = "{";
+			char               buf[256];
+			for (size_t i = 0; i < entries.size(); ++i) {
+				const entry &e = entries[i];
+				if (i == 0) out += "\"global\": ";
+				else if (i == 1) out += ", \"types\": [";
+				else out += ", ";
+				out += "{\"name\": \"" + _json_escape(e.name) + "\", ";
+				std::snprintf(
+				    buf, sizeof(buf),
+				    "\"alloc_calls\": %llu, \"dealloc_calls\": %llu, \"alloc_bytes\": %llu, "
+				    "\"dealloc_bytes\": %llu, \"live_bytes\": %lld, \"peak_bytes\": %lld, "
+				    "\"histogram\": [",
+				    (unsigned long long)e.alloc_calls,
+				    (unsigned long long)e.dealloc_calls, (unsigned long long)e.alloc_bytes,
+				    (unsigned long long)e.dealloc_bytes, (long long)e.live_bytes,
+				    (long long)e.peak_bytes);
+				out += buf;
+				for (size_t b = 0; b < size_t(HISTOGRAM_BUCKETS); ++b) {
+					if (b) out += ", ";
+					out += std::to_string(e.histogram[b]);
+				}
+				out += "]}";
+			}
+			if (entries.size() > 1) out += "]";
+			else out += ", \"types\": []";
+			out += "}";
+			return out;
+		}
+
+	}    // namespace alloc_stats
+
+	/**
+	 * @brief 记录分配统计的配置器包装，将分配、释放转发给 Alloc
+	 *
+	 * @tparam T 对象类型
+	 * @tparam Alloc 被包装的配置器
+	 */
+	template <typename T, typename Alloc>
+	class instrumented_allocator : public Alloc {
+	public:
+		typedef T      value_type;
+		typedef size_t size_type;
+
+		template <typename U>
+		struct rebind {
+			typedef instrumented_allocator<
+			    U, typename allocator_traits<Alloc>::template rebind_alloc<U>>
+			    other;
+		};
+
+		instrumented_allocator() = default;
+		instrumented_allocator(const Alloc &a) : Alloc(a) {}
+		template <typename U, typename A>
+		instrumented_allocator(const instrumented_allocator<U, A> &a) :
+		        Alloc(static_cast<const A &>(a)) {}
+
+		T *allocate(size_type n) {
+			T *ptr = Alloc::allocate(n);
+			alloc_stats::record_allocate<T>(n * sizeof(T));
+			return ptr;
+		}
+
+		void deallocate(T *ptr, size_type n) {
+			if (ptr == nullptr) return;
+			alloc_stats::record_deallocate<T>(n * sizeof(T));
+			Alloc::deallocate(ptr, n);
+		}
+	};
+
+}    // namespace leestl
+
+#endif
@@ -0,0 +1,172 @@
+/** @file alloc_traits.h
+ * 	这个文件实现配置器 traits，为容器提供统一的（有状态）配置器访问接口
+ */
+
+#ifndef _LEESTL_ALLOC_TRAITS_H_
+#define _LEESTL_ALLOC_TRAITS_H_ 1
+
+#include "construct.h"
+#include "type_traits.h"
+#include "utils.h"
+
+namespace leestl {
+
+	// 配置器成员类型的检测，成员不存在时使用默认类型
+	template <typename Alloc, typename Default, typename = void_type<>>
+	struct _alloc_pointer {
+		typedef Default type;
+	};
+
+	template <typename Alloc, typename Default>
+	struct _alloc_pointer<Alloc, Default, void_type<typename Alloc::pointer>> {
+		typedef typename Alloc::pointer type;
+	};
+
+	template <typename Alloc, typename = void_type<>>
+	struct _alloc_pocca {
+		typedef std::false_type type;
+	};
+
+	template <typename Alloc>
+	struct _alloc_pocca<Alloc, void_type<typename Alloc::propagate_on_container_copy_assignment>> {
+		typedef typename Alloc::propagate_on_container_copy_assignment type;
+	};
+
+	template <typename Alloc, typename = void_type<>>
+	struct _alloc_pocma {
+		typedef std::false_type type;
+	};
+
+	template <typename Alloc>
+	struct _alloc_pocma<Alloc, void_type<typename Alloc::propagate_on_container_move_assignment>> {
+		typedef typename Alloc::propagate_on_container_move_assignment type;
+	};
+
+	template <typename Alloc, typename = void_type<>>
+	struct _alloc_pocs {
+		typedef std::false_type type;
+	};
+
+	template <typename Alloc>
+	struct _alloc_pocs<Alloc, void_type<typename Alloc::propagate_on_container_swap>> {
+		typedef typename Alloc::propagate_on_container_swap type;
+	};
+
+	template <typename Alloc, typename = void_type<>>
+	struct _alloc_always_equal {
+		typedef typename std::is_empty<Alloc>::type type;
+	};
+
+	template <typename Alloc>
+	struct _alloc_always_equal<Alloc, void_type<typename Alloc::is_always_equal>> {
+		typedef typename Alloc::is_always_equal type;
+	};
+
+	// 配置器 rebind：优先使用 Alloc::rebind<U>::other，否则替换 Alloc<T, Args...> 的第一个模板参数
+	template <typename Alloc, typename U>
+	struct _alloc_rebind_template {};
+
+	template <template <typename, typename...> class Alloc, typename T, typename... Args, typename U>
+	struct _alloc_rebind_template<Alloc<T, Args...>, U> {
+		typedef Alloc<U, Args...> type;
+	};
+
+	template <typename Alloc, typename U, typename = void_type<>>
+	struct _alloc_rebind : _alloc_rebind_template<Alloc, U> {};
+
+	template <typename Alloc, typename U>
+	struct _alloc_rebind<Alloc, U, void_type<typename Alloc::template rebind<U>::other>> {
+		typedef typename Alloc::template rebind<U>::other type;
+	};
+
+	/**
+	 * @brief 配置器 traits，容器通过它访问配置器实例，从而同时支持
+	 * 	leestl::allocator 这样的无状态配置器与 arena、内存池等有状态配置器
+	 *
+	 * @tparam Alloc 配置器类型
+	 */
+	template <typename Alloc>
+	struct allocator_traits {
+		typedef Alloc                                                  allocator_type;
+		typedef typename Alloc::value_type                             value_type;
+		typedef typename _alloc_pointer<Alloc, value_type *>::type      pointer;
+		typedef size_t                                                 size_type;
+		typedef ptrdiff_t                                              difference_type;
+
+		typedef typename _alloc_pocca<Alloc>::type        propagate_on_container_copy_assignment;
+		typedef typename _alloc_pocma<Alloc>::type        propagate_on_container_move_assignment;
+		typedef typename _alloc_pocs<Alloc>::type         propagate_on_container_swap;
+		typedef typename _alloc_always_equal<Alloc>::type is_always_equal;
+
+		template <typename U>
+		using rebind_alloc = typename _alloc_rebind<Alloc, U>::type;
+
+		template <typename U>
+		using rebind_traits = allocator_traits<rebind_alloc<U>>;
+
+	private:
+		template <typename A, typename T, typename... Args>
+		static auto _construct(int, A &a, T *ptr, Args &&...args)
+		    -> decltype(a.construct(ptr, leestl::forward<Args>(args)...), void()) {
+			a.construct(ptr, leestl::forward<Args>(args)...);
+		}
+
+		template <typename A, typename T, typename... Args>
+		static void _construct(long, A &, T *ptr, Args &&...args) {
+			leestl::construct(ptr, leestl::forward<Args>(args)...);
+		}
+
+		template <typename A, typename T>
+		static auto _destroy(int, A &a, T *ptr) -> decltype(a.destroy(ptr), void()) {
+			a.destroy(ptr);
+		}
+
+		template <typename A, typename T>
+		static void _destroy(long, A &, T *ptr) {
+			leestl::destory(ptr);
+		}
+
+		template <typename A>
+		static auto _select(int, const A &a) -> decltype(a.select_on_container_copy_construction()) {
+			return a.select_on_container_copy_construction();
+		}
+
+		template <typename A>
+		static A _select(long, const A &a) {
+			return a;
+		}
+
+	public:
+		static pointer allocate(Alloc &a, size_type n) { return a.allocate(n); }
+
+		static void deallocate(Alloc &a, pointer ptr, size_type n) { a.deallocate(ptr, n); }
+
+		// 配置器提供 construct 时使用它，否则直接在 ptr 处构造
+		template <typename T, typename... Args>
+		static void construct(Alloc &a, T *ptr, Args &&...args) {
+			_construct(0, a, ptr, leestl::forward<Args>(args)...);
+		}
+
+		// 配置器提供 destroy 时使用它，否则直接调用析构函数
+		template <typename T>
+		static void destroy(Alloc &a, T *ptr) {
+			_destroy(0, a, ptr);
+		}
+
+		static constexpr size_type max_size(const Alloc &) noexcept {
+			return size_type(-1) / sizeof(value_type);
+		}
+
+		// 复制构造容器时获取新容器使用的配置器
+		static Alloc select_on_container_copy_construction(const Alloc &a) { return _select(0, a); }
+
+		// 判断两个配置器分配的内存能否互相释放
+		static bool equal(const Alloc &a, const Alloc &b) noexcept {
+			if constexpr (is_always_equal::value) return true;
+			else return a == b;
+		}
+	};
+
+}    // namespace leestl
+
+#endif
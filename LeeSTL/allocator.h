@@ -8,6 +8,10 @@
 #include "construct.h"
 #include "utils.h"
 
+#ifdef LEESTL_ALLOC_STATS
+#include "alloc_stats.h"
+#endif
+
 namespace leestl {
 
 	template <typename T>
@@ -21,7 +25,14 @@ namespace leestl {
 		typedef T&        reference;
 		typedef const T&  const_reference;
 
+		typedef std::true_type propagate_on_container_move_assignment;
+		typedef std::true_type is_always_equal;
+
 	public:
+		allocator() noexcept = default;
+		template <typename U>
+		allocator(const allocator<U>&) noexcept {}
+
 		static T* allocate();
 		static T* allocate(size_type n);
 
@@ -41,24 +52,36 @@ namespace leestl {
 
 	template <typename T>
 	T* allocator<T>::allocate() {
+#ifdef LEESTL_ALLOC_STATS
+		alloc_stats::record_allocate<T>(sizeof(T));
+#endif
 		return static_cast<T*>(::operator new(sizeof(T)));
 	}
 
 	template <typename T>
 	T* allocator<T>::allocate(size_type n) {
 		if (n == 0) return nullptr;
+#ifdef LEESTL_ALLOC_STATS
+		alloc_stats::record_allocate<T>(n * sizeof(T));
+#endif
 		return static_cast<T*>(::operator new(n * sizeof(T)));
 	}
 
 	template <typename T>
 	void allocator<T>::deallocate(T* ptr) {
 		if (ptr == nullptr) return;
+#ifdef LEESTL_ALLOC_STATS
+		alloc_stats::record_deallocate<T>(sizeof(T));
+#endif
 		::operator delete(ptr);
 	}
 
 	template <typename T>
 	void allocator<T>::deallocate(T* ptr, size_type n) {
 		if (ptr == nullptr) return;
+#ifdef LEESTL_ALLOC_STATS
+		alloc_stats::record_deallocate<T>(n * sizeof(T));
+#endif
 		::operator delete(ptr, n * sizeof(T));
 	}
 
@@ -93,6 +116,17 @@ namespace leestl {
 		leestl::destory(first, last);
 	}
 
+	// 无状态配置器，任意两个实例都可以互相释放对方分配的内存
+	template <typename T, typename U>
+	inline bool operator==(const allocator<T>&, const allocator<U>&) noexcept {
+		return true;
+	}
+
+	template <typename T, typename U>
+	inline bool operator!=(const allocator<T>&, const allocator<U>&) noexcept {
+		return false;
+	}
+
 }    // namespace leestl
 
 #endif
\ No newline at end of file
@@ -0,0 +1,88 @@
+/**
+ * @file binary_search.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief 从 L1 缓存大小到 4 倍末级缓存大小的有序数组上，各种 lower_bound 每次查询的耗时
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 编译: g++ -std=c++17 -O2 -I.. binary_search.cpp -o binary_search
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <unistd.h>
+
+#include "../LeeSTL/algo.h"
+#include "../LeeSTL/eytzinger_index.h"
+#include "../LeeSTL/vector.h"
+
+using std::cout;
+
+static std::mt19937_64 g_rng(20261018);
+
+// 返回每次查询的平均纳秒数，sink 防止查找被优化掉
+template <typename F>
+double measure(const std::vector<uint32_t> &queries, F lookup) {
+	size_t sink = 0;
+	auto   start = std::chrono::steady_clock::now();
+	sink += lookup();
+	double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	if (sink == size_t(-1)) cout << sink;
+	return t * 1e9 / double(queries.size());
+}
+
+int main() {
+	long llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+	if (llc <= 0) llc = 32L << 20;
+	const size_t queries_count = 1 << 22;
+
+	cout << "\n[===================================================================]\n";
+	cout << "[---------------------- binary search benchmark start ---------------------->\n";
+	cout << "uint32 keys, " << queries_count << " random queries, LLC " << (llc >> 20)
+	     << " MiB, ns/query\n";
+	for (size_t bytes = 32 << 10; bytes <= size_t(llc) * 4; bytes *= 2) {
+		const size_t          n = bytes / sizeof(uint32_t);
+		std::vector<uint32_t> keys(n), queries(queries_count);
+		for (size_t i = 0; i < n; ++i) keys[i] = uint32_t(g_rng());
+		std::sort(keys.begin(), keys.end());
+		for (uint32_t &q : queries) q = uint32_t(g_rng());
+		const uint32_t *f = keys.data(), *l = keys.data() + n;
+
+		leestl::eytzinger_index<uint32_t> index(f, l);
+		std::vector<const uint32_t *>     results(queries_count);
+
+		double std_lb = measure(queries, [&] {
+			size_t s = 0;
+			for (uint32_t q : queries) s += std::lower_bound(f, l, q) - f;
+			return s;
+		});
+		double lee_lb = measure(queries, [&] {
+			size_t s = 0;
+			for (uint32_t q : queries) s += leestl::lower_bound(f, l, q) - f;
+			return s;
+		});
+		double eyt = measure(queries, [&] {
+			size_t s = 0;
+			for (uint32_t q : queries) s += index.lower_bound(q) - index.begin();
+			return s;
+		});
+		double eyt_batch = measure(queries, [&] {
+			index.lower_bound(queries.data(), queries_count, results.data());
+			return size_t(results.back() - index.begin());
+		});
+		std::printf(
+		    "%8zu KiB  std::lower_bound %6.1f  leestl::lower_bound %6.1f  eytzinger %6.1f  "
+		    "eytzinger batch %6.1f\n",
+		    bytes >> 10, std_lb, lee_lb, eyt, eyt_batch);
+	}
+	cout << ">---------------------- binary search benchmark end ----------------------]\n";
+	return 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file btree_map.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief 有序映射表性能测试，比较 leestl::btree_map 与 std::map
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 键为随机的 uint64_t：随机插入、由有序区间构造、随机点查找（命中）、
+ * 完整顺序遍历、短范围遍历（lower_bound 后读取 100 个元素）、随机删除一半
+ * 编译: g++ -std=c++17 -O2 -I.. btree_map.cpp -o btree_map
+ * 运行: ./btree_map [元素个数，默认 10000000]
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "../LeeSTL/btree_map.h"
+
+static double now() {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch())
+	    .count();
+}
+
+static uint64_t sink = 0;
+
+struct result {
+	double insert, build, find, scan, range, erase;
+};
+
+template <typename Map>
+result run(const std::vector<uint64_t> &keys, const std::vector<uint64_t> &sorted,
+           const std::vector<uint64_t> &queries) {
+	result r;
+	double t = now();
+	{
+		Map m;
+		for (uint64_t k : keys) m.insert({k, k});
+		r.insert = (now() - t) * 1e9 / keys.size();
+	}
+
+	// 有序区间构造：std::map 的区间构造对有序输入同样是均摊 O(1)
+	std::vector<std::pair<const uint64_t, uint64_t>> pairs;
+	pairs.reserve(sorted.size());
+	for (uint64_t k : sorted) pairs.emplace_back(k, k);
+	t = now();
+	Map m(pairs.data(), pairs.data() + pairs.size());
+	r.build = (now() - t) * 1e9 / sorted.size();
+	std::vector<std::pair<const uint64_t, uint64_t>>().swap(pairs);
+
+	t = now();
+	for (uint64_t q : queries) sink += m.find(q)->second;
+	r.find = (now() - t) * 1e9 / queries.size();
+
+	t = now();
+	for (const auto &p : m) sink += p.second;
+	r.scan = (now() - t) * 1e9 / m.size();
+
+	const size_t ranges = queries.size() / 10;
+	t = now();
+	for (size_t i = 0; i < ranges; ++i) {
+		auto it = m.lower_bound(queries[i]);
+		for (int j = 0; j < 100 && it != m.end(); ++j, ++it) sink += it->second;
+	}
+	r.range = (now() - t) * 1e9 / ranges;
+
+	t = now();
+	for (size_t i = 0; i < keys.size(); i += 2) m.erase(keys[i]);
+	r.erase = (now() - t) * 1e9 / (keys.size() / 2);
+	return r;
+}
+
+int main(int argc, char **argv) {
+	size_t n = 10000000;
+	if (argc > 1) n = std::strtoul(argv[1], nullptr, 10);
+
+	std::mt19937_64       rng(2026);
+	std::vector<uint64_t> keys(n);
+	for (auto &k : keys) k = rng();
+	std::vector<uint64_t> sorted(keys);
+	std::sort(sorted.begin(), sorted.end());
+	sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+	std::vector<uint64_t> queries(n < 2000000 ? n : 2000000);
+	for (auto &q : queries) q = keys[rng() % n];
+
+	std::printf("elements: %zu, lookups: %zu, node bytes: %d\n", n, queries.size(),
+	            leestl::_BTREE_NODE_BYTES);
+	const result a = run<std::map<uint64_t, uint64_t>>(keys, sorted, queries);
+	const result b = run<leestl::btree_map<uint64_t, uint64_t>>(keys, sorted, queries);
+	std::printf("%-26s %14s %16s %8s\n", "", "std::map", "leestl::btree", "speedup");
+	auto row = [](const char *name, double x, double y) {
+		std::printf("%-26s %11.1f ns %13.1f ns %7.2fx\n", name, x, y, x / y);
+	};
+	row("random insert / elem", a.insert, b.insert);
+	row("build from sorted / elem", a.build, b.build);
+	row("point lookup", a.find, b.find);
+	row("full scan / elem", a.scan, b.scan);
+	row("range of 100", a.range, b.range);
+	row("random erase", a.erase, b.erase);
+	if (sink == 42) std::printf(" ");
+	return 0;
+}
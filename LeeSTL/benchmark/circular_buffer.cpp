@@ -0,0 +1,151 @@
+/**
+ * @file circular_buffer.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief 环形缓冲区性能测试，比较 leestl::circular_buffer 与作为滑动窗口使用的 std::deque
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 元素为 uint64_t，窗口长度固定：逐个写入并淘汰最旧元素、按块批量写入与批量取出、
+ * 窗口内随机下标访问、用迭代器或按两段连续区间遍历整个窗口
+ * 编译: g++ -std=c++17 -O2 -I.. circular_buffer.cpp -o circular_buffer
+ * 运行: ./circular_buffer [写入元素个数，默认 20000000] [窗口长度，默认 4096] [块大小，默认 256]
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "../LeeSTL/circular_buffer.h"
+
+static double now() {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch())
+	    .count();
+}
+
+static uint64_t sink = 0;
+
+struct result {
+	double push, bulk, random, scan, segments;
+};
+
+// std::deque 当作滑动窗口：尾部写入，超过窗口长度时从头部淘汰
+struct std_window {
+	std::deque<uint64_t> d;
+	size_t               window;
+
+	explicit std_window(size_t w) : window(w) {}
+
+	void push(uint64_t x) {
+		d.push_back(x);
+		if (d.size() > window) d.pop_front();
+	}
+	void push_chunk(const uint64_t *first, const uint64_t *last) {
+		d.insert(d.end(), first, last);
+		if (d.size() > window) d.erase(d.begin(), d.begin() + (d.size() - window));
+	}
+	void pop_chunk(uint64_t *out, size_t n) {
+		std::copy(d.begin(), d.begin() + n, out);
+		d.erase(d.begin(), d.begin() + n);
+	}
+	uint64_t operator[](size_t i) const { return d[i]; }
+	template <typename F>
+	void for_each(F f) const {
+		for (uint64_t x : d) f(x);
+	}
+	template <typename F>
+	void for_each_segment(F f) const {
+		for_each(f);
+	}
+};
+
+struct lee_window {
+	leestl::circular_buffer<uint64_t> b;
+
+	explicit lee_window(size_t w) : b(w) {}
+
+	void push(uint64_t x) { b.push_back(x); }
+	void push_chunk(const uint64_t *first, const uint64_t *last) { b.push_back(first, last); }
+	void pop_chunk(uint64_t *out, size_t n) { b.pop_front(n, out); }
+	uint64_t operator[](size_t i) const { return b[i]; }
+	template <typename F>
+	void for_each(F f) const {
+		for (uint64_t x : b) f(x);
+	}
+	// 按 array_one()/array_two() 两段连续区间遍历
+	template <typename F>
+	void for_each_segment(F f) const {
+		auto one = b.array_one(), two = b.array_two();
+		for (size_t i = 0; i < one.second; ++i) f(one.first[i]);
+		for (size_t i = 0; i < two.second; ++i) f(two.first[i]);
+	}
+};
+
+template <typename Window>
+result run(size_t n, size_t window, size_t chunk, const std::vector<uint32_t> &indices) {
+	result r;
+	Window w(window);
+
+	double t = now();
+	for (size_t i = 0; i < n; ++i) w.push(i);
+	r.push = (now() - t) * 1e9 / n;
+
+	// 生产者按块写入，消费者每写入两块取出一块，窗口保持满
+	std::vector<uint64_t> in(chunk), out(chunk);
+	for (size_t i = 0; i < chunk; ++i) in[i] = i;
+	t = now();
+	for (size_t i = 0; i < n / chunk; ++i) {
+		w.push_chunk(in.data(), in.data() + chunk);
+		if (i % 2) w.pop_chunk(out.data(), chunk), sink += out[0];
+	}
+	r.bulk = (now() - t) * 1e9 / (n / chunk * chunk);
+
+	for (size_t i = 0; i < window; ++i) w.push(i);
+	t = now();
+	for (uint32_t i : indices) sink += w[i];
+	r.random = (now() - t) * 1e9 / indices.size();
+
+	const size_t rounds = n / window;
+	uint64_t     sum = 0;
+	t = now();
+	for (size_t i = 0; i < rounds; ++i) w.for_each([&sum](uint64_t x) { sum += x; });
+	r.scan = (now() - t) * 1e9 / (rounds * window);
+
+	t = now();
+	for (size_t i = 0; i < rounds; ++i) w.for_each_segment([&sum](uint64_t x) { sum += x; });
+	r.segments = (now() - t) * 1e9 / (rounds * window);
+	sink += sum;
+	return r;
+}
+
+int main(int argc, char **argv) {
+	size_t n = 20000000, window = 4096, chunk = 256;
+	if (argc > 1) n = std::strtoul(argv[1], nullptr, 10);
+	if (argc > 2) window = std::strtoul(argv[2], nullptr, 10);
+	if (argc > 3) chunk = std::strtoul(argv[3], nullptr, 10);
+
+	std::mt19937          rng(2026);
+	std::vector<uint32_t> indices(n < 2000000 ? n : 2000000);
+	for (auto &i : indices) i = rng() % window;
+
+	std::printf("elements: %zu, window: %zu, chunk: %zu\n", n, window, chunk);
+	const result a = run<std_window>(n, window, chunk, indices);
+	const result b = run<lee_window>(n, window, chunk, indices);
+	std::printf("%-24s %14s %18s %8s\n", "", "std::deque", "circular_buffer", "speedup");
+	auto row = [](const char *name, double x, double y) {
+		std::printf("%-24s %11.2f ns %15.2f ns %7.2fx\n", name, x, y, x / y);
+	};
+	row("push + evict / elem", a.push, b.push);
+	row("chunk push/pop / elem", a.bulk, b.bulk);
+	row("random index", a.random, b.random);
+	row("iterator scan / elem", a.scan, b.scan);
+	row("segment scan / elem", a.segments, b.segments);
+	if (sink == 42) std::printf(" ");
+	return 0;
+}
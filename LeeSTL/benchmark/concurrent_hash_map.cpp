@@ -0,0 +1,122 @@
+/**
+ * @file concurrent_hash_map.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief 多线程哈希表吞吐量测试，比较 leestl::concurrent_hash_map 与一把互斥锁保护的
+ * 	std::unordered_map
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 读多负载：95% 查找，5% insert_or_assign；写多负载：50% 查找，25% insert_or_assign，25% 删除。
+ * 键在 [0, 2 * 预填充个数) 中均匀随机，查找约一半命中
+ * 编译: g++ -std=c++17 -O2 -pthread -I.. concurrent_hash_map.cpp -o concurrent_hash_map
+ * 运行: ./concurrent_hash_map [最大线程数]
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../LeeSTL/concurrent_hash_map.h"
+
+static const uint64_t kPrefill = 1 << 20;
+static const size_t   kOpsPerThread = 2000000;
+
+// 一把互斥锁保护的 std::unordered_map
+struct locked_map {
+	std::mutex                             lock;
+	std::unordered_map<uint64_t, uint64_t> map;
+
+	void insert_or_assign(uint64_t k, uint64_t v) {
+		std::lock_guard<std::mutex> guard(lock);
+		map[k] = v;
+	}
+	bool find(uint64_t k, uint64_t &out) {
+		std::lock_guard<std::mutex> guard(lock);
+		auto                        it = map.find(k);
+		if (it == map.end()) return false;
+		out = it->second;
+		return true;
+	}
+	void erase(uint64_t k) {
+		std::lock_guard<std::mutex> guard(lock);
+		map.erase(k);
+	}
+};
+
+static uint64_t xorshift(uint64_t &s) {
+	s ^= s << 13;
+	s ^= s >> 7;
+	s ^= s << 17;
+	return s;
+}
+
+// 每个线程执行 kOpsPerThread 次操作，read_pct% 查找，其余插入与删除各半，返回 Mops/s
+template <typename Map>
+double run(Map &m, size_t threads, unsigned read_pct) {
+	std::vector<std::thread> pool;
+	uint64_t                 sink = 0;
+	std::mutex               sink_lock;
+	auto                     start = std::chrono::steady_clock::now();
+	for (size_t t = 0; t < threads; ++t) {
+		pool.emplace_back([&, t] {
+			uint64_t s = 0x9E3779B97F4A7C15ull * (t + 1), found = 0, v = 0;
+			for (size_t i = 0; i < kOpsPerThread; ++i) {
+				const uint64_t r = xorshift(s);
+				const uint64_t key = (r >> 8) % (2 * kPrefill);
+				const unsigned op = unsigned(r % 100);
+				if (op < read_pct) found += m.find(key, v);
+				else if ((op - read_pct) % 2 == 0) m.insert_or_assign(key, r);
+				else m.erase(key);
+			}
+			std::lock_guard<std::mutex> guard(sink_lock);
+			sink += found + v;
+		});
+	}
+	for (auto &th : pool) th.join();
+	const double sec =
+	    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	if (sink == 1) std::printf(" ");
+	return double(threads * kOpsPerThread) / sec / 1e6;
+}
+
+template <typename Map>
+void prefill(Map &m) {
+	for (uint64_t k = 0; k < 2 * kPrefill; k += 2) m.insert_or_assign(k, k);
+}
+
+int main(int argc, char **argv) {
+	size_t max_threads = std::thread::hardware_concurrency();
+	if (argc > 1) max_threads = std::strtoul(argv[1], nullptr, 10);
+	if (max_threads == 0) max_threads = 1;
+
+	std::printf("hardware threads: %u, prefill: %llu, ops per thread: %zu\n",
+	            std::thread::hardware_concurrency(), (unsigned long long)kPrefill, kOpsPerThread);
+	const struct {
+		const char *name;
+		unsigned    read_pct;
+	} workloads[] = {{"read-heavy 95/5", 95}, {"write-heavy 50/50", 50}};
+	for (const auto &w : workloads) {
+		std::printf("\n%s (Mops/s)\n", w.name);
+		std::printf("%8s %20s %20s %8s\n", "threads", "mutex+unordered_map", "concurrent_hash_map",
+		            "speedup");
+		for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+			locked_map a;
+			prefill(a);
+			leestl::concurrent_hash_map<uint64_t, uint64_t> b;
+			b.reserve(2 * kPrefill);
+			prefill(b);
+			const double ta = run(a, threads, w.read_pct);
+			const double tb = run(b, threads, w.read_pct);
+			std::printf("%8zu %20.2f %20.2f %7.2fx\n", threads, ta, tb, tb / ta);
+		}
+	}
+	return 0;
+}
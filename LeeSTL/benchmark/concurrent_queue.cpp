@@ -0,0 +1,190 @@
+/**
+ * @file concurrent_queue.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief 线程间队列性能测试，比较 leestl::spsc_queue、leestl::mpmc_queue 与一把互斥锁保护的
+ * 	std::deque
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 吞吐量：若干生产者共写入固定个数的 uint64_t，若干消费者全部取出，逐个或按批（批大小 32）操作，
+ * 队列容量 4096；spsc_queue 只测一个生产者、一个消费者。
+ * 延迟：生产者每写入一个带时间戳的元素就让出时间片，使队列保持很浅，消费者记录从写入到取出的
+ * 时间，输出 50%、99%、99.9% 分位数
+ * 编译: g++ -std=c++17 -O2 -pthread -I.. concurrent_queue.cpp -o concurrent_queue
+ * 运行: ./concurrent_queue [元素个数，默认 4000000] [最大线程数（生产者与消费者各自），默认 4]
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../LeeSTL/concurrent_queue.h"
+
+static const size_t kCapacity = 4096;
+static const size_t kBatch = 32;
+
+static uint64_t now_ns() {
+	return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+	                    std::chrono::steady_clock::now().time_since_epoch())
+	                    .count());
+}
+
+// 一把互斥锁保护的有界 std::deque，批量操作在一次加锁内完成
+struct locked_queue {
+	std::mutex           lock;
+	std::deque<uint64_t> q;
+
+	explicit locked_queue(size_t) {}
+
+	bool try_push(uint64_t x) { return try_push_n(&x, 1) == 1; }
+	bool try_pop(uint64_t &x) { return try_pop_n(&x, 1) == 1; }
+	size_t try_push_n(const uint64_t *first, size_t n) {
+		std::lock_guard<std::mutex> guard(lock);
+		n = std::min(n, kCapacity - q.size());
+		q.insert(q.end(), first, first + n);
+		return n;
+	}
+	size_t try_pop_n(uint64_t *out, size_t n) {
+		std::lock_guard<std::mutex> guard(lock);
+		n = std::min(n, q.size());
+		std::copy(q.begin(), q.begin() + n, out);
+		q.erase(q.begin(), q.begin() + n);
+		return n;
+	}
+};
+
+/**
+ * @brief 生产者共写入 total 个元素，消费者全部取出
+ *
+ * @param batch 每次操作的元素个数，为 1 时使用 try_push/try_pop
+ * @param on_pop 消费者每取出一个元素调用一次，参数为元素与消费者编号
+ * @param pace 生产者每写入一批后是否让出时间片
+ * @return double 耗时（秒）
+ */
+template <typename Queue, typename OnPop>
+double transfer(
+    size_t producers, size_t consumers, size_t total, size_t batch, OnPop on_pop, bool pace) {
+	Queue                    q(kCapacity);
+	std::atomic<size_t>      consumed{0};
+	std::vector<std::thread> pool;
+	const auto               start = std::chrono::steady_clock::now();
+	for (size_t p = 0; p < producers; ++p) {
+		pool.emplace_back([&, p] {
+			std::vector<uint64_t> buf(batch);
+			const size_t          n = total / producers + (p < total % producers);
+			for (size_t i = 0; i < n;) {
+				const size_t len = std::min(batch, n - i);
+				size_t       done = 0;
+				while (done < len) {
+					size_t k;
+					if (batch == 1) {
+						k = q.try_push(pace ? now_ns() : i);
+					} else {
+						for (size_t j = done; j < len; ++j) buf[j] = pace ? now_ns() : i + j;
+						k = q.try_push_n(buf.data() + done, len - done);
+					}
+					if (k == 0) std::this_thread::yield();
+					done += k;
+				}
+				i += len;
+				if (pace) std::this_thread::yield();
+			}
+		});
+	}
+	for (size_t c = 0; c < consumers; ++c) {
+		pool.emplace_back([&, c] {
+			std::vector<uint64_t> buf(batch);
+			while (consumed.load(std::memory_order_relaxed) < total) {
+				size_t got;
+				if (batch == 1) got = q.try_pop(buf[0]);
+				else got = q.try_pop_n(buf.data(), batch);
+				for (size_t i = 0; i < got; ++i) on_pop(buf[i], c);
+				if (got == 0) std::this_thread::yield();
+				else consumed.fetch_add(got, std::memory_order_relaxed);
+			}
+		});
+	}
+	for (auto &t : pool) t.join();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 吞吐量，单位百万元素每秒
+template <typename Queue>
+double throughput(size_t producers, size_t consumers, size_t total, size_t batch) {
+	auto ignore = [](uint64_t, size_t) {};
+	return total / transfer<Queue>(producers, consumers, total, batch, ignore, false) / 1e6;
+}
+
+struct percentiles {
+	double p50, p99, p999;
+};
+
+// 从写入到取出的延迟分位数，单位纳秒
+template <typename Queue>
+percentiles latency(size_t producers, size_t consumers, size_t total) {
+	std::vector<std::vector<uint64_t>> samples(consumers);
+	for (auto &s : samples) s.reserve(total);
+	auto record = [&](uint64_t stamp, size_t c) { samples[c].push_back(now_ns() - stamp); };
+	transfer<Queue>(producers, consumers, total, 1, record, true);
+	std::vector<uint64_t> all;
+	for (auto &s : samples) all.insert(all.end(), s.begin(), s.end());
+	std::sort(all.begin(), all.end());
+	auto at = [&](double q) { return double(all[size_t(q * (all.size() - 1))]); };
+	return percentiles{at(0.5), at(0.99), at(0.999)};
+}
+
+int main(int argc, char **argv) {
+	size_t total = 4000000, max_threads = 4;
+	if (argc > 1) total = std::strtoul(argv[1], nullptr, 10);
+	if (argc > 2) max_threads = std::strtoul(argv[2], nullptr, 10);
+	typedef leestl::spsc_queue<uint64_t> spsc;
+	typedef leestl::mpmc_queue<uint64_t> mpmc;
+
+	std::printf(
+	    "elements: %zu, capacity: %zu, batch: %zu, hardware threads: %u\n", total, kCapacity,
+	    kBatch, std::thread::hardware_concurrency());
+	std::printf("\nthroughput (Mops/s)\n");
+	std::printf(
+	    "%-10s %10s %10s %10s %10s %10s %10s\n", "", "locked", "locked/32", "spsc", "spsc/32",
+	    "mpmc", "mpmc/32");
+	for (size_t t = 1; t <= max_threads; t *= 2) {
+		char name[16];
+		std::snprintf(name, sizeof(name), "%zup%zuc", t, t);
+		std::printf(
+		    "%-10s %10.2f %10.2f", name, throughput<locked_queue>(t, t, total, 1),
+		    throughput<locked_queue>(t, t, total, kBatch));
+		if (t == 1)
+			std::printf(
+			    " %10.2f %10.2f", throughput<spsc>(1, 1, total, 1),
+			    throughput<spsc>(1, 1, total, kBatch));
+		else std::printf(" %10s %10s", "-", "-");
+		std::printf(
+		    " %10.2f %10.2f\n", throughput<mpmc>(t, t, total, 1),
+		    throughput<mpmc>(t, t, total, kBatch));
+	}
+
+	const size_t samples = std::min(total, size_t(200000));
+	std::printf("\nlatency (ns), %zu samples\n", samples);
+	std::printf("%-18s %10s %10s %10s\n", "", "p50", "p99", "p99.9");
+	auto row = [](const char *name, percentiles p) {
+		std::printf("%-18s %10.0f %10.0f %10.0f\n", name, p.p50, p.p99, p.p999);
+	};
+	row("locked 1p1c", latency<locked_queue>(1, 1, samples));
+	row("spsc 1p1c", latency<spsc>(1, 1, samples));
+	row("mpmc 1p1c", latency<mpmc>(1, 1, samples));
+	if (max_threads >= 2) {
+		row("locked 2p2c", latency<locked_queue>(2, 2, samples));
+		row("mpmc 2p2c", latency<mpmc>(2, 2, samples));
+	}
+	return 0;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file concurrent_vector.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief 分段向量性能测试，比较 leestl::concurrent_vector 与 std::vector
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 追加：若干线程共追加固定个数的 uint64_t，std::vector 由一把互斥锁保护，逐个或按批（32 个）
+ * 追加；concurrent_vector 用 push_back 或 grow_by 无锁追加。单线程时另测不加锁的 std::vector。
+ * 访问：单线程随机下标读取与迭代器顺序遍历
+ * 编译: g++ -std=c++17 -O2 -pthread -I.. concurrent_vector.cpp -o concurrent_vector
+ * 运行: ./concurrent_vector [元素个数，默认 20000000] [最大线程数，默认 4]
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../LeeSTL/concurrent_vector.h"
+
+static const size_t kBatch = 32;
+
+static double now() {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch())
+	    .count();
+}
+
+static uint64_t sink = 0;
+
+// 一把互斥锁保护的 std::vector，批量追加在一次加锁内完成
+struct locked_vector {
+	std::mutex            lock;
+	std::vector<uint64_t> v;
+
+	void append(const uint64_t *first, size_t n) {
+		std::lock_guard<std::mutex> guard(lock);
+		v.insert(v.end(), first, first + n);
+	}
+};
+
+struct lee_vector {
+	leestl::concurrent_vector<uint64_t> v;
+
+	void append(const uint64_t *first, size_t n) {
+		if (n == 1) v.push_back(*first);
+		else v.grow_by(first, first + n);
+	}
+};
+
+/**
+ * @brief threads 个线程共追加 total 个元素
+ *
+ * @param batch 每次追加的元素个数
+ * @return double 每个元素的耗时（纳秒）
+ */
+template <typename Vector>
+double append(size_t threads, size_t total, size_t batch) {
+	Vector                   c;
+	std::vector<std::thread> pool;
+	const double             t = now();
+	for (size_t p = 0; p < threads; ++p) {
+		pool.emplace_back([&, p] {
+			std::vector<uint64_t> buf(batch);
+			const size_t          n = total / threads + (p < total % threads);
+			for (size_t i = 0; i < n; i += batch) {
+				const size_t len = n - i < batch ? n - i : batch;
+				for (size_t j = 0; j < len; ++j) buf[j] = i + j;
+				c.append(buf.data(), len);
+			}
+		});
+	}
+	for (auto &th : pool) th.join();
+	const double elapsed = now() - t;
+	sink += c.v.size();
+	return elapsed * 1e9 / total;
+}
+
+// 不加锁的 std::vector 单线程逐个追加
+double plain_push_back(size_t total) {
+	std::vector<uint64_t> v;
+	const double          t = now();
+	for (size_t i = 0; i < total; ++i) v.push_back(i);
+	const double elapsed = now() - t;
+	sink += v.size();
+	return elapsed * 1e9 / total;
+}
+
+struct access_result {
+	double random, scan;
+};
+
+template <typename Vector>
+access_result access(const Vector &v, const std::vector<uint32_t> &indices) {
+	access_result r;
+	double        t = now();
+	for (uint32_t i : indices) sink += v[i];
+	r.random = (now() - t) * 1e9 / indices.size();
+	uint64_t sum = 0;
+	t = now();
+	for (auto it = v.begin(), last = v.end(); it != last; ++it) sum += *it;
+	r.scan = (now() - t) * 1e9 / v.size();
+	sink += sum;
+	return r;
+}
+
+int main(int argc, char **argv) {
+	size_t total = 20000000, max_threads = 4;
+	if (argc > 1) total = std::strtoul(argv[1], nullptr, 10);
+	if (argc > 2) max_threads = std::strtoul(argv[2], nullptr, 10);
+
+	std::printf(
+	    "elements: %zu, batch: %zu, hardware threads: %u\n", total, kBatch,
+	    std::thread::hardware_concurrency());
+	std::printf("\nappend (ns / elem)\n");
+	std::printf(
+	    "%-10s %12s %12s %12s %12s %12s\n", "threads", "vector", "locked", "locked/32",
+	    "push_back", "grow_by/32");
+	for (size_t t = 1; t <= max_threads; t *= 2) {
+		std::printf("%-10zu ", t);
+		if (t == 1) std::printf("%12.2f ", plain_push_back(total));
+		else std::printf("%12s ", "-");
+		std::printf(
+		    "%12.2f %12.2f %12.2f %12.2f\n", append<locked_vector>(t, total, 1),
+		    append<locked_vector>(t, total, kBatch), append<lee_vector>(t, total, 1),
+		    append<lee_vector>(t, total, kBatch));
+	}
+
+	std::vector<uint64_t>               a;
+	leestl::concurrent_vector<uint64_t> b;
+	for (size_t i = 0; i < total; ++i) a.push_back(i), b.push_back(i);
+	std::mt19937          rng(2026);
+	std::vector<uint32_t> indices(total < 5000000 ? total : 5000000);
+	for (auto &i : indices) i = uint32_t(rng() % total);
+	const access_result x = access(a, indices);
+	const access_result y = access(b, indices);
+
+	std::printf("\n%-24s %14s %18s %8s\n", "access", "std::vector", "concurrent_vector", "ratio");
+	auto row = [](const char *name, double p, double q) {
+		std::printf("%-24s %11.2f ns %15.2f ns %7.2fx\n", name, p, q, p / q);
+	};
+	row("random index", x.random, y.random);
+	row("iterator scan / elem", x.scan, y.scan);
+	if (sink == 42) std::printf(" ");
+	return 0;
+}
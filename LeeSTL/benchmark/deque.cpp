@@ -0,0 +1,100 @@
+/**
+ * @file deque.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief 双端队列性能测试，比较 leestl::deque 与 std::deque
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 元素为 uint64_t：尾部追加、头部插入、先进先出队列（长度保持在 队列长度 附近，
+ * 测试空闲块回收）、随机下标访问、顺序遍历
+ * 编译: g++ -std=c++17 -O2 -I.. deque.cpp -o deque
+ * 运行: ./deque [元素个数，默认 10000000] [队列长度，默认 10000]
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "../LeeSTL/deque.h"
+
+static double now() {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch())
+	    .count();
+}
+
+static uint64_t sink = 0;
+
+struct result {
+	double push_back, push_front, fifo, random, scan;
+};
+
+template <typename Deque>
+result run(size_t n, size_t queue_len, const std::vector<uint32_t> &indices) {
+	result r;
+	double t = now();
+	{
+		Deque d;
+		for (size_t i = 0; i < n; ++i) d.push_front(i);
+		r.push_front = (now() - t) * 1e9 / n;
+	}
+
+	// 生产者-消费者：每次追加一个元素、取出一个元素
+	t = now();
+	{
+		Deque q;
+		for (size_t i = 0; i < queue_len; ++i) q.push_back(i);
+		for (size_t i = 0; i < n; ++i) {
+			q.push_back(i);
+			sink += q.front();
+			q.pop_front();
+		}
+	}
+	r.fifo = (now() - t) * 1e9 / n;
+
+	t = now();
+	Deque d;
+	for (size_t i = 0; i < n; ++i) d.push_back(i);
+	r.push_back = (now() - t) * 1e9 / n;
+
+	t = now();
+	for (uint32_t i : indices) sink += d[i];
+	r.random = (now() - t) * 1e9 / indices.size();
+
+	t = now();
+	for (auto it = d.begin(); it != d.end(); ++it) sink += *it;
+	r.scan = (now() - t) * 1e9 / n;
+	return r;
+}
+
+int main(int argc, char **argv) {
+	size_t n = 10000000, queue_len = 10000;
+	if (argc > 1) n = std::strtoul(argv[1], nullptr, 10);
+	if (argc > 2) queue_len = std::strtoul(argv[2], nullptr, 10);
+
+	std::mt19937          rng(2026);
+	std::vector<uint32_t> indices(n < 2000000 ? n : 2000000);
+	for (auto &i : indices) i = rng() % n;
+
+	std::printf("elements: %zu, queue length: %zu, block elements: %zu\n", n, queue_len,
+	            leestl::deque<uint64_t>::BLOCK_SIZE);
+	const result a = run<std::deque<uint64_t>>(n, queue_len, indices);
+	const result b = run<leestl::deque<uint64_t>>(n, queue_len, indices);
+	std::printf("%-22s %14s %16s %8s\n", "", "std::deque", "leestl::deque", "speedup");
+	auto row = [](const char *name, double x, double y) {
+		std::printf("%-22s %11.2f ns %13.2f ns %7.2fx\n", name, x, y, x / y);
+	};
+	row("push_back / elem", a.push_back, b.push_back);
+	row("push_front / elem", a.push_front, b.push_front);
+	row("fifo push+pop / elem", a.fifo, b.fifo);
+	row("random index", a.random, b.random);
+	row("scan / elem", a.scan, b.scan);
+	if (sink == 42) std::printf(" ");
+	return 0;
+}
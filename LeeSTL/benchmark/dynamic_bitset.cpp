@@ -0,0 +1,144 @@
+/**
+ * @file dynamic_bitset.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief 位数组性能测试，比较 leestl::dynamic_bitset 与 std::vector<bool>
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 两个随机过滤掩码（密度 50% 与 1%）：计数、按位与、差集、用 find_next 或 for_each_set
+ * 遍历全部为 1 的位（std::vector<bool> 两项都是逐位检查）；
+ * dynamic_bitset 分别在标量（simd::set_isa(ISA_SCALAR)）与 CPU 支持的最高指令集下测试。
+ * 另测 bitset_rank_index 上随机 rank、select 查询的耗时
+ * 编译: g++ -std=c++17 -O2 -I.. dynamic_bitset.cpp -o dynamic_bitset
+ * 运行: ./dynamic_bitset [位数，默认 32000000]
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "../LeeSTL/dynamic_bitset.h"
+
+static double now() {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch())
+	    .count();
+}
+
+static uint64_t sink = 0;
+
+typedef leestl::dynamic_bitset<> bitset;
+
+struct result {
+	double count, and_, andnot, scan, visit;
+};
+
+// 每项重复 rounds 次，结果为每次的毫秒数
+template <typename F>
+static double timed(size_t rounds, F f) {
+	const double t = now();
+	for (size_t r = 0; r < rounds; ++r) f();
+	return (now() - t) * 1e3 / rounds;
+}
+
+result run_vector_bool(const std::vector<bool> &a, const std::vector<bool> &b, size_t rounds) {
+	result            r;
+	const size_t      n = a.size();
+	std::vector<bool> c(n);
+	r.count = timed(rounds, [&] { sink += size_t(std::count(a.begin(), a.end(), true)); });
+	r.and_ = timed(rounds, [&] {
+		for (size_t i = 0; i < n; ++i) c[i] = a[i] && b[i];
+	});
+	r.andnot = timed(rounds, [&] {
+		for (size_t i = 0; i < n; ++i) c[i] = a[i] && !b[i];
+	});
+	sink += c[n / 2];
+	r.scan = timed(rounds, [&] {
+		for (size_t i = 0; i < n; ++i)
+			if (b[i]) sink += i;
+	});
+	r.visit = r.scan;
+	return r;
+}
+
+result run_bitset(const bitset &a, const bitset &b, size_t rounds, leestl::simd::isa level) {
+	leestl::simd::set_isa(level);
+	result r;
+	bitset c(a);
+	r.count = timed(rounds, [&] { sink += a.count(); });
+	r.and_ = timed(rounds, [&] { c &= b; });
+	r.andnot = timed(rounds, [&] { c -= b; });
+	sink += c.count();
+	r.scan = timed(rounds, [&] {
+		for (size_t i = b.find_first(); i != bitset::npos; i = b.find_next(i)) sink += i;
+	});
+	r.visit = timed(rounds, [&] { b.for_each_set([](size_t i) { sink += i; }); });
+	leestl::simd::set_isa(leestl::simd::detected_isa());
+	return r;
+}
+
+// 随机 rank 与 select 查询，每次查询的纳秒数
+void run_rank_select(const bitset &a, leestl::simd::isa level, double &rank, double &select) {
+	leestl::simd::set_isa(level);
+	leestl::bitset_rank_index<> index(a);
+	std::mt19937_64             rng(2026);
+	std::vector<size_t>         pos(1 << 20), ks(1 << 20);
+	for (size_t i = 0; i < pos.size(); ++i) {
+		pos[i] = rng() % a.size();
+		ks[i] = rng() % index.ones();
+	}
+	double t = now();
+	for (size_t p : pos) sink += index.rank(p);
+	rank = (now() - t) * 1e9 / pos.size();
+	t = now();
+	for (size_t k : ks) sink += index.select(k);
+	select = (now() - t) * 1e9 / ks.size();
+	leestl::simd::set_isa(leestl::simd::detected_isa());
+}
+
+int main(int argc, char **argv) {
+	size_t n = 32000000;
+	if (argc > 1) n = std::strtoul(argv[1], nullptr, 10);
+	const size_t rounds = 10;
+
+	std::mt19937_64   rng(2026);
+	std::vector<bool> va(n), vb(n);
+	bitset            a(n), b(n);
+	for (size_t i = 0; i < n; ++i) {
+		const uint64_t x = rng();
+		if (x & 1) va[i] = true, a[i] = true;
+		if ((x >> 8) % 100 == 0) vb[i] = true, b[i] = true;
+	}
+
+	const leestl::simd::isa best = leestl::simd::detected_isa();
+	std::printf("bits: %zu, density: 50%% and 1%%, isa: %s\n", n, leestl::simd::isa_name(best));
+	const result x = run_vector_bool(va, vb, rounds);
+	const result y = run_bitset(a, b, rounds, leestl::simd::ISA_SCALAR);
+	const result z = run_bitset(a, b, rounds, best);
+	std::printf(
+	    "%-20s %14s %14s %14s %8s\n", "", "vector<bool>", "bitset scalar", "bitset simd",
+	    "speedup");
+	auto row = [](const char *name, double p, double q, double s) {
+		std::printf("%-20s %11.3f ms %11.3f ms %11.3f ms %7.1fx\n", name, p, q, s, p / s);
+	};
+	row("count", x.count, y.count, z.count);
+	row("a &= b", x.and_, y.and_, z.and_);
+	row("a -= b (andnot)", x.andnot, y.andnot, z.andnot);
+	row("find_next 1% bits", x.scan, y.scan, z.scan);
+	row("for_each_set 1% bits", x.visit, y.visit, z.visit);
+
+	double rank_scalar, select_scalar, rank_best, select_best;
+	run_rank_select(a, leestl::simd::ISA_SCALAR, rank_scalar, select_scalar);
+	run_rank_select(a, best, rank_best, select_best);
+	std::printf("\n%-20s %14s %14s\n", "rank/select", "scalar", leestl::simd::isa_name(best));
+	std::printf("%-20s %11.2f ns %11.2f ns\n", "rank", rank_scalar, rank_best);
+	std::printf("%-20s %11.2f ns %11.2f ns\n", "select", select_scalar, select_best);
+	if (sink == 42) std::printf(" ");
+	return 0;
+}
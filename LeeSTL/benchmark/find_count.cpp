@@ -0,0 +1,88 @@
+/**
+ * @file find_count.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::find、count、mismatch 在各指令集内核下与 std 版本的扫描带宽
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 编译: g++ -std=c++17 -O2 -I.. find_count.cpp -o find_count
+ * 运行: ./find_count [最大字节数，默认 64 MiB]
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../LeeSTL/algo.h"
+
+using std::cout;
+
+// 防止编译器把扫描优化掉
+static volatile size_t g_sink;
+
+// 重复运行 f 直到累计扫描约 1 GiB，返回 GB/s
+template <typename F>
+double measure(size_t bytes, F f) {
+	const size_t iters = bytes >= (size_t(1) << 30) ? 1 : (size_t(1) << 30) / bytes;
+	g_sink = f();
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < iters; ++i) g_sink = f();
+	double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return double(bytes) * double(iters) / sec / 1e9;
+}
+
+// 对 std 版本和各指令集下的 leestl 版本分别计时并输出一行
+template <typename StdF, typename LeeF>
+void report(const char *op, const char *type, size_t bytes, StdF std_f, LeeF lee_f) {
+	std::printf("%-9s %-8s %10zu B  std %7.2f", op, type, bytes, measure(bytes, std_f));
+	for (int i = leestl::simd::ISA_SCALAR; i <= leestl::simd::detected_isa(); ++i) {
+		leestl::simd::set_isa(leestl::simd::isa(i));
+		std::printf("  %s %7.2f", leestl::simd::isa_name(leestl::simd::isa(i)),
+		            measure(bytes, lee_f));
+	}
+	leestl::simd::set_isa(leestl::simd::detected_isa());
+	std::printf("  GB/s\n");
+}
+
+// 数组中没有要查找的值、两个数组只有最后一个元素不同，都需要扫描全部数据
+template <typename T>
+void bench(const char *type, size_t bytes) {
+	const size_t   n = bytes / sizeof(T);
+	std::vector<T> a(n), b(n);
+	for (size_t i = 0; i < n; ++i) a[i] = b[i] = T(i % 61 + 1);
+	b[n - 1] = 0;
+	const T *f = a.data(), *l = a.data() + n, *g = b.data();
+	const T  absent = 0, present = 7;
+
+	report(
+	    "find", type, bytes, [&] { return size_t(std::find(f, l, absent) - f); },
+	    [&] { return size_t(leestl::find(f, l, absent) - f); });
+	report(
+	    "count", type, bytes, [&] { return size_t(std::count(f, l, present)); },
+	    [&] { return size_t(leestl::count(f, l, present)); });
+	report(
+	    "mismatch", type, bytes, [&] { return size_t(std::mismatch(f, l, g).first - f); },
+	    [&] { return size_t(leestl::mismatch(f, l, g).first - f); });
+}
+
+int main(int argc, char **argv) {
+	const size_t max_bytes = argc > 1 ? std::stoull(argv[1]) : size_t(64) << 20;
+
+	cout << "\n[===================================================================]\n";
+	cout << "[------------------- find / count / mismatch benchmark start ------------------->\n";
+	for (size_t bytes = 1024; bytes <= max_bytes; bytes *= 16) {
+		bench<uint8_t>("uint8", bytes);
+		bench<uint16_t>("uint16", bytes);
+		bench<uint32_t>("uint32", bytes);
+		bench<uint64_t>("uint64", bytes);
+	}
+	cout << ">------------------- find / count / mismatch benchmark end -------------------]\n";
+	return 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file flat_hash_map.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::flat_hash_map 与 std::unordered_map 的插入、命中查找、未命中查找、删除耗时
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 编译: g++ -std=c++17 -O2 -I.. flat_hash_map.cpp -o flat_hash_map
+ * 运行: ./flat_hash_map [最大元素个数，默认 10000000]
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../LeeSTL/flat_hash_map.h"
+
+using std::cout;
+
+static std::mt19937_64 g_rng(20261018);
+
+// 防止查找被优化掉
+static volatile size_t g_sink;
+
+// 返回每次操作的平均纳秒数
+template <typename F>
+double ns_per_op(size_t ops, F f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return sec * 1e9 / double(ops);
+}
+
+struct result {
+	double insert, hit, miss, erase;
+};
+
+// keys 中的键各不相同；hits 为 keys 的随机排列，misses 为不在表中的键
+template <typename Map, typename Key>
+result run(const std::vector<Key> &keys, const std::vector<Key> &hits,
+           const std::vector<Key> &misses) {
+	Map    m;
+	result r;
+	r.insert = ns_per_op(keys.size(), [&] {
+		for (size_t i = 0; i < keys.size(); ++i) m.insert({keys[i], i});
+	});
+	r.hit = ns_per_op(hits.size(), [&] {
+		size_t s = 0;
+		for (const Key &k : hits) s += m.find(k)->second;
+		g_sink = s;
+	});
+	r.miss = ns_per_op(misses.size(), [&] {
+		size_t s = 0;
+		for (const Key &k : misses) s += m.find(k) == m.end();
+		g_sink = s;
+	});
+	r.erase = ns_per_op(hits.size(), [&] {
+		for (const Key &k : hits) m.erase(k);
+	});
+	return r;
+}
+
+template <typename Key>
+void bench(const char *type, const std::vector<Key> &keys, const std::vector<Key> &misses) {
+	std::vector<Key> hits = keys;
+	std::shuffle(hits.begin(), hits.end(), g_rng);
+	const result lee = run<leestl::flat_hash_map<Key, size_t>>(keys, hits, misses);
+	const result std_ = run<std::unordered_map<Key, size_t>>(keys, hits, misses);
+	std::printf(
+	    "%-8s %9zu  insert %6.1f / %6.1f  hit %6.1f / %6.1f  miss %6.1f / %6.1f  "
+	    "erase %6.1f / %6.1f\n",
+	    type, keys.size(), lee.insert, std_.insert, lee.hit, std_.hit, lee.miss, std_.miss,
+	    lee.erase, std_.erase);
+}
+
+int main(int argc, char **argv) {
+	const size_t max_n = argc > 1 ? std::stoull(argv[1]) : 10000000;
+
+	cout << "\n[===================================================================]\n";
+	cout << "[---------------------- flat_hash_map benchmark start ---------------------->\n";
+	cout << "ns/op, leestl::flat_hash_map / std::unordered_map\n";
+	for (size_t n = 1000; n <= max_n; n *= 10) {
+		// 奇数作为表中的键，偶数作为未命中的键
+		std::vector<uint64_t> ints(n), int_misses(n);
+		for (size_t i = 0; i < n; ++i) {
+			ints[i] = g_rng() | 1;
+			int_misses[i] = g_rng() & ~uint64_t(1);
+		}
+		std::sort(ints.begin(), ints.end());
+		ints.erase(std::unique(ints.begin(), ints.end()), ints.end());
+		std::shuffle(ints.begin(), ints.end(), g_rng);
+		bench("uint64", ints, int_misses);
+
+		if (n > max_n / 10 && n > 1000000) continue;    // 字符串键只测到较小的规模
+		std::vector<std::string> strs(ints.size()), str_misses(n);
+		for (size_t i = 0; i < ints.size(); ++i) strs[i] = "user:" + std::to_string(ints[i]);
+		for (size_t i = 0; i < n; ++i) str_misses[i] = "user:" + std::to_string(int_misses[i]);
+		bench("string", strs, str_misses);
+	}
+	cout << ">---------------------- flat_hash_map benchmark end ----------------------]\n";
+	return 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file list.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief 双向链表性能测试，比较 leestl::list 与 std::list
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 元素为 uint64_t：逐个尾部插入、结点周转（随机删除一个元素再在尾部插入一个，
+ * 模拟 LRU 淘汰）、LRU 命中（splice 到头部）、批量插入后顺序遍历、归并排序
+ * 编译: g++ -std=c++17 -O2 -I.. list.cpp -o list
+ * 运行: ./list [元素个数，默认 1000000] [操作次数，默认 5000000]
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <random>
+#include <vector>
+
+#include "../LeeSTL/list.h"
+
+static double now() {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch())
+	    .count();
+}
+
+static uint64_t sink = 0;
+
+struct result {
+	double push_back, churn, touch, bulk_scan, sort;
+};
+
+template <typename List>
+result run(size_t n, size_t ops, const std::vector<uint32_t> &picks) {
+	typedef typename List::iterator iterator;
+	result                          r;
+
+	// 预热：上一轮排序后打乱的结点在释放时散布在堆上，第一次较大的分配会触发 malloc
+	// 整理这些碎片；先不计时地建立并销毁一次，避免把这部分开销算到本轮
+	{
+		List warm;
+		for (size_t i = 0; i < n; ++i) warm.push_back(i);
+	}
+
+	double t = now();
+	List   l;
+	for (size_t i = 0; i < n; ++i) l.push_back(i);
+	r.push_back = (now() - t) * 1e9 / n;
+
+	// 保存每个元素的迭代器，随机挑选元素删除或移动，结点散布在整个堆上
+	std::vector<iterator> its;
+	its.reserve(n);
+	for (iterator it = l.begin(); it != l.end(); ++it) its.push_back(it);
+
+	t = now();
+	for (size_t i = 0; i < ops; ++i) {
+		iterator &victim = its[picks[i % picks.size()]];
+		sink += *victim;
+		l.erase(victim);
+		l.push_back(i);
+		victim = --l.end();
+	}
+	r.churn = (now() - t) * 1e9 / ops;
+
+	t = now();
+	for (size_t i = 0; i < ops; ++i) {
+		iterator it = its[picks[(i * 7) % picks.size()]];
+		sink += *it;
+		l.splice(l.begin(), l, it);
+	}
+	r.touch = (now() - t) * 1e9 / ops;
+
+	t = now();
+	{
+		List b;
+		b.insert(b.end(), n, uint64_t(3));
+		for (uint64_t x : b) sink += x;
+	}
+	r.bulk_scan = (now() - t) * 1e9 / n;
+
+	std::mt19937_64 rng(7);
+	for (uint64_t &x : l) x = rng();
+	t = now();
+	l.sort();
+	r.sort = (now() - t) * 1e9 / n;
+	sink += l.front();
+	return r;
+}
+
+int main(int argc, char **argv) {
+	size_t n = 1000000, ops = 5000000;
+	if (argc > 1) n = std::strtoul(argv[1], nullptr, 10);
+	if (argc > 2) ops = std::strtoul(argv[2], nullptr, 10);
+
+	std::mt19937          rng(2026);
+	std::vector<uint32_t> picks(1 << 20);
+	for (auto &p : picks) p = rng() % n;
+
+	std::printf("elements: %zu, operations: %zu\n", n, ops);
+	const result a = run<std::list<uint64_t>>(n, ops, picks);
+	const result b = run<leestl::list<uint64_t>>(n, ops, picks);
+	std::printf("%-26s %14s %16s %8s\n", "", "std::list", "leestl::list", "speedup");
+	auto row = [](const char *name, double x, double y) {
+		std::printf("%-26s %11.1f ns %13.1f ns %7.2fx\n", name, x, y, x / y);
+	};
+	row("push_back / elem", a.push_back, b.push_back);
+	row("erase + push_back", a.churn, b.churn);
+	row("splice to front", a.touch, b.touch);
+	row("bulk insert + scan / elem", a.bulk_scan, b.bulk_scan);
+	row("sort / elem", a.sort, b.sort);
+	if (sink == 42) std::printf(" ");
+	return 0;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file memory_resource.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::monotonic_buffer_resource 构造-丢弃型负载性能测试
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 模拟请求级负载：每个请求构造上千个短小的 vector，插入若干元素后整体丢弃，
+ * 比较默认配置器、arena 配置器（堆上初始块）与 arena 配置器（栈上初始缓冲区）的耗时
+ * 编译: g++ -std=c++17 -O2 -I.. memory_resource.cpp -o memory_resource
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "../LeeSTL/memory_resource.h"
+#include "../LeeSTL/vector.h"
+
+using std::cout;
+
+static const int kRequests = 2000;
+static const int kVectorsPerRequest = 1000;
+
+// 单个请求：构造 kVectorsPerRequest 个 vector，每个插入若干元素，返回校验和防止被优化
+template <typename Vec, typename Alloc>
+long run_request(const Alloc &alloc, unsigned seed) {
+	long sum = 0;
+	for (int i = 0; i < kVectorsPerRequest; ++i) {
+		seed = seed * 1103515245u + 12345u;
+		size_t n = 1 + (seed >> 16) % 32;
+		Vec    v(n, i, alloc);
+		for (int k = 0; k < 4; ++k) v.insert(v.end(), k);
+		sum += v.size() + *v.begin();
+	}
+	return sum;
+}
+
+template <typename F>
+void bench(const std::string &name, F request) {
+	long sum = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < kRequests; ++r) sum += request(r);
+	auto   end = std::chrono::steady_clock::now();
+	double sec = std::chrono::duration<double>(end - start).count();
+	std::printf(
+	    "%-40s %8.3f s  %8.2f us/request  (checksum %ld)\n", name.c_str(), sec,
+	    sec * 1e6 / kRequests, sum);
+}
+
+int main() {
+	cout << "\n[===================================================================]\n";
+	cout << "[---------------------- memory_resource benchmark start ---------------------->\n";
+
+	bench("leestl::allocator", [](int r) {
+		typedef leestl::vector<int> Vec;
+		return run_request<Vec>(leestl::allocator<int>(), r);
+	});
+
+	leestl::monotonic_buffer_resource heap_arena(64 * 1024);
+	bench("arena_allocator (heap chunks)", [&](int r) {
+		typedef leestl::vector<int, leestl::arena_allocator<int>> Vec;
+		long sum = run_request<Vec>(leestl::arena_allocator<int>(heap_arena), r);
+		heap_arena.release();    // 请求结束，整体释放
+		return sum;
+	});
+
+	bench("arena_allocator (stack buffer)", [](int r) {
+		typedef leestl::vector<int, leestl::arena_allocator<int>> Vec;
+		leestl::stack_buffer_resource<64 * 1024> stack_arena;
+		return run_request<Vec>(leestl::arena_allocator<int>(stack_arena), r);
+	});
+
+	cout << ">---------------------- memory_resource benchmark end ----------------------]\n";
+	return 0;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file parallel_algobase.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::fill、copy、move、copy_backward 的并行版本从 1 到 N 个线程的扩展性
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 编译: g++ -std=c++17 -O2 -pthread -I.. parallel_algobase.cpp -o parallel_algobase
+ * 运行: ./parallel_algobase [缓冲区字节数，默认 1 GiB] [最大线程数，默认硬件线程数]
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "../LeeSTL/algorithm.h"
+
+using std::cout;
+
+static volatile int g_sink;
+
+// 重复运行 f 直到总时间超过 0.5 秒，返回 GB/s（按读写的总字节数计）
+template <typename F>
+double measure(size_t bytes, F f) {
+	size_t iters = 0;
+	auto   start = std::chrono::steady_clock::now();
+	double sec = 0;
+	do {
+		f();
+		++iters;
+		sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	} while (sec < 0.5);
+	return double(bytes) * double(iters) / sec / 1e9;
+}
+
+int main(int argc, char **argv) {
+	const size_t bytes = argc > 1 ? std::stoull(argv[1]) : size_t(1) << 30;
+	size_t       max_threads = argc > 2 ? std::stoul(argv[2]) : std::thread::hardware_concurrency();
+	if (max_threads == 0) max_threads = 1;
+	const size_t n = bytes / sizeof(int);
+
+	cout << "\n[===================================================================]\n";
+	cout << "[---------------------- parallel algobase benchmark start ---------------------->\n";
+	cout << "buffer " << bytes << " B, hardware threads " << std::thread::hardware_concurrency()
+	     << "\n";
+	// 工作线程绑定到固定 CPU，首次访问分配的页面才会稳定留在处理它的线程所在的 NUMA 节点
+	leestl::execution::set_pinning(true);
+	double base_fill = 0, base_copy = 0;
+	for (size_t t = 1;; t = t * 2 < max_threads ? t * 2 : max_threads) {
+		leestl::execution::set_num_threads(t);
+
+		// 每轮重新分配，由并行 fill 首次访问，页面落在之后处理同一段的线程所在的 NUMA 节点
+		int *src = static_cast<int *>(std::malloc(n * sizeof(int)));
+		int *dst = static_cast<int *>(std::malloc(n * sizeof(int)));
+		leestl::fill(leestl::execution::par, src, src + n, 1);
+		leestl::fill(leestl::execution::par, dst, dst + n, 0);
+
+		double fill = measure(bytes, [&] {
+			leestl::fill(leestl::execution::par, dst, dst + n, int(t));
+			g_sink = dst[n / 2];
+		});
+		double copy = measure(2 * bytes, [&] {
+			leestl::copy(leestl::execution::par, src, src + n, dst);
+			g_sink = dst[n / 2];
+		});
+		double move = measure(2 * bytes, [&] {
+			leestl::move(leestl::execution::par_unseq, src, src + n, dst);
+			g_sink = dst[n / 2];
+		});
+		double copy_backward = measure(2 * bytes, [&] {
+			leestl::copy_backward(leestl::execution::par, src, src + n, dst + n);
+			g_sink = dst[n / 2];
+		});
+		if (t == 1) base_fill = fill, base_copy = copy;
+		std::printf(
+		    "%3zu threads  fill %7.2f GB/s (x%.2f)  copy %7.2f GB/s (x%.2f)  move %7.2f GB/s  "
+		    "copy_backward %7.2f GB/s\n",
+		    t, fill, fill / base_fill, copy, copy / base_copy, move, copy_backward);
+
+		std::free(src);
+		std::free(dst);
+		if (t == max_threads) break;
+	}
+	cout << ">---------------------- parallel algobase benchmark end ----------------------]\n";
+	return 0;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file parallel_sort.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::sort、stable_sort 的并行版本在 1 到 32 个线程下的强扩展性
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 编译: g++ -std=c++17 -O2 -pthread -I.. parallel_sort.cpp -o parallel_sort
+ * 运行: ./parallel_sort [元素个数，默认 100000000] [最大线程数，默认 32]
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "../LeeSTL/algorithm.h"
+#include "../LeeSTL/vector.h"
+
+using std::cout;
+
+template <typename F>
+double seconds(F f) {
+	auto start = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv) {
+	const size_t n = argc > 1 ? std::stoull(argv[1]) : 100000000;
+	const size_t max_threads = argc > 2 ? std::stoul(argv[2]) : 32;
+
+	leestl::vector<uint64_t> input(n), v(n), expect(n);
+	std::mt19937_64          rng(20261018);
+	for (size_t i = 0; i < n; ++i) input[i] = rng();
+
+	cout << "\n[===================================================================]\n";
+	cout << "[---------------------- parallel sort benchmark start ---------------------->\n";
+	cout << n << " uint64, hardware threads " << std::thread::hardware_concurrency() << "\n";
+
+	leestl::copy(input.begin(), input.end(), expect.begin());
+	const double seq = seconds([&] { leestl::sort(expect.begin(), expect.end()); });
+	leestl::copy(input.begin(), input.end(), v.begin());
+	const double std_seq = seconds([&] { std::sort(v.data(), v.data() + n); });
+	leestl::copy(input.begin(), input.end(), v.begin());
+	const double stable_seq = seconds([&] { leestl::stable_sort(v.begin(), v.end()); });
+	std::printf(
+	    "sequential   leestl::sort %7.3f s  std::sort %7.3f s  leestl::stable_sort %7.3f s\n", seq,
+	    std_seq, stable_seq);
+
+	for (size_t t = 1; t <= max_threads; t *= 2) {
+		leestl::execution::set_num_threads(t);
+		leestl::copy(input.begin(), input.end(), v.begin());
+		const double par =
+		    seconds([&] { leestl::sort(leestl::execution::par, v.begin(), v.end()); });
+		const bool ok = std::equal(v.data(), v.data() + n, expect.data());
+		leestl::copy(input.begin(), input.end(), v.begin());
+		const double stable_par =
+		    seconds([&] { leestl::stable_sort(leestl::execution::par, v.begin(), v.end()); });
+		std::printf(
+		    "%3zu threads  sort(par) %7.3f s (x%5.2f, efficiency %3.0f%%)  "
+		    "stable_sort(par) %7.3f s (x%5.2f)%s\n",
+		    t, par, seq / par, 100 * seq / par / double(t), stable_par, stable_seq / stable_par,
+		    ok ? "" : "  MISMATCH");
+	}
+	leestl::execution::set_num_threads(0);
+	cout << ">---------------------- parallel sort benchmark end ----------------------]\n";
+	return 0;
+}
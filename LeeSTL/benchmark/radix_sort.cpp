@@ -0,0 +1,104 @@
+/**
+ * @file radix_sort.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::radix_sort 与 leestl::sort、std::sort 在整数、浮点数、时间戳和记录上的耗时
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 编译: g++ -std=c++17 -O2 -I.. radix_sort.cpp -o radix_sort
+ * 运行: ./radix_sort [最大元素个数，默认 10000000]
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../LeeSTL/algo.h"
+
+using std::cout;
+
+static std::mt19937_64 g_rng(20261018);
+
+// 按时间戳排序的记录
+struct event {
+	int64_t  timestamp;
+	uint32_t id;
+	float    value;
+};
+
+// 每次排序前恢复输入，返回每个元素的平均纳秒数（不计恢复时间）
+template <typename T, typename F>
+double measure(const std::vector<T> &input, F sort) {
+	std::vector<T> v(input.size());
+	const size_t   rounds = 20000000 / input.size() + 1;
+	double         total = 0;
+	for (size_t r = 0; r < rounds; ++r) {
+		std::copy(input.begin(), input.end(), v.begin());
+		auto start = std::chrono::steady_clock::now();
+		sort(v.data(), v.data() + v.size());
+		total += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+	return total * 1e9 / double(rounds) / double(input.size());
+}
+
+template <typename T>
+void bench(const char *name, const std::vector<T> &input) {
+	double radix = measure(input, [](T *f, T *l) { leestl::radix_sort(f, l); });
+	double lsort = measure(input, [](T *f, T *l) { leestl::sort(f, l); });
+	double ssort = measure(input, [](T *f, T *l) { std::sort(f, l); });
+	std::printf(
+	    "%-24s %9zu  radix_sort %6.2f  leestl::sort %6.2f (x%.2f)  std::sort %6.2f (x%.2f)  "
+	    "ns/elem\n",
+	    name, input.size(), radix, lsort, lsort / radix, ssort, ssort / radix);
+}
+
+void bench_events(const std::vector<event> &input) {
+	auto   key = [](const event &e) { return e.timestamp; };
+	auto   comp = [](const event &a, const event &b) { return a.timestamp < b.timestamp; };
+	double radix = measure(input, [&](event *f, event *l) { leestl::radix_sort(f, l, key); });
+	double lsort = measure(input, [&](event *f, event *l) { leestl::stable_sort(f, l, comp); });
+	double ssort = measure(input, [&](event *f, event *l) { std::stable_sort(f, l, comp); });
+	std::printf(
+	    "%-24s %9zu  radix_sort %6.2f  leestl::stable_sort %6.2f (x%.2f)  "
+	    "std::stable_sort %6.2f (x%.2f)  ns/elem\n",
+	    "event by timestamp", input.size(), radix, lsort, lsort / radix, ssort, ssort / radix);
+}
+
+int main(int argc, char **argv) {
+	const size_t max_n = argc > 1 ? std::stoull(argv[1]) : 10000000;
+
+	cout << "\n[===================================================================]\n";
+	cout << "[---------------------- radix_sort benchmark start ---------------------->\n";
+	for (size_t n = 1000; n <= max_n; n *= 10) {
+		std::vector<uint32_t> u32(n);
+		std::vector<uint64_t> u64(n);
+		std::vector<int64_t>  i64(n), ts(n);
+		std::vector<double>   f64(n);
+		std::vector<event>    events(n);
+		// 一天之内的微秒时间戳：高位字节全部相同，会被跳过
+		const int64_t day = int64_t(1790000000) * 1000000;
+		for (size_t i = 0; i < n; ++i) {
+			u32[i] = uint32_t(g_rng());
+			u64[i] = g_rng();
+			i64[i] = int64_t(g_rng());
+			ts[i] = day + int64_t(g_rng() % (int64_t(86400) * 1000000));
+			f64[i] = double(int64_t(g_rng() % 2000000) - 1000000) / 3.0;
+			events[i] = event{ts[i], uint32_t(i), float(i)};
+		}
+		bench("uint32", u32);
+		bench("uint64", u64);
+		bench("int64", i64);
+		bench("int64 timestamp (1 day)", ts);
+		bench("double", f64);
+		bench_events(events);
+	}
+	cout << ">---------------------- radix_sort benchmark end ----------------------]\n";
+	return 0;
+}
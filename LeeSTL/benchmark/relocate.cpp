@@ -0,0 +1,94 @@
+/**
+ * @file relocate.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::vector 扩容时平凡重定位（整段 memcpy）与逐个移动并析构的性能对比
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 对 POD、声明为可平凡重定位的 string 类型、未声明的同一 string 类型与 std::string
+ * 分别逐个尾部插入（从预先构造好的对象移动）构建 vector，扩容时迁移旧元素的方式不同
+ * 编译: g++ -std=c++17 -O2 -I.. relocate.cpp -o relocate
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "../LeeSTL/vector.h"
+
+using std::cout;
+
+// 只持有堆指针的 string 类型，移动后旧对象置空，Tag 用于区分是否声明可平凡重定位
+template <int Tag>
+class heap_string {
+private:
+	char  *_data;
+	size_t _size;
+
+public:
+	explicit heap_string(const char *s = "") : _size(std::strlen(s)) {
+		_data = new char[_size + 1];
+		std::memcpy(_data, s, _size + 1);
+	}
+	heap_string(const heap_string &x) : heap_string(x._data) {}
+	heap_string(heap_string &&x) noexcept : _data(x._data), _size(x._size) {
+		x._data = nullptr;
+		x._size = 0;
+	}
+	heap_string &operator=(heap_string x) noexcept {
+		leestl::swap(_data, x._data);
+		leestl::swap(_size, x._size);
+		return *this;
+	}
+	~heap_string() { delete[] _data; }
+
+	size_t size() const { return _size; }
+};
+
+typedef heap_string<0> relocatable_string;
+typedef heap_string<1> plain_string;
+LEESTL_TRIVIALLY_RELOCATABLE(relocatable_string)
+
+static_assert(leestl::is_trivially_relocatable_v<relocatable_string>, "");
+static_assert(!leestl::is_trivially_relocatable_v<plain_string>, "");
+
+template <typename T, typename Make>
+void bench(const char *name, size_t n, int rounds, Make make) {
+	size_t check = 0;
+	double sec = 0;
+	for (int r = 0; r < rounds; ++r) {
+		leestl::vector<T> pool(n, make());    // 元素的构造不计入耗时
+		leestl::vector<T> v;
+
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < n; ++i) v.insert(v.end(), leestl::move(pool.begin()[i]));
+		sec += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		check += v.size();
+	}
+	std::printf(
+	    "%-44s %10zu elements  %8.2f ns/insert  (%zu)\n", name, n, sec * 1e9 / (n * rounds),
+	    check);
+}
+
+int main(int argc, char **argv) {
+	size_t n = argc > 1 ? std::stoul(argv[1]) : 1000000;
+	int    rounds = argc > 2 ? std::stoi(argv[2]) : 5;
+
+	cout << "\n[===================================================================]\n";
+	cout << "[---------------------- relocate benchmark start ---------------------->\n";
+	bench<int>("int (trivially relocatable)", n, rounds, [] { return 42; });
+	bench<relocatable_string>("heap_string (LEESTL_TRIVIALLY_RELOCATABLE)", n, rounds, [] {
+		return relocatable_string("relocate");
+	});
+	bench<plain_string>(
+	    "heap_string (move + destroy)", n, rounds, [] { return plain_string("relocate"); });
+	bench<std::string>(
+	    "std::string (move + destroy)", n, rounds, [] { return std::string("relocate"); });
+	cout << ">---------------------- relocate benchmark end ----------------------]\n";
+	return 0;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file small_vector.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief 小规模工作负载下 leestl::small_vector 与 leestl::vector、std::vector 的分配次数与延迟对比
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 编译: g++ -std=c++17 -O2 -I.. small_vector.cpp -o small_vector
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../LeeSTL/small_vector.h"
+#include "../LeeSTL/vector.h"
+
+using std::cout;
+
+static size_t g_allocs = 0;    // 所有容器共用的分配次数计数
+
+// 统计分配次数的配置器
+template <typename T>
+struct counting_allocator : leestl::allocator<T> {
+	template <typename U>
+	struct rebind {
+		typedef counting_allocator<U> other;
+	};
+
+	counting_allocator() = default;
+	template <typename U>
+	counting_allocator(const counting_allocator<U> &) {}
+
+	T *allocate(size_t n) {
+		++g_allocs;
+		return leestl::allocator<T>::allocate(n);
+	}
+};
+
+// 防止编译器把结果优化掉
+static volatile size_t g_sink;
+
+// 每轮构造一个容器、追加 n 个元素、遍历求和后析构，模拟短生命周期的小容器
+template <typename Vec>
+void bench(const char *name, size_t n, size_t rounds) {
+	g_allocs = 0;
+	size_t sum = 0;
+	auto   start = std::chrono::steady_clock::now();
+	for (size_t r = 0; r < rounds; ++r) {
+		Vec v;
+		for (size_t i = 0; i < n; ++i) v.push_back(typename Vec::value_type(i + r));
+		for (auto &x : v) sum += size_t(x);
+	}
+	double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	g_sink = sum;
+	std::printf(
+	    "%-34s %4zu elements  %8.2f ns/container  %6.2f allocs/container\n", name, n,
+	    sec * 1e9 / double(rounds), double(g_allocs) / double(rounds));
+}
+
+// 移动一个装满 n 个元素的容器
+template <typename Vec>
+void bench_move(const char *name, size_t n, size_t rounds) {
+	Vec src;
+	for (size_t i = 0; i < n; ++i) src.emplace_back();
+	auto start = std::chrono::steady_clock::now();
+	for (size_t r = 0; r < rounds; ++r) {
+		Vec dst(leestl::move(src));
+		src = leestl::move(dst);
+	}
+	double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	g_sink = src.size();
+	std::printf("%-34s %4zu elements  %8.2f ns/2 moves\n", name, n, sec * 1e9 / double(rounds));
+}
+
+int main(int argc, char **argv) {
+	size_t rounds = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+	typedef counting_allocator<int> int_alloc;
+
+	cout << "\n[===================================================================]\n";
+	cout << "[---------------------- small_vector benchmark start ---------------------->\n";
+	for (size_t n : {size_t(1), size_t(4), size_t(8), size_t(16), size_t(32), size_t(64)}) {
+		bench<std::vector<int, int_alloc>>("std::vector<int>", n, rounds);
+		bench<leestl::vector<int, int_alloc>>("leestl::vector<int>", n, rounds);
+		bench<leestl::small_vector<int, 16, int_alloc>>("leestl::small_vector<int, 16>", n, rounds);
+		cout << "\n";
+	}
+	for (size_t n : {size_t(4), size_t(16), size_t(64)}) {
+		bench_move<leestl::vector<int>>("leestl::vector<int>", n, rounds);
+		bench_move<leestl::small_vector<int, 16>>("leestl::small_vector<int, 16>", n, rounds);
+		bench_move<leestl::small_vector<std::string, 16>>(
+		    "leestl::small_vector<string, 16>", n, rounds);
+	}
+	cout << ">---------------------- small_vector benchmark end ----------------------]\n";
+	return 0;
+}
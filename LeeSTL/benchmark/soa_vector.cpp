@@ -0,0 +1,151 @@
+/**
+ * @file soa_vector.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief 按列存储性能测试，比较 leestl::soa_vector 与按行存储的 leestl::vector<record>
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 每条记录 64 字节（7 个字段）。单字段扫描：对 price 求和，soa_vector 分别用 column<1>() 的原始
+ * 指针与 zip 迭代器的 get<1>() 访问；双字段过滤：统计 region 与 price 同时满足条件的记录；
+ * 整条记录遍历：用结构化绑定取出全部字段参与计算；另测逐个追加全部记录的耗时
+ * 编译: g++ -std=c++17 -O2 -I.. soa_vector.cpp -o soa_vector
+ * 运行: ./soa_vector [记录条数，默认 2000000]
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "../LeeSTL/soa_vector.h"
+#include "../LeeSTL/vector.h"
+
+static double now() {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch())
+	    .count();
+}
+
+static uint64_t sink = 0;
+
+struct tag24 {
+	char c[24];
+};
+
+struct record {
+	uint64_t id;
+	double   price;
+	double   qty;
+	uint32_t flags;
+	uint32_t region;
+	uint64_t ts;
+	tag24    tag;
+};
+
+typedef leestl::vector<record>                                                     aos;
+typedef leestl::soa_vector<uint64_t, double, double, uint32_t, uint32_t, uint64_t, tag24> soa;
+
+static record make_record(uint64_t i) {
+	record r;
+	r.id = i;
+	r.price = double(i % 1000) * 0.25;
+	r.qty = double(i % 7 + 1);
+	r.flags = uint32_t(i * 2654435761u);
+	r.region = uint32_t(i % 16);
+	r.ts = 1700000000 + i;
+	std::memset(r.tag.c, char('a' + i % 26), sizeof(r.tag.c));
+	return r;
+}
+
+// 每项重复 rounds 次，结果为每条记录的纳秒数
+template <typename F>
+static double timed(size_t rounds, size_t n, F f) {
+	const double t = now();
+	for (size_t r = 0; r < rounds; ++r) f();
+	return (now() - t) * 1e9 / double(rounds * n);
+}
+
+int main(int argc, char **argv) {
+	size_t n = 2000000;
+	if (argc > 1) n = std::strtoul(argv[1], nullptr, 10);
+	const size_t rounds = 10;
+
+	aos    a;
+	soa    s;
+	double build_aos, build_soa;
+	{
+		const double t = now();
+		for (size_t i = 0; i < n; ++i) a.push_back(make_record(i));
+		build_aos = (now() - t) * 1e9 / n;
+	}
+	{
+		const double t = now();
+		for (size_t i = 0; i < n; ++i) {
+			const record r = make_record(i);
+			s.emplace_back(r.id, r.price, r.qty, r.flags, r.region, r.ts, r.tag);
+		}
+		build_soa = (now() - t) * 1e9 / n;
+	}
+
+	// 单字段求和
+	const double sum_aos = timed(rounds, n, [&] {
+		double sum = 0;
+		for (const record &r : a) sum += r.price;
+		sink += uint64_t(sum);
+	});
+	const double sum_column = timed(rounds, n, [&] {
+		const double *price = s.data<1>();
+		double        sum = 0;
+		for (size_t i = 0; i < n; ++i) sum += price[i];
+		sink += uint64_t(sum);
+	});
+	const double sum_zip = timed(rounds, n, [&] {
+		double sum = 0;
+		for (auto it = s.cbegin(), last = s.cend(); it != last; ++it) sum += it.get<1>();
+		sink += uint64_t(sum);
+	});
+
+	// 双字段过滤
+	const double filter_aos = timed(rounds, n, [&] {
+		uint64_t count = 0;
+		for (const record &r : a) count += (r.region == 3) & (r.price > 100.0);
+		sink += count;
+	});
+	const double filter_column = timed(rounds, n, [&] {
+		const uint32_t *region = s.data<4>();
+		const double   *price = s.data<1>();
+		uint64_t        count = 0;
+		for (size_t i = 0; i < n; ++i) count += (region[i] == 3) & (price[i] > 100.0);
+		sink += count;
+	});
+
+	// 整条记录遍历
+	const double full_aos = timed(rounds, n, [&] {
+		uint64_t h = 0;
+		for (const record &r : a)
+			h += r.id + uint64_t(r.price * r.qty) + r.flags + r.region + r.ts + r.tag.c[0];
+		sink += h;
+	});
+	const double full_zip = timed(rounds, n, [&] {
+		uint64_t h = 0;
+		for (auto &&[id, price, qty, flags, region, ts, tag] : s)
+			h += id + uint64_t(price * qty) + flags + region + ts + tag.c[0];
+		sink += h;
+	});
+
+	std::printf("records: %zu, record size: %zu bytes\n", n, sizeof(record));
+	std::printf("%-28s %14s %14s %8s\n", "ns / record", "vector<rec>", "soa_vector", "speedup");
+	auto row = [](const char *name, double p, double q) {
+		std::printf("%-28s %11.3f ns %11.3f ns %7.2fx\n", name, p, q, p / q);
+	};
+	row("push_back", build_aos, build_soa);
+	row("sum price (column<1>)", sum_aos, sum_column);
+	row("sum price (zip get<1>)", sum_aos, sum_zip);
+	row("filter region && price", filter_aos, filter_column);
+	row("full record (zip bindings)", full_aos, full_zip);
+	if (sink == 42) std::printf(" ");
+	return 0;
+}
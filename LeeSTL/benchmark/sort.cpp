@@ -0,0 +1,88 @@
+/**
+ * @file sort.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::sort、stable_sort 与 std::sort、std::stable_sort 在各种输入分布下的耗时
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 编译: g++ -std=c++17 -O2 -I.. sort.cpp -o sort
+ * 运行: ./sort [最大元素个数，默认 10000000]
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../LeeSTL/algo.h"
+
+using std::cout;
+
+static std::mt19937_64 g_rng(20261018);
+
+// 输入分布
+template <typename T>
+void make_input(std::vector<T> &v, const std::string &pattern) {
+	const size_t n = v.size();
+	for (size_t i = 0; i < n; ++i) {
+		if (pattern == "random") v[i] = T(g_rng() % (uint64_t(1) << 40));
+		else if (pattern == "sorted") v[i] = T(i);
+		else if (pattern == "reversed") v[i] = T(n - i);
+		else if (pattern == "organ_pipe") v[i] = T(i < n / 2 ? i : n - i);
+		else if (pattern == "few_unique") v[i] = T(g_rng() % 16);
+		else if (pattern == "sorted_tail") v[i] = T(i < n - n / 100 ? i : g_rng() % n);
+		else v[i] = T(i % 1024);    // sawtooth
+	}
+}
+
+// 每次排序前恢复输入，返回每个元素的平均纳秒数（不计恢复时间）
+template <typename T, typename F>
+double measure(const std::vector<T> &input, F sort) {
+	std::vector<T> v(input.size());
+	const size_t   rounds = 20000000 / input.size() + 1;
+	double         total = 0;
+	for (size_t r = 0; r < rounds; ++r) {
+		std::copy(input.begin(), input.end(), v.begin());
+		auto start = std::chrono::steady_clock::now();
+		sort(v.data(), v.data() + v.size());
+		total += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+	return total * 1e9 / double(rounds) / double(input.size());
+}
+
+template <typename T>
+void bench(const char *type, size_t max_n) {
+	const char *patterns[] = {"random",     "sorted",      "reversed", "organ_pipe",
+	                          "few_unique", "sorted_tail", "sawtooth"};
+	for (size_t n = 1000; n <= max_n; n *= 100) {
+		for (const char *p : patterns) {
+			std::vector<T> input(n);
+			make_input(input, p);
+			double ls = measure(input, [](T *f, T *l) { leestl::sort(f, l); });
+			double ss = measure(input, [](T *f, T *l) { std::sort(f, l); });
+			double lst = measure(input, [](T *f, T *l) { leestl::stable_sort(f, l); });
+			double sst = measure(input, [](T *f, T *l) { std::stable_sort(f, l); });
+			std::printf(
+			    "%-6s %9zu %-11s  sort: leestl %6.2f std %6.2f (x%.2f)  "
+			    "stable_sort: leestl %6.2f std %6.2f (x%.2f)  ns/elem\n",
+			    type, n, p, ls, ss, ss / ls, lst, sst, sst / lst);
+		}
+	}
+}
+
+int main(int argc, char **argv) {
+	const size_t max_n = argc > 1 ? std::stoull(argv[1]) : 10000000;
+
+	cout << "\n[===================================================================]\n";
+	cout << "[---------------------- sort benchmark start ---------------------->\n";
+	bench<int64_t>("int64", max_n);
+	bench<double>("double", max_n);
+	cout << ">---------------------- sort benchmark end ----------------------]\n";
+	return 0;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file thread_alloc.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief 多线程小对象配置吞吐量测试，比较 leestl::allocator、
+ * 	加锁的第二级配置器 leestl::pool_allocator 与线程缓存配置器 leestl::thread_cache_allocator
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 同线程负载：每个线程反复分配一批对象后全部释放；
+ * 跨线程负载：每个线程分配一批对象，交给下一个线程释放
+ * 编译: g++ -std=c++17 -O2 -pthread -I.. thread_alloc.cpp -o thread_alloc
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../LeeSTL/thread_alloc.h"
+
+using std::cout;
+
+struct Node {
+	char data[32];
+};
+
+static const size_t kBatch = 1000;
+static const int    kRounds = 2000;
+
+template <typename Alloc>
+void local_worker() {
+	std::vector<Node *> ptrs(kBatch);
+	for (int r = 0; r < kRounds; ++r) {
+		for (size_t i = 0; i < kBatch; ++i) ptrs[i] = Alloc::allocate(1);
+		for (size_t i = 0; i < kBatch; ++i) Alloc::deallocate(ptrs[i], 1);
+	}
+}
+
+// 分配后交给其他线程释放：线程 i 在第 r 轮释放线程 (i + 1) % n 在第 r - 1 轮分配的对象
+template <typename Alloc>
+void cross_worker(
+    std::vector<std::vector<Node *>> &slots, size_t id, size_t nthreads, std::atomic<int> &phase) {
+	const int rounds = kRounds / 10;
+	for (int r = 0; r < rounds; ++r) {
+		for (size_t i = 0; i < kBatch; ++i) slots[id][i] = Alloc::allocate(1);
+		// 等待所有线程完成本轮分配
+		phase.fetch_add(1);
+		while (phase.load() < int(nthreads) * (2 * r + 1)) std::this_thread::yield();
+		std::vector<Node *> &other = slots[(id + 1) % nthreads];
+		for (size_t i = 0; i < kBatch; ++i) Alloc::deallocate(other[i], 1);
+		phase.fetch_add(1);
+		while (phase.load() < int(nthreads) * (2 * r + 2)) std::this_thread::yield();
+	}
+}
+
+template <typename Alloc>
+void bench(const std::string &name, size_t nthreads) {
+	std::vector<std::thread> threads;
+
+	auto start = std::chrono::steady_clock::now();
+	for (size_t t = 0; t < nthreads; ++t) threads.emplace_back(local_worker<Alloc>);
+	for (auto &t : threads) t.join();
+	double local_sec =
+	    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	threads.clear();
+	std::vector<std::vector<Node *>> slots(nthreads, std::vector<Node *>(kBatch));
+	std::atomic<int>                 phase(0);
+	start = std::chrono::steady_clock::now();
+	for (size_t t = 0; t < nthreads; ++t)
+		threads.emplace_back(cross_worker<Alloc>, std::ref(slots), t, nthreads, std::ref(phase));
+	for (auto &t : threads) t.join();
+	double cross_sec =
+	    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	double local_ops = double(nthreads) * kRounds * kBatch;
+	double cross_ops = double(nthreads) * (kRounds / 10) * kBatch;
+	std::printf(
+	    "%-32s %3zu threads  local %8.2f M ops/s  cross-thread %8.2f M ops/s\n", name.c_str(),
+	    nthreads, local_ops / local_sec / 1e6, cross_ops / cross_sec / 1e6);
+}
+
+int main(int argc, char **argv) {
+	size_t max_threads = argc > 1 ? std::stoul(argv[1]) : 32;
+
+	cout << "\n[===================================================================]\n";
+	cout << "[---------------------- thread_alloc benchmark start ---------------------->\n";
+	for (size_t n = 1; n <= max_threads; n *= 2) {
+		bench<leestl::allocator<Node>>("leestl::allocator", n);
+		bench<leestl::pool_allocator<Node>>("leestl::pool_allocator", n);
+		bench<leestl::thread_cache_allocator<Node>>("leestl::thread_cache_allocator", n);
+	}
+	cout << ">---------------------- thread_alloc benchmark end ----------------------]\n";
+	return 0;
+}
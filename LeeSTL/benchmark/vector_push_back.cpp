@@ -0,0 +1,74 @@
+/**
+ * @file vector_push_back.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::vector 在不同扩容策略下的均摊 push_back 性能，与 std::vector 对比
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 编译: g++ -std=c++17 -O2 -I.. vector_push_back.cpp -o vector_push_back
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../LeeSTL/vector.h"
+
+using std::cout;
+
+// 自定义扩容策略：小容量时翻倍，超过 1M 个元素后每次增长 25%
+struct growth_adaptive {
+	size_t operator()(size_t size, size_t n) const noexcept {
+		size_t step = size < (size_t(1) << 20) ? size : size / 4;
+		return size + (step > n ? step : n);
+	}
+};
+
+template <typename Vec>
+void bench(const char *name, size_t n, int rounds) {
+	size_t reallocs = 0, capacity = 0;
+	auto   start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; ++r) {
+		Vec v;
+		reallocs = 0;
+		for (size_t i = 0; i < n; ++i) {
+			const size_t cap = v.capacity();
+			v.push_back(typename Vec::value_type(i));
+			reallocs += cap != v.capacity();
+		}
+		capacity = v.capacity();
+	}
+	double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::printf(
+	    "%-28s %10zu elements  %7.2f ns/push_back  %3zu reallocs  capacity %10zu\n", name, n,
+	    sec * 1e9 / (double(n) * rounds), reallocs, capacity);
+}
+
+template <typename T>
+void bench_type(const char *type, size_t n, int rounds) {
+	cout << "[" << type << "]\n";
+	bench<std::vector<T>>("std::vector", n, rounds);
+	bench<leestl::vector<T>>("leestl::vector (2x)", n, rounds);
+	bench<leestl::vector<T, leestl::allocator<T>, leestl::growth_factor_1_5>>(
+	    "leestl::vector (1.5x)", n, rounds);
+	bench<leestl::vector<T, leestl::allocator<T>, growth_adaptive>>(
+	    "leestl::vector (adaptive)", n, rounds);
+}
+
+int main(int argc, char **argv) {
+	int rounds = argc > 1 ? std::stoi(argv[1]) : 5;
+
+	cout << "\n[===================================================================]\n";
+	cout << "[---------------------- vector push_back benchmark start ---------------------->\n";
+	for (size_t n : {size_t(1000), size_t(100000), size_t(10000000)}) {
+		bench_type<int>("int", n, rounds);
+		bench_type<double>("double", n, rounds);
+	}
+	cout << ">---------------------- vector push_back benchmark end ----------------------]\n";
+	return 0;
+}
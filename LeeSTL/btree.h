@@ -0,0 +1,982 @@
+/** @file btree.h
+ * 	这个文件实现 btree_map、btree_set 共用的 B+ 树
+ *
+ * 	每个结点约 _BTREE_NODE_BYTES 字节（8 条缓存行），键或元素按顺序存放在结点内的数组中，
+ * 	结点内用无分支二分查找定位。每个结点有十几到几十个子结点，树高只有红黑树的 1/4 左右，
+ * 	查找时每层只访问少量相邻的缓存行；元素不再各自分配结点，分配次数与指针开销也大幅减少。
+ * 	元素只存放在叶结点中，内部结点保存分隔键的副本：子树 i 中的键都在 [keys[i-1], keys[i]) 内。
+ * 	叶结点按顺序双向链接，范围遍历时逐个叶结点顺序读取，不需要回到父结点。
+ *
+ * 	插入的键大于所有元素时直接追加到最后一个叶结点，不从根下降；此时结点已满只移出一个元素，
+ * 	因此按升序插入（包括由有序区间构造、复制）每个元素均摊 O(1)，得到的结点几乎全满。
+ * 	插入与删除会移动同一结点中的元素，使所有迭代器、指针与引用失效。
+ */
+
+#ifndef _LEESTL_BTREE_H_
+#define _LEESTL_BTREE_H_ 1
+
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+
+#include "algo.h"
+#include "alloc_traits.h"
+#include "allocator.h"
+#include "iterator.h"
+#include "type_traits.h"
+
+namespace leestl {
+
+	enum { _BTREE_NODE_BYTES = 512 };    // 结点的目标大小
+
+	template <typename Key, typename Value>
+	struct _btree_internal;
+
+	// 结点的公共部分
+	template <typename Key, typename Value>
+	struct _btree_node {
+		_btree_internal<Key, Value> *parent;
+		unsigned short               pos;      // 在父结点 children 中的下标
+		unsigned short               count;    // 叶结点为元素个数，内部结点为键个数
+		bool                         leaf;
+	};
+
+	// 叶结点：有序的元素数组，与前后叶结点双向链接
+	template <typename Key, typename Value>
+	struct _btree_leaf : _btree_node<Key, Value> {
+		static constexpr size_t _fit =
+		    (_BTREE_NODE_BYTES - sizeof(_btree_node<Key, Value>) - 2 * sizeof(void *)) /
+		    sizeof(Value);
+		static constexpr size_t CAPACITY = _fit < 4 ? 4 : _fit;
+
+		_btree_leaf *prev;
+		_btree_leaf *next;
+		alignas(Value) unsigned char storage[CAPACITY * sizeof(Value)];
+
+		Value *values() noexcept { return reinterpret_cast<Value *>(storage); }
+	};
+
+	// 内部结点：count 个分隔键与 count + 1 个子结点
+	template <typename Key, typename Value>
+	struct _btree_internal : _btree_node<Key, Value> {
+		static constexpr size_t _fit =
+		    (_BTREE_NODE_BYTES - sizeof(_btree_node<Key, Value>) - sizeof(void *)) /
+		    (sizeof(Key) + sizeof(void *));
+		static constexpr size_t CAPACITY = _fit < 3 ? 3 : _fit;
+
+		alignas(Key) unsigned char storage[CAPACITY * sizeof(Key)];
+		_btree_node<Key, Value>   *children[CAPACITY + 1];
+
+		Key *keys() noexcept { return reinterpret_cast<Key *>(storage); }
+	};
+
+	/**
+	 * @brief B+ 树的双向迭代器，指向某个叶结点中的一个元素
+	 *
+	 * @tparam Key 键类型
+	 * @tparam Value 元素类型
+	 * @tparam Const 是否只读
+	 */
+	template <typename Key, typename Value, bool Const>
+	class _btree_iterator {
+		template <typename, typename, typename>
+		friend class _btree;
+		template <typename, typename, bool>
+		friend class _btree_iterator;
+
+		typedef _btree_leaf<Key, Value> _leaf_type;
+
+	public:
+		typedef bidirectional_interator_tag                       iterator_category;
+		typedef Value                                             value_type;
+		typedef ptrdiff_t                                         difference_type;
+		typedef std::conditional_t<Const, const Value *, Value *> pointer;
+		typedef std::conditional_t<Const, const Value &, Value &> reference;
+
+		_btree_iterator() noexcept = default;
+
+		// 可写迭代器可以转换为只读迭代器
+		template <bool C, typename = std::enable_if_t<Const && !C>>
+		_btree_iterator(const _btree_iterator<Key, Value, C> &x) noexcept
+		        : _leaf(x._leaf), _pos(x._pos) {}
+
+		reference operator*() const noexcept { return _leaf->values()[_pos]; }
+		pointer   operator->() const noexcept { return _leaf->values() + _pos; }
+
+		// 走出叶结点末尾时转到下一个叶结点，最后一个叶结点的末尾即尾后位置
+		_btree_iterator &operator++() noexcept {
+			if (++_pos == _leaf->count && _leaf->next) {
+				_leaf = _leaf->next;
+				_pos = 0;
+				__builtin_prefetch(_leaf->next);
+			}
+			return *this;
+		}
+
+		_btree_iterator operator++(int) noexcept {
+			_btree_iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		_btree_iterator &operator--() noexcept {
+			if (_pos == 0) {
+				_leaf = _leaf->prev;
+				_pos = _leaf->count;
+			}
+			--_pos;
+			return *this;
+		}
+
+		_btree_iterator operator--(int) noexcept {
+			_btree_iterator tmp = *this;
+			--*this;
+			return tmp;
+		}
+
+		template <bool C>
+		bool operator==(const _btree_iterator<Key, Value, C> &x) const noexcept {
+			return _leaf == x._leaf && _pos == x._pos;
+		}
+
+		template <bool C>
+		bool operator!=(const _btree_iterator<Key, Value, C> &x) const noexcept {
+			return !(*this == x);
+		}
+
+	private:
+		_leaf_type *_leaf = nullptr;
+		unsigned    _pos = 0;
+
+		_btree_iterator(_leaf_type *leaf, unsigned pos) noexcept : _leaf(leaf), _pos(pos) {}
+	};
+
+	// 比较仿函数声明 is_transparent 时允许以其他类型的键查找
+	template <typename Compare>
+	using _require_transparent_compare = void_type<typename Compare::is_transparent>;
+
+	/**
+	 * @brief B+ 树，键唯一
+	 *
+	 * @tparam Policy 描述元素类型以及如何从元素取出键
+	 * @tparam Compare 键的比较仿函数
+	 * @tparam Alloc 配置器类型
+	 */
+	template <typename Policy, typename Compare, typename Alloc>
+	class _btree {
+	public:
+		typedef typename Policy::key_type   key_type;
+		typedef typename Policy::value_type value_type;
+		typedef Compare                     key_compare;
+		typedef Alloc                       allocator_type;
+		typedef size_t                      size_type;
+		typedef ptrdiff_t                   difference_type;
+		typedef value_type                 &reference;
+		typedef const value_type           &const_reference;
+
+		typedef _btree_iterator<key_type, value_type, Policy::constant_iterators> iterator;
+		typedef _btree_iterator<key_type, value_type, true>                       const_iterator;
+		typedef leestl::reverse_iterator<iterator>       reverse_iterator;
+		typedef leestl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+	private:
+		typedef _btree_node<key_type, value_type>     _node;
+		typedef _btree_leaf<key_type, value_type>     _leaf;
+		typedef _btree_internal<key_type, value_type> _internal;
+
+		typedef typename leestl::allocator_traits<Alloc>::template rebind_alloc<value_type>
+		    value_allocator;
+		typedef typename leestl::allocator_traits<Alloc>::template rebind_alloc<_leaf>
+		    leaf_allocator;
+		typedef typename leestl::allocator_traits<Alloc>::template rebind_alloc<_internal>
+		    internal_allocator;
+		typedef leestl::allocator_traits<value_allocator>    _value_traits;
+		typedef leestl::allocator_traits<leaf_allocator>     _leaf_traits;
+		typedef leestl::allocator_traits<internal_allocator> _internal_traits;
+
+		static constexpr size_type _LEAF_CAP = _leaf::CAPACITY;
+		static constexpr size_type _LEAF_MIN = _LEAF_CAP / 2;    // 非根叶结点的最少元素个数
+		static constexpr size_type _INTERNAL_CAP = _internal::CAPACITY;
+		static constexpr size_type _INTERNAL_MIN = _INTERNAL_CAP / 2;
+		static constexpr size_type _MAX_HEIGHT = 64;
+
+		// 继承配置器以利用空基类优化，无状态配置器不占用额外空间
+		struct _btree_impl : public value_allocator {
+			_node    *root = nullptr;
+			_leaf    *first = nullptr;    // 最左的叶结点
+			_leaf    *last = nullptr;     // 最右的叶结点
+			size_type size = 0;
+
+			_btree_impl() = default;
+			_btree_impl(const value_allocator &a) : value_allocator(a) {}
+		};
+
+		_btree_impl _impl;
+		key_compare _comp;
+
+		value_allocator       &_get_alloc() noexcept { return _impl; }
+		const value_allocator &_get_alloc() const noexcept { return _impl; }
+
+	public:
+		_btree() = default;
+
+		explicit _btree(const key_compare &comp, const allocator_type &a = allocator_type())
+		        : _impl(value_allocator(a)), _comp(comp) {}
+
+		explicit _btree(const allocator_type &a) : _impl(value_allocator(a)) {}
+
+		template <typename _II, typename = leestl::RequireInputIterator<_II>>
+		_btree(_II first, _II last, const key_compare &comp = key_compare(),
+		       const allocator_type &a = allocator_type())
+		        : _btree(comp, a) {
+			_insert_or_clear(first, last);
+		}
+
+		_btree(std::initializer_list<value_type> ilist, const key_compare &comp = key_compare(),
+		       const allocator_type &a = allocator_type())
+		        : _btree(ilist.begin(), ilist.end(), comp, a) {}
+
+		// 复制构造：元素按升序逐个追加，得到的结点几乎全满
+		_btree(const _btree &x)
+		        : _impl(_value_traits::select_on_container_copy_construction(x._get_alloc())),
+		          _comp(x._comp) {
+			_insert_or_clear(x.begin(), x.end());
+		}
+
+		_btree(_btree &&x) noexcept : _impl(leestl::move(x._get_alloc())), _comp(x._comp) {
+			_steal(x);
+		}
+
+		// 复制赋值：先复制到临时树再接管，失败时本容器不变；
+		// propagate_on_container_copy_assignment 为真时同时复制配置器，否则保留原配置器
+		_btree &operator=(const _btree &x) {
+			if (this != &x) {
+				constexpr bool pocca = _value_traits::propagate_on_container_copy_assignment::value;
+				_btree         tmp(x._comp, allocator_type(pocca ? x._get_alloc() : _get_alloc()));
+				tmp._insert_or_clear(x.begin(), x.end());
+				clear();
+				if constexpr (pocca) _get_alloc() = x._get_alloc();
+				_comp = x._comp;
+				_steal(tmp);
+			}
+			return *this;
+		}
+
+		_btree &operator=(_btree &&x) noexcept(
+		    _value_traits::propagate_on_container_move_assignment::value ||
+		    _value_traits::is_always_equal::value) {
+			if (this == &x) return *this;
+			if constexpr (
+			    _value_traits::propagate_on_container_move_assignment::value ||
+			    _value_traits::is_always_equal::value) {
+				clear();
+				if constexpr (_value_traits::propagate_on_container_move_assignment::value)
+					_get_alloc() = leestl::move(x._get_alloc());
+				_comp = x._comp;
+				_steal(x);
+			} else if (_value_traits::equal(_get_alloc(), x._get_alloc())) {
+				clear();
+				_comp = x._comp;
+				_steal(x);
+			} else {
+				// 配置器不同，只能逐个移动元素
+				clear();
+				_comp = x._comp;
+				// 集合的迭代器只读，直接按叶结点访问元素；元素按升序追加
+				if (x._impl.root)
+					for (_leaf *l = x._impl.first; l; l = l->next)
+						for (size_type i = 0; i < l->count; ++i) {
+							value_type &v = l->values()[i];
+							_emplace_unique(Policy::key(v), leestl::move(v));
+						}
+				x.clear();
+			}
+			return *this;
+		}
+
+		_btree &operator=(std::initializer_list<value_type> ilist) {
+			clear();
+			insert(ilist.begin(), ilist.end());
+			return *this;
+		}
+
+		~_btree() { clear(); }
+
+		allocator_type get_allocator() const noexcept { return allocator_type(_get_alloc()); }
+		key_compare    key_comp() const { return _comp; }
+
+		iterator begin() noexcept { return _impl.root ? iterator(_impl.first, 0) : iterator(); }
+		const_iterator begin() const noexcept { return const_cast<_btree *>(this)->begin(); }
+		iterator       end() noexcept { return _end(); }
+		const_iterator end() const noexcept { return _end(); }
+		const_iterator cbegin() const noexcept { return begin(); }
+		const_iterator cend() const noexcept { return end(); }
+
+		reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+		bool      empty() const noexcept { return _impl.size == 0; }
+		size_type size() const noexcept { return _impl.size; }
+		size_type max_size() const noexcept { return _value_traits::max_size(_get_alloc()); }
+
+		// 树高，空树为 0，只有一个叶结点时为 1
+		size_type height() const noexcept {
+			size_type h = 0;
+			for (const _node *n = _impl.root; n; ++h)
+				n = n->leaf ? nullptr : static_cast<const _internal *>(n)->children[0];
+			return h;
+		}
+
+		// 销毁所有元素并释放所有结点
+		void clear() noexcept {
+			if (_impl.root == nullptr) return;
+			_destroy(_impl.root);
+			_impl.root = nullptr;
+			_impl.first = _impl.last = nullptr;
+			_impl.size = 0;
+		}
+
+		std::pair<iterator, bool> insert(const value_type &v) {
+			return _emplace_unique(Policy::key(v), v);
+		}
+
+		std::pair<iterator, bool> insert(value_type &&v) {
+			return _emplace_unique(Policy::key(v), leestl::move(v));
+		}
+
+		// 逐个插入；区间按键升序时每个元素均摊 O(1)
+		template <typename _II, typename = leestl::RequireInputIterator<_II>>
+		void insert(_II first, _II last) {
+			for (; first != last; ++first) _emplace_unique(Policy::key(*first), *first);
+		}
+
+		void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+
+		/**
+		 * @brief 由 args 构造元素并插入，键已存在时不插入
+		 *
+		 * @return std::pair<iterator, bool> 键所在的位置，以及是否插入了新元素
+		 */
+		template <typename... Args>
+		std::pair<iterator, bool> emplace(Args &&...args) {
+			// 需要先构造出元素才能取得键
+			value_type tmp(leestl::forward<Args>(args)...);
+			return _emplace_unique(Policy::key(tmp), leestl::move(tmp));
+		}
+
+		iterator       find(const key_type &key) { return _find(key); }
+		const_iterator find(const key_type &key) const { return _find(key); }
+
+		// 异构查找，比较仿函数声明 is_transparent 时可用，例如以 string_view 查找 std::string 键
+		template <typename K, typename C = Compare, typename = _require_transparent_compare<C>>
+		iterator find(const K &key) {
+			return _find(key);
+		}
+
+		template <typename K, typename C = Compare, typename = _require_transparent_compare<C>>
+		const_iterator find(const K &key) const {
+			return _find(key);
+		}
+
+		bool contains(const key_type &key) const { return _find(key) != _end(); }
+
+		template <typename K, typename C = Compare, typename = _require_transparent_compare<C>>
+		bool contains(const K &key) const {
+			return _find(key) != _end();
+		}
+
+		size_type count(const key_type &key) const { return contains(key); }
+
+		template <typename K, typename C = Compare, typename = _require_transparent_compare<C>>
+		size_type count(const K &key) const {
+			return contains(key);
+		}
+
+		// 第一个不小于 key 的元素
+		iterator       lower_bound(const key_type &key) { return _lower_bound(key); }
+		const_iterator lower_bound(const key_type &key) const { return _lower_bound(key); }
+
+		template <typename K, typename C = Compare, typename = _require_transparent_compare<C>>
+		iterator lower_bound(const K &key) {
+			return _lower_bound(key);
+		}
+
+		template <typename K, typename C = Compare, typename = _require_transparent_compare<C>>
+		const_iterator lower_bound(const K &key) const {
+			return _lower_bound(key);
+		}
+
+		// 第一个大于 key 的元素
+		iterator       upper_bound(const key_type &key) { return _upper_bound(key); }
+		const_iterator upper_bound(const key_type &key) const { return _upper_bound(key); }
+
+		template <typename K, typename C = Compare, typename = _require_transparent_compare<C>>
+		iterator upper_bound(const K &key) {
+			return _upper_bound(key);
+		}
+
+		template <typename K, typename C = Compare, typename = _require_transparent_compare<C>>
+		const_iterator upper_bound(const K &key) const {
+			return _upper_bound(key);
+		}
+
+		// 键唯一，区间至多包含一个元素
+		std::pair<iterator, iterator> equal_range(const key_type &key) {
+			iterator first = _find(key), last = first;
+			if (last != end()) ++last;
+			return std::pair<iterator, iterator>(first, last);
+		}
+
+		std::pair<const_iterator, const_iterator> equal_range(const key_type &key) const {
+			return const_cast<_btree *>(this)->equal_range(key);
+		}
+
+		/**
+		 * @brief 删除 pos 所指的元素
+		 *
+		 * @param pos 元素位置
+		 * @return iterator 下一个元素的位置
+		 */
+		iterator erase(const_iterator pos) { return _erase(pos._leaf, pos._pos); }
+
+		// 删除会移动元素使 last 失效，因此先求出要删除的元素个数
+		iterator erase(const_iterator first, const_iterator last) {
+			if (first == begin() && last == end()) {
+				clear();
+				return end();
+			}
+			iterator it(first._leaf, first._pos);
+			for (difference_type n = leestl::distance(first, last); n > 0; --n)
+				it = _erase(it._leaf, it._pos);
+			return it;
+		}
+
+		/**
+		 * @brief 删除键为 key 的元素
+		 *
+		 * @param key 键
+		 * @return size_type 删除的元素个数（0 或 1）
+		 */
+		size_type erase(const key_type &key) { return _erase_key(key); }
+
+		template <typename K, typename C = Compare, typename = _require_transparent_compare<C>,
+		          typename = std::enable_if_t<!std::is_convertible_v<const K &, const_iterator>>>
+		size_type erase(const K &key) {
+			return _erase_key(key);
+		}
+
+		void swap(_btree &x) noexcept {
+			leestl::swap(_impl.root, x._impl.root);
+			leestl::swap(_impl.first, x._impl.first);
+			leestl::swap(_impl.last, x._impl.last);
+			leestl::swap(_impl.size, x._impl.size);
+			leestl::swap(_comp, x._comp);
+			if constexpr (_value_traits::propagate_on_container_swap::value)
+				leestl::swap(_get_alloc(), x._get_alloc());
+		}
+
+	protected:
+		/**
+		 * @brief 键为 key 的元素不存在时，在叶结点中由 args 构造元素
+		 *
+		 * @param key 元素的键，用于查找
+		 * @param args 构造元素的参数，不能引用树中的元素（插入可能移动它们）
+		 * @return std::pair<iterator, bool> 键所在的位置，以及是否插入了新元素
+		 */
+		template <typename... Args>
+		std::pair<iterator, bool> _emplace_unique(const key_type &key, Args &&...args) {
+			_leaf    *l;
+			size_type i;
+			if (_impl.size &&
+			    _comp(Policy::key(_impl.last->values()[_impl.last->count - 1]), key)) {
+				// 大于所有元素：直接追加到最后一个叶结点
+				l = _impl.last;
+				i = l->count;
+			} else {
+				if (_impl.root == nullptr) _impl.root = _impl.first = _impl.last = _new_leaf();
+				l = _find_leaf(key);
+				i = _lower_in_leaf(l, key);
+				if (i < l->count && !_comp(key, Policy::key(l->values()[i])))
+					return std::pair<iterator, bool>(iterator(l, unsigned(i)), false);
+			}
+			if (l->count == _LEAF_CAP) _split_leaf(l, i);
+			_insert_value(l, i, leestl::forward<Args>(args)...);
+			return std::pair<iterator, bool>(iterator(l, unsigned(i)), true);
+		}
+
+		template <typename K>
+		iterator _find(const K &key) const {
+			if (_impl.root == nullptr) return iterator();
+			_leaf          *l = _find_leaf(key);
+			const size_type i = _lower_in_leaf(l, key);
+			if (i < l->count && !_comp(key, Policy::key(l->values()[i])))
+				return iterator(l, unsigned(i));
+			return _end();
+		}
+
+		template <typename K>
+		iterator _lower_bound(const K &key) const {
+			if (_impl.root == nullptr) return iterator();
+			_leaf *l = _find_leaf(key);
+			return _make_iterator(l, _lower_in_leaf(l, key));
+		}
+
+		template <typename K>
+		iterator _upper_bound(const K &key) const {
+			if (_impl.root == nullptr) return iterator();
+			_leaf *l = _find_leaf(key);
+			return _make_iterator(l, _upper_in_leaf(l, key));
+		}
+
+		template <typename K>
+		size_type _erase_key(const K &key) {
+			iterator it = _find(key);
+			if (it == _end()) return 0;
+			_erase(it._leaf, it._pos);
+			return 1;
+		}
+
+	private:
+		iterator _end() const noexcept {
+			return _impl.root ? iterator(_impl.last, _impl.last->count) : iterator();
+		}
+
+		// 叶结点末尾的位置规范为下一个叶结点的开头，使其与 ++ 得到的迭代器相等
+		static iterator _make_iterator(_leaf *l, size_type i) noexcept {
+			if (i == l->count && l->next) return iterator(l->next, 0);
+			return iterator(l, unsigned(i));
+		}
+
+		/*------------------------------------ 结点内查找 ------------------------------------*/
+
+		template <typename K>
+		size_type _lower_in_leaf(_leaf *l, const K &key) const {
+			const value_type *v = l->values();
+			auto less = [this](const value_type &a, const K &k) { return _comp(Policy::key(a), k); };
+			return leestl::lower_bound(v, v + l->count, key, less) - v;
+		}
+
+		template <typename K>
+		size_type _upper_in_leaf(_leaf *l, const K &key) const {
+			const value_type *v = l->values();
+			auto less = [this](const K &k, const value_type &a) { return _comp(k, Policy::key(a)); };
+			return leestl::upper_bound(v, v + l->count, key, less) - v;
+		}
+
+		// 从根下降到可能包含 key 的叶结点：在每个内部结点中进入第一个大于 key 的分隔键左侧的子树
+		template <typename K>
+		_leaf *_find_leaf(const K &key) const {
+			_node *n = _impl.root;
+			while (!n->leaf) {
+				_internal      *in = static_cast<_internal *>(n);
+				const key_type *k = in->keys();
+				n = in->children[leestl::upper_bound(k, k + in->count, key, _comp) - k];
+			}
+			return static_cast<_leaf *>(n);
+		}
+
+		/*------------------------------------ 结点管理 ------------------------------------*/
+
+		_leaf *_new_leaf() {
+			leaf_allocator a(_get_alloc());
+			_leaf         *l = ::new (static_cast<void *>(_leaf_traits::allocate(a, 1))) _leaf;
+			l->parent = nullptr;
+			l->pos = l->count = 0;
+			l->leaf = true;
+			l->prev = l->next = nullptr;
+			return l;
+		}
+
+		_internal *_new_internal() {
+			internal_allocator a(_get_alloc());
+			_internal *n = ::new (static_cast<void *>(_internal_traits::allocate(a, 1))) _internal;
+			n->parent = nullptr;
+			n->pos = n->count = 0;
+			n->leaf = false;
+			return n;
+		}
+
+		void _delete_leaf(_leaf *l) noexcept {
+			leaf_allocator a(_get_alloc());
+			_leaf_traits::deallocate(a, l, 1);
+		}
+
+		void _delete_internal(_internal *n) noexcept {
+			internal_allocator a(_get_alloc());
+			_internal_traits::deallocate(a, n, 1);
+		}
+
+		// 销毁子树 n 中的所有元素与分隔键并释放结点
+		void _destroy(_node *n) noexcept {
+			if (n->leaf) {
+				_leaf *l = static_cast<_leaf *>(n);
+				if constexpr (!std::is_trivially_destructible_v<value_type>)
+					for (size_type i = 0; i < l->count; ++i)
+						_value_traits::destroy(_get_alloc(), l->values() + i);
+				_delete_leaf(l);
+			} else {
+				_internal *in = static_cast<_internal *>(n);
+				for (size_type i = 0; i <= in->count; ++i) _destroy(in->children[i]);
+				leestl::destory(in->keys(), in->keys() + in->count);
+				_delete_internal(in);
+			}
+		}
+
+		void _steal(_btree &x) noexcept {
+			_impl.root = x._impl.root;
+			_impl.first = x._impl.first;
+			_impl.last = x._impl.last;
+			_impl.size = x._impl.size;
+			x._impl.root = nullptr;
+			x._impl.first = x._impl.last = nullptr;
+			x._impl.size = 0;
+		}
+
+		// 构造函数中插入区间，失败时释放已插入的元素
+		template <typename _II>
+		void _insert_or_clear(_II first, _II last) {
+			try {
+				insert(first, last);
+			} catch (...) {
+				clear();
+				throw;
+			}
+		}
+
+		// 把 [src, src + n) 的元素移动到 dst 并销毁原元素，两段可以重叠
+		void _move_values(value_type *dst, value_type *src, size_type n) {
+			if constexpr (leestl::is_trivially_relocatable_v<value_type>) {
+				if (n)
+					std::memmove(
+					    static_cast<void *>(dst), static_cast<void *>(src), n * sizeof(value_type));
+			} else if (dst < src) {
+				for (size_type j = 0; j < n; ++j) Policy::transfer(_get_alloc(), dst + j, src + j);
+			} else {
+				for (size_type j = n; j-- > 0;) Policy::transfer(_get_alloc(), dst + j, src + j);
+			}
+		}
+
+		// 把 [src, src + n) 的分隔键移动到 dst 并销毁原对象，两段可以重叠
+		static void _move_keys(key_type *dst, key_type *src, size_type n) {
+			if constexpr (leestl::is_trivially_relocatable_v<key_type>) {
+				if (n)
+					std::memmove(
+					    static_cast<void *>(dst), static_cast<void *>(src), n * sizeof(key_type));
+			} else if (dst < src) {
+				for (size_type j = 0; j < n; ++j) _move_key(dst + j, src + j);
+			} else {
+				for (size_type j = n; j-- > 0;) _move_key(dst + j, src + j);
+			}
+		}
+
+		static void _move_key(key_type *dst, key_type *src) {
+			leestl::construct(dst, leestl::move(*src));
+			leestl::destory(src);
+		}
+
+		// 把 src 的 children[from, from + n) 移到 dst 的 children[to, to + n)，并更新它们的父结点与下标
+		static void _move_children(
+		    _internal *dst, size_type to, _internal *src, size_type from, size_type n) noexcept {
+			std::memmove(dst->children + to, src->children + from, n * sizeof(_node *));
+			for (size_type j = to; j < to + n; ++j) {
+				dst->children[j]->parent = dst;
+				dst->children[j]->pos = (unsigned short)j;
+			}
+		}
+
+		/*-------------------------------------- 插入 --------------------------------------*/
+
+		template <typename... Args>
+		void _insert_value(_leaf *l, size_type i, Args &&...args) {
+			value_type *v = l->values();
+			_move_values(v + i + 1, v + i, l->count - i);
+			try {
+				_value_traits::construct(_get_alloc(), v + i, leestl::forward<Args>(args)...);
+			} catch (...) {
+				_move_values(v + i, v + i + 1, l->count - i);
+				throw;
+			}
+			++l->count;
+			++_impl.size;
+		}
+
+		// 分裂前一次分配好所需的内部结点，分裂过程中不会因内存不足而中断
+		struct _spare_nodes {
+			_btree    &tree;
+			_internal *nodes[_MAX_HEIGHT];
+			size_type  count = 0;
+
+			_spare_nodes(_btree &t, size_type n) : tree(t) {
+				try {
+					for (; count < n; ++count) nodes[count] = tree._new_internal();
+				} catch (...) {
+					while (count) tree._delete_internal(nodes[--count]);
+					throw;
+				}
+			}
+
+			~_spare_nodes() {
+				while (count) tree._delete_internal(nodes[--count]);
+			}
+
+			_internal *take() noexcept { return nodes[--count]; }
+		};
+
+		// 结点 n 分裂时需要新建的内部结点数：每个已满的祖先分裂出一个，根分裂时还需要一个新根
+		size_type _internal_needed(const _node *n) const noexcept {
+			size_type        k = 0;
+			const _internal *p = n->parent;
+			for (; p && p->count == _INTERNAL_CAP; p = p->parent) ++k;
+			return p ? k : k + 1;
+		}
+
+		/**
+		 * @brief 分裂已满的叶结点
+		 *
+		 * @param l 叶结点，返回时为新元素应插入的叶结点
+		 * @param i 新元素的插入位置，返回时为在 l 中的位置
+		 */
+		void _split_leaf(_leaf *&l, size_type &i) {
+			// 向最后一个叶结点末尾追加时只移出一个元素，按升序插入时叶结点几乎全满
+			const bool      append = l->next == nullptr && i == l->count;
+			const size_type mid = append ? l->count - 1 : l->count / 2;
+			key_type        sep(Policy::key(l->values()[mid]));
+			_spare_nodes    spare(*this, _internal_needed(l));
+			_leaf          *r = _new_leaf();
+
+			_move_values(r->values(), l->values() + mid, l->count - mid);
+			r->count = (unsigned short)(l->count - mid);
+			l->count = (unsigned short)mid;
+			r->prev = l;
+			r->next = l->next;
+			(l->next ? l->next->prev : _impl.last) = r;
+			l->next = r;
+			_insert_into_parent(l, sep, r, spare, append);
+			if (i > mid) {
+				l = r;
+				i -= mid;
+			}
+		}
+
+		/**
+		 * @brief 结点 left 分裂出 right 后，把分隔键 sep 与 right 插入 left 的父结点，
+		 * 父结点已满时继续向上分裂
+		 *
+		 * @param sep right 中的最小键，插入后被移走
+		 * @param append 是否为向树的末尾追加，是则分裂时左侧结点保留尽可能多的键
+		 */
+		void _insert_into_parent(
+		    _node *left, key_type &sep, _node *right, _spare_nodes &spare, bool append) {
+			_internal *p = left->parent;
+			if (p == nullptr) {
+				p = spare.take();
+				p->children[0] = left;
+				left->parent = p;
+				left->pos = 0;
+				_impl.root = p;
+			}
+			size_type pos = left->pos;
+			if (p->count == _INTERNAL_CAP) {
+				// p 保留 keys[0, m) 与 children[0, m]，keys[m] 上移到父结点，其余移到 q
+				const size_type m = append ? _INTERNAL_CAP - 1 : _INTERNAL_CAP / 2;
+				const size_type moved = _INTERNAL_CAP - m - 1;
+				_internal      *q = spare.take();
+				_move_keys(q->keys(), p->keys() + m + 1, moved);
+				_move_children(q, 0, p, m + 1, moved + 1);
+				q->count = (unsigned short)moved;
+				key_type up(leestl::move(p->keys()[m]));
+				leestl::destory(p->keys() + m);
+				p->count = (unsigned short)m;
+				_insert_into_parent(p, up, q, spare, append);
+				if (pos > m) {
+					p = q;
+					pos -= m + 1;
+				}
+			}
+			// 在 keys[pos] 处插入 sep，在 children[pos + 1] 处插入 right
+			_move_keys(p->keys() + pos + 1, p->keys() + pos, p->count - pos);
+			leestl::construct(p->keys() + pos, leestl::move(sep));
+			_move_children(p, pos + 2, p, pos + 1, p->count - pos);
+			p->children[pos + 1] = right;
+			right->parent = p;
+			right->pos = (unsigned short)(pos + 1);
+			++p->count;
+		}
+
+		/*-------------------------------------- 删除 --------------------------------------*/
+
+		// 删除叶结点 l 中的第 i 个元素，返回下一个元素的位置
+		iterator _erase(_leaf *l, size_type i) {
+			value_type *v = l->values();
+			_value_traits::destroy(_get_alloc(), v + i);
+			_move_values(v + i, v + i + 1, l->count - i - 1);
+			--l->count;
+			--_impl.size;
+			if (l == _impl.root) {
+				if (l->count == 0) clear();
+				if (_impl.root == nullptr) return iterator();
+			} else if (l->count < _LEAF_MIN) {
+				_rebalance_leaf(l, i);
+			}
+			return _make_iterator(l, i);
+		}
+
+		// 删除上一层的分隔键 keys[c - 1] 与子结点 children[c]
+		void _remove_child(_internal *p, size_type c) noexcept {
+			leestl::destory(p->keys() + c - 1);
+			_move_keys(p->keys() + c - 1, p->keys() + c, p->count - c);
+			_move_children(p, c, p, c + 1, p->count - c);
+			--p->count;
+		}
+
+		/**
+		 * @brief 叶结点 l 的元素少于下限时与相邻的兄弟合并，合并不下时从兄弟移来一部分元素
+		 *
+		 * @param l 叶结点，合并到左兄弟时改为左兄弟
+		 * @param i l 中的一个位置，随元素的移动更新
+		 */
+		void _rebalance_leaf(_leaf *&l, size_type &i) {
+			_internal *p = l->parent;
+			if (l->pos > 0) {
+				_leaf *left = static_cast<_leaf *>(p->children[l->pos - 1]);
+				if (left->count + l->count <= _LEAF_CAP) {
+					i += left->count;
+					_merge_leaves(left, l);
+					l = left;
+				} else {
+					const size_type k = (left->count - l->count) / 2;
+					if (!_set_separator(p->keys()[l->pos - 1], left->values()[left->count - k]))
+						return;
+					_move_values(l->values() + k, l->values(), l->count);
+					_move_values(l->values(), left->values() + left->count - k, k);
+					left->count = (unsigned short)(left->count - k);
+					l->count = (unsigned short)(l->count + k);
+					i += k;
+					return;
+				}
+			} else {
+				_leaf *right = static_cast<_leaf *>(p->children[1]);
+				if (l->count + right->count <= _LEAF_CAP) {
+					_merge_leaves(l, right);
+				} else {
+					const size_type k = (right->count - l->count) / 2;
+					if (!_set_separator(p->keys()[0], right->values()[k])) return;
+					_move_values(l->values() + l->count, right->values(), k);
+					_move_values(right->values(), right->values() + k, right->count - k);
+					l->count = (unsigned short)(l->count + k);
+					right->count = (unsigned short)(right->count - k);
+					return;
+				}
+			}
+			_rebalance_internal(p);
+		}
+
+		// 从兄弟移来元素前先把分隔键改为 v 的键；复制键失败时放弃移动，
+		// 结点暂时少于下限不影响正确性
+		static bool _set_separator(key_type &sep, const value_type &v) noexcept {
+			try {
+				sep = Policy::key(v);
+			} catch (...) {
+				return false;
+			}
+			return true;
+		}
+
+		// 把右兄弟 r 的元素全部移到 l 末尾并释放 r
+		void _merge_leaves(_leaf *l, _leaf *r) {
+			_move_values(l->values() + l->count, r->values(), r->count);
+			l->count = (unsigned short)(l->count + r->count);
+			l->next = r->next;
+			(r->next ? r->next->prev : _impl.last) = l;
+			_remove_child(l->parent, r->pos);
+			_delete_leaf(r);
+		}
+
+		// 内部结点 n 的键少于下限时与兄弟合并或从兄弟借键，合并后继续检查父结点
+		void _rebalance_internal(_internal *n) {
+			while (n != _impl.root && size_type(n->count) < _INTERNAL_MIN) {
+				_internal *p = n->parent;
+				_internal *l = n->pos > 0 ? static_cast<_internal *>(p->children[n->pos - 1]) : n;
+				_internal *r = n->pos > 0 ? n : static_cast<_internal *>(p->children[1]);
+				const size_type j = r->pos - 1;
+				if (size_type(l->count) + r->count + 1 <= _INTERNAL_CAP) {
+					// 分隔键下移到 l 末尾，r 的键与子结点接在其后
+					leestl::construct(l->keys() + l->count, leestl::move(p->keys()[j]));
+					_move_keys(l->keys() + l->count + 1, r->keys(), r->count);
+					_move_children(l, l->count + 1, r, 0, r->count + 1);
+					l->count = (unsigned short)(l->count + r->count + 1);
+					_remove_child(p, r->pos);
+					_delete_internal(r);
+					n = p;
+				} else if (n == r) {
+					_rotate_right(p, j, l, r, (l->count - r->count) / 2);
+					return;
+				} else {
+					_rotate_left(p, j, l, r, (r->count - l->count) / 2);
+					return;
+				}
+			}
+			// 根没有键时由唯一的子结点代替
+			if (n == _impl.root && n->count == 0) {
+				_impl.root = n->children[0];
+				_impl.root->parent = nullptr;
+				_impl.root->pos = 0;
+				_delete_internal(n);
+			}
+		}
+
+		// 左兄弟 l 的最后 k 个子结点经分隔键 p->keys()[j] 转到 r 的开头
+		void _rotate_right(_internal *p, size_type j, _internal *l, _internal *r, size_type k) {
+			_move_keys(r->keys() + k, r->keys(), r->count);
+			_move_children(r, k, r, 0, r->count + 1);
+			leestl::construct(r->keys() + k - 1, leestl::move(p->keys()[j]));
+			leestl::destory(p->keys() + j);
+			_move_keys(r->keys(), l->keys() + l->count - k + 1, k - 1);
+			_move_children(r, 0, l, l->count - k + 1, k);
+			_move_key(p->keys() + j, l->keys() + l->count - k);
+			l->count = (unsigned short)(l->count - k);
+			r->count = (unsigned short)(r->count + k);
+		}
+
+		// 右兄弟 r 的前 k 个子结点经分隔键 p->keys()[j] 转到 l 的末尾
+		void _rotate_left(_internal *p, size_type j, _internal *l, _internal *r, size_type k) {
+			leestl::construct(l->keys() + l->count, leestl::move(p->keys()[j]));
+			leestl::destory(p->keys() + j);
+			_move_keys(l->keys() + l->count + 1, r->keys(), k - 1);
+			_move_children(l, l->count + 1, r, 0, k);
+			_move_key(p->keys() + j, r->keys() + k - 1);
+			_move_keys(r->keys(), r->keys() + k, r->count - k);
+			_move_children(r, 0, r, k, r->count - k + 1);
+			l->count = (unsigned short)(l->count + k);
+			r->count = (unsigned short)(r->count - k);
+		}
+	};
+
+	/**
+	 * @brief 比较两棵树是否包含相同的元素
+	 */
+	template <typename Policy, typename Compare, typename Alloc>
+	bool operator==(
+	    const _btree<Policy, Compare, Alloc> &x, const _btree<Policy, Compare, Alloc> &y) {
+		return x.size() == y.size() && leestl::equal(x.begin(), x.end(), y.begin());
+	}
+
+	template <typename Policy, typename Compare, typename Alloc>
+	bool operator!=(
+	    const _btree<Policy, Compare, Alloc> &x, const _btree<Policy, Compare, Alloc> &y) {
+		return !(x == y);
+	}
+
+	// 按元素的字典序比较
+	template <typename Policy, typename Compare, typename Alloc>
+	bool operator<(
+	    const _btree<Policy, Compare, Alloc> &x, const _btree<Policy, Compare, Alloc> &y) {
+		return leestl::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+	}
+
+}    // namespace leestl
+
+#endif
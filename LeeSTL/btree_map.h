@@ -0,0 +1,134 @@
+/** @file btree_map.h
+ * 	这个文件实现有序关联容器 btree_map
+ *
+ * 	元素按键升序存放在 B+ 树的叶结点中，相邻元素在内存中连续，适合大量的点查找与范围遍历。
+ * 	插入与删除会移动同一结点中的元素，使所有迭代器、指针与引用失效。
+ */
+
+#ifndef _LEESTL_BTREE_MAP_H_
+#define _LEESTL_BTREE_MAP_H_ 1
+
+#include <stdexcept>
+#include <tuple>
+
+#include "btree.h"
+
+namespace leestl {
+
+	// btree_map 的元素为 std::pair<const Key, T>，键取 first
+	template <typename Key, typename T>
+	struct _btree_map_policy {
+		typedef Key                     key_type;
+		typedef std::pair<const Key, T> value_type;
+		static constexpr bool           constant_iterators = false;
+
+		static const Key &key(const value_type &v) noexcept { return v.first; }
+
+		// 把 src 的元素移动到未初始化的 dst 并销毁 src。键是 const 的，
+		// 但 src 随即被销毁，移动它的键不会被观察到
+		template <typename A>
+		static void transfer(A &a, value_type *dst, value_type *src) {
+			leestl::allocator_traits<A>::construct(
+			    a, dst, std::piecewise_construct,
+			    std::forward_as_tuple(leestl::move(const_cast<Key &>(src->first))),
+			    std::forward_as_tuple(leestl::move(src->second)));
+			leestl::allocator_traits<A>::destroy(a, src);
+		}
+	};
+
+	/**
+	 * @brief 键唯一的 B+ 树有序映射表
+	 *
+	 * @tparam Key 键类型，需要可复制（内部结点保存键的副本）
+	 * @tparam T 值类型
+	 * @tparam Compare 键的比较仿函数，声明 is_transparent 时支持异构查找
+	 * @tparam Alloc 配置器类型
+	 */
+	template <
+	    typename Key, typename T, typename Compare = std::less<Key>,
+	    typename Alloc = leestl::allocator<std::pair<const Key, T>>>
+	class btree_map : public _btree<_btree_map_policy<Key, T>, Compare, Alloc> {
+		typedef _btree<_btree_map_policy<Key, T>, Compare, Alloc> _base;
+
+	public:
+		typedef T                              mapped_type;
+		typedef typename _base::key_type       key_type;
+		typedef typename _base::value_type     value_type;
+		typedef typename _base::size_type      size_type;
+		typedef typename _base::iterator       iterator;
+		typedef typename _base::const_iterator const_iterator;
+
+		using _base::_base;
+		using _base::operator=;
+
+		btree_map() = default;
+
+		/**
+		 * @brief 键不存在时以 args 构造值并插入，键已存在时什么也不做（args 不会被移动）
+		 *
+		 * @param key 键
+		 * @param args 构造值的参数
+		 * @return std::pair<iterator, bool> 键所在的位置，以及是否插入了新元素
+		 */
+		template <typename... Args>
+		std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) {
+			return this->_emplace_unique(
+			    key, std::piecewise_construct, std::forward_as_tuple(key),
+			    std::forward_as_tuple(leestl::forward<Args>(args)...));
+		}
+
+		template <typename... Args>
+		std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args) {
+			return this->_emplace_unique(
+			    key, std::piecewise_construct, std::forward_as_tuple(leestl::move(key)),
+			    std::forward_as_tuple(leestl::forward<Args>(args)...));
+		}
+
+		/**
+		 * @brief 键不存在时插入，键已存在时把值赋为 obj
+		 *
+		 * @return std::pair<iterator, bool> 键所在的位置，以及是否插入了新元素
+		 */
+		template <typename M>
+		std::pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj) {
+			auto r = try_emplace(key, leestl::forward<M>(obj));
+			if (!r.second) r.first->second = leestl::forward<M>(obj);
+			return r;
+		}
+
+		template <typename M>
+		std::pair<iterator, bool> insert_or_assign(key_type &&key, M &&obj) {
+			auto r = try_emplace(leestl::move(key), leestl::forward<M>(obj));
+			if (!r.second) r.first->second = leestl::forward<M>(obj);
+			return r;
+		}
+
+		// 返回键对应的值，键不存在时插入值初始化的元素
+		mapped_type &operator[](const key_type &key) { return try_emplace(key).first->second; }
+		mapped_type &operator[](key_type &&key) {
+			return try_emplace(leestl::move(key)).first->second;
+		}
+
+		// 返回键对应的值，键不存在时抛出 std::out_of_range
+		mapped_type &at(const key_type &key) {
+			iterator it = this->find(key);
+			if (it == this->end()) throw std::out_of_range("btree_map::at: key not found");
+			return it->second;
+		}
+
+		const mapped_type &at(const key_type &key) const {
+			const_iterator it = this->find(key);
+			if (it == this->end()) throw std::out_of_range("btree_map::at: key not found");
+			return it->second;
+		}
+	};
+
+	template <typename Key, typename T, typename Compare, typename Alloc>
+	inline void swap(
+	    btree_map<Key, T, Compare, Alloc> &x, btree_map<Key, T, Compare, Alloc> &y) noexcept {
+		x.swap(y);
+	}
+
+}    // namespace leestl
+
+#endif
@@ -0,0 +1,59 @@
+/** @file btree_set.h
+ * 	这个文件实现有序集合容器 btree_set
+ *
+ * 	元素按升序存放在 B+ 树的叶结点中，迭代器只读。
+ * 	插入与删除会移动同一结点中的元素，使所有迭代器、指针与引用失效。
+ */
+
+#ifndef _LEESTL_BTREE_SET_H_
+#define _LEESTL_BTREE_SET_H_ 1
+
+#include "btree.h"
+
+namespace leestl {
+
+	// btree_set 的元素就是键
+	template <typename Key>
+	struct _btree_set_policy {
+		typedef Key           key_type;
+		typedef Key           value_type;
+		static constexpr bool constant_iterators = true;
+
+		static const Key &key(const value_type &v) noexcept { return v; }
+
+		// 把 src 的元素移动到未初始化的 dst 并销毁 src
+		template <typename A>
+		static void transfer(A &a, value_type *dst, value_type *src) {
+			leestl::allocator_traits<A>::construct(a, dst, leestl::move(*src));
+			leestl::allocator_traits<A>::destroy(a, src);
+		}
+	};
+
+	/**
+	 * @brief 元素唯一的 B+ 树有序集合
+	 *
+	 * @tparam Key 元素类型，需要可复制（内部结点保存键的副本）
+	 * @tparam Compare 比较仿函数，声明 is_transparent 时支持异构查找
+	 * @tparam Alloc 配置器类型
+	 */
+	template <
+	    typename Key, typename Compare = std::less<Key>, typename Alloc = leestl::allocator<Key>>
+	class btree_set : public _btree<_btree_set_policy<Key>, Compare, Alloc> {
+		typedef _btree<_btree_set_policy<Key>, Compare, Alloc> _base;
+
+	public:
+		using _base::_base;
+		using _base::operator=;
+
+		btree_set() = default;
+	};
+
+	template <typename Key, typename Compare, typename Alloc>
+	inline void swap(
+	    btree_set<Key, Compare, Alloc> &x, btree_set<Key, Compare, Alloc> &y) noexcept {
+		x.swap(y);
+	}
+
+}    // namespace leestl
+
+#endif
@@ -0,0 +1,760 @@
+/** @file circular_buffer.h
+ * 	这个文件实现固定容量的环形缓冲区 circular_buffer
+ *
+ * 	容量在构造时给出并一次性分配，此后的插入、删除只在这块空间上移动首尾位置，不再分配内存
+ * 	（只有赋值为另一个容量不同的缓冲区时才重新分配）。元素在逻辑上从 head 开始连续排列，
+ * 	越过空间末尾后回到起始处，因此全部元素至多分成两段连续区间，可由 array_one()/array_two() 取得。
+ *
+ * 	缓冲区满时的行为由 circular_buffer_policy 决定：overwrite 覆盖最旧的元素（滑动窗口），
+ * 	reject 拒绝新元素并返回 false。批量的 push_back(first, last) 与 pop_front(n, result)
+ * 	按两段连续区间整段复制，元素可平凡复制且区间为指针时各自至多是两次 memcpy。
+ */
+
+#ifndef _LEESTL_CIRCULAR_BUFFER_H_
+#define _LEESTL_CIRCULAR_BUFFER_H_
+
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "algo.h"
+#include "alloc_traits.h"
+#include "allocator.h"
+#include "iterator.h"
+#include "uninitialized.h"
+#include "utils.h"
+
+namespace leestl {
+
+	// 缓冲区满时插入新元素的处理方式
+	enum class circular_buffer_policy {
+		overwrite,    // 覆盖另一端最旧的元素
+		reject        // 不插入，返回 false
+	};
+
+	/**
+	 * @brief circular_buffer 的随机访问迭代器
+	 *
+	 * 	同时记录当前元素的地址与未回绕的位置 pos（取值在 [head, head + capacity] 之间）：
+	 * 	解引用直接使用地址，移动时地址越过存储空间末尾再回到起始处；比较与相减只看 pos，
+	 * 	因此满缓冲区的尾后迭代器虽然与 begin() 指向同一地址，两者仍然可以区分
+	 *
+	 * @tparam T 元素类型
+	 * @tparam Const 是否只读
+	 */
+	template <typename T, bool Const>
+	class _circular_buffer_iterator {
+		template <typename, typename>
+		friend class circular_buffer;
+		template <typename, bool>
+		friend class _circular_buffer_iterator;
+
+	public:
+		typedef random_acess_interator_tag                iterator_category;
+		typedef T                                         value_type;
+		typedef ptrdiff_t                                 difference_type;
+		typedef std::conditional_t<Const, const T *, T *> pointer;
+		typedef std::conditional_t<Const, const T &, T &> reference;
+
+		_circular_buffer_iterator() noexcept = default;
+
+		// 可写迭代器可以转换为只读迭代器
+		template <bool C, typename = std::enable_if_t<Const && !C>>
+		_circular_buffer_iterator(const _circular_buffer_iterator<T, C> &x) noexcept
+		        : _cur(x._cur), _buf(x._buf), _end(x._end), _pos(x._pos) {}
+
+		reference operator*() const noexcept { return *_cur; }
+		pointer   operator->() const noexcept { return _cur; }
+		reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+		_circular_buffer_iterator &operator++() noexcept {
+			++_pos;
+			if (++_cur == _end) _cur = _buf;
+			return *this;
+		}
+
+		_circular_buffer_iterator operator++(int) noexcept {
+			_circular_buffer_iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		_circular_buffer_iterator &operator--() noexcept {
+			--_pos;
+			if (_cur == _buf) _cur = _end;
+			--_cur;
+			return *this;
+		}
+
+		_circular_buffer_iterator operator--(int) noexcept {
+			_circular_buffer_iterator tmp = *this;
+			--*this;
+			return tmp;
+		}
+
+		// |n| 不超过容量，地址至多回绕一次
+		_circular_buffer_iterator &operator+=(difference_type n) noexcept {
+			const difference_type cap = _end - _buf;
+			difference_type        i = (_cur - _buf) + n;
+			if (i >= cap) i -= cap;
+			else if (i < 0) i += cap;
+			_cur = _buf + i;
+			_pos += size_t(n);
+			return *this;
+		}
+
+		_circular_buffer_iterator &operator-=(difference_type n) noexcept { return *this += -n; }
+
+		_circular_buffer_iterator operator+(difference_type n) const noexcept {
+			_circular_buffer_iterator tmp = *this;
+			return tmp += n;
+		}
+
+		_circular_buffer_iterator operator-(difference_type n) const noexcept {
+			_circular_buffer_iterator tmp = *this;
+			return tmp -= n;
+		}
+
+		friend _circular_buffer_iterator operator+(
+		    difference_type n, const _circular_buffer_iterator &x) noexcept {
+			return x + n;
+		}
+
+		template <bool C>
+		difference_type operator-(const _circular_buffer_iterator<T, C> &x) const noexcept {
+			return difference_type(_pos - x._pos);
+		}
+
+		template <bool C>
+		bool operator==(const _circular_buffer_iterator<T, C> &x) const noexcept {
+			return _pos == x._pos;
+		}
+
+		template <bool C>
+		bool operator!=(const _circular_buffer_iterator<T, C> &x) const noexcept {
+			return _pos != x._pos;
+		}
+
+		template <bool C>
+		bool operator<(const _circular_buffer_iterator<T, C> &x) const noexcept {
+			return _pos < x._pos;
+		}
+
+		template <bool C>
+		bool operator>(const _circular_buffer_iterator<T, C> &x) const noexcept {
+			return x._pos < _pos;
+		}
+
+		template <bool C>
+		bool operator<=(const _circular_buffer_iterator<T, C> &x) const noexcept {
+			return _pos <= x._pos;
+		}
+
+		template <bool C>
+		bool operator>=(const _circular_buffer_iterator<T, C> &x) const noexcept {
+			return _pos >= x._pos;
+		}
+
+	private:
+		T     *_cur = nullptr;    // 当前元素
+		T     *_buf = nullptr;    // 存储空间的起始
+		T     *_end = nullptr;    // 存储空间的尾后
+		size_t _pos = 0;          // 未回绕的位置
+
+		_circular_buffer_iterator(T *buf, size_t cap, size_t pos) noexcept
+		        : _cur(buf + (pos < cap ? pos : pos - cap)), _buf(buf), _end(buf + cap),
+		          _pos(pos) {}
+	};
+
+	/**
+	 * @brief 固定容量的环形缓冲区
+	 *
+	 * @tparam T 元素类型
+	 * @tparam Alloc 配置器类型
+	 */
+	template <typename T, typename Alloc = leestl::allocator<T>>
+	class circular_buffer {
+	public:
+		typedef Alloc allocator_type;    // 配置器类型
+		typedef typename leestl::allocator_traits<Alloc>::template rebind_alloc<T> data_allocator;
+
+	private:
+		typedef leestl::allocator_traits<data_allocator> _alloc_traits;
+
+	public:
+		typedef T                                       value_type;
+		typedef typename _alloc_traits::size_type       size_type;
+		typedef typename _alloc_traits::difference_type difference_type;
+		typedef T                                      *pointer;
+		typedef const T                                *const_pointer;
+		typedef value_type                             &reference;
+		typedef const value_type                       &const_reference;
+
+		typedef _circular_buffer_iterator<T, false>      iterator;
+		typedef _circular_buffer_iterator<T, true>       const_iterator;
+		typedef leestl::reverse_iterator<iterator>       reverse_iterator;
+		typedef leestl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+		typedef std::pair<pointer, size_type>       array_range;          // 一段连续的元素
+		typedef std::pair<const_pointer, size_type> const_array_range;    // 一段只读的连续元素
+
+		allocator_type get_allocator() const noexcept { return allocator_type(_get_alloc()); }
+
+	private:
+		// 继承配置器以利用空基类优化，无状态配置器不占用额外空间。
+		// 元素依次位于 buf[head], buf[(head + 1) % capacity], ...，共 size 个
+		struct _circular_buffer_impl : public data_allocator {
+			T                     *buf = nullptr;                                 // 存储空间
+			size_type              capacity = 0;                                  // 容量
+			size_type              head = 0;                                      // 第一个元素的下标
+			size_type              size = 0;                                      // 元素个数
+			circular_buffer_policy policy = circular_buffer_policy::overwrite;    // 满时的处理方式
+
+			_circular_buffer_impl() noexcept(
+			    std::is_nothrow_default_constructible<data_allocator>::value)
+			        : data_allocator() {}
+			_circular_buffer_impl(const data_allocator &a) noexcept : data_allocator(a) {}
+			_circular_buffer_impl(data_allocator &&a) noexcept : data_allocator(leestl::move(a)) {}
+
+			// 交换数据，不交换配置器
+			void _swap_data(_circular_buffer_impl &x) noexcept {
+				leestl::swap(buf, x.buf);
+				leestl::swap(capacity, x.capacity);
+				leestl::swap(head, x.head);
+				leestl::swap(size, x.size);
+				leestl::swap(policy, x.policy);
+			}
+		};
+
+		_circular_buffer_impl _impl;
+
+		data_allocator       &_get_alloc() noexcept { return _impl; }
+		const data_allocator &_get_alloc() const noexcept { return _impl; }
+
+	public:
+		/**
+		 * @brief circular_buffer 默认构造函数，容量为 0，不分配空间
+		 *
+		 */
+		circular_buffer() = default;
+
+		/**
+		 * @brief 指定配置器的 circular_buffer 构造函数，容量为 0
+		 *
+		 * @param alloc 配置器
+		 */
+		explicit circular_buffer(const allocator_type &alloc) noexcept
+		        : _impl(data_allocator(alloc)) {}
+
+		/**
+		 * @brief 给出容量的 circular_buffer 构造函数，一次性分配全部空间
+		 *
+		 * @param capacity 容量
+		 * @param policy 缓冲区满时的处理方式
+		 * @param alloc 配置器
+		 */
+		explicit circular_buffer(
+		    size_type capacity, circular_buffer_policy policy = circular_buffer_policy::overwrite,
+		    const allocator_type &alloc = allocator_type())
+		        : _impl(data_allocator(alloc)) {
+			_allocate_storage(capacity);
+			_impl.policy = policy;
+		}
+
+		/**
+		 * @brief 给出容量并依次插入 [first, last) 中的元素，元素多于容量时按 policy 处理
+		 *
+		 * @tparam _II 迭代器类型
+		 * @param capacity 容量
+		 * @param first 区间起始
+		 * @param last 区间终止
+		 * @param policy 缓冲区满时的处理方式
+		 * @param alloc 配置器
+		 */
+		template <typename _II, typename = leestl::RequireInputIterator<_II>>
+		circular_buffer(
+		    size_type capacity, _II first, _II last,
+		    circular_buffer_policy policy = circular_buffer_policy::overwrite,
+		    const allocator_type  &alloc = allocator_type())
+		        : circular_buffer(capacity, policy, alloc) {
+			_guarded([&] { push_back(first, last); });
+		}
+
+		/**
+		 * @brief 给出容量并依次插入初始化列表中的元素
+		 *
+		 * @param capacity 容量
+		 * @param il 初始化列表
+		 * @param policy 缓冲区满时的处理方式
+		 * @param alloc 配置器
+		 */
+		circular_buffer(
+		    size_type capacity, std::initializer_list<value_type> il,
+		    circular_buffer_policy policy = circular_buffer_policy::overwrite,
+		    const allocator_type  &alloc = allocator_type())
+		        : circular_buffer(capacity, il.begin(), il.end(), policy, alloc) {}
+
+		/**
+		 * @brief 复制构造函数，复制容量、满时的处理方式与全部元素，
+		 * 	配置器由 select_on_container_copy_construction 决定
+		 *
+		 * @param x 要复制的 circular_buffer
+		 */
+		circular_buffer(const circular_buffer &x)
+		        : _impl(_alloc_traits::select_on_container_copy_construction(x._get_alloc())) {
+			_allocate_storage(x.capacity());
+			_impl.policy = x.policy();
+			_guarded([&] { _copy_from(x); });
+		}
+
+		/**
+		 * @brief 指定配置器的复制构造函数
+		 *
+		 * @param x 要复制的 circular_buffer
+		 * @param alloc 配置器
+		 */
+		circular_buffer(const circular_buffer &x, const allocator_type &alloc)
+		        : _impl(data_allocator(alloc)) {
+			_allocate_storage(x.capacity());
+			_impl.policy = x.policy();
+			_guarded([&] { _copy_from(x); });
+		}
+
+		/**
+		 * @brief 移动构造函数，接管 x 的存储空间与配置器，x 的容量变为 0
+		 */
+		circular_buffer(circular_buffer &&x) noexcept : _impl(leestl::move(x._get_alloc())) {
+			_impl._swap_data(x._impl);
+		}
+
+		/**
+		 * @brief 指定配置器的移动构造函数，配置器不相等时只能分配新空间并逐个移动元素
+		 *
+		 * @param x 要移动的 circular_buffer
+		 * @param alloc 配置器
+		 */
+		circular_buffer(circular_buffer &&x, const allocator_type &alloc)
+		        : _impl(data_allocator(alloc)) {
+			if (_alloc_traits::equal(_get_alloc(), x._get_alloc())) {
+				_impl._swap_data(x._impl);
+			} else {
+				_allocate_storage(x.capacity());
+				_impl.policy = x.policy();
+				_guarded([&] { x.pop_front(x.size(), _back_inserter()); });
+			}
+		}
+
+		~circular_buffer() noexcept {
+			_destroy_front(_impl.size);
+			_free_storage();
+		}
+
+		// 复制赋值，容量相同时沿用原有空间，否则按 x 的容量重新分配
+		circular_buffer &operator=(const circular_buffer &x) {
+			if (this != &x) {
+				clear();
+				if constexpr (_alloc_traits::propagate_on_container_copy_assignment::value) {
+					// 旧配置器无法释放新配置器分配的空间，先用旧配置器释放
+					if (!_alloc_traits::equal(_get_alloc(), x._get_alloc())) _free_storage();
+					_get_alloc() = x._get_alloc();
+				}
+				if (capacity() != x.capacity()) {
+					_free_storage();
+					_allocate_storage(x.capacity());
+				}
+				_impl.policy = x.policy();
+				_copy_from(x);
+			}
+			return *this;
+		}
+
+		// 移动赋值，配置器可传播或相等时直接接管空间，否则逐个移动元素
+		circular_buffer &operator=(circular_buffer &&x) noexcept(
+		    _alloc_traits::propagate_on_container_move_assignment::value ||
+		    _alloc_traits::is_always_equal::value) {
+			if (this != &x) {
+				if constexpr (_alloc_traits::propagate_on_container_move_assignment::value) {
+					_move_assign(x);
+					_get_alloc() = leestl::move(x._get_alloc());
+				} else if (_alloc_traits::equal(_get_alloc(), x._get_alloc())) {
+					_move_assign(x);
+				} else {
+					circular_buffer tmp(leestl::move(x), _get_alloc());    // 用本容器的配置器
+					_move_assign(tmp);
+				}
+			}
+			return *this;
+		}
+
+		// 迭代器相关操作，缓冲区内容改变后（包括覆盖写入）原有迭代器失效
+		iterator begin() noexcept { return iterator(_impl.buf, _impl.capacity, _impl.head); }
+		const_iterator begin() const noexcept {
+			return const_iterator(_impl.buf, _impl.capacity, _impl.head);
+		}
+		iterator end() noexcept {
+			return iterator(_impl.buf, _impl.capacity, _impl.head + _impl.size);
+		}
+		const_iterator end() const noexcept {
+			return const_iterator(_impl.buf, _impl.capacity, _impl.head + _impl.size);
+		}
+		reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+		const_iterator         cbegin() const noexcept { return begin(); }
+		const_iterator         cend() const noexcept { return end(); }
+		const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+		const_reverse_iterator crend() const noexcept { return rend(); }
+
+		// 容量相关操作
+		bool      empty() const noexcept { return _impl.size == 0; }
+		bool      full() const noexcept { return _impl.size == _impl.capacity; }
+		size_type size() const noexcept { return _impl.size; }
+		size_type capacity() const noexcept { return _impl.capacity; }
+		size_type available() const noexcept { return _impl.capacity - _impl.size; }    // 空位
+		size_type max_size() const noexcept { return _alloc_traits::max_size(_get_alloc()); }
+
+		circular_buffer_policy policy() const noexcept { return _impl.policy; }
+		void set_policy(circular_buffer_policy policy) noexcept { _impl.policy = policy; }
+
+		// 元素访问相关操作
+		reference       operator[](size_type n) noexcept { return _impl.buf[_index(n)]; }
+		const_reference operator[](size_type n) const noexcept { return _impl.buf[_index(n)]; }
+
+		reference at(size_type n) {
+			_range_check(n);
+			return (*this)[n];
+		}
+		const_reference at(size_type n) const {
+			_range_check(n);
+			return (*this)[n];
+		}
+
+		reference       front() noexcept { return _impl.buf[_impl.head]; }
+		const_reference front() const noexcept { return _impl.buf[_impl.head]; }
+		reference       back() noexcept { return _impl.buf[_index(_impl.size - 1)]; }
+		const_reference back() const noexcept { return _impl.buf[_index(_impl.size - 1)]; }
+
+		/**
+		 * @brief 从最旧的元素开始的第一段连续元素
+		 *
+		 * @return array_range 起始地址与元素个数
+		 */
+		array_range array_one() noexcept {
+			return array_range(_impl.buf + _impl.head, _first_len());
+		}
+		const_array_range array_one() const noexcept {
+			return const_array_range(_impl.buf + _impl.head, _first_len());
+		}
+
+		/**
+		 * @brief 回绕到存储空间起始处的第二段连续元素，没有回绕时元素个数为 0
+		 *
+		 * @return array_range 起始地址与元素个数
+		 */
+		array_range array_two() noexcept {
+			return array_range(_impl.buf, _impl.size - _first_len());
+		}
+		const_array_range array_two() const noexcept {
+			return const_array_range(_impl.buf, _impl.size - _first_len());
+		}
+
+		// 修改容器相关操作，缓冲区满时按 policy 处理，返回元素是否被插入
+		bool push_back(const value_type &value) { return _put_back(value); }
+		bool push_back(value_type &&value) { return _put_back(leestl::move(value)); }
+		bool push_front(const value_type &value) { return _put_front(value); }
+		bool push_front(value_type &&value) { return _put_front(leestl::move(value)); }
+
+		/**
+		 * @brief 在尾部直接构造元素；已满时覆盖最旧的元素（先构造临时对象再移动赋值）或拒绝
+		 *
+		 * @param args 构造参数
+		 * @return bool 元素是否被插入
+		 */
+		template <typename... Args>
+		bool emplace_back(Args &&...args) {
+			if (!full()) {
+				_alloc_traits::construct(
+				    _get_alloc(), _impl.buf + _tail(), leestl::forward<Args>(args)...);
+				++_impl.size;
+				return true;
+			}
+			if (!_can_overwrite()) return false;
+			_impl.buf[_impl.head] = value_type(leestl::forward<Args>(args)...);
+			_impl.head = _wrap(_impl.head + 1);
+			return true;
+		}
+
+		/**
+		 * @brief 在头部直接构造元素；已满时覆盖最新的元素或拒绝
+		 *
+		 * @param args 构造参数
+		 * @return bool 元素是否被插入
+		 */
+		template <typename... Args>
+		bool emplace_front(Args &&...args) {
+			if (!full()) {
+				const size_type slot = _prev(_impl.head);
+				_alloc_traits::construct(
+				    _get_alloc(), _impl.buf + slot, leestl::forward<Args>(args)...);
+				_impl.head = slot;
+				++_impl.size;
+				return true;
+			}
+			if (!_can_overwrite()) return false;
+			_impl.head = _prev(_impl.head);
+			_impl.buf[_impl.head] = value_type(leestl::forward<Args>(args)...);
+			return true;
+		}
+
+		/**
+		 * @brief 依次在尾部插入 [first, last) 中的元素，写入的空间至多分成两段连续区间
+		 *
+		 * 	overwrite 时先一次性丢弃放不下的最旧元素，区间长于容量时只保留最后 capacity() 个；
+		 * 	reject 时只插入能放下的前 available() 个
+		 *
+		 * @tparam _II 迭代器类型
+		 * @param first 区间起始
+		 * @param last 区间终止
+		 * @return size_type 被接受的元素个数，overwrite 时总是区间的长度
+		 */
+		template <typename _II, typename = leestl::RequireInputIterator<_II>>
+		size_type push_back(_II first, _II last) {
+			return _range_push_back(first, last, leestl::iterator_category_types<_II>());
+		}
+
+		// 删除最旧的元素
+		void pop_front() noexcept {
+			leestl::destory(_impl.buf + _impl.head);
+			_impl.head = _wrap(_impl.head + 1);
+			--_impl.size;
+		}
+
+		// 删除最新的元素
+		void pop_back() noexcept {
+			--_impl.size;
+			leestl::destory(_impl.buf + _index(_impl.size));
+		}
+
+		/**
+		 * @brief 删除最旧的 n 个元素，n 大于 size() 时删除全部元素
+		 *
+		 * @param n 删除的元素个数
+		 */
+		void pop_front(size_type n) noexcept {
+			n = leestl::min(n, _impl.size);
+			_destroy_front(n);
+			_impl.size -= n;
+			// 清空后回到存储空间的起始处，之后的批量写入不必回绕
+			_impl.head = _impl.size == 0 ? 0 : _wrap(_impl.head + n);
+		}
+
+		/**
+		 * @brief 把最旧的 n 个元素依次移动到 result 处再删除，至多两段连续区间的整段移动
+		 *
+		 * @tparam _OI 输出迭代器类型
+		 * @param n 取出的元素个数，大于 size() 时取出全部元素
+		 * @param result 输出位置
+		 * @return _OI 输出区间的尾后位置
+		 */
+		template <typename _OI>
+		_OI pop_front(size_type n, _OI result) {
+			n = leestl::min(n, _impl.size);
+			const size_type first_len = leestl::min(n, _impl.capacity - _impl.head);
+			T              *first = _impl.buf + _impl.head;
+			result = leestl::move(first, first + first_len, result);
+			result = leestl::move(_impl.buf, _impl.buf + (n - first_len), result);
+			pop_front(n);
+			return result;
+		}
+
+		// 交换两个 circular_buffer，propagate_on_container_swap 为真时同时交换配置器
+		void swap(circular_buffer &x) noexcept {
+			_impl._swap_data(x._impl);
+			if constexpr (_alloc_traits::propagate_on_container_swap::value)
+				leestl::swap(_get_alloc(), x._get_alloc());
+		}
+
+		// 销毁所有元素，保留存储空间
+		void clear() noexcept { pop_front(_impl.size); }
+
+	private:
+		void _range_check(size_type n) const {
+			if (n >= size())
+				throw std::out_of_range("circular_buffer::_range_check: n >= size()");
+		}
+
+		bool _can_overwrite() const noexcept {
+			return _impl.policy == circular_buffer_policy::overwrite && _impl.capacity != 0;
+		}
+
+		// 把 [0, 2 * capacity) 上的位置回绕到存储空间内
+		size_type _wrap(size_type i) const noexcept {
+			return i < _impl.capacity ? i : i - _impl.capacity;
+		}
+
+		size_type _index(size_type n) const noexcept { return _wrap(_impl.head + n); }
+		size_type _tail() const noexcept { return _wrap(_impl.head + _impl.size); }
+		size_type _prev(size_type i) const noexcept { return (i == 0 ? _impl.capacity : i) - 1; }
+
+		// 第一段连续元素的个数
+		size_type _first_len() const noexcept {
+			return leestl::min(_impl.size, _impl.capacity - _impl.head);
+		}
+
+		// 分配、释放存储空间
+		void _allocate_storage(size_type n) {
+			if (n > max_size())
+				throw std::length_error("cannot create circular_buffer larger than max_size().");
+			_impl.buf = n ? _alloc_traits::allocate(_get_alloc(), n) : nullptr;
+			_impl.capacity = n;
+		}
+
+		void _free_storage() noexcept {
+			if (_impl.buf) _alloc_traits::deallocate(_get_alloc(), _impl.buf, _impl.capacity);
+			_impl.buf = nullptr;
+			_impl.capacity = _impl.head = _impl.size = 0;
+		}
+
+		// 构造函数中执行 f，出现异常时销毁已有元素并释放空间
+		template <typename F>
+		void _guarded(F f) {
+			try {
+				f();
+			} catch (...) {
+				clear();
+				_free_storage();
+				throw;
+			}
+		}
+
+		// 销毁最旧的 n 个元素，不改变 head 与 size
+		void _destroy_front(size_type n) noexcept {
+			if constexpr (!std::is_trivially_destructible<T>::value) {
+				const size_type first_len = leestl::min(n, _impl.capacity - _impl.head);
+				leestl::destory(_impl.buf + _impl.head, _impl.buf + _impl.head + first_len);
+				leestl::destory(_impl.buf, _impl.buf + (n - first_len));
+			}
+		}
+
+		void _move_assign(circular_buffer &x) noexcept {
+			circular_buffer tmp(_get_alloc());
+			_impl._swap_data(tmp._impl);
+			_impl._swap_data(x._impl);
+		}
+
+		// 空缓冲区复制 x 的全部元素，容量不小于 x.size()
+		void _copy_from(const circular_buffer &x) {
+			const const_array_range one = x.array_one(), two = x.array_two();
+			leestl::uninitialized_copy(one.first, one.first + one.second, _impl.buf);
+			_impl.size = one.second;
+			leestl::uninitialized_copy(two.first, two.first + two.second, _impl.buf + one.second);
+			_impl.size += two.second;
+		}
+
+		// 依次在尾部构造元素的输出迭代器，供按配置器移动时使用
+		struct _back_insert_iterator {
+			circular_buffer *c;
+
+			_back_insert_iterator &operator*() noexcept { return *this; }
+			_back_insert_iterator &operator++() noexcept { return *this; }
+			_back_insert_iterator &operator=(value_type &&value) {
+				c->push_back(leestl::move(value));
+				return *this;
+			}
+		};
+
+		_back_insert_iterator _back_inserter() noexcept { return _back_insert_iterator{this}; }
+
+		template <typename V>
+		bool _put_back(V &&value) {
+			if (!full()) {
+				_alloc_traits::construct(
+				    _get_alloc(), _impl.buf + _tail(), leestl::forward<V>(value));
+				++_impl.size;
+				return true;
+			}
+			if (!_can_overwrite()) return false;
+			// 满时尾后位置就是最旧元素的位置，赋值后 head 后移，value 即使引用本容器的元素也安全
+			_impl.buf[_impl.head] = leestl::forward<V>(value);
+			_impl.head = _wrap(_impl.head + 1);
+			return true;
+		}
+
+		template <typename V>
+		bool _put_front(V &&value) {
+			if (!full()) {
+				const size_type slot = _prev(_impl.head);
+				_alloc_traits::construct(_get_alloc(), _impl.buf + slot, leestl::forward<V>(value));
+				_impl.head = slot;
+				++_impl.size;
+				return true;
+			}
+			if (!_can_overwrite()) return false;
+			_impl.head = _prev(_impl.head);
+			_impl.buf[_impl.head] = leestl::forward<V>(value);
+			return true;
+		}
+
+		// 输入迭代器只能逐个插入，reject 时遇到第一个放不下的元素即停止
+		template <typename _II>
+		size_type _range_push_back(_II first, _II last, leestl::input_interator_tag) {
+			size_type count = 0;
+			for (; first != last; ++first, (void)++count)
+				if (!push_back(*first)) break;
+			return count;
+		}
+
+		template <typename _FI>
+		size_type _range_push_back(_FI first, _FI last, leestl::forward_interator_tag) {
+			const size_type len = size_type(leestl::distance(first, last));
+			size_type       n = len;
+			if (n > available()) {
+				if (!_can_overwrite()) {
+					n = available();
+				} else if (n >= _impl.capacity) {
+					leestl::advance(first, n - _impl.capacity);
+					n = _impl.capacity;
+					clear();
+				} else {
+					pop_front(n - available());
+				}
+			}
+			// 从尾后位置写到存储空间末尾，剩余的回绕到起始处
+			const size_type tail = _tail();
+			const size_type first_len = leestl::min(n, _impl.capacity - tail);
+			_FI             mid = first;
+			leestl::advance(mid, first_len);
+			leestl::uninitialized_copy(first, mid, _impl.buf + tail);
+			_impl.size += first_len;
+			_FI end = mid;
+			leestl::advance(end, n - first_len);
+			leestl::uninitialized_copy(mid, end, _impl.buf);
+			_impl.size += n - first_len;
+			return _can_overwrite() ? len : n;
+		}
+	};
+
+	template <typename T, typename Alloc>
+	inline bool operator==(const circular_buffer<T, Alloc> &x, const circular_buffer<T, Alloc> &y) {
+		return x.size() == y.size() && leestl::equal(x.begin(), x.end(), y.begin());
+	}
+
+	template <typename T, typename Alloc>
+	inline bool operator!=(const circular_buffer<T, Alloc> &x, const circular_buffer<T, Alloc> &y) {
+		return !(x == y);
+	}
+
+	template <typename T, typename Alloc>
+	inline bool operator<(const circular_buffer<T, Alloc> &x, const circular_buffer<T, Alloc> &y) {
+		return leestl::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+	}
+
+	template <typename T, typename Alloc>
+	inline void swap(circular_buffer<T, Alloc> &x, circular_buffer<T, Alloc> &y) noexcept {
+		x.swap(y);
+	}
+
+}    // namespace leestl
+
+#endif
@@ -0,0 +1,335 @@
+/** @file concurrent_hash_map.h
+ * 	这个文件实现可被多个线程同时访问的哈希映射表 concurrent_hash_map
+ *
+ * 	键按混合后哈希值的高位分到 2 的幂个分片，每个分片是一个 flat_hash_map 加一把读写锁，
+ * 	各自独占缓存行：不同分片上的操作互不阻塞，锁字也不会与相邻分片共享缓存行。
+ * 	查找只取分片的共享锁，多个读线程可以同时访问同一分片；插入、赋值与删除取独占锁。
+ * 	分片内的表使用哈希值的低位定位组与指纹，每次操作只计算一次键的哈希值。
+ *
+ * 	容器不提供迭代器：元素只能在持有分片锁时通过 visit 系列函数访问，或由 find 复制出来。
+ */
+
+#ifndef _LEESTL_CONCURRENT_HASH_MAP_H_
+#define _LEESTL_CONCURRENT_HASH_MAP_H_ 1
+
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+#include "flat_hash_map.h"
+
+namespace leestl {
+
+	/**
+	 * @brief 分片加锁的线程安全哈希映射表
+	 *
+	 * @tparam Key 键类型
+	 * @tparam T 值类型
+	 * @tparam Hash 哈希仿函数，与 KeyEqual 都声明 is_transparent 时支持异构查找
+	 * @tparam KeyEqual 判断键相等的仿函数
+	 * @tparam Alloc 配置器类型
+	 */
+	template <
+	    typename Key, typename T, typename Hash = leestl::hash<Key>,
+	    typename KeyEqual = leestl::equal_to<Key>,
+	    typename Alloc = leestl::allocator<std::pair<const Key, T>>>
+	class concurrent_hash_map {
+	public:
+		typedef Key                     key_type;
+		typedef T                       mapped_type;
+		typedef std::pair<const Key, T> value_type;
+		typedef size_t                  size_type;
+		typedef Hash                    hasher;
+		typedef KeyEqual                key_equal;
+		typedef Alloc                   allocator_type;
+
+		enum { max_shards = 1 << 16 };
+
+	private:
+		// 分片内的哈希表，开放以已算好的哈希值操作的接口
+		class _table : public flat_hash_map<Key, T, Hash, KeyEqual, Alloc> {
+			typedef flat_hash_map<Key, T, Hash, KeyEqual, Alloc> _base;
+
+		public:
+			using _base::_base;
+			using _base::_mix;
+
+			template <typename K>
+			value_type *find_hashed(size_t h, const K &key) {
+				auto it = this->_iterator_at(this->_find_index(key, h));
+				return it == this->end() ? nullptr : &*it;
+			}
+
+			template <typename K, typename... Args>
+			std::pair<value_type *, bool> emplace_hashed(size_t h, const K &key, Args &&...args) {
+				auto r = this->_emplace_unique_hashed(h, key, leestl::forward<Args>(args)...);
+				return std::pair<value_type *, bool>(&*r.first, r.second);
+			}
+
+			template <typename K>
+			size_type erase_hashed(size_t h, const K &key) {
+				return this->_erase_key_hashed(h, key);
+			}
+		};
+
+		// 一个分片独占缓存行，避免不同分片的锁字之间伪共享
+		struct alignas(64) _shard {
+			mutable std::shared_mutex lock;
+			_table                    table;
+		};
+
+		std::unique_ptr<_shard[]> _shards;
+		size_type                 _shard_mask;
+		hasher                    _hash;
+
+	public:
+		/**
+		 * @brief 构造空表
+		 *
+		 * @param shards 分片数，向上取整为 2 的幂；为 0 时按硬件线程数选取
+		 */
+		explicit concurrent_hash_map(
+		    size_type shards = 0, const hasher &hf = hasher(), const key_equal &eq = key_equal(),
+		    const allocator_type &a = allocator_type())
+		        : _hash(hf) {
+			const size_type n = _round_shards(shards ? shards : _default_shards());
+			_shards.reset(new _shard[n]);
+			_shard_mask = n - 1;
+			for (size_type i = 0; i < n; ++i) _shards[i].table = _table(0, hf, eq, a);
+		}
+
+		concurrent_hash_map(const concurrent_hash_map &) = delete;
+		concurrent_hash_map &operator=(const concurrent_hash_map &) = delete;
+
+		size_type shard_count() const noexcept { return _shard_mask + 1; }
+		hasher    hash_function() const { return _hash; }
+
+		// 元素个数，有其他线程同时修改时只是某一时刻附近的近似值
+		size_type size() const {
+			size_type n = 0;
+			for (size_type i = 0; i <= _shard_mask; ++i) {
+				std::shared_lock<std::shared_mutex> guard(_shards[i].lock);
+				n += _shards[i].table.size();
+			}
+			return n;
+		}
+
+		bool empty() const { return size() == 0; }
+
+		/**
+		 * @brief 预留空间，n 个元素平均分摊到各分片并留出 1/8 的余量
+		 *
+		 * @param n 元素个数
+		 */
+		void reserve(size_type n) {
+			const size_type per = n / shard_count() + n / shard_count() / 8 + 1;
+			for (size_type i = 0; i <= _shard_mask; ++i) {
+				std::unique_lock<std::shared_mutex> guard(_shards[i].lock);
+				_shards[i].table.reserve(per);
+			}
+		}
+
+		// 逐个分片清空，不同分片的清空之间可能穿插其他线程的插入
+		void clear() {
+			for (size_type i = 0; i <= _shard_mask; ++i) {
+				std::unique_lock<std::shared_mutex> guard(_shards[i].lock);
+				_shards[i].table.clear();
+			}
+		}
+
+		/**
+		 * @brief 键不存在时以 args 构造值并插入，键已存在时什么也不做
+		 *
+		 * @return bool 是否插入了新元素
+		 */
+		template <typename... Args>
+		bool try_emplace(const key_type &key, Args &&...args) {
+			const size_t                        h = _hash_of(key);
+			_shard                             &s = _shard_for(h);
+			std::unique_lock<std::shared_mutex> guard(s.lock);
+			return s.table
+			    .emplace_hashed(
+			        h, key, std::piecewise_construct, std::forward_as_tuple(key),
+			        std::forward_as_tuple(leestl::forward<Args>(args)...))
+			    .second;
+		}
+
+		/**
+		 * @brief 键不存在时插入，键已存在时把值赋为 obj
+		 *
+		 * @return bool 是否插入了新元素
+		 */
+		template <typename M>
+		bool insert_or_assign(const key_type &key, M &&obj) {
+			const size_t                        h = _hash_of(key);
+			_shard                             &s = _shard_for(h);
+			std::unique_lock<std::shared_mutex> guard(s.lock);
+			auto r = s.table.emplace_hashed(
+			    h, key, std::piecewise_construct, std::forward_as_tuple(key),
+			    std::forward_as_tuple(leestl::forward<M>(obj)));
+			if (!r.second) r.first->second = leestl::forward<M>(obj);
+			return r.second;
+		}
+
+		/**
+		 * @brief 查找键为 key 的元素，存在时把值复制到 out
+		 *
+		 * @param key 键
+		 * @param out 接收值的对象，键不存在时不修改
+		 * @return bool 键是否存在
+		 */
+		bool find(const key_type &key, mapped_type &out) const {
+			return _cvisit(key, [&](const value_type &v) { out = v.second; });
+		}
+
+		template <typename K, typename H = Hash, typename E = KeyEqual,
+		          typename = _require_transparent<H, E>>
+		bool find(const K &key, mapped_type &out) const {
+			return _cvisit(key, [&](const value_type &v) { out = v.second; });
+		}
+
+		bool contains(const key_type &key) const {
+			return _cvisit(key, [](const value_type &) {});
+		}
+
+		template <typename K, typename H = Hash, typename E = KeyEqual,
+		          typename = _require_transparent<H, E>>
+		bool contains(const K &key) const {
+			return _cvisit(key, [](const value_type &) {});
+		}
+
+		/**
+		 * @brief 删除键为 key 的元素
+		 *
+		 * @return bool 是否删除了元素
+		 */
+		bool erase(const key_type &key) { return _erase(key); }
+
+		template <typename K, typename H = Hash, typename E = KeyEqual,
+		          typename = _require_transparent<H, E>>
+		bool erase(const K &key) {
+			return _erase(key);
+		}
+
+		/**
+		 * @brief 持有分片的独占锁，对键为 key 的元素调用 f(value_type &)，可以修改值
+		 *
+		 * @param key 键
+		 * @param f 访问函数，不能再访问本容器，否则可能死锁
+		 * @return bool 键是否存在
+		 */
+		template <typename F>
+		bool visit(const key_type &key, F f) {
+			return _visit(key, f);
+		}
+
+		template <typename K, typename F, typename H = Hash, typename E = KeyEqual,
+		          typename = _require_transparent<H, E>>
+		bool visit(const K &key, F f) {
+			return _visit(key, f);
+		}
+
+		/**
+		 * @brief 持有分片的共享锁，对键为 key 的元素调用 f(const value_type &)
+		 *
+		 * @param key 键
+		 * @param f 访问函数，可能被多个线程同时调用，不能再访问本容器
+		 * @return bool 键是否存在
+		 */
+		template <typename F>
+		bool cvisit(const key_type &key, F f) const {
+			return _cvisit(key, f);
+		}
+
+		template <typename K, typename F, typename H = Hash, typename E = KeyEqual,
+		          typename = _require_transparent<H, E>>
+		bool cvisit(const K &key, F f) const {
+			return _cvisit(key, f);
+		}
+
+		/**
+		 * @brief 逐个分片持有独占锁，对每个元素调用 f(value_type &)
+		 *
+		 * @return size_type 访问的元素个数
+		 */
+		template <typename F>
+		size_type visit_all(F f) {
+			size_type n = 0;
+			for (size_type i = 0; i <= _shard_mask; ++i) {
+				std::unique_lock<std::shared_mutex> guard(_shards[i].lock);
+				for (value_type &v : _shards[i].table) f(v);
+				n += _shards[i].table.size();
+			}
+			return n;
+		}
+
+		// 逐个分片持有共享锁，对每个元素调用 f(const value_type &)
+		template <typename F>
+		size_type cvisit_all(F f) const {
+			size_type n = 0;
+			for (size_type i = 0; i <= _shard_mask; ++i) {
+				std::shared_lock<std::shared_mutex> guard(_shards[i].lock);
+				for (const value_type &v : _shards[i].table) f(v);
+				n += _shards[i].table.size();
+			}
+			return n;
+		}
+
+	private:
+		template <typename K>
+		size_t _hash_of(const K &key) const {
+			return _table::_mix(_hash(key));
+		}
+
+		// 分片编号取哈希值的最高 16 位，分片内的表只用到低位，两者互不相关
+		_shard &_shard_for(size_t h) const noexcept {
+			return _shards[(h >> (sizeof(size_t) * 8 - 16)) & _shard_mask];
+		}
+
+		static size_type _default_shards() {
+			const size_type threads = std::thread::hardware_concurrency();
+			return threads * 4 < 16 ? 16 : threads * 4;
+		}
+
+		static size_type _round_shards(size_type n) noexcept {
+			if (n > size_type(max_shards)) return max_shards;
+			size_type r = 1;
+			while (r < n) r *= 2;
+			return r;
+		}
+
+		template <typename K, typename F>
+		bool _cvisit(const K &key, F f) const {
+			const size_t                        h = _hash_of(key);
+			_shard                             &s = _shard_for(h);
+			std::shared_lock<std::shared_mutex> guard(s.lock);
+			const value_type                   *v = s.table.find_hashed(h, key);
+			if (v == nullptr) return false;
+			f(*v);
+			return true;
+		}
+
+		template <typename K, typename F>
+		bool _visit(const K &key, F f) {
+			const size_t                        h = _hash_of(key);
+			_shard                             &s = _shard_for(h);
+			std::unique_lock<std::shared_mutex> guard(s.lock);
+			value_type                         *v = s.table.find_hashed(h, key);
+			if (v == nullptr) return false;
+			f(*v);
+			return true;
+		}
+
+		template <typename K>
+		bool _erase(const K &key) {
+			const size_t                        h = _hash_of(key);
+			_shard                             &s = _shard_for(h);
+			std::unique_lock<std::shared_mutex> guard(s.lock);
+			return s.table.erase_hashed(h, key) != 0;
+		}
+	};
+
+}    // namespace leestl
+
+#endif
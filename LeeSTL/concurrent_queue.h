@@ -0,0 +1,536 @@
+/** @file concurrent_queue.h
+ * 	这个文件实现用于线程间传递数据的有界无锁队列 spsc_queue 与 mpmc_queue
+ *
+ * 	spsc_queue 只允许一个生产者线程与一个消费者线程，是无等待的环形队列：生产者只写 tail、
+ * 	消费者只写 head，各自独占缓存行。两端都缓存一份对方的下标，只有缓存的值显示队列已满
+ * 	（或已空）时才重新读取对方的原子变量，稳态下每次操作不访问对方的缓存行。
+ *
+ * 	mpmc_queue 允许任意多个生产者与消费者，采用 Dmitry Vyukov 的有界队列算法：每个槽位带一个
+ * 	序号，生产者与消费者分别用 CAS 推进入队、出队位置来占有槽位，再通过槽位的序号交接数据，
+ * 	不需要锁，也不会出现 ABA 问题。
+ *
+ * 	两个队列的容量都向上取整为 2 的幂，空间在构造时一次性分配。try_push_n/try_pop_n 一次
+ * 	处理一批元素：spsc_queue 只发布一次下标，元素按至多两段连续区间整段复制；mpmc_queue
+ * 	只做一次 CAS 占有连续的一批槽位，减少多个线程争用同一位置的次数。
+ */
+
+#ifndef _LEESTL_CONCURRENT_QUEUE_H_
+#define _LEESTL_CONCURRENT_QUEUE_H_ 1
+
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#include "algo.h"
+#include "alloc_traits.h"
+#include "allocator.h"
+#include "uninitialized.h"
+#include "utils.h"
+
+namespace leestl {
+
+	enum { _QUEUE_CACHE_LINE = 64 };    // 生产者与消费者的下标各自独占的缓存行大小
+	enum { _QUEUE_SPIN_LIMIT = 64 };    // 阻塞操作先自旋的次数，之后每次失败都让出时间片
+
+	// 阻塞的 push/pop 等待对方时的退避：先用 pause 指令自旋，再让出时间片
+	class _queue_backoff {
+	private:
+		unsigned _spins = 0;
+
+	public:
+		void wait() noexcept {
+			if (_spins < _QUEUE_SPIN_LIMIT) {
+				++_spins;
+#if defined(__x86_64__) || defined(__i386__)
+				__builtin_ia32_pause();
+#elif defined(__aarch64__)
+				asm volatile("yield");
+#endif
+			} else {
+				std::this_thread::yield();
+			}
+		}
+	};
+
+	// 把容量向上取整为 2 的幂，至少为 2
+	inline size_t _queue_capacity(size_t n, size_t max) {
+		size_t cap = 2;
+		while (cap < n) {
+			if (cap > max / 2) throw std::length_error("concurrent queue capacity is too large.");
+			cap <<= 1;
+		}
+		return cap;
+	}
+
+	/**
+	 * @brief 单生产者单消费者的无等待有界队列
+	 *
+	 * 	try_push 系列只能由生产者线程调用，try_pop 系列只能由消费者线程调用；
+	 * 	size() 与 empty() 可由任意线程调用，有并发修改时只是近似值
+	 *
+	 * @tparam T 元素类型
+	 * @tparam Alloc 配置器类型
+	 */
+	template <typename T, typename Alloc = leestl::allocator<T>>
+	class spsc_queue {
+	public:
+		typedef T      value_type;
+		typedef size_t size_type;
+		typedef Alloc  allocator_type;
+		typedef typename leestl::allocator_traits<Alloc>::template rebind_alloc<T> data_allocator;
+
+	private:
+		typedef leestl::allocator_traits<data_allocator> _alloc_traits;
+
+		// 构造后只读的部分，继承配置器以利用空基类优化
+		struct _queue_impl : public data_allocator {
+			T        *buf = nullptr;    // 环形存储空间
+			size_type mask = 0;         // 容量减一
+
+			_queue_impl(const data_allocator &a) noexcept : data_allocator(a) {}
+		};
+
+		// head 与 tail 只增不减，对容量取模得到槽位；tail - head 为元素个数
+		alignas(_QUEUE_CACHE_LINE) _queue_impl _impl;
+		alignas(_QUEUE_CACHE_LINE) std::atomic<size_type> _tail{0};    // 生产者写入
+		size_type _head_cache = 0;                                     // 生产者看到的 head
+		alignas(_QUEUE_CACHE_LINE) std::atomic<size_type> _head{0};    // 消费者写入
+		size_type _tail_cache = 0;                                     // 消费者看到的 tail
+
+		data_allocator &_get_alloc() noexcept { return _impl; }
+
+	public:
+		/**
+		 * @brief 构造空队列，一次性分配全部空间
+		 *
+		 * @param capacity 容量，向上取整为 2 的幂
+		 * @param alloc 配置器
+		 */
+		explicit spsc_queue(size_type capacity, const allocator_type &alloc = allocator_type())
+		        : _impl(data_allocator(alloc)) {
+			const size_type cap = _queue_capacity(capacity, _alloc_traits::max_size(_get_alloc()));
+			_impl.buf = _alloc_traits::allocate(_get_alloc(), cap);
+			_impl.mask = cap - 1;
+		}
+
+		spsc_queue(const spsc_queue &) = delete;
+		spsc_queue &operator=(const spsc_queue &) = delete;
+
+		~spsc_queue() noexcept {
+			const size_type h = _head.load(std::memory_order_relaxed);
+			_destroy(h, _tail.load(std::memory_order_relaxed) - h);
+			_alloc_traits::deallocate(_get_alloc(), _impl.buf, capacity());
+		}
+
+		size_type capacity() const noexcept { return _impl.mask + 1; }
+
+		size_type size() const noexcept {
+			const size_type h = _head.load(std::memory_order_acquire);
+			const size_type t = _tail.load(std::memory_order_acquire);
+			return t - h <= capacity() ? t - h : 0;
+		}
+
+		bool empty() const noexcept { return size() == 0; }
+
+		/**
+		 * @brief 生产者在队尾直接构造元素
+		 *
+		 * @param args 构造参数
+		 * @return bool 队列已满时返回 false，不构造元素
+		 */
+		template <typename... Args>
+		bool try_emplace(Args &&...args) {
+			const size_type t = _tail.load(std::memory_order_relaxed);
+			if (t - _head_cache == capacity()) {
+				_head_cache = _head.load(std::memory_order_acquire);
+				if (t - _head_cache == capacity()) return false;
+			}
+			_alloc_traits::construct(
+			    _get_alloc(), _impl.buf + (t & _impl.mask), leestl::forward<Args>(args)...);
+			_tail.store(t + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool try_push(const value_type &value) { return try_emplace(value); }
+		bool try_push(value_type &&value) { return try_emplace(leestl::move(value)); }
+
+		// 队列已满时等待消费者腾出位置
+		void push(const value_type &value) {
+			for (_queue_backoff backoff; !try_emplace(value);) backoff.wait();
+		}
+		void push(value_type &&value) {
+			for (_queue_backoff backoff; !try_emplace(leestl::move(value));) backoff.wait();
+		}
+
+		/**
+		 * @brief 生产者从 first 开始复制至多 n 个元素到队尾，只发布一次 tail
+		 *
+		 * @tparam _FI 前向迭代器类型
+		 * @param first 区间起始
+		 * @param n 元素个数
+		 * @return size_type 实际入队的个数，受空位个数限制
+		 */
+		template <typename _FI>
+		size_type try_push_n(_FI first, size_type n) {
+			const size_type t = _tail.load(std::memory_order_relaxed);
+			if (capacity() - (t - _head_cache) < n)
+				_head_cache = _head.load(std::memory_order_acquire);
+			n = leestl::min(n, capacity() - (t - _head_cache));
+			if (n == 0) return 0;
+			// 从 tail 所在槽位写到空间末尾，剩余的回绕到起始处
+			const size_type i = t & _impl.mask;
+			const size_type first_len = leestl::min(n, capacity() - i);
+			_FI             mid = first;
+			leestl::advance(mid, first_len);
+			leestl::uninitialized_copy(first, mid, _impl.buf + i);
+			try {
+				_FI last = mid;
+				leestl::advance(last, n - first_len);
+				leestl::uninitialized_copy(mid, last, _impl.buf);
+			} catch (...) {
+				_tail.store(t + first_len, std::memory_order_release);
+				throw;
+			}
+			_tail.store(t + n, std::memory_order_release);
+			return n;
+		}
+
+		/**
+		 * @brief 消费者取出队首元素
+		 *
+		 * @param out 接收元素的对象
+		 * @return bool 队列为空时返回 false，不修改 out
+		 */
+		bool try_pop(value_type &out) {
+			const size_type h = _head.load(std::memory_order_relaxed);
+			if (h == _tail_cache) {
+				_tail_cache = _tail.load(std::memory_order_acquire);
+				if (h == _tail_cache) return false;
+			}
+			T *p = _impl.buf + (h & _impl.mask);
+			out = leestl::move(*p);
+			leestl::destory(p);
+			_head.store(h + 1, std::memory_order_release);
+			return true;
+		}
+
+		// 队列为空时等待生产者写入
+		void pop(value_type &out) {
+			for (_queue_backoff backoff; !try_pop(out);) backoff.wait();
+		}
+
+		/**
+		 * @brief 消费者把至多 n 个队首元素依次移动到 result 处，只发布一次 head
+		 *
+		 * @tparam _OI 输出迭代器类型
+		 * @param result 输出位置
+		 * @param n 元素个数
+		 * @return size_type 实际出队的个数，受元素个数限制
+		 */
+		template <typename _OI>
+		size_type try_pop_n(_OI result, size_type n) {
+			const size_type h = _head.load(std::memory_order_relaxed);
+			if (_tail_cache - h < n) _tail_cache = _tail.load(std::memory_order_acquire);
+			n = leestl::min(n, _tail_cache - h);
+			if (n == 0) return 0;
+			const size_type i = h & _impl.mask;
+			const size_type first_len = leestl::min(n, capacity() - i);
+			result = leestl::move(_impl.buf + i, _impl.buf + i + first_len, result);
+			leestl::move(_impl.buf, _impl.buf + (n - first_len), result);
+			_destroy(h, n);
+			_head.store(h + n, std::memory_order_release);
+			return n;
+		}
+
+	private:
+		// 销毁从位置 pos 开始的 n 个元素，它们至多分成两段连续区间
+		void _destroy(size_type pos, size_type n) noexcept {
+			if constexpr (!std::is_trivially_destructible<T>::value) {
+				const size_type i = pos & _impl.mask;
+				const size_type first_len = leestl::min(n, capacity() - i);
+				leestl::destory(_impl.buf + i, _impl.buf + i + first_len);
+				leestl::destory(_impl.buf, _impl.buf + (n - first_len));
+			}
+		}
+	};
+
+	/**
+	 * @brief 多生产者多消费者的无锁有界队列
+	 *
+	 * 	元素的移动构造与析构不能抛出异常：槽位一旦被占有就无法退回。复制构造可能抛出异常时，
+	 * 	先在槽位之外构造好元素，占有槽位后再移动进去
+	 *
+	 * @tparam T 元素类型
+	 * @tparam Alloc 配置器类型
+	 */
+	template <typename T, typename Alloc = leestl::allocator<T>>
+	class mpmc_queue {
+		static_assert(
+		    std::is_nothrow_move_constructible<T>::value &&
+		        std::is_nothrow_destructible<T>::value,
+		    "mpmc_queue requires nothrow move construction and destruction");
+
+	public:
+		typedef T      value_type;
+		typedef size_t size_type;
+		typedef Alloc  allocator_type;
+		typedef typename leestl::allocator_traits<Alloc>::template rebind_alloc<T> data_allocator;
+
+	private:
+		typedef leestl::allocator_traits<data_allocator> _alloc_traits;
+
+		// 槽位：seq 等于位置 pos 时可供该位置入队，等于 pos + 1 时存有该位置的元素，
+		// 出队后置为 pos + 容量，即下一圈同一槽位的入队位置
+		struct _cell {
+			std::atomic<size_type> seq;
+			alignas(T) unsigned char storage[sizeof(T)];
+
+			T *valptr() noexcept { return reinterpret_cast<T *>(storage); }
+		};
+
+		typedef typename _alloc_traits::template rebind_alloc<_cell> cell_allocator;
+		typedef leestl::allocator_traits<cell_allocator>             _cell_traits;
+
+		// 构造后只读的部分，继承配置器以利用空基类优化
+		struct _queue_impl : public data_allocator {
+			_cell    *cells = nullptr;    // 环形槽位数组
+			size_type mask = 0;           // 容量减一
+
+			_queue_impl(const data_allocator &a) noexcept : data_allocator(a) {}
+		};
+
+		alignas(_QUEUE_CACHE_LINE) _queue_impl _impl;
+		alignas(_QUEUE_CACHE_LINE) std::atomic<size_type> _enqueue_pos{0};    // 下一个入队位置
+		alignas(_QUEUE_CACHE_LINE) std::atomic<size_type> _dequeue_pos{0};    // 下一个出队位置
+
+		data_allocator &_get_alloc() noexcept { return _impl; }
+
+	public:
+		/**
+		 * @brief 构造空队列，一次性分配全部槽位
+		 *
+		 * @param capacity 容量，向上取整为 2 的幂
+		 * @param alloc 配置器
+		 */
+		explicit mpmc_queue(size_type capacity, const allocator_type &alloc = allocator_type())
+		        : _impl(data_allocator(alloc)) {
+			cell_allocator  a(_get_alloc());
+			const size_type cap = _queue_capacity(capacity, _cell_traits::max_size(a));
+			_impl.cells = _cell_traits::allocate(a, cap);
+			_impl.mask = cap - 1;
+			for (size_type i = 0; i < cap; ++i) {
+				::new (static_cast<void *>(_impl.cells + i)) _cell;
+				_impl.cells[i].seq.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		mpmc_queue(const mpmc_queue &) = delete;
+		mpmc_queue &operator=(const mpmc_queue &) = delete;
+
+		~mpmc_queue() noexcept {
+			const size_type last = _enqueue_pos.load(std::memory_order_relaxed);
+			for (size_type pos = _dequeue_pos.load(std::memory_order_relaxed); pos != last; ++pos)
+				leestl::destory(_cell_at(pos).valptr());
+			cell_allocator a(_get_alloc());
+			_cell_traits::deallocate(a, _impl.cells, capacity());
+		}
+
+		size_type capacity() const noexcept { return _impl.mask + 1; }
+
+		// 元素个数的近似值，包括已被占有但尚未写完的槽位
+		size_type size() const noexcept {
+			const size_type d = _dequeue_pos.load(std::memory_order_acquire);
+			const size_type e = _enqueue_pos.load(std::memory_order_acquire);
+			return e - d <= capacity() ? e - d : 0;
+		}
+
+		bool empty() const noexcept { return size() == 0; }
+
+		/**
+		 * @brief 占有一个入队位置并直接构造元素
+		 *
+		 * @param args 构造参数
+		 * @return bool 队列已满时返回 false
+		 */
+		template <typename... Args>
+		bool try_emplace(Args &&...args) {
+			if constexpr (std::is_nothrow_constructible<T, Args &&...>::value) {
+				size_type pos;
+				_cell    *c = _claim_enqueue(pos);
+				if (c == nullptr) return false;
+				_alloc_traits::construct(_get_alloc(), c->valptr(), leestl::forward<Args>(args)...);
+				c->seq.store(pos + 1, std::memory_order_release);
+				return true;
+			} else {
+				T tmp(leestl::forward<Args>(args)...);
+				return try_emplace(leestl::move(tmp));
+			}
+		}
+
+		bool try_push(const value_type &value) { return try_emplace(value); }
+		bool try_push(value_type &&value) { return try_emplace(leestl::move(value)); }
+
+		// 队列已满时等待消费者腾出位置
+		void push(const value_type &value) {
+			for (_queue_backoff backoff; !try_emplace(value);) backoff.wait();
+		}
+		void push(value_type &&value) {
+			for (_queue_backoff backoff; !try_emplace(leestl::move(value));) backoff.wait();
+		}
+
+		/**
+		 * @brief 用一次 CAS 占有从入队位置开始的一批空闲槽位，再从 first 开始复制元素
+		 *
+		 * 	从 *first 复制构造可能抛出异常时退化为逐个 try_push
+		 *
+		 * @tparam _FI 前向迭代器类型
+		 * @param first 区间起始
+		 * @param n 元素个数
+		 * @return size_type 实际入队的个数
+		 */
+		template <typename _FI>
+		size_type try_push_n(_FI first, size_type n) {
+			typedef decltype(*first) source_reference;
+			if constexpr (!std::is_nothrow_constructible<T, source_reference>::value) {
+				size_type k = 0;
+				for (; k < n && try_push(*first); ++k) ++first;
+				return k;
+			} else {
+				size_type       pos;
+				const size_type k = _claim_batch(_enqueue_pos, 0, n, pos);
+				for (size_type i = 0; i < k; ++i, (void)++first) {
+					_cell &c = _cell_at(pos + i);
+					_alloc_traits::construct(_get_alloc(), c.valptr(), *first);
+					c.seq.store(pos + i + 1, std::memory_order_release);
+				}
+				return k;
+			}
+		}
+
+		/**
+		 * @brief 占有一个出队位置并取出元素
+		 *
+		 * 	移动赋值给 out 时抛出异常则该元素被丢弃，槽位照常释放
+		 *
+		 * @param out 接收元素的对象
+		 * @return bool 队列为空时返回 false，不修改 out
+		 */
+		bool try_pop(value_type &out) {
+			size_type pos;
+			_cell    *c = _claim_dequeue(pos);
+			if (c == nullptr) return false;
+			_move_out(*c, pos, out);
+			return true;
+		}
+
+		// 队列为空时等待生产者写入
+		void pop(value_type &out) {
+			for (_queue_backoff backoff; !try_pop(out);) backoff.wait();
+		}
+
+		/**
+		 * @brief 用一次 CAS 占有从出队位置开始的一批已写入的槽位，把元素依次移动到 result 处
+		 *
+		 * @tparam _OI 输出迭代器类型
+		 * @param result 输出位置
+		 * @param n 元素个数
+		 * @return size_type 实际出队的个数
+		 */
+		template <typename _OI>
+		size_type try_pop_n(_OI result, size_type n) {
+			size_type       pos;
+			const size_type k = _claim_batch(_dequeue_pos, 1, n, pos);
+			size_type       i = 0;
+			try {
+				for (; i < k; ++i, (void)++result) _move_out(_cell_at(pos + i), pos + i, *result);
+			} catch (...) {
+				// 已占有的其余槽位不能退回，丢弃其中的元素并释放
+				for (++i; i < k; ++i) _release(_cell_at(pos + i), pos + i);
+				throw;
+			}
+			return k;
+		}
+
+	private:
+		_cell &_cell_at(size_type pos) noexcept { return _impl.cells[pos & _impl.mask]; }
+
+		// 释放出队位置 pos 上的槽位，供下一圈入队
+		void _release(_cell &c, size_type pos) noexcept {
+			leestl::destory(c.valptr());
+			c.seq.store(pos + capacity(), std::memory_order_release);
+		}
+
+		template <typename Out>
+		void _move_out(_cell &c, size_type pos, Out &&out) {
+			struct _guard {
+				mpmc_queue *q;
+				_cell      &c;
+				size_type   pos;
+				~_guard() { q->_release(c, pos); }
+			} guard{this, c, pos};
+			out = leestl::move(*c.valptr());
+		}
+
+		/**
+		 * @brief 推进 position 占有一个槽位
+		 *
+		 * @param position 入队或出队位置
+		 * @param ready 槽位可被占有时 seq 比位置多出的值：入队为 0，出队为 1
+		 * @param pos 占有的位置
+		 * @return _cell* 占有的槽位，队列已满（或为空）时返回空指针
+		 */
+		_cell *_claim(std::atomic<size_type> &position, size_type ready, size_type &pos) noexcept {
+			pos = position.load(std::memory_order_relaxed);
+			for (;;) {
+				_cell          &c = _cell_at(pos);
+				const ptrdiff_t dif =
+				    ptrdiff_t(c.seq.load(std::memory_order_acquire) - (pos + ready));
+				if (dif == 0) {
+					if (position.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						return &c;
+				} else if (dif < 0) {
+					return nullptr;
+				} else {
+					pos = position.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		_cell *_claim_enqueue(size_type &pos) noexcept { return _claim(_enqueue_pos, 0, pos); }
+		_cell *_claim_dequeue(size_type &pos) noexcept { return _claim(_dequeue_pos, 1, pos); }
+
+		/**
+		 * @brief 统计从 position 开始连续可占有的槽位（至多 n 个），用一次 CAS 全部占有
+		 *
+		 * 	位置尚未推进时，这些槽位只能由推进 position 的线程改变，因此 CAS 成功时统计仍然有效
+		 *
+		 * @return size_type 占有的槽位个数，起始位置存入 pos
+		 */
+		size_type _claim_batch(
+		    std::atomic<size_type> &position, size_type ready, size_type n,
+		    size_type &pos) noexcept {
+			n = leestl::min(n, capacity());
+			if (n == 0) return 0;
+			pos = position.load(std::memory_order_relaxed);
+			for (;;) {
+				size_type k = 0;
+				while (k < n &&
+				       _cell_at(pos + k).seq.load(std::memory_order_acquire) == pos + k + ready)
+					++k;
+				if (k == 0) {
+					const ptrdiff_t dif = ptrdiff_t(
+					    _cell_at(pos).seq.load(std::memory_order_acquire) - (pos + ready));
+					if (dif < 0) return 0;
+					pos = position.load(std::memory_order_relaxed);
+				} else if (position.compare_exchange_weak(
+				               pos, pos + k, std::memory_order_relaxed)) {
+					return k;
+				}
+			}
+		}
+	};
+
+}    // namespace leestl
+
+#endif
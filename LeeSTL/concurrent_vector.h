@@ -0,0 +1,818 @@
+/** @file concurrent_vector.h
+ * 	这个文件实现可被多个线程同时追加元素的分段向量 concurrent_vector
+ *
+ * 	元素存放在若干段中：第 0 段有 F 个元素（F 为 2 的幂，使一段至少占 256 字节），
+ * 	第 k 段（k >= 1）存放下标 [F * 2^(k-1), F * 2^k)，容量每多一段翻一倍。下标 i 所在的段
+ * 	只需对 i | (F - 1) 取最高位即可求出，随机访问是一次位扫描、一次表查找与一次加法。
+ * 	各段的起始地址记在一张固定长度的段表中，段表本身从不重新分配，
+ * 	已有的段也从不搬移，因此元素的地址在容器的整个生命周期内保持不变。
+ *
+ * 	grow_by、push_back 等追加操作用一次 fetch_add 占有一段连续的下标，然后在这些位置上构造
+ * 	元素；所需的段尚未分配时由先到的线程分配并用 CAS 写入段表，抢输的线程释放自己分配的段。
+ * 	追加操作之间、追加与读取已完成构造的元素之间都不需要加锁。size() 包含其他线程正在构造
+ * 	的元素，读取这些元素需要由调用者另行同步（例如先由追加线程发布下标）。
+ *
+ * 	clear、shrink_to_fit、赋值与交换不是线程安全的。交换与移动之后原有的迭代器失效，
+ * 	但元素的地址不变。
+ */
+
+#ifndef _LEESTL_CONCURRENT_VECTOR_H_
+#define _LEESTL_CONCURRENT_VECTOR_H_ 1
+
+#include <atomic>
+#include <exception>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "algo.h"
+#include "alloc_traits.h"
+#include "allocator.h"
+#include "iterator.h"
+#include "uninitialized.h"
+#include "utils.h"
+
+namespace leestl {
+
+	/**
+	 * @brief 第 0 段元素个数的对数：段至少占 256 字节，且至少有 2 个元素
+	 *
+	 * @param size 元素的字节数
+	 * @return size_t 第 0 段元素个数以 2 为底的对数
+	 */
+	constexpr size_t _concurrent_vector_first_bits(size_t size) {
+		size_t bits = 1;
+		while ((size_t(1) << bits) * size < 256) ++bits;
+		return bits;
+	}
+
+	/**
+	 * @brief concurrent_vector 的分段方式，容器与迭代器共用
+	 *
+	 * @tparam T 元素类型
+	 */
+	template <typename T>
+	struct _concurrent_vector_layout {
+		static constexpr size_t first_bits = _concurrent_vector_first_bits(sizeof(T));
+		static constexpr size_t first_size = size_t(1) << first_bits;                   // 第 0 段
+		static constexpr size_t segment_count = sizeof(size_t) * 8 - first_bits + 1;    // 段表长度
+
+		// 下标 i 所在的段：i < first_size 时为 0，否则为 i 的最高位减去 first_bits 再加 1
+		static size_t segment_of(size_t i) noexcept {
+			return size_t(leestl::_lg(i | (first_size - 1))) + 1 - first_bits;
+		}
+
+		// 第 k 段第一个元素的下标，第 k 段（k >= 1）的元素个数也等于这个值
+		static size_t segment_base(size_t k) noexcept {
+			return k == 0 ? 0 : size_t(1) << (k + first_bits - 1);
+		}
+
+		static size_t segment_size(size_t k) noexcept {
+			return k == 0 ? first_size : segment_base(k);
+		}
+
+		// 下标 i 是否为第 1 段及之后某一段的起点，迭代器逐个移动时只在这些位置重新查段表
+		static bool is_segment_start(size_t i) noexcept {
+			return i >= first_size && (i & (i - 1)) == 0;
+		}
+
+		// 下标 i 处元素的地址，所在的段尚未分配时为空
+		static T *address(const std::atomic<T *> *table, size_t i) noexcept {
+			const size_t k = segment_of(i);
+			T           *seg = table[k].load(std::memory_order_acquire);
+			return seg ? seg + (i - segment_base(k)) : nullptr;
+		}
+	};
+
+	/**
+	 * @brief concurrent_vector 的随机访问迭代器
+	 *
+	 * 	记录段表、下标、下一段的起点与当前元素的地址：解引用直接使用地址，逐个前移时只在到达
+	 * 	下一段的起点时重新查段表；比较与相减只看下标
+	 *
+	 * @tparam T 元素类型
+	 * @tparam Const 是否只读
+	 */
+	template <typename T, bool Const>
+	class _concurrent_vector_iterator {
+		template <typename, typename>
+		friend class concurrent_vector;
+		template <typename, bool>
+		friend class _concurrent_vector_iterator;
+
+		typedef _concurrent_vector_layout<T> _layout;
+
+	public:
+		typedef random_acess_interator_tag                iterator_category;
+		typedef T                                         value_type;
+		typedef ptrdiff_t                                 difference_type;
+		typedef std::conditional_t<Const, const T *, T *> pointer;
+		typedef std::conditional_t<Const, const T &, T &> reference;
+
+		_concurrent_vector_iterator() noexcept = default;
+
+		// 可写迭代器可以转换为只读迭代器
+		template <bool C, typename = std::enable_if_t<Const && !C>>
+		_concurrent_vector_iterator(const _concurrent_vector_iterator<T, C> &x) noexcept
+		        : _table(x._table), _index(x._index), _next(x._next), _ptr(x._ptr) {}
+
+		reference operator*() const noexcept { return *_ptr; }
+		pointer   operator->() const noexcept { return _ptr; }
+		reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+		_concurrent_vector_iterator &operator++() noexcept {
+			if (++_index == _next) _seek();
+			else ++_ptr;
+			return *this;
+		}
+
+		_concurrent_vector_iterator operator++(int) noexcept {
+			_concurrent_vector_iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		_concurrent_vector_iterator &operator--() noexcept {
+			if (_layout::is_segment_start(_index--)) _seek();
+			else --_ptr;
+			return *this;
+		}
+
+		_concurrent_vector_iterator operator--(int) noexcept {
+			_concurrent_vector_iterator tmp = *this;
+			--*this;
+			return tmp;
+		}
+
+		_concurrent_vector_iterator &operator+=(difference_type n) noexcept {
+			_index += size_t(n);
+			_seek();
+			return *this;
+		}
+
+		_concurrent_vector_iterator &operator-=(difference_type n) noexcept {
+			return *this += -n;
+		}
+
+		_concurrent_vector_iterator operator+(difference_type n) const noexcept {
+			_concurrent_vector_iterator tmp = *this;
+			return tmp += n;
+		}
+
+		_concurrent_vector_iterator operator-(difference_type n) const noexcept {
+			_concurrent_vector_iterator tmp = *this;
+			return tmp -= n;
+		}
+
+		friend _concurrent_vector_iterator operator+(
+		    difference_type n, const _concurrent_vector_iterator &x) noexcept {
+			return x + n;
+		}
+
+		template <bool C>
+		difference_type operator-(const _concurrent_vector_iterator<T, C> &x) const noexcept {
+			return difference_type(_index - x._index);
+		}
+
+		template <bool C>
+		bool operator==(const _concurrent_vector_iterator<T, C> &x) const noexcept {
+			return _index == x._index;
+		}
+
+		template <bool C>
+		bool operator!=(const _concurrent_vector_iterator<T, C> &x) const noexcept {
+			return _index != x._index;
+		}
+
+		template <bool C>
+		bool operator<(const _concurrent_vector_iterator<T, C> &x) const noexcept {
+			return _index < x._index;
+		}
+
+		template <bool C>
+		bool operator>(const _concurrent_vector_iterator<T, C> &x) const noexcept {
+			return x._index < _index;
+		}
+
+		template <bool C>
+		bool operator<=(const _concurrent_vector_iterator<T, C> &x) const noexcept {
+			return _index <= x._index;
+		}
+
+		template <bool C>
+		bool operator>=(const _concurrent_vector_iterator<T, C> &x) const noexcept {
+			return _index >= x._index;
+		}
+
+	private:
+		const std::atomic<T *> *_table = nullptr;    // 所属容器的段表
+		size_t                  _index = 0;          // 下标
+		size_t                  _next = 0;           // 下一段的起始下标
+		T                      *_ptr = nullptr;      // 当前元素，所在的段未分配时为空
+
+		_concurrent_vector_iterator(const std::atomic<T *> *table, size_t index) noexcept
+		        : _table(table), _index(index) {
+			_seek();
+		}
+
+		// 按下标重新查段表
+		void _seek() noexcept {
+			const size_t k = _layout::segment_of(_index);
+			_next = _layout::segment_base(k) + _layout::segment_size(k);
+			_ptr = _layout::address(_table, _index);
+		}
+	};
+
+	/**
+	 * @brief 可被多个线程同时追加元素、元素地址始终不变的分段向量
+	 *
+	 * @tparam T 元素类型
+	 * @tparam Alloc 配置器类型，需要可被多个线程同时调用
+	 */
+	template <typename T, typename Alloc = leestl::allocator<T>>
+	class concurrent_vector {
+	public:
+		typedef Alloc allocator_type;    // 配置器类型
+		typedef typename leestl::allocator_traits<Alloc>::template rebind_alloc<T> data_allocator;
+
+	private:
+		typedef leestl::allocator_traits<data_allocator> _alloc_traits;
+		typedef _concurrent_vector_layout<T>             _layout;
+
+	public:
+		typedef T                                       value_type;
+		typedef typename _alloc_traits::size_type       size_type;
+		typedef typename _alloc_traits::difference_type difference_type;
+		typedef T                                      *pointer;
+		typedef const T                                *const_pointer;
+		typedef value_type                             &reference;
+		typedef const value_type                       &const_reference;
+
+		typedef _concurrent_vector_iterator<T, false>    iterator;
+		typedef _concurrent_vector_iterator<T, true>     const_iterator;
+		typedef leestl::reverse_iterator<iterator>       reverse_iterator;
+		typedef leestl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+		allocator_type get_allocator() const noexcept { return allocator_type(_get_alloc()); }
+
+	private:
+		// 构造元素时抛出异常、没有构造出元素的下标区间 [first, last)，析构时跳过
+		struct _hole {
+			size_type first;
+			size_type last;
+			_hole    *next;
+		};
+
+		// 继承配置器以利用空基类优化，无状态配置器不占用额外空间。
+		// 追加操作争用的 size 独占缓存行，不影响只读段表的线程
+		struct _concurrent_vector_impl : public data_allocator {
+			std::atomic<T *> table[_layout::segment_count] = {};    // 各段起始地址，未分配为空
+			alignas(64) std::atomic<size_type> size{0};             // 已占有的下标个数
+			std::atomic<_hole *> holes{nullptr};                    // 无锁单链表
+
+			_concurrent_vector_impl() noexcept(
+			    std::is_nothrow_default_constructible<data_allocator>::value)
+			        : data_allocator() {}
+			_concurrent_vector_impl(const data_allocator &a) noexcept : data_allocator(a) {}
+			_concurrent_vector_impl(data_allocator &&a) noexcept
+			        : data_allocator(leestl::move(a)) {}
+
+			// 交换数据，不交换配置器；只能在没有其他线程访问时调用
+			void _swap_data(_concurrent_vector_impl &x) noexcept {
+				for (size_type k = 0; k < _layout::segment_count; ++k)
+					_swap_relaxed(table[k], x.table[k]);
+				_swap_relaxed(size, x.size);
+				_swap_relaxed(holes, x.holes);
+			}
+
+			template <typename U>
+			static void _swap_relaxed(std::atomic<U> &a, std::atomic<U> &b) noexcept {
+				a.store(b.exchange(a.load(std::memory_order_relaxed), std::memory_order_relaxed),
+				        std::memory_order_relaxed);
+			}
+		};
+
+		_concurrent_vector_impl _impl;
+
+		data_allocator       &_get_alloc() noexcept { return _impl; }
+		const data_allocator &_get_alloc() const noexcept { return _impl; }
+
+	public:
+		/**
+		 * @brief concurrent_vector 默认构造函数，不分配空间
+		 *
+		 */
+		concurrent_vector() = default;
+
+		/**
+		 * @brief 指定配置器的 concurrent_vector 构造函数
+		 *
+		 * @param alloc 配置器
+		 */
+		explicit concurrent_vector(const allocator_type &alloc) noexcept
+		        : _impl(data_allocator(alloc)) {}
+
+		/**
+		 * @brief 构造 n 个值初始化的元素
+		 *
+		 * @param n 元素个数
+		 * @param alloc 配置器
+		 */
+		explicit concurrent_vector(size_type n, const allocator_type &alloc = allocator_type())
+		        : _impl(data_allocator(alloc)) {
+			_guarded([&] { grow_by(n); });
+		}
+
+		/**
+		 * @brief 构造 n 个值为 value 的元素
+		 *
+		 * @param n 元素个数
+		 * @param value 元素的值
+		 * @param alloc 配置器
+		 */
+		concurrent_vector(
+		    size_type n, const value_type &value, const allocator_type &alloc = allocator_type())
+		        : _impl(data_allocator(alloc)) {
+			_guarded([&] { grow_by(n, value); });
+		}
+
+		/**
+		 * @brief 依次复制 [first, last) 中的元素
+		 *
+		 * @tparam _II 迭代器类型
+		 * @param first 区间起始
+		 * @param last 区间终止
+		 * @param alloc 配置器
+		 */
+		template <typename _II, typename = leestl::RequireInputIterator<_II>>
+		concurrent_vector(_II first, _II last, const allocator_type &alloc = allocator_type())
+		        : _impl(data_allocator(alloc)) {
+			_guarded([&] { grow_by(first, last); });
+		}
+
+		/**
+		 * @brief 依次复制初始化列表中的元素
+		 *
+		 * @param il 初始化列表
+		 * @param alloc 配置器
+		 */
+		concurrent_vector(
+		    std::initializer_list<value_type> il, const allocator_type &alloc = allocator_type())
+		        : concurrent_vector(il.begin(), il.end(), alloc) {}
+
+		/**
+		 * @brief 复制构造函数，配置器由 select_on_container_copy_construction 决定
+		 *
+		 * @param x 要复制的 concurrent_vector，不能有其他线程同时追加元素
+		 */
+		concurrent_vector(const concurrent_vector &x)
+		        : _impl(_alloc_traits::select_on_container_copy_construction(x._get_alloc())) {
+			_guarded([&] { grow_by(x.begin(), x.end()); });
+		}
+
+		/**
+		 * @brief 指定配置器的复制构造函数
+		 *
+		 * @param x 要复制的 concurrent_vector
+		 * @param alloc 配置器
+		 */
+		concurrent_vector(const concurrent_vector &x, const allocator_type &alloc)
+		        : _impl(data_allocator(alloc)) {
+			_guarded([&] { grow_by(x.begin(), x.end()); });
+		}
+
+		/**
+		 * @brief 移动构造函数，接管 x 的全部段与配置器，元素地址不变
+		 */
+		concurrent_vector(concurrent_vector &&x) noexcept : _impl(leestl::move(x._get_alloc())) {
+			_impl._swap_data(x._impl);
+		}
+
+		/**
+		 * @brief 指定配置器的移动构造函数，配置器不相等时只能逐个移动元素
+		 *
+		 * @param x 要移动的 concurrent_vector
+		 * @param alloc 配置器
+		 */
+		concurrent_vector(concurrent_vector &&x, const allocator_type &alloc)
+		        : _impl(data_allocator(alloc)) {
+			if (_alloc_traits::equal(_get_alloc(), x._get_alloc())) {
+				_impl._swap_data(x._impl);
+			} else {
+				_guarded([&] { _move_elements(x); });
+			}
+		}
+
+		~concurrent_vector() noexcept {
+			_destroy_elements();
+			_free_holes();
+			_free_segments(0);
+		}
+
+		// 复制赋值，沿用已分配的段
+		concurrent_vector &operator=(const concurrent_vector &x) {
+			if (this != &x) {
+				clear();
+				if constexpr (_alloc_traits::propagate_on_container_copy_assignment::value) {
+					// 旧配置器无法释放新配置器分配的空间，先用旧配置器释放
+					if (!_alloc_traits::equal(_get_alloc(), x._get_alloc())) _free_segments(0);
+					_get_alloc() = x._get_alloc();
+				}
+				grow_by(x.begin(), x.end());
+			}
+			return *this;
+		}
+
+		// 移动赋值，配置器可传播或相等时直接接管各段，否则逐个移动元素
+		concurrent_vector &operator=(concurrent_vector &&x) noexcept(
+		    _alloc_traits::propagate_on_container_move_assignment::value ||
+		    _alloc_traits::is_always_equal::value) {
+			if (this != &x) {
+				if constexpr (_alloc_traits::propagate_on_container_move_assignment::value) {
+					_move_assign(x);
+					_get_alloc() = leestl::move(x._get_alloc());
+				} else if (_alloc_traits::equal(_get_alloc(), x._get_alloc())) {
+					_move_assign(x);
+				} else {
+					clear();
+					_move_elements(x);
+				}
+			}
+			return *this;
+		}
+
+		concurrent_vector &operator=(std::initializer_list<value_type> il) {
+			clear();
+			grow_by(il.begin(), il.end());
+			return *this;
+		}
+
+		// 迭代器相关操作，end() 取调用时的 size()
+		iterator       begin() noexcept { return iterator(_impl.table, 0); }
+		const_iterator begin() const noexcept { return const_iterator(_impl.table, 0); }
+		iterator       end() noexcept { return iterator(_impl.table, size()); }
+		const_iterator end() const noexcept { return const_iterator(_impl.table, size()); }
+		reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+		const_iterator         cbegin() const noexcept { return begin(); }
+		const_iterator         cend() const noexcept { return end(); }
+		const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+		const_reverse_iterator crend() const noexcept { return rend(); }
+
+		// 容量相关操作，size() 包含其他线程正在构造的元素
+		bool      empty() const noexcept { return size() == 0; }
+		size_type size() const noexcept { return _impl.size.load(std::memory_order_acquire); }
+		size_type max_size() const noexcept { return _alloc_traits::max_size(_get_alloc()); }
+
+		// 从下标 0 开始连续已分配的元素个数
+		size_type capacity() const noexcept {
+			size_type k = 0;
+			while (k < _layout::segment_count && _impl.table[k].load(std::memory_order_acquire))
+				++k;
+			return _layout::segment_base(k);
+		}
+
+		/**
+		 * @brief 预先分配容纳 n 个元素所需的各段，可与追加操作同时调用
+		 *
+		 * @param n 元素个数
+		 */
+		void reserve(size_type n) {
+			if (n > max_size())
+				throw std::length_error("concurrent_vector::reserve: n exceeds max_size()");
+			if (n == 0) return;
+			for (size_type k = 0, last = _layout::segment_of(n - 1); k <= last; ++k) _segment(k);
+		}
+
+		// 释放 size() 之后整段空闲的段，不是线程安全的
+		void shrink_to_fit() noexcept {
+			const size_type n = size();
+			_free_segments(n == 0 ? 0 : _layout::segment_of(n - 1) + 1);
+		}
+
+		// 元素访问相关操作
+		reference operator[](size_type n) noexcept { return *_element(n); }
+		const_reference operator[](size_type n) const noexcept { return *_element(n); }
+
+		reference at(size_type n) {
+			_range_check(n);
+			return (*this)[n];
+		}
+		const_reference at(size_type n) const {
+			_range_check(n);
+			return (*this)[n];
+		}
+
+		reference       front() noexcept { return *_element(0); }
+		const_reference front() const noexcept { return *_element(0); }
+		reference       back() noexcept { return *_element(size() - 1); }
+		const_reference back() const noexcept { return *_element(size() - 1); }
+
+		/**
+		 * @brief 在尾部追加 n 个值初始化的元素，可被多个线程同时调用
+		 *
+		 * @param n 追加的元素个数
+		 * @return iterator 指向追加的第一个元素
+		 */
+		iterator grow_by(size_type n) {
+			return _grow(n, [this](T *p) { _alloc_traits::construct(_get_alloc(), p); });
+		}
+
+		/**
+		 * @brief 在尾部追加 n 个值为 value 的元素，可被多个线程同时调用
+		 *
+		 * @param n 追加的元素个数
+		 * @param value 元素的值
+		 * @return iterator 指向追加的第一个元素
+		 */
+		iterator grow_by(size_type n, const value_type &value) {
+			return _grow(
+			    n, [this, &value](T *p) { _alloc_traits::construct(_get_alloc(), p, value); });
+		}
+
+		/**
+		 * @brief 在尾部追加 [first, last) 中的元素，可被多个线程同时调用
+		 *
+		 * 	前向迭代器一次占有全部下标，元素连续排列；输入迭代器只能逐个追加，
+		 * 	其他线程追加的元素可能穿插其间
+		 *
+		 * @tparam _II 迭代器类型
+		 * @param first 区间起始
+		 * @param last 区间终止
+		 * @return iterator 指向追加的第一个元素
+		 */
+		template <typename _II, typename = leestl::RequireInputIterator<_II>>
+		iterator grow_by(_II first, _II last) {
+			return _range_grow_by(first, last, leestl::iterator_category_types<_II>());
+		}
+
+		iterator grow_by(std::initializer_list<value_type> il) {
+			return grow_by(il.begin(), il.end());
+		}
+
+		/**
+		 * @brief 元素少于 n 个时用值初始化的元素补足到 n 个，可被多个线程同时调用
+		 *
+		 * @param n 至少需要的元素个数
+		 * @return iterator 指向补足的第一个元素，没有补足时指向下标 n
+		 */
+		iterator grow_to_at_least(size_type n) {
+			return _grow_to(n, [this](T *p) { _alloc_traits::construct(_get_alloc(), p); });
+		}
+
+		/**
+		 * @brief 元素少于 n 个时用值为 value 的元素补足到 n 个，可被多个线程同时调用
+		 *
+		 * @param n 至少需要的元素个数
+		 * @param value 元素的值
+		 * @return iterator 指向补足的第一个元素，没有补足时指向下标 n
+		 */
+		iterator grow_to_at_least(size_type n, const value_type &value) {
+			return _grow_to(
+			    n, [this, &value](T *p) { _alloc_traits::construct(_get_alloc(), p, value); });
+		}
+
+		// 在尾部追加一个元素，可被多个线程同时调用，返回指向它的迭代器
+		iterator push_back(const value_type &value) { return emplace_back(value); }
+		iterator push_back(value_type &&value) { return emplace_back(leestl::move(value)); }
+
+		/**
+		 * @brief 在尾部直接构造一个元素，可被多个线程同时调用
+		 *
+		 * @param args 构造参数
+		 * @return iterator 指向新元素
+		 */
+		template <typename... Args>
+		iterator emplace_back(Args &&...args) {
+			return _grow(1, [&](T *p) {
+				_alloc_traits::construct(_get_alloc(), p, leestl::forward<Args>(args)...);
+			});
+		}
+
+		// 交换两个 concurrent_vector，propagate_on_container_swap 为真时同时交换配置器
+		void swap(concurrent_vector &x) noexcept {
+			_impl._swap_data(x._impl);
+			if constexpr (_alloc_traits::propagate_on_container_swap::value)
+				leestl::swap(_get_alloc(), x._get_alloc());
+		}
+
+		// 销毁所有元素，保留已分配的段，不是线程安全的
+		void clear() noexcept {
+			_destroy_elements();
+			_free_holes();
+			_impl.size.store(0, std::memory_order_relaxed);
+		}
+
+	private:
+		void _range_check(size_type n) const {
+			if (n >= size())
+				throw std::out_of_range("concurrent_vector::_range_check: n >= size()");
+		}
+
+		// 下标 n 处元素的地址，所在的段必须已经分配
+		T *_element(size_type n) const noexcept {
+			const size_type k = _layout::segment_of(n);
+			return _impl.table[k].load(std::memory_order_acquire) + (n - _layout::segment_base(k));
+		}
+
+		// 取得第 k 段，尚未分配时分配并用 CAS 写入段表，抢输的线程释放自己分配的段
+		T *_segment(size_type k) {
+			T *seg = _impl.table[k].load(std::memory_order_acquire);
+			if (seg) return seg;
+			T *fresh = _alloc_traits::allocate(_get_alloc(), _layout::segment_size(k));
+			if (_impl.table[k].compare_exchange_strong(
+			        seg, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+				return fresh;
+			_alloc_traits::deallocate(_get_alloc(), fresh, _layout::segment_size(k));
+			return seg;
+		}
+
+		// 释放第 first 段及之后的所有段
+		void _free_segments(size_type first) noexcept {
+			for (size_type k = first; k < _layout::segment_count; ++k) {
+				T *seg = _impl.table[k].exchange(nullptr, std::memory_order_relaxed);
+				if (seg) _alloc_traits::deallocate(_get_alloc(), seg, _layout::segment_size(k));
+			}
+		}
+
+		// 占有 n 个连续的下标，返回第一个
+		size_type _claim(size_type n) {
+			if (n > max_size() - size())
+				throw std::length_error("concurrent_vector::grow_by: size exceeds max_size()");
+			return _impl.size.fetch_add(n, std::memory_order_acq_rel);
+		}
+
+		/**
+		 * @brief 依次在下标 [first, last) 处调用 construct 构造元素，逐段分配所需的空间
+		 *
+		 * 	出现异常时把没有构造的 [i, last) 记为空洞再重新抛出
+		 *
+		 * @param construct 在给出的地址上构造一个元素的函数
+		 */
+		template <typename Construct>
+		void _construct_at(size_type first, size_type last, Construct &construct) {
+			size_type i = first;
+			try {
+				while (i < last) {
+					const size_type k = _layout::segment_of(i);
+					const size_type base = _layout::segment_base(k);
+					const size_type end = leestl::min(last, base + _layout::segment_size(k));
+					T              *seg = _segment(k);
+					for (; i < end; ++i) construct(seg + (i - base));
+				}
+			} catch (...) {
+				_record_hole(i, last);
+				throw;
+			}
+		}
+
+		template <typename Construct>
+		iterator _grow(size_type n, Construct construct) {
+			const size_type first = _claim(n);
+			_construct_at(first, first + n, construct);
+			return iterator(_impl.table, first);
+		}
+
+		template <typename Construct>
+		iterator _grow_to(size_type n, Construct construct) {
+			if (n > max_size())
+				throw std::length_error(
+				    "concurrent_vector::grow_to_at_least: n exceeds max_size()");
+			size_type cur = _impl.size.load(std::memory_order_acquire);
+			while (cur < n &&
+			       !_impl.size.compare_exchange_weak(
+			           cur, n, std::memory_order_acq_rel, std::memory_order_acquire)) {}
+			if (cur >= n) return iterator(_impl.table, n);
+			_construct_at(cur, n, construct);
+			return iterator(_impl.table, cur);
+		}
+
+		template <typename _II>
+		iterator _range_grow_by(_II first, _II last, leestl::input_interator_tag) {
+			if (first == last) return end();
+			iterator result = push_back(*first);
+			for (++first; first != last; ++first) push_back(*first);
+			return result;
+		}
+
+		template <typename _FI>
+		iterator _range_grow_by(_FI first, _FI last, leestl::forward_interator_tag) {
+			return _grow(size_type(leestl::distance(first, last)), [this, &first](T *p) {
+				_alloc_traits::construct(_get_alloc(), p, *first);
+				++first;
+			});
+		}
+
+		// 逐个移动 x 的元素，x 保留原有元素（处于被移动后的状态）
+		void _move_elements(concurrent_vector &x) {
+			size_type i = 0;
+			_grow(x.size(), [this, &x, &i](T *p) {
+				_alloc_traits::construct(_get_alloc(), p, leestl::move(x[i]));
+				++i;
+			});
+		}
+
+		void _move_assign(concurrent_vector &x) noexcept {
+			concurrent_vector tmp(_get_alloc());
+			_impl._swap_data(tmp._impl);
+			_impl._swap_data(x._impl);
+		}
+
+		// 构造函数中执行 f，出现异常时销毁已有元素并释放空间
+		template <typename F>
+		void _guarded(F f) {
+			try {
+				f();
+			} catch (...) {
+				clear();
+				_free_segments(0);
+				throw;
+			}
+		}
+
+		// 记录空洞；无法记录时析构会访问未构造的对象，只能终止程序
+		void _record_hole(size_type first, size_type last) noexcept {
+			_hole *h = new (std::nothrow) _hole{first, last, nullptr};
+			if (!h) std::terminate();
+			h->next = _impl.holes.load(std::memory_order_relaxed);
+			while (!_impl.holes.compare_exchange_weak(
+			    h->next, h, std::memory_order_release, std::memory_order_relaxed)) {}
+		}
+
+		void _free_holes() noexcept {
+			_hole *h = _impl.holes.exchange(nullptr, std::memory_order_acquire);
+			while (h) {
+				_hole *next = h->next;
+				delete h;
+				h = next;
+			}
+		}
+
+		// 从下标 i 开始、在 end 之前第一段不在空洞中的区间 [i, result.second)，
+		// result.first 为跳过空洞后的起点
+		std::pair<size_type, size_type> _skip_holes(size_type i, size_type end) const noexcept {
+			bool moved = true;
+			while (moved) {
+				moved = false;
+				for (_hole *h = _impl.holes.load(std::memory_order_acquire); h; h = h->next)
+					if (h->first <= i && i < h->last) i = h->last, moved = true;
+			}
+			for (_hole *h = _impl.holes.load(std::memory_order_acquire); h; h = h->next)
+				if (i < h->first && h->first < end) end = h->first;
+			return std::pair<size_type, size_type>(i, leestl::max(i, end));
+		}
+
+		// 逐段销毁所有已构造的元素，跳过空洞，不改变 size
+		void _destroy_elements() noexcept {
+			if constexpr (!std::is_trivially_destructible<T>::value) {
+				const size_type n = size();
+				const bool      has_holes = _impl.holes.load(std::memory_order_acquire) != nullptr;
+				for (size_type i = 0; i < n;) {
+					const size_type k = _layout::segment_of(i);
+					const size_type base = _layout::segment_base(k);
+					size_type       end = leestl::min(n, base + _layout::segment_size(k));
+					if (has_holes) {
+						const std::pair<size_type, size_type> r = _skip_holes(i, end);
+						if (r.first != i) {
+							i = r.first;
+							continue;
+						}
+						end = r.second;
+					}
+					T *seg = _impl.table[k].load(std::memory_order_relaxed);
+					leestl::destory(seg + (i - base), seg + (end - base));
+					i = end;
+				}
+			}
+		}
+	};
+
+	template <typename T, typename Alloc>
+	inline bool operator==(
+	    const concurrent_vector<T, Alloc> &x, const concurrent_vector<T, Alloc> &y) {
+		return x.size() == y.size() && leestl::equal(x.begin(), x.end(), y.begin());
+	}
+
+	template <typename T, typename Alloc>
+	inline bool operator!=(
+	    const concurrent_vector<T, Alloc> &x, const concurrent_vector<T, Alloc> &y) {
+		return !(x == y);
+	}
+
+	template <typename T, typename Alloc>
+	inline bool operator<(
+	    const concurrent_vector<T, Alloc> &x, const concurrent_vector<T, Alloc> &y) {
+		return leestl::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+	}
+
+	template <typename T, typename Alloc>
+	inline void swap(concurrent_vector<T, Alloc> &x, concurrent_vector<T, Alloc> &y) noexcept {
+		x.swap(y);
+	}
+
+}    // namespace leestl
+
+#endif
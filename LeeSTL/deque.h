@@ -0,0 +1,1268 @@
+/** @file deque.h
+ * 	这个文件实现双端队列容器 deque
+ *
+ * 	元素存放在若干大小固定（约一页，_DEQUE_BLOCK_BYTES 字节）的块中，中控表 map 按顺序保存
+ * 	各块的指针，已使用的块位于 map 的中部，两侧留出空位。在两端插入只需在首尾块中构造元素，
+ * 	块满时再取一个块挂到 map 上，元素本身从不移动；map 一侧用完时，若总空位足够则把块指针
+ * 	移回中部，否则才重新分配更大的 map。随机访问先算出块号再算块内偏移，为 O(1)。
+ *
+ * 	首尾的块被清空后不释放，而是挂到容器内的空闲块链表上，下次需要新块时优先取用。
+ * 	作为生产者-消费者缓冲区（一端插入、另一端删除）时，预热后的稳态运行不再分配内存；
+ * 	空闲块在析构或 shrink_to_fit() 时才归还配置器。
+ */
+
+#ifndef _LEESTL_DEQUE_H_
+#define _LEESTL_DEQUE_H_ 1
+
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+
+#include "algo.h"
+#include "alloc_traits.h"
+#include "allocator.h"
+#include "iterator.h"
+#include "uninitialized.h"
+#include "utils.h"
+
+namespace leestl {
+
+	enum { _DEQUE_BLOCK_BYTES = 4096 };    // 块的目标大小
+	enum { _DEQUE_INITIAL_MAP_SIZE = 8 };
+
+	// 每个块容纳的元素个数：一页能放下几个就放几个，元素大于一页时每块一个
+	constexpr size_t _deque_block_size(size_t size) noexcept {
+		return size < _DEQUE_BLOCK_BYTES ? _DEQUE_BLOCK_BYTES / size : 1;
+	}
+
+	/**
+	 * @brief deque 的随机访问迭代器，记录当前元素、所在块的边界以及块在 map 中的位置
+	 *
+	 * @tparam T 元素类型
+	 * @tparam Const 是否只读
+	 */
+	template <typename T, bool Const>
+	class _deque_iterator {
+		template <typename, typename>
+		friend class deque;
+		template <typename, bool>
+		friend class _deque_iterator;
+
+	public:
+		typedef random_acess_interator_tag                iterator_category;
+		typedef T                                         value_type;
+		typedef ptrdiff_t                                 difference_type;
+		typedef std::conditional_t<Const, const T *, T *> pointer;
+		typedef std::conditional_t<Const, const T &, T &> reference;
+
+		static constexpr difference_type BLOCK_SIZE = _deque_block_size(sizeof(T));
+
+		_deque_iterator() noexcept = default;
+
+		// 可写迭代器可以转换为只读迭代器
+		template <bool C, typename = std::enable_if_t<Const && !C>>
+		_deque_iterator(const _deque_iterator<T, C> &x) noexcept
+		        : _cur(x._cur), _first(x._first), _last(x._last), _node(x._node) {}
+
+		reference operator*() const noexcept { return *_cur; }
+		pointer   operator->() const noexcept { return _cur; }
+		reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+		_deque_iterator &operator++() noexcept {
+			if (++_cur == _last) {
+				_set_node(_node + 1);
+				_cur = _first;
+			}
+			return *this;
+		}
+
+		_deque_iterator operator++(int) noexcept {
+			_deque_iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		_deque_iterator &operator--() noexcept {
+			if (_cur == _first) {
+				_set_node(_node - 1);
+				_cur = _last;
+			}
+			--_cur;
+			return *this;
+		}
+
+		_deque_iterator operator--(int) noexcept {
+			_deque_iterator tmp = *this;
+			--*this;
+			return tmp;
+		}
+
+		// 目标仍在当前块内时只移动指针，否则按块号与块内偏移定位
+		_deque_iterator &operator+=(difference_type n) noexcept {
+			const difference_type offset = n + (_cur - _first);
+			if (offset >= 0 && offset < BLOCK_SIZE) {
+				_cur += n;
+			} else {
+				const difference_type node_offset =
+				    offset > 0 ? offset / BLOCK_SIZE : -((-offset - 1) / BLOCK_SIZE) - 1;
+				_set_node(_node + node_offset);
+				_cur = _first + (offset - node_offset * BLOCK_SIZE);
+			}
+			return *this;
+		}
+
+		_deque_iterator &operator-=(difference_type n) noexcept { return *this += -n; }
+
+		_deque_iterator operator+(difference_type n) const noexcept {
+			_deque_iterator tmp = *this;
+			return tmp += n;
+		}
+
+		_deque_iterator operator-(difference_type n) const noexcept {
+			_deque_iterator tmp = *this;
+			return tmp -= n;
+		}
+
+		friend _deque_iterator operator+(difference_type n, const _deque_iterator &x) noexcept {
+			return x + n;
+		}
+
+		// 空迭代器的 _node 为空，此时两者之差为 0
+		template <bool C>
+		difference_type operator-(const _deque_iterator<T, C> &x) const noexcept {
+			return BLOCK_SIZE * (_node - x._node - (_node != nullptr)) + (_cur - _first) +
+			       (x._last - x._cur);
+		}
+
+		template <bool C>
+		bool operator==(const _deque_iterator<T, C> &x) const noexcept {
+			return _cur == x._cur;
+		}
+
+		template <bool C>
+		bool operator!=(const _deque_iterator<T, C> &x) const noexcept {
+			return _cur != x._cur;
+		}
+
+		template <bool C>
+		bool operator<(const _deque_iterator<T, C> &x) const noexcept {
+			return _node == x._node ? _cur < x._cur : _node < x._node;
+		}
+
+		template <bool C>
+		bool operator>(const _deque_iterator<T, C> &x) const noexcept {
+			return x < *this;
+		}
+
+		template <bool C>
+		bool operator<=(const _deque_iterator<T, C> &x) const noexcept {
+			return !(x < *this);
+		}
+
+		template <bool C>
+		bool operator>=(const _deque_iterator<T, C> &x) const noexcept {
+			return !(*this < x);
+		}
+
+	private:
+		T  *_cur = nullptr;      // 当前元素
+		T  *_first = nullptr;    // 所在块的起始
+		T  *_last = nullptr;     // 所在块的尾后
+		T **_node = nullptr;     // 所在块在 map 中的位置
+
+		_deque_iterator(T *cur, T **node) noexcept : _cur(cur) { _set_node(node); }
+
+		void _set_node(T **node) noexcept {
+			_node = node;
+			_first = *node;
+			_last = _first + BLOCK_SIZE;
+		}
+	};
+
+	/**
+	 * @brief 分块存储的双端队列
+	 *
+	 * @tparam T 元素类型
+	 * @tparam Alloc 配置器类型
+	 */
+	template <typename T, typename Alloc = leestl::allocator<T>>
+	class deque {
+	public:
+		typedef Alloc allocator_type;    // 配置器类型
+		typedef typename leestl::allocator_traits<Alloc>::template rebind_alloc<T> data_allocator;
+
+	private:
+		typedef leestl::allocator_traits<data_allocator>           _alloc_traits;
+		typedef typename _alloc_traits::template rebind_alloc<T *> map_allocator;
+		typedef leestl::allocator_traits<map_allocator>            _map_traits;
+
+	public:
+		typedef T                                       value_type;
+		typedef typename _alloc_traits::size_type       size_type;
+		typedef typename _alloc_traits::difference_type difference_type;
+		typedef T                                      *pointer;
+		typedef const T                                *const_pointer;
+		typedef value_type                             &reference;
+		typedef const value_type                       &const_reference;
+
+		typedef _deque_iterator<T, false>                iterator;
+		typedef _deque_iterator<T, true>                 const_iterator;
+		typedef leestl::reverse_iterator<iterator>       reverse_iterator;
+		typedef leestl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+		static constexpr size_type BLOCK_SIZE = _deque_block_size(sizeof(T));    // 每块的元素个数
+
+		allocator_type get_allocator() const noexcept { return allocator_type(_get_alloc()); }
+
+	private:
+		static_assert(
+		    BLOCK_SIZE * sizeof(T) >= sizeof(T *), "a free block must be able to hold a pointer");
+
+		// 继承配置器以利用空基类优化，无状态配置器不占用额外空间。
+		// map 为空表示尚未分配任何空间；否则 finish._cur 总指向最后一个块内的空位
+		struct _deque_impl : public data_allocator {
+			T       **map = nullptr;      // 中控表
+			size_type map_size = 0;       // 中控表的容量
+			iterator  start;              // 第一个元素
+			iterator  finish;             // 尾后位置
+			T        *spare = nullptr;    // 空闲块链表，下一个块的指针存放在块的起始处
+
+			_deque_impl() noexcept(std::is_nothrow_default_constructible<data_allocator>::value)
+			        : data_allocator() {}
+			_deque_impl(const data_allocator &a) noexcept : data_allocator(a) {}
+			_deque_impl(data_allocator &&a) noexcept : data_allocator(leestl::move(a)) {}
+
+			// 交换数据，不交换配置器
+			void _swap_data(_deque_impl &x) noexcept {
+				leestl::swap(map, x.map);
+				leestl::swap(map_size, x.map_size);
+				leestl::swap(start, x.start);
+				leestl::swap(finish, x.finish);
+				leestl::swap(spare, x.spare);
+			}
+		};
+
+		_deque_impl _impl;
+
+		data_allocator       &_get_alloc() noexcept { return _impl; }
+		const data_allocator &_get_alloc() const noexcept { return _impl; }
+
+	public:
+		/**
+		 * @brief deque 默认构造函数，不分配空间
+		 *
+		 */
+		deque() = default;
+
+		/**
+		 * @brief 指定配置器的 deque 构造函数
+		 *
+		 * @param alloc 配置器
+		 */
+		explicit deque(const allocator_type &alloc) noexcept : _impl(data_allocator(alloc)) {}
+
+		/**
+		 * @brief 给出大小的 deque 构造函数，元素值初始化
+		 *
+		 * @param n deque 的大小
+		 * @param alloc 配置器
+		 */
+		explicit deque(size_type n, const allocator_type &alloc = allocator_type())
+		        : _impl(data_allocator(alloc)) {
+			_initialize_map(_check_init_len(n));
+			try {
+				_default_construct(_impl.start, _impl.finish);
+			} catch (...) {
+				_free_storage();
+				throw;
+			}
+		}
+
+		/**
+		 * @brief 给出大小、初始值的 deque 构造函数
+		 *
+		 * @param n deque 的大小
+		 * @param value 初始值
+		 * @param alloc 配置器
+		 */
+		deque(size_type n, const value_type &value, const allocator_type &alloc = allocator_type())
+		        : _impl(data_allocator(alloc)) {
+			_initialize_map(_check_init_len(n));
+			try {
+				leestl::uninitialized_fill(_impl.start, _impl.finish, value);
+			} catch (...) {
+				_free_storage();
+				throw;
+			}
+		}
+
+		/**
+		 * @brief 通过迭代器区间构造 deque
+		 *
+		 * @tparam _II 迭代器类型
+		 * @param first 区间起始
+		 * @param last 区间终止
+		 * @param alloc 配置器
+		 */
+		template <typename _II, typename = leestl::RequireInputIterator<_II>>
+		deque(_II first, _II last, const allocator_type &alloc = allocator_type())
+		        : _impl(data_allocator(alloc)) {
+			_range_initialize(first, last, leestl::iterator_category_types<_II>());
+		}
+
+		/**
+		 * @brief 通过初始化列表构造 deque
+		 *
+		 * @param il 初始化列表
+		 * @param alloc 配置器
+		 */
+		deque(std::initializer_list<value_type> il, const allocator_type &alloc = allocator_type())
+		        : _impl(data_allocator(alloc)) {
+			_range_initialize(il.begin(), il.end(), leestl::random_acess_interator_tag());
+		}
+
+		/**
+		 * @brief 复制构造函数，配置器由 select_on_container_copy_construction 决定
+		 *
+		 * @param x 要复制的 deque
+		 */
+		deque(const deque &x)
+		        : _impl(_alloc_traits::select_on_container_copy_construction(x._get_alloc())) {
+			_range_initialize(x.begin(), x.end(), leestl::random_acess_interator_tag());
+		}
+
+		/**
+		 * @brief 指定配置器的复制构造函数
+		 *
+		 * @param x 要复制的 deque
+		 * @param alloc 配置器
+		 */
+		deque(const deque &x, const allocator_type &alloc) : _impl(data_allocator(alloc)) {
+			_range_initialize(x.begin(), x.end(), leestl::random_acess_interator_tag());
+		}
+
+		/**
+		 * @brief 移动构造函数，接管 x 的全部块与配置器
+		 */
+		deque(deque &&x) noexcept : _impl(leestl::move(x._get_alloc())) {
+			_impl._swap_data(x._impl);
+		}
+
+		/**
+		 * @brief 指定配置器的移动构造函数，配置器不相等时只能逐个移动元素
+		 *
+		 * @param x 要移动的 deque
+		 * @param alloc 配置器
+		 */
+		deque(deque &&x, const allocator_type &alloc) : _impl(data_allocator(alloc)) {
+			if (_alloc_traits::equal(_get_alloc(), x._get_alloc())) {
+				_impl._swap_data(x._impl);
+			} else if (!x.empty()) {
+				_initialize_map(x.size());
+				try {
+					leestl::uninitialized_move(x.begin(), x.end(), _impl.start);
+				} catch (...) {
+					_free_storage();
+					throw;
+				}
+				x.clear();
+			}
+		}
+
+		~deque() noexcept {
+			_destroy_data(_impl.start, _impl.finish);
+			_free_storage();
+		}
+
+		// 复制赋值，propagate_on_container_copy_assignment 为真时同时复制配置器
+		deque &operator=(const deque &x) {
+			if (this != &x) {
+				if constexpr (_alloc_traits::propagate_on_container_copy_assignment::value) {
+					if (!_alloc_traits::equal(_get_alloc(), x._get_alloc())) {
+						// 旧配置器无法释放新配置器分配的空间，先用旧配置器释放全部空间
+						_destroy_data(_impl.start, _impl.finish);
+						_free_storage();
+					}
+					_get_alloc() = x._get_alloc();
+				}
+				_assign_aux(x.begin(), x.end(), leestl::random_acess_interator_tag());
+			}
+			return *this;
+		}
+
+		// 移动赋值，配置器可传播或相等时直接接管空间，否则逐个移动元素
+		deque &operator=(deque &&x) noexcept(
+		    _alloc_traits::propagate_on_container_move_assignment::value ||
+		    _alloc_traits::is_always_equal::value) {
+			if (this != &x) {
+				if constexpr (_alloc_traits::propagate_on_container_move_assignment::value) {
+					_move_assign(x);
+					_get_alloc() = leestl::move(x._get_alloc());
+				} else if (_alloc_traits::equal(_get_alloc(), x._get_alloc())) {
+					_move_assign(x);
+				} else {
+					deque tmp(leestl::move(x), _get_alloc());    // 用本容器的配置器逐个移动元素
+					_move_assign(tmp);
+				}
+			}
+			return *this;
+		}
+
+		// 初始化列表赋值
+		deque &operator=(std::initializer_list<value_type> il) {
+			_assign_aux(il.begin(), il.end(), leestl::random_acess_interator_tag());
+			return *this;
+		}
+
+		// 以 n 个 value 替换全部元素
+		void assign(size_type n, const value_type &value) {
+			if (n > size()) {
+				leestl::fill(begin(), end(), value);
+				_fill_insert(end(), n - size(), value);
+			} else {
+				_erase_at_end(begin() + difference_type(n));
+				leestl::fill(begin(), end(), value);
+			}
+		}
+
+		// 以区间 [first, last) 替换全部元素
+		template <typename _II, typename = leestl::RequireInputIterator<_II>>
+		void assign(_II first, _II last) {
+			_assign_aux(first, last, leestl::iterator_category_types<_II>());
+		}
+
+		void assign(std::initializer_list<value_type> il) {
+			_assign_aux(il.begin(), il.end(), leestl::random_acess_interator_tag());
+		}
+
+		// 迭代器相关操作
+		iterator               begin() noexcept { return _impl.start; }
+		const_iterator         begin() const noexcept { return _impl.start; }
+		iterator               end() noexcept { return _impl.finish; }
+		const_iterator         end() const noexcept { return _impl.finish; }
+		reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+		const_iterator         cbegin() const noexcept { return begin(); }
+		const_iterator         cend() const noexcept { return end(); }
+		const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+		const_reverse_iterator crend() const noexcept { return rend(); }
+
+		// 容量相关操作
+		bool      empty() const noexcept { return _impl.finish == _impl.start; }
+		size_type size() const noexcept { return size_type(_impl.finish - _impl.start); }
+		size_type max_size() const noexcept { return _alloc_traits::max_size(_get_alloc()); }
+
+		/**
+		 * @brief 改变元素个数，新增的元素值初始化
+		 *
+		 * @param n 新的元素个数
+		 */
+		void resize(size_type n) {
+			const size_type len = size();
+			if (n > len) _default_append(n - len);
+			else if (n < len) _erase_at_end(begin() + difference_type(n));
+		}
+
+		/**
+		 * @brief 改变元素个数，新增的元素复制自 value
+		 *
+		 * @param n 新的元素个数
+		 * @param value 新增元素的初始值
+		 */
+		void resize(size_type n, const value_type &value) {
+			const size_type len = size();
+			if (n > len) _fill_insert(end(), n - len, value);
+			else if (n < len) _erase_at_end(begin() + difference_type(n));
+		}
+
+		// 把空闲块归还配置器，已使用的块与 map 不变
+		void shrink_to_fit() noexcept {
+			while (T *block = _pop_spare()) _deallocate_block(block);
+		}
+
+		// 元素访问相关操作
+		reference operator[](size_type n) noexcept { return _impl.start[difference_type(n)]; }
+		const_reference operator[](size_type n) const noexcept {
+			return _impl.start[difference_type(n)];
+		}
+
+		reference at(size_type n) {
+			_range_check(n);
+			return (*this)[n];
+		}
+		const_reference at(size_type n) const {
+			_range_check(n);
+			return (*this)[n];
+		}
+
+		reference       front() noexcept { return *_impl.start; }
+		const_reference front() const noexcept { return *_impl.start; }
+		reference back() noexcept {
+			iterator tmp = end();
+			return *--tmp;
+		}
+		const_reference back() const noexcept {
+			const_iterator tmp = end();
+			return *--tmp;
+		}
+
+		// 修改容器相关操作
+		void push_back(const value_type &value) { emplace_back(value); }
+		void push_back(value_type &&value) { emplace_back(leestl::move(value)); }
+		void push_front(const value_type &value) { emplace_front(value); }
+		void push_front(value_type &&value) { emplace_front(leestl::move(value)); }
+
+		/**
+		 * @brief 在尾部直接构造元素，最后一个块写满时再挂上一个新块
+		 *
+		 * @param args 构造参数
+		 * @return reference 新元素的引用
+		 */
+		template <typename... Args>
+		reference emplace_back(Args &&...args) {
+			if (_impl.finish._last - _impl.finish._cur > 1) {
+				_alloc_traits::construct(
+				    _get_alloc(), _impl.finish._cur, leestl::forward<Args>(args)...);
+				return *_impl.finish._cur++;
+			}
+			_push_back_aux(leestl::forward<Args>(args)...);
+			return back();
+		}
+
+		/**
+		 * @brief 在头部直接构造元素，第一个块的前部用完时再挂上一个新块
+		 *
+		 * @param args 构造参数
+		 * @return reference 新元素的引用
+		 */
+		template <typename... Args>
+		reference emplace_front(Args &&...args) {
+			if (_impl.start._cur != _impl.start._first) {
+				_alloc_traits::construct(
+				    _get_alloc(), _impl.start._cur - 1, leestl::forward<Args>(args)...);
+				return *--_impl.start._cur;
+			}
+			_push_front_aux(leestl::forward<Args>(args)...);
+			return front();
+		}
+
+		// 删除尾部元素，最后一个块被清空时回收到空闲块链表
+		void pop_back() noexcept {
+			if (_impl.finish._cur != _impl.finish._first) {
+				--_impl.finish._cur;
+			} else {
+				_push_spare(_impl.finish._first);
+				_impl.finish._set_node(_impl.finish._node - 1);
+				_impl.finish._cur = _impl.finish._last - 1;
+			}
+			_alloc_traits::destroy(_get_alloc(), _impl.finish._cur);
+		}
+
+		// 删除头部元素，第一个块被清空时回收到空闲块链表
+		void pop_front() noexcept {
+			_alloc_traits::destroy(_get_alloc(), _impl.start._cur);
+			if (_impl.start._last - _impl.start._cur > 1) {
+				++_impl.start._cur;
+			} else {
+				_push_spare(_impl.start._first);
+				_impl.start._set_node(_impl.start._node + 1);
+				_impl.start._cur = _impl.start._first;
+			}
+		}
+
+		/**
+		 * @brief 在 pos 处直接构造元素，移动 pos 前后元素中较少的一侧
+		 *
+		 * @param pos 插入位置
+		 * @param args 构造参数
+		 * @return iterator 新元素的位置
+		 */
+		template <typename... Args>
+		iterator emplace(const_iterator pos, Args &&...args) {
+			if (pos._cur == _impl.start._cur) {
+				emplace_front(leestl::forward<Args>(args)...);
+				return begin();
+			}
+			if (pos._cur == _impl.finish._cur) {
+				emplace_back(leestl::forward<Args>(args)...);
+				return end() - 1;
+			}
+			return _insert_aux(_mutable(pos), leestl::forward<Args>(args)...);
+		}
+
+		// 插入元素
+		iterator insert(const_iterator pos, const value_type &value) { return emplace(pos, value); }
+		iterator insert(const_iterator pos, value_type &&value) {
+			return emplace(pos, leestl::move(value));
+		}
+
+		// 填充插入
+		iterator insert(const_iterator pos, size_type n, const value_type &value) {
+			const difference_type offset = pos - cbegin();
+			_fill_insert(_mutable(pos), n, value);
+			return begin() + offset;
+		}
+
+		// 范围插入
+		template <typename _II, typename = leestl::RequireInputIterator<_II>>
+		iterator insert(const_iterator pos, _II first, _II last) {
+			const difference_type offset = pos - cbegin();
+			_range_insert(_mutable(pos), first, last, leestl::iterator_category_types<_II>());
+			return begin() + offset;
+		}
+
+		// 初始化列表插入
+		iterator insert(const_iterator pos, std::initializer_list<value_type> il) {
+			return insert(pos, il.begin(), il.end());
+		}
+
+		/**
+		 * @brief 删除 pos 处的元素，移动 pos 前后元素中较少的一侧
+		 *
+		 * @param pos 删除位置
+		 * @return iterator 被删除元素的下一个位置
+		 */
+		iterator erase(const_iterator pos) {
+			iterator        position = _mutable(pos);
+			iterator        next = position;
+			const size_type index = size_type(position - _impl.start);
+			++next;
+			if (index < size() / 2) {
+				if (position != _impl.start) leestl::move_backward(_impl.start, position, next);
+				pop_front();
+			} else {
+				if (next != _impl.finish) leestl::move(next, _impl.finish, position);
+				pop_back();
+			}
+			return _impl.start + difference_type(index);
+		}
+
+		/**
+		 * @brief 删除 [first, last) 中的元素，移动区间前后元素中较少的一侧
+		 *
+		 * @return iterator 被删除区间的下一个位置
+		 */
+		iterator erase(const_iterator first, const_iterator last) {
+			if (first == last) return _mutable(first);
+			if (first == cbegin() && last == cend()) {
+				clear();
+				return end();
+			}
+			const difference_type n = last - first;
+			const difference_type elems_before = first - cbegin();
+			if (size_type(elems_before) < (size() - n) / 2) {
+				if (first != cbegin())
+					leestl::move_backward(begin(), _mutable(first), _mutable(last));
+				_erase_at_begin(begin() + n);
+			} else {
+				if (last != cend()) leestl::move(_mutable(last), end(), _mutable(first));
+				_erase_at_end(end() - n);
+			}
+			return begin() + elems_before;
+		}
+
+		// 交换两个 deque，propagate_on_container_swap 为真时同时交换配置器
+		void swap(deque &x) noexcept {
+			_impl._swap_data(x._impl);
+			if constexpr (_alloc_traits::propagate_on_container_swap::value)
+				leestl::swap(_get_alloc(), x._get_alloc());
+		}
+
+		// 销毁所有元素，只保留第一个块，其余块回收到空闲块链表
+		void clear() noexcept { _erase_at_end(begin()); }
+
+	private:
+		// 构造函数用该方法检查初始化长度是否合法
+		size_type _check_init_len(size_type n) const {
+			if (n > max_size())
+				throw std::length_error("cannot create deque larger than max_size().");
+			return n;
+		}
+
+		void _range_check(size_type n) const {
+			if (n >= size()) throw std::out_of_range("deque::_range_check: n >= size()");
+		}
+
+		iterator _mutable(const_iterator it) const noexcept {
+			return it._node ? iterator(it._cur, it._node) : iterator();
+		}
+
+		// 分配、释放块与中控表
+		T *_allocate_block() {
+			if (T *block = _pop_spare()) return block;
+			return _alloc_traits::allocate(_get_alloc(), BLOCK_SIZE);
+		}
+
+		void _deallocate_block(T *block) noexcept {
+			_alloc_traits::deallocate(_get_alloc(), block, BLOCK_SIZE);
+		}
+
+		// 空闲块链表：块中没有元素，起始处存放下一个空闲块的指针
+		void _push_spare(T *block) noexcept {
+			std::memcpy(static_cast<void *>(block), &_impl.spare, sizeof(T *));
+			_impl.spare = block;
+		}
+
+		T *_pop_spare() noexcept {
+			T *block = _impl.spare;
+			if (block) std::memcpy(&_impl.spare, static_cast<void *>(block), sizeof(T *));
+			return block;
+		}
+
+		// 回收 [first, last) 上的块
+		void _recycle_blocks(T **first, T **last) noexcept {
+			for (; first < last; ++first) _push_spare(*first);
+		}
+
+		T **_allocate_map(size_type n) {
+			map_allocator a(_get_alloc());
+			return _map_traits::allocate(a, n);
+		}
+
+		void _deallocate_map(T **map, size_type n) noexcept {
+			map_allocator a(_get_alloc());
+			_map_traits::deallocate(a, map, n);
+		}
+
+		// 释放全部块与中控表（元素须已销毁），回到未分配空间的状态
+		void _free_storage() noexcept {
+			if (_impl.map) {
+				for (T **node = _impl.start._node; node <= _impl.finish._node; ++node)
+					_deallocate_block(*node);
+				_deallocate_map(_impl.map, _impl.map_size);
+			}
+			shrink_to_fit();
+			_impl.map = nullptr;
+			_impl.map_size = 0;
+			_impl.start = _impl.finish = iterator();
+		}
+
+		// 接管 x 的空间，x 置空
+		void _move_assign(deque &x) noexcept {
+			deque tmp(_get_alloc());
+			_impl._swap_data(x._impl);
+			tmp._impl._swap_data(x._impl);
+		}
+
+		/**
+		 * @brief 分配能容纳 n 个元素的块与中控表，元素从第一个块的起始处开始排列（尚未构造）
+		 *
+		 * @param n 元素个数
+		 */
+		void _initialize_map(size_type n) {
+			const size_type num_nodes = n / BLOCK_SIZE + 1;
+			_impl.map_size = leestl::max(size_type(_DEQUE_INITIAL_MAP_SIZE), num_nodes + 2);
+			_impl.map = _allocate_map(_impl.map_size);
+			T **nstart = _impl.map + (_impl.map_size - num_nodes) / 2;
+			T **cur = nstart;
+			try {
+				for (; cur < nstart + num_nodes; ++cur) *cur = _allocate_block();
+			} catch (...) {
+				while (cur != nstart) _deallocate_block(*--cur);
+				_deallocate_map(_impl.map, _impl.map_size);
+				_impl.map = nullptr;
+				_impl.map_size = 0;
+				throw;
+			}
+			_impl.start._set_node(nstart);
+			_impl.finish._set_node(nstart + num_nodes - 1);
+			_impl.start._cur = _impl.start._first;
+			_impl.finish._cur = _impl.finish._first + n % BLOCK_SIZE;
+		}
+
+		/**
+		 * @brief 确保 map 尾部至少还有 nodes_to_add 个空位
+		 */
+		void _reserve_map_at_back(size_type nodes_to_add = 1) {
+			if (nodes_to_add + 1 > _impl.map_size - size_type(_impl.finish._node - _impl.map))
+				_reallocate_map(nodes_to_add, false);
+		}
+
+		/**
+		 * @brief 确保 map 头部至少还有 nodes_to_add 个空位
+		 */
+		void _reserve_map_at_front(size_type nodes_to_add = 1) {
+			if (nodes_to_add > size_type(_impl.start._node - _impl.map))
+				_reallocate_map(nodes_to_add, true);
+		}
+
+		/**
+		 * @brief map 一侧空位不足时，把已使用的块指针移回中部；总空位也不足时才分配更大的 map
+		 *
+		 * @param nodes_to_add 需要增加的块数
+		 * @param add_at_front 空位留在头部还是尾部
+		 */
+		void _reallocate_map(size_type nodes_to_add, bool add_at_front) {
+			const size_type old_num_nodes = _impl.finish._node - _impl.start._node + 1;
+			const size_type new_num_nodes = old_num_nodes + nodes_to_add;
+			const size_type front_gap = add_at_front ? nodes_to_add : 0;
+			T             **new_nstart;
+			if (_impl.map_size > 2 * new_num_nodes) {
+				new_nstart = _impl.map + (_impl.map_size - new_num_nodes) / 2 + front_gap;
+				std::memmove(new_nstart, _impl.start._node, old_num_nodes * sizeof(T *));
+			} else {
+				const size_type new_map_size =
+				    _impl.map_size + leestl::max(_impl.map_size, nodes_to_add) + 2;
+				T **new_map = _allocate_map(new_map_size);
+				new_nstart = new_map + (new_map_size - new_num_nodes) / 2 + front_gap;
+				std::memcpy(new_nstart, _impl.start._node, old_num_nodes * sizeof(T *));
+				_deallocate_map(_impl.map, _impl.map_size);
+				_impl.map = new_map;
+				_impl.map_size = new_map_size;
+			}
+			_impl.start._set_node(new_nstart);
+			_impl.finish._set_node(new_nstart + old_num_nodes - 1);
+		}
+
+		/**
+		 * @brief 在尾部准备 n 个未构造元素的空间，必要时挂上新块
+		 *
+		 * @return iterator 新的尾后位置，由调用者在构造成功后赋给 finish
+		 */
+		iterator _reserve_elements_at_back(size_type n) {
+			if (_impl.map == nullptr) _initialize_map(0);
+			const size_type vacancies = _impl.finish._last - _impl.finish._cur - 1;
+			if (n > vacancies) {
+				const size_type new_nodes = (n - vacancies + BLOCK_SIZE - 1) / BLOCK_SIZE;
+				_reserve_map_at_back(new_nodes);
+				size_type i = 1;
+				try {
+					for (; i <= new_nodes; ++i) _impl.finish._node[i] = _allocate_block();
+				} catch (...) {
+					_recycle_blocks(_impl.finish._node + 1, _impl.finish._node + i);
+					throw;
+				}
+			}
+			return _impl.finish + difference_type(n);
+		}
+
+		/**
+		 * @brief 在头部准备 n 个未构造元素的空间，必要时挂上新块
+		 *
+		 * @return iterator 新的起始位置，由调用者在构造成功后赋给 start
+		 */
+		iterator _reserve_elements_at_front(size_type n) {
+			if (_impl.map == nullptr) _initialize_map(0);
+			const size_type vacancies = _impl.start._cur - _impl.start._first;
+			if (n > vacancies) {
+				const size_type new_nodes = (n - vacancies + BLOCK_SIZE - 1) / BLOCK_SIZE;
+				_reserve_map_at_front(new_nodes);
+				size_type i = 1;
+				try {
+					for (; i <= new_nodes; ++i) *(_impl.start._node - i) = _allocate_block();
+				} catch (...) {
+					_recycle_blocks(_impl.start._node - (i - 1), _impl.start._node);
+					throw;
+				}
+			}
+			return _impl.start - difference_type(n);
+		}
+
+		// 最后一个块只剩尾后位置时：先在新块到位后构造元素，再移动 finish
+		template <typename... Args>
+		void _push_back_aux(Args &&...args) {
+			if (_impl.map == nullptr) {
+				_initialize_map(0);
+				if (BLOCK_SIZE > 1) {
+					_alloc_traits::construct(
+					    _get_alloc(), _impl.finish._cur, leestl::forward<Args>(args)...);
+					++_impl.finish._cur;
+					return;
+				}
+			}
+			_reserve_map_at_back();
+			_impl.finish._node[1] = _allocate_block();
+			try {
+				_alloc_traits::construct(
+				    _get_alloc(), _impl.finish._cur, leestl::forward<Args>(args)...);
+			} catch (...) {
+				_push_spare(_impl.finish._node[1]);
+				throw;
+			}
+			_impl.finish._set_node(_impl.finish._node + 1);
+			_impl.finish._cur = _impl.finish._first;
+		}
+
+		// 第一个块的前部用完时：在前面挂上新块，并在其末尾构造元素
+		template <typename... Args>
+		void _push_front_aux(Args &&...args) {
+			if (_impl.map == nullptr) {
+				// 空容器在头部插入，元素从块的末尾向前排列
+				_initialize_map(0);
+				_impl.start._cur = _impl.finish._cur = _impl.start._last - 1;
+				if (BLOCK_SIZE > 1) {
+					_alloc_traits::construct(
+					    _get_alloc(), _impl.start._cur - 1, leestl::forward<Args>(args)...);
+					--_impl.start._cur;
+					return;
+				}
+			}
+			_reserve_map_at_front();
+			*(_impl.start._node - 1) = _allocate_block();
+			try {
+				_alloc_traits::construct(
+				    _get_alloc(), *(_impl.start._node - 1) + (BLOCK_SIZE - 1),
+				    leestl::forward<Args>(args)...);
+			} catch (...) {
+				_push_spare(*(_impl.start._node - 1));
+				throw;
+			}
+			_impl.start._set_node(_impl.start._node - 1);
+			_impl.start._cur = _impl.start._last - 1;
+		}
+
+		// 逐块销毁 [first, last) 上的元素
+		void _destroy_data(iterator first, iterator last) noexcept {
+			if constexpr (!std::is_trivially_destructible<T>::value) {
+				if (first == last) return;
+				for (T **node = first._node + 1; node < last._node; ++node)
+					leestl::destory(*node, *node + BLOCK_SIZE);
+				if (first._node != last._node) {
+					leestl::destory(first._cur, first._last);
+					leestl::destory(last._first, last._cur);
+				} else {
+					leestl::destory(first._cur, last._cur);
+				}
+			}
+		}
+
+		// 删除 pos 之前的元素，清空的块回收
+		void _erase_at_begin(iterator pos) noexcept {
+			_destroy_data(_impl.start, pos);
+			_recycle_blocks(_impl.start._node, pos._node);
+			_impl.start = pos;
+		}
+
+		// 删除 pos 及之后的元素，清空的块回收
+		void _erase_at_end(iterator pos) noexcept {
+			if (pos == _impl.finish) return;
+			_destroy_data(pos, _impl.finish);
+			_recycle_blocks(pos._node + 1, _impl.finish._node + 1);
+			_impl.finish = pos;
+		}
+
+		// 在未初始化的 [first, last) 上值初始化元素
+		void _default_construct(iterator first, iterator last) {
+			iterator cur = first;
+			try {
+				for (; cur != last; ++cur) _alloc_traits::construct(_get_alloc(), cur._cur);
+			} catch (...) {
+				_destroy_data(first, cur);
+				throw;
+			}
+		}
+
+		// 在尾部追加 n 个值初始化的元素
+		void _default_append(size_type n) {
+			iterator new_finish = _reserve_elements_at_back(n);
+			try {
+				_default_construct(_impl.finish, new_finish);
+			} catch (...) {
+				_recycle_blocks(_impl.finish._node + 1, new_finish._node + 1);
+				throw;
+			}
+			_impl.finish = new_finish;
+		}
+
+		// 适用于输入迭代器的范围初始化
+		template <typename _II>
+		void _range_initialize(_II first, _II last, leestl::input_interator_tag) {
+			try {
+				for (; first != last; ++first) emplace_back(*first);
+			} catch (...) {
+				_destroy_data(_impl.start, _impl.finish);
+				_free_storage();
+				throw;
+			}
+		}
+
+		// 适用于前向迭代器的范围初始化：逐块复制，源为指针时每块整段复制
+		template <typename _FI>
+		void _range_initialize(_FI first, _FI last, leestl::forward_interator_tag) {
+			_initialize_map(_check_init_len(leestl::distance(first, last)));
+			T **node = _impl.start._node;
+			try {
+				for (; node < _impl.finish._node; ++node) {
+					_FI mid = first;
+					leestl::advance(mid, BLOCK_SIZE);
+					leestl::uninitialized_copy(first, mid, *node);
+					first = mid;
+				}
+				leestl::uninitialized_copy(first, last, _impl.finish._first);
+			} catch (...) {
+				_destroy_data(_impl.start, iterator(*node, node));
+				_free_storage();
+				throw;
+			}
+		}
+
+		// 适用于输入迭代器的赋值
+		template <typename _II>
+		void _assign_aux(_II first, _II last, leestl::input_interator_tag) {
+			iterator cur = begin();
+			for (; first != last && cur != end(); ++cur, (void)++first) *cur = *first;
+			if (first == last) _erase_at_end(cur);
+			else _range_insert(end(), first, last, leestl::iterator_category_types<_II>());
+		}
+
+		// 适用于前向迭代器的赋值
+		template <typename _FI>
+		void _assign_aux(_FI first, _FI last, leestl::forward_interator_tag) {
+			const size_type len = leestl::distance(first, last);
+			if (len > size()) {
+				_FI mid = first;
+				leestl::advance(mid, size());
+				leestl::copy(first, mid, begin());
+				_range_insert(end(), mid, last, leestl::forward_interator_tag());
+			} else {
+				_erase_at_end(leestl::copy(first, last, begin()));
+			}
+		}
+
+		// 在中间插入一个元素
+		template <typename... Args>
+		iterator _insert_aux(iterator pos, Args &&...args) {
+			value_type            x_copy(leestl::forward<Args>(args)...);    // args 可能引用容器内元素
+			const difference_type index = pos - _impl.start;
+			if (size_type(index) < size() / 2) {
+				// 头部元素前移一位：复制出新的头部元素，再移动 [1, index)
+				emplace_front(leestl::move(front()));
+				iterator front1 = _impl.start;
+				++front1;
+				iterator front2 = front1;
+				++front2;
+				pos = _impl.start + index;
+				iterator pos1 = pos;
+				++pos1;
+				leestl::move(front2, pos1, front1);
+			} else {
+				emplace_back(leestl::move(back()));
+				iterator back1 = _impl.finish;
+				--back1;
+				iterator back2 = back1;
+				--back2;
+				pos = _impl.start + index;
+				leestl::move_backward(pos, back2, back1);
+			}
+			*pos = leestl::move(x_copy);
+			return pos;
+		}
+
+		// 填充插入：在两端时直接构造，否则移动较少的一侧腾出 n 个位置
+		void _fill_insert(iterator pos, size_type n, const value_type &value) {
+			if (n == 0) return;
+			if (pos._cur == _impl.start._cur) {
+				iterator new_start = _reserve_elements_at_front(n);
+				try {
+					leestl::uninitialized_fill(new_start, _impl.start, value);
+				} catch (...) {
+					_recycle_blocks(new_start._node, _impl.start._node);
+					throw;
+				}
+				_impl.start = new_start;
+			} else if (pos._cur == _impl.finish._cur) {
+				iterator new_finish = _reserve_elements_at_back(n);
+				try {
+					leestl::uninitialized_fill(_impl.finish, new_finish, value);
+				} catch (...) {
+					_recycle_blocks(_impl.finish._node + 1, new_finish._node + 1);
+					throw;
+				}
+				_impl.finish = new_finish;
+			} else {
+				_fill_insert_aux(pos, n, value);
+			}
+		}
+
+		void _fill_insert_aux(iterator pos, size_type n, const value_type &value) {
+			const difference_type elems_before = pos - _impl.start;
+			const difference_type len = difference_type(size());
+			const difference_type dn = difference_type(n);
+			value_type            x_copy = value;
+			if (elems_before < len / 2) {
+				iterator new_start = _reserve_elements_at_front(n);
+				iterator old_start = _impl.start;
+				pos = _impl.start + elems_before;
+				try {
+					if (elems_before >= dn) {
+						iterator start_n = _impl.start + dn;
+						leestl::uninitialized_move(_impl.start, start_n, new_start);
+						_impl.start = new_start;
+						leestl::move(start_n, pos, old_start);
+						leestl::fill(pos - dn, pos, x_copy);
+					} else {
+						iterator mid = leestl::uninitialized_move(_impl.start, pos, new_start);
+						try {
+							leestl::uninitialized_fill(mid, _impl.start, x_copy);
+						} catch (...) {
+							_destroy_data(new_start, mid);
+							throw;
+						}
+						_impl.start = new_start;
+						leestl::fill(old_start, pos, x_copy);
+					}
+				} catch (...) {
+					_recycle_blocks(new_start._node, _impl.start._node);
+					throw;
+				}
+			} else {
+				iterator              new_finish = _reserve_elements_at_back(n);
+				iterator              old_finish = _impl.finish;
+				const difference_type elems_after = len - elems_before;
+				pos = _impl.finish - elems_after;
+				try {
+					if (elems_after > dn) {
+						iterator finish_n = _impl.finish - dn;
+						leestl::uninitialized_move(finish_n, _impl.finish, _impl.finish);
+						_impl.finish = new_finish;
+						leestl::move_backward(pos, finish_n, old_finish);
+						leestl::fill(pos, pos + dn, x_copy);
+					} else {
+						iterator mid = _impl.finish + (dn - elems_after);
+						leestl::uninitialized_fill(_impl.finish, mid, x_copy);
+						try {
+							leestl::uninitialized_move(pos, _impl.finish, mid);
+						} catch (...) {
+							_destroy_data(_impl.finish, mid);
+							throw;
+						}
+						_impl.finish = new_finish;
+						leestl::fill(pos, old_finish, x_copy);
+					}
+				} catch (...) {
+					_recycle_blocks(_impl.finish._node + 1, new_finish._node + 1);
+					throw;
+				}
+			}
+		}
+
+		// 适用于输入迭代器的范围插入
+		template <typename _II>
+		void _range_insert(iterator pos, _II first, _II last, leestl::input_interator_tag) {
+			if (pos == end()) {
+				for (; first != last; ++first) emplace_back(*first);
+			} else if (first != last) {
+				deque tmp(first, last, get_allocator());
+				_range_insert(pos, tmp.begin(), tmp.end(), leestl::random_acess_interator_tag());
+			}
+		}
+
+		// 适用于前向迭代器的范围插入
+		template <typename _FI>
+		void _range_insert(iterator pos, _FI first, _FI last, leestl::forward_interator_tag) {
+			const size_type n = leestl::distance(first, last);
+			if (n == 0) return;
+			if (pos._cur == _impl.start._cur) {
+				iterator new_start = _reserve_elements_at_front(n);
+				try {
+					leestl::uninitialized_copy(first, last, new_start);
+				} catch (...) {
+					_recycle_blocks(new_start._node, _impl.start._node);
+					throw;
+				}
+				_impl.start = new_start;
+			} else if (pos._cur == _impl.finish._cur) {
+				iterator new_finish = _reserve_elements_at_back(n);
+				try {
+					leestl::uninitialized_copy(first, last, _impl.finish);
+				} catch (...) {
+					_recycle_blocks(_impl.finish._node + 1, new_finish._node + 1);
+					throw;
+				}
+				_impl.finish = new_finish;
+			} else {
+				_range_insert_aux(pos, first, last, n);
+			}
+		}
+
+		template <typename _FI>
+		void _range_insert_aux(iterator pos, _FI first, _FI last, size_type n) {
+			const difference_type elems_before = pos - _impl.start;
+			const difference_type len = difference_type(size());
+			const difference_type dn = difference_type(n);
+			if (elems_before < len / 2) {
+				iterator new_start = _reserve_elements_at_front(n);
+				iterator old_start = _impl.start;
+				pos = _impl.start + elems_before;
+				try {
+					if (elems_before >= dn) {
+						iterator start_n = _impl.start + dn;
+						leestl::uninitialized_move(_impl.start, start_n, new_start);
+						_impl.start = new_start;
+						leestl::move(start_n, pos, old_start);
+						leestl::copy(first, last, pos - dn);
+					} else {
+						_FI mid = first;
+						leestl::advance(mid, dn - elems_before);
+						iterator dmid = leestl::uninitialized_move(_impl.start, pos, new_start);
+						try {
+							leestl::uninitialized_copy(first, mid, dmid);
+						} catch (...) {
+							_destroy_data(new_start, dmid);
+							throw;
+						}
+						_impl.start = new_start;
+						leestl::copy(mid, last, old_start);
+					}
+				} catch (...) {
+					_recycle_blocks(new_start._node, _impl.start._node);
+					throw;
+				}
+			} else {
+				iterator              new_finish = _reserve_elements_at_back(n);
+				iterator              old_finish = _impl.finish;
+				const difference_type elems_after = len - elems_before;
+				pos = _impl.finish - elems_after;
+				try {
+					if (elems_after > dn) {
+						iterator finish_n = _impl.finish - dn;
+						leestl::uninitialized_move(finish_n, _impl.finish, _impl.finish);
+						_impl.finish = new_finish;
+						leestl::move_backward(pos, finish_n, old_finish);
+						leestl::copy(first, last, pos);
+					} else {
+						_FI mid = first;
+						leestl::advance(mid, elems_after);
+						iterator dmid = leestl::uninitialized_copy(mid, last, _impl.finish);
+						try {
+							leestl::uninitialized_move(pos, _impl.finish, dmid);
+						} catch (...) {
+							_destroy_data(_impl.finish, dmid);
+							throw;
+						}
+						_impl.finish = new_finish;
+						leestl::copy(first, mid, pos);
+					}
+				} catch (...) {
+					_recycle_blocks(_impl.finish._node + 1, new_finish._node + 1);
+					throw;
+				}
+			}
+		}
+	};
+
+	template <typename T, typename Alloc>
+	inline bool operator==(const deque<T, Alloc> &x, const deque<T, Alloc> &y) {
+		return x.size() == y.size() && leestl::equal(x.begin(), x.end(), y.begin());
+	}
+
+	template <typename T, typename Alloc>
+	inline bool operator!=(const deque<T, Alloc> &x, const deque<T, Alloc> &y) {
+		return !(x == y);
+	}
+
+	template <typename T, typename Alloc>
+	inline bool operator<(const deque<T, Alloc> &x, const deque<T, Alloc> &y) {
+		return leestl::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+	}
+
+	template <typename T, typename Alloc>
+	inline void swap(deque<T, Alloc> &x, deque<T, Alloc> &y) noexcept {
+		x.swap(y);
+	}
+
+}    // namespace leestl
+
+#endif
@@ -0,0 +1,517 @@
+/** @file dynamic_bitset.h
+ * 	这个文件实现长度可变的位数组 dynamic_bitset 与在其上做 rank/select 查询的 bitset_rank_index
+ *
+ * 	位 i 存放在第 i / 64 个 64 位字的第 i % 64 位，最后一个字中超出 size() 的位始终为 0，
+ * 	因此整体运算可以直接按字处理而不必单独处理尾部。与、或、异或、差集与计数交给 simd.h
+ * 	中按指令集分派的字数组内核；查找先用向量比较跳过全为 0 的字，再对第一个非零字取末尾零
+ * 	的个数（tzcnt）得到位置。
+ *
+ * 	bitset_rank_index 为每 512 位（一条缓存行）记录此前 1 的个数，rank 是一次表查找加至多
+ * 	8 个字的计数；select 先由每隔 4096 个 1 的采样缩小范围，再二分查找所在的 512 位块，
+ * 	最后在字内用 pdep 与 tzcnt 定位。
+ */
+
+#ifndef _LEESTL_DYNAMIC_BITSET_H_
+#define _LEESTL_DYNAMIC_BITSET_H_ 1
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "allocator.h"
+#include "simd.h"
+#include "vector.h"
+
+namespace leestl {
+
+	/**
+	 * @brief 按 64 位字存放的长度可变的位数组
+	 *
+	 * @tparam Alloc 字的配置器类型
+	 */
+	template <typename Alloc = leestl::allocator<uint64_t>>
+	class dynamic_bitset {
+	public:
+		typedef uint64_t block_type;        // 存放位的字
+		typedef Alloc    allocator_type;    // 配置器类型
+		typedef size_t   size_type;
+
+		static constexpr size_type bits_per_block = 64;
+		static constexpr size_type npos = size_type(-1);    // 查找失败时的返回值
+
+		/**
+		 * @brief 单个位的代理引用
+		 *
+		 */
+		class reference {
+			friend class dynamic_bitset;
+
+		public:
+			operator bool() const noexcept { return (*_word & _mask) != 0; }
+			bool operator~() const noexcept { return (*_word & _mask) == 0; }
+
+			reference &operator=(bool value) noexcept {
+				if (value) *_word |= _mask;
+				else *_word &= ~_mask;
+				return *this;
+			}
+
+			reference &operator=(const reference &x) noexcept { return *this = bool(x); }
+
+			reference &flip() noexcept {
+				*_word ^= _mask;
+				return *this;
+			}
+
+		private:
+			block_type *_word;
+			block_type  _mask;
+
+			reference(block_type *word, block_type mask) noexcept : _word(word), _mask(mask) {}
+		};
+
+	private:
+		leestl::vector<block_type, Alloc> _words;
+		size_type                         _size = 0;    // 位数
+
+	public:
+		/**
+		 * @brief dynamic_bitset 默认构造函数，不分配空间
+		 *
+		 */
+		dynamic_bitset() = default;
+
+		/**
+		 * @brief 指定配置器的 dynamic_bitset 构造函数
+		 *
+		 * @param alloc 配置器
+		 */
+		explicit dynamic_bitset(const allocator_type &alloc) noexcept : _words(alloc) {}
+
+		/**
+		 * @brief 构造 n 个位，全部为 value
+		 *
+		 * @param n 位数
+		 * @param value 每一位的值
+		 * @param alloc 配置器
+		 */
+		explicit dynamic_bitset(
+		    size_type n, bool value = false, const allocator_type &alloc = allocator_type())
+		        : _words(_blocks_for(n), value ? ~block_type(0) : block_type(0), alloc),
+		          _size(n) {
+			_clear_unused();
+		}
+
+		/**
+		 * @brief 由 '0'、'1' 组成的字符串构造，与 std::bitset 相同，字符串的最后一个字符为位 0
+		 *
+		 * @param s 字符串，含有其他字符时抛出 std::invalid_argument
+		 * @param alloc 配置器
+		 */
+		explicit dynamic_bitset(
+		    const std::string &s, const allocator_type &alloc = allocator_type())
+		        : dynamic_bitset(s.size(), false, alloc) {
+			for (size_type i = 0; i < _size; ++i) {
+				const char c = s[_size - 1 - i];
+				if (c != '0' && c != '1')
+					throw std::invalid_argument("dynamic_bitset: string contains not 0 or 1.");
+				if (c == '1') _word(i) |= _bit(i);
+			}
+		}
+
+		allocator_type get_allocator() const noexcept { return _words.get_allocator(); }
+
+		// 容量相关操作
+		bool      empty() const noexcept { return _size == 0; }
+		size_type size() const noexcept { return _size; }
+		size_type num_blocks() const noexcept { return _words.size(); }
+		size_type capacity() const noexcept { return _words.capacity() * bits_per_block; }
+		// 最大位数：字数上限乘以每字位数，溢出时截断，并保证 npos 不会是合法位置
+		size_type max_size() const noexcept {
+			const size_type words = _words.max_size();
+			return words < (npos - 1) / bits_per_block ? words * bits_per_block : npos - 1;
+		}
+
+		void reserve(size_type n) { _words.reserve(_blocks_for(n)); }
+		void shrink_to_fit() { _words.shrink_to_fit(); }
+
+		/**
+		 * @brief 改变位数，新增的位为 value
+		 *
+		 * @param n 新的位数
+		 * @param value 新增位的值
+		 */
+		void resize(size_type n, bool value = false) {
+			if (value && n > _size && _size % bits_per_block)
+				_words.back() |= ~block_type(0) << (_size % bits_per_block);
+			_words.resize(_blocks_for(n), value ? ~block_type(0) : block_type(0));
+			_size = n;
+			_clear_unused();
+		}
+
+		void push_back(bool value) {
+			if (_size % bits_per_block == 0) _words.push_back(block_type(0));
+			if (value) _words.back() |= _bit(_size);
+			++_size;
+		}
+
+		void pop_back() noexcept {
+			--_size;
+			if (_size % bits_per_block == 0) _words.pop_back();
+			else _words.back() &= ~_bit(_size);
+		}
+
+		void clear() noexcept {
+			_words.clear();
+			_size = 0;
+		}
+
+		void swap(dynamic_bitset &x) noexcept {
+			_words.swap(x._words);
+			leestl::swap(_size, x._size);
+		}
+
+		// 字数组，供按字处理的调用者直接使用；修改时最后一个字超出 size() 的位必须保持为 0
+		block_type       *data() noexcept { return _words.data(); }
+		const block_type *data() const noexcept { return _words.data(); }
+
+		// 位访问相关操作
+		bool operator[](size_type i) const noexcept { return (_word(i) & _bit(i)) != 0; }
+		reference operator[](size_type i) noexcept { return reference(&_word(i), _bit(i)); }
+
+		// 带下标检查的读取，越界时抛出 std::out_of_range
+		bool test(size_type i) const {
+			_range_check(i);
+			return (*this)[i];
+		}
+
+		// 全部位置 1
+		dynamic_bitset &set() noexcept {
+			leestl::fill(_words.begin(), _words.end(), ~block_type(0));
+			_clear_unused();
+			return *this;
+		}
+
+		dynamic_bitset &set(size_type i, bool value = true) {
+			_range_check(i);
+			(*this)[i] = value;
+			return *this;
+		}
+
+		/**
+		 * @brief 把 [pos, pos + len) 中的位都设为 value，首尾两个字按掩码修改，中间的字整字填充
+		 *
+		 * @param pos 起始位置
+		 * @param len 位数
+		 * @param value 值
+		 */
+		dynamic_bitset &set(size_type pos, size_type len, bool value) {
+			if (pos > _size || len > _size - pos)
+				throw std::out_of_range("dynamic_bitset::set: range exceeds size()");
+			if (len == 0) return *this;
+			const size_type  end = pos + len - 1;    // 最后一位
+			const size_type  first = pos / bits_per_block, last = end / bits_per_block;
+			const block_type head = ~block_type(0) << (pos % bits_per_block);
+			const block_type tail = ~block_type(0) >> (bits_per_block - 1 - end % bits_per_block);
+			if (first == last) {
+				_apply_mask(first, head & tail, value);
+			} else {
+				_apply_mask(first, head, value);
+				leestl::fill(
+				    _words.begin() + first + 1, _words.begin() + last,
+				    value ? ~block_type(0) : block_type(0));
+				_apply_mask(last, tail, value);
+			}
+			return *this;
+		}
+
+		// 全部位置 0
+		dynamic_bitset &reset() noexcept {
+			leestl::fill(_words.begin(), _words.end(), block_type(0));
+			return *this;
+		}
+
+		dynamic_bitset &reset(size_type i) { return set(i, false); }
+		dynamic_bitset &reset(size_type pos, size_type len) { return set(pos, len, false); }
+
+		// 全部位取反
+		dynamic_bitset &flip() noexcept {
+			for (block_type &w : _words) w = ~w;
+			_clear_unused();
+			return *this;
+		}
+
+		dynamic_bitset &flip(size_type i) {
+			_range_check(i);
+			_word(i) ^= _bit(i);
+			return *this;
+		}
+
+		// 计数与判断
+		size_type count() const noexcept {
+			return leestl::simd::popcount_words(_words.data(), _words.size());
+		}
+
+		bool any() const noexcept {
+			return leestl::simd::find_nonzero_word(_words.data(), _words.size()) != _words.size();
+		}
+
+		bool none() const noexcept { return !any(); }
+
+		bool all() const noexcept {
+			const size_type full = _size / bits_per_block;
+			for (size_type k = 0; k < full; ++k)
+				if (_words[k] != ~block_type(0)) return false;
+			return _size % bits_per_block == 0 || _words.back() == _bit(_size) - 1;
+		}
+
+		// 整体运算，两个位数组的位数必须相同，否则抛出 std::invalid_argument
+		dynamic_bitset &operator&=(const dynamic_bitset &x) {
+			return _combine(x, leestl::simd::BIT_AND);
+		}
+		dynamic_bitset &operator|=(const dynamic_bitset &x) {
+			return _combine(x, leestl::simd::BIT_OR);
+		}
+		dynamic_bitset &operator^=(const dynamic_bitset &x) {
+			return _combine(x, leestl::simd::BIT_XOR);
+		}
+		// 差集：清除 x 中为 1 的位，即 *this & ~x
+		dynamic_bitset &operator-=(const dynamic_bitset &x) {
+			return _combine(x, leestl::simd::BIT_ANDNOT);
+		}
+
+		dynamic_bitset operator~() const {
+			dynamic_bitset tmp(*this);
+			return tmp.flip();
+		}
+
+		/**
+		 * @brief 第一个为 1 的位
+		 *
+		 * @return size_type 位置，全为 0 时为 npos
+		 */
+		size_type find_first() const noexcept { return _find_from_block(0); }
+
+		/**
+		 * @brief pos 之后第一个为 1 的位
+		 *
+		 * @param pos 起始位置（不含）
+		 * @return size_type 位置，不存在时为 npos
+		 */
+		size_type find_next(size_type pos) const noexcept {
+			if (pos >= _size || ++pos == _size) return npos;
+			const size_type  k = pos / bits_per_block;
+			const block_type w = _words[k] & (~block_type(0) << (pos % bits_per_block));
+			if (w) return k * bits_per_block + size_type(__builtin_ctzll(w));
+			return _find_from_block(k + 1);
+		}
+
+		/**
+		 * @brief 按从小到大的顺序对每个为 1 的位调用 f，逐字取末尾零个数后清除最低位的 1
+		 *
+		 * @param f 参数为位置的函数
+		 */
+		template <typename F>
+		void for_each_set(F f) const {
+			const size_type n = _words.size();
+			for (size_type k = 0; k < n; ++k)
+				for (block_type w = _words[k]; w; w &= w - 1)
+					f(k * bits_per_block + size_type(__builtin_ctzll(w)));
+		}
+
+		// 转换为字符串，与 std::bitset 相同，位 0 在最后
+		std::string to_string() const {
+			std::string s(_size, '0');
+			for_each_set([&](size_type i) { s[_size - 1 - i] = '1'; });
+			return s;
+		}
+
+		friend bool operator==(const dynamic_bitset &x, const dynamic_bitset &y) {
+			return x._size == y._size &&
+			       leestl::equal(x._words.begin(), x._words.end(), y._words.begin());
+		}
+
+		friend bool operator!=(const dynamic_bitset &x, const dynamic_bitset &y) {
+			return !(x == y);
+		}
+
+	private:
+		static size_type _blocks_for(size_type n) noexcept {
+			return n / bits_per_block + (n % bits_per_block != 0);
+		}
+
+		static block_type _bit(size_type i) noexcept {
+			return block_type(1) << (i % bits_per_block);
+		}
+
+		block_type       &_word(size_type i) noexcept { return _words[i / bits_per_block]; }
+		const block_type &_word(size_type i) const noexcept { return _words[i / bits_per_block]; }
+
+		void _range_check(size_type i) const {
+			if (i >= _size) throw std::out_of_range("dynamic_bitset::_range_check: i >= size()");
+		}
+
+		// 把最后一个字中超出 size() 的位清零
+		void _clear_unused() noexcept {
+			if (_size % bits_per_block) _words.back() &= _bit(_size) - 1;
+		}
+
+		void _apply_mask(size_type k, block_type mask, bool value) noexcept {
+			if (value) _words[k] |= mask;
+			else _words[k] &= ~mask;
+		}
+
+		dynamic_bitset &_combine(const dynamic_bitset &x, leestl::simd::bit_op op) {
+			if (_size != x._size)
+				throw std::invalid_argument("dynamic_bitset: operands have different sizes.");
+			leestl::simd::bitwise_words(_words.data(), x._words.data(), _words.size(), op);
+			return *this;
+		}
+
+		// 从第 k 个字开始第一个为 1 的位。先直接检查随后的几个字，
+		// 较密的位数组不必进入跳过全零字的向量内核
+		size_type _find_from_block(size_type k) const noexcept {
+			const size_type n = _words.size();
+			for (const size_type end = leestl::min(n, k + 4); k < end; ++k)
+				if (_words[k]) return k * bits_per_block + size_type(__builtin_ctzll(_words[k]));
+			if (k >= n) return npos;
+			k += leestl::simd::find_nonzero_word(_words.data() + k, n - k);
+			if (k == n) return npos;
+			return k * bits_per_block + size_type(__builtin_ctzll(_words[k]));
+		}
+	};
+
+	template <typename Alloc>
+	inline dynamic_bitset<Alloc> operator&(
+	    const dynamic_bitset<Alloc> &x, const dynamic_bitset<Alloc> &y) {
+		dynamic_bitset<Alloc> tmp(x);
+		return tmp &= y;
+	}
+
+	template <typename Alloc>
+	inline dynamic_bitset<Alloc> operator|(
+	    const dynamic_bitset<Alloc> &x, const dynamic_bitset<Alloc> &y) {
+		dynamic_bitset<Alloc> tmp(x);
+		return tmp |= y;
+	}
+
+	template <typename Alloc>
+	inline dynamic_bitset<Alloc> operator^(
+	    const dynamic_bitset<Alloc> &x, const dynamic_bitset<Alloc> &y) {
+		dynamic_bitset<Alloc> tmp(x);
+		return tmp ^= y;
+	}
+
+	template <typename Alloc>
+	inline dynamic_bitset<Alloc> operator-(
+	    const dynamic_bitset<Alloc> &x, const dynamic_bitset<Alloc> &y) {
+		dynamic_bitset<Alloc> tmp(x);
+		return tmp -= y;
+	}
+
+	template <typename Alloc>
+	inline void swap(dynamic_bitset<Alloc> &x, dynamic_bitset<Alloc> &y) noexcept {
+		x.swap(y);
+	}
+
+	/**
+	 * @brief dynamic_bitset 上的 rank/select 索引，构造后只读
+	 *
+	 * 	索引引用位数组的字，位数组被修改或重新分配后必须重新构造索引
+	 *
+	 * @tparam Alloc 计数表的配置器类型
+	 */
+	template <typename Alloc = leestl::allocator<uint64_t>>
+	class bitset_rank_index {
+	public:
+		typedef size_t size_type;
+
+		static constexpr size_type npos = size_type(-1);    // select 失败时的返回值
+
+	private:
+		enum { _BLOCK_WORDS = 8 };       // 每个计数块的字数，512 位恰好一条缓存行
+		enum { _SAMPLE_RATE = 4096 };    // select 采样间隔（1 的个数）
+
+		const uint64_t *_words = nullptr;
+		size_type       _size = 0;    // 位数
+		size_type       _ones = 0;    // 1 的个数
+
+		leestl::vector<uint64_t, Alloc> _ranks;      // _ranks[b] 为第 b 块之前 1 的个数，末尾为总数
+		leestl::vector<uint64_t, Alloc> _samples;    // _samples[j] 为第 j * _SAMPLE_RATE 个 1 所在的块
+
+	public:
+		bitset_rank_index() = default;
+
+		/**
+		 * @brief 为 bits 构造索引，用时与位数成正比
+		 *
+		 * @param bits 位数组，索引使用期间不能修改
+		 * @param alloc 配置器
+		 */
+		template <typename A>
+		explicit bitset_rank_index(const dynamic_bitset<A> &bits, const Alloc &alloc = Alloc())
+		        : _words(bits.data()), _size(bits.size()), _ranks(alloc), _samples(alloc) {
+			const size_type n = bits.num_blocks();
+			const size_type blocks = n / _BLOCK_WORDS + 1;
+			_ranks.reserve(blocks + 1);
+			_ranks.push_back(0);
+			for (size_type b = 0; b < blocks; ++b) {
+				const size_type first = b * _BLOCK_WORDS;
+				const size_type len = leestl::min(size_type(_BLOCK_WORDS), n - first);
+				const uint64_t  before = _ranks.back();
+				_ranks.push_back(before + leestl::simd::popcount_words(_words + first, len));
+				for (uint64_t j = _samples.size(); j * _SAMPLE_RATE < _ranks.back(); ++j)
+					_samples.push_back(b);
+			}
+			_ones = size_type(_ranks.back());
+		}
+
+		size_type size() const noexcept { return _size; }
+		size_type ones() const noexcept { return _ones; }
+
+		/**
+		 * @brief [0, i) 中 1 的个数
+		 *
+		 * @param i 位置，不超过 size()
+		 * @return size_type 1 的个数
+		 */
+		size_type rank(size_type i) const noexcept {
+			const size_type word = i / 64;
+			const size_type b = word / _BLOCK_WORDS;
+			size_type       r = size_type(_ranks[b]);
+			for (size_type k = b * _BLOCK_WORDS; k < word; ++k)
+				r += leestl::simd::popcount64(_words[k]);
+			if (i % 64) r += leestl::simd::popcount64(_words[word] << (64 - i % 64));
+			return r;
+		}
+
+		/**
+		 * @brief 第 k 个（从 0 开始）为 1 的位的位置
+		 *
+		 * @param k 序号
+		 * @return size_type 位置，k 不小于 ones() 时为 npos
+		 */
+		size_type select(size_type k) const noexcept {
+			if (k >= _ones) return npos;
+			// 第 k 个 1 所在的块 b 满足 _ranks[b] <= k < _ranks[b + 1]，在两个采样之间二分查找
+			const size_type j = k / _SAMPLE_RATE;
+			size_type       lo = size_type(_samples[j]);
+			size_type       hi = j + 1 < _samples.size() ? size_type(_samples[j + 1]) + 1
+			                                             : _ranks.size() - 1;
+			while (hi - lo > 1) {
+				const size_type mid = lo + (hi - lo) / 2;
+				if (_ranks[mid] <= k) lo = mid;
+				else hi = mid;
+			}
+			size_type r = k - size_type(_ranks[lo]);
+			for (size_type w = lo * _BLOCK_WORDS;; ++w) {
+				const size_type c = leestl::simd::popcount64(_words[w]);
+				if (r < c) return w * 64 + leestl::simd::select_in_word(_words[w], unsigned(r));
+				r -= c;
+			}
+		}
+	};
+
+}    // namespace leestl
+
+#endif
@@ -0,0 +1,270 @@
+/** @file execution.h
+ * 	这个文件实现算法的执行策略 seq、par、par_unseq 与并行算法使用的内部线程池
+ *
+ * 	线程池采用静态划分：一次并行调用分成 T 个任务（T 为线程数），第 i 个任务总是由第 i 个线程执行，
+ * 	调用线程自己承担第 0 个任务。同一缓冲区先后经过多次并行算法时，每一段总是由同一个线程处理，
+ * 	在 Linux 下通过 execution::set_pinning(true) 把工作线程绑定到固定 CPU 后，
+ * 	缓冲区按“首次访问”规则分配到的 NUMA 节点与之后访问它的线程一致。
+ * 	绑定默认关闭，避免覆盖 cgroup、taskset 为进程安排的 CPU，或在线程数超过 CPU 数时互相争抢。
+ */
+
+#ifndef _LEESTL_EXECUTION_H_
+#define _LEESTL_EXECUTION_H_ 1
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace leestl {
+
+	namespace execution {
+
+		// 顺序执行
+		struct sequenced_policy {};
+		// 多线程并行执行
+		struct parallel_policy {};
+		// 多线程并行且允许向量化执行
+		struct parallel_unsequenced_policy {};
+
+		inline constexpr sequenced_policy            seq{};
+		inline constexpr parallel_policy             par{};
+		inline constexpr parallel_unsequenced_policy par_unseq{};
+
+	}    // namespace execution
+
+	// 判断类型是否为执行策略
+	template <typename T>
+	struct is_execution_policy : std::false_type {};
+	template <>
+	struct is_execution_policy<execution::sequenced_policy> : std::true_type {};
+	template <>
+	struct is_execution_policy<execution::parallel_policy> : std::true_type {};
+	template <>
+	struct is_execution_policy<execution::parallel_unsequenced_policy> : std::true_type {};
+
+	template <typename T>
+	inline constexpr bool is_execution_policy_v =
+	    is_execution_policy<std::remove_cv_t<std::remove_reference_t<T>>>::value;
+
+	// 并行算法重载的返回类型，第一个参数为执行策略时才参与重载决议
+	template <typename _EP, typename R>
+	using _enable_if_execution_policy = std::enable_if_t<is_execution_policy_v<_EP>, R>;
+
+	// 执行策略是否要求多线程执行
+	template <typename _EP>
+	inline constexpr bool _is_parallel_policy_v =
+	    is_execution_policy_v<_EP> && !std::is_same_v<
+	                                      std::remove_cv_t<std::remove_reference_t<_EP>>,
+	                                      execution::sequenced_policy>;
+
+	/**
+	 * @brief 并行算法使用的线程池，全局唯一
+	 */
+	class _thread_pool {
+	private:
+		typedef void (*_task_fn)(void *ctx, size_t task);
+
+		std::vector<std::thread> _workers;
+		std::mutex               _run_mutex;    // 同一时刻只执行一个并行调用
+		std::mutex               _mutex;
+		std::condition_variable  _wake_cv;
+		std::condition_variable  _done_cv;
+
+		// 当前并行调用
+		_task_fn            _fn = nullptr;
+		void               *_ctx = nullptr;
+		size_t              _ntasks = 0;
+		std::atomic<size_t> _nthreads{1};       // 参与的线程数，包括调用线程
+		size_t              _pending = 0;       // 尚未完成的工作线程数
+		uint64_t            _generation = 0;    // 每次并行调用加一，唤醒工作线程
+		bool                _stop = false;
+		bool                _pinning = false;    // 是否把工作线程绑定到固定 CPU
+
+#ifdef __linux__
+		cpu_set_t _allowed;    // 创建线程池时进程可用的 CPU，解除绑定时恢复为该集合
+#endif
+
+		static bool &_in_worker() {
+			thread_local bool in_worker = false;
+			return in_worker;
+		}
+
+		// 在当前线程依次执行全部任务，任务抛出异常时与多线程执行一样调用 std::terminate
+		template <typename F>
+		static void _run_serial(size_t ntasks, F &f) noexcept {
+			for (size_t t = 0; t < ntasks; ++t) f(t);
+		}
+
+		// 第 id 个线程执行任务 id, id + T, id + 2T, ...
+		void _run_tasks(size_t id) noexcept {
+			const size_t nthreads = _nthreads.load(std::memory_order_relaxed);
+			for (size_t t = id; t < _ntasks; t += nthreads) _fn(_ctx, t);
+		}
+
+		// seen 为启动时的调用代数，由启动者传入：线程真正开始运行前可能已有新的并行调用
+		void _worker_loop(size_t id, uint64_t seen) {
+			_in_worker() = true;
+			for (;;) {
+				{
+					std::unique_lock<std::mutex> lock(_mutex);
+					_wake_cv.wait(lock, [&] { return _stop || _generation != seen; });
+					if (_stop) return;
+					seen = _generation;
+				}
+				_run_tasks(id);
+				std::lock_guard<std::mutex> lock(_mutex);
+				if (--_pending == 0) _done_cv.notify_one();
+			}
+		}
+
+		// 开启绑定时把第 id 个线程绑定到进程可用的第 id 个 CPU，使其访问的内存页稳定落在同一 NUMA 节点；
+		// 关闭绑定时恢复为进程可用的全部 CPU
+		void _pin(std::thread &t, size_t id) {
+#ifdef __linux__
+			const int ncpu = CPU_COUNT(&_allowed);
+			if (ncpu == 0) return;
+			if (!_pinning) {
+				pthread_setaffinity_np(t.native_handle(), sizeof(_allowed), &_allowed);
+				return;
+			}
+			int nth = int(id % size_t(ncpu));
+			for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+				if (!CPU_ISSET(cpu, &_allowed) || nth-- != 0) continue;
+				cpu_set_t set;
+				CPU_ZERO(&set);
+				CPU_SET(cpu, &set);
+				pthread_setaffinity_np(t.native_handle(), sizeof(set), &set);
+				return;
+			}
+#else
+			(void)t;
+			(void)id;
+#endif
+		}
+
+		void _start(size_t nthreads) {
+			_stop = false;
+			_nthreads.store(nthreads, std::memory_order_relaxed);
+			for (size_t id = 1; id < nthreads; ++id) {
+				_workers.emplace_back(&_thread_pool::_worker_loop, this, id, _generation);
+				if (_pinning) _pin(_workers.back(), id);
+			}
+		}
+
+		void _shutdown() {
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_stop = true;
+			}
+			_wake_cv.notify_all();
+			for (std::thread &t : _workers) t.join();
+			_workers.clear();
+		}
+
+		_thread_pool() {
+#ifdef __linux__
+			if (sched_getaffinity(0, sizeof(_allowed), &_allowed) != 0) CPU_ZERO(&_allowed);
+#endif
+			const size_t n = std::thread::hardware_concurrency();
+			_start(n == 0 ? 1 : n);
+		}
+
+	public:
+		_thread_pool(const _thread_pool &) = delete;
+		_thread_pool &operator=(const _thread_pool &) = delete;
+
+		~_thread_pool() { _shutdown(); }
+
+		static _thread_pool &instance() {
+			static _thread_pool pool;
+			return pool;
+		}
+
+		// 参与并行调用的线程数，包括调用线程
+		size_t size() const noexcept { return _nthreads.load(std::memory_order_relaxed); }
+
+		// 调整线程数，n 为 0 时使用硬件线程数；_nthreads 与 _pinning 只在持有 _run_mutex 时修改
+		void resize(size_t n) {
+			std::lock_guard<std::mutex> run_lock(_run_mutex);
+			if (n == 0) n = std::thread::hardware_concurrency();
+			if (n == 0) n = 1;
+			if (n == _nthreads.load(std::memory_order_relaxed)) return;
+			_shutdown();
+			_start(n);
+		}
+
+		// 开启或关闭工作线程的 CPU 绑定，对已有的工作线程立即生效
+		void set_pinning(bool on) {
+			std::lock_guard<std::mutex> run_lock(_run_mutex);
+			if (on == _pinning) return;
+			_pinning = on;
+			for (size_t id = 1; id <= _workers.size(); ++id) _pin(_workers[id - 1], id);
+		}
+
+		/**
+		 * @brief 执行 ntasks 个任务，阻塞直到全部完成；任务 t 由第 t % size() 个线程执行。
+		 * 	在工作线程内嵌套调用时退化为顺序执行
+		 *
+		 * 	与标准库的并行执行策略一致，任务抛出异常时调用 std::terminate：无论任务在调用线程、
+		 * 	工作线程还是顺序执行，都经过 noexcept 的函数执行，异常不会在其他线程仍引用 f 时离开 run
+		 *
+		 * @param ntasks 任务个数
+		 * @param f 可调用对象，f(t) 执行第 t 个任务
+		 */
+		template <typename F>
+		void run(size_t ntasks, F &&f) {
+			if (ntasks == 0) return;
+			if (ntasks == 1 || _in_worker()) {
+				_run_serial(ntasks, f);
+				return;
+			}
+			std::lock_guard<std::mutex> run_lock(_run_mutex);
+			const size_t nthreads = _nthreads.load(std::memory_order_relaxed);
+			if (nthreads == 1) {
+				_run_serial(ntasks, f);
+				return;
+			}
+			typedef std::remove_reference_t<F> _F;
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_fn = [](void *ctx, size_t t) noexcept { (*static_cast<_F *>(ctx))(t); };
+				_ctx = const_cast<void *>(static_cast<const void *>(std::addressof(f)));
+				_ntasks = ntasks;
+				_pending = nthreads - 1;
+				++_generation;
+			}
+			_wake_cv.notify_all();
+			_in_worker() = true;    // 调用线程执行任务期间的嵌套调用同样顺序执行
+			_run_tasks(0);
+			_in_worker() = false;
+			std::unique_lock<std::mutex> lock(_mutex);
+			_done_cv.wait(lock, [&] { return _pending == 0; });
+		}
+	};
+
+	namespace execution {
+
+		// 设置并行算法使用的线程数（包括调用线程），0 表示硬件线程数
+		inline void set_num_threads(size_t n) { _thread_pool::instance().resize(n); }
+
+		// 并行算法使用的线程数
+		inline size_t num_threads() { return _thread_pool::instance().size(); }
+
+		// 开启或关闭把工作线程绑定到固定 CPU（仅 Linux），默认关闭
+		inline void set_pinning(bool on) { _thread_pool::instance().set_pinning(on); }
+
+	}    // namespace execution
+
+}    // namespace leestl
+
+#endif
@@ -0,0 +1,160 @@
+/** @file eytzinger_index.h
+ * 	这个文件实现 eytzinger_index：把有序序列按二叉搜索树的层序（Eytzinger 布局）重新排列的静态查找表
+ *
+ * 	有序数组上的二分查找前几步访问的元素相距很远，每一步都可能缓存缺失，且下一步的地址依赖本次比较。
+ * 	层序布局中结点 k 的子结点为 2k 与 2k + 1，从根开始的若干层集中在数组开头，常驻缓存；
+ * 	结点 k 往下 log2(B) 层的 B 个后代在数组中连续（B 为一条缓存行容纳的元素个数），
+ * 	因此每一步都可以提前预取几层之后要访问的缓存行。批量查找时多个查询交替前进一层，
+ * 	各查询的内存访问相互重叠，进一步掩盖内存延迟。
+ */
+
+#ifndef _LEESTL_EYTZINGER_INDEX_H_
+#define _LEESTL_EYTZINGER_INDEX_H_ 1
+
+#include "allocator.h"
+#include "vector.h"
+
+namespace leestl {
+
+	/**
+	 * @brief 按 operator< 有序的静态查找表，构造后不可修改
+	 *
+	 * @tparam T 元素类型
+	 * @tparam Alloc 配置器类型
+	 */
+	template <typename T, typename Alloc = leestl::allocator<T>>
+	class eytzinger_index {
+	public:
+		typedef T               value_type;
+		typedef Alloc           allocator_type;
+		typedef size_t          size_type;
+		typedef const T        *const_pointer;
+		typedef const T        &const_reference;
+		typedef const T        *const_iterator;
+
+		// 批量查找时同时前进的查询个数
+		enum { batch_size = 16 };
+
+	private:
+		// 预取 k * _STRIDE 处的缓存行，即结点 k 往下 log2(_STRIDE) 层的全部后代
+		enum { _STRIDE = sizeof(T) >= 64 ? 1 : 64 / sizeof(T) };
+
+		leestl::vector<T, Alloc> _tree;    // _tree[1..n] 为层序排列的元素，_tree[0] 不使用
+		size_type                _size = 0;
+
+	public:
+		eytzinger_index() = default;
+
+		/**
+		 * @brief 由有序区间 [first, last) 构造
+		 *
+		 * @param first 起始位置，区间须按 operator< 有序
+		 * @param last 终止位置
+		 */
+		template <typename _RI, typename = leestl::RequireRandomAccessIterator<_RI>>
+		eytzinger_index(_RI first, _RI last, const Alloc &alloc = Alloc())
+		        : _tree(alloc), _size(last - first) {
+			if (_size == 0) return;
+			_tree.resize(_size + 1, *first);
+			_RI it = first;
+			_build(it, 1);
+		}
+
+		/**
+		 * @brief 由有序的 leestl::vector 构造
+		 *
+		 * @param sorted 按 operator< 有序的数组
+		 */
+		template <typename A, typename G>
+		explicit eytzinger_index(
+		    const leestl::vector<T, A, G> &sorted, const Alloc &alloc = Alloc())
+		        : eytzinger_index(sorted.begin(), sorted.end(), alloc) {}
+
+		size_type size() const noexcept { return _size; }
+		bool      empty() const noexcept { return _size == 0; }
+
+		// 层序排列的元素
+		const_iterator begin() const noexcept { return _tree.data() + (_size ? 1 : 0); }
+		const_iterator end() const noexcept { return _tree.data() + (_size ? _size + 1 : 0); }
+
+		/**
+		 * @brief 查找第一个不小于 value 的元素
+		 *
+		 * @param value 查找值
+		 * @return const_iterator 指向该元素，不存在时为 end()
+		 */
+		const_iterator lower_bound(const T &value) const {
+			const T  *b = _tree.data();
+			size_type k = 1;
+			while (k <= _size) {
+				__builtin_prefetch(b + k * _STRIDE);
+				k = 2 * k + size_type(b[k] < value);
+			}
+			return _result(k);
+		}
+
+		/**
+		 * @brief 判断是否存在与 value 相等的元素
+		 *
+		 * @param value 查找值
+		 * @return bool 是否存在
+		 */
+		bool contains(const T &value) const {
+			const_iterator it = lower_bound(value);
+			return it != end() && !(value < *it);
+		}
+
+		/**
+		 * @brief 批量查找，batch_size 个查询交替前进，results[i] 为 lower_bound(queries[i])
+		 *
+		 * @param queries 查询值数组
+		 * @param count 查询个数
+		 * @param results 结果数组，长度不小于 count
+		 */
+		void lower_bound(const T *queries, size_type count, const_iterator *results) const {
+			const T  *b = _tree.data();
+			size_type k[batch_size];
+			size_type i = 0;
+			for (; i + batch_size <= count; i += batch_size) {
+				for (size_type j = 0; j < batch_size; ++j) k[j] = 1;
+				// 所有查询都至少走满 _full_levels() 层，这些层无需判断是否越界
+				for (int level = _full_levels(); level > 0; --level) {
+					for (size_type j = 0; j < batch_size; ++j) {
+						__builtin_prefetch(b + k[j] * _STRIDE);
+						k[j] = 2 * k[j] + size_type(b[k[j]] < queries[i + j]);
+					}
+				}
+				for (size_type j = 0; j < batch_size; ++j) {
+					if (k[j] <= _size) k[j] = 2 * k[j] + size_type(b[k[j]] < queries[i + j]);
+					results[i + j] = _result(k[j]);
+				}
+			}
+			for (; i < count; ++i) results[i] = lower_bound(queries[i]);
+		}
+
+	private:
+		// 中序遍历子树 k，依次填入有序元素
+		template <typename _RI>
+		void _build(_RI &it, size_type k) {
+			if (k > _size) return;
+			_build(it, 2 * k);
+			_tree[k] = *it;
+			++it;
+			_build(it, 2 * k + 1);
+		}
+
+		// 满二叉的层数，即 floor(log2(n + 1))
+		int _full_levels() const noexcept {
+			return int(sizeof(size_type) * 8 - 1) - __builtin_clzl(_size + 1);
+		}
+
+		// 搜索路径最后一次向左走的结点即为结果：去掉 k 末尾连续的 1（向右走）以及其前的一个 0
+		const_iterator _result(size_type k) const noexcept {
+			k >>= __builtin_ffsl(long(~k));
+			return k == 0 ? end() : _tree.data() + k;
+		}
+	};
+
+}    // namespace leestl
+
+#endif
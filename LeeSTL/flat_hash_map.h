@@ -0,0 +1,125 @@
+/** @file flat_hash_map.h
+ * 	这个文件实现开放寻址的关联容器 flat_hash_map
+ *
+ * 	键值对直接存放在哈希表的槽位数组中，查找不需要跟随结点指针，插入也不需要为每个元素分配内存。
+ * 	重建时元素会被移动到新的槽位，因此插入可能使所有迭代器、指针与引用失效，删除只使被删元素的失效。
+ */
+
+#ifndef _LEESTL_FLAT_HASH_MAP_H_
+#define _LEESTL_FLAT_HASH_MAP_H_ 1
+
+#include <tuple>
+
+#include "flat_hashtable.h"
+
+namespace leestl {
+
+	// flat_hash_map 的元素为 std::pair<const Key, T>，键取 first
+	template <typename Key, typename T>
+	struct _flat_map_policy {
+		typedef Key                     key_type;
+		typedef std::pair<const Key, T> value_type;
+		static constexpr bool           constant_iterators = false;
+
+		static const Key &key(const value_type &v) noexcept { return v.first; }
+	};
+
+	/**
+	 * @brief 键唯一的开放寻址哈希映射表
+	 *
+	 * @tparam Key 键类型
+	 * @tparam T 值类型
+	 * @tparam Hash 哈希仿函数，与 KeyEqual 都声明 is_transparent 时支持异构查找
+	 * @tparam KeyEqual 判断键相等的仿函数
+	 * @tparam Alloc 配置器类型
+	 */
+	template <
+	    typename Key, typename T, typename Hash = leestl::hash<Key>,
+	    typename KeyEqual = leestl::equal_to<Key>,
+	    typename Alloc = leestl::allocator<std::pair<const Key, T>>>
+	class flat_hash_map : public _flat_hashtable<_flat_map_policy<Key, T>, Hash, KeyEqual, Alloc> {
+		typedef _flat_hashtable<_flat_map_policy<Key, T>, Hash, KeyEqual, Alloc> _base;
+
+	public:
+		typedef T                              mapped_type;
+		typedef typename _base::key_type       key_type;
+		typedef typename _base::value_type     value_type;
+		typedef typename _base::size_type      size_type;
+		typedef typename _base::iterator       iterator;
+		typedef typename _base::const_iterator const_iterator;
+
+		using _base::_base;
+		using _base::operator=;
+
+		flat_hash_map() = default;
+
+		/**
+		 * @brief 键不存在时以 args 构造值并插入，键已存在时什么也不做（args 不会被移动）
+		 *
+		 * @param key 键
+		 * @param args 构造值的参数
+		 * @return std::pair<iterator, bool> 键所在的位置，以及是否插入了新元素
+		 */
+		template <typename... Args>
+		std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) {
+			return this->_emplace_unique(
+			    key, std::piecewise_construct, std::forward_as_tuple(key),
+			    std::forward_as_tuple(leestl::forward<Args>(args)...));
+		}
+
+		template <typename... Args>
+		std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args) {
+			return this->_emplace_unique(
+			    key, std::piecewise_construct, std::forward_as_tuple(leestl::move(key)),
+			    std::forward_as_tuple(leestl::forward<Args>(args)...));
+		}
+
+		/**
+		 * @brief 键不存在时插入，键已存在时把值赋为 obj
+		 *
+		 * @return std::pair<iterator, bool> 键所在的位置，以及是否插入了新元素
+		 */
+		template <typename M>
+		std::pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj) {
+			auto r = try_emplace(key, leestl::forward<M>(obj));
+			if (!r.second) r.first->second = leestl::forward<M>(obj);
+			return r;
+		}
+
+		template <typename M>
+		std::pair<iterator, bool> insert_or_assign(key_type &&key, M &&obj) {
+			auto r = try_emplace(leestl::move(key), leestl::forward<M>(obj));
+			if (!r.second) r.first->second = leestl::forward<M>(obj);
+			return r;
+		}
+
+		// 返回键对应的值，键不存在时插入值初始化的元素
+		mapped_type &operator[](const key_type &key) { return try_emplace(key).first->second; }
+		mapped_type &operator[](key_type &&key) {
+			return try_emplace(leestl::move(key)).first->second;
+		}
+
+		// 返回键对应的值，键不存在时抛出 std::out_of_range
+		mapped_type &at(const key_type &key) {
+			iterator it = this->find(key);
+			if (it == this->end()) throw std::out_of_range("flat_hash_map::at: key not found");
+			return it->second;
+		}
+
+		const mapped_type &at(const key_type &key) const {
+			const_iterator it = this->find(key);
+			if (it == this->end()) throw std::out_of_range("flat_hash_map::at: key not found");
+			return it->second;
+		}
+	};
+
+	template <typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+	inline void swap(
+	    flat_hash_map<Key, T, Hash, KeyEqual, Alloc> &x,
+	    flat_hash_map<Key, T, Hash, KeyEqual, Alloc> &y) noexcept {
+		x.swap(y);
+	}
+
+}    // namespace leestl
+
+#endif
@@ -0,0 +1,55 @@
+/** @file flat_hash_set.h
+ * 	这个文件实现开放寻址的集合容器 flat_hash_set
+ *
+ * 	元素直接存放在哈希表的槽位数组中，迭代器只读。重建时元素会被移动到新的槽位，
+ * 	因此插入可能使所有迭代器、指针与引用失效，删除只使被删元素的失效。
+ */
+
+#ifndef _LEESTL_FLAT_HASH_SET_H_
+#define _LEESTL_FLAT_HASH_SET_H_ 1
+
+#include "flat_hashtable.h"
+
+namespace leestl {
+
+	// flat_hash_set 的元素就是键
+	template <typename Key>
+	struct _flat_set_policy {
+		typedef Key           key_type;
+		typedef Key           value_type;
+		static constexpr bool constant_iterators = true;
+
+		static const Key &key(const value_type &v) noexcept { return v; }
+	};
+
+	/**
+	 * @brief 元素唯一的开放寻址哈希集合
+	 *
+	 * @tparam Key 元素类型
+	 * @tparam Hash 哈希仿函数，与 KeyEqual 都声明 is_transparent 时支持异构查找
+	 * @tparam KeyEqual 判断元素相等的仿函数
+	 * @tparam Alloc 配置器类型
+	 */
+	template <
+	    typename Key, typename Hash = leestl::hash<Key>, typename KeyEqual = leestl::equal_to<Key>,
+	    typename Alloc = leestl::allocator<Key>>
+	class flat_hash_set : public _flat_hashtable<_flat_set_policy<Key>, Hash, KeyEqual, Alloc> {
+		typedef _flat_hashtable<_flat_set_policy<Key>, Hash, KeyEqual, Alloc> _base;
+
+	public:
+		using _base::_base;
+		using _base::operator=;
+
+		flat_hash_set() = default;
+	};
+
+	template <typename Key, typename Hash, typename KeyEqual, typename Alloc>
+	inline void swap(
+	    flat_hash_set<Key, Hash, KeyEqual, Alloc> &x,
+	    flat_hash_set<Key, Hash, KeyEqual, Alloc> &y) noexcept {
+		x.swap(y);
+	}
+
+}    // namespace leestl
+
+#endif
@@ -0,0 +1,821 @@
+/** @file flat_hashtable.h
+ * 	这个文件实现 flat_hash_map、flat_hash_set 共用的开放寻址哈希表
+ *
+ * 	元素直接存放在连续的槽位数组中，每 15 个槽位为一组，对应 16 字节的控制组：
+ * 	前 15 字节是各槽位的控制字节（0 表示空，1 为表尾哨兵，其余为哈希值低 8 位映射到 [2, 255] 的指纹），
+ * 	最后 1 字节为溢出位图。
+ * 	查找时用一次 SSE2 比较找出组内指纹相同的槽位，只对这些槽位比较键，每组通常只需比较一次键。
+ * 	插入时若组已满，就在该组的溢出位图中置上哈希值对应的位，再按三角数序列探测下一组；
+ * 	查找遇到对应溢出位未置位的组即可停止。因此删除只需把控制字节改回空，不留下墓碑。
+ * 	残留的溢出位只会让之后的查找多探测几组：删除位于有溢出的组中的元素时同时下调最大负载，
+ * 	这类删除累计足够多后，下一次插入会在原容量下重建哈希表并清除这些位。
+ */
+
+#ifndef _LEESTL_FLAT_HASHTABLE_H_
+#define _LEESTL_FLAT_HASHTABLE_H_ 1
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "alloc_traits.h"
+#include "allocator.h"
+#include "iterator_base_types.h"
+#include "simd.h"
+#include "type_traits.h"
+#include "utils.h"
+
+#if defined(LEESTL_SIMD_X86) && defined(__SSE2__)
+#define _LEESTL_HASH_GROUP_SSE2 1
+#endif
+
+namespace leestl {
+
+	// 默认的哈希仿函数
+	template <typename Key>
+	struct hash : std::hash<Key> {};
+
+	// 字符串的哈希支持异构查找：std::string、string_view、const char* 的哈希值相同
+	template <>
+	struct hash<std::string> {
+		typedef void is_transparent;
+
+		size_t operator()(std::string_view s) const noexcept {
+			return std::hash<std::string_view>()(s);
+		}
+	};
+
+	template <>
+	struct hash<std::string_view> : hash<std::string> {};
+
+	// 默认的相等比较，字符串使用透明比较，可以直接与 string_view、const char* 比较
+	template <typename Key>
+	struct equal_to : std::equal_to<Key> {};
+
+	template <>
+	struct equal_to<std::string> : std::equal_to<> {};
+
+	template <>
+	struct equal_to<std::string_view> : std::equal_to<> {};
+
+	// 哈希与相等比较都声明了 is_transparent 时允许以其他类型的键查找
+	template <typename Hash, typename KeyEqual>
+	using _require_transparent =
+	    void_type<typename Hash::is_transparent, typename KeyEqual::is_transparent>;
+
+	// 16 字节的控制组：前 15 字节为槽位的控制字节，最后 1 字节为溢出位图
+	struct _hash_group {
+		enum { SLOTS = 15 };
+		enum : unsigned char { EMPTY = 0, SENTINEL = 1 };
+
+		unsigned char ctrl[16];
+
+		// 控制字节等于 c 的槽位组成的位掩码
+		uint32_t match(unsigned char c) const noexcept {
+#ifdef _LEESTL_HASH_GROUP_SSE2
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl));
+			return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(char(c))))) & 0x7fff;
+#else
+			uint32_t m = 0;
+			for (int i = 0; i < SLOTS; ++i) m |= uint32_t(ctrl[i] == c) << i;
+			return m;
+#endif
+		}
+
+		uint32_t match_empty() const noexcept { return match(EMPTY); }
+
+		// 有元素或哨兵的槽位
+		uint32_t match_occupied() const noexcept { return ~match_empty() & 0x7fff; }
+
+		bool overflowed(size_t hash) const noexcept { return ctrl[SLOTS] & (1u << (hash % 8)); }
+
+		void mark_overflow(size_t hash) noexcept {
+			ctrl[SLOTS] |= (unsigned char)(1u << (hash % 8));
+		}
+	};
+
+	/**
+	 * @brief 哈希表的前向迭代器，指向某个控制组中的一个槽位
+	 *
+	 * @tparam Value 元素类型
+	 * @tparam Const 是否只读
+	 */
+	template <typename Value, bool Const>
+	class _flat_hash_iterator {
+		template <typename, typename, typename, typename>
+		friend class _flat_hashtable;
+		template <typename, bool>
+		friend class _flat_hash_iterator;
+
+	public:
+		typedef forward_interator_tag                             iterator_category;
+		typedef Value                                             value_type;
+		typedef ptrdiff_t                                         difference_type;
+		typedef std::conditional_t<Const, const Value *, Value *> pointer;
+		typedef std::conditional_t<Const, const Value &, Value &> reference;
+
+		_flat_hash_iterator() noexcept = default;
+
+		// 可写迭代器可以转换为只读迭代器
+		template <bool C, typename = std::enable_if_t<Const && !C>>
+		_flat_hash_iterator(const _flat_hash_iterator<Value, C> &x) noexcept
+		        : _group(x._group), _pos(x._pos), _slot(x._slot) {}
+
+		reference operator*() const noexcept { return *_slot; }
+		pointer   operator->() const noexcept { return _slot; }
+
+		_flat_hash_iterator &operator++() noexcept {
+			++_slot;
+			++_pos;
+			_skip_empty();
+			return *this;
+		}
+
+		_flat_hash_iterator operator++(int) noexcept {
+			_flat_hash_iterator tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		template <bool C>
+		bool operator==(const _flat_hash_iterator<Value, C> &x) const noexcept {
+			return _slot == x._slot;
+		}
+
+		template <bool C>
+		bool operator!=(const _flat_hash_iterator<Value, C> &x) const noexcept {
+			return _slot != x._slot;
+		}
+
+	private:
+		const _hash_group *_group = nullptr;
+		unsigned           _pos = 0;    // 槽位在组内的下标
+		Value             *_slot = nullptr;
+
+		_flat_hash_iterator(const _hash_group *group, unsigned pos, Value *slot) noexcept
+		        : _group(group), _pos(pos), _slot(slot) {}
+
+		// 从当前槽位开始跳过空槽位，表尾哨兵保证一定会停下
+		void _skip_empty() noexcept {
+			for (;;) {
+				const uint32_t m = _pos < unsigned(_hash_group::SLOTS)
+				                       ? _group->match_occupied() >> _pos << _pos
+				                       : 0;
+				if (m) {
+					const unsigned next = unsigned(__builtin_ctz(m));
+					_slot += next - _pos;
+					_pos = next;
+					return;
+				}
+				_slot += _hash_group::SLOTS - _pos;
+				++_group;
+				_pos = 0;
+			}
+		}
+	};
+
+	/**
+	 * @brief 开放寻址哈希表，键唯一
+	 *
+	 * @tparam Policy 描述元素类型以及如何从元素取出键
+	 * @tparam Hash 哈希仿函数
+	 * @tparam KeyEqual 判断键相等的仿函数
+	 * @tparam Alloc 配置器类型
+	 */
+	template <typename Policy, typename Hash, typename KeyEqual, typename Alloc>
+	class _flat_hashtable {
+	public:
+		typedef typename Policy::key_type   key_type;
+		typedef typename Policy::value_type value_type;
+		typedef Hash                        hasher;
+		typedef KeyEqual                    key_equal;
+		typedef Alloc                       allocator_type;
+		typedef size_t                      size_type;
+		typedef ptrdiff_t                   difference_type;
+		typedef value_type                 &reference;
+		typedef const value_type           &const_reference;
+
+		typedef _flat_hash_iterator<value_type, Policy::constant_iterators> iterator;
+		typedef _flat_hash_iterator<value_type, true>                       const_iterator;
+
+	private:
+		typedef typename leestl::allocator_traits<Alloc>::template rebind_alloc<value_type>
+		    slot_allocator;
+		typedef typename leestl::allocator_traits<Alloc>::template rebind_alloc<_hash_group>
+		    group_allocator;
+		typedef leestl::allocator_traits<slot_allocator>  _slot_traits;
+		typedef leestl::allocator_traits<group_allocator> _group_traits;
+
+		// 继承配置器以利用空基类优化，无状态配置器不占用额外空间
+		struct _hashtable_impl : public slot_allocator {
+			_hash_group *groups = nullptr;    // 控制组数组，共 group_mask + 1 组
+			value_type  *slots = nullptr;     // 槽位数组，第 i 组对应 [15i, 15i + 15)
+			size_type    group_mask = 0;      // 组数减 1，组数为 2 的幂
+			size_type    size = 0;            // 元素个数
+			size_type    max_load = 0;        // 元素个数达到该值时插入前先重建
+
+			_hashtable_impl() = default;
+			_hashtable_impl(const slot_allocator &a) : slot_allocator(a) {}
+		};
+
+		_hashtable_impl _impl;
+		hasher          _hash;
+		key_equal       _eq;
+
+		slot_allocator       &_get_alloc() noexcept { return _impl; }
+		const slot_allocator &_get_alloc() const noexcept { return _impl; }
+
+		static constexpr size_type _npos = size_type(-1);
+
+	public:
+		_flat_hashtable() = default;
+
+		explicit _flat_hashtable(
+		    size_type n, const hasher &hf = hasher(), const key_equal &eq = key_equal(),
+		    const allocator_type &a = allocator_type())
+		        : _impl(slot_allocator(a)), _hash(hf), _eq(eq) {
+			reserve(n);
+		}
+
+		explicit _flat_hashtable(const allocator_type &a) : _impl(slot_allocator(a)) {}
+
+		template <typename _II, typename = leestl::RequireInputIterator<_II>>
+		_flat_hashtable(
+		    _II first, _II last, size_type n = 0, const hasher &hf = hasher(),
+		    const key_equal &eq = key_equal(), const allocator_type &a = allocator_type())
+		        : _flat_hashtable(n, hf, eq, a) {
+			insert(first, last);
+		}
+
+		_flat_hashtable(
+		    std::initializer_list<value_type> ilist, size_type n = 0,
+		    const hasher &hf = hasher(), const key_equal &eq = key_equal(),
+		    const allocator_type &a = allocator_type())
+		        : _flat_hashtable(ilist.begin(), ilist.end(), n, hf, eq, a) {}
+
+		// 复制构造：按相同容量分配，控制字节整段复制，元素复制到相同的槽位
+		_flat_hashtable(const _flat_hashtable &x)
+		        : _impl(_slot_traits::select_on_container_copy_construction(x._get_alloc())),
+		          _hash(x._hash), _eq(x._eq) {
+			_copy_from(x);
+		}
+
+		_flat_hashtable(_flat_hashtable &&x) noexcept
+		        : _impl(leestl::move(x._get_alloc())), _hash(x._hash), _eq(x._eq) {
+			_steal(x);
+		}
+
+		// 复制赋值：先复制到临时容器再接管，失败时本容器不变；
+		// propagate_on_container_copy_assignment 为真时同时复制配置器，否则保留原配置器
+		_flat_hashtable &operator=(const _flat_hashtable &x) {
+			if (this != &x) {
+				constexpr bool  pocca = _slot_traits::propagate_on_container_copy_assignment::value;
+				_flat_hashtable tmp(allocator_type(pocca ? x._get_alloc() : _get_alloc()));
+				tmp._copy_from(x);
+				_destroy_and_deallocate();
+				if constexpr (pocca) _get_alloc() = x._get_alloc();
+				_hash = x._hash;
+				_eq = x._eq;
+				_steal(tmp);
+			}
+			return *this;
+		}
+
+		_flat_hashtable &operator=(_flat_hashtable &&x) noexcept(
+		    _slot_traits::propagate_on_container_move_assignment::value ||
+		    _slot_traits::is_always_equal::value) {
+			if (this == &x) return *this;
+			if constexpr (
+			    _slot_traits::propagate_on_container_move_assignment::value ||
+			    _slot_traits::is_always_equal::value) {
+				_destroy_and_deallocate();
+				if constexpr (_slot_traits::propagate_on_container_move_assignment::value)
+					_get_alloc() = leestl::move(x._get_alloc());
+				_hash = x._hash;
+				_eq = x._eq;
+				_steal(x);
+			} else if (_slot_traits::equal(_get_alloc(), x._get_alloc())) {
+				_destroy_and_deallocate();
+				_hash = x._hash;
+				_eq = x._eq;
+				_steal(x);
+			} else {
+				// 配置器不同，只能逐个移动元素
+				clear();
+				_hash = x._hash;
+				_eq = x._eq;
+				reserve(x.size());
+				// 集合的迭代器只读，直接按槽位访问元素
+				x._for_each_index([&](size_type i) {
+					value_type &v = x._impl.slots[i];
+					_emplace_unique(Policy::key(v), leestl::move(v));
+				});
+				x.clear();
+			}
+			return *this;
+		}
+
+		_flat_hashtable &operator=(std::initializer_list<value_type> ilist) {
+			clear();
+			insert(ilist.begin(), ilist.end());
+			return *this;
+		}
+
+		~_flat_hashtable() { _destroy_and_deallocate(); }
+
+		allocator_type get_allocator() const noexcept { return allocator_type(_get_alloc()); }
+		hasher         hash_function() const { return _hash; }
+		key_equal      key_eq() const { return _eq; }
+
+		iterator begin() noexcept {
+			if (_impl.groups == nullptr) return iterator();
+			iterator it(_impl.groups, 0, _impl.slots);
+			it._skip_empty();
+			return it;
+		}
+
+		const_iterator begin() const noexcept {
+			return const_cast<_flat_hashtable *>(this)->begin();
+		}
+
+		// 尾后位置即表尾哨兵所在的槽位
+		iterator end() noexcept {
+			if (_impl.groups == nullptr) return iterator();
+			return iterator(
+			    _impl.groups + _impl.group_mask, _hash_group::SLOTS - 1,
+			    _impl.slots + capacity());
+		}
+
+		const_iterator end() const noexcept { return const_cast<_flat_hashtable *>(this)->end(); }
+		const_iterator cbegin() const noexcept { return begin(); }
+		const_iterator cend() const noexcept { return end(); }
+
+		bool      empty() const noexcept { return _impl.size == 0; }
+		size_type size() const noexcept { return _impl.size; }
+		size_type max_size() const noexcept { return _slot_traits::max_size(_get_alloc()); }
+
+		// 可容纳元素的槽位数，不含哨兵
+		size_type capacity() const noexcept {
+			return _impl.groups ? (_impl.group_mask + 1) * _hash_group::SLOTS - 1 : 0;
+		}
+
+		size_type bucket_count() const noexcept { return capacity(); }
+		float     load_factor() const noexcept {
+			return capacity() ? float(size()) / float(capacity()) : 0.0f;
+		}
+		float max_load_factor() const noexcept { return 0.875f; }
+
+		/**
+		 * @brief 预留空间，使插入 n 个元素之前不会重建
+		 *
+		 * @param n 元素个数
+		 */
+		void reserve(size_type n) {
+			if (n > _impl.max_load) _rehash(_groups_for(n < size() ? size() : n));
+		}
+
+		// 销毁所有元素，保留已分配的空间
+		void clear() noexcept {
+			if (_impl.groups == nullptr) return;
+			_destroy_elements();
+			_reset_ctrl(_impl.groups, _impl.group_mask + 1);
+			_impl.size = 0;
+			_impl.max_load = _max_load_for(_impl.group_mask + 1);
+		}
+
+		std::pair<iterator, bool> insert(const value_type &v) {
+			return _emplace_unique(Policy::key(v), v);
+		}
+
+		std::pair<iterator, bool> insert(value_type &&v) {
+			return _emplace_unique(Policy::key(v), leestl::move(v));
+		}
+
+		template <typename _II, typename = leestl::RequireInputIterator<_II>>
+		void insert(_II first, _II last) {
+			for (; first != last; ++first) _emplace_unique(Policy::key(*first), *first);
+		}
+
+		void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+
+		/**
+		 * @brief 由 args 构造元素并插入，键已存在时不插入
+		 *
+		 * @return std::pair<iterator, bool> 键所在的位置，以及是否插入了新元素
+		 */
+		template <typename... Args>
+		std::pair<iterator, bool> emplace(Args &&...args) {
+			// 需要先构造出元素才能取得键
+			value_type tmp(leestl::forward<Args>(args)...);
+			return _emplace_unique(Policy::key(tmp), leestl::move(tmp));
+		}
+
+		iterator find(const key_type &key) { return _iterator_at(_find_index(key)); }
+
+		const_iterator find(const key_type &key) const { return _iterator_at(_find_index(key)); }
+
+		// 异构查找，例如以 string_view 查找 std::string 键，无需构造临时的键
+		template <typename K, typename H = Hash, typename E = KeyEqual,
+		          typename = _require_transparent<H, E>>
+		iterator find(const K &key) {
+			return _iterator_at(_find_index(key));
+		}
+
+		template <typename K, typename H = Hash, typename E = KeyEqual,
+		          typename = _require_transparent<H, E>>
+		const_iterator find(const K &key) const {
+			return _iterator_at(_find_index(key));
+		}
+
+		bool contains(const key_type &key) const { return _find_index(key) != _npos; }
+
+		template <typename K, typename H = Hash, typename E = KeyEqual,
+		          typename = _require_transparent<H, E>>
+		bool contains(const K &key) const {
+			return _find_index(key) != _npos;
+		}
+
+		size_type count(const key_type &key) const { return contains(key); }
+
+		template <typename K, typename H = Hash, typename E = KeyEqual,
+		          typename = _require_transparent<H, E>>
+		size_type count(const K &key) const {
+			return contains(key);
+		}
+
+		/**
+		 * @brief 删除 pos 所指的元素
+		 *
+		 * @param pos 元素位置
+		 * @return iterator 下一个元素的位置
+		 */
+		iterator erase(const_iterator pos) {
+			_erase_index(pos._slot - _impl.slots);
+			iterator it(pos._group, pos._pos, const_cast<value_type *>(pos._slot));
+			++it;
+			return it;
+		}
+
+		iterator erase(const_iterator first, const_iterator last) {
+			while (first != last) first = erase(first);
+			return iterator(last._group, last._pos, const_cast<value_type *>(last._slot));
+		}
+
+		/**
+		 * @brief 删除键为 key 的元素
+		 *
+		 * @param key 键
+		 * @return size_type 删除的元素个数（0 或 1）
+		 */
+		size_type erase(const key_type &key) { return _erase_key(key); }
+
+		template <typename K, typename H = Hash, typename E = KeyEqual,
+		          typename = _require_transparent<H, E>,
+		          typename = std::enable_if_t<!std::is_convertible_v<const K &, const_iterator>>>
+		size_type erase(const K &key) {
+			return _erase_key(key);
+		}
+
+		void swap(_flat_hashtable &x) noexcept {
+			leestl::swap(_impl.groups, x._impl.groups);
+			leestl::swap(_impl.slots, x._impl.slots);
+			leestl::swap(_impl.group_mask, x._impl.group_mask);
+			leestl::swap(_impl.size, x._impl.size);
+			leestl::swap(_impl.max_load, x._impl.max_load);
+			leestl::swap(_hash, x._hash);
+			leestl::swap(_eq, x._eq);
+			if constexpr (_slot_traits::propagate_on_container_swap::value)
+				leestl::swap(_get_alloc(), x._get_alloc());
+		}
+
+	protected:
+		// 混合哈希值的高低位，使 std::hash 对整数的恒等映射也能均匀分布
+		static size_t _mix(size_t h) noexcept {
+			const __uint128_t r = __uint128_t(h) * 0x9E3779B97F4A7C15ull;
+			return size_t(r) ^ size_t(r >> 64);
+		}
+
+		template <typename K>
+		size_t _hash_of(const K &key) const {
+			return _mix(_hash(key));
+		}
+
+		// 哈希值低 8 位作为指纹，避开空与哨兵两个取值
+		static unsigned char _fingerprint(size_t h) noexcept {
+			const unsigned char f = (unsigned char)h;
+			return f < 2 ? f + 8 : f;
+		}
+
+		size_type _first_group(size_t h) const noexcept { return (h >> 8) & _impl.group_mask; }
+
+		template <typename K>
+		size_type _find_index(const K &key) const {
+			return _impl.size ? _find_index(key, _hash_of(key)) : _npos;
+		}
+
+		/**
+		 * @brief 查找键为 key 的元素所在的槽位
+		 *
+		 * @param key 键
+		 * @param h 键混合后的哈希值
+		 * @return size_type 槽位下标，不存在时为 _npos
+		 */
+		template <typename K>
+		size_type _find_index(const K &key, size_t h) const {
+			if (_impl.size == 0) return _npos;
+			const unsigned char fp = _fingerprint(h);
+			size_type           g = _first_group(h);
+			for (size_type step = 1;; g = (g + step++) & _impl.group_mask) {
+				const _hash_group &group = _impl.groups[g];
+				for (uint32_t m = group.match(fp); m; m &= m - 1) {
+					const size_type i = g * _hash_group::SLOTS + __builtin_ctz(m);
+					if (_eq(key, Policy::key(_impl.slots[i]))) return i;
+				}
+				if (!group.overflowed(h) || step > _impl.group_mask) return _npos;
+			}
+		}
+
+		// 在 groups 中为哈希值 h 找一个空槽位，沿途经过的满组记录溢出；表中必须有空槽位
+		static size_type _find_empty(_hash_group *groups, size_type mask, size_t h) noexcept {
+			size_type g = (h >> 8) & mask;
+			for (size_type step = 1;; g = (g + step++) & mask) {
+				const uint32_t m = groups[g].match_empty();
+				if (m) return g * _hash_group::SLOTS + __builtin_ctz(m);
+				groups[g].mark_overflow(h);
+			}
+		}
+
+		/**
+		 * @brief 键为 key 的元素不存在时，在空槽位上由 args 构造元素
+		 *
+		 * @param key 元素的键，用于查找与计算哈希值
+		 * @param args 构造元素的参数，不能引用表内的元素（插入可能触发重建）
+		 * @return std::pair<iterator, bool> 键所在的位置，以及是否插入了新元素
+		 */
+		template <typename K, typename... Args>
+		std::pair<iterator, bool> _emplace_unique(const K &key, Args &&...args) {
+			return _emplace_unique_hashed(_hash_of(key), key, leestl::forward<Args>(args)...);
+		}
+
+		// 与 _emplace_unique 相同，h 为 key 混合后的哈希值
+		template <typename K, typename... Args>
+		std::pair<iterator, bool> _emplace_unique_hashed(size_t h, const K &key, Args &&...args) {
+			const size_type found = _find_index(key, h);
+			if (found != _npos) return std::pair<iterator, bool>(_iterator_at(found), false);
+			if (_impl.size >= _impl.max_load) _grow();
+			const size_type i = _find_empty(_impl.groups, _impl.group_mask, h);
+			_slot_traits::construct(_get_alloc(), _impl.slots + i, leestl::forward<Args>(args)...);
+			_impl.groups[i / _hash_group::SLOTS].ctrl[i % _hash_group::SLOTS] = _fingerprint(h);
+			++_impl.size;
+			return std::pair<iterator, bool>(_iterator_at(i), true);
+		}
+
+		template <typename K>
+		size_type _erase_key(const K &key) {
+			return _impl.size ? _erase_key_hashed(_hash_of(key), key) : 0;
+		}
+
+		template <typename K>
+		size_type _erase_key_hashed(size_t h, const K &key) {
+			const size_type i = _find_index(key, h);
+			if (i == _npos) return 0;
+			_erase_index(i);
+			return 1;
+		}
+
+		// 销毁槽位 i 上的元素并把控制字节改回空；所在组有溢出时下调最大负载
+		void _erase_index(size_type i) {
+			_hash_group &group = _impl.groups[i / _hash_group::SLOTS];
+			_slot_traits::destroy(_get_alloc(), _impl.slots + i);
+			group.ctrl[i % _hash_group::SLOTS] = _hash_group::EMPTY;
+			--_impl.size;
+			if (group.ctrl[_hash_group::SLOTS]) --_impl.max_load;
+		}
+
+		iterator _iterator_at(size_type i) noexcept {
+			if (i == _npos) return end();
+			return iterator(
+			    _impl.groups + i / _hash_group::SLOTS, unsigned(i % _hash_group::SLOTS),
+			    _impl.slots + i);
+		}
+
+		const_iterator _iterator_at(size_type i) const noexcept {
+			return const_cast<_flat_hashtable *>(this)->_iterator_at(i);
+		}
+
+	private:
+		// 最多容纳的元素个数：负载因子 7/8
+		static size_type _max_load_for(size_type groups) noexcept {
+			const size_type cap = groups * _hash_group::SLOTS - 1;
+			return cap - cap / 8;
+		}
+
+		// 最大负载不小于 n 的最小组数
+		static size_type _groups_for(size_type n) noexcept {
+			size_type g = 1;
+			while (_max_load_for(g) < n) g *= 2;
+			return g;
+		}
+
+		// 控制字节全部置空，最后一个槽位放置哨兵
+		static void _reset_ctrl(_hash_group *groups, size_type count) noexcept {
+			std::memset(static_cast<void *>(groups), 0, count * sizeof(_hash_group));
+			groups[count - 1].ctrl[_hash_group::SLOTS - 1] = _hash_group::SENTINEL;
+		}
+
+		// 对 groups（共 mask + 1 组）中每个有元素的槽位调用 f(i)
+		template <typename F>
+		static void _for_each_index(const _hash_group *groups, size_type mask, F f) {
+			for (size_type g = 0; g <= mask; ++g) {
+				uint32_t m = groups[g].match_occupied();
+				if (g == mask) m &= ~(1u << (_hash_group::SLOTS - 1));
+				for (; m; m &= m - 1) f(g * _hash_group::SLOTS + __builtin_ctz(m));
+			}
+		}
+
+		template <typename F>
+		void _for_each_index(F f) const {
+			if (_impl.groups) _for_each_index(_impl.groups, _impl.group_mask, f);
+		}
+
+		void _destroy_elements() noexcept {
+			if constexpr (!std::is_trivially_destructible_v<value_type>)
+				_for_each_index(
+				    [&](size_type i) { _slot_traits::destroy(_get_alloc(), _impl.slots + i); });
+		}
+
+		void _deallocate(_hash_group *groups, value_type *slots, size_type count) noexcept {
+			group_allocator ga(_get_alloc());
+			_group_traits::deallocate(ga, groups, count);
+			_slot_traits::deallocate(_get_alloc(), slots, count * _hash_group::SLOTS);
+		}
+
+		void _destroy_and_deallocate() noexcept {
+			if (_impl.groups == nullptr) return;
+			_destroy_elements();
+			_deallocate(_impl.groups, _impl.slots, _impl.group_mask + 1);
+			_impl.groups = nullptr;
+			_impl.slots = nullptr;
+			_impl.group_mask = _impl.size = _impl.max_load = 0;
+		}
+
+		void _steal(_flat_hashtable &x) noexcept {
+			_impl.groups = x._impl.groups;
+			_impl.slots = x._impl.slots;
+			_impl.group_mask = x._impl.group_mask;
+			_impl.size = x._impl.size;
+			_impl.max_load = x._impl.max_load;
+			x._impl.groups = nullptr;
+			x._impl.slots = nullptr;
+			x._impl.group_mask = x._impl.size = x._impl.max_load = 0;
+		}
+
+		// 分配 count 组的控制组与槽位，控制字节已初始化
+		std::pair<_hash_group *, value_type *> _allocate(size_type count) {
+			group_allocator ga(_get_alloc());
+			_hash_group    *groups = _group_traits::allocate(ga, count);
+			value_type     *slots = nullptr;
+			try {
+				slots = _slot_traits::allocate(_get_alloc(), count * _hash_group::SLOTS);
+			} catch (...) {
+				_group_traits::deallocate(ga, groups, count);
+				throw;
+			}
+			_reset_ctrl(groups, count);
+			return std::pair<_hash_group *, value_type *>(groups, slots);
+		}
+
+		void _copy_from(const _flat_hashtable &x) {
+			if (x._impl.size == 0) return;
+			const size_type count = x._impl.group_mask + 1;
+			auto            mem = _allocate(count);
+			size_type       built = 0;
+			try {
+				x._for_each_index([&](size_type i) {
+					_slot_traits::construct(_get_alloc(), mem.second + i, x._impl.slots[i]);
+					++built;
+				});
+			} catch (...) {
+				x._for_each_index([&](size_type i) {
+					if (built) {
+						_slot_traits::destroy(_get_alloc(), mem.second + i);
+						--built;
+					}
+				});
+				_deallocate(mem.first, mem.second, count);
+				throw;
+			}
+			std::memcpy(
+			    static_cast<void *>(mem.first), x._impl.groups, count * sizeof(_hash_group));
+			_impl.groups = mem.first;
+			_impl.slots = mem.second;
+			_impl.group_mask = x._impl.group_mask;
+			_impl.size = x._impl.size;
+			_impl.max_load = x._impl.max_load;
+		}
+
+		// 删除在有溢出的组中累计足够多时在原容量下重建以清除溢出位，否则容量翻倍
+		void _grow() {
+			const size_type count = _impl.groups ? _impl.group_mask + 1 : 0;
+			if (count && _impl.size < _max_load_for(count) / 2) _rehash(count);
+			else _rehash(_groups_for(_impl.size + 1));
+		}
+
+		// 元素可以逐个迁移而不抛出异常：可平凡重定位或移动构造不抛出异常，且哈希不抛出异常
+		static constexpr bool _nothrow_relocate =
+		    noexcept(std::declval<const hasher &>()(std::declval<const key_type &>())) &&
+		    (leestl::is_trivially_relocatable_v<value_type> ||
+		     std::is_nothrow_move_constructible_v<value_type>);
+
+		// 在新的 count 组中为槽位 i 的元素找一个空槽位
+		size_type _rehash_target(_hash_group *groups, size_type count, size_type i) const {
+			return _find_empty(groups, count - 1, _hash_of(Policy::key(_impl.slots[i])));
+		}
+
+		// 把槽位 i 的控制字节复制到新控制组的槽位 j
+		void _copy_ctrl(_hash_group *groups, size_type j, size_type i) const noexcept {
+			groups[j / _hash_group::SLOTS].ctrl[j % _hash_group::SLOTS] =
+			    _impl.groups[i / _hash_group::SLOTS].ctrl[i % _hash_group::SLOTS];
+		}
+
+		/**
+		 * @brief 重建为 count 组
+		 *
+		 * 	迁移不会抛出异常时，元素逐个移动到新槽位并随即销毁原元素。
+		 * 	否则先用 move_if_noexcept 把全部元素构造到新槽位（flat_hash_map 的键是 const 的，因此会复制键），
+		 * 	全部成功后才销毁原元素；中途抛出异常时销毁已构造的新元素并释放新空间，原表保持不变
+		 *
+		 * @param count 新的组数，为 2 的幂
+		 */
+		void _rehash(size_type count) {
+			auto mem = _allocate(count);
+			if constexpr (_nothrow_relocate) {
+				_for_each_index([&](size_type i) {
+					value_type     *src = _impl.slots + i;
+					const size_type j = _rehash_target(mem.first, count, i);
+					if constexpr (leestl::is_trivially_relocatable_v<value_type>) {
+						std::memcpy(
+						    static_cast<void *>(mem.second + j), static_cast<const void *>(src),
+						    sizeof(value_type));
+					} else {
+						_slot_traits::construct(_get_alloc(), mem.second + j, leestl::move(*src));
+						_slot_traits::destroy(_get_alloc(), src);
+					}
+					_copy_ctrl(mem.first, j, i);
+				});
+			} else {
+				try {
+					_for_each_index([&](size_type i) {
+						const size_type j = _rehash_target(mem.first, count, i);
+						_slot_traits::construct(
+						    _get_alloc(), mem.second + j, std::move_if_noexcept(_impl.slots[i]));
+						_copy_ctrl(mem.first, j, i);
+					});
+				} catch (...) {
+					// 只有控制字节已写入的槽位上构造了元素
+					_for_each_index(mem.first, count - 1, [&](size_type j) {
+						_slot_traits::destroy(_get_alloc(), mem.second + j);
+					});
+					_deallocate(mem.first, mem.second, count);
+					throw;
+				}
+				_destroy_elements();
+			}
+			if (_impl.groups) _deallocate(_impl.groups, _impl.slots, _impl.group_mask + 1);
+			_impl.groups = mem.first;
+			_impl.slots = mem.second;
+			_impl.group_mask = count - 1;
+			_impl.max_load = _max_load_for(count);
+		}
+	};
+
+	/**
+	 * @brief 比较两个哈希表是否包含相同的元素
+	 */
+	template <typename Policy, typename Hash, typename KeyEqual, typename Alloc>
+	bool operator==(
+	    const _flat_hashtable<Policy, Hash, KeyEqual, Alloc> &x,
+	    const _flat_hashtable<Policy, Hash, KeyEqual, Alloc> &y) {
+		if (x.size() != y.size()) return false;
+		for (const auto &v : x) {
+			auto it = y.find(Policy::key(v));
+			if (it == y.end() || !(*it == v)) return false;
+		}
+		return true;
+	}
+
+	template <typename Policy, typename Hash, typename KeyEqual, typename Alloc>
+	bool operator!=(
+	    const _flat_hashtable<Policy, Hash, KeyEqual, Alloc> &x,
+	    const _flat_hashtable<Policy, Hash, KeyEqual, Alloc> &y) {
+		return !(x == y);
+	}
+
+}    // namespace leestl
+
+#endif
@@ -77,6 +77,10 @@ namespace leestl {
 	using RequireInputIterator = typename std::enable_if<
 	    std::is_convertible<iterator_category_types<_Iter>, input_interator_tag>::value>::type;
 
+	template <typename _Iter>
+	using RequireRandomAccessIterator = typename std::enable_if<std::is_convertible<
+	    iterator_category_types<_Iter>, random_acess_interator_tag>::value>::type;
+
 	// 使用于输入迭代器的 distance 实现
 	template <typename _IT>
 	inline constexpr typename iterator_traits<_IT>::difference_type _distance(
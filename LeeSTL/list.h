@@ -0,0 +1,1052 @@
+/** @file list.h
+ * 	这个文件实现双向链表容器 list
+ *
+ * 	结点不逐个向配置器申请，而是取自容器自己的结点池：结点池一次申请一整块 slab
+ * 	（大小从约 1KB 起按 2 倍增长到约 64KB），切成结点放入空闲链表；删除的结点回到空闲链表，
+ * 	下次插入直接复用，频繁增删时不再调用配置器。批量插入 n 个元素且空闲结点不足时，
+ * 	申请一块至少能容纳 n 个结点的 slab，新结点在内存中连续且按地址顺序链接。
+ * 	结点池的内存在容器析构时整体释放，元素被删除后结点只回到空闲链表。
+ *
+ * 	不同的 list 默认各自使用独立的结点池，可以在不同线程中分别修改。splice、merge
+ * 	从另一个 list 取得元素时，把元素移动构造到本容器池中的新结点上再删除原结点，
+ * 	复杂度为 O(n)，指向被转移元素的迭代器失效。需要 O(1) 转移且迭代器保持有效时，
+ * 	先调用 share_pool 让两个容器共用一个结点池（引用计数，最后一个使用者析构时释放），
+ * 	此后两者之间只修改结点链接；共用结点池的容器不能在不同线程中同时修改。
+ * 	与 std::list 一样，splice、merge 要求两个容器的配置器相等。
+ */
+
+#ifndef _LEESTL_LIST_H_
+#define _LEESTL_LIST_H_ 1
+
+#include <functional>
+#include <initializer_list>
+#include <new>
+
+#include "algobase.h"
+#include "alloc_traits.h"
+#include "allocator.h"
+#include "iterator.h"
+#include "utils.h"
+
+namespace leestl {
+
+	enum { _LIST_FIRST_SLAB_BYTES = 1024 };       // 第一块 slab 的目标大小
+	enum { _LIST_MAX_SLAB_BYTES = 64 * 1024 };    // 按 2 倍增长的 slab 的最大大小
+
+	struct _list_node_base {
+		_list_node_base *prev;
+		_list_node_base *next;    // 空闲结点用它链接空闲链表
+	};
+
+	template <typename T>
+	struct _list_node : _list_node_base {
+		alignas(T) unsigned char storage[sizeof(T)];
+
+		T       *valptr() noexcept { return reinterpret_cast<T *>(storage); }
+		const T *valptr() const noexcept { return reinterpret_cast<const T *>(storage); }
+	};
+
+	// slab 的头部，占用 slab 的第一个结点位置
+	struct _list_slab {
+		_list_slab *next;
+		size_t      count;    // 结点个数，不含头部
+	};
+
+	// 结点池，可由调用过 share_pool 的多个 list 共享
+	struct _list_pool {
+		size_t           refs;          // 引用计数
+		_list_pool      *forward;       // 已并入的池，非空时本池不再持有内存
+		_list_slab      *slabs;         // 已申请的 slab
+		_list_node_base *free;          // 空闲结点链表
+		_list_node_base *free_tail;     // 空闲结点链表的最后一个结点，链表非空时有效
+		size_t           free_count;    // 空闲结点个数
+		size_t           next_slab;     // 下一块 slab 的结点个数
+	};
+
+	/**
+	 * @brief list 的双向迭代器
+	 *
+	 * @tparam T 元素类型
+	 * @tparam Const 是否只读
+	 */
+	template <typename T, bool Const>
+	class _list_iterator {
+		template <typename, typename>
+		friend class list;
+		template <typename, bool>
+		friend class _list_iterator;
+
+	public:
+		typedef bidirectional_interator_tag               iterator_category;
+		typedef T                                         value_type;
+		typedef ptrdiff_t                                 difference_type;
+		typedef std::conditional_t<Const, const T *, T *> pointer;
+		typedef std::conditional_t<Const, const T &, T &> reference;
+
+		_list_iterator() noexcept = default;
+
+		// 可写迭代器可以转换为只读迭代器
+		template <bool C, typename = std::enable_if_t<Const && !C>>
+		_list_iterator(const _list_iterator<T, C> &x) noexcept : _node(x._node) {}
+
+		reference operator*() const noexcept { return *operator->(); }
+		pointer   operator->() const noexcept {
+			return static_cast<_list_node<T> *>(_node)->valptr();
+		}
+
+		_list_iterator &operator++() noexcept {
+			_node = _node->next;
+			return *this;
+		}
+
+		_list_iterator operator++(int) noexcept {
+			_list_iterator tmp = *this;
+			_node = _node->next;
+			return tmp;
+		}
+
+		_list_iterator &operator--() noexcept {
+			_node = _node->prev;
+			return *this;
+		}
+
+		_list_iterator operator--(int) noexcept {
+			_list_iterator tmp = *this;
+			_node = _node->prev;
+			return tmp;
+		}
+
+		template <bool C>
+		bool operator==(const _list_iterator<T, C> &x) const noexcept {
+			return _node == x._node;
+		}
+
+		template <bool C>
+		bool operator!=(const _list_iterator<T, C> &x) const noexcept {
+			return _node != x._node;
+		}
+
+	private:
+		_list_node_base *_node = nullptr;
+
+		explicit _list_iterator(_list_node_base *node) noexcept : _node(node) {}
+	};
+
+	/**
+	 * @brief 结点取自结点池的双向循环链表
+	 *
+	 * @tparam T 元素类型
+	 * @tparam Alloc 配置器类型
+	 */
+	template <typename T, typename Alloc = leestl::allocator<T>>
+	class list {
+	public:
+		typedef Alloc allocator_type;    // 配置器类型
+		typedef typename leestl::allocator_traits<Alloc>::template rebind_alloc<T> data_allocator;
+
+	private:
+		typedef _list_node<T>                                        _node;
+		typedef leestl::allocator_traits<data_allocator>             _alloc_traits;
+		typedef typename _alloc_traits::template rebind_alloc<_node> node_allocator;
+		typedef leestl::allocator_traits<node_allocator>             _node_traits;
+		typedef typename _alloc_traits::template rebind_alloc<_list_pool> pool_allocator;
+		typedef leestl::allocator_traits<pool_allocator>                  _pool_traits;
+
+		static constexpr size_t _fit(size_t bytes) noexcept {
+			return bytes / sizeof(_node) < 4 ? 4 : bytes / sizeof(_node);
+		}
+		static constexpr size_t _FIRST_SLAB = _fit(_LIST_FIRST_SLAB_BYTES);
+		static constexpr size_t _MAX_SLAB = _fit(_LIST_MAX_SLAB_BYTES);
+
+	public:
+		typedef T                                       value_type;
+		typedef typename _alloc_traits::size_type       size_type;
+		typedef typename _alloc_traits::difference_type difference_type;
+		typedef T                                      *pointer;
+		typedef const T                                *const_pointer;
+		typedef value_type                             &reference;
+		typedef const value_type                       &const_reference;
+
+		typedef _list_iterator<T, false>                 iterator;
+		typedef _list_iterator<T, true>                  const_iterator;
+		typedef leestl::reverse_iterator<iterator>       reverse_iterator;
+		typedef leestl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+		allocator_type get_allocator() const noexcept { return allocator_type(_get_alloc()); }
+
+	private:
+		// 继承配置器以利用空基类优化，无状态配置器不占用额外空间。
+		// 哨兵结点 header 内嵌在容器中，空链表的 header 指向自己，默认构造不分配内存
+		struct _list_impl : public data_allocator {
+			_list_node_base header;
+			size_type       size = 0;
+			_list_pool     *pool = nullptr;    // 第一次插入时才创建
+
+			_list_impl() noexcept(std::is_nothrow_default_constructible<data_allocator>::value)
+			        : data_allocator() {
+				header.prev = header.next = &header;
+			}
+			_list_impl(const data_allocator &a) noexcept : data_allocator(a) {
+				header.prev = header.next = &header;
+			}
+			_list_impl(data_allocator &&a) noexcept : data_allocator(leestl::move(a)) {
+				header.prev = header.next = &header;
+			}
+
+			// 交换结点、元素个数与结点池，不交换配置器；结点首尾的指针改为指向新的 header
+			void _swap_data(_list_impl &x) noexcept {
+				leestl::swap(header.prev, x.header.prev);
+				leestl::swap(header.next, x.header.next);
+				_fix_header(header, x.header);
+				_fix_header(x.header, header);
+				leestl::swap(size, x.size);
+				leestl::swap(pool, x.pool);
+			}
+
+			// h 由 old 交换而来：old 为空时 h 置空，否则让首尾结点指向 h
+			static void _fix_header(_list_node_base &h, _list_node_base &old) noexcept {
+				if (h.next == &old) h.prev = h.next = &h;
+				else h.next->prev = h.prev->next = &h;
+			}
+		};
+
+		_list_impl _impl;
+
+		data_allocator       &_get_alloc() noexcept { return _impl; }
+		const data_allocator &_get_alloc() const noexcept { return _impl; }
+
+	public:
+		/**
+		 * @brief list 默认构造函数，不分配空间
+		 *
+		 */
+		list() = default;
+
+		/**
+		 * @brief 指定配置器的 list 构造函数
+		 *
+		 * @param alloc 配置器
+		 */
+		explicit list(const allocator_type &alloc) noexcept : _impl(data_allocator(alloc)) {}
+
+		/**
+		 * @brief 给出大小的 list 构造函数，元素值初始化，结点取自同一块 slab
+		 *
+		 * @param n list 的大小
+		 * @param alloc 配置器
+		 */
+		explicit list(size_type n, const allocator_type &alloc = allocator_type())
+		        : _impl(data_allocator(alloc)) {
+			_guarded([&] { _bulk_insert(end(), n, _value_init()); });
+		}
+
+		/**
+		 * @brief 给出大小、初始值的 list 构造函数
+		 *
+		 * @param n list 的大小
+		 * @param value 初始值
+		 * @param alloc 配置器
+		 */
+		list(size_type n, const value_type &value, const allocator_type &alloc = allocator_type())
+		        : _impl(data_allocator(alloc)) {
+			_guarded([&] { insert(end(), n, value); });
+		}
+
+		/**
+		 * @brief 通过迭代器区间构造 list
+		 *
+		 * @tparam _II 迭代器类型
+		 * @param first 区间起始
+		 * @param last 区间终止
+		 * @param alloc 配置器
+		 */
+		template <typename _II, typename = leestl::RequireInputIterator<_II>>
+		list(_II first, _II last, const allocator_type &alloc = allocator_type())
+		        : _impl(data_allocator(alloc)) {
+			_guarded([&] { insert(end(), first, last); });
+		}
+
+		/**
+		 * @brief 通过初始化列表构造 list
+		 *
+		 * @param il 初始化列表
+		 * @param alloc 配置器
+		 */
+		list(std::initializer_list<value_type> il, const allocator_type &alloc = allocator_type())
+		        : _impl(data_allocator(alloc)) {
+			_guarded([&] { insert(end(), il.begin(), il.end()); });
+		}
+
+		/**
+		 * @brief 复制构造函数，配置器由 select_on_container_copy_construction 决定
+		 *
+		 * @param x 要复制的 list
+		 */
+		list(const list &x)
+		        : _impl(_alloc_traits::select_on_container_copy_construction(x._get_alloc())) {
+			_guarded([&] { insert(end(), x.begin(), x.end()); });
+		}
+
+		/**
+		 * @brief 指定配置器的复制构造函数
+		 *
+		 * @param x 要复制的 list
+		 * @param alloc 配置器
+		 */
+		list(const list &x, const allocator_type &alloc) : _impl(data_allocator(alloc)) {
+			_guarded([&] { insert(end(), x.begin(), x.end()); });
+		}
+
+		/**
+		 * @brief 移动构造函数，接管 x 的结点与结点池
+		 */
+		list(list &&x) noexcept : _impl(leestl::move(x._get_alloc())) { _impl._swap_data(x._impl); }
+
+		/**
+		 * @brief 指定配置器的移动构造函数，配置器不相等时只能逐个移动元素
+		 *
+		 * @param x 要移动的 list
+		 * @param alloc 配置器
+		 */
+		list(list &&x, const allocator_type &alloc) : _impl(data_allocator(alloc)) {
+			if (_alloc_traits::equal(_get_alloc(), x._get_alloc())) {
+				_impl._swap_data(x._impl);
+			} else {
+				_guarded([&] {
+					iterator it = x.begin();
+					_bulk_insert(end(), x.size(), [&](T *p) {
+						_alloc_traits::construct(_get_alloc(), p, leestl::move(*it));
+						++it;
+					});
+				});
+				x.clear();
+			}
+		}
+
+		~list() noexcept {
+			clear();
+			_release_pool(_impl.pool);
+		}
+
+		// 复制赋值，复用已有结点；propagate_on_container_copy_assignment 为真时同时复制配置器
+		list &operator=(const list &x) {
+			if (this != &x) {
+				if constexpr (_alloc_traits::propagate_on_container_copy_assignment::value) {
+					if (!_alloc_traits::equal(_get_alloc(), x._get_alloc())) {
+						// 旧配置器无法释放新配置器分配的空间，先用旧配置器释放全部空间
+						clear();
+						_release_pool(_impl.pool);
+						_impl.pool = nullptr;
+					}
+					_get_alloc() = x._get_alloc();
+				}
+				assign(x.begin(), x.end());
+			}
+			return *this;
+		}
+
+		// 移动赋值，配置器可传播或相等时直接接管结点，否则逐个移动元素
+		list &operator=(list &&x) noexcept(
+		    _alloc_traits::propagate_on_container_move_assignment::value ||
+		    _alloc_traits::is_always_equal::value) {
+			if (this != &x) {
+				if constexpr (_alloc_traits::propagate_on_container_move_assignment::value) {
+					_move_assign(x);
+					_get_alloc() = leestl::move(x._get_alloc());
+				} else if (_alloc_traits::equal(_get_alloc(), x._get_alloc())) {
+					_move_assign(x);
+				} else {
+					list tmp(leestl::move(x), _get_alloc());    // 用本容器的配置器逐个移动元素
+					_move_assign(tmp);
+				}
+			}
+			return *this;
+		}
+
+		// 初始化列表赋值
+		list &operator=(std::initializer_list<value_type> il) {
+			assign(il.begin(), il.end());
+			return *this;
+		}
+
+		// 以 n 个 value 替换全部元素
+		void assign(size_type n, const value_type &value) {
+			iterator it = begin();
+			for (; it != end() && n > 0; ++it, --n) *it = value;
+			if (n > 0) insert(end(), n, value);
+			else erase(it, end());
+		}
+
+		// 以区间 [first, last) 替换全部元素，复用已有结点
+		template <typename _II, typename = leestl::RequireInputIterator<_II>>
+		void assign(_II first, _II last) {
+			iterator it = begin();
+			for (; it != end() && first != last; ++it, (void)++first) *it = *first;
+			if (first == last) erase(it, end());
+			else insert(end(), first, last);
+		}
+
+		void assign(std::initializer_list<value_type> il) { assign(il.begin(), il.end()); }
+
+		// 迭代器相关操作
+		iterator               begin() noexcept { return iterator(_impl.header.next); }
+		const_iterator         begin() const noexcept { return const_iterator(_impl.header.next); }
+		iterator               end() noexcept { return iterator(&_impl.header); }
+		const_iterator         end() const noexcept { return const_iterator(_header()); }
+		reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+		const_iterator         cbegin() const noexcept { return begin(); }
+		const_iterator         cend() const noexcept { return end(); }
+		const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+		const_reverse_iterator crend() const noexcept { return rend(); }
+
+		// 容量相关操作
+		bool      empty() const noexcept { return _impl.size == 0; }
+		size_type size() const noexcept { return _impl.size; }
+		size_type max_size() const noexcept {
+			return _node_traits::max_size(node_allocator(_get_alloc()));
+		}
+
+		/**
+		 * @brief 预留结点，使元素个数增长到 n 之前不再申请内存；新结点在一块 slab 中连续
+		 *
+		 * @param n 需要的容量
+		 */
+		void reserve(size_type n) {
+			if (n > _impl.size) _reserve_nodes(n - _impl.size);
+		}
+
+		/**
+		 * @brief 改变元素个数，新增的元素值初始化
+		 *
+		 * @param n 新的元素个数
+		 */
+		void resize(size_type n) {
+			if (n < _impl.size) erase(_at_back(_impl.size - n), end());
+			else _bulk_insert(end(), n - _impl.size, _value_init());
+		}
+
+		/**
+		 * @brief 改变元素个数，新增的元素复制自 value
+		 *
+		 * @param n 新的元素个数
+		 * @param value 新增元素的初始值
+		 */
+		void resize(size_type n, const value_type &value) {
+			if (n < _impl.size) erase(_at_back(_impl.size - n), end());
+			else insert(end(), n - _impl.size, value);
+		}
+
+		// 元素访问相关操作
+		reference       front() noexcept { return *begin(); }
+		const_reference front() const noexcept { return *begin(); }
+		reference       back() noexcept { return *iterator(_impl.header.prev); }
+		const_reference back() const noexcept { return *const_iterator(_impl.header.prev); }
+
+		// 修改容器相关操作
+		void push_back(const value_type &value) { emplace_back(value); }
+		void push_back(value_type &&value) { emplace_back(leestl::move(value)); }
+		void push_front(const value_type &value) { emplace_front(value); }
+		void push_front(value_type &&value) { emplace_front(leestl::move(value)); }
+
+		template <typename... Args>
+		reference emplace_back(Args &&...args) {
+			return *emplace(cend(), leestl::forward<Args>(args)...);
+		}
+
+		template <typename... Args>
+		reference emplace_front(Args &&...args) {
+			return *emplace(cbegin(), leestl::forward<Args>(args)...);
+		}
+
+		void pop_back() noexcept { _erase_node(_impl.header.prev); }
+		void pop_front() noexcept { _erase_node(_impl.header.next); }
+
+		/**
+		 * @brief 在 pos 之前直接构造元素
+		 *
+		 * @param pos 插入位置
+		 * @param args 构造参数
+		 * @return iterator 新元素的位置
+		 */
+		template <typename... Args>
+		iterator emplace(const_iterator pos, Args &&...args) {
+			_node *node = _get_node();
+			try {
+				_alloc_traits::construct(
+				    _get_alloc(), node->valptr(), leestl::forward<Args>(args)...);
+			} catch (...) {
+				_put_node(node);
+				throw;
+			}
+			_link_range(pos._node, node, node);
+			++_impl.size;
+			return iterator(node);
+		}
+
+		// 插入元素
+		iterator insert(const_iterator pos, const value_type &value) { return emplace(pos, value); }
+		iterator insert(const_iterator pos, value_type &&value) {
+			return emplace(pos, leestl::move(value));
+		}
+
+		// 填充插入，结点取自同一块 slab
+		iterator insert(const_iterator pos, size_type n, const value_type &value) {
+			return _bulk_insert(
+			    pos, n, [&](T *p) { _alloc_traits::construct(_get_alloc(), p, value); });
+		}
+
+		// 范围插入：前向迭代器的结点取自同一块 slab，输入迭代器先构造临时 list 再转移
+		template <typename _II, typename = leestl::RequireInputIterator<_II>>
+		iterator insert(const_iterator pos, _II first, _II last) {
+			if constexpr (std::is_convertible<
+			                  leestl::iterator_category_types<_II>,
+			                  leestl::forward_interator_tag>::value) {
+				return _bulk_insert(pos, size_type(leestl::distance(first, last)), [&](T *p) {
+					_alloc_traits::construct(_get_alloc(), p, *first);
+					++first;
+				});
+			} else {
+				list tmp(get_allocator());
+				tmp.share_pool(*this);    // 临时链表的结点取自本容器的池，转移时只修改链接
+				for (; first != last; ++first) tmp.emplace_back(*first);
+				iterator it = tmp.begin();
+				splice(pos, tmp);
+				return it;
+			}
+		}
+
+		// 初始化列表插入
+		iterator insert(const_iterator pos, std::initializer_list<value_type> il) {
+			return insert(pos, il.begin(), il.end());
+		}
+
+		// 删除 pos 处的元素，返回下一个位置
+		iterator erase(const_iterator pos) noexcept {
+			_list_node_base *next = pos._node->next;
+			_erase_node(pos._node);
+			return iterator(next);
+		}
+
+		// 删除 [first, last) 中的元素，返回 last
+		iterator erase(const_iterator first, const_iterator last) noexcept {
+			while (first != last) first = erase(first);
+			return iterator(last._node);
+		}
+
+		// 交换两个 list，propagate_on_container_swap 为真时同时交换配置器
+		void swap(list &x) noexcept {
+			_impl._swap_data(x._impl);
+			if constexpr (_alloc_traits::propagate_on_container_swap::value)
+				leestl::swap(_get_alloc(), x._get_alloc());
+		}
+
+		// 销毁所有元素，结点回到空闲链表
+		void clear() noexcept {
+			_list_node_base *node = _impl.header.next;
+			while (node != &_impl.header) {
+				_list_node_base *next = node->next;
+				_alloc_traits::destroy(_get_alloc(), static_cast<_node *>(node)->valptr());
+				_put_node(static_cast<_node *>(node));
+				node = next;
+			}
+			_impl.header.prev = _impl.header.next = &_impl.header;
+			_impl.size = 0;
+		}
+
+		// 链表操作
+		/**
+		 * @brief 让本容器与 x 共用一个结点池，此后两者之间的 splice、merge 只修改结点链接，
+		 * 	不移动元素，迭代器仍然有效。共用结点池的容器不能在不同线程中同时修改
+		 *
+		 * @param x 另一个 list，配置器须与本容器相等
+		 */
+		void share_pool(list &x) {
+			if (this == &x) return;
+			if (_pool() == nullptr) _create_pool();
+			x._share_pool(*this);
+		}
+
+		/**
+		 * @brief 把 x 的全部元素移到 pos 之前；未与 x 共用结点池时逐个移动元素
+		 *
+		 * @param pos 插入位置
+		 * @param x 另一个 list，配置器须与本容器相等
+		 */
+		void splice(const_iterator pos, list &x) {
+			if (x.empty() || this == &x) return;
+			_take(pos, x, x.begin(), x.end(), x._impl.size);
+		}
+
+		void splice(const_iterator pos, list &&x) { splice(pos, x); }
+
+		// 把 x 中 it 处的元素移到 pos 之前
+		void splice(const_iterator pos, list &x, const_iterator it) {
+			_list_node_base *next = it._node->next;
+			if (pos._node == it._node || pos._node == next) return;
+			if (this != &x) _take(pos, x, it, const_iterator(next), 1);
+			else _transfer(pos._node, it._node, next);
+		}
+
+		void splice(const_iterator pos, list &&x, const_iterator it) { splice(pos, x, it); }
+
+		// 把 x 中 [first, last) 的元素移到 pos 之前，来自另一个 list 时需要 O(n) 计数
+		void splice(const_iterator pos, list &x, const_iterator first, const_iterator last) {
+			if (first == last) return;
+			if (this != &x) _take(pos, x, first, last, size_type(leestl::distance(first, last)));
+			else _transfer(pos._node, first._node, last._node);
+		}
+
+		void splice(const_iterator pos, list &&x, const_iterator first, const_iterator last) {
+			splice(pos, x, first, last);
+		}
+
+		// 删除所有等于 value 的元素，返回删除的个数
+		size_type remove(const value_type &value) {
+			return remove_if([&](const value_type &v) { return v == value; });
+		}
+
+		// 删除所有满足 pred 的元素，返回删除的个数
+		template <typename Predicate>
+		size_type remove_if(Predicate pred) {
+			const size_type old_size = _impl.size;
+			if (old_size == 0) return 0;
+			// value 可能引用容器内的元素，先把要删除的结点移到末尾，最后一起删除
+			list removed(get_allocator());
+			removed.share_pool(*this);
+			for (iterator it = begin(); it != end();) {
+				iterator next = it;
+				++next;
+				if (pred(*it)) removed.splice(removed.end(), *this, it);
+				it = next;
+			}
+			return old_size - _impl.size;
+		}
+
+		// 删除相邻的重复元素，返回删除的个数
+		size_type unique() { return unique(std::equal_to<>()); }
+
+		template <typename BinaryPredicate>
+		size_type unique(BinaryPredicate pred) {
+			const size_type old_size = _impl.size;
+			if (_impl.size < 2) return 0;
+			iterator first = begin(), next = first;
+			while (++next != end()) {
+				if (pred(*first, *next)) {
+					erase(next);
+					next = first;
+				} else {
+					first = next;
+				}
+			}
+			return old_size - _impl.size;
+		}
+
+		/**
+		 * @brief 把有序的 x 合并到本容器（有序）中，稳定；与 x 共用结点池时不移动元素
+		 *
+		 * @param x 另一个有序 list，配置器须与本容器相等
+		 * @param comp 比较仿函数
+		 */
+		template <typename Compare>
+		void merge(list &x, Compare comp) {
+			if (this == &x || x.empty()) return;
+			iterator first1 = begin(), last1 = end();
+			iterator first2 = x.begin(), last2 = x.end();
+			while (first1 != last1 && first2 != last2) {
+				if (comp(*first2, *first1)) {
+					// x 中连续小于 *first1 的一段一次转移
+					iterator  next = first2;
+					size_type n = 1;
+					while (++next != last2 && comp(*next, *first1)) ++n;
+					_take(first1, x, first2, next, n);
+					first2 = next;
+				} else {
+					++first1;
+				}
+			}
+			if (first2 != last2) _take(last1, x, first2, last2, x._impl.size);
+		}
+
+		void merge(list &x) { merge(x, std::less<>()); }
+		void merge(list &&x) { merge(x, std::less<>()); }
+		template <typename Compare>
+		void merge(list &&x, Compare comp) {
+			merge(x, comp);
+		}
+
+		/**
+		 * @brief 稳定的归并排序，只修改结点的链接，不移动元素
+		 *
+		 * 	先断开为以空指针结尾的单链表，自底向上归并：bins[i] 保存 2^i 个结点的有序链，
+		 * 	每取下一个结点就像二进制加一一样向上合并；最后一次性恢复 prev 指针。
+		 * 	comp 抛出异常时全部结点重新接回容器，顺序未指定。
+		 *
+		 * @param comp 比较仿函数
+		 */
+		template <typename Compare>
+		void sort(Compare comp) {
+			if (_impl.size < 2) return;
+			_list_node_base *head = _impl.header.next;
+			_list_node_base *cur = nullptr;
+			_list_node_base *bins[64] = {};
+			size_t           fill = 0;
+			_impl.header.prev->next = nullptr;
+			try {
+				while (head) {
+					cur = head;
+					head = head->next;
+					cur->next = nullptr;
+					size_t i = 0;
+					for (; i < fill && bins[i]; ++i) {
+						_list_node_base *run = bins[i];
+						bins[i] = nullptr;
+						_merge_nodes(run, cur, comp);
+					}
+					if (i == fill) ++fill;
+					bins[i] = cur;
+					cur = nullptr;
+				}
+				for (size_t i = 0; i < fill; ++i) {
+					_list_node_base *run = bins[i];
+					bins[i] = nullptr;
+					if (!run) continue;
+					if (cur) _merge_nodes(run, cur, comp);
+					else cur = run;
+				}
+			} catch (...) {
+				for (_list_node_base *run : bins) cur = _concat(cur, run);
+				_relink(_concat(cur, head));
+				throw;
+			}
+			_relink(cur);
+		}
+
+		void sort() { sort(std::less<>()); }
+
+		// 反转元素顺序
+		void reverse() noexcept {
+			_list_node_base *node = &_impl.header;
+			do {
+				leestl::swap(node->prev, node->next);
+				node = node->prev;
+			} while (node != &_impl.header);
+		}
+
+	private:
+		_list_node_base *_header() const noexcept {
+			return const_cast<_list_node_base *>(&_impl.header);
+		}
+
+		// 在给定地址值初始化元素的构造器，用于 _bulk_insert
+		auto _value_init() noexcept {
+			return [this](T *p) { _alloc_traits::construct(_get_alloc(), p); };
+		}
+
+		// 倒数第 n 个元素
+		iterator _at_back(size_type n) noexcept {
+			iterator it = end();
+			while (n--) --it;
+			return it;
+		}
+
+		// 在构造函数中执行 f，失败时释放已分配的全部资源（析构函数不会被调用）
+		template <typename F>
+		void _guarded(F f) {
+			try {
+				f();
+			} catch (...) {
+				clear();
+				_release_pool(_impl.pool);
+				throw;
+			}
+		}
+
+		// 接管 x 的结点，x 置空
+		void _move_assign(list &x) noexcept {
+			list tmp(_get_alloc());
+			_impl._swap_data(x._impl);
+			tmp._impl._swap_data(x._impl);
+		}
+
+		/*------------------------------------- 结点池 -------------------------------------*/
+
+		// 本容器使用的池；池已并入其他池时改为直接引用最终的池
+		_list_pool *_pool() noexcept {
+			_list_pool *p = _impl.pool;
+			if (p && p->forward) {
+				_list_pool *root = p->forward;
+				while (root->forward) root = root->forward;
+				++root->refs;
+				_release_pool(p);
+				_impl.pool = p = root;
+			}
+			return p;
+		}
+
+		_list_pool *_create_pool() {
+			pool_allocator a(_get_alloc());
+			_list_pool    *p = _pool_traits::allocate(a, 1);
+			*p = _list_pool{1, nullptr, nullptr, nullptr, nullptr, 0, _FIRST_SLAB};
+			return _impl.pool = p;
+		}
+
+		// 减少 p 的引用计数，归零时释放它的全部 slab，并释放对并入的池的引用
+		void _release_pool(_list_pool *p) noexcept {
+			while (p && --p->refs == 0) {
+				_list_pool    *forward = p->forward;
+				node_allocator a(_get_alloc());
+				while (_list_slab *slab = p->slabs) {
+					p->slabs = slab->next;
+					_node_traits::deallocate(a, reinterpret_cast<_node *>(slab), slab->count + 1);
+				}
+				pool_allocator pa(_get_alloc());
+				_pool_traits::deallocate(pa, p, 1);
+				p = forward;
+			}
+		}
+
+		// 申请一块有 count 个结点的 slab，结点按地址升序排在空闲链表头部
+		void _add_slab(_list_pool *p, size_t count) {
+			node_allocator a(_get_alloc());
+			_node         *raw = _node_traits::allocate(a, count + 1);
+			p->slabs = ::new (static_cast<void *>(raw)) _list_slab{p->slabs, count};
+			for (size_t i = count; i > 0; --i) _push_free(p, raw + i);
+			if (p->next_slab < _MAX_SLAB) p->next_slab = leestl::min(p->next_slab * 2, _MAX_SLAB);
+		}
+
+		static void _push_free(_list_pool *p, _list_node_base *node) noexcept {
+			if (!p->free) p->free_tail = node;
+			node->next = p->free;
+			p->free = node;
+			++p->free_count;
+		}
+
+		// 确保至少有 n 个空闲结点；不足时申请一块能容纳全部 n 个结点的 slab，使它们连续
+		void _reserve_nodes(size_type n) {
+			_list_pool *p = _pool();
+			if (p == nullptr) p = _create_pool();
+			if (p->free_count < n) _add_slab(p, leestl::max(size_t(n), p->next_slab));
+		}
+
+		_node *_get_node() {
+			_list_pool *p = _pool();
+			if (p == nullptr) p = _create_pool();
+			if (p->free == nullptr) _add_slab(p, p->next_slab);
+			_list_node_base *node = p->free;
+			p->free = node->next;
+			--p->free_count;
+			return static_cast<_node *>(node);
+		}
+
+		void _put_node(_node *node) noexcept { _push_free(_pool(), node); }
+
+		/**
+		 * @brief 把 x（不是本容器）中长度为 n 的 [first, last) 移到 pos 之前。
+		 * 	共用结点池时只修改链接；否则把元素移动构造到本容器池中的新结点上，再删除原结点，
+		 * 	两个容器的结点池保持独立。构造失败时本容器不变，x 中的元素可能已被移动
+		 */
+		void _take(
+		    const_iterator pos, list &x, const_iterator first, const_iterator last, size_type n) {
+			if (_pool() != nullptr && _pool() == x._pool()) {
+				_transfer(pos._node, first._node, last._node);
+				_impl.size += n;
+				x._impl.size -= n;
+				return;
+			}
+			iterator it(first._node);
+			_bulk_insert(pos, n, [&](T *p) {
+				_alloc_traits::construct(_get_alloc(), p, leestl::move(*it));
+				++it;
+			});
+			x.erase(first, last);
+		}
+
+		/**
+		 * @brief 让本容器与 x 使用同一个结点池，以便在两者之间转移结点
+		 *
+		 * 	x 的池并入本容器的池：slab 与空闲结点全部移交，原来的池只留下指向新池的引用
+		 */
+		void _share_pool(list &x) noexcept {
+			_list_pool *from = x._pool();
+			_list_pool *to = _pool();
+			if (from == nullptr || from == to) return;
+			if (to == nullptr) {
+				++from->refs;
+				_impl.pool = from;
+				return;
+			}
+			if (_list_slab *slab = from->slabs) {
+				while (slab->next) slab = slab->next;
+				slab->next = to->slabs;
+				to->slabs = from->slabs;
+				from->slabs = nullptr;
+			}
+			if (from->free) {
+				if (!to->free) to->free_tail = from->free_tail;
+				from->free_tail->next = to->free;
+				to->free = from->free;
+				to->free_count += from->free_count;
+				from->free = nullptr;
+				from->free_count = 0;
+			}
+			to->next_slab = leestl::max(to->next_slab, from->next_slab);
+			from->forward = to;
+			++to->refs;
+			x._pool();
+		}
+
+		/*------------------------------------ 结点链接 ------------------------------------*/
+
+		// 把已链接好的 [first, last] 挂到 pos 之前
+		static void _link_range(
+		    _list_node_base *pos, _list_node_base *first, _list_node_base *last) noexcept {
+			_list_node_base *prev = pos->prev;
+			first->prev = prev;
+			prev->next = first;
+			last->next = pos;
+			pos->prev = last;
+		}
+
+		// 把 [first, last) 从原链表中摘下并挂到 pos 之前
+		static void _transfer(
+		    _list_node_base *pos, _list_node_base *first, _list_node_base *last) noexcept {
+			if (pos == last) return;
+			_list_node_base *tail = last->prev;
+			first->prev->next = last;
+			last->prev = first->prev;
+			_link_range(pos, first, tail);
+		}
+
+		void _erase_node(_list_node_base *node) noexcept {
+			node->prev->next = node->next;
+			node->next->prev = node->prev;
+			_alloc_traits::destroy(_get_alloc(), static_cast<_node *>(node)->valptr());
+			_put_node(static_cast<_node *>(node));
+			--_impl.size;
+		}
+
+		/**
+		 * @brief 在 pos 之前插入 n 个元素：先预留结点，把元素构造在一条独立的链上，
+		 * 	全部成功后再一次挂入，失败时容器不变
+		 *
+		 * @param construct 在给定地址构造下一个元素
+		 * @return iterator 第一个新元素的位置，n 为 0 时为 pos
+		 */
+		template <typename Construct>
+		iterator _bulk_insert(const_iterator pos, size_type n, Construct construct) {
+			if (n == 0) return iterator(pos._node);
+			_reserve_nodes(n);
+			_node          *first = nullptr;
+			_list_node_base *last = nullptr;
+			size_type        built = 0;
+			try {
+				for (; built < n; ++built) {
+					_node *node = _get_node();
+					try {
+						construct(node->valptr());
+					} catch (...) {
+						_put_node(node);
+						throw;
+					}
+					if (last) last->next = node;
+					else first = node;
+					node->prev = last;
+					last = node;
+				}
+			} catch (...) {
+				for (_list_node_base *node = first; built > 0; --built) {
+					_list_node_base *next = node->next;
+					_alloc_traits::destroy(_get_alloc(), static_cast<_node *>(node)->valptr());
+					_put_node(static_cast<_node *>(node));
+					node = next;
+				}
+				throw;
+			}
+			_link_range(pos._node, first, last);
+			_impl.size += n;
+			return iterator(first);
+		}
+
+		/*------------------------------------- 排序 -------------------------------------*/
+
+		static const T &_value(const _list_node_base *node) noexcept {
+			return *static_cast<const _node *>(node)->valptr();
+		}
+
+		/**
+		 * @brief 把以空指针结尾的有序单链表 a 合并到 b 中，结果存入 b；相等时 a 的结点在前。
+		 * 	comp 抛出异常时把剩余结点接在已合并部分之后，b 仍包含全部结点
+		 */
+		template <typename Compare>
+		static void _merge_nodes(_list_node_base *a, _list_node_base *&b, Compare &comp) {
+			_list_node_base  head;
+			_list_node_base *tail = &head;
+			_list_node_base *rest_b = b;
+			try {
+				while (a && rest_b) {
+					if (comp(_value(rest_b), _value(a))) {
+						tail->next = rest_b;
+						rest_b = rest_b->next;
+					} else {
+						tail->next = a;
+						a = a->next;
+					}
+					tail = tail->next;
+				}
+			} catch (...) {
+				tail->next = _concat(a, rest_b);
+				b = head.next;
+				throw;
+			}
+			tail->next = a ? a : rest_b;
+			b = head.next;
+		}
+
+		// 连接两条以空指针结尾的单链表
+		static _list_node_base *_concat(_list_node_base *a, _list_node_base *b) noexcept {
+			if (!a) return b;
+			_list_node_base *tail = a;
+			while (tail->next) tail = tail->next;
+			tail->next = b;
+			return a;
+		}
+
+		// 把以空指针结尾的单链表重新接回 header，并恢复 prev 指针
+		void _relink(_list_node_base *first) noexcept {
+			_list_node_base *prev = &_impl.header;
+			for (_list_node_base *node = first; node; node = node->next) {
+				prev->next = node;
+				node->prev = prev;
+				prev = node;
+			}
+			prev->next = &_impl.header;
+			_impl.header.prev = prev;
+		}
+	};
+
+	template <typename T, typename Alloc>
+	inline bool operator==(const list<T, Alloc> &x, const list<T, Alloc> &y) {
+		return x.size() == y.size() && leestl::equal(x.begin(), x.end(), y.begin());
+	}
+
+	template <typename T, typename Alloc>
+	inline bool operator!=(const list<T, Alloc> &x, const list<T, Alloc> &y) {
+		return !(x == y);
+	}
+
+	template <typename T, typename Alloc>
+	inline bool operator<(const list<T, Alloc> &x, const list<T, Alloc> &y) {
+		return leestl::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+	}
+
+	template <typename T, typename Alloc>
+	inline void swap(list<T, Alloc> &x, list<T, Alloc> &y) noexcept {
+		x.swap(y);
+	}
+
+}    // namespace leestl
+
+#endif
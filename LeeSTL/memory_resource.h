@@ -0,0 +1,214 @@
+/** @file memory_resource.h
+ * 	这个文件实现单调增长的内存资源（bump-pointer arena）及其对象配置器
+ *
+ * 	monotonic_buffer_resource 从一串按几何级数增长的内存块中顺序切割空间，
+ * 	释放单个对象为空操作，所有空间在 release() 或析构时一次性归还，
+ * 	适合“构造一批临时容器、用完整体丢弃”的请求级场景。
+ */
+
+#ifndef _LEESTL_MEMORY_RESOURCE_H_
+#define _LEESTL_MEMORY_RESOURCE_H_ 1
+
+#include <cstddef>
+#include <cstdint>
+
+#include "alloc.h"
+#include "alloc_traits.h"
+
+namespace leestl {
+
+	/**
+	 * @brief 单调增长的内存资源，从上游配置器申请内存块，块内以移动指针的方式分配
+	 *
+	 * @tparam Upstream 上游字节配置器，默认为第一级配置器
+	 */
+	template <typename Upstream = leestl::malloc_alloc>
+	class basic_monotonic_buffer_resource {
+	private:
+		// 从上游申请的内存块头部，块之间组成单向链表
+		struct _chunk_header {
+			_chunk_header *next;
+			size_t         size;    // 整块大小，包括头部
+		};
+
+		enum { _DEFAULT_CHUNK = 1024 };
+		static constexpr size_t _GROWTH_FACTOR = 2;
+
+		char          *_current;        // 当前块中下一次分配的位置
+		char          *_end;            // 当前块的结束位置
+		_chunk_header *_chunks;         // 已申请内存块组成的链表
+		void          *_initial_buf;    // 用户提供的初始缓冲区，不归本资源释放
+		size_t         _initial_size;
+		size_t         _initial_next_size;    // 构造时的首块大小，release 后从它重新增长
+		size_t         _next_size;            // 下一次向上游申请的块大小
+
+		// 当前块空间不足，向上游申请新块
+		void _new_chunk(size_t bytes, size_t align) {
+			size_t need = bytes + align + sizeof(_chunk_header);
+			size_t size = _next_size > need ? _next_size : need;
+
+			_chunk_header *chunk = static_cast<_chunk_header *>(Upstream::allocate(size));
+			chunk->next = _chunks;
+			chunk->size = size;
+			_chunks = chunk;
+
+			_current = reinterpret_cast<char *>(chunk + 1);
+			_end = reinterpret_cast<char *>(chunk) + size;
+			_next_size = size * _GROWTH_FACTOR;
+		}
+
+		// 计算 ptr 按 align 上调后的位置
+		static char *_align_up(char *ptr, size_t align) {
+			uintptr_t p = reinterpret_cast<uintptr_t>(ptr);
+			return reinterpret_cast<char *>((p + align - 1) & ~(uintptr_t(align) - 1));
+		}
+
+	public:
+		/**
+		 * @brief 构造内存资源，第一次分配时才向上游申请内存
+		 *
+		 * @param initial_size 第一个内存块的大小
+		 */
+		explicit basic_monotonic_buffer_resource(size_t initial_size = _DEFAULT_CHUNK) noexcept :
+		        _current(nullptr), _end(nullptr), _chunks(nullptr), _initial_buf(nullptr),
+		        _initial_size(0), _initial_next_size(initial_size ? initial_size : 1),
+		        _next_size(_initial_next_size) {}
+
+		/**
+		 * @brief 使用用户提供的缓冲区（例如栈上数组）作为第一块空间
+		 *
+		 * @param buffer 初始缓冲区
+		 * @param size 初始缓冲区大小
+		 */
+		basic_monotonic_buffer_resource(void *buffer, size_t size) noexcept :
+		        _current(static_cast<char *>(buffer)), _end(static_cast<char *>(buffer) + size),
+		        _chunks(nullptr), _initial_buf(buffer), _initial_size(size),
+		        _initial_next_size(size * _GROWTH_FACTOR > size_t(_DEFAULT_CHUNK)
+		                               ? size * _GROWTH_FACTOR
+		                               : size_t(_DEFAULT_CHUNK)),
+		        _next_size(_initial_next_size) {}
+
+		basic_monotonic_buffer_resource(const basic_monotonic_buffer_resource &) = delete;
+		basic_monotonic_buffer_resource &operator=(const basic_monotonic_buffer_resource &) = delete;
+
+		~basic_monotonic_buffer_resource() { release(); }
+
+		/**
+		 * @brief 分配 bytes 字节、按 align 对齐的空间
+		 *
+		 * @param bytes 字节数
+		 * @param align 对齐要求，必须为 2 的幂
+		 * @return void* 分配到的空间
+		 */
+		void *allocate(size_t bytes, size_t align = alignof(std::max_align_t)) {
+			char *p = _align_up(_current, align);
+			if (__builtin_expect(_current == nullptr || p + bytes > _end, false)) {
+				_new_chunk(bytes, align);
+				p = _align_up(_current, align);
+			}
+			_current = p + bytes;
+			return p;
+		}
+
+		// 单调资源不回收单个对象
+		void deallocate(void *, size_t, size_t = alignof(std::max_align_t)) noexcept {}
+
+		/**
+		 * @brief 把所有内存块归还上游，回到初始缓冲区（若有）重新开始分配
+		 */
+		void release() noexcept {
+			while (_chunks != nullptr) {
+				_chunk_header *next = _chunks->next;
+				Upstream::deallocate(_chunks, _chunks->size);
+				_chunks = next;
+			}
+			// 重置后从构造时的块大小重新开始增长，避免反复填满、释放时块大小无限膨胀
+			_next_size = _initial_next_size;
+			_current = static_cast<char *>(_initial_buf);
+			_end = _current + _initial_size;
+		}
+
+		// 已从上游申请的字节数
+		size_t upstream_bytes() const noexcept {
+			size_t total = 0;
+			for (_chunk_header *c = _chunks; c != nullptr; c = c->next) total += c->size;
+			return total;
+		}
+	};
+
+	typedef basic_monotonic_buffer_resource<> monotonic_buffer_resource;
+
+	template <size_t N>
+	struct _aligned_buffer_holder {
+		alignas(std::max_align_t) char _buf[N];
+	};
+
+	/**
+	 * @brief 自带 N 字节初始缓冲区的单调内存资源，作为局部变量使用时初始空间位于栈上
+	 *
+	 * @tparam N 初始缓冲区大小
+	 */
+	template <size_t N>
+	class stack_buffer_resource : private _aligned_buffer_holder<N>,
+	                              public monotonic_buffer_resource {
+	public:
+		stack_buffer_resource() noexcept :
+		        monotonic_buffer_resource(_aligned_buffer_holder<N>::_buf, N) {}
+	};
+
+	/**
+	 * @brief 从单调内存资源分配对象的有状态配置器，可作为容器的 Alloc 模板参数
+	 *
+	 * @tparam T 对象类型
+	 * @tparam Resource 内存资源类型
+	 */
+	template <typename T, typename Resource = monotonic_buffer_resource>
+	class arena_allocator {
+	public:
+		typedef T         value_type;
+		typedef size_t    size_type;
+		typedef ptrdiff_t difference_type;
+		typedef T        *pointer;
+		typedef const T  *const_pointer;
+		typedef T        &reference;
+		typedef const T  &const_reference;
+
+		// 与 pmr 一致：配置器绑定在资源上，容器复制、移动、交换时不传播
+		typedef std::false_type propagate_on_container_copy_assignment;
+		typedef std::false_type propagate_on_container_move_assignment;
+		typedef std::false_type propagate_on_container_swap;
+		typedef std::false_type is_always_equal;
+
+		template <typename U, typename R>
+		friend class arena_allocator;
+
+	private:
+		Resource *_resource;
+
+	public:
+		arena_allocator(Resource &resource) noexcept : _resource(&resource) {}
+		template <typename U>
+		arena_allocator(const arena_allocator<U, Resource> &a) noexcept : _resource(a._resource) {}
+
+		T *allocate(size_type n) {
+			return static_cast<T *>(_resource->allocate(n * sizeof(T), alignof(T)));
+		}
+		void deallocate(T *ptr, size_type n) noexcept {
+			_resource->deallocate(ptr, n * sizeof(T), alignof(T));
+		}
+
+		Resource *resource() const noexcept { return _resource; }
+
+		template <typename U>
+		bool operator==(const arena_allocator<U, Resource> &a) const noexcept {
+			return _resource == a._resource;
+		}
+		template <typename U>
+		bool operator!=(const arena_allocator<U, Resource> &a) const noexcept {
+			return _resource != a._resource;
+		}
+	};
+
+}    // namespace leestl
+
+#endif
@@ -0,0 +1,208 @@
+/** @file parallel_algo.h
+ * 	这个文件实现 sort、stable_sort 接受执行策略的版本
+ *
+ * 	并行排序为样本排序（sample sort）：等间距取样选出分割元素，各线程对自己的一段元素分类并计数，
+ * 	按“桶优先、段次之”的顺序求前缀和后并行分配到缓冲区，最后各线程动态领取桶，
+ * 	在桶内调用顺序排序并移回原区间。与分割元素相等的元素单独成桶，无需再排序，
+ * 	重复元素很多时也不会出现过大的桶。分配过程保持元素原有的相对顺序，因此 stable_sort
+ * 	的结果与顺序版本完全相同；sort 的结果只在相等元素可以区分时才可能与顺序版本不同。
+ */
+
+#ifndef _LEESTL_PARALLEL_ALGO_H_
+#define _LEESTL_PARALLEL_ALGO_H_ 1
+
+#include <atomic>
+#include <new>
+
+#include "algo.h"
+#include "parallel_algobase.h"
+#include "vector.h"
+
+namespace leestl {
+
+	enum {
+		_PAR_SORT_MIN = 1 << 16,                // 少于该元素个数时顺序排序
+		_SAMPLE_SORT_BUCKETS_PER_THREAD = 4,    // 每个线程平均分到的桶数
+		_SAMPLE_SORT_MAX_BUCKETS = 128,         // 桶编号（含相等桶）可以用一个字节保存
+		_SAMPLE_SORT_OVERSAMPLING = 32,         // 每个桶的样本数
+	};
+
+	/**
+	 * @brief 用 threads 个线程对 [first, last) 做样本排序
+	 *
+	 * @tparam _Stable 是否为稳定排序
+	 * @return bool 缓冲区分配失败时返回 false，区间保持不变
+	 */
+	template <bool _Stable, typename _RI, typename Compare>
+	bool _sample_sort(_RI first, _RI last, Compare comp, size_t threads) {
+		typedef typename iterator_traits<_RI>::value_type _Tp;
+
+		const size_t n = last - first;
+		const size_t k = leestl::min(
+		    threads * _SAMPLE_SORT_BUCKETS_PER_THREAD, size_t(_SAMPLE_SORT_MAX_BUCKETS));
+
+		// 等间距取样并排序，选出 k - 1 个分割元素，相等的分割元素只保留一个
+		leestl::vector<size_t> sample(k * _SAMPLE_SORT_OVERSAMPLING);
+		for (size_t i = 0; i < sample.size(); ++i)
+			sample[i] = (2 * i + 1) * n / (2 * sample.size());
+		leestl::sort(sample.begin(), sample.end(), [&](size_t a, size_t b) {
+			return comp(*(first + a), *(first + b));
+		});
+		leestl::vector<_RI> splitters;
+		for (size_t j = 1; j < k; ++j) {
+			_RI s = first + sample[j * _SAMPLE_SORT_OVERSAMPLING];
+			if (splitters.empty() || comp(*splitters.back(), *s)) splitters.push_back(s);
+		}
+		const size_t m = splitters.size(), nbuckets = 2 * m + 1;
+
+		// 元素所在的桶：j 为第一个不小于它的分割元素，等于 s_j 时为 2j + 1，否则为 2j。
+		// 随机输入下二分查找的分支无法预测，循环内只用比较结果计算下标
+		const _RI *split = splitters.data();
+		auto       classify = [&](const _Tp &x) -> unsigned char {
+			if (m == 0) return 0;
+			const _RI *base = split;
+			for (size_t len = m; len > 1;) {
+				const size_t half = len / 2;
+				base += comp(*base[half], x) ? half : 0;
+				len -= half;
+			}
+			const size_t j = (base - split) + comp(**base, x);
+			return (unsigned char)(2 * j + (j < m && !comp(x, *split[j])));
+		};
+
+		// 缓冲区与桶编号数组不初始化，由各线程首次写入
+		_Tp           *buffer = nullptr;
+		unsigned char *ids = nullptr;
+		try {
+			buffer = leestl::allocator<_Tp>::allocate(n);
+			ids = leestl::allocator<unsigned char>::allocate(n);
+		} catch (const std::bad_alloc &) {
+			leestl::allocator<_Tp>::deallocate(buffer, n);
+			return false;
+		}
+
+		// 每个线程对自己的一段分类，counts[c * nbuckets + b] 为第 c 段中属于桶 b 的元素个数
+		_thread_pool          &pool = _thread_pool::instance();
+		leestl::vector<size_t> counts(threads * nbuckets, 0);
+		auto chunk = [&](size_t c) { return c * (n / threads) + c * (n % threads) / threads; };
+		pool.run(threads, [&](size_t c) {
+			size_t local[_SAMPLE_SORT_MAX_BUCKETS * 2] = {};
+			for (size_t i = chunk(c), e = chunk(c + 1); i < e; ++i) {
+				ids[i] = classify(*(first + i));
+				++local[ids[i]];
+			}
+			for (size_t b = 0; b < nbuckets; ++b) counts[c * nbuckets + b] = local[b];
+		});
+
+		// 按桶优先、段次之的顺序求前缀和，得到每段每个桶的写入位置
+		leestl::vector<size_t> bucket_begin(nbuckets + 1);
+		for (size_t b = 0, sum = 0; b < nbuckets; ++b) {
+			bucket_begin[b] = sum;
+			for (size_t c = 0; c < threads; ++c) {
+				const size_t cnt = counts[c * nbuckets + b];
+				counts[c * nbuckets + b] = sum;
+				sum += cnt;
+			}
+		}
+		bucket_begin[nbuckets] = n;
+
+		// 并行分配，段内保持原有顺序
+		pool.run(threads, [&](size_t c) {
+			size_t *offset = counts.data() + c * nbuckets;
+			for (size_t i = chunk(c), e = chunk(c + 1); i < e; ++i)
+				leestl::construct(buffer + offset[ids[i]]++, leestl::move(*(first + i)));
+		});
+		leestl::allocator<unsigned char>::deallocate(ids, n);
+
+		// 各线程动态领取桶，桶内排序后移回原区间；相等桶内的元素彼此相等，直接移回
+		std::atomic<size_t> next(0);
+		pool.run(threads, [&](size_t) {
+			for (size_t b; (b = next.fetch_add(1, std::memory_order_relaxed)) < nbuckets;) {
+				_Tp *lo = buffer + bucket_begin[b], *hi = buffer + bucket_begin[b + 1];
+				if (b % 2 == 0) {
+					if constexpr (_Stable) leestl::stable_sort(lo, hi, comp);
+					else leestl::sort(lo, hi, comp);
+				}
+				leestl::move(lo, hi, first + bucket_begin[b]);
+				leestl::destory(lo, hi);
+			}
+		});
+		leestl::allocator<_Tp>::deallocate(buffer, n);
+		return true;
+	}
+
+	// 元素数量足够且有多个线程时并行排序，否则或缓冲区分配失败时顺序排序
+	template <bool _Stable, typename _RI, typename Compare>
+	void _parallel_sort(_RI first, _RI last, Compare comp) {
+		const size_t threads = execution::num_threads();
+		if (threads > 1 && size_t(last - first) >= _PAR_SORT_MIN &&
+		    leestl::_sample_sort<_Stable>(first, last, comp, threads))
+			return;
+		if constexpr (_Stable) leestl::stable_sort(first, last, comp);
+		else leestl::sort(first, last, comp);
+	}
+
+	// 迭代器为随机访问迭代器、元素移动不抛出异常，且执行策略要求并行时才多线程排序
+	template <typename _EP, typename _RI>
+	inline constexpr bool _use_parallel_sort_v = _use_parallel_v<
+	    _EP, _RI, _RI,
+	    std::is_nothrow_move_constructible_v<typename iterator_traits<_RI>::value_type> &&
+	        std::is_nothrow_move_assignable_v<typename iterator_traits<_RI>::value_type>>;
+
+	/**
+	 * @brief 按执行策略对 [first, last) 排序，不稳定
+	 *
+	 * @tparam _EP 执行策略类型
+	 * @param first 起始位置
+	 * @param last 终止位置
+	 * @param comp 比较仿函数，并行执行时可能被多个线程同时调用
+	 */
+	template <typename _EP, typename _RI, typename Compare>
+	_enable_if_execution_policy<_EP, void> sort(_EP &&, _RI first, _RI last, Compare comp) {
+		if constexpr (_use_parallel_sort_v<_EP, _RI>)
+			leestl::_parallel_sort<false>(first, last, comp);
+		else leestl::sort(first, last, comp);
+	}
+
+	/**
+	 * @brief 按执行策略和 operator< 对 [first, last) 升序排序，不稳定
+	 *
+	 * @tparam _EP 执行策略类型
+	 * @param first 起始位置
+	 * @param last 终止位置
+	 */
+	template <typename _EP, typename _RI>
+	_enable_if_execution_policy<_EP, void> sort(_EP &&policy, _RI first, _RI last) {
+		leestl::sort(policy, first, last, _iter_less());
+	}
+
+	/**
+	 * @brief 按执行策略对 [first, last) 稳定排序，结果与顺序版本相同
+	 *
+	 * @tparam _EP 执行策略类型
+	 * @param first 起始位置
+	 * @param last 终止位置
+	 * @param comp 比较仿函数，并行执行时可能被多个线程同时调用
+	 */
+	template <typename _EP, typename _RI, typename Compare>
+	_enable_if_execution_policy<_EP, void> stable_sort(_EP &&, _RI first, _RI last, Compare comp) {
+		if constexpr (_use_parallel_sort_v<_EP, _RI>)
+			leestl::_parallel_sort<true>(first, last, comp);
+		else leestl::stable_sort(first, last, comp);
+	}
+
+	/**
+	 * @brief 按执行策略和 operator< 对 [first, last) 稳定升序排序
+	 *
+	 * @tparam _EP 执行策略类型
+	 * @param first 起始位置
+	 * @param last 终止位置
+	 */
+	template <typename _EP, typename _RI>
+	_enable_if_execution_policy<_EP, void> stable_sort(_EP &&policy, _RI first, _RI last) {
+		leestl::stable_sort(policy, first, last, _iter_less());
+	}
+
+}    // namespace leestl
+
+#endif
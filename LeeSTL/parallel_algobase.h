@@ -0,0 +1,226 @@
+/** @file parallel_algobase.h
+ * 	这个文件实现基础算法 copy、move、fill、fill_n、copy_backward 接受执行策略的版本
+ *
+ * 	区间按线程数静态划分，每段不少于 _PAR_MIN_BYTES 字节，段边界在目标空间中按缓存行对齐，
+ * 	相邻线程不会写同一条缓存行；每段内部调用顺序版本，仍会使用 memmove 与 SIMD 内核。
+ * 	只有随机访问迭代器、且元素赋值不抛出异常时才多线程执行，否则退化为顺序版本。
+ * 	原生指针的输入、输出区间重叠时同样退化为顺序版本，保持顺序版本对重叠区间的语义；
+ * 	其他迭代器无法判断是否重叠，与标准库一致，输入、输出区间不能重叠。
+ */
+
+#ifndef _LEESTL_PARALLEL_ALGOBASE_H_
+#define _LEESTL_PARALLEL_ALGOBASE_H_ 1
+
+#include <cstdint>
+
+#include "algobase.h"
+#include "execution.h"
+
+namespace leestl {
+
+	enum { _PAR_MIN_BYTES = 256 * 1024, _CACHE_LINE = 64 };
+
+	// 迭代器是否为随机访问迭代器
+	template <typename _Iter>
+	inline constexpr bool _is_random_access_v =
+	    std::is_convertible_v<iterator_category_types<_Iter>, random_acess_interator_tag>;
+
+	// 原生指针可以按地址对齐段边界，其他迭代器不对齐
+	template <typename _Iter>
+	inline const void *_par_address(_Iter) noexcept {
+		return nullptr;
+	}
+	template <typename T>
+	inline const void *_par_address(T *ptr) noexcept {
+		return ptr;
+	}
+
+	// 以 a、b 为起点的两段 n 个元素的空间是否重叠，地址未知时视为不重叠
+	template <typename _It1, typename _It2>
+	inline bool _par_overlap(_It1 a, _It2 b, size_t n) noexcept {
+		const void *pa = _par_address(a), *pb = _par_address(b);
+		if (pa == nullptr || pb == nullptr) return false;
+		const uintptr_t x = reinterpret_cast<uintptr_t>(pa), y = reinterpret_cast<uintptr_t>(pb);
+		return x < y + n * sizeof(typename iterator_traits<_It2>::value_type) &&
+		       y < x + n * sizeof(typename iterator_traits<_It1>::value_type);
+	}
+
+	/**
+	 * @brief 计算 n 个元素划分为 parts 段时第 k 段的起点
+	 *
+	 * @param n 元素个数
+	 * @param k 段编号，k == parts 时返回 n
+	 * @param parts 段数
+	 * @param dst 目标空间起始地址，非空时把段边界向下对齐到缓存行
+	 * @param esize 元素大小
+	 * @return size_t 第 k 段起点的下标
+	 */
+	inline size_t _par_boundary(size_t n, size_t k, size_t parts, const void *dst, size_t esize) {
+		if (k >= parts) return n;
+		size_t idx = n / parts * k + n % parts * k / parts;    // 即 n * k / parts，避免溢出
+		if (dst != nullptr && size_t(_CACHE_LINE) % esize == 0) {
+			const uintptr_t base = reinterpret_cast<uintptr_t>(dst);
+			const uintptr_t addr = (base + idx * esize) & ~uintptr_t(_CACHE_LINE - 1);
+			idx = addr <= base ? 0 : (addr - base) / esize;
+		}
+		return idx;
+	}
+
+	/**
+	 * @brief 把 [0, n) 划分为至多 num_threads() 段并行执行 f(begin, end)，第 k 段总由第 k 个线程执行
+	 *
+	 * @param n 元素个数
+	 * @param dst 目标空间起始地址，用于对齐段边界，可以为空
+	 * @param esize 元素大小
+	 * @param f 处理一段的可调用对象
+	 */
+	template <typename F>
+	void _parallel_for(size_t n, const void *dst, size_t esize, F f) {
+		const size_t threads = execution::num_threads();
+		size_t       parts = n / (size_t(_PAR_MIN_BYTES) / esize + 1);
+		if (parts > threads) parts = threads;
+		if (parts <= 1) {
+			f(size_t(0), n);
+			return;
+		}
+		_thread_pool::instance().run(parts, [&](size_t k) {
+			f(_par_boundary(n, k, parts, dst, esize), _par_boundary(n, k + 1, parts, dst, esize));
+		});
+	}
+
+	// 两个迭代器都是随机访问迭代器、元素赋值不抛出异常，且执行策略要求并行时才多线程执行
+	template <typename _EP, typename _It1, typename _It2, bool _Nothrow>
+	inline constexpr bool _use_parallel_v = _is_parallel_policy_v<_EP> &&
+	                                        _is_random_access_v<_It1> &&
+	                                        _is_random_access_v<_It2> && _Nothrow;
+
+	/**
+	 * @brief 按执行策略把 [first, last) 上的内容复制到以 result 为起始处的空间
+	 *
+	 * @tparam _EP 执行策略类型
+	 * @param first 原始空间的起始位置
+	 * @param last 原始空间的终止位置
+	 * @param result 目标空间的起始位置，非原生指针时不能与原始空间重叠
+	 * @return _OI 目标空间的尾部
+	 */
+	template <typename _EP, typename _II, typename _OI>
+	_enable_if_execution_policy<_EP, _OI> copy(_EP &&, _II first, _II last, _OI result) {
+		if constexpr (_use_parallel_v<
+		                  _EP, _II, _OI,
+		                  std::is_nothrow_assignable_v<decltype(*result), decltype(*first)>>) {
+			const size_t n = last - first;
+			const size_t esize = sizeof(typename iterator_traits<_OI>::value_type);
+			if (_par_overlap(first, result, n))
+				return leestl::copy(first, last, result);
+			_parallel_for(
+			    n, _par_address(result), esize,
+			    [&](size_t b, size_t e) { leestl::copy(first + b, first + e, result + b); });
+			return result + n;
+		} else {
+			return leestl::copy(first, last, result);
+		}
+	}
+
+	/**
+	 * @brief 按执行策略把 [first, last) 上的内容移动到以 result 为起始处的空间
+	 *
+	 * @tparam _EP 执行策略类型
+	 * @param first 原始空间的起始位置
+	 * @param last 原始空间的终止位置
+	 * @param result 目标空间的起始位置，非原生指针时不能与原始空间重叠
+	 * @return _OI 目标空间的尾部
+	 */
+	template <typename _EP, typename _II, typename _OI>
+	_enable_if_execution_policy<_EP, _OI> move(_EP &&, _II first, _II last, _OI result) {
+		if constexpr (_use_parallel_v<
+		                  _EP, _II, _OI,
+		                  std::is_nothrow_assignable_v<
+		                      decltype(*result), decltype(leestl::move(*first))>>) {
+			const size_t n = last - first;
+			const size_t esize = sizeof(typename iterator_traits<_OI>::value_type);
+			if (_par_overlap(first, result, n))
+				return leestl::move(first, last, result);
+			_parallel_for(
+			    n, _par_address(result), esize,
+			    [&](size_t b, size_t e) { leestl::move(first + b, first + e, result + b); });
+			return result + n;
+		} else {
+			return leestl::move(first, last, result);
+		}
+	}
+
+	/**
+	 * @brief 按执行策略把 [first, last) 上的内容都填充为 value
+	 *
+	 * @tparam _EP 执行策略类型
+	 * @param first 目标空间的起始位置
+	 * @param last 目标空间的终止位置
+	 * @param value 填充的值
+	 */
+	template <typename _EP, typename _FI, typename T>
+	_enable_if_execution_policy<_EP, void> fill(_EP &&, _FI first, _FI last, const T &value) {
+		if constexpr (_use_parallel_v<
+		                  _EP, _FI, _FI,
+		                  std::is_nothrow_assignable_v<decltype(*first), const T &>>) {
+			_parallel_for(
+			    size_t(last - first), _par_address(first),
+			    sizeof(typename iterator_traits<_FI>::value_type),
+			    [&](size_t b, size_t e) { leestl::fill(first + b, first + e, value); });
+		} else {
+			leestl::fill(first, last, value);
+		}
+	}
+
+	/**
+	 * @brief 按执行策略把 [first, first + n) 上的内容都填充为 value
+	 *
+	 * @tparam _EP 执行策略类型
+	 * @param first 目标空间的起始位置
+	 * @param n 填充的数量
+	 * @param value 填充的值
+	 * @return _OI 目标空间的尾部
+	 */
+	template <typename _EP, typename _OI, typename _Size, typename T>
+	_enable_if_execution_policy<_EP, _OI> fill_n(_EP &&policy, _OI first, _Size n, const T &value) {
+		if constexpr (_is_random_access_v<_OI>) {
+			if (n <= 0) return first;
+			leestl::fill(policy, first, first + n, value);
+			return first + n;
+		} else {
+			return leestl::fill_n(first, n, value);
+		}
+	}
+
+	/**
+	 * @brief 按执行策略反向复制 [first, last) 上的元素到 result 之前
+	 *
+	 * @tparam _EP 执行策略类型
+	 * @param first 原始空间的起始位置
+	 * @param last 原始空间的终止位置
+	 * @param result 目标空间的尾部，非原生指针时目标空间不能与原始空间重叠
+	 * @return _BI2 目标空间的起始位置
+	 */
+	template <typename _EP, typename _BI1, typename _BI2>
+	_enable_if_execution_policy<_EP, _BI2> copy_backward(
+	    _EP &&, _BI1 first, _BI1 last, _BI2 result) {
+		if constexpr (_use_parallel_v<
+		                  _EP, _BI1, _BI2,
+		                  std::is_nothrow_assignable_v<decltype(*result), decltype(*first)>>) {
+			const size_t n = last - first;
+			const size_t esize = sizeof(typename iterator_traits<_BI2>::value_type);
+			if (_par_overlap(first, result - n, n))
+				return leestl::copy_backward(first, last, result);
+			_parallel_for(
+			    n, _par_address(result - n), esize,
+			    [&](size_t b, size_t e) {
+				    leestl::copy_backward(first + b, first + e, result - (n - e));
+			    });
+			return result - n;
+		} else {
+			return leestl::copy_backward(first, last, result);
+		}
+	}
+
+}    // namespace leestl
+
+#endif
@@ -0,0 +1,941 @@
+/** @file simd.h
+ * 	这个文件实现 fill、copy 使用的 SIMD 内核，运行时按 CPUID 选择 SSE2、AVX2 或 AVX-512 版本
+ *
+ * 	填充：把值重复铺满一段模式缓冲区，头部一次非对齐写入，主体按向量宽度对齐写入，
+ * 	尾部用一次与主体重叠的非对齐写入收尾，元素大小为 2、4、8、16 字节时都适用。
+ * 	复制：超过阈值（默认为末级缓存大小）且两段空间不重叠时使用非临时存储绕过缓存，
+ * 	避免大块复制把缓存中的热数据全部挤出，其余情况仍交给 memmove。
+ * 	查找、计数与比较：按元素宽度做向量比较，再用 movemask 把结果压成位掩码，
+ * 	查找位置由掩码的末尾零个数得到，计数在字节计数器上累加后用 sad 汇总。
+ * 	AVX-512 等级下查找与比较仍使用 AVX2 内核。
+ * 	位数组：64 位字数组的逐字位运算按向量宽度处理；计数在 AVX-512 且支持 vpopcntq 时逐通道
+ * 	计数，AVX2 时按 4 位查表（Mula 算法）再用 sad 汇总，否则使用 popcnt 指令。
+ *
+ * 	定义宏 LEESTL_NO_SIMD 后全部退回标量实现。
+ */
+
+#ifndef _LEESTL_SIMD_H_
+#define _LEESTL_SIMD_H_ 1
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <unistd.h>
+
+#if !defined(LEESTL_NO_SIMD) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define LEESTL_SIMD_X86 1
+#endif
+
+namespace leestl {
+
+	namespace simd {
+
+		// 指令集等级，数值越大向量越宽
+		enum isa { ISA_SCALAR = 0, ISA_SSE2, ISA_AVX2, ISA_AVX512 };
+
+		// 小于该字节数时由调用者直接使用标量循环，避免分派与构造模式缓冲区的开销
+		enum { FILL_MIN_BYTES = 256 };
+
+		// 模式缓冲区大小：至少一个最宽向量加上一个元素的错位
+		enum { _PATTERN_BYTES = 128 };
+
+		inline const char *isa_name(isa i) {
+			static const char *names[] = {"scalar", "sse2", "avx2", "avx512"};
+			return names[i];
+		}
+
+		// 通过 CPUID 检测当前 CPU 支持的最高指令集
+		inline isa detected_isa() {
+#ifdef LEESTL_SIMD_X86
+			static const isa detected = [] {
+				__builtin_cpu_init();
+				if (__builtin_cpu_supports("avx512f")) return ISA_AVX512;
+				if (__builtin_cpu_supports("avx2")) return ISA_AVX2;
+				if (__builtin_cpu_supports("sse2")) return ISA_SSE2;
+				return ISA_SCALAR;
+			}();
+			return detected;
+#else
+			return ISA_SCALAR;
+#endif
+		}
+
+		// 默认的非临时存储阈值：末级缓存大小，无法获取时取 8 MiB
+		inline size_t _default_nt_threshold() {
+			long llc = -1;
+#ifdef _SC_LEVEL3_CACHE_SIZE
+			llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+			return llc > 0 ? size_t(llc) : size_t(8) << 20;
+		}
+
+		struct _config {
+			std::atomic<int>    isa;
+			std::atomic<size_t> nt_threshold;
+
+			_config() : isa(detected_isa()), nt_threshold(_default_nt_threshold()) {}
+		};
+
+		inline _config &_get_config() {
+			static _config c;
+			return c;
+		}
+
+		// 当前使用的指令集
+		inline isa active_isa() {
+			return isa(_get_config().isa.load(std::memory_order_relaxed));
+		}
+
+		/**
+		 * @brief 指定使用的指令集，用于测试与性能对比，不会超过 CPU 实际支持的等级
+		 *
+		 * @param i 期望的指令集
+		 * @return isa 实际生效的指令集
+		 */
+		inline isa set_isa(isa i) {
+			if (i > detected_isa()) i = detected_isa();
+			_get_config().isa.store(i, std::memory_order_relaxed);
+			return i;
+		}
+
+		// 复制时启用非临时存储的字节数阈值
+		inline size_t nontemporal_threshold() {
+			return _get_config().nt_threshold.load(std::memory_order_relaxed);
+		}
+
+		inline void set_nontemporal_threshold(size_t bytes) {
+			_get_config().nt_threshold.store(bytes, std::memory_order_relaxed);
+		}
+
+		// ptr 向上对齐到 align 字节
+		inline char *_align_up(char *ptr, size_t align) {
+			return reinterpret_cast<char *>(
+			    (reinterpret_cast<uintptr_t>(ptr) + align - 1) & ~(uintptr_t(align) - 1));
+		}
+
+#ifdef LEESTL_SIMD_X86
+		// 以下内核要求 bytes 不小于向量宽度，pat 为从 dst 起始处对应的模式，esize 整除 16
+
+		inline void _fill_sse2(char *dst, size_t bytes, const char *pat, size_t esize, bool nt) {
+			char *const   end = dst + bytes;
+			char         *p = _align_up(dst, 16);
+			const __m128i v = _mm_loadu_si128((const __m128i *)(pat + (p - dst) % esize));
+			if (nt) {
+				std::memcpy(dst, pat, p - dst);
+				for (; p + 64 <= end; p += 64) {
+					_mm_stream_si128((__m128i *)p, v);
+					_mm_stream_si128((__m128i *)(p + 16), v);
+					_mm_stream_si128((__m128i *)(p + 32), v);
+					_mm_stream_si128((__m128i *)(p + 48), v);
+				}
+				for (; p + 16 <= end; p += 16) _mm_stream_si128((__m128i *)p, v);
+				_mm_sfence();
+				std::memcpy(p, pat + (p - dst) % esize, end - p);
+				return;
+			}
+			_mm_storeu_si128((__m128i *)dst, _mm_loadu_si128((const __m128i *)pat));
+			for (; p + 64 <= end; p += 64) {
+				_mm_store_si128((__m128i *)p, v);
+				_mm_store_si128((__m128i *)(p + 16), v);
+				_mm_store_si128((__m128i *)(p + 32), v);
+				_mm_store_si128((__m128i *)(p + 48), v);
+			}
+			for (; p + 16 <= end; p += 16) _mm_store_si128((__m128i *)p, v);
+			_mm_storeu_si128((__m128i *)(end - 16), _mm_loadu_si128((const __m128i *)pat));
+		}
+
+		__attribute__((target("avx2"))) inline void _fill_avx2(
+		    char *dst, size_t bytes, const char *pat, size_t esize, bool nt) {
+			char *const   end = dst + bytes;
+			char         *p = _align_up(dst, 32);
+			const __m256i v = _mm256_loadu_si256((const __m256i *)(pat + (p - dst) % esize));
+			if (nt) {
+				std::memcpy(dst, pat, p - dst);
+				for (; p + 128 <= end; p += 128) {
+					_mm256_stream_si256((__m256i *)p, v);
+					_mm256_stream_si256((__m256i *)(p + 32), v);
+					_mm256_stream_si256((__m256i *)(p + 64), v);
+					_mm256_stream_si256((__m256i *)(p + 96), v);
+				}
+				for (; p + 32 <= end; p += 32) _mm256_stream_si256((__m256i *)p, v);
+				_mm_sfence();
+				std::memcpy(p, pat + (p - dst) % esize, end - p);
+				return;
+			}
+			_mm256_storeu_si256((__m256i *)dst, _mm256_loadu_si256((const __m256i *)pat));
+			for (; p + 128 <= end; p += 128) {
+				_mm256_store_si256((__m256i *)p, v);
+				_mm256_store_si256((__m256i *)(p + 32), v);
+				_mm256_store_si256((__m256i *)(p + 64), v);
+				_mm256_store_si256((__m256i *)(p + 96), v);
+			}
+			for (; p + 32 <= end; p += 32) _mm256_store_si256((__m256i *)p, v);
+			_mm256_storeu_si256((__m256i *)(end - 32), _mm256_loadu_si256((const __m256i *)pat));
+		}
+
+		__attribute__((target("avx512f"))) inline void _fill_avx512(
+		    char *dst, size_t bytes, const char *pat, size_t esize, bool nt) {
+			char *const   end = dst + bytes;
+			char         *p = _align_up(dst, 64);
+			const __m512i v = _mm512_loadu_si512(pat + (p - dst) % esize);
+			if (nt) {
+				std::memcpy(dst, pat, p - dst);
+				for (; p + 256 <= end; p += 256) {
+					_mm512_stream_si512((__m512i *)p, v);
+					_mm512_stream_si512((__m512i *)(p + 64), v);
+					_mm512_stream_si512((__m512i *)(p + 128), v);
+					_mm512_stream_si512((__m512i *)(p + 192), v);
+				}
+				for (; p + 64 <= end; p += 64) _mm512_stream_si512((__m512i *)p, v);
+				_mm_sfence();
+				std::memcpy(p, pat + (p - dst) % esize, end - p);
+				return;
+			}
+			_mm512_storeu_si512(dst, _mm512_loadu_si512(pat));
+			for (; p + 256 <= end; p += 256) {
+				_mm512_store_si512(p, v);
+				_mm512_store_si512(p + 64, v);
+				_mm512_store_si512(p + 128, v);
+				_mm512_store_si512(p + 192, v);
+			}
+			for (; p + 64 <= end; p += 64) _mm512_store_si512(p, v);
+			_mm512_storeu_si512(end - 64, _mm512_loadu_si512(pat));
+		}
+
+		// 以下内核使用非临时存储复制不重叠的两段空间，要求 bytes 不小于向量宽度
+
+		inline void _copy_nt_sse2(char *dst, const char *src, size_t bytes) {
+			char *const  end = dst + bytes;
+			const size_t head = _align_up(dst, 16) - dst;
+			std::memcpy(dst, src, head);
+			char       *d = dst + head;
+			const char *s = src + head;
+			for (; d + 64 <= end; d += 64, s += 64) {
+				__m128i a = _mm_loadu_si128((const __m128i *)s);
+				__m128i b = _mm_loadu_si128((const __m128i *)(s + 16));
+				__m128i c = _mm_loadu_si128((const __m128i *)(s + 32));
+				__m128i e = _mm_loadu_si128((const __m128i *)(s + 48));
+				_mm_stream_si128((__m128i *)d, a);
+				_mm_stream_si128((__m128i *)(d + 16), b);
+				_mm_stream_si128((__m128i *)(d + 32), c);
+				_mm_stream_si128((__m128i *)(d + 48), e);
+			}
+			for (; d + 16 <= end; d += 16, s += 16)
+				_mm_stream_si128((__m128i *)d, _mm_loadu_si128((const __m128i *)s));
+			_mm_sfence();
+			std::memcpy(d, s, end - d);
+		}
+
+		__attribute__((target("avx2"))) inline void _copy_nt_avx2(
+		    char *dst, const char *src, size_t bytes) {
+			char *const  end = dst + bytes;
+			const size_t head = _align_up(dst, 32) - dst;
+			std::memcpy(dst, src, head);
+			char       *d = dst + head;
+			const char *s = src + head;
+			for (; d + 128 <= end; d += 128, s += 128) {
+				__m256i a = _mm256_loadu_si256((const __m256i *)s);
+				__m256i b = _mm256_loadu_si256((const __m256i *)(s + 32));
+				__m256i c = _mm256_loadu_si256((const __m256i *)(s + 64));
+				__m256i e = _mm256_loadu_si256((const __m256i *)(s + 96));
+				_mm256_stream_si256((__m256i *)d, a);
+				_mm256_stream_si256((__m256i *)(d + 32), b);
+				_mm256_stream_si256((__m256i *)(d + 64), c);
+				_mm256_stream_si256((__m256i *)(d + 96), e);
+			}
+			for (; d + 32 <= end; d += 32, s += 32)
+				_mm256_stream_si256((__m256i *)d, _mm256_loadu_si256((const __m256i *)s));
+			_mm_sfence();
+			std::memcpy(d, s, end - d);
+		}
+
+		__attribute__((target("avx512f"))) inline void _copy_nt_avx512(
+		    char *dst, const char *src, size_t bytes) {
+			char *const  end = dst + bytes;
+			const size_t head = _align_up(dst, 64) - dst;
+			std::memcpy(dst, src, head);
+			char       *d = dst + head;
+			const char *s = src + head;
+			for (; d + 256 <= end; d += 256, s += 256) {
+				__m512i a = _mm512_loadu_si512(s);
+				__m512i b = _mm512_loadu_si512(s + 64);
+				__m512i c = _mm512_loadu_si512(s + 128);
+				__m512i e = _mm512_loadu_si512(s + 192);
+				_mm512_stream_si512((__m512i *)d, a);
+				_mm512_stream_si512((__m512i *)(d + 64), b);
+				_mm512_stream_si512((__m512i *)(d + 128), c);
+				_mm512_stream_si512((__m512i *)(d + 192), e);
+			}
+			for (; d + 64 <= end; d += 64, s += 64)
+				_mm512_stream_si512((__m512i *)d, _mm512_loadu_si512(s));
+			_mm_sfence();
+			std::memcpy(d, s, end - d);
+		}
+
+		// 以下内核按元素宽度 E（1、2、4、8 字节）比较，相等元素的每个字节在结果中全为 1
+
+		template <size_t E>
+		inline __m128i _broadcast_sse2(const char *value) {
+			if constexpr (E == 1) return _mm_set1_epi8(*value);
+			else if constexpr (E == 2) {
+				int16_t v;
+				std::memcpy(&v, value, 2);
+				return _mm_set1_epi16(v);
+			} else if constexpr (E == 4) {
+				int32_t v;
+				std::memcpy(&v, value, 4);
+				return _mm_set1_epi32(v);
+			} else {
+				int64_t v;
+				std::memcpy(&v, value, 8);
+				return _mm_set1_epi64x(v);
+			}
+		}
+
+		template <size_t E>
+		inline __m128i _cmpeq_sse2(__m128i a, __m128i b) {
+			if constexpr (E == 1) return _mm_cmpeq_epi8(a, b);
+			else if constexpr (E == 2) return _mm_cmpeq_epi16(a, b);
+			else if constexpr (E == 4) return _mm_cmpeq_epi32(a, b);
+			else {
+				// SSE2 没有 64 位比较：高低两个 32 位都相等才算相等
+				const __m128i c = _mm_cmpeq_epi32(a, b);
+				return _mm_and_si128(c, _mm_shuffle_epi32(c, _MM_SHUFFLE(2, 3, 0, 1)));
+			}
+		}
+
+		template <size_t E>
+		__attribute__((target("avx2"))) inline __m256i _broadcast_avx2(const char *value) {
+			return _mm256_broadcastsi128_si256(_broadcast_sse2<E>(value));
+		}
+
+		template <size_t E>
+		__attribute__((target("avx2"))) inline __m256i _cmpeq_avx2(__m256i a, __m256i b) {
+			if constexpr (E == 1) return _mm256_cmpeq_epi8(a, b);
+			else if constexpr (E == 2) return _mm256_cmpeq_epi16(a, b);
+			else if constexpr (E == 4) return _mm256_cmpeq_epi32(a, b);
+			else return _mm256_cmpeq_epi64(a, b);
+		}
+
+		// 以下查找、计数内核要求 bytes 不小于向量宽度且为 E 的倍数，返回值以字节为单位；
+		// 尾部用一次与前面重叠的非对齐读取收尾
+
+		// 第一个等于 value 的元素的字节偏移，不存在时返回 bytes
+		template <size_t E>
+		inline size_t _find_sse2(const char *p, size_t bytes, const char *value) {
+			const __m128i v = _broadcast_sse2<E>(value);
+			size_t        i = 0;
+			for (; i + 64 <= bytes; i += 64) {
+				const __m128i a = _cmpeq_sse2<E>(_mm_loadu_si128((const __m128i *)(p + i)), v);
+				const __m128i b = _cmpeq_sse2<E>(_mm_loadu_si128((const __m128i *)(p + i + 16)), v);
+				const __m128i c = _cmpeq_sse2<E>(_mm_loadu_si128((const __m128i *)(p + i + 32)), v);
+				const __m128i d = _cmpeq_sse2<E>(_mm_loadu_si128((const __m128i *)(p + i + 48)), v);
+				if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)))) break;
+			}
+			for (; i + 16 <= bytes; i += 16) {
+				const int m = _mm_movemask_epi8(
+				    _cmpeq_sse2<E>(_mm_loadu_si128((const __m128i *)(p + i)), v));
+				if (m) return i + __builtin_ctz(m);
+			}
+			if (i < bytes) {
+				const int m = _mm_movemask_epi8(
+				    _cmpeq_sse2<E>(_mm_loadu_si128((const __m128i *)(p + bytes - 16)), v));
+				if (m) return bytes - 16 + __builtin_ctz(m);
+			}
+			return bytes;
+		}
+
+		template <size_t E>
+		__attribute__((target("avx2"))) inline size_t _find_avx2(
+		    const char *p, size_t bytes, const char *value) {
+			const __m256i v = _broadcast_avx2<E>(value);
+			size_t        i = 0;
+			for (; i + 128 <= bytes; i += 128) {
+				const __m256i a = _cmpeq_avx2<E>(_mm256_loadu_si256((const __m256i *)(p + i)), v);
+				const __m256i b =
+				    _cmpeq_avx2<E>(_mm256_loadu_si256((const __m256i *)(p + i + 32)), v);
+				const __m256i c =
+				    _cmpeq_avx2<E>(_mm256_loadu_si256((const __m256i *)(p + i + 64)), v);
+				const __m256i d =
+				    _cmpeq_avx2<E>(_mm256_loadu_si256((const __m256i *)(p + i + 96)), v);
+				const __m256i any = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d));
+				if (!_mm256_testz_si256(any, any)) break;
+			}
+			for (; i + 32 <= bytes; i += 32) {
+				const uint32_t m = uint32_t(_mm256_movemask_epi8(
+				    _cmpeq_avx2<E>(_mm256_loadu_si256((const __m256i *)(p + i)), v)));
+				if (m) return i + __builtin_ctz(m);
+			}
+			if (i < bytes) {
+				const uint32_t m = uint32_t(_mm256_movemask_epi8(
+				    _cmpeq_avx2<E>(_mm256_loadu_si256((const __m256i *)(p + bytes - 32)), v)));
+				if (m) return bytes - 32 + __builtin_ctz(m);
+			}
+			return bytes;
+		}
+
+		// 等于 value 的字节数（元素个数乘 E）。比较结果先在字节计数器上累加，
+		// 计数器溢出之前用 sad 汇总到 64 位计数器
+		template <size_t E>
+		inline size_t _count_sse2(const char *p, size_t bytes, const char *value) {
+			const __m128i v = _broadcast_sse2<E>(value), zero = _mm_setzero_si128();
+			__m128i       total = zero;
+			size_t        i = 0;
+			while (i + 64 <= bytes) {
+				// 每轮 4 个向量最多各减 1，63 轮之后计数器不超过 252
+				__m128i acc = zero;
+				for (int k = 0; k < 63 && i + 64 <= bytes; ++k, i += 64) {
+					const __m128i a = _cmpeq_sse2<E>(_mm_loadu_si128((const __m128i *)(p + i)), v);
+					const __m128i b =
+					    _cmpeq_sse2<E>(_mm_loadu_si128((const __m128i *)(p + i + 16)), v);
+					const __m128i c =
+					    _cmpeq_sse2<E>(_mm_loadu_si128((const __m128i *)(p + i + 32)), v);
+					const __m128i d =
+					    _cmpeq_sse2<E>(_mm_loadu_si128((const __m128i *)(p + i + 48)), v);
+					acc = _mm_sub_epi8(acc, _mm_add_epi8(_mm_add_epi8(a, b), _mm_add_epi8(c, d)));
+				}
+				total = _mm_add_epi64(total, _mm_sad_epu8(acc, zero));
+			}
+			alignas(16) uint64_t sum[2];
+			_mm_store_si128((__m128i *)sum, total);
+			size_t result = size_t(sum[0] + sum[1]);
+			for (; i + 16 <= bytes; i += 16)
+				result += __builtin_popcount(unsigned(_mm_movemask_epi8(
+				    _cmpeq_sse2<E>(_mm_loadu_si128((const __m128i *)(p + i)), v))));
+			if (i < bytes) {
+				// 只保留与前面不重叠的高 bytes - i 位
+				const unsigned m = unsigned(_mm_movemask_epi8(
+				    _cmpeq_sse2<E>(_mm_loadu_si128((const __m128i *)(p + bytes - 16)), v)));
+				result += __builtin_popcount(m >> (16 - (bytes - i)));
+			}
+			return result;
+		}
+
+		template <size_t E>
+		__attribute__((target("avx2"))) inline size_t _count_avx2(
+		    const char *p, size_t bytes, const char *value) {
+			const __m256i v = _broadcast_avx2<E>(value), zero = _mm256_setzero_si256();
+			__m256i       total = zero;
+			size_t        i = 0;
+			while (i + 128 <= bytes) {
+				__m256i acc = zero;
+				for (int k = 0; k < 63 && i + 128 <= bytes; ++k, i += 128) {
+					const __m256i a =
+					    _cmpeq_avx2<E>(_mm256_loadu_si256((const __m256i *)(p + i)), v);
+					const __m256i b =
+					    _cmpeq_avx2<E>(_mm256_loadu_si256((const __m256i *)(p + i + 32)), v);
+					const __m256i c =
+					    _cmpeq_avx2<E>(_mm256_loadu_si256((const __m256i *)(p + i + 64)), v);
+					const __m256i d =
+					    _cmpeq_avx2<E>(_mm256_loadu_si256((const __m256i *)(p + i + 96)), v);
+					acc = _mm256_sub_epi8(
+					    acc, _mm256_add_epi8(_mm256_add_epi8(a, b), _mm256_add_epi8(c, d)));
+				}
+				total = _mm256_add_epi64(total, _mm256_sad_epu8(acc, zero));
+			}
+			alignas(32) uint64_t sum[4];
+			_mm256_store_si256((__m256i *)sum, total);
+			size_t result = size_t(sum[0] + sum[1] + sum[2] + sum[3]);
+			for (; i + 32 <= bytes; i += 32)
+				result += __builtin_popcount(uint32_t(_mm256_movemask_epi8(
+				    _cmpeq_avx2<E>(_mm256_loadu_si256((const __m256i *)(p + i)), v))));
+			if (i < bytes) {
+				const uint32_t m = uint32_t(_mm256_movemask_epi8(
+				    _cmpeq_avx2<E>(_mm256_loadu_si256((const __m256i *)(p + bytes - 32)), v)));
+				result += __builtin_popcount(m >> (32 - (bytes - i)));
+			}
+			return result;
+		}
+
+		// 第一个不同字节的偏移，全部相同时返回 bytes，要求 bytes 不小于向量宽度
+		inline size_t _mismatch_sse2(const char *a, const char *b, size_t bytes) {
+			size_t i = 0;
+			for (; i + 16 <= bytes; i += 16) {
+				const unsigned m = unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(
+				    _mm_loadu_si128((const __m128i *)(a + i)),
+				    _mm_loadu_si128((const __m128i *)(b + i)))));
+				if (m != 0xffff) return i + __builtin_ctz(~m);
+			}
+			if (i < bytes) {
+				const unsigned m = unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(
+				    _mm_loadu_si128((const __m128i *)(a + bytes - 16)),
+				    _mm_loadu_si128((const __m128i *)(b + bytes - 16)))));
+				if (m != 0xffff) return bytes - 16 + __builtin_ctz(~m);
+			}
+			return bytes;
+		}
+
+		__attribute__((target("avx2"))) inline size_t _mismatch_avx2(
+		    const char *a, const char *b, size_t bytes) {
+			size_t i = 0;
+			for (; i + 128 <= bytes; i += 128) {
+				__m256i e = _mm256_cmpeq_epi8(
+				    _mm256_loadu_si256((const __m256i *)(a + i)),
+				    _mm256_loadu_si256((const __m256i *)(b + i)));
+				for (size_t k = 32; k < 128; k += 32)
+					e = _mm256_and_si256(
+					    e, _mm256_cmpeq_epi8(
+					           _mm256_loadu_si256((const __m256i *)(a + i + k)),
+					           _mm256_loadu_si256((const __m256i *)(b + i + k))));
+				if (uint32_t(_mm256_movemask_epi8(e)) != 0xffffffffu) break;
+			}
+			for (; i + 32 <= bytes; i += 32) {
+				const uint32_t m = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+				    _mm256_loadu_si256((const __m256i *)(a + i)),
+				    _mm256_loadu_si256((const __m256i *)(b + i)))));
+				if (m != 0xffffffffu) return i + __builtin_ctz(~m);
+			}
+			if (i < bytes) {
+				const uint32_t m = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+				    _mm256_loadu_si256((const __m256i *)(a + bytes - 32)),
+				    _mm256_loadu_si256((const __m256i *)(b + bytes - 32)))));
+				if (m != 0xffffffffu) return bytes - 32 + __builtin_ctz(~m);
+			}
+			return bytes;
+		}
+#endif
+
+		// 64 位字数组上的逐字位运算
+		enum bit_op { BIT_AND, BIT_OR, BIT_XOR, BIT_ANDNOT };
+
+		template <int Op>
+		inline uint64_t _bit_apply(uint64_t a, uint64_t b) {
+			if constexpr (Op == BIT_AND) return a & b;
+			else if constexpr (Op == BIT_OR) return a | b;
+			else if constexpr (Op == BIT_XOR) return a ^ b;
+			else return a & ~b;
+		}
+
+		// 与向量宽度无关的位操作指令，单独检测：popcnt、pdep（BMI2）与 AVX-512 的 vpopcntq
+		struct _bit_features {
+			bool popcnt = false;
+			bool bmi2 = false;
+			bool vpopcntdq = false;
+
+			_bit_features() {
+#ifdef LEESTL_SIMD_X86
+				__builtin_cpu_init();
+				popcnt = __builtin_cpu_supports("popcnt");
+				bmi2 = __builtin_cpu_supports("bmi2");
+				vpopcntdq = __builtin_cpu_supports("avx512vpopcntdq");
+#endif
+			}
+		};
+
+		inline const _bit_features &_get_bit_features() {
+			static const _bit_features f;
+			return f;
+		}
+
+		/**
+		 * @brief 单个字中 1 的个数
+		 *
+		 * 	编译时启用了 popcnt 指令就直接使用，否则内联 SWAR 计算，不调用 libgcc 的计数函数
+		 */
+		inline unsigned popcount64(uint64_t x) {
+#ifdef __POPCNT__
+			return unsigned(__builtin_popcountll(x));
+#else
+			x = x - ((x >> 1) & 0x5555555555555555ull);
+			x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+			x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+			return unsigned((x * 0x0101010101010101ull) >> 56);
+#endif
+		}
+
+#ifdef LEESTL_SIMD_X86
+		__attribute__((target("popcnt"))) inline size_t _popcount_popcnt(
+		    const uint64_t *p, size_t n) {
+			size_t a = 0, b = 0, c = 0, d = 0, i = 0;
+			for (; i + 4 <= n; i += 4) {
+				a += size_t(_mm_popcnt_u64(p[i]));
+				b += size_t(_mm_popcnt_u64(p[i + 1]));
+				c += size_t(_mm_popcnt_u64(p[i + 2]));
+				d += size_t(_mm_popcnt_u64(p[i + 3]));
+			}
+			for (; i < n; ++i) a += size_t(_mm_popcnt_u64(p[i]));
+			return a + b + c + d;
+		}
+
+		// 每个字节中 1 的个数：高低 4 位各查一次 16 项的表（Mula 算法）
+		__attribute__((target("avx2"))) inline __m256i _popcount_bytes_avx2(
+		    __m256i v, __m256i table, __m256i low) {
+			const __m256i lo = _mm256_and_si256(v, low);
+			const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low);
+			return _mm256_add_epi8(_mm256_shuffle_epi8(table, lo), _mm256_shuffle_epi8(table, hi));
+		}
+
+		// 字节计数先在字节计数器上累加，计数器溢出之前用 sad 汇总到 64 位计数器
+		__attribute__((target("avx2,popcnt"))) inline size_t _popcount_avx2(
+		    const uint64_t *p, size_t n) {
+			const __m256i table = _mm256_setr_epi8(
+			    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3,
+			    2, 3, 3, 4);
+			const __m256i low = _mm256_set1_epi8(0x0f), zero = _mm256_setzero_si256();
+			__m256i       total = zero;
+			size_t        i = 0;
+			while (i + 16 <= n) {
+				// 每轮 4 个向量各加至多 8，7 轮之后计数器不超过 224
+				__m256i acc = zero;
+				for (int k = 0; k < 7 && i + 16 <= n; ++k, i += 16) {
+					const __m256i a = _popcount_bytes_avx2(
+					    _mm256_loadu_si256((const __m256i *)(p + i)), table, low);
+					const __m256i b = _popcount_bytes_avx2(
+					    _mm256_loadu_si256((const __m256i *)(p + i + 4)), table, low);
+					const __m256i c = _popcount_bytes_avx2(
+					    _mm256_loadu_si256((const __m256i *)(p + i + 8)), table, low);
+					const __m256i d = _popcount_bytes_avx2(
+					    _mm256_loadu_si256((const __m256i *)(p + i + 12)), table, low);
+					acc = _mm256_add_epi8(
+					    acc, _mm256_add_epi8(_mm256_add_epi8(a, b), _mm256_add_epi8(c, d)));
+				}
+				total = _mm256_add_epi64(total, _mm256_sad_epu8(acc, zero));
+			}
+			alignas(32) uint64_t sum[4];
+			_mm256_store_si256((__m256i *)sum, total);
+			size_t result = size_t(sum[0] + sum[1] + sum[2] + sum[3]);
+			for (; i < n; ++i) result += size_t(_mm_popcnt_u64(p[i]));
+			return result;
+		}
+
+		// 8 个 64 位通道求和。GCC 的 _mm512_reduce_add_epi64 经由 _mm512_undefined_* 实现，
+		// 会产生未初始化变量的警告，这里存回内存再相加
+		__attribute__((target("avx512f"))) inline uint64_t _reduce_add_avx512(__m512i v) {
+			alignas(64) uint64_t lanes[8];
+			_mm512_store_si512(lanes, v);
+			uint64_t sum = 0;
+			for (uint64_t x : lanes) sum += x;
+			return sum;
+		}
+
+		// 每个 64 位通道直接计数，尾部用掩码读取
+		__attribute__((target("avx512f,avx512vpopcntdq"))) inline size_t _popcount_avx512(
+		    const uint64_t *p, size_t n) {
+			__m512i a = _mm512_setzero_si512(), b = _mm512_setzero_si512();
+			size_t  i = 0;
+			for (; i + 16 <= n; i += 16) {
+				a = _mm512_add_epi64(a, _mm512_popcnt_epi64(_mm512_loadu_si512(p + i)));
+				b = _mm512_add_epi64(b, _mm512_popcnt_epi64(_mm512_loadu_si512(p + i + 8)));
+			}
+			for (; i < n; i += 8) {
+				const __mmask8 m = n - i >= 8 ? __mmask8(0xff) : __mmask8((1u << (n - i)) - 1);
+				const __m512i v = _mm512_mask_loadu_epi64(_mm512_setzero_si512(), m, p + i);
+				a = _mm512_add_epi64(a, _mm512_popcnt_epi64(v));
+			}
+			return size_t(_reduce_add_avx512(_mm512_add_epi64(a, b)));
+		}
+
+		template <int Op>
+		__attribute__((target("avx2"))) inline __m256i _bit_apply_avx2(__m256i a, __m256i b) {
+			if constexpr (Op == BIT_AND) return _mm256_and_si256(a, b);
+			else if constexpr (Op == BIT_OR) return _mm256_or_si256(a, b);
+			else if constexpr (Op == BIT_XOR) return _mm256_xor_si256(a, b);
+			else return _mm256_andnot_si256(b, a);
+		}
+
+		template <int Op>
+		__attribute__((target("avx2"))) inline void _bitwise_avx2(
+		    uint64_t *dst, const uint64_t *src, size_t n) {
+			size_t i = 0;
+			for (; i + 8 <= n; i += 8) {
+				const __m256i a = _bit_apply_avx2<Op>(
+				    _mm256_loadu_si256((const __m256i *)(dst + i)),
+				    _mm256_loadu_si256((const __m256i *)(src + i)));
+				const __m256i b = _bit_apply_avx2<Op>(
+				    _mm256_loadu_si256((const __m256i *)(dst + i + 4)),
+				    _mm256_loadu_si256((const __m256i *)(src + i + 4)));
+				_mm256_storeu_si256((__m256i *)(dst + i), a);
+				_mm256_storeu_si256((__m256i *)(dst + i + 4), b);
+			}
+			for (; i < n; ++i) dst[i] = _bit_apply<Op>(dst[i], src[i]);
+		}
+
+		template <int Op>
+		__attribute__((target("avx512f"))) inline __m512i _bit_apply_avx512(__m512i a, __m512i b) {
+			if constexpr (Op == BIT_AND) return _mm512_and_si512(a, b);
+			else if constexpr (Op == BIT_OR) return _mm512_or_si512(a, b);
+			else if constexpr (Op == BIT_XOR) return _mm512_xor_si512(a, b);
+			// 带全 1 掩码的版本给出了合并来源，避免 _mm512_andnot_si512 的未初始化警告
+			else return _mm512_mask_andnot_epi64(a, __mmask8(0xff), b, a);
+		}
+
+		template <int Op>
+		__attribute__((target("avx512f"))) inline void _bitwise_avx512(
+		    uint64_t *dst, const uint64_t *src, size_t n) {
+			size_t i = 0;
+			for (; i + 16 <= n; i += 16) {
+				const __m512i a = _bit_apply_avx512<Op>(
+				    _mm512_loadu_si512(dst + i), _mm512_loadu_si512(src + i));
+				const __m512i b = _bit_apply_avx512<Op>(
+				    _mm512_loadu_si512(dst + i + 8), _mm512_loadu_si512(src + i + 8));
+				_mm512_storeu_si512(dst + i, a);
+				_mm512_storeu_si512(dst + i + 8, b);
+			}
+			if (i < n) {
+				const __mmask8 m = n - i >= 8 ? __mmask8(0xff) : __mmask8((1u << (n - i)) - 1);
+				const __m512i a = _mm512_mask_loadu_epi64(_mm512_setzero_si512(), m, dst + i);
+				const __m512i b = _mm512_mask_loadu_epi64(_mm512_setzero_si512(), m, src + i);
+				_mm512_mask_storeu_epi64(dst + i, m, _bit_apply_avx512<Op>(a, b));
+				for (i += 8; i < n; ++i) dst[i] = _bit_apply<Op>(dst[i], src[i]);
+			}
+		}
+
+		// 每次检查 8 个字，全为 0 时跳过
+		__attribute__((target("avx2"))) inline size_t _find_nonzero_avx2(
+		    const uint64_t *p, size_t n) {
+			size_t i = 0;
+			for (; i + 8 <= n; i += 8) {
+				const __m256i v = _mm256_or_si256(
+				    _mm256_loadu_si256((const __m256i *)(p + i)),
+				    _mm256_loadu_si256((const __m256i *)(p + i + 4)));
+				if (!_mm256_testz_si256(v, v)) break;
+			}
+			for (; i < n; ++i)
+				if (p[i]) return i;
+			return n;
+		}
+
+		__attribute__((target("bmi,bmi2"))) inline unsigned _select_bmi2(uint64_t w, unsigned k) {
+			return unsigned(_tzcnt_u64(_pdep_u64(uint64_t(1) << k, w)));
+		}
+#endif
+
+		/**
+		 * @brief 把 dst 起始的 n 个元素都填充为 *value，元素按字节复制
+		 *
+		 * @param dst 目标空间，按元素大小对齐
+		 * @param n 元素个数
+		 * @param value 填充值的地址
+		 * @param esize 元素大小，必须为 2、4、8 或 16
+		 */
+		inline void fill_pattern(void *dst, size_t n, const void *value, size_t esize) {
+			const size_t bytes = n * esize;
+			char        *d = static_cast<char *>(dst);
+#ifdef LEESTL_SIMD_X86
+			const isa i = active_isa();
+			if (i != ISA_SCALAR && bytes >= 64) {
+				alignas(64) char pat[_PATTERN_BYTES];
+				for (size_t off = 0; off < size_t(_PATTERN_BYTES); off += esize)
+					std::memcpy(pat + off, value, esize);
+				const bool nt = bytes >= nontemporal_threshold();
+				if (i == ISA_AVX512) _fill_avx512(d, bytes, pat, esize, nt);
+				else if (i == ISA_AVX2) _fill_avx2(d, bytes, pat, esize, nt);
+				else _fill_sse2(d, bytes, pat, esize, nt);
+				return;
+			}
+#endif
+			for (size_t off = 0; off < bytes; off += esize) std::memcpy(d + off, value, esize);
+		}
+
+		/**
+		 * @brief 复制 bytes 字节，允许重叠；超过非临时存储阈值且不重叠时绕过缓存写入
+		 *
+		 * @param dst 目标空间
+		 * @param src 原始空间
+		 * @param bytes 字节数
+		 */
+		inline void copy_bytes(void *dst, const void *src, size_t bytes) {
+#ifdef LEESTL_SIMD_X86
+			char       *d = static_cast<char *>(dst);
+			const char *s = static_cast<const char *>(src);
+			if (bytes >= 256 && bytes >= nontemporal_threshold() &&
+			    (d + bytes <= s || s + bytes <= d)) {
+				const isa i = active_isa();
+				if (i == ISA_AVX512) return _copy_nt_avx512(d, s, bytes);
+				if (i == ISA_AVX2) return _copy_nt_avx2(d, s, bytes);
+				if (i == ISA_SSE2) return _copy_nt_sse2(d, s, bytes);
+			}
+#endif
+			__builtin_memmove(dst, src, bytes);
+		}
+
+		// 逐个元素比较的标量版本，数组较短或不支持 SIMD 时使用
+		template <size_t E>
+		inline size_t _find_scalar(const char *p, size_t n, const char *value) {
+			for (size_t k = 0; k < n; ++k)
+				if (std::memcmp(p + k * E, value, E) == 0) return k;
+			return n;
+		}
+
+		template <size_t E>
+		inline size_t _find(const char *p, size_t n, const char *value) {
+			if constexpr (E == 1) {
+				const void *r = n ? std::memchr(p, (unsigned char)*value, n) : nullptr;
+				return r ? static_cast<const char *>(r) - p : n;
+			} else {
+#ifdef LEESTL_SIMD_X86
+				const isa i = active_isa();
+				if (i >= ISA_AVX2 && n * E >= 32) return _find_avx2<E>(p, n * E, value) / E;
+				if (i != ISA_SCALAR && n * E >= 16) return _find_sse2<E>(p, n * E, value) / E;
+#endif
+				return _find_scalar<E>(p, n, value);
+			}
+		}
+
+		template <size_t E>
+		inline size_t _count(const char *p, size_t n, const char *value) {
+#ifdef LEESTL_SIMD_X86
+			const isa i = active_isa();
+			if (i >= ISA_AVX2 && n * E >= 32) return _count_avx2<E>(p, n * E, value) / E;
+			if (i != ISA_SCALAR && n * E >= 16) return _count_sse2<E>(p, n * E, value) / E;
+#endif
+			size_t c = 0;
+			for (size_t k = 0; k < n; ++k) c += std::memcmp(p + k * E, value, E) == 0;
+			return c;
+		}
+
+		/**
+		 * @brief 查找第一个与 *value 逐字节相同的元素
+		 *
+		 * @param first 数组起始位置
+		 * @param n 元素个数
+		 * @param value 查找值的地址
+		 * @param esize 元素大小，必须为 1、2、4 或 8
+		 * @return size_t 该元素的下标，不存在时为 n
+		 */
+		inline size_t find_pattern(const void *first, size_t n, const void *value, size_t esize) {
+			const char *p = static_cast<const char *>(first);
+			const char *v = static_cast<const char *>(value);
+			switch (esize) {
+				case 1: return _find<1>(p, n, v);
+				case 2: return _find<2>(p, n, v);
+				case 4: return _find<4>(p, n, v);
+				default: return _find<8>(p, n, v);
+			}
+		}
+
+		/**
+		 * @brief 统计与 *value 逐字节相同的元素个数
+		 *
+		 * @param first 数组起始位置
+		 * @param n 元素个数
+		 * @param value 统计值的地址
+		 * @param esize 元素大小，必须为 1、2、4 或 8
+		 * @return size_t 元素个数
+		 */
+		inline size_t count_pattern(const void *first, size_t n, const void *value, size_t esize) {
+			const char *p = static_cast<const char *>(first);
+			const char *v = static_cast<const char *>(value);
+			switch (esize) {
+				case 1: return _count<1>(p, n, v);
+				case 2: return _count<2>(p, n, v);
+				case 4: return _count<4>(p, n, v);
+				default: return _count<8>(p, n, v);
+			}
+		}
+
+		/**
+		 * @brief 查找两段空间中第一个不同的字节
+		 *
+		 * @param a 第一段空间
+		 * @param b 第二段空间
+		 * @param bytes 字节数
+		 * @return size_t 第一个不同字节的偏移，全部相同时为 bytes
+		 */
+		inline size_t mismatch_bytes(const void *a, const void *b, size_t bytes) {
+			const char *p = static_cast<const char *>(a);
+			const char *q = static_cast<const char *>(b);
+#ifdef LEESTL_SIMD_X86
+			const isa i = active_isa();
+			if (i >= ISA_AVX2 && bytes >= 32) return _mismatch_avx2(p, q, bytes);
+			if (i != ISA_SCALAR && bytes >= 16) return _mismatch_sse2(p, q, bytes);
+#endif
+			// 先按 8 字节一组比较，找到不同的一组后再逐字节比较
+			size_t k = 0;
+			for (uint64_t x, y; k + 8 <= bytes; k += 8) {
+				std::memcpy(&x, p + k, 8);
+				std::memcpy(&y, q + k, 8);
+				if (x != y) break;
+			}
+			while (k < bytes && p[k] == q[k]) ++k;
+			return k;
+		}
+
+		template <int Op>
+		inline void _bitwise(uint64_t *dst, const uint64_t *src, size_t n) {
+#ifdef LEESTL_SIMD_X86
+			const isa i = active_isa();
+			if (i == ISA_AVX512 && n >= 8) return _bitwise_avx512<Op>(dst, src, n);
+			if (i >= ISA_AVX2 && n >= 8) return _bitwise_avx2<Op>(dst, src, n);
+#endif
+			for (size_t k = 0; k < n; ++k) dst[k] = _bit_apply<Op>(dst[k], src[k]);
+		}
+
+		/**
+		 * @brief 逐字计算 dst[k] = dst[k] op src[k]
+		 *
+		 * @param dst 目标数组，同时是左操作数
+		 * @param src 右操作数数组，与 dst 完全重合或不重叠
+		 * @param n 字数
+		 * @param op 位运算，BIT_ANDNOT 为 dst & ~src
+		 */
+		inline void bitwise_words(uint64_t *dst, const uint64_t *src, size_t n, bit_op op) {
+			switch (op) {
+				case BIT_AND: return _bitwise<BIT_AND>(dst, src, n);
+				case BIT_OR: return _bitwise<BIT_OR>(dst, src, n);
+				case BIT_XOR: return _bitwise<BIT_XOR>(dst, src, n);
+				default: return _bitwise<BIT_ANDNOT>(dst, src, n);
+			}
+		}
+
+		/**
+		 * @brief 统计 n 个字中 1 的个数
+		 *
+		 * 	AVX-512 等级且支持 vpopcntq 时逐通道计数，AVX2 等级按字节查表，
+		 * 	其余情况使用 popcnt 指令或 SWAR
+		 *
+		 * @param p 字数组
+		 * @param n 字数
+		 * @return size_t 1 的个数
+		 */
+		inline size_t popcount_words(const uint64_t *p, size_t n) {
+#ifdef LEESTL_SIMD_X86
+			const isa            i = active_isa();
+			const _bit_features &f = _get_bit_features();
+			if (i == ISA_AVX512 && f.vpopcntdq && n >= 8) return _popcount_avx512(p, n);
+			if (i >= ISA_AVX2 && f.popcnt && n >= 16) return _popcount_avx2(p, n);
+			if (i != ISA_SCALAR && f.popcnt) return _popcount_popcnt(p, n);
+#endif
+			size_t c = 0;
+			for (size_t k = 0; k < n; ++k) c += popcount64(p[k]);
+			return c;
+		}
+
+		/**
+		 * @brief 查找第一个不为 0 的字
+		 *
+		 * @param p 字数组
+		 * @param n 字数
+		 * @return size_t 该字的下标，全为 0 时为 n
+		 */
+		inline size_t find_nonzero_word(const uint64_t *p, size_t n) {
+#ifdef LEESTL_SIMD_X86
+			if (active_isa() >= ISA_AVX2 && n >= 8) return _find_nonzero_avx2(p, n);
+#endif
+			for (size_t k = 0; k < n; ++k)
+				if (p[k]) return k;
+			return n;
+		}
+
+		/**
+		 * @brief 字 w 中第 k 个（从 0 开始）为 1 的位的位置，支持 BMI2 时为一次 pdep 与 tzcnt
+		 *
+		 * @param w 字
+		 * @param k 序号，必须小于 w 中 1 的个数
+		 * @return unsigned 位的位置
+		 */
+		inline unsigned select_in_word(uint64_t w, unsigned k) {
+#ifdef LEESTL_SIMD_X86
+			if (active_isa() != ISA_SCALAR && _get_bit_features().bmi2) return _select_bmi2(w, k);
+#endif
+			for (; k; --k) w &= w - 1;
+			return unsigned(__builtin_ctzll(w));
+		}
+
+	}    // namespace simd
+
+}    // namespace leestl
+
+#endif
@@ -0,0 +1,735 @@
+/** @file small_vector.h
+ * 	这个文件实现带内联存储的序列容器 small_vector
+ *
+ * 	small_vector<T, N> 在对象内部预留 N 个元素的空间，元素个数不超过 N 时不分配堆内存，
+ * 	超过后与 vector 一样在堆上按 2 倍扩容，接口与 leestl::vector 一致。
+ * 	移动构造、移动赋值时堆上的空间直接被接管，内联的元素则逐个迁移（可平凡重定位时整段 memcpy）。
+ */
+
+#ifndef _LEESTL_SMALL_VECTOR_H_
+#define _LEESTL_SMALL_VECTOR_H_
+
+#include <initializer_list>
+#include <stdexcept>
+
+#include "alloc_traits.h"
+#include "allocator.h"
+#include "iterator_base_types.h"
+#include "utils.h"
+#include "uninitialized.h"
+#include "algo.h"
+
+namespace leestl {
+
+	/**
+	 * @brief 带 N 个元素内联存储的 vector
+	 *
+	 * @tparam T 元素类型
+	 * @tparam N 内联存储可容纳的元素个数
+	 * @tparam Alloc 超过 N 个元素后使用的配置器
+	 */
+	template <typename T, size_t N, typename Alloc = leestl::allocator<T>>
+	class small_vector {
+		static_assert(N > 0, "small_vector needs at least one inline element!");
+
+	public:
+		typedef Alloc allocator_type;
+		typedef typename leestl::allocator_traits<Alloc>::template rebind_alloc<T> data_allocator;
+
+	private:
+		typedef leestl::allocator_traits<data_allocator> _alloc_traits;
+
+	public:
+		typedef T                                       value_type;
+		typedef typename _alloc_traits::size_type       size_type;
+		typedef typename _alloc_traits::difference_type difference_type;
+		typedef value_type*                             pointer;
+		typedef const value_type*                       const_pointer;
+		typedef value_type&                             reference;
+		typedef const value_type&                       const_reference;
+
+		typedef value_type*                              iterator;
+		typedef const value_type*                        const_iterator;
+		typedef leestl::reverse_iterator<iterator>       reverse_iterator;
+		typedef leestl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+		static constexpr size_type inline_capacity = N;    // 内联存储的容量
+
+		allocator_type get_allocator() const noexcept { return allocator_type(_get_alloc()); }
+
+	private:
+		// 继承配置器以利用空基类优化，无状态配置器不占用额外空间
+		struct _small_vector_impl : public data_allocator {
+			pointer start;             // 当前已使用空间的起始点
+			pointer finish;            // 当前已使用空间的终止点
+			pointer end_of_storage;    // 当前空间（内联或堆上）的尾部
+
+			_small_vector_impl() noexcept(
+			    std::is_nothrow_default_constructible<data_allocator>::value) :
+			        data_allocator() {}
+			_small_vector_impl(const data_allocator& a) noexcept : data_allocator(a) {}
+			_small_vector_impl(data_allocator&& a) noexcept : data_allocator(leestl::move(a)) {}
+		};
+
+		_small_vector_impl _impl;
+		alignas(T) unsigned char _buf[N * sizeof(T)];    // 内联存储，未初始化
+
+		data_allocator&       _get_alloc() noexcept { return _impl; }
+		const data_allocator& _get_alloc() const noexcept { return _impl; }
+
+		pointer       _inline_data() noexcept { return reinterpret_cast<pointer>(_buf); }
+		const_pointer _inline_data() const noexcept {
+			return reinterpret_cast<const_pointer>(_buf);
+		}
+
+		// 指向空的内联存储
+		void _reset_inline() noexcept {
+			_impl.start = _impl.finish = _inline_data();
+			_impl.end_of_storage = _impl.start + N;
+		}
+
+	public:
+		/**
+		 * @brief small_vector 默认构造函数，不分配内存
+		 *
+		 */
+		small_vector() noexcept(std::is_nothrow_default_constructible<data_allocator>::value) {
+			_reset_inline();
+		}
+
+		/**
+		 * @brief 指定配置器的 small_vector 构造函数
+		 *
+		 * @param alloc 配置器
+		 */
+		explicit small_vector(const allocator_type& alloc) noexcept : _impl(data_allocator(alloc)) {
+			_reset_inline();
+		}
+
+		/**
+		 * @brief 给出大小的 small_vector 构造函数，元素值初始化
+		 *
+		 * @param n small_vector 的大小
+		 * @param alloc 配置器
+		 */
+		explicit small_vector(size_type n, const allocator_type& alloc = allocator_type()) :
+		        _impl(data_allocator(alloc)) {
+			_reset_inline();
+			_default_append(n);
+		}
+
+		/**
+		 * @brief 给出大小、初始值的 small_vector 构造函数
+		 *
+		 * @param n small_vector 的大小
+		 * @param value 初始化值
+		 * @param alloc 配置器
+		 */
+		small_vector(
+		    size_type n, const value_type& value, const allocator_type& alloc = allocator_type()) :
+		        _impl(data_allocator(alloc)) {
+			_reset_inline();
+			_fill_insert(_impl.finish, n, value);
+		}
+
+		/**
+		 * @brief 复制构造函数，配置器由 select_on_container_copy_construction 决定
+		 *
+		 * @param x 要复制的 small_vector
+		 */
+		small_vector(const small_vector& x) :
+		        _impl(_alloc_traits::select_on_container_copy_construction(x._get_alloc())) {
+			_reset_inline();
+			_range_initialize(x.begin(), x.end(), leestl::random_acess_interator_tag());
+		}
+
+		/**
+		 * @brief 移动构造函数，x 在堆上时接管其空间，否则把元素迁移到本对象的内联存储
+		 *
+		 * @param x 要移动的 small_vector，之后为空
+		 */
+		small_vector(small_vector&& x) noexcept(_use_relocate) :
+		        _impl(leestl::move(x._get_alloc())) {
+			_reset_inline();
+			if (x.is_inline()) _take_elements(x);
+			else _steal_storage(x);
+		}
+
+		/**
+		 * @brief 通过初始化列表构造 small_vector
+		 *
+		 * @param il 初始化列表
+		 * @param alloc 配置器
+		 */
+		small_vector(
+		    std::initializer_list<value_type> il, const allocator_type& alloc = allocator_type()) :
+		        _impl(data_allocator(alloc)) {
+			_reset_inline();
+			_range_initialize(il.begin(), il.end(), leestl::random_acess_interator_tag());
+		}
+
+		/**
+		 * @brief 通过迭代器区间构造 small_vector
+		 *
+		 * @tparam _II 迭代器类型
+		 * @param first 区间起始位置
+		 * @param last 区间终止位置
+		 * @param alloc 配置器
+		 */
+		template <typename _II, typename = leestl::RequireInputIterator<_II>>
+		small_vector(_II first, _II last, const allocator_type& alloc = allocator_type()) :
+		        _impl(data_allocator(alloc)) {
+			_reset_inline();
+			_range_initialize(first, last, leestl::iterator_category_types<_II>());
+		}
+
+		/**
+		 * @brief 析构函数
+		 */
+		~small_vector() noexcept {
+			leestl::destory(_impl.start, _impl.finish);
+			_release_heap();
+		}
+
+		// 赋值操作符
+		// 复制赋值，propagate_on_container_copy_assignment 为真时同时复制配置器
+		small_vector& operator=(const small_vector& x) {
+			if (this != &x) {
+				if constexpr (_alloc_traits::propagate_on_container_copy_assignment::value) {
+					if (!_alloc_traits::equal(_get_alloc(), x._get_alloc())) {
+						// 旧配置器无法释放新配置器分配的空间，先用旧配置器释放全部空间
+						clear();
+						_release_heap();
+						_reset_inline();
+					}
+					_get_alloc() = x._get_alloc();
+				}
+				_assign_aux(x.begin(), x.end(), leestl::random_acess_interator_tag());
+			}
+			return *this;
+		}
+
+		// 移动赋值，x 在堆上且配置器可传播或相等时直接接管空间，否则逐个迁移元素
+		small_vector& operator=(small_vector&& x) noexcept(
+		    _use_relocate && (_alloc_traits::propagate_on_container_move_assignment::value ||
+		                      _alloc_traits::is_always_equal::value)) {
+			if (this != &x) {
+				clear();
+				if constexpr (_alloc_traits::propagate_on_container_move_assignment::value) {
+					if (!_alloc_traits::equal(_get_alloc(), x._get_alloc())) {
+						_release_heap();
+						_reset_inline();
+					}
+					_get_alloc() = leestl::move(x._get_alloc());
+				}
+				if (!x.is_inline() && _alloc_traits::equal(_get_alloc(), x._get_alloc())) {
+					_release_heap();
+					_steal_storage(x);
+				} else {
+					reserve(x.size());
+					_take_elements(x);
+				}
+			}
+			return *this;
+		}
+
+		// 初始化列表赋值
+		small_vector& operator=(std::initializer_list<value_type> il) {
+			_assign_aux(il.begin(), il.end(), leestl::random_acess_interator_tag());
+			return *this;
+		}
+
+		// 赋值为 n 个 value
+		void assign(size_type n, const value_type& value) {
+			if (n > capacity()) {
+				small_vector tmp(n, value, get_allocator());
+				*this = leestl::move(tmp);
+			} else if (n > size()) {
+				leestl::fill(begin(), end(), value);
+				_impl.finish = leestl::uninitialized_fill_n(_impl.finish, n - size(), value);
+			} else {
+				_erase_at_end(leestl::fill_n(_impl.start, n, value));
+			}
+		}
+
+		// 赋值为迭代器区间的内容
+		template <typename _II, typename = leestl::RequireInputIterator<_II>>
+		void assign(_II first, _II last) {
+			_assign_aux(first, last, leestl::iterator_category_types<_II>());
+		}
+
+		// 赋值为初始化列表的内容
+		void assign(std::initializer_list<value_type> il) {
+			_assign_aux(il.begin(), il.end(), leestl::random_acess_interator_tag());
+		}
+
+		// 迭代器相关操作
+		iterator               begin() noexcept { return _impl.start; }
+		const_iterator         begin() const noexcept { return _impl.start; }
+		iterator               end() noexcept { return _impl.finish; }
+		const_iterator         end() const noexcept { return _impl.finish; }
+		reverse_iterator       rbegin() noexcept { return reverse_iterator(_impl.finish); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(_impl.finish); }
+		reverse_iterator       rend() noexcept { return reverse_iterator(_impl.start); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(_impl.start); }
+		const_iterator         cbegin() const noexcept { return _impl.start; }
+		const_iterator         cend() const noexcept { return _impl.finish; }
+		const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(_impl.finish); }
+		const_reverse_iterator crend() const noexcept { return const_reverse_iterator(_impl.start); }
+
+		// 容量相关操作
+		bool      empty() const noexcept { return _impl.start == _impl.finish; }
+		size_type size() const noexcept { return size_type(_impl.finish - _impl.start); }
+		size_type max_size() const noexcept { return size_type(-1) / sizeof(T); }
+		size_type capacity() const noexcept { return size_type(_impl.end_of_storage - _impl.start); }
+
+		// 元素是否存放在内联存储中
+		bool is_inline() const noexcept { return _impl.start == _inline_data(); }
+
+		/**
+		 * @brief 预留至少能容纳 n 个元素的空间，不改变元素个数
+		 *
+		 * @param n 需要的容量
+		 */
+		void reserve(size_type n) {
+			if (n > max_size()) throw std::length_error("small_vector::reserve");
+			if (capacity() < n) _reallocate(n);
+		}
+
+		/**
+		 * @brief 改变元素个数，新增的元素值初始化
+		 *
+		 * @param n 新的元素个数
+		 */
+		void resize(size_type n) {
+			if (n > size()) _default_append(n - size());
+			else if (n < size()) _erase_at_end(_impl.start + n);
+		}
+
+		/**
+		 * @brief 改变元素个数，新增的元素复制自 value
+		 *
+		 * @param n 新的元素个数
+		 * @param value 新增元素的初始值
+		 */
+		void resize(size_type n, const value_type& value) {
+			if (n > size()) _fill_insert(end(), n - size(), value);
+			else if (n < size()) _erase_at_end(_impl.start + n);
+		}
+
+		// 释放多余的容量，元素个数不超过 N 时回到内联存储
+		void shrink_to_fit() {
+			if (!is_inline() && capacity() != size()) _reallocate(size());
+		}
+
+		// 元素访问相关操作
+		reference       operator[](size_type n) noexcept { return *(_impl.start + n); }
+		const_reference operator[](size_type n) const noexcept { return *(_impl.start + n); }
+
+		reference at(size_type n) {
+			_range_check(n);
+			return (*this)[n];
+		}
+		const_reference at(size_type n) const {
+			_range_check(n);
+			return (*this)[n];
+		}
+
+		reference       front() noexcept { return *begin(); }
+		const_reference front() const noexcept { return *begin(); }
+		reference       back() noexcept { return *(end() - 1); }
+		const_reference back() const noexcept { return *(end() - 1); }
+
+		value_type*       data() noexcept { return _impl.start; }
+		const value_type* data() const noexcept { return _impl.start; }
+
+		// 修改容器相关操作
+		// 尾部插入元素
+		void push_back(const value_type& value) { emplace_back(value); }
+		void push_back(value_type&& value) { emplace_back(leestl::move(value)); }
+
+		/**
+		 * @brief 在尾部直接构造元素，空间不足时在新空间的最终位置构造
+		 *
+		 * @param args 构造参数
+		 * @return reference 新元素的引用
+		 */
+		template <typename... Args>
+		reference emplace_back(Args&&... args) {
+			if (_impl.finish != _impl.end_of_storage) {
+				_alloc_traits::construct(_get_alloc(), _impl.finish, leestl::forward<Args>(args)...);
+				++_impl.finish;
+			} else {
+				_realloc_insert(_impl.finish, 1, [&](pointer p) {
+					_alloc_traits::construct(_get_alloc(), p, leestl::forward<Args>(args)...);
+				});
+			}
+			return back();
+		}
+
+		// 删除尾部元素
+		void pop_back() noexcept {
+			--_impl.finish;
+			leestl::destory(_impl.finish);
+		}
+
+		/**
+		 * @brief 在 pos 处直接构造元素
+		 *
+		 * @param pos 插入位置
+		 * @param args 构造参数
+		 * @return iterator 新元素的位置
+		 */
+		template <typename... Args>
+		iterator emplace(const_iterator pos, Args&&... args) {
+			const size_type n = pos - cbegin();
+			if (_impl.finish != _impl.end_of_storage) {
+				if (pos == cend()) {
+					_alloc_traits::construct(
+					    _get_alloc(), _impl.finish, leestl::forward<Args>(args)...);
+					++_impl.finish;
+				} else {
+					value_type tmp(leestl::forward<Args>(args)...);    // args 可能引用容器内元素
+					_insert_aux(begin() + n, leestl::move(tmp));
+				}
+			} else {
+				_realloc_insert(_impl.start + n, 1, [&](pointer p) {
+					_alloc_traits::construct(_get_alloc(), p, leestl::forward<Args>(args)...);
+				});
+			}
+			return begin() + n;
+		}
+
+		// 复制插入
+		iterator insert(const_iterator pos, const value_type& value) { return emplace(pos, value); }
+
+		// 移动插入
+		iterator insert(const_iterator pos, value_type&& value) {
+			return emplace(pos, leestl::move(value));
+		}
+
+		// 初始化列表插入
+		iterator insert(const_iterator pos, std::initializer_list<value_type> il) {
+			auto n = pos - cbegin();
+			_range_insert(begin() + n, il.begin(), il.end(), leestl::random_acess_interator_tag());
+			return begin() + n;
+		}
+
+		// 填充插入
+		iterator insert(const_iterator pos, size_type n, const value_type& value) {
+			difference_type _offset = pos - cbegin();
+			_fill_insert(begin() + _offset, n, value);
+			return begin() + _offset;
+		}
+
+		// 范围插入
+		template <typename _II, typename = leestl::RequireInputIterator<_II>>
+		iterator insert(const_iterator pos, _II first, _II last) {
+			difference_type _offset = pos - cbegin();
+			_range_insert(begin() + _offset, first, last, leestl::iterator_category_types<_II>());
+			return begin() + _offset;
+		}
+
+		// 删除指定位置元素
+		iterator erase(const_iterator _pos) {
+			iterator pos = begin() + (_pos - cbegin());
+			if (pos + 1 != end()) leestl::move(pos + 1, end(), pos);
+			pop_back();
+			return pos;
+		}
+
+		// 删除指定范围元素
+		iterator erase(const_iterator _first, const_iterator _last) {
+			iterator first = begin() + (_first - cbegin()), last = begin() + (_last - cbegin());
+			if (first != last) {
+				if (last != end()) leestl::move(last, end(), first);
+				_erase_at_end(first + (end() - last));
+			}
+			return first;
+		}
+
+		// 交换两个 small_vector：都在堆上时只交换指针，否则经由临时对象交换元素
+		void swap(small_vector& x) {
+			if (this == &x) return;
+			if (!is_inline() && !x.is_inline()) {
+				leestl::swap(_impl.start, x._impl.start);
+				leestl::swap(_impl.finish, x._impl.finish);
+				leestl::swap(_impl.end_of_storage, x._impl.end_of_storage);
+				if constexpr (_alloc_traits::propagate_on_container_swap::value)
+					leestl::swap(_get_alloc(), x._get_alloc());
+			} else {
+				small_vector tmp(leestl::move(x));
+				x = leestl::move(*this);
+				*this = leestl::move(tmp);
+			}
+		}
+
+		void clear() noexcept { _erase_at_end(_impl.start); }
+
+	private:
+		// 扩容时能否直接迁移（移动并析构）旧元素：迁移过程必须不抛出异常
+		static constexpr bool _use_relocate = leestl::is_trivially_relocatable<T>::value ||
+		                                      std::is_nothrow_move_constructible<T>::value;
+
+		// 把旧元素转移到新空间：可迁移时移动并析构（可平凡重定位时整段 memcpy），
+		// 否则复制以保证强异常安全，旧元素由调用者在全部成功后析构
+		static pointer _migrate(pointer first, pointer last, pointer result) {
+			if constexpr (_use_relocate) return leestl::relocate(first, last, result);
+			else return leestl::uninitialized_copy(first, last, result);
+		}
+
+		pointer _allocate(size_type n) { return _alloc_traits::allocate(_get_alloc(), n); }
+
+		// 释放堆上的空间（若有），不析构元素
+		void _release_heap() noexcept {
+			if (!is_inline()) _alloc_traits::deallocate(_get_alloc(), _impl.start, capacity());
+		}
+
+		// 接管 x 在堆上的空间，x 回到空的内联存储
+		void _steal_storage(small_vector& x) noexcept {
+			_impl.start = x._impl.start;
+			_impl.finish = x._impl.finish;
+			_impl.end_of_storage = x._impl.end_of_storage;
+			x._reset_inline();
+		}
+
+		// 把 x 的元素移动到本容器（为空且容量足够）的空间中，x 之后为空
+		void _take_elements(small_vector& x) noexcept(_use_relocate) {
+			if constexpr (_use_relocate) {
+				_impl.finish = leestl::relocate(x._impl.start, x._impl.finish, _impl.start);
+				x._impl.finish = x._impl.start;
+			} else {
+				_impl.finish =
+				    leestl::uninitialized_move(x._impl.start, x._impl.finish, _impl.start);
+				x.clear();
+			}
+		}
+
+		void _range_check(size_type n) const {
+			if (n >= size()) throw std::out_of_range("small_vector::_range_check: n >= size()");
+		}
+
+		// 扩容时检查剩余空间并计算新空间大小，按 2 倍增长
+		size_type _check_len(size_type n, const char* s) const {
+			if (max_size() - size() < n) throw std::length_error(s);
+			const size_type len = size() + leestl::max(size(), n);
+			return len > max_size() ? max_size() : len;
+		}
+
+		// 把元素迁移到容量为 n（不小于 size()）的空间，n 不超过 N 时迁回内联存储，
+		// 用于 reserve 与 shrink_to_fit，调用者保证新旧空间不同
+		void _reallocate(size_type n) {
+			const bool to_inline = n <= N;
+			pointer    old_start(_impl.start), old_finish(_impl.finish);
+			pointer    new_start = to_inline ? _inline_data() : _allocate(n);
+			pointer    new_finish;
+			try {
+				new_finish = _migrate(old_start, old_finish, new_start);
+			} catch (...) {
+				if (!to_inline) _alloc_traits::deallocate(_get_alloc(), new_start, n);
+				throw;
+			}
+			if constexpr (!_use_relocate) leestl::destory(old_start, old_finish);
+			_release_heap();
+			_impl.start = new_start;
+			_impl.finish = new_finish;
+			_impl.end_of_storage = new_start + (to_inline ? N : n);
+		}
+
+		/**
+		 * @brief 空间不足时在堆上重新分配空间，并在 pos 处插入 n 个元素
+		 *
+		 * @param pos 插入位置
+		 * @param n 插入的元素个数
+		 * @param construct 在新空间的给定位置构造这 n 个元素，失败时自行清理
+		 */
+		template <typename _Construct>
+		void _realloc_insert(pointer pos, size_type n, _Construct construct) {
+			const size_type len = _check_len(n, "size of small_vector is too big.");
+			const size_type elems_before = pos - _impl.start;
+
+			pointer new_start = _allocate(len);
+			pointer old_start(_impl.start), old_finish(_impl.finish), new_finish(new_start);
+			try {
+				// 先在最终位置构造新元素，构造参数可能引用旧空间中的元素
+				construct(new_start + elems_before);
+				new_finish = pointer();
+				new_finish = _migrate(old_start, pos, new_start);
+				new_finish += n;
+				new_finish = _migrate(pos, old_finish, new_finish);
+			} catch (...) {
+				if (!new_finish)
+					leestl::destory(new_start + elems_before, new_start + elems_before + n);
+				else leestl::destory(new_start, new_finish);
+				_alloc_traits::deallocate(_get_alloc(), new_start, len);
+				throw;
+			}
+			if constexpr (!_use_relocate) leestl::destory(old_start, old_finish);
+			_release_heap();
+			_impl.start = new_start;
+			_impl.finish = new_finish;
+			_impl.end_of_storage = new_start + len;
+		}
+
+		// 在尾部追加 n 个值初始化的元素
+		void _default_append(size_type n) {
+			if (size_type(_impl.end_of_storage - _impl.finish) >= n)
+				_impl.finish = _default_construct_n(_impl.finish, n);
+			else _realloc_insert(_impl.finish, n, [&](pointer p) { _default_construct_n(p, n); });
+		}
+
+		// 在未初始化空间 [first, first + n) 上值初始化元素
+		pointer _default_construct_n(pointer first, size_type n) {
+			pointer curr = first;
+			try {
+				for (; n > 0; --n, ++curr) _alloc_traits::construct(_get_alloc(), curr);
+				return curr;
+			} catch (...) {
+				leestl::destory(first, curr);
+				throw;
+			}
+		}
+
+		// 范围初始化，构造函数中失败时需自行释放已分配的空间
+		template <typename _II>
+		void _range_initialize(_II first, _II last, leestl::input_interator_tag) {
+			try {
+				for (; first != last; ++first) emplace_back(*first);
+			} catch (...) {
+				clear();
+				_release_heap();
+				throw;
+			}
+		}
+
+		template <typename _FI>
+		void _range_initialize(_FI first, _FI last, leestl::forward_interator_tag) {
+			const size_type n = leestl::distance(first, last);
+			if (n > N) {
+				if (n > max_size())
+					throw std::length_error("cannot create small_vector larger than max_size().");
+				_impl.start = _impl.finish = _allocate(n);
+				_impl.end_of_storage = _impl.start + n;
+			}
+			try {
+				_impl.finish = leestl::uninitialized_copy(first, last, _impl.start);
+			} catch (...) {
+				_release_heap();
+				throw;
+			}
+		}
+
+		// 从 pos 处开始擦除元素
+		void _erase_at_end(pointer pos) noexcept {
+			if (_impl.finish != pos) {
+				leestl::destory(pos, _impl.finish);
+				_impl.finish = pos;
+			}
+		}
+
+		// 空间足够时在 pos 处插入元素
+		template <typename _Arg>
+		void _insert_aux(iterator pos, _Arg&& arg) {
+			_alloc_traits::construct(_get_alloc(), _impl.finish, leestl::move(*(_impl.finish - 1)));
+			++_impl.finish;
+			leestl::move_backward(pos, _impl.finish - 2, _impl.finish - 1);
+			*pos = leestl::forward<_Arg>(arg);
+		}
+
+		// 适用于输入迭代器的范围插入
+		template <typename _II>
+		void _range_insert(iterator pos, _II first, _II last, leestl::input_interator_tag) {
+			if (pos == end()) {
+				for (; first != last; ++first) emplace_back(*first);
+			} else if (first != last) {
+				small_vector tmp(first, last, get_allocator());
+				insert(pos, tmp.begin(), tmp.end());
+			}
+		}
+
+		// 适用于前向迭代器的范围插入
+		template <typename _FI>
+		void _range_insert(iterator pos, _FI first, _FI last, leestl::forward_interator_tag) {
+			if (first == last) return;
+			const size_type n = leestl::distance(first, last);
+			if (size_type(_impl.end_of_storage - _impl.finish) >= n) {    // 空间足够
+				const size_type elems_after = _impl.finish - pos;           // pos 后的元素个数
+				pointer         old_finish(_impl.finish);
+				if (elems_after > n) {
+					_impl.finish =
+					    leestl::uninitialized_move(_impl.finish - n, _impl.finish, _impl.finish);
+					leestl::move_backward(pos, old_finish - n, old_finish);
+					leestl::copy(first, last, pos);
+				} else {
+					_FI mid = first;
+					leestl::advance(mid, elems_after);
+					_impl.finish = leestl::uninitialized_copy(mid, last, _impl.finish);
+					_impl.finish = leestl::uninitialized_move(pos, old_finish, _impl.finish);
+					leestl::copy(first, mid, pos);
+				}
+			} else {
+				_realloc_insert(
+				    pos, n, [&](pointer p) { leestl::uninitialized_copy(first, last, p); });
+			}
+		}
+
+		// 填充插入
+		void _fill_insert(iterator pos, size_type n, const value_type& value) {
+			if (n == 0) return;
+			if (size_type(_impl.end_of_storage - _impl.finish) >= n) {    // 空间足够
+				const size_type elems_after = end() - pos;
+				value_type      value_copy = value;
+				pointer         old_finish(_impl.finish);
+				if (elems_after > n) {
+					_impl.finish =
+					    leestl::uninitialized_move(_impl.finish - n, _impl.finish, _impl.finish);
+					leestl::move_backward(pos, old_finish - n, old_finish);
+					leestl::fill(pos, pos + n, value_copy);
+				} else {
+					_impl.finish =
+					    leestl::uninitialized_fill_n(_impl.finish, n - elems_after, value_copy);
+					_impl.finish = leestl::uninitialized_move(pos, old_finish, _impl.finish);
+					leestl::fill(pos, old_finish, value_copy);
+				}
+			} else {
+				_realloc_insert(
+				    pos, n, [&](pointer p) { leestl::uninitialized_fill_n(p, n, value); });
+			}
+		}
+
+		// 适用于输入迭代器的赋值
+		template <typename _II>
+		void _assign_aux(_II first, _II last, leestl::input_interator_tag) {
+			pointer cur = _impl.start;
+			for (; first != last && cur != _impl.finish; ++cur, (void)++first) *cur = *first;
+			if (first == last) _erase_at_end(cur);
+			else _range_insert(end(), first, last, leestl::iterator_category_types<_II>());
+		}
+
+		// 适用于前向迭代器的赋值
+		template <typename _FI>
+		void _assign_aux(_FI first, _FI last, leestl::forward_interator_tag) {
+			const size_type len = leestl::distance(first, last);
+			if (len > capacity()) {
+				clear();
+				_reallocate(len);
+				_impl.finish = leestl::uninitialized_copy(first, last, _impl.start);
+			} else if (size() >= len) {
+				_erase_at_end(leestl::copy(first, last, _impl.start));
+			} else {
+				_FI mid = first;
+				leestl::advance(mid, size());
+				leestl::copy(first, mid, _impl.start);
+				_impl.finish = leestl::uninitialized_copy(mid, last, _impl.finish);
+			}
+		}
+	};
+
+	template <typename T, size_t N, typename Alloc>
+	inline void swap(small_vector<T, N, Alloc>& x, small_vector<T, N, Alloc>& y) {
+		x.swap(y);
+	}
+
+}    // namespace leestl
+
+#endif
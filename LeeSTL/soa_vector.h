@@ -0,0 +1,973 @@
+/** @file soa_vector.h
+ * 	这个文件实现按列存储（structure of arrays）的动态数组 soa_vector
+ *
+ * 	soa_vector<Ts...> 在逻辑上是 tuple<Ts...> 的序列，但每个字段各自存放在一段连续的数组中：
+ * 	只扫描其中一个字段时不会把其余字段读进缓存，相邻元素的同一字段也可以直接用 SIMD 指令成批处理。
+ * 	全部列共用一次分配，每一列的起始地址都对齐到 soa_column_alignment（64 字节）。
+ *
+ * 	按行访问时 operator[] 与迭代器返回由各字段引用组成的 tuple<Ts &...>，可以用结构化绑定取出字段，
+ * 	也可以整体赋值；迭代器只保存各列的起始地址与下标，是随机访问迭代器，但没有 operator->。
+ * 	按列访问时 column<I>() 返回第 I 列的 column_span，data<I>() 返回带对齐提示的原始指针。
+ *
+ * 	扩容时逐列转移元素：字段可平凡重定位时整列 memcpy，移动构造不抛出异常时逐个移动，
+ * 	否则逐列复制，某一列失败时销毁已复制的列并保持原容器不变
+ */
+
+#ifndef _LEESTL_SOA_VECTOR_H_
+#define _LEESTL_SOA_VECTOR_H_ 1
+
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "algo.h"
+#include "alloc_traits.h"
+#include "allocator.h"
+#include "iterator.h"
+#include "type_traits.h"
+#include "uninitialized.h"
+#include "utils.h"
+
+namespace leestl {
+
+	// 每一列起始地址的对齐字节数：一个缓存行，也满足 AVX-512 的对齐加载
+	constexpr size_t soa_column_alignment = 64;
+
+	/**
+	 * @brief soa_vector 中一列元素的视图，只保存起始地址与元素个数，不拥有元素
+	 *
+	 * @tparam T 元素类型，只读视图为 const T
+	 */
+	template <typename T>
+	class column_span {
+	public:
+		typedef T        value_type;
+		typedef size_t   size_type;
+		typedef T       *pointer;
+		typedef T       &reference;
+		typedef T       *iterator;
+
+		column_span() noexcept = default;
+		column_span(T *data, size_t size) noexcept : _data(data), _size(size) {}
+
+		// 可写视图可以转换为只读视图
+		template <typename U, typename = std::enable_if_t<std::is_same<const U, T>::value>>
+		column_span(const column_span<U> &x) noexcept : _data(x.data()), _size(x.size()) {}
+
+		T     *data() const noexcept { return _data; }
+		size_t size() const noexcept { return _size; }
+		bool   empty() const noexcept { return _size == 0; }
+
+		T &operator[](size_t n) const noexcept { return _data[n]; }
+		T &front() const noexcept { return _data[0]; }
+		T &back() const noexcept { return _data[_size - 1]; }
+
+		T *begin() const noexcept { return _data; }
+		T *end() const noexcept { return _data + _size; }
+
+	private:
+		T     *_data = nullptr;
+		size_t _size = 0;
+	};
+
+	/**
+	 * @brief soa_vector 的随机访问迭代器，同时遍历全部列
+	 *
+	 * 	解引用得到由各字段引用组成的 tuple，因此没有 operator->；
+	 * 	比较与相减只看下标，只对同一容器的迭代器有意义
+	 *
+	 * @tparam Const 是否只读
+	 * @tparam Ts 各字段类型
+	 */
+	template <bool Const, typename... Ts>
+	class _soa_iterator {
+		template <typename, typename...>
+		friend class basic_soa_vector;
+		template <bool, typename...>
+		friend class _soa_iterator;
+
+		typedef std::conditional_t<Const, std::tuple<const Ts *...>, std::tuple<Ts *...>> _columns;
+
+	public:
+		typedef random_acess_interator_tag iterator_category;
+		typedef std::tuple<Ts...>          value_type;
+		typedef ptrdiff_t                  difference_type;
+		typedef void                       pointer;
+		typedef std::conditional_t<Const, std::tuple<const Ts &...>, std::tuple<Ts &...>>
+		    reference;
+
+		_soa_iterator() noexcept = default;
+
+		// 可写迭代器可以转换为只读迭代器
+		template <bool C, typename = std::enable_if_t<Const && !C>>
+		_soa_iterator(const _soa_iterator<C, Ts...> &x) noexcept : _cols(x._cols), _i(x._i) {}
+
+		reference operator*() const noexcept { return _at(_i, std::index_sequence_for<Ts...>()); }
+		reference operator[](difference_type n) const noexcept {
+			return _at(_i + n, std::index_sequence_for<Ts...>());
+		}
+
+		// 当前元素的第 I 个字段
+		template <size_t I>
+		auto &get() const noexcept {
+			return std::get<I>(_cols)[_i];
+		}
+
+		// 当前元素的下标
+		difference_type index() const noexcept { return _i; }
+
+		_soa_iterator &operator++() noexcept {
+			++_i;
+			return *this;
+		}
+
+		_soa_iterator operator++(int) noexcept {
+			_soa_iterator tmp = *this;
+			++_i;
+			return tmp;
+		}
+
+		_soa_iterator &operator--() noexcept {
+			--_i;
+			return *this;
+		}
+
+		_soa_iterator operator--(int) noexcept {
+			_soa_iterator tmp = *this;
+			--_i;
+			return tmp;
+		}
+
+		_soa_iterator &operator+=(difference_type n) noexcept {
+			_i += n;
+			return *this;
+		}
+
+		_soa_iterator &operator-=(difference_type n) noexcept {
+			_i -= n;
+			return *this;
+		}
+
+		_soa_iterator operator+(difference_type n) const noexcept {
+			_soa_iterator tmp = *this;
+			return tmp += n;
+		}
+
+		_soa_iterator operator-(difference_type n) const noexcept {
+			_soa_iterator tmp = *this;
+			return tmp -= n;
+		}
+
+		friend _soa_iterator operator+(difference_type n, const _soa_iterator &x) noexcept {
+			return x + n;
+		}
+
+		template <bool C>
+		difference_type operator-(const _soa_iterator<C, Ts...> &x) const noexcept {
+			return _i - x._i;
+		}
+
+		template <bool C>
+		bool operator==(const _soa_iterator<C, Ts...> &x) const noexcept {
+			return _i == x._i;
+		}
+
+		template <bool C>
+		bool operator!=(const _soa_iterator<C, Ts...> &x) const noexcept {
+			return _i != x._i;
+		}
+
+		template <bool C>
+		bool operator<(const _soa_iterator<C, Ts...> &x) const noexcept {
+			return _i < x._i;
+		}
+
+		template <bool C>
+		bool operator>(const _soa_iterator<C, Ts...> &x) const noexcept {
+			return x._i < _i;
+		}
+
+		template <bool C>
+		bool operator<=(const _soa_iterator<C, Ts...> &x) const noexcept {
+			return _i <= x._i;
+		}
+
+		template <bool C>
+		bool operator>=(const _soa_iterator<C, Ts...> &x) const noexcept {
+			return _i >= x._i;
+		}
+
+	private:
+		_columns        _cols{};    // 各列的起始地址
+		difference_type _i = 0;     // 当前元素的下标
+
+		_soa_iterator(const _columns &cols, difference_type i) noexcept : _cols(cols), _i(i) {}
+
+		template <size_t... I>
+		reference _at(difference_type i, std::index_sequence<I...>) const noexcept {
+			return reference(std::get<I>(_cols)[i]...);
+		}
+	};
+
+	/**
+	 * @brief 按列存储的动态数组
+	 *
+	 * @tparam Alloc 配置器类型，按字节重绑定后为全部列分配一整块空间
+	 * @tparam Ts 各字段类型，对齐要求不超过 soa_column_alignment
+	 */
+	template <typename Alloc, typename... Ts>
+	class basic_soa_vector {
+		static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one field");
+		static_assert(
+		    ((alignof(Ts) <= soa_column_alignment) && ...),
+		    "soa_vector fields must not be over-aligned");
+
+	public:
+		typedef Alloc allocator_type;    // 配置器类型
+		typedef typename leestl::allocator_traits<Alloc>::template rebind_alloc<unsigned char>
+		    data_allocator;
+
+	private:
+		typedef leestl::allocator_traits<data_allocator> _alloc_traits;
+		typedef std::tuple<Ts *...>                      _columns;
+		typedef std::index_sequence_for<Ts...>           _indices;
+
+	public:
+		typedef std::tuple<Ts...>                       value_type;
+		typedef typename _alloc_traits::size_type       size_type;
+		typedef typename _alloc_traits::difference_type difference_type;
+		typedef std::tuple<Ts &...>                     reference;
+		typedef std::tuple<const Ts &...>               const_reference;
+
+		typedef _soa_iterator<false, Ts...>              iterator;
+		typedef _soa_iterator<true, Ts...>               const_iterator;
+		typedef leestl::reverse_iterator<iterator>       reverse_iterator;
+		typedef leestl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+		// 第 I 个字段的类型
+		template <size_t I>
+		using field_type = std::tuple_element_t<I, value_type>;
+
+		static constexpr size_t field_count = sizeof...(Ts);    // 字段个数
+
+		allocator_type get_allocator() const noexcept { return allocator_type(_get_alloc()); }
+
+	private:
+		// 一次分配得到的空间：raw 为配置器返回的地址，columns 为对齐后的各列起始地址
+		struct _block {
+			unsigned char *raw = nullptr;
+			size_type      bytes = 0;
+			_columns       columns{};
+		};
+
+		// 继承配置器以利用空基类优化，无状态配置器不占用额外空间
+		struct _soa_vector_impl : public data_allocator {
+			_block    storage;         // 全部列共用的存储空间
+			size_type size = 0;        // 元素个数
+			size_type capacity = 0;    // 每一列能容纳的元素个数
+
+			_soa_vector_impl() noexcept(
+			    std::is_nothrow_default_constructible<data_allocator>::value)
+			        : data_allocator() {}
+			_soa_vector_impl(const data_allocator &a) noexcept : data_allocator(a) {}
+			_soa_vector_impl(data_allocator &&a) noexcept : data_allocator(leestl::move(a)) {}
+
+			// 交换数据，不交换配置器
+			void _swap_data(_soa_vector_impl &x) noexcept {
+				leestl::swap(storage.raw, x.storage.raw);
+				leestl::swap(storage.bytes, x.storage.bytes);
+				storage.columns.swap(x.storage.columns);
+				leestl::swap(size, x.size);
+				leestl::swap(capacity, x.capacity);
+			}
+		};
+
+		_soa_vector_impl _impl;
+
+		data_allocator       &_get_alloc() noexcept { return _impl; }
+		const data_allocator &_get_alloc() const noexcept { return _impl; }
+
+	public:
+		/**
+		 * @brief soa_vector 默认构造函数，不分配空间
+		 *
+		 */
+		basic_soa_vector() = default;
+
+		/**
+		 * @brief 指定配置器的 soa_vector 构造函数
+		 *
+		 * @param alloc 配置器
+		 */
+		explicit basic_soa_vector(const allocator_type &alloc) noexcept
+		        : _impl(data_allocator(alloc)) {}
+
+		/**
+		 * @brief 构造 n 个各字段值初始化的元素
+		 *
+		 * @param n 元素个数
+		 * @param alloc 配置器
+		 */
+		explicit basic_soa_vector(size_type n, const allocator_type &alloc = allocator_type())
+		        : _impl(data_allocator(alloc)) {
+			_guarded([&] { resize(n); });
+		}
+
+		/**
+		 * @brief 构造 n 个值为 value 的元素
+		 *
+		 * @param n 元素个数
+		 * @param value 元素的值
+		 * @param alloc 配置器
+		 */
+		basic_soa_vector(
+		    size_type n, const value_type &value, const allocator_type &alloc = allocator_type())
+		        : _impl(data_allocator(alloc)) {
+			_guarded([&] { resize(n, value); });
+		}
+
+		/**
+		 * @brief 用区间 [first, last) 中的元素构造，元素类型需能转换为 value_type
+		 *
+		 * @tparam _II 迭代器类型
+		 * @param first 区间起始
+		 * @param last 区间终止
+		 * @param alloc 配置器
+		 */
+		template <typename _II, typename = leestl::RequireInputIterator<_II>>
+		basic_soa_vector(_II first, _II last, const allocator_type &alloc = allocator_type())
+		        : _impl(data_allocator(alloc)) {
+			_guarded([&] {
+				for (; first != last; ++first) push_back(value_type(*first));
+			});
+		}
+
+		/**
+		 * @brief 用初始化列表中的元素构造
+		 *
+		 * @param il 初始化列表
+		 * @param alloc 配置器
+		 */
+		basic_soa_vector(
+		    std::initializer_list<value_type> il, const allocator_type &alloc = allocator_type())
+		        : _impl(data_allocator(alloc)) {
+			_guarded([&] { _append_copy(il.begin(), il.size()); });
+		}
+
+		/**
+		 * @brief 复制构造函数，按 x 的元素个数分配空间后逐列复制，
+		 * 	配置器由 select_on_container_copy_construction 决定
+		 *
+		 * @param x 要复制的 soa_vector
+		 */
+		basic_soa_vector(const basic_soa_vector &x)
+		        : _impl(_alloc_traits::select_on_container_copy_construction(x._get_alloc())) {
+			_guarded([&] { _copy_from(x); });
+		}
+
+		/**
+		 * @brief 指定配置器的复制构造函数
+		 *
+		 * @param x 要复制的 soa_vector
+		 * @param alloc 配置器
+		 */
+		basic_soa_vector(const basic_soa_vector &x, const allocator_type &alloc)
+		        : _impl(data_allocator(alloc)) {
+			_guarded([&] { _copy_from(x); });
+		}
+
+		/**
+		 * @brief 移动构造函数，接管 x 的存储空间与配置器，x 变为空
+		 */
+		basic_soa_vector(basic_soa_vector &&x) noexcept : _impl(leestl::move(x._get_alloc())) {
+			_impl._swap_data(x._impl);
+		}
+
+		/**
+		 * @brief 指定配置器的移动构造函数，配置器不相等时只能分配新空间并逐列移动元素
+		 *
+		 * @param x 要移动的 soa_vector
+		 * @param alloc 配置器
+		 */
+		basic_soa_vector(basic_soa_vector &&x, const allocator_type &alloc)
+		        : _impl(data_allocator(alloc)) {
+			if (_alloc_traits::equal(_get_alloc(), x._get_alloc())) {
+				_impl._swap_data(x._impl);
+			} else {
+				_guarded([&] { _move_from(x); });
+			}
+		}
+
+		~basic_soa_vector() noexcept {
+			clear();
+			_free_block(_impl.storage);
+		}
+
+		// 复制赋值，容量足够时沿用原有空间
+		basic_soa_vector &operator=(const basic_soa_vector &x) {
+			if (this != &x) {
+				clear();
+				if constexpr (_alloc_traits::propagate_on_container_copy_assignment::value) {
+					// 旧配置器无法释放新配置器分配的空间，先用旧配置器释放
+					if (!_alloc_traits::equal(_get_alloc(), x._get_alloc())) _release();
+					_get_alloc() = x._get_alloc();
+				}
+				_copy_from(x);
+			}
+			return *this;
+		}
+
+		// 移动赋值，配置器可传播或相等时直接接管空间，否则逐列移动元素
+		basic_soa_vector &operator=(basic_soa_vector &&x) noexcept(
+		    _alloc_traits::propagate_on_container_move_assignment::value ||
+		    _alloc_traits::is_always_equal::value) {
+			if (this != &x) {
+				if constexpr (_alloc_traits::propagate_on_container_move_assignment::value) {
+					_move_assign(x);
+					_get_alloc() = leestl::move(x._get_alloc());
+				} else if (_alloc_traits::equal(_get_alloc(), x._get_alloc())) {
+					_move_assign(x);
+				} else {
+					basic_soa_vector tmp(leestl::move(x), _get_alloc());    // 用本容器的配置器
+					_move_assign(tmp);
+				}
+			}
+			return *this;
+		}
+
+		basic_soa_vector &operator=(std::initializer_list<value_type> il) {
+			clear();
+			_append_copy(il.begin(), il.size());
+			return *this;
+		}
+
+		// 迭代器相关操作，扩容后原有迭代器失效
+		iterator       begin() noexcept { return iterator(_impl.storage.columns, 0); }
+		const_iterator begin() const noexcept { return const_iterator(_impl.storage.columns, 0); }
+		iterator       end() noexcept { return iterator(_impl.storage.columns, _ssize()); }
+		const_iterator end() const noexcept {
+			return const_iterator(_impl.storage.columns, _ssize());
+		}
+		reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+		const_iterator         cbegin() const noexcept { return begin(); }
+		const_iterator         cend() const noexcept { return end(); }
+		const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+		const_reverse_iterator crend() const noexcept { return rend(); }
+
+		// 容量相关操作
+		bool      empty() const noexcept { return _impl.size == 0; }
+		size_type size() const noexcept { return _impl.size; }
+		size_type capacity() const noexcept { return _impl.capacity; }
+
+		// 每个元素占用各字段大小之和，每一列另有至多一个对齐单位的填充
+		size_type max_size() const noexcept {
+			constexpr size_type row_bytes = (sizeof(Ts) + ...);
+			constexpr size_type padding = (sizeof...(Ts) + 1) * soa_column_alignment;
+			const size_type     bytes = _alloc_traits::max_size(_get_alloc());
+			return bytes < padding ? 0 : (bytes - padding) / row_bytes;
+		}
+
+		/**
+		 * @brief 使容量至少为 n，扩容时逐列转移元素
+		 *
+		 * @param n 容量
+		 */
+		void reserve(size_type n) {
+			if (n > capacity()) _reallocate(n);
+		}
+
+		// 把容量缩小到元素个数，没有元素时释放全部空间
+		void shrink_to_fit() {
+			if (_impl.size == _impl.capacity) return;
+			if (_impl.size == 0) _release();
+			else _reallocate(_impl.size);
+		}
+
+		// 元素访问相关操作，按行访问得到各字段引用组成的 tuple
+		reference operator[](size_type n) noexcept { return _row(n, _indices()); }
+		const_reference operator[](size_type n) const noexcept { return _row(n, _indices()); }
+
+		reference at(size_type n) {
+			_range_check(n);
+			return (*this)[n];
+		}
+		const_reference at(size_type n) const {
+			_range_check(n);
+			return (*this)[n];
+		}
+
+		reference       front() noexcept { return (*this)[0]; }
+		const_reference front() const noexcept { return (*this)[0]; }
+		reference       back() noexcept { return (*this)[_impl.size - 1]; }
+		const_reference back() const noexcept { return (*this)[_impl.size - 1]; }
+
+		/**
+		 * @brief 第 n 个元素的第 I 个字段
+		 *
+		 * @tparam I 字段序号
+		 * @param n 元素下标
+		 */
+		template <size_t I>
+		field_type<I> &get(size_type n) noexcept {
+			return std::get<I>(_impl.storage.columns)[n];
+		}
+		template <size_t I>
+		const field_type<I> &get(size_type n) const noexcept {
+			return std::get<I>(_impl.storage.columns)[n];
+		}
+
+		/**
+		 * @brief 第 I 列的起始地址，按 soa_column_alignment 对齐并告知编译器，
+		 * 	没有分配空间时为空指针
+		 *
+		 * @tparam I 字段序号
+		 */
+		template <size_t I>
+		field_type<I> *data() noexcept {
+			return _assume_aligned(std::get<I>(_impl.storage.columns));
+		}
+		template <size_t I>
+		const field_type<I> *data() const noexcept {
+			return _assume_aligned(std::get<I>(_impl.storage.columns));
+		}
+
+		/**
+		 * @brief 第 I 列全部元素的视图，扩容后失效
+		 *
+		 * @tparam I 字段序号
+		 */
+		template <size_t I>
+		column_span<field_type<I>> column() noexcept {
+			return column_span<field_type<I>>(data<I>(), _impl.size);
+		}
+		template <size_t I>
+		column_span<const field_type<I>> column() const noexcept {
+			return column_span<const field_type<I>>(data<I>(), _impl.size);
+		}
+
+		// 修改容器相关操作
+		void push_back(const value_type &value) { _emplace_row(value); }
+		void push_back(value_type &&value) { _emplace_row(leestl::move(value)); }
+
+		/**
+		 * @brief 在尾部构造一个元素，每个参数依次构造一个字段；
+		 * 	参数可以引用本容器的元素，扩容时先在新空间构造新元素再转移旧元素
+		 *
+		 * @param args 各字段的构造参数，个数与字段个数相同
+		 * @return reference 新元素
+		 */
+		template <typename... Args>
+		reference emplace_back(Args &&...args) {
+			static_assert(
+			    sizeof...(Args) == sizeof...(Ts), "emplace_back takes one argument per field");
+			_emplace_row(std::forward_as_tuple(leestl::forward<Args>(args)...));
+			return back();
+		}
+
+		void pop_back() noexcept {
+			--_impl.size;
+			_destroy_rows(_impl.size, _impl.size + 1);
+		}
+
+		/**
+		 * @brief 改变元素个数，新增的元素各字段值初始化
+		 *
+		 * @param n 新的元素个数
+		 */
+		void resize(size_type n) {
+			_resize(n, [this](auto, auto *first, auto *last) { _value_init(first, last); });
+		}
+
+		/**
+		 * @brief 改变元素个数，新增的元素复制 value
+		 *
+		 * @param n 新的元素个数
+		 * @param value 新增元素的值
+		 */
+		void resize(size_type n, const value_type &value) {
+			// value 可能引用本容器的元素，先复制一份再扩容
+			const value_type copy(value);
+			_resize(n, [&copy](auto k, auto *first, auto *last) {
+				leestl::uninitialized_fill(first, last, std::get<k>(copy));
+			});
+		}
+
+		/**
+		 * @brief 删除一个元素，之后的元素逐列前移
+		 *
+		 * @param pos 被删除元素的位置
+		 * @return iterator 被删除元素之后的元素的位置
+		 */
+		iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+		/**
+		 * @brief 删除 [first, last) 中的元素，之后的元素逐列前移
+		 *
+		 * @param first 区间起始
+		 * @param last 区间终止
+		 * @return iterator 被删除区间之后的元素的位置
+		 */
+		iterator erase(const_iterator first, const_iterator last) {
+			const size_type lo = size_type(first._i), hi = size_type(last._i);
+			if (lo != hi) {
+				_for_each_field([&](auto k) {
+					auto *col = std::get<k>(_impl.storage.columns);
+					leestl::move(col + hi, col + _impl.size, col + lo);
+				});
+				const size_type n = _impl.size - (hi - lo);
+				_destroy_rows(n, _impl.size);
+				_impl.size = n;
+			}
+			return iterator(_impl.storage.columns, difference_type(lo));
+		}
+
+		// 交换两个 soa_vector，propagate_on_container_swap 为真时同时交换配置器
+		void swap(basic_soa_vector &x) noexcept {
+			_impl._swap_data(x._impl);
+			if constexpr (_alloc_traits::propagate_on_container_swap::value)
+				leestl::swap(_get_alloc(), x._get_alloc());
+		}
+
+		// 销毁所有元素，保留存储空间
+		void clear() noexcept {
+			_destroy_rows(0, _impl.size);
+			_impl.size = 0;
+		}
+
+	private:
+		// 扩容时能否直接迁移（移动并析构）旧元素：每一列的迁移都必须不抛出异常
+		static constexpr bool _use_relocate =
+		    ((leestl::is_trivially_relocatable<Ts>::value ||
+		      std::is_nothrow_move_constructible<Ts>::value) &&
+		     ...);
+
+		difference_type _ssize() const noexcept { return difference_type(_impl.size); }
+
+		void _range_check(size_type n) const {
+			if (n >= size()) throw std::out_of_range("soa_vector::_range_check: n >= size()");
+		}
+
+		template <typename T>
+		static T *_assume_aligned(T *p) noexcept {
+			return static_cast<T *>(__builtin_assume_aligned(p, soa_column_alignment));
+		}
+
+		// 依次以 integral_constant<size_t, I> 为参数对每一列调用 f
+		template <typename F, size_t... I>
+		static void _for_each_field(F &&f, std::index_sequence<I...>) {
+			(f(std::integral_constant<size_t, I>()), ...);
+		}
+
+		template <typename F>
+		static void _for_each_field(F &&f) {
+			_for_each_field(f, _indices());
+		}
+
+		template <size_t... I>
+		reference _row(size_type n, std::index_sequence<I...>) noexcept {
+			return reference(std::get<I>(_impl.storage.columns)[n]...);
+		}
+
+		template <size_t... I>
+		const_reference _row(size_type n, std::index_sequence<I...>) const noexcept {
+			return const_reference(std::get<I>(_impl.storage.columns)[n]...);
+		}
+
+		// 容量为 n 时各列相对于对齐起点的偏移，返回全部列占用的字节数
+		static size_type _column_offsets(size_type n, size_type (&offset)[sizeof...(Ts)]) noexcept {
+			constexpr size_type sizes[] = {sizeof(Ts)...};
+			size_type           bytes = 0;
+			for (size_t k = 0; k < sizeof...(Ts); ++k) {
+				offset[k] = bytes;
+				bytes += (n * sizes[k] + soa_column_alignment - 1) & ~(soa_column_alignment - 1);
+			}
+			return bytes;
+		}
+
+		template <size_t... I>
+		static void _place_columns(
+		    _columns &cols, unsigned char *base, const size_type *offset,
+		    std::index_sequence<I...>) noexcept {
+			((std::get<I>(cols) = reinterpret_cast<std::tuple_element_t<I, value_type> *>(
+			      base + offset[I])),
+			 ...);
+		}
+
+		// 分配容量为 n 的空间：多分配一个对齐单位，再把起点向上对齐
+		_block _allocate_block(size_type n) {
+			if (n > max_size())
+				throw std::length_error("cannot create soa_vector larger than max_size().");
+			_block b;
+			if (n == 0) return b;
+			size_type offset[sizeof...(Ts)];
+			b.bytes = _column_offsets(n, offset) + soa_column_alignment - 1;
+			b.raw = _alloc_traits::allocate(_get_alloc(), b.bytes);
+			const uintptr_t addr = reinterpret_cast<uintptr_t>(b.raw);
+			const uintptr_t aligned =
+			    (addr + soa_column_alignment - 1) & ~uintptr_t(soa_column_alignment - 1);
+			_place_columns(b.columns, b.raw + (aligned - addr), offset, _indices());
+			return b;
+		}
+
+		void _free_block(_block &b) noexcept {
+			if (b.raw) _alloc_traits::deallocate(_get_alloc(), b.raw, b.bytes);
+			b = _block();
+		}
+
+		// 换用新空间，旧元素已由调用者转移或销毁
+		void _adopt(_block &b, size_type capacity) noexcept {
+			_free_block(_impl.storage);
+			_impl.storage = b;
+			_impl.capacity = capacity;
+		}
+
+		// 销毁全部元素并释放空间
+		void _release() noexcept {
+			clear();
+			_free_block(_impl.storage);
+			_impl.capacity = 0;
+		}
+
+		// 构造函数中执行 f，出现异常时销毁已有元素并释放空间
+		template <typename F>
+		void _guarded(F f) {
+			try {
+				f();
+			} catch (...) {
+				_release();
+				throw;
+			}
+		}
+
+		// 销毁各列下标在 [first, last) 中的元素
+		void _destroy_rows(size_type first, size_type last) noexcept {
+			_destroy_rows(_impl.storage.columns, first, last);
+		}
+
+		static void _destroy_rows(const _columns &cols, size_type first, size_type last) noexcept {
+			_for_each_field([&](auto k) {
+				leestl::destory(std::get<k>(cols) + first, std::get<k>(cols) + last);
+			});
+		}
+
+		/**
+		 * @brief 依次对每一列调用 f(k)，在 cols 各列的 [first, last) 上构造元素
+		 *
+		 * 	f 在单列上失败时自行销毁已构造的元素；某一列失败时再销毁之前各列已构造的元素，然后抛出
+		 */
+		template <typename F>
+		static void _build_rows(const _columns &cols, size_type first, size_type last, F f) {
+			size_t done = 0;    // 已完成的列数
+			try {
+				_for_each_field([&](auto k) {
+					f(k);
+					++done;
+				});
+			} catch (...) {
+				_for_each_field([&](auto k) {
+					if (k < done)
+						leestl::destory(std::get<k>(cols) + first, std::get<k>(cols) + last);
+				});
+				throw;
+			}
+		}
+
+		// 在 cols 的下标 i 处用 args 中对应的参数逐列构造一个元素
+		template <typename Tuple>
+		void _construct_row(const _columns &cols, size_type i, Tuple &&args) {
+			_build_rows(cols, i, i + 1, [&](auto k) {
+				_alloc_traits::construct(
+				    _get_alloc(), std::get<k>(cols) + i, std::get<k>(leestl::forward<Tuple>(args)));
+			});
+		}
+
+		// 把全部旧元素转移到 cols：可迁移时逐列移动并析构，否则逐列复制后再析构旧元素
+		void _transfer(const _columns &cols) {
+			const size_type n = _impl.size;
+			if constexpr (_use_relocate) {
+				_for_each_field([&](auto k) {
+					auto *col = std::get<k>(_impl.storage.columns);
+					leestl::relocate(col, col + n, std::get<k>(cols));
+				});
+			} else {
+				_build_rows(cols, 0, n, [&](auto k) {
+					auto *col = std::get<k>(_impl.storage.columns);
+					leestl::uninitialized_copy(col, col + n, std::get<k>(cols));
+				});
+				_destroy_rows(0, n);
+			}
+		}
+
+		// 重新分配容量为 n 的空间，n 不小于元素个数
+		void _reallocate(size_type n) {
+			_block b = _allocate_block(n);
+			try {
+				_transfer(b.columns);
+			} catch (...) {
+				_free_block(b);
+				throw;
+			}
+			_adopt(b, n);
+		}
+
+		// 扩容后的容量，与 vector 的默认策略相同
+		size_type _next_capacity(size_type n) const {
+			if (max_size() - size() < n) throw std::length_error("soa_vector::_next_capacity");
+			const size_type len = size() + leestl::max(size(), n);
+			return len > max_size() ? max_size() : len;
+		}
+
+		// 在尾部构造一个元素；已满时先在新空间构造新元素，参数引用旧元素时仍然有效
+		template <typename Tuple>
+		void _emplace_row(Tuple &&args) {
+			if (_impl.size != _impl.capacity) {
+				_construct_row(_impl.storage.columns, _impl.size, leestl::forward<Tuple>(args));
+				++_impl.size;
+				return;
+			}
+			const size_type cap = _next_capacity(1);
+			_block          b = _allocate_block(cap);
+			try {
+				_construct_row(b.columns, _impl.size, leestl::forward<Tuple>(args));
+				try {
+					_transfer(b.columns);
+				} catch (...) {
+					_destroy_rows(b.columns, _impl.size, _impl.size + 1);
+					throw;
+				}
+			} catch (...) {
+				_free_block(b);
+				throw;
+			}
+			_adopt(b, cap);
+			++_impl.size;
+		}
+
+		// 把元素个数改为 n，新增部分由 init(k, first, last) 在第 k 列上构造
+		template <typename Init>
+		void _resize(size_type n, Init init) {
+			if (n <= _impl.size) {
+				_destroy_rows(n, _impl.size);
+				_impl.size = n;
+				return;
+			}
+			if (n > _impl.capacity) _reallocate(_next_capacity(n - _impl.size));
+			const _columns &cols = _impl.storage.columns;
+			_build_rows(cols, _impl.size, n, [&](auto k) {
+				init(k, std::get<k>(cols) + _impl.size, std::get<k>(cols) + n);
+			});
+			_impl.size = n;
+		}
+
+		// 通过配置器值初始化 [first, last) 上的元素
+		template <typename T>
+		void _value_init(T *first, T *last) {
+			T *curr = first;
+			try {
+				for (; curr != last; ++curr) _alloc_traits::construct(_get_alloc(), curr);
+			} catch (...) {
+				leestl::destory(first, curr);
+				throw;
+			}
+		}
+
+		// 在尾部逐列复制 n 个 tuple 形式的元素
+		void _append_copy(const value_type *src, size_type n) {
+			if (n == 0) return;
+			if (_impl.size + n > _impl.capacity) _reallocate(_next_capacity(n));
+			const _columns &cols = _impl.storage.columns;
+			const size_type first = _impl.size;
+			_build_rows(cols, first, first + n, [&](auto k) {
+				auto     *col = std::get<k>(cols) + first;
+				size_type i = 0;
+				try {
+					for (; i < n; ++i)
+						_alloc_traits::construct(_get_alloc(), col + i, std::get<k>(src[i]));
+				} catch (...) {
+					leestl::destory(col, col + i);
+					throw;
+				}
+			});
+			_impl.size += n;
+		}
+
+		// 空容器或已清空的容器复制 x 的全部元素，容量不足时按 x 的元素个数分配
+		void _copy_from(const basic_soa_vector &x) {
+			const size_type n = x.size();
+			if (n > _impl.capacity) {
+				_free_block(_impl.storage);
+				_impl.capacity = 0;
+				_block b = _allocate_block(n);
+				_adopt(b, n);
+			}
+			const _columns &cols = _impl.storage.columns;
+			_build_rows(cols, 0, n, [&](auto k) {
+				auto *src = std::get<k>(x._impl.storage.columns);
+				leestl::uninitialized_copy(src, src + n, std::get<k>(cols));
+			});
+			_impl.size = n;
+		}
+
+		// 空容器逐列移动 x 的全部元素，供配置器不相等时使用
+		void _move_from(basic_soa_vector &x) {
+			const size_type n = x.size();
+			_block          b = _allocate_block(n);
+			_adopt(b, n);
+			const _columns &cols = _impl.storage.columns;
+			_build_rows(cols, 0, n, [&](auto k) {
+				auto *src = std::get<k>(x._impl.storage.columns);
+				leestl::uninitialized_move(src, src + n, std::get<k>(cols));
+			});
+			_impl.size = n;
+			x.clear();
+		}
+
+		void _move_assign(basic_soa_vector &x) noexcept {
+			basic_soa_vector tmp(_get_alloc());
+			_impl._swap_data(tmp._impl);
+			_impl._swap_data(x._impl);
+		}
+
+		// 逐列比较前 n 个元素
+		friend bool operator==(const basic_soa_vector &x, const basic_soa_vector &y) {
+			if (x.size() != y.size()) return false;
+			bool equal = true;
+			_for_each_field([&](auto k) {
+				auto *a = std::get<k>(x._impl.storage.columns);
+				auto *b = std::get<k>(y._impl.storage.columns);
+				equal = equal && leestl::equal(a, a + x.size(), b);
+			});
+			return equal;
+		}
+	};
+
+	template <typename Alloc, typename... Ts>
+	inline bool operator!=(
+	    const basic_soa_vector<Alloc, Ts...> &x, const basic_soa_vector<Alloc, Ts...> &y) {
+		return !(x == y);
+	}
+
+	template <typename Alloc, typename... Ts>
+	inline bool operator<(
+	    const basic_soa_vector<Alloc, Ts...> &x, const basic_soa_vector<Alloc, Ts...> &y) {
+		return leestl::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+	}
+
+	template <typename Alloc, typename... Ts>
+	inline void swap(
+	    basic_soa_vector<Alloc, Ts...> &x, basic_soa_vector<Alloc, Ts...> &y) noexcept {
+		x.swap(y);
+	}
+
+	// 使用默认配置器的按列存储动态数组
+	template <typename... Ts>
+	using soa_vector = basic_soa_vector<leestl::allocator<unsigned char>, Ts...>;
+
+}    // namespace leestl
+
+#endif
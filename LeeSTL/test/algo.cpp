@@ -0,0 +1,443 @@
+/**
+ * @file algo.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl 算法测试程序
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "../LeeSTL/algorithm.h"
+#include "../LeeSTL/vector.h"
+
+template <typename T>
+std::ostream &operator<<(std::ostream &os, const leestl::vector<T> &v) {
+	for (auto &i : v) { os << i << " "; }
+	os << std::endl;
+	return os;
+}
+
+using std::cout;
+using std::endl;
+
+// 按 key 比较，用于检查稳定性
+struct record {
+	int key, seq;
+};
+
+static std::mt19937 g_rng(20261018);
+
+// 生成各种分布的输入
+leestl::vector<int> make_input(const std::string &pattern, size_t n) {
+	leestl::vector<int> v(n);
+	for (size_t i = 0; i < n; ++i) {
+		if (pattern == "random") v[i] = int(g_rng());
+		else if (pattern == "sorted") v[i] = int(i);
+		else if (pattern == "reversed") v[i] = int(n - i);
+		else if (pattern == "organ_pipe") v[i] = int(i < n / 2 ? i : n - i);
+		else if (pattern == "few_unique") v[i] = int(g_rng() % 4);
+		else v[i] = 7;
+	}
+	return v;
+}
+
+bool same(const leestl::vector<int> &a, const leestl::vector<int> &b) {
+	return a.size() == b.size() && std::equal(a.data(), a.data() + a.size(), b.data());
+}
+
+// 在 [0, 4) 的随机数组上与 std 的查找、计数、比较结果对照，覆盖向量宽度附近的长度与非对齐起点
+template <typename T>
+bool check_search() {
+	for (size_t n : {0, 1, 15, 16, 17, 31, 32, 33, 127, 128, 129, 1000, 70000}) {
+		leestl::vector<T> a(n + 1), b(n + 1);
+		T *p = a.data() + 1, *q = b.data() + 1;
+		for (size_t i = 0; i < n; ++i) p[i] = q[i] = T(g_rng() % 4);
+		for (int x = -1; x < 5; ++x) {
+			if (leestl::find(p, p + n, x) != std::find(p, p + n, x)) return false;
+			if (leestl::count(p, p + n, x) != std::count(p, p + n, x)) return false;
+		}
+		for (int k = 0; k < 8 && n; ++k) {
+			q[g_rng() % n] = T(g_rng() % 4);
+			const size_t m = g_rng() % (n + 1);
+			if (leestl::mismatch(p, p + n, q) != std::mismatch(p, p + n, q) ||
+			    leestl::equal(p, p + n, q) != std::equal(p, p + n, q) ||
+			    leestl::lexicographical_compare(p, p + n, q, q + m) !=
+			        std::lexicographical_compare(p, p + n, q, q + m))
+				return false;
+		}
+	}
+	return true;
+}
+
+// 16 字节的平凡可复制类型，走 16 字节模式填充
+struct quad {
+	uint64_t lo, hi;
+	bool     operator==(const quad &x) const { return lo == x.lo && hi == x.hi; }
+};
+
+/**
+ * @brief 在当前指令集下检查 fill、fill_n：起点在向量内错开若干元素，长度覆盖 SIMD 阈值附近与不整除向量宽度的尾部，
+ * 	填充区间前后的哨兵元素不能被改写
+ */
+template <typename T>
+bool check_fill(const T &value, const T &guard) {
+	const size_t vec = 64 / sizeof(T);    // 最宽向量容纳的元素数
+	for (size_t n : {size_t(0), size_t(1), vec - 1, vec, vec + 1,
+	                 size_t(leestl::simd::FILL_MIN_BYTES) / sizeof(T) - 1,
+	                 size_t(leestl::simd::FILL_MIN_BYTES) / sizeof(T) + 3, 4096 / sizeof(T) + 5}) {
+		for (size_t off = 0; off < vec; off += 3) {
+			leestl::vector<T> a(n + vec + 2, guard);
+			T                *first = a.data() + 1 + off;
+			if (off % 2) leestl::fill(first, first + n, value);
+			else if (leestl::fill_n(first, n, value) != first + n) return false;
+			for (size_t i = 0; i < a.size(); ++i) {
+				const bool inside = a.data() + i >= first && a.data() + i < first + n;
+				if (!(a[i] == (inside ? value : guard))) return false;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief 在当前指令集下对照 std::copy 检查 copy、move、copy_backward：
+ * 	非对齐的不重叠复制（超过非临时存储阈值）、向前与向后重叠的复制，以及从 const T* 复制
+ */
+bool check_copy() {
+	for (size_t n : {0, 1, 2, 63, 64, 65, 255, 256, 257, 1000, 4099, 70001}) {
+		for (size_t src_off : {0, 1, 5}) {
+			for (size_t dst_off : {0, 3}) {
+				leestl::vector<int> src(n + src_off), a(n + dst_off + 1, -1), b(n + dst_off + 1, -1);
+				for (size_t i = 0; i < src.size(); ++i) src[i] = int(g_rng());
+				const int *first = src.data() + src_off;
+				std::copy(first, first + n, b.data() + dst_off);
+				if (leestl::copy(first, first + n, a.data() + dst_off) != a.data() + dst_off + n ||
+				    !same(a, b))
+					return false;
+				leestl::fill(a.data(), a.data() + a.size(), -1);
+				leestl::move(src.data() + src_off, src.data() + src_off + n, a.data() + dst_off);
+				if (!same(a, b)) return false;
+
+				// 原始空间与目标空间重叠，分别向前、向后平移 dst_off + 1 个元素
+				const size_t        shift = dst_off + 1;
+				leestl::vector<int> c(n + shift), d(n + shift);
+				for (size_t i = 0; i < c.size(); ++i) c[i] = d[i] = int(g_rng());
+				leestl::copy(c.data() + shift, c.data() + shift + n, c.data());
+				std::copy(d.data() + shift, d.data() + shift + n, d.data());
+				if (!same(c, d)) return false;
+				leestl::copy_backward(c.data(), c.data() + n, c.data() + shift + n);
+				std::copy_backward(d.data(), d.data() + n, d.data() + shift + n);
+				if (!same(c, d)) return false;
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief 对照并行与顺序的 copy、move、fill、fill_n、copy_backward，
+ * 	覆盖分段阈值附近与不能整除的长度、非对齐的起点，以及原始空间与目标空间重叠的 copy_backward
+ *
+ * @param make 由下标生成元素
+ */
+template <typename T, typename Make>
+bool check_parallel_algobase(Make make) {
+	namespace ex = leestl::execution;
+	const size_t step = size_t(leestl::_PAR_MIN_BYTES) / sizeof(T) + 1;    // 多于一段所需的元素数
+	for (size_t n : {size_t(0), size_t(1), 2 * step - 1, 2 * step, 2 * step + 1, 5 * step + 3}) {
+		for (size_t off : {0, 1}) {
+			leestl::vector<T> src(n + off), a(n + off + 3), b(n + off + 3);
+			for (size_t i = 0; i < src.size(); ++i) src[i] = make(i);
+			const T *first = src.data() + off, *last = first + n;
+			auto     same_ab = [&] { return std::equal(a.data(), a.data() + a.size(), b.data()); };
+
+			if (leestl::copy(ex::par, first, last, a.data() + off) != a.data() + off + n) return false;
+			leestl::copy(first, last, b.data() + off);
+			if (!same_ab()) return false;
+
+			leestl::vector<T> ma = src, mb = src;
+			leestl::move(ex::par, ma.data() + off, ma.data() + off + n, a.data() + 1);
+			leestl::move(mb.data() + off, mb.data() + off + n, b.data() + 1);
+			if (!same_ab()) return false;
+
+			leestl::fill(ex::par, a.data() + off, a.data() + off + n, make(7));
+			leestl::fill(b.data() + off, b.data() + off + n, make(7));
+			if (!same_ab()) return false;
+			if (leestl::fill_n(ex::par, a.data() + 1, n, make(9)) != a.data() + 1 + n) return false;
+			leestl::fill_n(b.data() + 1, n, make(9));
+			if (!same_ab()) return false;
+
+			T *end = a.data() + off + n + 3;
+			if (leestl::copy_backward(ex::par, first, last, end) != end - n) return false;
+			leestl::copy_backward(first, last, b.data() + off + n + 3);
+			if (!same_ab()) return false;
+
+			// 目标空间与原始空间重叠，向后平移 3 个元素
+			leestl::copy(first, last, a.data());
+			leestl::copy(first, last, b.data());
+			leestl::copy_backward(ex::par, a.data(), a.data() + n, a.data() + n + 3);
+			leestl::copy_backward(b.data(), b.data() + n, b.data() + n + 3);
+			if (!same_ab()) return false;
+		}
+	}
+	return true;
+}
+
+int main() {
+	cout << "\n[===================================================================]\n";
+	cout << "[---------------------- algo test start ---------------------->\n";
+	cout << "[------------------- sort test start------------------->\n";
+	leestl::vector<int> v1 = {5, 3, 9, 1, 5, 8, 2, 7, 0, 6};
+	leestl::sort(v1.begin(), v1.end());
+	cout << "sort: " << v1;
+	leestl::sort(v1.begin(), v1.end(), std::greater<int>());
+	cout << "sort greater: " << v1;
+
+	leestl::vector<std::string> v2 = {"pear", "apple", "fig", "banana", "cherry"};
+	leestl::sort(v2.begin(), v2.end());
+	cout << "sort string: " << v2;
+
+	const char *patterns[] = {"random", "sorted", "reversed", "organ_pipe", "few_unique", "equal"};
+	for (const char *p : patterns) {
+		bool ok = true;
+		for (size_t n : {0, 1, 2, 23, 24, 100, 1000, 100000}) {
+			const leestl::vector<int> input = make_input(p, n);
+			leestl::vector<int>       a = input, b = input;
+			leestl::sort(a.data(), a.data() + n);
+			std::sort(b.data(), b.data() + n);
+			ok = ok && same(a, b);
+			a = input;
+			leestl::sort(a.data(), a.data() + n, [](int x, int y) { return x > y; });
+			std::sort(b.data(), b.data() + n, std::greater<int>());
+			ok = ok && same(a, b);
+		}
+		cout << "sort " << p << ": " << (ok ? "ok" : "FAILED") << endl;
+	}
+	cout << ">------------------- sort test end -------------------]\n";
+
+	cout << "[------------------- stable_sort test start------------------->\n";
+	leestl::vector<std::string> v3 = {"pear", "fig", "apple", "kiwi", "plum", "banana", "date"};
+	leestl::stable_sort(v3.begin(), v3.end(), [](const std::string &a, const std::string &b) {
+		return a.size() < b.size();
+	});
+	cout << "stable_sort by length: " << v3;
+	for (size_t n : {0, 1, 15, 16, 17, 1000, 100001}) {
+		leestl::vector<record> a(n);
+		for (size_t i = 0; i < n; ++i) a[i] = record{int(g_rng() % 64), int(i)};
+		leestl::stable_sort(a.begin(), a.end(), [](const record &x, const record &y) {
+			return x.key < y.key;
+		});
+		bool ok = true;
+		for (size_t i = 1; i < n; ++i) {
+			const record &x = a[i - 1], &y = a[i];
+			ok = ok && (x.key < y.key || (x.key == y.key && x.seq < y.seq));
+		}
+		cout << "stable_sort n = " << n << ": " << (ok ? "ok" : "FAILED") << endl;
+	}
+	cout << ">------------------- stable_sort test end -------------------]\n";
+
+	cout << "[------------------- partial_sort test start------------------->\n";
+	leestl::vector<int> v4 = {9, 4, 7, 1, 8, 2, 6, 3, 5, 0};
+	leestl::partial_sort(v4.begin(), v4.begin() + 4, v4.end());
+	cout << "partial_sort first 4: " << v4;
+	for (const char *p : patterns) {
+		leestl::vector<int> a = make_input(p, 10000), b = a;
+		leestl::partial_sort(a.data(), a.data() + 100, a.data() + a.size());
+		std::partial_sort(b.data(), b.data() + 100, b.data() + b.size());
+		cout << "partial_sort " << p << ": "
+		     << (std::equal(a.data(), a.data() + 100, b.data()) ? "ok" : "FAILED") << endl;
+	}
+	cout << ">------------------- partial_sort test end -------------------]\n";
+
+	cout << "[------------------- nth_element test start------------------->\n";
+	leestl::vector<int> v5 = {9, 4, 7, 1, 8, 2, 6, 3, 5, 0};
+	leestl::nth_element(v5.begin(), v5.begin() + 5, v5.end());
+	cout << "nth_element 5th: " << v5[5] << ", " << v5;
+	for (const char *p : patterns) {
+		bool ok = true;
+		for (size_t n : {1, 30, 1000, 100000}) {
+			leestl::vector<int> a = make_input(p, n), b = a;
+			std::sort(b.data(), b.data() + n);
+			for (size_t k : {size_t(0), n / 3, n / 2, n - 1}) {
+				leestl::nth_element(a.data(), a.data() + k, a.data() + n);
+				ok = ok && a[k] == b[k] &&
+				     std::all_of(a.data(), a.data() + k, [&](int x) { return x <= a[k]; }) &&
+				     std::all_of(a.data() + k, a.data() + n, [&](int x) { return x >= a[k]; });
+			}
+		}
+		cout << "nth_element " << p << ": " << (ok ? "ok" : "FAILED") << endl;
+	}
+	cout << ">------------------- nth_element test end -------------------]\n";
+	cout << "[------------------- binary search test start------------------->\n";
+	leestl::vector<int> v8 = {1, 3, 3, 3, 5, 8, 13};
+	cout << "lower_bound 3: " << leestl::lower_bound(v8.begin(), v8.end(), 3) - v8.begin()
+	     << ", upper_bound 3: " << leestl::upper_bound(v8.begin(), v8.end(), 3) - v8.begin()
+	     << ", binary_search 4: " << leestl::binary_search(v8.begin(), v8.end(), 4)
+	     << ", binary_search 13: " << leestl::binary_search(v8.begin(), v8.end(), 13) << endl;
+	for (const char *p : {"sorted", "few_unique"}) {
+		bool ok = true;
+		for (size_t n : {0, 1, 2, 7, 8, 1000}) {
+			leestl::vector<int> a = make_input(p, n);
+			std::sort(a.data(), a.data() + n);
+			const int *f = a.data(), *l = a.data() + n;
+			for (int x = -2; x < int(n) + 2; ++x) {
+				ok = ok && leestl::lower_bound(f, l, x) == std::lower_bound(f, l, x) &&
+				     leestl::upper_bound(f, l, x) == std::upper_bound(f, l, x) &&
+				     leestl::binary_search(f, l, x) == std::binary_search(f, l, x) &&
+				     leestl::lower_bound(f, l, x, std::less<int>()) == std::lower_bound(f, l, x);
+			}
+		}
+		cout << "lower_bound/upper_bound/binary_search " << p << ": " << (ok ? "ok" : "FAILED")
+		     << endl;
+	}
+	cout << ">------------------- binary search test end -------------------]\n";
+
+	cout << "[------------------- find / count / mismatch test start------------------->\n";
+	leestl::vector<int> v9 = {4, 8, 15, 16, 23, 42, 8};
+	cout << "find 16: " << leestl::find(v9.begin(), v9.end(), 16) - v9.begin()
+	     << ", find 7: " << leestl::find(v9.begin(), v9.end(), 7) - v9.begin()
+	     << ", count 8: " << leestl::count(v9.begin(), v9.end(), 8)
+	     << ", count_if even: "
+	     << leestl::count_if(v9.begin(), v9.end(), [](int x) { return x % 2 == 0; }) << endl;
+	const std::string s1 = "leestl simd", s2 = "leestl sort";
+	cout << "mismatch: " << *leestl::mismatch(s1.data(), s1.data() + s1.size(), s2.data()).first
+	     << ", equal: " << leestl::equal(s1.data(), s1.data() + s1.size(), s2.data())
+	     << ", lexicographical_compare: "
+	     << leestl::lexicographical_compare(
+	            s1.data(), s1.data() + s1.size(), s2.data(), s2.data() + s2.size())
+	     << endl;
+	for (int i = leestl::simd::ISA_SCALAR; i <= leestl::simd::detected_isa(); ++i) {
+		leestl::simd::set_isa(leestl::simd::isa(i));
+		const bool ok = check_search<unsigned char>() && check_search<char>() &&
+		                check_search<short>() && check_search<int>() &&
+		                check_search<unsigned>() && check_search<long long>();
+		cout << "find/count/mismatch/equal/lexicographical_compare "
+		     << leestl::simd::isa_name(leestl::simd::isa(i)) << ": " << (ok ? "ok" : "FAILED")
+		     << endl;
+	}
+	leestl::simd::set_isa(leestl::simd::detected_isa());
+	cout << ">------------------- find / count / mismatch test end -------------------]\n";
+
+	cout << "[------------------- SIMD fill / copy test start------------------->\n";
+	// 从 const T* 复制同样按字节复制
+	static_assert(leestl::_is_memmovable<const int *, int *>::value);
+	static_assert(!leestl::_is_memmovable<const int *, long *>::value);
+	// 非临时存储阈值调小，使较短的复制也经过非临时存储内核
+	const size_t nt_threshold = leestl::simd::nontemporal_threshold();
+	leestl::simd::set_nontemporal_threshold(256);
+	for (int i = leestl::simd::ISA_SCALAR; i <= leestl::simd::detected_isa(); ++i) {
+		leestl::simd::set_isa(leestl::simd::isa(i));
+		const bool ok = check_fill<uint16_t>(0xa55a, 0x1111) &&
+		                check_fill<uint32_t>(0xdeadbeef, 0x11111111u) &&
+		                check_fill<double>(-2.5, 1.0) &&
+		                check_fill<quad>(quad{0x0123456789abcdefull, 42}, quad{1, 1}) &&
+		                check_copy();
+		cout << "fill/fill_n/copy/move " << leestl::simd::isa_name(leestl::simd::isa(i)) << ": "
+		     << (ok ? "ok" : "FAILED") << endl;
+	}
+	leestl::simd::set_isa(leestl::simd::detected_isa());
+	leestl::simd::set_nontemporal_threshold(nt_threshold);
+	cout << ">------------------- SIMD fill / copy test end -------------------]\n";
+
+	cout << "[------------------- radix_sort test start------------------->\n";
+	leestl::vector<int> v6 = {170, -45, 75, -90, 802, 24, 2, 66, 0, -1};
+	leestl::radix_sort(v6.begin(), v6.end());
+	cout << "radix_sort int: " << v6;
+	leestl::vector<double> v7 = {3.5, -0.0, -2.25, 1e300, 0.0, -1e-300, 42.0, -7.0};
+	leestl::radix_sort(v7.begin(), v7.end());
+	cout << "radix_sort double: " << v7;
+	for (size_t n : {0, 1, 1023, 1024, 100000, 400000}) {
+		leestl::vector<uint32_t> u(n);
+		leestl::vector<int64_t>  s(n);
+		leestl::vector<float>    f(n);
+		for (size_t i = 0; i < n; ++i) {
+			u[i] = uint32_t(g_rng());
+			s[i] = int64_t(g_rng()) * (i % 2 ? -1 : 1) * 1000003;
+			f[i] = float(int(g_rng() % 2001) - 1000) / 8.0f;
+		}
+		leestl::vector<uint32_t> u2 = u;
+		leestl::vector<int64_t>  s2 = s;
+		leestl::vector<float>    f2 = f;
+		leestl::radix_sort(u.begin(), u.end());
+		leestl::radix_sort(s.begin(), s.end());
+		leestl::radix_sort(f.begin(), f.end());
+		std::sort(u2.data(), u2.data() + n);
+		std::sort(s2.data(), s2.data() + n);
+		std::sort(f2.data(), f2.data() + n);
+		const bool ok = std::equal(u.data(), u.data() + n, u2.data()) &&
+		                std::equal(s.data(), s.data() + n, s2.data()) &&
+		                std::equal(f.data(), f.data() + n, f2.data());
+		cout << "radix_sort n = " << n << ": " << (ok ? "ok" : "FAILED") << endl;
+	}
+	{
+		// 按字段排序，结果应当稳定
+		const size_t           n = 50000;
+		leestl::vector<record> a(n);
+		for (size_t i = 0; i < n; ++i) a[i] = record{int(g_rng() % 1000) - 500, int(i)};
+		leestl::radix_sort(a.begin(), a.end(), [](const record &r) { return r.key; });
+		bool ok = true;
+		for (size_t i = 1; i < n; ++i) {
+			const record &x = a[i - 1], &y = a[i];
+			ok = ok && (x.key < y.key || (x.key == y.key && x.seq < y.seq));
+		}
+		cout << "radix_sort by key: " << (ok ? "ok" : "FAILED") << endl;
+
+		leestl::vector<std::string> names = {"delta", "alpha", "echo", "bravo", "charlie"};
+		leestl::radix_sort(
+		    names.begin(), names.end(), [](const std::string &x) { return uint8_t(x[0]); });
+		cout << "radix_sort string by first char: " << names;
+	}
+	cout << ">------------------- radix_sort test end -------------------]\n";
+	cout << "[------------------- parallel sort test start------------------->\n";
+	leestl::execution::set_num_threads(4);
+	for (const char *p : patterns) {
+		const leestl::vector<int> input = make_input(p, 300000);
+		leestl::vector<int>       a = input, b = input;
+		leestl::sort(leestl::execution::par, a.begin(), a.end());
+		leestl::sort(b.begin(), b.end());
+		cout << "sort(par) " << p << ": " << (same(a, b) ? "ok" : "FAILED") << endl;
+	}
+	{
+		// 并行稳定排序的结果与顺序版本完全相同
+		const size_t           n = 300000;
+		leestl::vector<record> a(n);
+		for (size_t i = 0; i < n; ++i) a[i] = record{int(g_rng() % 100), int(i)};
+		leestl::vector<record> b = a;
+		auto by_key = [](const record &x, const record &y) { return x.key < y.key; };
+		leestl::stable_sort(leestl::execution::par, a.begin(), a.end(), by_key);
+		leestl::stable_sort(b.begin(), b.end(), by_key);
+		bool ok = true;
+		for (size_t i = 0; i < n; ++i) ok = ok && a[i].key == b[i].key && a[i].seq == b[i].seq;
+		cout << "stable_sort(par): " << (ok ? "ok" : "FAILED") << endl;
+	}
+	leestl::execution::set_num_threads(0);
+	cout << ">------------------- parallel sort test end -------------------]\n";
+
+	cout << "[------------------- parallel copy / move / fill test start------------------->\n";
+	leestl::execution::set_num_threads(4);
+	cout << "parallel algobase char: "
+	     << (check_parallel_algobase<char>([](size_t i) { return char(i * 7); }) ? "ok" : "FAILED")
+	     << endl;
+	cout << "parallel algobase int: "
+	     << (check_parallel_algobase<int>([](size_t i) { return int(i * 2654435761u); }) ? "ok"
+	                                                                                    : "FAILED")
+	     << endl;
+	cout << "parallel algobase std::string: "
+	     << (check_parallel_algobase<std::string>([](size_t i) { return std::to_string(i); })
+	             ? "ok"
+	             : "FAILED")
+	     << endl;
+	leestl::execution::set_num_threads(0);
+	cout << ">------------------- parallel copy / move / fill test end -------------------]\n";
+	cout << ">---------------------- algo test end ----------------------]\n";
+	return 0;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file alloc_stats.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::alloc_stats 测试程序
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 本文件自行定义 LEESTL_ALLOC_STATS，leestl::allocator 的分配、释放都会被记录
+ * 编译: g++ -std=c++17 -pthread -I.. alloc_stats.cpp -o alloc_stats
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#define LEESTL_ALLOC_STATS 1
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../LeeSTL/alloc.h"
+#include "../LeeSTL/alloc_stats.h"
+#include "../LeeSTL/vector.h"
+
+using std::cout;
+using std::endl;
+
+struct point {
+	double x, y;
+};
+
+// 按名称查找快照中的记录，找不到时返回名称为空的记录
+leestl::alloc_stats::entry find(const std::string &name) {
+	for (const auto &e : leestl::alloc_stats::snapshot())
+		if (e.name == name) return e;
+	return leestl::alloc_stats::entry();
+}
+
+bool check(const leestl::alloc_stats::entry &e, uint64_t alloc_calls, uint64_t dealloc_calls,
+           uint64_t alloc_bytes, uint64_t dealloc_bytes, int64_t live, int64_t peak) {
+	return e.alloc_calls == alloc_calls && e.dealloc_calls == dealloc_calls &&
+	       e.alloc_bytes == alloc_bytes && e.dealloc_bytes == dealloc_bytes &&
+	       e.live_bytes == live && e.peak_bytes == peak;
+}
+
+void print(const leestl::alloc_stats::entry &e) {
+	cout << e.name << ": calls " << e.alloc_calls << "/" << e.dealloc_calls << ", bytes "
+	     << e.alloc_bytes << "/" << e.dealloc_bytes << ", live " << e.live_bytes << ", peak "
+	     << e.peak_bytes << endl;
+}
+
+int main() {
+	cout << "\n[===================================================================]\n";
+	cout << "[------------------- alloc_stats test start ------------------->\n";
+	cout << "[------------------- allocator test start------------------->\n";
+	typedef leestl::allocator<int> int_alloc;
+	int *a = int_alloc::allocate(10);      // 40 字节
+	int *b = int_alloc::allocate(1500);    // 6000 字节
+	int_alloc::deallocate(a, 10);
+	int *c = int_alloc::allocate();
+	int_alloc::deallocate(c);
+	print(find("int"));
+	cout << "int: " << (check(find("int"), 3, 2, 6044, 44, 6000, 6040) ? "ok" : "FAIL") << endl;
+	int_alloc::deallocate(b, 1500);
+	cout << "int after free: " << (check(find("int"), 3, 3, 6044, 6044, 0, 6040) ? "ok" : "FAIL")
+	     << endl;
+	const auto int_entry = find("int");
+	cout << "histogram: [32, 64) " << int_entry.histogram[6] << ", [4, 8) "
+	     << int_entry.histogram[3] << ", [4096, 8192) " << int_entry.histogram[13] << endl;
+
+	{
+		leestl::vector<unsigned> v;
+		v.reserve(1500);
+		v.push_back(1);
+	}
+	const bool vector_ok = check(find("unsigned int"), 1, 1, 6000, 6000, 0, 6000);
+	cout << "vector<unsigned>: " << (vector_ok ? "ok" : "FAIL") << endl;
+
+	// 存活字节数的净变化超过分片合并阈值，峰值仍然精确
+	typedef leestl::allocator<double> double_alloc;
+	std::vector<double *>             blocks;
+	for (int i = 0; i < 5; ++i) blocks.push_back(double_alloc::allocate(500));    // 4000 字节
+	for (int i = 0; i < 3; ++i) double_alloc::deallocate(blocks[i], 500);
+	for (int i = 0; i < 5; ++i) blocks.push_back(double_alloc::allocate(500));
+	const bool double_ok = check(find("double"), 10, 3, 40000, 12000, 28000, 28000);
+	for (size_t i = 3; i < blocks.size(); ++i) double_alloc::deallocate(blocks[i], 500);
+	cout << "double across flushes: "
+	     << (double_ok && check(find("double"), 10, 10, 40000, 40000, 0, 28000) ? "ok" : "FAIL")
+	     << endl;
+
+	typedef leestl::instrumented_allocator<point, leestl::pool_allocator<point>> point_alloc;
+	point_alloc pa;
+	point      *p = pa.allocate(4);
+	point      *q = pa.allocate(2);
+	pa.deallocate(p, 4);
+	cout << "instrumented point: " << (check(find("point"), 2, 1, 96, 64, 32, 96) ? "ok" : "FAIL")
+	     << endl;
+	pa.deallocate(q, 2);
+	cout << ">------------------- allocator test end -------------------]\n";
+
+	cout << "[------------------- multi-thread test start------------------->\n";
+	// 每个线程同时至多持有一个 long，存活字节数不超过线程数 * 8
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t)
+		threads.emplace_back([] {
+			for (int i = 0; i < 10000; ++i)
+				leestl::allocator<long>::deallocate(leestl::allocator<long>::allocate(1), 1);
+		});
+	for (auto &t : threads) t.join();
+	const auto longs = find("long");
+	print(longs);
+	cout << "long: "
+	     << (longs.alloc_calls == 40000 && longs.dealloc_calls == 40000 && longs.live_bytes == 0 &&
+	                 longs.peak_bytes >= 8 && longs.peak_bytes <= 32
+	             ? "ok"
+	             : "FAIL")
+	     << endl;
+
+	// 一个线程分配、另一个线程释放，两个分片的净变化都会超过合并阈值，存活字节数仍然精确
+	std::vector<short *> shorts(20000);
+	std::thread          producer([&] {
+		for (auto &p : shorts) p = leestl::allocator<short>::allocate(4);
+	});
+	producer.join();
+	std::thread consumer([&] {
+		for (auto p : shorts) leestl::allocator<short>::deallocate(p, 4);
+	});
+	consumer.join();
+	const auto    shorts_entry = find("short");
+	const int64_t slack = leestl::alloc_stats::_NSHARDS * leestl::alloc_stats::_FLUSH_BYTES;
+	print(shorts_entry);
+	cout << "short: "
+	     << (shorts_entry.live_bytes == 0 && shorts_entry.peak_bytes >= 160000 &&
+	                 shorts_entry.peak_bytes <= 160000 + slack
+	             ? "ok"
+	             : "FAIL")
+	     << endl;
+	cout << ">------------------- multi-thread test end -------------------]\n";
+
+	cout << "[------------------- snapshot test start------------------->\n";
+	const auto entries = leestl::alloc_stats::snapshot();
+	uint64_t   calls = 0, bytes = 0;
+	for (size_t i = 1; i < entries.size(); ++i) {
+		calls += entries[i].alloc_calls;
+		bytes += entries[i].alloc_bytes;
+	}
+	cout << "first entry " << entries[0].name << ", global sums types: "
+	     << (calls == entries[0].alloc_calls && bytes == entries[0].alloc_bytes &&
+	                 entries[0].live_bytes == 0
+	             ? "ok"
+	             : "FAIL")
+	     << endl;
+
+	const std::string json = leestl::alloc_stats::dump_json();
+	const char *expect = "{\"name\": \"int\", \"alloc_calls\": 3, \"dealloc_calls\": 3, "
+	                     "\"alloc_bytes\": 6044, \"dealloc_bytes\": 6044, \"live_bytes\": 0, "
+	                     "\"peak_bytes\": 6040, \"histogram\": [";
+	const std::string global = "{\"global\": {\"name\": \"<global>\", ";
+	cout << "dump_json starts with global: "
+	     << (json.compare(0, global.size(), global) == 0 ? "ok" : "FAIL") << endl;
+	cout << "dump_json int record: " << (json.find(expect) != std::string::npos ? "ok" : "FAIL")
+	     << endl;
+	cout << "dump_json balanced: "
+	     << (json.back() == '}' && json.find("\"types\": [") != std::string::npos ? "ok" : "FAIL")
+	     << endl;
+	cout << ">------------------- snapshot test end -------------------]\n";
+	cout << ">------------------- alloc_stats test end ------------------]\n";
+	return 0;
+}
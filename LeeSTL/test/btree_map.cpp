@@ -0,0 +1,181 @@
+/**
+ * @file btree_map.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::btree_map、leestl::btree_set 测试程序
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "../LeeSTL/btree_map.h"
+#include "../LeeSTL/btree_set.h"
+#include "test_util.h"
+
+using std::cout;
+using std::endl;
+
+// 随机插入、删除、查找，与 std::map 逐步比较
+template <typename Map, typename Gen>
+bool compare_with_std(Gen gen, int ops, int range) {
+	typedef typename Map::key_type    K;
+	typedef typename Map::mapped_type V;
+	Map             m;
+	std::map<K, V>  ref;
+	std::mt19937    rng(2026);
+	for (int op = 0; op < ops; ++op) {
+		const int r = rng() % 100;
+		const K   key = gen(rng() % range);
+		if (r < 45) {
+			if (m.insert_or_assign(key, V(gen(op))).second !=
+			    ref.insert_or_assign(key, V(gen(op))).second)
+				return false;
+		} else if (r < 80) {
+			if (m.erase(key) != ref.erase(key)) return false;
+		} else if (r < 90) {
+			// 按迭代器删除，检查返回的下一个位置
+			auto it = m.lower_bound(key);
+			auto jt = ref.lower_bound(key);
+			if ((it == m.end()) != (jt == ref.end())) return false;
+			if (it == m.end()) continue;
+			if (!(it->first == jt->first)) return false;
+			it = m.erase(it);
+			jt = ref.erase(jt);
+			if ((it == m.end()) != (jt == ref.end())) return false;
+			if (it != m.end() && !(it->first == jt->first)) return false;
+		} else {
+			auto it = m.upper_bound(key);
+			auto jt = ref.upper_bound(key);
+			if ((it == m.end()) != (jt == ref.end())) return false;
+			if (it != m.end() && !(it->first == jt->first)) return false;
+		}
+		if (op % 1000 == 0) {
+			if (m.size() != ref.size()) return false;
+			auto jt = ref.begin();
+			for (auto &p : m) {
+				if (!(p.first == jt->first && p.second == jt->second)) return false;
+				++jt;
+			}
+			auto rj = ref.rbegin();
+			for (auto it = m.rbegin(); it != m.rend(); ++it, ++rj)
+				if (!(it->first == rj->first)) return false;
+		}
+	}
+	// 按随机顺序删除全部元素
+	while (!ref.empty()) {
+		auto jt = ref.begin();
+		std::advance(jt, rng() % ref.size());
+		if (m.erase(jt->first) != 1) return false;
+		ref.erase(jt);
+	}
+	return m.empty() && m.begin() == m.end() && m.height() == 0;
+}
+
+int main() {
+	cout << "\n[===================================================================]\n";
+	cout << "[------------------------ btree_map test start ------------------------>\n";
+	cout << "[------------------- API test start------------------->\n";
+	leestl::btree_map<std::string, int> m1 = {{"one", 1}, {"two", 2}, {"three", 3}};
+	print("m1", m1);
+	m1["four"] = 4;
+	m1.insert({"one", 100});    // 键已存在，不插入
+	m1.insert_or_assign("two", 22);
+	m1.try_emplace("five", 5);
+	m1.emplace("six", 6);
+	print("m1 after insert", m1);
+	cout << "erase three: " << m1.erase("three") << ", erase seven: " << m1.erase("seven")
+	     << endl;
+	cout << "at four: " << m1.at("four") << ", count two: " << m1.count("two")
+	     << ", contains three: " << m1.contains("three") << endl;
+	try {
+		m1.at("seven");
+	} catch (const std::out_of_range &e) {
+		cout << "at seven: out_of_range" << endl;
+	}
+	cout << "lower_bound \"p\": " << m1.lower_bound("p")->first
+	     << ", upper_bound \"six\": " << m1.upper_bound("six")->first << endl;
+	cout << "reverse: ";
+	for (auto it = m1.rbegin(); it != m1.rend(); ++it) cout << it->first << " ";
+	cout << endl;
+
+	// 透明比较仿函数支持以 string_view 查找
+	leestl::btree_set<std::string, std::less<>> s1 = {"pear", "apple", "fig", "apple"};
+	print("s1", s1);
+	cout << "find fig: " << (s1.find(std::string_view("fig")) != s1.end()) << endl;
+
+	leestl::btree_map<std::string, int> m2(m1);
+	cout << "m2 == m1: " << (m2 == m1) << ", ";
+	m2.erase(m2.begin());
+	cout << "after erase begin, m2 == m1: " << (m2 == m1) << ", m2 < m1: " << (m2 < m1) << endl;
+
+	// 配置器带状态且不随移动赋值传播，不相等时逐个移动元素
+	typedef leestl::btree_set<int, std::less<int>, tagged_allocator<int>> tagged_set;
+	tagged_set ts1(std::less<int>(), tagged_allocator<int>(1)),
+	    ts2(std::less<int>(), tagged_allocator<int>(2));
+	for (int i = 0; i < 1000; ++i) ts1.insert(i);
+	ts2.insert(-1);
+	ts2 = leestl::move(ts1);
+	cout << "tagged set move-assign: id " << ts2.get_allocator().id << ", size " << ts2.size()
+	     << ", first " << *ts2.begin() << ", last " << *ts2.rbegin()
+	     << ", source empty: " << ts1.empty() << endl;
+	// 复制赋值也不传播配置器，目标保留自己的配置器
+	tagged_set ts3(std::less<int>(), tagged_allocator<int>(3));
+	ts3 = ts2;
+	cout << "tagged set copy-assign: id " << ts3.get_allocator().id << ", size " << ts3.size()
+	     << (ts3.get_allocator().id == 3 && ts3 == ts2 ? " ok" : " FAILED") << endl;
+	typedef tagged_allocator<std::pair<const int, std::string>>                 pair_alloc;
+	typedef leestl::btree_map<int, std::string, std::less<int>, pair_alloc> tagged_map;
+	tagged_map tm1(std::less<int>(), tagged_allocator<int>(1)),
+	    tm2(std::less<int>(), tagged_allocator<int>(2));
+	for (int i = 0; i < 300; ++i) tm1.try_emplace(i, std::string(20, char('a' + i % 26)));
+	tm2 = leestl::move(tm1);
+	cout << "tagged map move-assign: id " << tm2.get_allocator().id << ", size " << tm2.size()
+	     << ", tm2[27] == bbb...: " << (tm2.at(27) == std::string(20, 'b')) << endl;
+	cout << ">------------------- API test end -------------------]\n";
+
+	cout << "[------------------- bulk test start------------------->\n";
+	// 按升序插入：追加到最后一个叶结点，结点几乎全满
+	leestl::btree_set<int> s2;
+	for (int i = 0; i < 100000; ++i) s2.insert(i);
+	cout << "ascending 100000: size " << s2.size() << ", height " << s2.height() << endl;
+	auto it = s2.erase(s2.lower_bound(1000), s2.lower_bound(99000));
+	cout << "erase [1000, 99000): size " << s2.size() << ", next " << *it
+	     << ", height " << s2.height() << endl;
+	bool ordered = true;
+	int  prev = -1;
+	for (int x : s2) ordered = ordered && x > prev, prev = x;
+	cout << "ordered: " << ordered << endl;
+	leestl::btree_set<int> s3;
+	for (int i = 100000; i > 0; --i) s3.insert(i);
+	for (int i = 1; i <= 100000; i += 2) s3.erase(i);
+	cout << "descending then erase odd: size " << s3.size() << ", first " << *s3.begin()
+	     << ", last " << *s3.rbegin() << endl;
+	cout << ">------------------- bulk test end -------------------]\n";
+
+	cout << "[------------------- compare with std::map start------------------->\n";
+	auto int_key = [](int k) { return k; };
+	auto str_key = [](int k) { return "key-" + std::to_string(k) + std::string(20, 'x'); };
+	cout << "int, key range 300: "
+	     << (compare_with_std<leestl::btree_map<int, int>>(int_key, 200000, 300) ? "ok" : "FAIL")
+	     << endl;
+	cout << "int, key range 50000: "
+	     << (compare_with_std<leestl::btree_map<int, int>>(int_key, 300000, 50000) ? "ok"
+	                                                                               : "FAIL")
+	     << endl;
+	cout << "string, key range 5000: "
+	     << (compare_with_std<leestl::btree_map<std::string, std::string>>(str_key, 100000, 5000)
+	             ? "ok"
+	             : "FAIL")
+	     << endl;
+	cout << ">------------------- compare with std::map end -------------------]\n";
+	cout << ">------------------------ btree_map test end ------------------------]\n";
+	return 0;
+}
@@ -0,0 +1,200 @@
+/**
+ * @file circular_buffer.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::circular_buffer 测试程序
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <deque>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../LeeSTL/circular_buffer.h"
+#include "test_util.h"
+
+using std::cout;
+using std::endl;
+
+// 在 same_indexed 的基础上，两段连续区间拼起来就是全部元素
+template <typename Buffer, typename Ref>
+bool same_arrays(const Buffer &b, const Ref &ref) {
+	if (!same_indexed(b, ref)) return false;
+	auto   one = b.array_one(), two = b.array_two();
+	size_t k = 0;
+	for (size_t j = 0; j < one.second; ++j)
+		if (!(one.first[j] == ref[k++])) return false;
+	for (size_t j = 0; j < two.second; ++j)
+		if (!(two.first[j] == ref[k++])) return false;
+	return k == ref.size();
+}
+
+// 随机单个/批量插入与取出，与按同样规则维护的 std::deque 逐步比较
+template <typename T, typename Gen>
+bool compare_with_std(Gen gen, int ops, leestl::circular_buffer_policy policy) {
+	const size_t               cap = 37;
+	leestl::circular_buffer<T> b(cap, policy);
+	std::deque<T>              ref;
+	const bool                 overwrite = policy == leestl::circular_buffer_policy::overwrite;
+	std::mt19937               rng(2026);
+	for (int op = 0; op < ops; ++op) {
+		const int r = rng() % 100;
+		const T   x = gen(op);
+		if (r < 30) {
+			const bool ok = b.push_back(x);
+			if (ok != (overwrite || ref.size() < cap)) return false;
+			if (ref.size() == cap && overwrite) ref.pop_front();
+			if (ok) ref.push_back(x);
+		} else if (r < 40) {
+			const bool ok = b.push_front(x);
+			if (ok != (overwrite || ref.size() < cap)) return false;
+			if (ref.size() == cap && overwrite) ref.pop_back();
+			if (ok) ref.push_front(x);
+		} else if (r < 55) {
+			std::vector<T> src;
+			for (size_t k = rng() % 60; k > 0; --k) src.push_back(gen(op * 100 + int(k)));
+			const size_t accepted = b.push_back(src.data(), src.data() + src.size());
+			size_t       expect = 0;
+			for (auto &v : src) {
+				if (ref.size() == cap) {
+					if (!overwrite) break;
+					ref.pop_front();
+				}
+				ref.push_back(v);
+				++expect;
+			}
+			if (accepted != expect) return false;
+		} else if (r < 70) {
+			if (!ref.empty()) b.pop_front(), ref.pop_front();
+		} else if (r < 75) {
+			if (!ref.empty()) b.pop_back(), ref.pop_back();
+		} else if (r < 88) {
+			const size_t   n = rng() % 40;
+			std::vector<T> out(n);
+			const size_t   got = b.pop_front(n, out.data()) - out.data();
+			if (got != std::min(n, ref.size())) return false;
+			for (size_t k = 0; k < got; ++k) {
+				if (!(out[k] == ref.front())) return false;
+				ref.pop_front();
+			}
+		} else if (r < 93) {
+			const size_t n = rng() % 20;
+			b.pop_front(n);
+			ref.erase(ref.begin(), ref.begin() + std::min(n, ref.size()));
+		} else if (r < 96) {
+			leestl::circular_buffer<T> c(b);
+			b = leestl::move(c);
+		} else if (r < 98) {
+			leestl::circular_buffer<T> c(cap, policy);
+			c = b;
+			b.swap(c);
+		} else {
+			b.clear();
+			ref.clear();
+		}
+		if (op % 20 == 0 && !same_arrays(b, ref)) return false;
+	}
+	return same_arrays(b, ref);
+}
+
+int main() {
+	typedef leestl::circular_buffer_policy policy;
+	cout << "\n[===================================================================]\n";
+	cout << "[------------------------ circular_buffer test start ------------------------>\n";
+	cout << "[------------------- API test start------------------->\n";
+	leestl::circular_buffer<int> b1, b2(5), b3(4, {1, 2, 3, 4, 5, 6});
+	print("b1", b1);
+	print("b2", b2);
+	print("b3 overwrite", b3);
+	cout << "capacity " << b1.capacity() << " " << b2.capacity() << " " << b3.capacity() << endl;
+	for (int i = 1; i <= 7; ++i) b2.push_back(i);
+	print("b2 after push_back 1..7", b2);
+	cout << "front " << b2.front() << ", back " << b2.back() << ", [1] " << b2[1] << ", at(4) "
+	     << b2.at(4) << endl;
+	try {
+		b2.at(5);
+	} catch (const std::out_of_range &e) {
+		cout << "at(5): out_of_range" << endl;
+	}
+	auto one = b2.array_one(), two = b2.array_two();
+	cout << "array_one size " << one.second << ", array_two size " << two.second << endl;
+	b2.push_front(0);
+	print("b2 after push_front 0", b2);
+	b2.pop_front();
+	b2.pop_back();
+	print("b2 after pop_front/pop_back", b2);
+	leestl::circular_buffer<int> r(3, policy::reject);
+	cout << "reject mode push_back: ";
+	for (int i = 0; i < 5; ++i) cout << r.push_back(i) << " ";
+	cout << endl;
+	print("r", r);
+	const int src[] = {10, 11, 12, 13, 14, 15};
+	r.pop_front(2);
+	cout << "reject bulk push_back accepted " << r.push_back(src, src + 6) << endl;
+	print("r", r);
+	r.set_policy(policy::overwrite);
+	cout << "overwrite bulk push_back accepted " << r.push_back(src, src + 6) << endl;
+	print("r", r);
+	int        out[8];
+	const int *end = r.pop_front(8, out);
+	cout << "pop_front(8, out) took " << (end - out) << ": ";
+	for (const int *p = out; p != end; ++p) cout << *p << " ";
+	cout << endl;
+	cout << "end - begin: " << (b2.end() - b2.begin()) << ", reverse: ";
+	for (auto it = b2.rbegin(); it != b2.rend(); ++it) cout << *it << " ";
+	cout << endl;
+	b2.push_back(9);
+	b2.push_back(1);
+	cout << "b2 wraps: array_two size " << b2.array_two().second << endl;
+	leestl::sort(b2.begin(), b2.end());
+	print("b2 sorted across wraparound", b2);
+	b1 = b2;
+	cout << "b1 == b2: " << (b1 == b2) << ", b3 < b2: " << (b3 < b2) << endl;
+	leestl::swap(b1, b3);
+	print("b1 after swap", b1);
+	cout << ">------------------- API test end -------------------]\n";
+
+	cout << "[------------------- no allocation test start------------------->\n";
+	// 构造之后的单个、批量插入与取出都不再分配
+	typedef leestl::circular_buffer<uint64_t, counting_allocator<uint64_t>> counted_buffer;
+	counted_buffer        w(1000);
+	const size_t          after_construction = allocations;
+	std::vector<uint64_t> chunk(333), out_chunk(333);
+	uint64_t              sum = 0;
+	for (int round = 0; round < 10000; ++round) {
+		for (auto &x : chunk) x = round;
+		w.push_back(chunk.data(), chunk.data() + chunk.size());
+		w.push_back(round);
+		if (round % 3 == 0) w.pop_front(100, out_chunk.data()), sum += out_chunk[0];
+		w.emplace_front(round);
+	}
+	const size_t   in_loop = allocations - after_construction;
+	counted_buffer w2(1000);
+	const size_t   before_assign = allocations;
+	w2 = w;
+	cout << "allocations at construction: " << after_construction
+	     << ", after construction: " << in_loop
+	     << ", copy-assign same capacity: " << allocations - before_assign << endl;
+	cout << ">------------------- no allocation test end -------------------]\n";
+
+	cout << "[------------------- compare with std::deque start------------------->\n";
+	auto int_gen = [](int k) { return k; };
+	auto str_gen = [](int k) { return "value-" + std::to_string(k) + std::string(20, 'x'); };
+	auto verdict = [](bool ok) { return ok ? "ok" : "FAIL"; };
+	cout << "int overwrite: " << verdict(compare_with_std<int>(int_gen, 20000, policy::overwrite))
+	     << endl;
+	cout << "int reject: " << verdict(compare_with_std<int>(int_gen, 20000, policy::reject))
+	     << endl;
+	cout << "string overwrite: "
+	     << verdict(compare_with_std<std::string>(str_gen, 5000, policy::overwrite)) << endl;
+	cout << "string reject: "
+	     << verdict(compare_with_std<std::string>(str_gen, 5000, policy::reject)) << endl;
+	cout << ">------------------- compare with std::deque end -------------------]\n";
+	cout << ">------------------------ circular_buffer test end ------------------------]\n";
+	return 0;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file concurrent_hash_map.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::concurrent_hash_map 测试程序
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 编译: g++ -std=c++17 -pthread -I.. concurrent_hash_map.cpp -o concurrent_hash_map
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "../LeeSTL/concurrent_hash_map.h"
+
+using std::cout;
+using std::endl;
+
+int main() {
+	cout << "\n[===================================================================]\n";
+	cout << "[------------------- concurrent_hash_map test start ------------------->\n";
+	cout << "[------------------- API test start------------------->\n";
+	leestl::concurrent_hash_map<std::string, int> m1(4);
+	cout << "shard_count: " << m1.shard_count() << endl;
+	cout << "insert_or_assign one: " << m1.insert_or_assign("one", 1)
+	     << ", two: " << m1.insert_or_assign("two", 2)
+	     << ", one again: " << m1.insert_or_assign("one", 11) << endl;
+	cout << "try_emplace three: " << m1.try_emplace("three", 3)
+	     << ", two again: " << m1.try_emplace("two", 22) << endl;
+	int v = 0;
+	cout << "find one: " << m1.find("one", v) << " -> " << v;
+	cout << ", find four: " << m1.find("four", v) << endl;
+	m1.visit("two", [](std::pair<const std::string, int> &p) { p.second *= 10; });
+	m1.cvisit("two", [](const std::pair<const std::string, int> &p) {
+		cout << "cvisit two: " << p.second << endl;
+	});
+
+	// 以 string_view 查找与删除，不构造临时 std::string
+	std::string_view key = "three";
+	cout << "contains three: " << m1.contains(key) << ", erase three: " << m1.erase(key)
+	     << ", erase three again: " << m1.erase(key) << endl;
+	std::vector<std::pair<std::string, int>> all;
+	m1.cvisit_all([&](const std::pair<const std::string, int> &p) { all.push_back(p); });
+	std::sort(all.begin(), all.end());
+	cout << "m1: ";
+	for (auto &p : all) cout << p.first << "=" << p.second << " ";
+	cout << "(size " << m1.size() << ")" << endl;
+	m1.clear();
+	cout << "after clear, size: " << m1.size() << ", empty: " << m1.empty() << endl;
+	cout << ">------------------- API test end -------------------]\n";
+
+	cout << "[------------------- multithread test start------------------->\n";
+	const int kThreads = 4, kPerThread = 20000, kShared = 64, kIncrements = 5000;
+	leestl::concurrent_hash_map<int, int> m2;
+	m2.reserve(kThreads * kPerThread / 2);
+	for (int k = 0; k < kShared; ++k) m2.insert_or_assign(-1 - k, 0);
+
+	// 每个线程插入自己的键并立即读回，同时对共享的键做自增，读线程不断查找
+	std::atomic<bool>        stop(false);
+	std::atomic<int>         errors(0);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < kThreads; ++t) {
+		threads.emplace_back([&, t] {
+			for (int i = 0; i < kPerThread; ++i) {
+				const int key = t * kPerThread + i;
+				m2.insert_or_assign(key, key * 2);
+				int value = -1;
+				if (!m2.find(key, value) || value != key * 2) ++errors;
+				if (i < kIncrements) m2.visit(-1 - i % kShared, [](auto &p) { ++p.second; });
+			}
+			// 删除奇数键
+			for (int i = 1; i < kPerThread; i += 2) m2.erase(t * kPerThread + i);
+		});
+	}
+	std::thread reader([&] {
+		while (!stop.load()) {
+			for (int key = 0; key < kThreads * kPerThread; key += 97) {
+				int value = -1;
+				if (m2.find(key, value) && value != key * 2) ++errors;
+			}
+		}
+	});
+	for (auto &th : threads) th.join();
+	stop = true;
+	reader.join();
+
+	long long sum = 0;
+	bool      ok = errors == 0;
+	for (int k = 0; k < kShared; ++k) {
+		int value = 0;
+		ok = ok && m2.find(-1 - k, value);
+		sum += value;
+	}
+	for (int key = 0; key < kThreads * kPerThread; ++key)
+		ok = ok && m2.contains(key) == (key % 2 == 0);
+	cout << "size: " << m2.size() << " (expect " << kThreads * kPerThread / 2 + kShared << ")"
+	     << endl;
+	cout << "sum of shared counters: " << sum << " (expect " << kThreads * kIncrements << ")"
+	     << endl;
+	cout << "multithread check: " << (ok ? "pass" : "FAIL") << endl;
+	cout << ">------------------- multithread test end -------------------]\n";
+	cout << ">------------------- concurrent_hash_map test end -------------------]\n";
+	return ok ? 0 : 1;
+}
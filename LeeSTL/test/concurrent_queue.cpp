@@ -0,0 +1,192 @@
+/**
+ * @file concurrent_queue.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::spsc_queue 与 leestl::mpmc_queue 测试程序
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 编译: g++ -std=c++17 -pthread -I.. concurrent_queue.cpp -o concurrent_queue
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../LeeSTL/concurrent_queue.h"
+#include "test_util.h"
+
+using std::cout;
+using std::endl;
+
+// 一个生产者依次写入 0..n-1（单个与批量交替），消费者检查顺序
+bool spsc_in_order(size_t n) {
+	leestl::spsc_queue<uint64_t> q(1000);
+
+	std::thread producer([&] {
+		std::vector<uint64_t> batch(37);
+		for (uint64_t i = 0; i < n;) {
+			if (i % 3 == 0) {
+				q.push(i++);
+				continue;
+			}
+			size_t len = 0;
+			for (; len < batch.size() && i + len < n; ++len) batch[len] = i + len;
+			size_t done = 0;
+			while (done < len) done += q.try_push_n(batch.data() + done, len - done);
+			i += len;
+		}
+	});
+	bool                  ok = true;
+	uint64_t              expect = 0;
+	std::vector<uint64_t> out(50);
+	while (expect < n) {
+		if (expect % 2 == 0) {
+			uint64_t x;
+			q.pop(x);
+			ok = ok && x == expect++;
+		} else {
+			const size_t got = q.try_pop_n(out.data(), out.size());
+			for (size_t i = 0; i < got; ++i) ok = ok && out[i] == expect++;
+			if (got == 0) std::this_thread::yield();
+		}
+	}
+	producer.join();
+	return ok && q.empty();
+}
+
+// 多个生产者与消费者：每个值编码 (生产者, 序号)，检查全部到达且每个消费者看到的
+// 同一生产者的序号递增
+bool mpmc_all_delivered(size_t producers, size_t consumers, size_t per_producer) {
+	leestl::mpmc_queue<uint64_t>       q(256);
+	std::atomic<size_t>                received{0};
+	std::vector<std::vector<uint64_t>> seen(consumers);
+	std::vector<std::thread>           pool;
+	for (size_t p = 0; p < producers; ++p) {
+		pool.emplace_back([&, p] {
+			std::vector<uint64_t> batch(16);
+			for (uint64_t i = 0; i < per_producer;) {
+				if (p % 2 == 0) {
+					q.push(p << 32 | i++);
+					continue;
+				}
+				size_t len = 0;
+				for (; len < batch.size() && i + len < per_producer; ++len)
+					batch[len] = p << 32 | (i + len);
+				size_t done = 0;
+				while (done < len) {
+					const size_t k = q.try_push_n(batch.data() + done, len - done);
+					if (k == 0) std::this_thread::yield();
+					done += k;
+				}
+				i += len;
+			}
+		});
+	}
+	const size_t      total = producers * per_producer;
+	std::atomic<bool> ordered{true};
+	for (size_t c = 0; c < consumers; ++c) {
+		pool.emplace_back([&, c] {
+			std::vector<uint64_t> last(producers, 0), out(16);
+			std::vector<bool>     any(producers, false);
+			bool                  ok = true;
+
+			auto take = [&](uint64_t x) {
+				const size_t   p = size_t(x >> 32);
+				const uint64_t i = x & 0xffffffffu;
+				if (any[p] && i <= last[p]) ok = false;
+				any[p] = true;
+				last[p] = i;
+				seen[c].push_back(x);
+			};
+			while (received.load() < total) {
+				size_t got = 0;
+				if (c % 2 == 0) {
+					uint64_t x;
+					if (q.try_pop(x)) take(x), got = 1;
+				} else {
+					got = q.try_pop_n(out.data(), out.size());
+					for (size_t i = 0; i < got; ++i) take(out[i]);
+				}
+				if (got == 0) std::this_thread::yield();
+				received += got;
+			}
+			if (!ok) ordered = false;
+		});
+	}
+	for (auto &t : pool) t.join();
+	std::vector<size_t> count(producers, 0);
+	size_t              n = 0;
+	for (auto &v : seen)
+		for (uint64_t x : v) ++count[x >> 32], ++n;
+	for (size_t p = 0; p < producers; ++p)
+		if (count[p] != per_producer) return false;
+	return ordered && n == total && q.empty();
+}
+
+int main() {
+	cout << "\n[===================================================================]\n";
+	cout << "[------------------- concurrent_queue test start ------------------->\n";
+	cout << "[------------------- API test start------------------->\n";
+	leestl::spsc_queue<std::string> s(5);
+	cout << "spsc capacity(5): " << s.capacity() << endl;
+	for (int i = 0; i < 10; ++i)
+		if (!s.try_push("s" + std::to_string(i))) cout << "full at " << i << ", ";
+	std::string x;
+	s.try_pop(x);
+	cout << "pop " << x;
+	s.try_pop(x);
+	cout << " " << x << ", size " << s.size() << endl;
+	const std::string src[] = {"a", "b", "c", "d"};
+	cout << "try_push_n 4 (wraps): " << s.try_push_n(src, 4) << endl;
+	std::string out[8];
+	const size_t got = s.try_pop_n(out, 8);
+	cout << "try_pop_n 8: " << got << " ->";
+	for (size_t i = 0; i < got; ++i) cout << " " << out[i];
+	cout << ", empty " << s.empty() << ", try_pop " << s.try_pop(x) << endl;
+	s.try_push("left in queue");
+
+	leestl::mpmc_queue<std::string> m(3);
+	cout << "mpmc capacity(3): " << m.capacity() << endl;
+	cout << "try_push:";
+	for (int i = 0; i < 5; ++i) cout << " " << m.try_push("m" + std::to_string(i));
+	cout << endl;
+	m.try_pop(x);
+	cout << "pop " << x << ", try_push_n 4: " << m.try_push_n(src, 4);
+	const size_t mgot = m.try_pop_n(out, 8);
+	cout << ", try_pop_n 8: " << mgot << " ->";
+	for (size_t i = 0; i < mgot; ++i) cout << " " << out[i];
+	cout << endl;
+	m.try_emplace(3, 'z');
+
+	// 复制抛出异常时不占有槽位，队列保持可用
+	leestl::mpmc_queue<movable_fragile> f(4);
+	movable_fragile items[3] = {movable_fragile(1), movable_fragile(2), movable_fragile(3)};
+	movable_fragile::copies_left = 1;
+	size_t pushed = 0;
+	try {
+		pushed = f.try_push_n(items, 3);
+	} catch (const std::runtime_error &) {
+		cout << "fragile copy threw, ";
+	}
+	movable_fragile::copies_left = 100;
+	movable_fragile first;
+	cout << "size " << f.size() << ", pushed " << pushed << ", try_push " << f.try_push(items[2])
+	     << ", pop " << f.try_pop(first) << " -> " << first.value << ", size " << f.size() << endl;
+	cout << ">------------------- API test end -------------------]\n";
+
+	cout << "[------------------- multi-thread test start------------------->\n";
+	cout << "spsc 1000000 in order: " << (spsc_in_order(1000000) ? "ok" : "FAIL") << endl;
+	cout << "mpmc 1p1c: " << (mpmc_all_delivered(1, 1, 200000) ? "ok" : "FAIL") << endl;
+	cout << "mpmc 4p4c: " << (mpmc_all_delivered(4, 4, 100000) ? "ok" : "FAIL") << endl;
+	cout << "mpmc 2p6c: " << (mpmc_all_delivered(2, 6, 100000) ? "ok" : "FAIL") << endl;
+	cout << ">------------------- multi-thread test end -------------------]\n";
+	cout << ">------------------- concurrent_queue test end ------------------]\n";
+	return 0;
+}
@@ -0,0 +1,211 @@
+/**
+ * @file concurrent_vector.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::concurrent_vector 测试程序
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 编译: g++ -std=c++17 -pthread -I.. concurrent_vector.cpp -o concurrent_vector
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../LeeSTL/concurrent_vector.h"
+#include "test_util.h"
+
+using std::cout;
+using std::endl;
+
+// 跨越多个段的下标、迭代器正反向移动与随机跳转都与 std::vector 一致
+bool matches_vector(size_t n) {
+	leestl::concurrent_vector<uint32_t> v;
+	std::vector<uint32_t>               expect;
+	for (uint32_t i = 0; i < n; ++i) {
+		v.push_back(i * 7);
+		expect.push_back(i * 7);
+	}
+	for (size_t i = 0; i < n; ++i)
+		if (v[i] != expect[i]) return false;
+	size_t i = 0;
+	for (auto it = v.begin(); it != v.end(); ++it, ++i)
+		if (*it != expect[i]) return false;
+	for (auto it = v.end(); it != v.begin();)
+		if (*--it != expect[--i]) return false;
+	for (size_t step = 1; step < n; step = step * 3 + 1)
+		for (size_t j = 0; j + step < n; j += step)
+			if ((v.begin() + j)[step] != expect[j + step]) return false;
+	return i == 0 && size_t(v.end() - v.begin()) == n;
+}
+
+// 多个线程同时 push_back 与 grow_by：每个值编码 (线程, 序号)，检查全部到达、
+// 返回的地址之后不再改变、一次 grow_by 得到的下标连续
+bool concurrent_append(size_t threads, size_t per_thread) {
+	leestl::concurrent_vector<uint64_t>    v;
+	std::vector<std::vector<const void *>> addrs(threads);
+	std::vector<std::vector<uint64_t>>     values(threads);
+	std::vector<std::vector<size_t>>       batches(threads);    // 每次 grow_by 的第一个下标
+	std::vector<std::thread>               pool;
+	for (size_t t = 0; t < threads; ++t) {
+		pool.emplace_back([&, t] {
+			for (uint64_t i = 0; i < per_thread;) {
+				if (t % 2 == 0 || i % 5 == 0) {
+					auto it = v.push_back(t << 32 | i);
+					addrs[t].push_back(&*it);
+					values[t].push_back(t << 32 | i);
+					++i;
+					continue;
+				}
+				const uint64_t len = per_thread - i < 13 ? per_thread - i : 13;
+				auto           it = v.grow_by(len);
+				batches[t].push_back(size_t(it - v.begin()));
+				for (uint64_t j = 0; j < len; ++j, ++it) {
+					*it = t << 32 | (i + j);
+					addrs[t].push_back(&*it);
+					values[t].push_back(t << 32 | (i + j));
+				}
+				i += len;
+			}
+		});
+	}
+	for (auto &t : pool) t.join();
+	if (v.size() != threads * per_thread) return false;
+
+	std::vector<size_t> count(threads, 0);
+	for (size_t i = 0; i < v.size(); ++i) ++count[v[i] >> 32];
+	for (size_t t = 0; t < threads; ++t) {
+		if (count[t] != per_thread) return false;
+		for (size_t i = 0; i < per_thread; ++i)
+			if (*static_cast<const uint64_t *>(addrs[t][i]) != values[t][i]) return false;
+		for (size_t start : batches[t])
+			for (size_t j = 1; j < 13 && start + j < v.size() && v[start + j] >> 32 == t; ++j)
+				if (v[start + j] != v[start] + j) return false;
+	}
+	return true;
+}
+
+// 多个线程同时 grow_to_at_least，结果等于最大的要求且只补足一次
+bool concurrent_grow_to(size_t threads) {
+	leestl::concurrent_vector<int> v;
+	std::vector<std::thread>       pool;
+	for (size_t t = 0; t < threads; ++t)
+		pool.emplace_back([&, t] {
+			for (size_t n = 1; n <= 5000; n += 1 + t) v.grow_to_at_least(n, 1);
+		});
+	for (auto &t : pool) t.join();
+	size_t sum = 0;
+	for (int x : v) sum += size_t(x);
+	return v.size() == 5000 && sum == 5000;
+}
+
+int main() {
+	cout << "\n[===================================================================]\n";
+	cout << "[------------------- concurrent_vector test start ------------------->\n";
+	cout << "[------------------- API test start------------------->\n";
+	leestl::concurrent_vector<std::string> s = {"a", "b", "c"};
+	print("s", s);
+	auto it = s.push_back("d");
+	cout << "push_back returns " << *it << " at index " << (it - s.begin()) << endl;
+	s.emplace_back(3, 'e');
+	auto grown = s.grow_by(2, std::string("f"));
+	*grown = "f0";
+	const std::string more[] = {"g", "h"};
+	s.grow_by(more, more + 2);
+	s.grow_by({"i"});
+	print("s", s);
+	cout << "front " << s.front() << ", back " << s.back() << ", at(4) " << s.at(4) << endl;
+	try {
+		s.at(100);
+	} catch (const std::out_of_range &e) {
+		cout << "at(100) throws: " << e.what() << endl;
+	}
+	cout << "reverse:";
+	for (auto r = s.rbegin(); r != s.rend(); ++r) cout << " " << *r;
+	cout << endl;
+
+	const std::string *addr = &s[2];
+	s.grow_by(1000);
+	cout << "after grow_by(1000): size " << s.size() << ", &s[2] unchanged " << (addr == &s[2])
+	     << ", capacity >= size " << (s.capacity() >= s.size()) << endl;
+	auto at_least = s.grow_to_at_least(10);
+	cout << "grow_to_at_least(10) on larger: index " << (at_least - s.begin()) << ", size "
+	     << s.size() << endl;
+
+	leestl::concurrent_vector<std::string> copy(s);
+	cout << "copy == s " << (copy == s) << ", copy < s " << (copy < s) << endl;
+	const std::string                     *copied = &copy[2];
+	leestl::concurrent_vector<std::string> moved(leestl::move(copy));
+	cout << "moved size " << moved.size() << ", source size " << copy.size()
+	     << ", address kept " << (&moved[2] == copied) << endl;
+	const std::string *kept = &moved[1];
+	copy = leestl::move(moved);
+	cout << "move assigned, address kept " << (&copy[1] == kept) << endl;
+	copy = {"x", "y"};
+	print("copy", copy);
+	s.swap(copy);
+	cout << "after swap: s.size " << s.size() << ", copy.size " << copy.size() << endl;
+
+	leestl::concurrent_vector<int> r;
+	r.reserve(100);
+	cout << "reserve(100): capacity " << r.capacity() << ", size " << r.size() << endl;
+	r.grow_by(10, 5);
+	r.clear();
+	r.shrink_to_fit();
+	cout << "clear + shrink_to_fit: capacity " << r.capacity() << ", empty " << r.empty() << endl;
+	leestl::concurrent_vector<int> ints(5, 2);
+	print("ints", ints);
+	cout << ">------------------- API test end -------------------]\n";
+
+	cout << "[------------------- exception test start------------------->\n";
+	{
+		leestl::concurrent_vector<fragile> f;
+		const fragile src[5] = {fragile(1), fragile(2), fragile(3), fragile(4), fragile(5)};
+		f.grow_by(src, src + 5);
+		fragile::copies_left = 2;
+		try {
+			f.grow_by(src, src + 5);
+		} catch (const std::runtime_error &) {
+			cout << "grow_by threw, ";
+		}
+		fragile::copies_left = 1000;
+		f.push_back(fragile(9));
+		cout << "size " << f.size() << " (3 holes), live " << fragile::live - 5 << ", last "
+		     << f.back().value << endl;
+		try {
+			leestl::concurrent_vector<fragile> bad(src, src + 5);
+			fragile::copies_left = 0;
+			leestl::concurrent_vector<fragile> fails(bad);
+		} catch (const std::runtime_error &) {
+			cout << "copy constructor threw, ";
+		}
+		fragile::copies_left = 1000;
+		cout << "live after failed copy " << fragile::live - 5 - 8 << endl;
+		f.clear();
+		cout << "after clear live " << fragile::live - 5 << endl;
+		f.push_back(fragile(3));
+	}
+	cout << "all destroyed: " << (fragile::live == 0 ? "ok" : "FAIL") << endl;
+	cout << ">------------------- exception test end -------------------]\n";
+
+	cout << "[------------------- segment test start------------------->\n";
+	cout << "indexing and iterators over 100000 elements: "
+	     << (matches_vector(100000) ? "ok" : "FAIL") << endl;
+	cout << ">------------------- segment test end -------------------]\n";
+
+	cout << "[------------------- multi-thread test start------------------->\n";
+	cout << "4 threads append 100000 each: " << (concurrent_append(4, 100000) ? "ok" : "FAIL")
+	     << endl;
+	cout << "8 threads append 20000 each: " << (concurrent_append(8, 20000) ? "ok" : "FAIL")
+	     << endl;
+	cout << "4 threads grow_to_at_least: " << (concurrent_grow_to(4) ? "ok" : "FAIL") << endl;
+	cout << ">------------------- multi-thread test end -------------------]\n";
+	cout << ">------------------- concurrent_vector test end ------------------]\n";
+	return 0;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file deque.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::deque 测试程序
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <deque>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../LeeSTL/deque.h"
+#include "../LeeSTL/memory_resource.h"
+#include "test_util.h"
+
+using std::cout;
+using std::endl;
+
+// 随机在两端与中间插入、删除，与 std::deque 逐步比较
+template <typename T, typename Gen>
+bool compare_with_std(Gen gen, int ops) {
+	leestl::deque<T> d;
+	std::deque<T>    ref;
+	std::mt19937     rng(2026);
+	for (int op = 0; op < ops; ++op) {
+		const int r = rng() % 100;
+		const T   x = gen(op);
+		if (r < 20) {
+			d.push_back(x);
+			ref.push_back(x);
+		} else if (r < 40) {
+			d.push_front(x);
+			ref.push_front(x);
+		} else if (r < 52) {
+			if (!ref.empty()) d.pop_back(), ref.pop_back();
+		} else if (r < 64) {
+			if (!ref.empty()) d.pop_front(), ref.pop_front();
+		} else if (r < 72) {
+			const size_t i = rng() % (ref.size() + 1);
+			d.insert(d.begin() + i, x);
+			ref.insert(ref.begin() + i, x);
+		} else if (r < 76) {
+			const size_t i = rng() % (ref.size() + 1), n = rng() % 1500;
+			d.insert(d.begin() + i, n, x);
+			ref.insert(ref.begin() + i, n, x);
+		} else if (r < 80) {
+			const size_t i = rng() % (ref.size() + 1), n = rng() % 1500;
+			std::vector<T> src;
+			for (size_t k = 0; k < n; ++k) src.push_back(gen(op + k));
+			d.insert(d.begin() + i, src.data(), src.data() + n);
+			ref.insert(ref.begin() + i, src.begin(), src.end());
+		} else if (r < 88) {
+			if (ref.empty()) continue;
+			const size_t i = rng() % ref.size();
+			auto         it = d.erase(d.begin() + i);
+			ref.erase(ref.begin() + i);
+			if (size_t(it - d.begin()) != i) return false;
+		} else if (r < 92) {
+			const size_t i = rng() % (ref.size() + 1), n = rng() % (ref.size() - i + 1);
+			d.erase(d.begin() + i, d.begin() + (i + n));
+			ref.erase(ref.begin() + i, ref.begin() + (i + n));
+		} else if (r < 95) {
+			const size_t n = rng() % 3000;
+			d.resize(n, x);
+			ref.resize(n, x);
+		} else if (r < 97) {
+			leestl::deque<T> c(d);
+			d = leestl::move(c);
+		} else if (r < 98) {
+			d.clear();
+			ref.clear();
+		} else {
+			d.shrink_to_fit();
+		}
+		if (op % 100 == 0 && !same_indexed(d, ref)) return false;
+	}
+	return same_indexed(d, ref);
+}
+
+int main() {
+	cout << "\n[===================================================================]\n";
+	cout << "[------------------------ deque test start ------------------------>\n";
+	cout << "[------------------- API test start------------------->\n";
+	leestl::deque<int> d1, d2(5), d3(4, 7), d4 = {1, 2, 3, 4, 5};
+	leestl::deque<int> d5(d4.begin() + 1, d4.end()), d6(d4);
+	print("d1", d1);
+	print("d2", d2);
+	print("d3", d3);
+	print("d4", d4);
+	print("d5", d5);
+	for (int i = 0; i < 3; ++i) d6.push_front(-i), d6.push_back(10 + i);
+	print("d6 after push_front/push_back", d6);
+	d6.pop_front();
+	d6.pop_back();
+	d6.emplace(d6.begin() + 2, 100);
+	d6.insert(d6.end() - 1, 2, 200);
+	print("d6 after pop/emplace/insert", d6);
+	d6.erase(d6.begin() + 1);
+	d6.erase(d6.begin() + 3, d6.begin() + 6);
+	print("d6 after erase", d6);
+	cout << "front " << d6.front() << ", back " << d6.back() << ", [2] " << d6[2] << ", at(3) "
+	     << d6.at(3) << endl;
+	try {
+		d6.at(100);
+	} catch (const std::out_of_range &e) {
+		cout << "at(100): out_of_range" << endl;
+	}
+	cout << "end - begin: " << (d6.end() - d6.begin()) << ", reverse: ";
+	for (auto it = d6.rbegin(); it != d6.rend(); ++it) cout << *it << " ";
+	cout << endl;
+	d1 = d4;
+	cout << "d1 == d4: " << (d1 == d4) << ", d5 < d4: " << (d5 < d4) << endl;
+	d1.resize(8, 9);
+	print("d1 resize(8, 9)", d1);
+	d1.assign({6, 5, 4});
+	print("d1 assign", d1);
+	leestl::swap(d1, d3);
+	print("d1 after swap", d1);
+	leestl::stack_buffer_resource<256>                   arena;
+	leestl::deque<int, leestl::arena_allocator<int>> ad(3, 6, arena);
+	const int more[] = {1, 2, 3};
+	ad.insert(ad.begin() + 1, input_iterator<int>(more), input_iterator<int>(more + 3));
+	print("ad", ad);
+	cout << "block size: int " << leestl::deque<int>::BLOCK_SIZE << ", std::string "
+	     << leestl::deque<std::string>::BLOCK_SIZE << endl;
+	cout << ">------------------- API test end -------------------]\n";
+
+	cout << "[------------------- block recycling test start------------------->\n";
+	// 先扩展到稳态的最大长度，之后的先进先出与两端交替操作都不应再分配
+	leestl::deque<int, counting_allocator<int>> q;
+	for (int round = 0; round < 2; ++round) {
+		for (int i = 0; i < 50000; ++i) q.push_back(i);
+		for (int i = 0; i < 50000; ++i) q.pop_front();
+	}
+	const size_t warm = allocations;
+	long long    sum = 0;
+	for (int i = 0; i < 1000000; ++i) {
+		q.push_back(i);
+		if (q.size() > 30000) sum += q.front(), q.pop_front();
+	}
+	while (!q.empty()) q.pop_back();
+	for (int i = 0; i < 40000; ++i) q.push_front(i);
+	q.clear();
+	cout << "warm-up allocations: " << warm
+	     << ", allocations in steady state: " << allocations - warm << endl;
+	cout << ">------------------- block recycling test end -------------------]\n";
+
+	cout << "[------------------- compare with std::deque start------------------->\n";
+	auto int_gen = [](int k) { return k; };
+	auto str_gen = [](int k) { return "value-" + std::to_string(k) + std::string(20, 'x'); };
+	cout << "int: " << (compare_with_std<int>(int_gen, 20000) ? "ok" : "FAIL") << endl;
+	cout << "string: " << (compare_with_std<std::string>(str_gen, 5000) ? "ok" : "FAIL") << endl;
+	cout << ">------------------- compare with std::deque end -------------------]\n";
+	cout << ">------------------------ deque test end ------------------------]\n";
+	return 0;
+}
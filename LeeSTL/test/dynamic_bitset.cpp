@@ -0,0 +1,157 @@
+/**
+ * @file dynamic_bitset.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::dynamic_bitset 与 leestl::bitset_rank_index 测试程序
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 编译: g++ -std=c++17 -I.. dynamic_bitset.cpp -o dynamic_bitset
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "../LeeSTL/dynamic_bitset.h"
+
+using std::cout;
+using std::endl;
+
+typedef leestl::dynamic_bitset<> bitset;
+
+// 按给定密度随机生成的位数组及对应的 std::vector<bool>
+static void random_bits(
+    size_t n, unsigned percent, unsigned seed, bitset &b, std::vector<bool> &v) {
+	std::mt19937 rng(seed);
+	b = bitset(n);
+	v.assign(n, false);
+	for (size_t i = 0; i < n; ++i)
+		if (rng() % 100 < percent) b[i] = true, v[i] = true;
+}
+
+// 整体运算、计数与查找在各指令集等级下都与逐位计算的结果一致
+bool matches_reference(leestl::simd::isa level) {
+	leestl::simd::set_isa(level);
+	bool ok = true;
+	for (size_t n : {0, 1, 63, 64, 65, 200, 1000, 4099, 70000}) {
+		for (unsigned percent : {0, 1, 50, 100}) {
+			bitset            a, b;
+			std::vector<bool> va, vb;
+			random_bits(n, percent, unsigned(n + percent), a, va);
+			random_bits(n, 50, unsigned(n * 7 + 1), b, vb);
+
+			size_t count = 0;
+			for (bool x : va) count += x;
+			ok = ok && a.count() == count && a.any() == (count != 0) && a.all() == (count == n);
+
+			// 用 find_first/find_next 与 for_each_set 分别遍历
+			std::vector<size_t> by_find, by_visit, expect;
+			for (size_t i = 0; i < n; ++i)
+				if (va[i]) expect.push_back(i);
+			for (size_t i = a.find_first(); i != bitset::npos; i = a.find_next(i))
+				by_find.push_back(i);
+			a.for_each_set([&](size_t i) { by_visit.push_back(i); });
+			ok = ok && by_find == expect && by_visit == expect;
+
+			bitset and_ = a & b, or_ = a | b, xor_ = a ^ b, diff = a - b, inv = ~a;
+			for (size_t i = 0; i < n; ++i) {
+				ok = ok && and_[i] == (va[i] && vb[i]) && or_[i] == (va[i] || vb[i]);
+				ok = ok && xor_[i] == (va[i] != vb[i]) && diff[i] == (va[i] && !vb[i]);
+				ok = ok && inv[i] == !va[i];
+			}
+			ok = ok && inv.count() == n - count;
+
+			// rank/select 与逐位前缀和一致
+			leestl::bitset_rank_index<> index(a);
+			size_t                      ones = 0;
+			for (size_t i = 0; i <= n; ++i) {
+				ok = ok && index.rank(i) == ones;
+				if (i < n && va[i]) ok = ok && index.select(ones++) == i;
+			}
+			ok = ok && index.ones() == count && index.select(count) == bitset::npos;
+		}
+	}
+	leestl::simd::set_isa(leestl::simd::detected_isa());
+	return ok;
+}
+
+int main() {
+	cout << "\n[===================================================================]\n";
+	cout << "[------------------- dynamic_bitset test start ------------------->\n";
+	cout << "[------------------- API test start------------------->\n";
+	bitset b(10);
+	b.set(1).set(3).flip(9);
+	b[5] = true;
+	cout << "b: " << b.to_string() << ", count " << b.count() << ", size " << b.size() << endl;
+	bitset s("1100101");
+	cout << "from string 1100101: " << s.to_string() << ", bit 0 " << s[0] << ", bit 1 " << s[1]
+	     << endl;
+	try {
+		bitset bad("10x");
+	} catch (const std::invalid_argument &e) {
+		cout << "bad string throws: " << e.what() << endl;
+	}
+	try {
+		b.test(10);
+	} catch (const std::out_of_range &e) {
+		cout << "test(10) throws: " << e.what() << endl;
+	}
+
+	bitset r(150);
+	r.set(60, 70, true);
+	cout << "set(60, 70): count " << r.count() << ", find_first " << r.find_first()
+	     << ", find_next(128) " << r.find_next(128) << ", find_next(129) is npos "
+	     << (r.find_next(129) == bitset::npos) << endl;
+	r.reset(62, 3);
+	cout << "reset(62, 3): count " << r.count() << ", find_next(61) " << r.find_next(61) << endl;
+	r.set();
+	cout << "set(): all " << r.all() << ", count " << r.count() << endl;
+	r.resize(200, true);
+	cout << "resize(200, true): count " << r.count() << endl;
+	r.resize(130);
+	r.flip();
+	cout << "resize(130) + flip: none " << r.none() << ", count " << r.count() << endl;
+
+	bitset p;
+	for (int i = 0; i < 70; ++i) p.push_back(i % 3 == 0);
+	cout << "push_back 70: count " << p.count() << ", blocks " << p.num_blocks();
+	for (int i = 0; i < 7; ++i) p.pop_back();
+	cout << ", pop_back 7: size " << p.size() << ", blocks " << p.num_blocks() << ", count "
+	     << p.count() << endl;
+
+	bitset x("1010"), y("0110");
+	cout << "1010 & 0110 = " << (x & y).to_string() << ", | " << (x | y).to_string() << ", ^ "
+	     << (x ^ y).to_string() << ", - " << (x - y).to_string() << ", ~1010 = "
+	     << (~x).to_string() << endl;
+	try {
+		x &= b;
+	} catch (const std::invalid_argument &e) {
+		cout << "size mismatch throws: " << e.what() << endl;
+	}
+	cout << "x == x " << (x == bitset("1010")) << ", x != y " << (x != y) << endl;
+
+	const size_t word_limit = leestl::vector<bitset::block_type>().max_size();
+	cout << "max_size in bits: "
+	     << (b.max_size() > word_limit && b.max_size() < bitset::npos ? "ok" : "FAILED") << endl;
+
+	leestl::bitset_rank_index<> index(b);
+	cout << "rank over " << b.to_string() << ":";
+	for (size_t i = 0; i <= b.size(); ++i) cout << " " << index.rank(i);
+	cout << "\nselect:";
+	for (size_t k = 0; k < index.ones(); ++k) cout << " " << index.select(k);
+	cout << endl;
+	cout << ">------------------- API test end -------------------]\n";
+
+	cout << "[------------------- reference test start------------------->\n";
+	for (int level = 0; level <= int(leestl::simd::detected_isa()); ++level) {
+		const leestl::simd::isa i = leestl::simd::isa(level);
+		cout << leestl::simd::isa_name(i) << ": " << (matches_reference(i) ? "ok" : "FAIL") << endl;
+	}
+	cout << ">------------------- reference test end -------------------]\n";
+	cout << ">------------------- dynamic_bitset test end ------------------]\n";
+	return 0;
+}
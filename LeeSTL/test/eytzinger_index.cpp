@@ -0,0 +1,68 @@
+/**
+ * @file eytzinger_index.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::eytzinger_index 测试程序
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+#include "../LeeSTL/eytzinger_index.h"
+#include "../LeeSTL/vector.h"
+
+using std::cout;
+using std::endl;
+
+int main() {
+	cout << "\n[===================================================================]\n";
+	cout << "[---------------------- eytzinger_index test start ---------------------->\n";
+	leestl::vector<int>              sorted = {1, 3, 3, 5, 8, 13, 21, 34, 55, 89};
+	leestl::eytzinger_index<int>     index(sorted);
+	leestl::eytzinger_index<int>     empty;
+	cout << "layout: ";
+	for (int x : index) cout << x << " ";
+	cout << "(size " << index.size() << ")" << endl;
+	for (int x : {0, 3, 4, 89, 90}) {
+		auto it = index.lower_bound(x);
+		cout << "lower_bound " << x << ": ";
+		if (it == index.end()) cout << "end";
+		else cout << *it;
+		cout << ", contains: " << index.contains(x) << endl;
+	}
+	cout << "empty: lower_bound 1 == end: " << (empty.lower_bound(1) == empty.end())
+	     << ", contains 1: " << empty.contains(1) << endl;
+
+	leestl::vector<std::string>          words = {"apple", "banana", "cherry", "date"};
+	leestl::eytzinger_index<std::string> word_index(words.begin(), words.end());
+	cout << "lower_bound \"c\": " << *word_index.lower_bound("c")
+	     << ", contains \"date\": " << word_index.contains("date") << endl;
+
+	// 与 std::lower_bound 对照，覆盖各种大小与批量查找
+	bool ok = true;
+	for (size_t n = 0; n <= 300; ++n) {
+		leestl::vector<int> a(n);
+		for (size_t i = 0; i < n; ++i) a[i] = int(2 * i - i % 3);
+		std::sort(a.data(), a.data() + n);
+		leestl::eytzinger_index<int> idx(a);
+		leestl::vector<int>          queries;
+		for (int x = -2; x < int(2 * n) + 2; ++x) queries.push_back(x);
+		leestl::vector<const int *> results(queries.size());
+		idx.lower_bound(queries.data(), queries.size(), results.data());
+		for (size_t q = 0; q < queries.size(); ++q) {
+			const int *expect = std::lower_bound(a.data(), a.data() + n, queries[q]);
+			const int *single = idx.lower_bound(queries[q]);
+			const bool found = expect != a.data() + n;
+			ok = ok && (found ? single != idx.end() && *single == *expect : single == idx.end());
+			ok = ok && results[q] == single;
+		}
+	}
+	cout << "compare with std::lower_bound: " << (ok ? "ok" : "FAILED") << endl;
+	cout << ">---------------------- eytzinger_index test end ----------------------]\n";
+	return 0;
+}
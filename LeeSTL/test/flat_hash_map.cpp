@@ -0,0 +1,174 @@
+/**
+ * @file flat_hash_map.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::flat_hash_map、leestl::flat_hash_set 测试程序
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../LeeSTL/flat_hash_map.h"
+#include "../LeeSTL/flat_hash_set.h"
+#include "../LeeSTL/memory_resource.h"
+#include "test_util.h"
+
+// 按键排序后输出，使结果与哈希表内部顺序无关
+template <typename Map>
+void print_sorted(const char *name, const Map &m) {
+	std::vector<std::pair<typename Map::key_type, typename Map::mapped_type>> v;
+	for (auto &p : m) v.push_back(p);
+	std::sort(v.begin(), v.end());
+	std::cout << name << ": ";
+	for (auto &p : v) std::cout << p.first << "=" << p.second << " ";
+	std::cout << "(size " << m.size() << ")" << std::endl;
+}
+
+using std::cout;
+using std::endl;
+
+int main() {
+	cout << "\n[===================================================================]\n";
+	cout << "[---------------------- flat_hash_map test start ---------------------->\n";
+	cout << "[------------------- API test start------------------->\n";
+	leestl::flat_hash_map<std::string, int> m1 = {{"one", 1}, {"two", 2}, {"three", 3}};
+	print_sorted("m1", m1);
+	m1["four"] = 4;
+	m1.insert({"one", 100});    // 键已存在，不插入
+	m1.insert_or_assign("two", 22);
+	m1.try_emplace("five", 5);
+	m1.emplace("six", 6);
+	print_sorted("m1 after insert", m1);
+	cout << "erase three: " << m1.erase("three") << ", erase seven: " << m1.erase("seven")
+	     << endl;
+	cout << "at four: " << m1.at("four") << ", count two: " << m1.count("two")
+	     << ", contains three: " << m1.contains("three") << endl;
+	try {
+		m1.at("seven");
+	} catch (const std::out_of_range &e) {
+		cout << "at seven: out_of_range" << endl;
+	}
+
+	// 以 string_view 查找，不构造临时 std::string
+	std::string_view key = "five";
+	cout << "find string_view five: " << m1.find(key)->second << endl;
+
+	leestl::flat_hash_map<std::string, int> m2(m1), m3;
+	m3 = leestl::move(m2);
+	cout << "copy == original: " << (m3 == m1) << ", moved-from empty: " << m2.empty() << endl;
+	m3.clear();
+	cout << "clear: size " << m3.size() << ", capacity " << m3.capacity() << endl;
+	cout << ">------------------- API test end -------------------]\n";
+
+	cout << "[------------------- flat_hash_set test start------------------->\n";
+	leestl::flat_hash_set<int> s1 = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5};
+	std::vector<int>           keys;
+	for (int k : s1) keys.push_back(k);
+	std::sort(keys.begin(), keys.end());
+	cout << "s1: ";
+	for (int k : keys) cout << k << " ";
+	cout << "(size " << s1.size() << ")" << endl;
+	s1.erase(s1.find(4));
+	cout << "erase 4: contains 4: " << s1.contains(4) << ", size " << s1.size() << endl;
+	cout << ">------------------- flat_hash_set test end -------------------]\n";
+
+	cout << "[------------------- allocator & exception test start------------------->\n";
+	// 配置器不同且不传播时，移动赋值逐个移动元素；集合的迭代器只读，需要按槽位访问
+	leestl::stack_buffer_resource<1024> arena1, arena2;
+	typedef leestl::arena_allocator<int> int_arena;
+	leestl::flat_hash_set<int, leestl::hash<int>, leestl::equal_to<int>, int_arena> as1(
+	    arena1),
+	    as2(arena2);
+	for (int i = 0; i < 20; ++i) as1.insert(i);
+	as2.insert(100);
+	as2 = leestl::move(as1);
+	cout << "set move-assign across arenas: size " << as2.size() << ", contains 19: "
+	     << as2.contains(19) << ", contains 100: " << as2.contains(100)
+	     << ", source empty: " << as1.empty() << endl;
+
+	typedef leestl::arena_allocator<std::pair<const int, std::string>> pair_arena;
+	leestl::flat_hash_map<int, std::string, leestl::hash<int>, leestl::equal_to<int>, pair_arena>
+	    am1(arena1), am2(arena2);
+	for (int i = 0; i < 20; ++i) am1.try_emplace(i, std::string(30, char('a' + i)));
+	am2 = leestl::move(am1);
+	cout << "map move-assign across arenas: size " << am2.size() << ", am2[7] == h...: "
+	     << (am2.find(7)->second == std::string(30, 'h')) << ", source empty: " << am1.empty()
+	     << endl;
+
+	// 复制赋值不传播配置器：目标保留自己的配置器，元素复制到自己的空间中
+	as1 = as2;
+	cout << "set copy-assign across arenas: size " << as1.size()
+	     << ", keeps own arena: " << (as1.get_allocator() == int_arena(arena1)) << endl;
+	typedef tagged_allocator<int> int_tagged;
+	typedef leestl::flat_hash_set<int, leestl::hash<int>, leestl::equal_to<int>, int_tagged>
+	    tagged_set;
+	tagged_set ts1(int_tagged(1)), ts2(int_tagged(2));
+	for (int i = 0; i < 20; ++i) ts2.insert(i);
+	ts1 = ts2;
+	cout << "tagged copy-assign: size " << ts1.size() << ", id " << ts1.get_allocator().id
+	     << (ts1.get_allocator().id == 1 && ts1.contains(19) ? " ok" : " FAILED") << endl;
+
+	// 移动构造会抛出异常的元素：重建时复制元素，复制失败时原表保持不变且不泄漏
+	{
+		// 插入不复制元素，只有重建会复制；限制复制次数后一直插入直到重建失败
+		leestl::flat_hash_map<int, fragile> fm;
+		fragile::copies_left = 5;
+		size_t cap = 0;
+		int    n = 0;
+		bool   threw = false;
+		try {
+			for (;; ++n) {
+				cap = fm.capacity();
+				fm.try_emplace(n, n);
+			}
+		} catch (const std::runtime_error &) {
+			threw = true;
+		}
+		fragile::copies_left = 1000;
+		bool intact = fm.size() == size_t(n) && fm.capacity() == cap;
+		for (int i = 0; i < n; ++i) intact = intact && fm.find(i)->second.value == i;
+		cout << "rehash with throwing move: threw " << threw << ", table intact " << intact;
+		fm.try_emplace(n, n);
+		cout << ", retry size " << fm.size() << endl;
+	}
+	cout << "fragile live after destruction: " << fragile::live << endl;
+	cout << ">------------------- allocator & exception test end -------------------]\n";
+
+	cout << "[------------------- compare with std::unordered_map start------------------->\n";
+	// 小键空间上反复插入删除，覆盖溢出位残留与原容量重建
+	std::mt19937_64 rng(20261018);
+	for (uint64_t range : {16, 1000, 100000}) {
+		leestl::flat_hash_map<uint64_t, uint64_t> m;
+		std::unordered_map<uint64_t, uint64_t>    ref;
+		bool                                      ok = true;
+		for (int op = 0; op < 200000; ++op) {
+			const uint64_t k = rng() % range, v = rng();
+			switch (rng() % 3) {
+				case 0: m.insert_or_assign(k, v), ref[k] = v; break;
+				case 1: ok = ok && m.erase(k) == ref.erase(k); break;
+				default: {
+					auto it = m.find(k);
+					auto jt = ref.find(k);
+					ok = ok && (it == m.end() ? jt == ref.end()
+					                          : jt != ref.end() && it->second == jt->second);
+				}
+			}
+		}
+		size_t n = 0;
+		for (auto &p : m) ok = ok && ref.count(p.first) && ref[p.first] == p.second && ++n;
+		ok = ok && n == ref.size() && m.size() == ref.size();
+		cout << "key range " << range << ": " << (ok ? "ok" : "FAILED") << endl;
+	}
+	cout << ">------------------- compare with std::unordered_map end -------------------]\n";
+	cout << ">---------------------- flat_hash_map test end ----------------------]\n";
+	return 0;
+}
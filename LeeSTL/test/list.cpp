@@ -0,0 +1,243 @@
+/**
+ * @file list.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::list 测试程序
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <iostream>
+#include <list>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../LeeSTL/list.h"
+#include "test_util.h"
+
+using std::cout;
+using std::endl;
+
+template <typename List>
+typename List::iterator nth(List &l, size_t n) {
+	auto it = l.begin();
+	while (n--) ++it;
+	return it;
+}
+
+// 在两个 list 之间随机插入、删除、转移、合并、排序，与 std::list 逐步比较
+template <typename T, typename Gen>
+bool compare_with_std(Gen gen, int ops) {
+	leestl::list<T> a, b;
+	std::list<T>    ra, rb;
+	std::mt19937    rng(2026);
+	for (int op = 0; op < ops; ++op) {
+		const int r = rng() % 100;
+		const T   x = gen(rng() % 1000);
+		if (r < 20) {
+			const size_t i = rng() % (ra.size() + 1);
+			a.insert(nth(a, i), x);
+			ra.insert(nth(ra, i), x);
+		} else if (r < 25) {
+			const size_t i = rng() % (rb.size() + 1), n = rng() % 50;
+			b.insert(nth(b, i), n, x);
+			rb.insert(nth(rb, i), n, x);
+		} else if (r < 30) {
+			std::vector<T> src;
+			for (size_t k = rng() % 50; k > 0; --k) src.push_back(gen(rng() % 1000));
+			a.insert(a.end(), src.data(), src.data() + src.size());
+			ra.insert(ra.end(), src.begin(), src.end());
+		} else if (r < 45) {
+			if (ra.empty()) continue;
+			const size_t i = rng() % ra.size();
+			a.erase(nth(a, i));
+			ra.erase(nth(ra, i));
+		} else if (r < 55) {
+			// 单个结点在两个容器之间转移
+			if (ra.empty()) continue;
+			const size_t i = rng() % ra.size(), j = rng() % (rb.size() + 1);
+			b.splice(nth(b, j), a, nth(a, i));
+			rb.splice(nth(rb, j), ra, nth(ra, i));
+		} else if (r < 60) {
+			const size_t i = rng() % (rb.size() + 1), n = rng() % (rb.size() - i + 1);
+			const size_t j = rng() % (ra.size() + 1);
+			a.splice(nth(a, j), b, nth(b, i), nth(b, i + n));
+			ra.splice(nth(ra, j), rb, nth(rb, i), nth(rb, i + n));
+		} else if (r < 63) {
+			a.sort();
+			ra.sort();
+			b.sort();
+			rb.sort();
+			a.merge(b);
+			ra.merge(rb);
+		} else if (r < 66) {
+			b.sort();
+			rb.sort();
+		} else if (r < 68) {
+			a.unique();
+			ra.unique();
+		} else if (r < 70) {
+			a.remove(x);
+			ra.remove(x);
+		} else if (r < 72) {
+			a.reverse();
+			ra.reverse();
+		} else if (r < 74) {
+			leestl::list<T> c(a);
+			b.swap(c);
+			rb = ra;
+		} else if (r < 76) {
+			const size_t n = rng() % 200;
+			b.resize(n, x);
+			rb.resize(n, x);
+		} else if (r < 77) {
+			a.clear();
+			ra.clear();
+		} else if (r < 78) {
+			b = leestl::move(a);
+			a = b;
+			rb = ra;
+		} else {
+			a.push_front(x);
+			ra.push_front(x);
+			b.push_back(x);
+			rb.push_back(x);
+		}
+		if (op % 50 == 0 && !(same(a, ra) && same(b, rb))) return false;
+	}
+	return same(a, ra) && same(b, rb);
+}
+
+// 排序的稳定性：按 first 排序后，first 相同的元素保持原来的 second 顺序
+bool sort_is_stable() {
+	leestl::list<std::pair<int, int>> l;
+	std::mt19937                      rng(7);
+	for (int i = 0; i < 100000; ++i) l.push_back({int(rng() % 100), i});
+	l.sort([](const std::pair<int, int> &x, const std::pair<int, int> &y) {
+		return x.first < y.first;
+	});
+	auto prev = l.begin();
+	for (auto it = ++l.begin(); it != l.end(); ++it, ++prev) {
+		if (prev->first > it->first) return false;
+		if (prev->first == it->first && prev->second > it->second) return false;
+	}
+	return l.size() == 100000;
+}
+
+// 互相 splice、merge 过的两个 list 结点池仍然独立，可以在不同线程中同时修改
+bool independent_after_splice() {
+	leestl::list<int> a(1000, 1), b(1000, 2);
+	b.splice(b.begin(), a, a.begin(), nth(a, 500));
+	a.splice(a.end(), b, b.begin());
+	a.sort();
+	b.sort();
+	a.merge(b);
+	b.assign(1000, 3);
+	auto churn = [](leestl::list<int> &l, int v) {
+		for (int i = 0; i < 200000; ++i) {
+			l.push_back(v);
+			l.pop_front();
+		}
+	};
+	std::thread t([&] { churn(a, 4); });
+	churn(b, 5);
+	t.join();
+	return a.size() == 2000 && b.size() == 1000 && a.front() == 4 && b.back() == 5;
+}
+
+int main() {
+	cout << "\n[===================================================================]\n";
+	cout << "[------------------------ list test start ------------------------>\n";
+	cout << "[------------------- API test start------------------->\n";
+	leestl::list<int> l1, l2(3), l3(4, 7), l4 = {5, 1, 4, 2, 3};
+	leestl::list<int> l5(l4.begin(), l4.end()), l6(l4);
+	print("l1", l1);
+	print("l2", l2);
+	print("l3", l3);
+	print("l4", l4);
+	l5.sort();
+	print("l5 sorted", l5);
+	l6.push_front(0);
+	l6.push_back(9);
+	l6.insert(++l6.begin(), 2, 8);
+	l6.emplace(l6.end(), 10);
+	print("l6 after insert", l6);
+	l6.pop_front();
+	l6.pop_back();
+	l6.erase(l6.begin());
+	print("l6 after erase", l6);
+	cout << "front " << l6.front() << ", back " << l6.back() << endl;
+	l6.sort();
+	l5.merge(l6);
+	print("l5 merge l6", l5);
+	cout << "unique removed " << l5.unique() << ", remove 9 removed " << l5.remove(9) << endl;
+	l5.reverse();
+	print("l5 reversed", l5);
+	l3.splice(l3.begin(), l5, ++l5.begin(), l5.end());
+	print("l3 after splice", l3);
+	print("l5 after splice", l5);
+	l1 = l3;
+	cout << "l1 == l3: " << (l1 == l3) << ", l5 < l3: " << (l5 < l3) << endl;
+	leestl::swap(l1, l4);
+	print("l1 after swap", l1);
+	cout << "reverse: ";
+	for (auto it = l1.rbegin(); it != l1.rend(); ++it) cout << *it << " ";
+	cout << endl;
+	cout << ">------------------- API test end -------------------]\n";
+
+	cout << "[------------------- node pool test start------------------->\n";
+	// 结点回收：反复增删不再分配；批量插入的结点在内存中连续
+	leestl::list<int, counting_allocator<int>> q;
+	for (int i = 0; i < 10000; ++i) q.push_back(i);
+	const size_t warm = allocations;
+	for (int i = 0; i < 1000000; ++i) {
+		q.pop_front();
+		q.push_back(i);
+	}
+	cout << "allocations after warm-up: " << allocations - warm << endl;
+	leestl::list<int, counting_allocator<int>> bulk;
+	const size_t                               before = allocations;
+	bulk.insert(bulk.end(), 100000, 1);
+	bool contiguous = true;
+	for (auto it = bulk.begin(), next = ++bulk.begin(); next != bulk.end(); ++it, ++next)
+		contiguous = contiguous && (reinterpret_cast<const char *>(&*next) -
+		                                reinterpret_cast<const char *>(&*it) ==
+		                            ptrdiff_t(sizeof(leestl::_list_node<int>)));
+	cout << "bulk insert 100000: allocations " << allocations - before
+	     << ", contiguous: " << contiguous << endl;
+	// 默认 splice 把元素移到本容器池中的结点上，源容器析构不影响转移过来的元素
+	leestl::list<std::string> *src = new leestl::list<std::string>(1000, "spliced");
+	leestl::list<std::string>  dst = {"a", "b"};
+	dst.splice(++dst.begin(), *src, src->begin(), --src->end());
+	delete src;
+	dst.push_back("c");
+	cout << "after splice from destroyed list: size " << dst.size() << ", second " << *++dst.begin()
+	     << ", back " << dst.back() << endl;
+	// share_pool 之后 splice 只修改链接，迭代器仍指向同一个元素；先析构的一方不释放共用的池
+	leestl::list<std::string> *shared = new leestl::list<std::string>{"x", "y", "z"};
+	leestl::list<std::string>  owner = {"a"};
+	owner.share_pool(*shared);
+	auto y = ++shared->begin();
+	owner.splice(owner.end(), *shared, y);
+	delete shared;
+	owner.push_back("b");
+	cout << "shared pool splice keeps iterators: " << (&*y == &*++owner.begin() ? "ok" : "FAIL")
+	     << ", size " << owner.size() << endl;
+	cout << "independent pools after splice/merge: "
+	     << (independent_after_splice() ? "ok" : "FAIL") << endl;
+	cout << "sort is stable: " << sort_is_stable() << endl;
+	cout << ">------------------- node pool test end -------------------]\n";
+
+	cout << "[------------------- compare with std::list start------------------->\n";
+	auto int_gen = [](int k) { return k % 100; };
+	auto str_gen = [](int k) { return "value-" + std::to_string(k % 100) + std::string(20, 'x'); };
+	cout << "int: " << (compare_with_std<int>(int_gen, 20000) ? "ok" : "FAIL") << endl;
+	cout << "string: " << (compare_with_std<std::string>(str_gen, 5000) ? "ok" : "FAIL") << endl;
+	cout << ">------------------- compare with std::list end -------------------]\n";
+	cout << ">------------------------ list test end ------------------------]\n";
+	return 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file small_vector.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::small_vector 测试程序
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <iostream>
+#include <string>
+
+#include "../LeeSTL/memory_resource.h"
+#include "../LeeSTL/small_vector.h"
+#include "test_util.h"
+
+template <typename T, size_t N, typename Alloc>
+std::ostream &operator<<(std::ostream &os, const leestl::small_vector<T, N, Alloc> &v) {
+	for (auto &i : v) { os << i << " "; }
+	os << "(size " << v.size() << ", capacity " << v.capacity()
+	   << (v.is_inline() ? ", inline)" : ", heap)") << std::endl;
+	return os;
+}
+
+using std::cout;
+using std::endl;
+
+int main() {
+	cout << "\n[===================================================================]\n";
+	cout << "[---------------------- small_vector test start ---------------------->\n";
+	cout << "[------------------- API test start------------------->\n";
+	leestl::small_vector<int, 4> v1, v2(3), v3(6, 5);
+	leestl::small_vector<int, 4> v4 = {41, 42, 43};
+	leestl::small_vector<int, 4> v5(v4.begin(), v4.end()), v6(v3);
+	cout << "v1: " << v1;
+	cout << "v2: " << v2;
+	cout << "v3: " << v3;
+	cout << "v4: " << v4;
+	cout << "v5: " << v5;
+	cout << "v6: " << v6;
+
+	leestl::small_vector<int, 4> v7(leestl::move(v4));    // 内联元素逐个迁移
+	leestl::small_vector<int, 4> v8(leestl::move(v6));    // 堆上空间直接接管
+	cout << "v4: " << v4;
+	cout << "v7: " << v7;
+	cout << "v6: " << v6;
+	cout << "v8: " << v8;
+
+	v7 = v8;
+	cout << "v7 = v8: " << v7;
+	v8 = {1, 2};
+	cout << "v8 = {1, 2}: " << v8;
+	v7 = leestl::move(v8);
+	cout << "v7 = move(v8): " << v7;
+	v7.swap(v3);
+	cout << "v7.swap(v3): " << v7 << "v3: " << v3;
+
+	leestl::small_vector<int, 4> v9;
+	for (int i = 0; i < 4; ++i) v9.push_back(i);
+	cout << "v9: " << v9;
+	v9.emplace_back(4);    // 第 5 个元素溢出到堆上
+	cout << "v9 emplace_back(4): " << v9;
+	v9.insert(v9.begin() + 1, 3, 7);
+	v9.insert(v9.end(), {8, 9});
+	v9.emplace(v9.begin(), -1);
+	cout << "v9 insert: " << v9;
+	v9.erase(v9.begin() + 2, v9.begin() + 4);
+	v9.erase(v9.begin());
+	cout << "v9 erase: " << v9;
+	cout << "v9 front/back/at(2): " << v9.front() << " " << v9.back() << " " << v9.at(2)
+	     << endl;
+	try {
+		v9.at(100);
+	} catch (const std::out_of_range &) { cout << "v9.at(100): out_of_range" << endl; }
+	v9.resize(3);
+	v9.shrink_to_fit();    // 元素个数不超过 N，回到内联存储
+	cout << "v9 resize(3), shrink_to_fit: " << v9;
+	v9.resize(5, 6);
+	cout << "v9 resize(5, 6): " << v9;
+	v9.assign(2, 1);
+	cout << "v9 assign(2, 1): " << v9;
+	v9.clear();
+	cout << "v9 clear empty: " << v9.empty() << endl;
+
+	leestl::small_vector<std::string, 2> v10;
+	for (int i = 0; i < 4; ++i) v10.emplace_back(3, char('a' + i));
+	v10.push_back(v10[0]);    // 扩容时参数引用的是旧空间中的元素
+	v10.insert(v10.begin() + 1, "xyz");
+	cout << "v10: " << v10;
+	leestl::small_vector<std::string, 2> v11 = {"s1", "s2"}, v12(v10);
+	v11.swap(v12);    // 内联与堆上的交换
+	cout << "v11: " << v11;
+	cout << "v12: " << v12;
+	cout << ">------------------- API test end -------------------]\n";
+
+	cout << "[------------------- allocator test start------------------->\n";
+	leestl::stack_buffer_resource<256>                         arena;
+	leestl::small_vector<int, 4, leestl::arena_allocator<int>> av1(3, 6, arena);
+	const int more[] = {1, 2, 3};
+	av1.insert(av1.begin() + 1, input_iterator<int>(more), input_iterator<int>(more + 3));
+	cout << "av1: " << av1;
+	cout << ">------------------- allocator test end -------------------]\n";
+
+	cout << "sizeof(leestl::small_vector<int, 16>): " << sizeof(leestl::small_vector<int, 16>)
+	     << endl;
+	cout << ">---------------------- small_vector test end ----------------------]\n";
+	return 0;
+}
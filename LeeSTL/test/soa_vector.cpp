@@ -0,0 +1,230 @@
+/**
+ * @file soa_vector.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::soa_vector 测试程序
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 编译: g++ -std=c++17 -I.. soa_vector.cpp -o soa_vector
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "../LeeSTL/soa_vector.h"
+#include "test_util.h"
+
+using std::cout;
+using std::endl;
+
+typedef leestl::soa_vector<int, double, std::string> records;
+
+// 值初始化时写入 7 的配置器，用来确认元素经由配置器构造
+template <typename T>
+struct seven_allocator {
+	typedef T value_type;
+
+	seven_allocator() = default;
+	template <typename U>
+	seven_allocator(const seven_allocator<U> &) {}
+
+	T   *allocate(size_t n) { return static_cast<T *>(::operator new(n * sizeof(T))); }
+	void deallocate(T *ptr, size_t) { ::operator delete(ptr); }
+
+	template <typename U, typename... Args>
+	void construct(U *ptr, Args &&...args) {
+		if constexpr (sizeof...(Args) == 0 && std::is_arithmetic<U>::value) ::new (ptr) U(7);
+		else ::new (ptr) U(std::forward<Args>(args)...);
+	}
+
+	bool operator==(const seven_allocator &) const { return true; }
+	bool operator!=(const seven_allocator &) const { return false; }
+};
+
+// 各列起始地址都按 soa_column_alignment 对齐
+template <typename Vector, size_t... I>
+bool columns_aligned(const Vector &v, std::index_sequence<I...>) {
+	return ((reinterpret_cast<uintptr_t>(v.template data<I>()) % leestl::soa_column_alignment ==
+	         0) &&
+	        ...);
+}
+
+// 随机的追加、删除、改变大小与逐列修改后，内容与按行存储的 std::vector 一致
+bool matches_reference(size_t rounds) {
+	leestl::soa_vector<uint8_t, uint64_t, uint16_t, std::string> v;
+	std::vector<std::tuple<uint8_t, uint64_t, uint16_t, std::string>> expect;
+	uint32_t                                                           seed = 2026;
+	auto next = [&seed] { return seed = seed * 1664525u + 1013904223u; };
+	for (size_t r = 0; r < rounds; ++r) {
+		const uint32_t x = next();
+		switch (x % 8) {
+		case 0:
+		case 1:
+		case 2:
+			v.emplace_back(uint8_t(x), uint64_t(x) << 20, uint16_t(x >> 3), std::to_string(x));
+			expect.emplace_back(uint8_t(x), uint64_t(x) << 20, uint16_t(x >> 3), std::to_string(x));
+			break;
+		case 3:
+			if (!expect.empty()) {
+				const size_t i = x % expect.size(), n = (x >> 8) % 4;
+				const size_t last = i + n < expect.size() ? i + n : expect.size();
+				v.erase(v.begin() + i, v.begin() + last);
+				expect.erase(expect.begin() + i, expect.begin() + last);
+			}
+			break;
+		case 4:
+			v.resize(x % 300);
+			expect.resize(x % 300);
+			break;
+		case 5: {
+			auto col = v.column<1>();
+			for (size_t i = 0; i < col.size(); ++i) col[i] += i;
+			for (size_t i = 0; i < expect.size(); ++i) std::get<1>(expect[i]) += i;
+			break;
+		}
+		case 6:
+			if (!expect.empty()) {
+				v.push_back(v[x % v.size()]);    // 引用自身元素
+				expect.push_back(expect[x % expect.size()]);
+			}
+			break;
+		default:
+			if (x & 256) v.shrink_to_fit();
+			else v.reserve(x % 500);
+		}
+		if (v.size() != expect.size() || !columns_aligned(v, std::make_index_sequence<4>()))
+			return false;
+	}
+	for (size_t i = 0; i < expect.size(); ++i)
+		if (v[i] != expect[i]) return false;
+	return true;
+}
+
+int main() {
+	cout << "\n[===================================================================]\n";
+	cout << "[------------------- soa_vector test start ------------------->\n";
+	cout << "[------------------- API test start------------------->\n";
+	records v = {{1, 1.5, "a"}, {2, 2.5, "b"}};
+	v.push_back({3, 3.5, "c"});
+	v.emplace_back(4, 4.5, "d");
+	print("v", v);
+	auto [id, price, name] = v[1];
+	price *= 10;
+	name = "B";
+	cout << "through proxy: id " << id << ", v[1] = (" << std::get<1>(v[1]) << ", "
+	     << v.get<2>(1) << ")" << endl;
+	v[0] = std::make_tuple(10, 0.5, std::string("z"));
+	cout << "front " << std::get<0>(v.front()) << ", back " << std::get<2>(v.back()) << ", at(2) "
+	     << std::get<0>(v.at(2)) << endl;
+	try {
+		v.at(4);
+	} catch (const std::out_of_range &e) {
+		cout << "at(4) throws: " << e.what() << endl;
+	}
+
+	auto ids = v.column<0>();
+	int  sum = 0;
+	for (int x : ids) sum += x;
+	cout << "column<0> size " << ids.size() << ", sum " << sum << ", data<1> aligned "
+	     << (reinterpret_cast<uintptr_t>(v.data<1>()) % 64 == 0) << endl;
+
+	auto it = v.begin() + 2;
+	cout << "iterator: index " << it.index() << ", get<2> " << it.get<2>() << ", end - begin "
+	     << (v.end() - v.begin()) << ", reverse first " << std::get<0>(*v.rbegin()) << endl;
+	records::const_iterator cit = it;
+	cout << "const iterator == " << (cit == it) << ", it[1] " << std::get<0>(it[1]) << endl;
+
+	v.erase(v.begin() + 1);
+	print("v", v);
+	v.pop_back();
+	v.resize(4, std::make_tuple(7, 7.5, std::string("r")));
+	print("v", v);
+	v.resize(5);
+	cout << "resize(5) value-initialized: " << std::get<0>(v[4]) << " " << std::get<1>(v[4])
+	     << " '" << std::get<2>(v[4]) << "'" << endl;
+
+	leestl::basic_soa_vector<seven_allocator<char>, int, double> sv;
+	sv.resize(3);
+	cout << "resize through allocator construct: "
+	     << (sv.get<0>(2) == 7 && sv.get<1>(2) == 7.0 ? "ok" : "FAILED") << endl;
+
+	records copy(v);
+	cout << "copy == v " << (copy == v) << ", copy < v " << (copy < v) << endl;
+	std::get<0>(copy[0]) = -1;
+	cout << "after change copy < v " << (copy < v) << ", copy != v " << (copy != v) << endl;
+	const int *column = copy.data<0>();
+	records    moved(leestl::move(copy));
+	cout << "moved size " << moved.size() << ", source size " << copy.size()
+	     << ", column kept " << (moved.data<0>() == column) << endl;
+	copy = v;
+	v = leestl::move(moved);
+	cout << "assigned: copy size " << copy.size() << ", v front " << std::get<0>(v.front())
+	     << endl;
+	v.swap(copy);
+	cout << "after swap: v front " << std::get<0>(v.front()) << endl;
+
+	records r;
+	r.reserve(100);
+	cout << "reserve(100): capacity " << r.capacity() << ", size " << r.size() << endl;
+	r.emplace_back(1, 1.0, "x");
+	r.shrink_to_fit();
+	cout << "shrink_to_fit: capacity " << r.capacity() << endl;
+	r.clear();
+	r.shrink_to_fit();
+	cout << "clear + shrink_to_fit: capacity " << r.capacity() << ", empty " << r.empty() << endl;
+
+	const std::tuple<int, double, std::string> src[] = {{5, 5.0, "p"}, {6, 6.0, "q"}};
+	records                                    from_range(src, src + 2);
+	print("from_range", from_range);
+	leestl::soa_vector<char, int64_t> n(3, std::make_tuple('k', int64_t(9)));
+	cout << "fill: " << n.get<0>(2) << " " << n.get<1>(2) << endl;
+	cout << ">------------------- API test end -------------------]\n";
+
+	cout << "[------------------- exception test start------------------->\n";
+	{
+		leestl::soa_vector<std::string, fragile> f;
+		for (int i = 0; i < 4; ++i) f.emplace_back(std::to_string(i), fragile(i));
+		const size_t cap = f.capacity();
+		fragile::copies_left = 2;
+		try {
+			f.reserve(100);    // 第二列复制到一半时失败
+		} catch (const std::runtime_error &) {
+			cout << "reserve threw, ";
+		}
+		cout << "size " << f.size() << ", capacity kept " << (f.capacity() == cap) << ", live "
+		     << fragile::live << endl;
+		fragile::copies_left = 0;
+		try {
+			f.emplace_back("x", fragile(9));    // 第一列已构造，第二列失败
+		} catch (const std::runtime_error &) {
+			cout << "emplace_back threw, ";
+		}
+		cout << "size " << f.size() << ", last " << f.get<0>(f.size() - 1) << ", live "
+		     << fragile::live << endl;
+		try {
+			leestl::soa_vector<std::string, fragile> fails(f);
+		} catch (const std::runtime_error &) {
+			cout << "copy constructor threw, live " << fragile::live << endl;
+		}
+		fragile::copies_left = 1000;
+		f.resize(6);
+		cout << "resize(6): live " << fragile::live << endl;
+	}
+	cout << "all destroyed: " << (fragile::live == 0 ? "ok" : "FAIL") << endl;
+	cout << ">------------------- exception test end -------------------]\n";
+
+	cout << "[------------------- reference test start------------------->\n";
+	cout << "20000 random operations against std::vector<tuple>: "
+	     << (matches_reference(20000) ? "ok" : "FAIL") << endl;
+	cout << ">------------------- reference test end -------------------]\n";
+	cout << ">------------------- soa_vector test end ------------------]\n";
+	return 0;
+}
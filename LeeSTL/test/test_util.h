@@ -0,0 +1,175 @@
+/**
+ * @file test_util.h
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief 各测试程序共用的输出函数、统计分配次数的配置器与会抛出异常的元素类型
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef _LEESTL_TEST_UTIL_H_
+#define _LEESTL_TEST_UTIL_H_
+
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "../LeeSTL/iterator_base_types.h"
+
+// 输出一个元素：pair 输出为 key=value，tuple 输出为 (a, b, ...)
+template <typename T>
+void print_value(const T &x) {
+	std::cout << x;
+}
+
+template <typename K, typename V>
+void print_value(const std::pair<K, V> &x) {
+	std::cout << x.first << "=" << x.second;
+}
+
+template <typename... Ts>
+void print_value(const std::tuple<Ts...> &x) {
+	std::cout << "(";
+	std::apply(
+	    [](const auto &first, const auto &...rest) {
+		    print_value(first);
+		    ((std::cout << ", ", print_value(rest)), ...);
+	    },
+	    x);
+	std::cout << ")";
+}
+
+// 输出容器名称、全部元素与元素个数
+template <typename Container>
+void print(const char *name, const Container &c) {
+	std::cout << name << ": ";
+	for (auto &&x : c) {
+		print_value(x);
+		std::cout << " ";
+	}
+	std::cout << "(size " << c.size() << ")" << std::endl;
+}
+
+// 正向、反向遍历 c 得到的元素都与 ref 一致
+template <typename Container, typename Ref>
+bool same(const Container &c, const Ref &ref) {
+	if (c.size() != ref.size()) return false;
+	auto jt = ref.begin();
+	for (auto &&x : c)
+		if (!(x == *jt++)) return false;
+	auto rj = ref.rbegin();
+	for (auto it = c.rbegin(); it != c.rend(); ++it)
+		if (!(*it == *rj++)) return false;
+	return true;
+}
+
+// 在 same 的基础上，按下标访问得到的元素也与 ref 一致
+template <typename Container, typename Ref>
+bool same_indexed(const Container &c, const Ref &ref) {
+	if (!same(c, ref)) return false;
+	for (size_t i = 0; i < ref.size(); ++i)
+		if (!(c[i] == ref[i])) return false;
+	return true;
+}
+
+// counting_allocator 的分配次数
+inline size_t allocations = 0;
+
+// 统计分配次数的无状态配置器
+template <typename T>
+struct counting_allocator {
+	typedef T value_type;
+
+	counting_allocator() = default;
+	template <typename U>
+	counting_allocator(const counting_allocator<U> &) {}
+
+	T *allocate(size_t n) {
+		++allocations;
+		return static_cast<T *>(::operator new(n * sizeof(T)));
+	}
+	void deallocate(T *ptr, size_t) { ::operator delete(ptr); }
+
+	bool operator==(const counting_allocator &) const { return true; }
+	bool operator!=(const counting_allocator &) const { return false; }
+};
+
+// 带状态的配置器，id 不同的实例不能互相释放内存；移动赋值、复制赋值时不传播，交换时传播
+template <typename T>
+struct tagged_allocator {
+	typedef T              value_type;
+	typedef std::true_type propagate_on_container_swap;
+
+	int id;
+
+	explicit tagged_allocator(int _id = 0) : id(_id) {}
+	template <typename U>
+	tagged_allocator(const tagged_allocator<U> &a) : id(a.id) {}
+
+	T   *allocate(size_t n) { return static_cast<T *>(::operator new(n * sizeof(T))); }
+	void deallocate(T *ptr, size_t) { ::operator delete(ptr); }
+
+	bool operator==(const tagged_allocator &a) const { return id == a.id; }
+	bool operator!=(const tagged_allocator &a) const { return id != a.id; }
+};
+
+// 只提供输入迭代器操作的指针包装，用来走容器的单趟范围插入路径
+template <typename T>
+struct input_iterator
+    : public leestl::iterator<leestl::input_interator_tag, T, ptrdiff_t, const T *, const T &> {
+	const T *ptr;
+
+	explicit input_iterator(const T *p) : ptr(p) {}
+	const T        &operator*() const { return *ptr; }
+	input_iterator &operator++() {
+		++ptr;
+		return *this;
+	}
+	bool operator==(const input_iterator &x) const { return ptr == x.ptr; }
+	bool operator!=(const input_iterator &x) const { return ptr != x.ptr; }
+};
+
+/**
+ * @brief 复制构造在 copies_left 次之后抛出异常，并统计存活对象个数的元素
+ *
+ * 	Movable 为假时移动构造与复制构造相同（同样计数、可能抛出异常），容器只能复制元素；
+ * 	为真时移动构造不抛出异常。赋值运算由用户提供，不是平凡的
+ *
+ * @tparam Movable 移动构造是否不抛出异常
+ */
+template <bool Movable>
+struct basic_fragile {
+	static inline int copies_left = 1000;
+	static inline int live = 0;
+	int               value;
+
+	explicit basic_fragile(int v = 0) : value(v) { ++live; }
+	basic_fragile(const basic_fragile &x) : value(x.value) {
+		_count_copy();
+		++live;
+	}
+	basic_fragile(basic_fragile &&x) noexcept(Movable) : value(x.value) {
+		if constexpr (!Movable) _count_copy();
+		++live;
+	}
+	~basic_fragile() { --live; }
+
+	basic_fragile &operator=(const basic_fragile &x) {
+		value = x.value;
+		return *this;
+	}
+
+private:
+	static void _count_copy() {
+		if (--copies_left < 0) throw std::runtime_error("copy failed");
+	}
+};
+
+typedef basic_fragile<false> fragile;            // 只能复制
+typedef basic_fragile<true>  movable_fragile;    // 移动不抛出异常
+
+#endif
@@ -0,0 +1,184 @@
+/**
+ * @file thread_alloc.cpp
+ * @author zanzan lee (leezanzan@outlook.com)
+ * @brief leestl::thread_alloc 测试程序
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * 编译: g++ -std=c++17 -pthread -I.. thread_alloc.cpp -o thread_alloc
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "../LeeSTL/thread_alloc.h"
+#include "../LeeSTL/vector.h"
+
+using std::cout;
+using std::endl;
+
+typedef leestl::_size_class size_class;
+
+// 每个分级的区块大小恰好落在本级，边界两侧的尺寸分到相邻两级
+bool size_classes_consistent() {
+	for (size_t cls = 0; cls < size_t(size_class::_NCLASSES); ++cls) {
+		const size_t bytes = size_class::size(cls);
+		if (size_class::index(bytes) != cls) return false;
+		if (cls > 0 && size_class::index(size_class::size(cls - 1) + 1) != cls) return false;
+	}
+	return size_class::index(1) == 0 && size_class::size(size_class::_NCLASSES - 1) ==
+	                                        size_t(size_class::_MAX_BYTES);
+}
+
+// 边界尺寸的区块写满后互不覆盖；超过 1024 字节的区块交给第一级配置器
+bool boundary_blocks_intact() {
+	const size_t sizes[] = {0, 1, 7, 8, 9, 127, 128, 129, 191, 192, 193, 1023, 1024, 1025, 4096};
+	std::vector<std::pair<unsigned char *, size_t>> blocks;
+	for (int round = 0; round < 4; ++round)
+		for (size_t n : sizes) {
+			auto *p = static_cast<unsigned char *>(leestl::thread_alloc::allocate(n));
+			std::memset(p, int(blocks.size() & 0xff), n);
+			blocks.emplace_back(p, n);
+		}
+	bool ok = true;
+	for (size_t i = 0; i < blocks.size(); ++i)
+		for (size_t j = 0; j < blocks[i].second; ++j)
+			if (blocks[i].first[j] != (i & 0xff)) ok = false;
+	for (auto &b : blocks) leestl::thread_alloc::deallocate(b.first, b.second);
+	return ok;
+}
+
+// 多轮由一个线程分配、另一个线程检查内容后释放；同时存活的区块地址互不相同
+bool cross_thread_free(int rounds, size_t per_round) {
+	const size_t        sizes[] = {8, 24, 128, 200, 1024};
+	std::vector<void *> blocks(per_round);
+	bool                ok = true;
+	for (int r = 0; r < rounds; ++r) {
+		std::thread producer([&] {
+			for (size_t i = 0; i < per_round; ++i) {
+				const size_t n = sizes[i % 5];
+				blocks[i] = leestl::thread_alloc::allocate(n);
+				std::memset(blocks[i], int((i + r) & 0xff), n);
+			}
+		});
+		producer.join();
+		std::thread consumer([&] {
+			std::set<void *> seen(blocks.begin(), blocks.end());
+			if (seen.size() != per_round) ok = false;
+			for (size_t i = 0; i < per_round; ++i) {
+				const size_t n = sizes[i % 5];
+				const auto  *p = static_cast<const unsigned char *>(blocks[i]);
+				if (p[0] != ((i + r) & 0xff) || p[n - 1] != ((i + r) & 0xff)) ok = false;
+				leestl::thread_alloc::deallocate(blocks[i], n);
+			}
+		});
+		consumer.join();
+	}
+	return ok;
+}
+
+// 线程局部对象先于线程缓存构造完成，线程退出时在缓存之后析构，此时才释放区块
+struct late_release {
+	void *ptr = nullptr;
+	~late_release() { leestl::thread_alloc::deallocate(ptr, 1000); }
+};
+thread_local late_release late;
+
+// 之后还可以分配；释放的区块回到中心自由链表，被下一个取用这一级的线程拿到
+bool free_after_thread_exit() {
+	void *freed = nullptr;
+	std::thread worker([&freed] {
+		late_release &holder = late;
+		holder.ptr = leestl::thread_alloc::allocate(1000);    // 此时才构造线程缓存
+		freed = holder.ptr;
+	});
+	worker.join();
+	void *p = nullptr;
+	std::thread next([&p] {
+		p = leestl::thread_alloc::allocate(1000);
+		leestl::thread_alloc::deallocate(p, 1000);
+	});
+	next.join();
+	return p == freed;
+}
+
+// 当前进程占用的虚拟地址空间字节数
+size_t current_vm_bytes() {
+	unsigned long pages = 0;
+	FILE         *f = std::fopen("/proc/self/statm", "r");
+	if (f == nullptr) return 0;
+	if (std::fscanf(f, "%lu", &pages) != 1) pages = 0;
+	std::fclose(f);
+	return pages * size_t(sysconf(_SC_PAGESIZE));
+}
+
+// 向系统申请区块失败时 bad_alloc 传给调用者，中心自由链表的锁不会一直被持有：
+// 限制地址空间并耗尽堆使 malloc 失败，恢复之后本线程与其他线程仍能取用同一分级
+bool upstream_failure_releases_lock() {
+	const size_t bytes = 960;    // 其他测试未使用的分级，中心自由链表为空
+	leestl::thread_alloc::deallocate(leestl::thread_alloc::allocate(8), 8);    // 先构造线程缓存
+	std::vector<void *> filler;
+	filler.reserve(1 << 20);
+	rlimit old;
+	if (getrlimit(RLIMIT_AS, &old) != 0) return false;
+	rlimit tight = old;
+	tight.rlim_cur = current_vm_bytes();
+	if (tight.rlim_cur == 0 || setrlimit(RLIMIT_AS, &tight) != 0) return false;
+	while (filler.size() < filler.capacity())
+		if (void *p = std::malloc(4096)) filler.push_back(p);
+		else break;
+	bool threw = false;
+	try {
+		leestl::thread_alloc::deallocate(leestl::thread_alloc::allocate(bytes), bytes);
+	} catch (const std::bad_alloc &) {
+		threw = true;
+	}
+	setrlimit(RLIMIT_AS, &old);
+	for (void *p : filler) std::free(p);
+
+	// 锁未释放时下面的分配会一直自旋，等待超时即判定失败
+	std::atomic<int> done{0};
+	std::thread([&done, bytes] {
+		leestl::thread_alloc::deallocate(leestl::thread_alloc::allocate(bytes), bytes);
+		++done;
+	}).detach();
+	for (int i = 0; i < 500 && done.load() == 0; ++i)
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	if (done.load() == 0) return false;
+	leestl::thread_alloc::deallocate(leestl::thread_alloc::allocate(bytes), bytes);
+	return threw;
+}
+
+// 进程退出时全局容器在主线程的缓存之后析构
+leestl::vector<int, leestl::thread_cache_allocator<int>> global_vector;
+
+int main() {
+	cout << "\n[===================================================================]\n";
+	cout << "[------------------- thread_alloc test start ------------------->\n";
+	cout << "size classes: " << size_class::_NCLASSES << ", consistent "
+	     << (size_classes_consistent() ? "ok" : "FAIL") << endl;
+	const bool upstream_ok = upstream_failure_releases_lock();
+	cout << "upstream failure: " << (upstream_ok ? "ok" : "FAIL") << endl;
+	if (!upstream_ok) std::_Exit(1);    // 锁可能仍被持有，其他测试会卡住
+	cout << "boundary sizes: " << (boundary_blocks_intact() ? "ok" : "FAIL") << endl;
+	cout << "cross-thread free: " << (cross_thread_free(20, 5000) ? "ok" : "FAIL") << endl;
+	cout << "free after thread exit: " << (free_after_thread_exit() ? "ok" : "FAIL") << endl;
+	for (int i = 0; i < 100; ++i) global_vector.push_back(i);
+	cout << "global vector size " << global_vector.size() << endl;
+	cout << ">------------------- thread_alloc test end ------------------]\n";
+	return 0;
+}
@@ -10,15 +10,22 @@
  */
 
 #include <iostream>
+#include <string>
 #include <vector>
 
+#include "../LeeSTL/alloc.h"
+#include "../LeeSTL/memory_resource.h"
 #include "../LeeSTL/vector.h"
+#include "test_util.h"
 
 template <
     typename Vec,
     typename = std::enable_if_t<
-        std::is_same_v<Vec, leestl::vector<typename Vec::value_type>> ||
-        std::is_same_v<Vec, std::vector<typename Vec::value_type>>>>
+        std::is_same_v<
+            Vec, leestl::vector<
+                     typename Vec::value_type, typename Vec::allocator_type,
+                     typename Vec::growth_policy>> ||
+        std::is_same_v<Vec, std::vector<typename Vec::value_type, typename Vec::allocator_type>>>>
 std::ostream &operator<<(std::ostream &os, const Vec &v) {
 	for (auto &i : v) { os << i << " "; }
 	os << std::endl;
@@ -28,6 +35,45 @@ std::ostream &operator<<(std::ostream &os, const Vec &v) {
 using std::cout;
 using std::endl;
 
+// 持有堆上的 int，移动构造与析构都会计数；声明为可平凡重定位，vector 扩容时应整段 memcpy
+struct heap_int {
+	static inline int moves = 0;
+	static inline int destroys = 0;
+	int              *ptr;
+
+	explicit heap_int(int v) : ptr(new int(v)) {}
+	heap_int(const heap_int &x) : ptr(new int(*x.ptr)) {}
+	heap_int(heap_int &&x) noexcept : ptr(x.ptr) {
+		x.ptr = nullptr;
+		++moves;
+	}
+	~heap_int() {
+		delete ptr;
+		++destroys;
+	}
+	heap_int &operator=(heap_int x) noexcept {
+		std::swap(ptr, x.ptr);
+		return *this;
+	}
+};
+
+LEESTL_TRIVIALLY_RELOCATABLE(heap_int)
+
+// 保存指向自身的指针，不能按字节重定位，vector 扩容时只能逐个移动构造
+struct self_ref {
+	static inline int moves = 0;
+	int               value;
+	self_ref         *self;
+
+	explicit self_ref(int v) : value(v), self(this) {}
+	self_ref(const self_ref &x) : value(x.value), self(this) {}
+	self_ref(self_ref &&x) noexcept : value(x.value), self(this) { ++moves; }
+	self_ref &operator=(const self_ref &x) {
+		value = x.value;
+		return *this;
+	}
+};
+
 template <typename T>
 void rcout(leestl::vector<T> &v) {
 	for (auto it = v.rbegin(); it != v.rend(); ++it) { cout << *it << " "; }
@@ -58,15 +104,132 @@ int main() {
 	cout << "v9: " << v9;
 	cout << "v10: " << v10;
 
-	leestl::vector<int> v11(leestl::move(v10));    // 移动构造使用默认构造函数，并未进行移动
+	leestl::vector<int> v11(leestl::move(v10));    // 移动构造接管了 v10 的空间
 	cout << "v10: " << v10;
 	cout << "v11: " << v11;
 
 	cout << "v4-reverse_iterator: ";
 	rcout(v4);
 
+	leestl::vector<int> v12;
+	for (int i = 0; i < 5; ++i) v12.push_back(i);
+	v12.emplace_back(5);
+	v12.emplace(v12.begin() + 1, 10);
+	v12.pop_back();
+	cout << "v12: " << v12;
+	cout << "v12 front/back/at(2): " << v12.front() << " " << v12.back() << " " << v12.at(2)
+	     << endl;
+	try {
+		v12.at(100);
+	} catch (const std::out_of_range &) { cout << "v12.at(100): out_of_range" << endl; }
+
+	v12.reserve(100);
+	cout << "v12 reserve(100) size/capacity: " << v12.size() << " " << v12.capacity() << endl;
+	v12.resize(8);
+	cout << "v12 resize(8): " << v12;
+	v12.resize(10, 7);
+	cout << "v12 resize(10, 7): " << v12;
+	v12.resize(3);
+	v12.shrink_to_fit();
+	cout << "v12 resize(3), shrink_to_fit size/capacity: " << v12.size() << " "
+	     << v12.capacity() << endl;
+	v12.clear();
+	cout << "v12 clear empty: " << v12.empty() << endl;
+
+	leestl::vector<std::string> v13;
+	for (int i = 0; i < 4; ++i) v13.emplace_back(3, char('a' + i));
+	v13.push_back(v13[0]);    // 扩容时参数引用的是旧空间中的元素
+	cout << "v13: " << v13;
+
+	leestl::vector<int, leestl::allocator<int>, leestl::growth_factor_1_5> v14;
+	cout << "v14 capacity(1.5x):";
+	for (int i = 0; i < 20; ++i) {
+		size_t cap = v14.capacity();
+		v14.push_back(i);
+		if (v14.capacity() != cap) cout << " " << v14.capacity();
+	}
+	cout << endl;
+
 	cout << ">------------------- API test end -------------------]\n";
 
+	cout << "[------------------- allocator test start------------------->\n";
+	leestl::vector<int, leestl::pool_allocator<int>> pv1(5, 7), pv2(pv1);
+	pv2.insert(pv2.begin() + 2, 3, 1);
+	cout << "pv1: " << pv1;
+	cout << "pv2: " << pv2;
+
+	typedef leestl::vector<int, tagged_allocator<int>> tvector;
+	tvector tv1({1, 2, 3}, tagged_allocator<int>(1)), tv2(tagged_allocator<int>(2));
+	tv2 = leestl::move(tv1);    // 配置器不相等且不传播，逐个移动元素
+	cout << "tv2(id " << tv2.get_allocator().id << "): " << tv2;
+	tvector tv3(3, 9, tagged_allocator<int>(3));
+	tv2.swap(tv3);    // propagate_on_container_swap 为真，配置器随之交换
+	cout << "tv2(id " << tv2.get_allocator().id << "): " << tv2;
+	cout << "tv3(id " << tv3.get_allocator().id << "): " << tv3;
+	leestl::stack_buffer_resource<256>                      arena;
+	leestl::vector<int, leestl::arena_allocator<int>> av1(4, 6, arena), av2(av1, arena);
+	av2.insert(av2.end(), 100, 8);    // 超出栈上缓冲区，向上游申请新块
+	const int more[] = {1, 2, 3};
+	av1.insert(av1.begin() + 2, input_iterator<int>(more), input_iterator<int>(more + 3));
+	cout << "av1: " << av1;
+	cout << "av2.size(): " << av2.size() << ", arena upstream bytes: " << arena.upstream_bytes()
+	     << endl;
+	// 反复填满再 release，每一轮向上游申请的字节数应与第一轮相同
+	leestl::stack_buffer_resource<256> cycle_stack;
+	leestl::monotonic_buffer_resource  cycle_heap(128);
+	size_t first_stack = 0, first_heap = 0;
+	bool   bounded = true;
+	for (int round = 0; round < 20; ++round) {
+		for (int i = 0; i < 200; ++i) {
+			cycle_stack.allocate(40);
+			cycle_heap.allocate(40);
+		}
+		if (round == 0) {
+			first_stack = cycle_stack.upstream_bytes();
+			first_heap = cycle_heap.upstream_bytes();
+		}
+		bounded = bounded && cycle_stack.upstream_bytes() == first_stack &&
+		          cycle_heap.upstream_bytes() == first_heap;
+		cycle_stack.release();
+		cycle_heap.release();
+	}
+	cout << "fill/release cycles upstream bytes: " << first_stack << ", " << first_heap
+	     << (bounded ? " ok" : " FAILED") << endl;
+	cout << "sizeof(leestl::vector<int>): " << sizeof(leestl::vector<int>) << endl;
+	cout << ">------------------- allocator test end -------------------]\n";
+
+	cout << "[------------------- relocate test start------------------->\n";
+	cout << "is_trivially_relocatable: int " << leestl::is_trivially_relocatable_v<int>
+	     << ", leestl::vector<int> " << leestl::is_trivially_relocatable_v<leestl::vector<int>>
+	     << ", leestl::vector<std::string> "
+	     << leestl::is_trivially_relocatable_v<leestl::vector<std::string>>
+	     << ", std::string " << leestl::is_trivially_relocatable_v<std::string> << ", heap_int "
+	     << leestl::is_trivially_relocatable_v<heap_int> << ", self_ref "
+	     << leestl::is_trivially_relocatable_v<self_ref> << endl;
+	{
+		leestl::vector<heap_int> hv;
+		for (int i = 0; i < 1000; ++i) hv.emplace_back(i);
+		hv.insert(hv.begin() + 10, 3000, heap_int(-1));    // _fill_insert 重新分配
+		bool ok = heap_int::moves == 0 && heap_int::destroys == 1 && hv.size() == 4000;
+		for (int i = 0; i < 1000; ++i) ok = ok && *hv[i < 10 ? i : i + 3000].ptr == i;
+		cout << "heap_int grows by memcpy: " << (ok ? "ok" : "FAILED") << endl;
+	}
+	{
+		leestl::vector<self_ref> sv;
+		for (int i = 0; i < 1000; ++i) sv.emplace_back(i);
+		bool ok = self_ref::moves > 0;
+		for (int i = 0; i < 1000; ++i) ok = ok && sv[i].value == i && sv[i].self == &sv[i];
+		cout << "self_ref grows element by element: " << (ok ? "ok" : "FAILED") << endl;
+	}
+	{
+		leestl::vector<leestl::vector<std::string>> vv;
+		for (int i = 0; i < 100; ++i) vv.push_back(leestl::vector<std::string>(3, std::to_string(i)));
+		bool ok = true;
+		for (int i = 0; i < 100; ++i) ok = ok && vv[i].size() == 3 && vv[i][2] == std::to_string(i);
+		cout << "vector<vector<std::string>> grows: " << (ok ? "ok" : "FAILED") << endl;
+	}
+	cout << ">------------------- relocate test end -------------------]\n";
+
 	cout << ">---------------------- vector test end ----------------------]\n";
 	return 0;
 }
\ No newline at end of file
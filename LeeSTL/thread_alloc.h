@@ -0,0 +1,270 @@
+/** @file thread_alloc.h
+ * 	这个文件实现 tcmalloc 风格的线程缓存配置器
+ *
+ * 	每个线程持有按尺寸分级的自由链表缓存，分配、释放在缓存命中时完全无锁；
+ * 	缓存为空时从中心自由链表批量取回一组区块，缓存过长时再批量归还。
+ * 	一个线程释放另一个线程分配的区块时，区块进入释放线程的缓存，
+ * 	溢出部分经中心自由链表回到其他线程，因此跨线程释放无需额外同步。
+ */
+
+#ifndef _LEESTL_THREAD_ALLOC_H_
+#define _LEESTL_THREAD_ALLOC_H_ 1
+
+#include <atomic>
+
+#include "alloc.h"
+
+namespace leestl {
+
+	// 尺寸分级：不超过 128 字节时以 8 字节为粒度，128 ~ 1024 字节以 64 字节为粒度
+	struct _size_class {
+		enum { _SMALL_MAX = 128, _SMALL_ALIGN = 8 };
+		enum { _MAX_BYTES = 1024, _LARGE_ALIGN = 64 };
+		enum {
+			_NSMALL = _SMALL_MAX / _SMALL_ALIGN,
+			_NCLASSES = _NSMALL + (_MAX_BYTES - _SMALL_MAX) / _LARGE_ALIGN
+		};
+
+		// 尺寸对应的分级编号
+		static size_t index(size_t bytes) {
+			if (bytes <= size_t(_SMALL_MAX)) return (bytes + _SMALL_ALIGN - 1) / _SMALL_ALIGN - 1;
+			return _NSMALL + (bytes - _SMALL_MAX + _LARGE_ALIGN - 1) / _LARGE_ALIGN - 1;
+		}
+
+		// 分级对应的区块大小
+		static size_t size(size_t cls) {
+			if (cls < size_t(_NSMALL)) return (cls + 1) * _SMALL_ALIGN;
+			return _SMALL_MAX + (cls - _NSMALL + 1) * _LARGE_ALIGN;
+		}
+
+		// 线程缓存与中心自由链表之间一次搬运的区块数，小区块多搬、大区块少搬
+		static int batch(size_t cls) {
+			size_t n = 8192 / size(cls);
+			return n < 4 ? 4 : (n > 64 ? 64 : int(n));
+		}
+	};
+
+	// 自由链表节点
+	struct _free_obj {
+		_free_obj *next;
+	};
+
+	// 自旋等待时提示 CPU 降低功耗、让出流水线
+	inline void _cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#elif defined(__aarch64__)
+		asm volatile("yield");
+#endif
+	}
+
+	// 基于 atomic_flag 的自旋锁，中心自由链表的临界区很短
+	class _spin_lock {
+	private:
+		std::atomic_flag _flag = ATOMIC_FLAG_INIT;
+
+	public:
+		void lock() noexcept {
+			while (_flag.test_and_set(std::memory_order_acquire)) _cpu_relax();
+		}
+		void unlock() noexcept { _flag.clear(std::memory_order_release); }
+	};
+
+	// 某一尺寸分级的中心自由链表，所有线程共享
+	class _central_free_list {
+	private:
+		enum { _SPAN_BYTES = 64 * 1024 };    // 链表为空时一次向系统申请的大小
+
+		_spin_lock _lock;
+		_free_obj *_head = nullptr;
+		size_t     _length = 0;
+
+		// 链表为空时一次申请的字节数，至少容纳 64 个区块
+		static size_t _span_bytes(size_t obj_size) noexcept {
+			return obj_size * 64 > size_t(_SPAN_BYTES) ? obj_size * 64 : size_t(_SPAN_BYTES);
+		}
+
+		// 把向系统申请的一段空间切割为 obj_size 大小的区块并挂入链表，调用者持有锁
+		void _populate(char *span, size_t obj_size) noexcept {
+			size_t n = _span_bytes(obj_size) / obj_size;
+			for (size_t i = 0; i < n; ++i) {
+				_free_obj *obj = reinterpret_cast<_free_obj *>(span + i * obj_size);
+				obj->next = _head;
+				_head = obj;
+			}
+			_length += n;
+		}
+
+	public:
+		// 取出至多 n 个区块，返回链表头，实际数量写入 n
+		_free_obj *remove_range(int &n, size_t obj_size) {
+			_lock.lock();
+			if (_head == nullptr) {
+				// 申请空间可能抛出 bad_alloc，在锁外申请，避免异常离开时锁仍被持有
+				_lock.unlock();
+				char *span = static_cast<char *>(malloc_alloc::allocate(_span_bytes(obj_size)));
+				_lock.lock();
+				_populate(span, obj_size);
+			}
+			_free_obj *first = _head, *last = _head;
+			int        count = 1;
+			while (count < n && last->next != nullptr) {
+				last = last->next;
+				++count;
+			}
+			_head = last->next;
+			_length -= count;
+			_lock.unlock();
+
+			last->next = nullptr;
+			n = count;
+			return first;
+		}
+
+		// 归还一段以 first 开头、last 结尾、共 n 个区块的链表
+		void insert_range(_free_obj *first, _free_obj *last, int n) {
+			_lock.lock();
+			last->next = _head;
+			_head = first;
+			_length += n;
+			_lock.unlock();
+		}
+	};
+
+	/**
+	 * @brief 线程缓存，每个线程一个，析构时（线程退出）把缓存的区块全部还给中心自由链表
+	 *
+	 * 	线程退出时，先于缓存构造完成的线程局部对象在缓存之后析构，它们释放（或再分配）
+	 * 	的区块不能再进入已析构的缓存；此时 destroyed() 为真，thread_alloc 改为每次直接与
+	 * 	中心自由链表交换单个区块
+	 */
+	class _thread_cache {
+	private:
+		struct _free_list {
+			_free_obj *head = nullptr;
+			int        length = 0;
+			int        max_length = 1;    // 慢启动：随取回次数增长，上限为若干批
+		};
+
+		_free_list _lists[_size_class::_NCLASSES];
+
+		static _central_free_list *_central() {
+			static _central_free_list lists[_size_class::_NCLASSES];
+			return lists;
+		}
+
+		// 本线程的缓存是否已析构；bool 无需析构，线程退出的整个过程中都可以访问
+		static bool &_destroyed_flag() noexcept {
+			thread_local bool destroyed = false;
+			return destroyed;
+		}
+
+		// 缓存为空，从中心自由链表取回一批
+		void *_fetch(size_t cls) {
+			_free_list &list = _lists[cls];
+			const int   batch = _size_class::batch(cls);
+			int         n = list.max_length < batch ? list.max_length : batch;
+
+			_free_obj *first = _central()[cls].remove_range(n, _size_class::size(cls));
+			list.head = first->next;
+			list.length = n - 1;
+			if (list.max_length < batch) ++list.max_length;
+			else if (list.max_length < 4 * batch) list.max_length += batch;
+			return first;
+		}
+
+		// 缓存超过上限，归还一批给中心自由链表
+		void _release(size_t cls, int n) {
+			_free_list &list = _lists[cls];
+			_free_obj  *first = list.head, *last = list.head;
+			for (int i = 1; i < n; ++i) last = last->next;
+			list.head = last->next;
+			list.length -= n;
+			_central()[cls].insert_range(first, last, n);
+		}
+
+		// 缓存长度超过上限，归还至多一批，并按慢启动规则放宽上限
+		void _list_too_long(size_t cls) {
+			_free_list &list = _lists[cls];
+			const int   batch = _size_class::batch(cls);
+			_release(cls, list.length < batch ? list.length : batch);
+			if (list.max_length < batch) ++list.max_length;
+		}
+
+	public:
+		_thread_cache() { _central(); }    // 保证中心自由链表先于线程缓存构造、后于其析构
+
+		~_thread_cache() {
+			_destroyed_flag() = true;
+			for (size_t cls = 0; cls < size_t(_size_class::_NCLASSES); ++cls)
+				if (_lists[cls].length > 0) _release(cls, _lists[cls].length);
+		}
+
+		void *allocate(size_t cls) {
+			_free_list &list = _lists[cls];
+			_free_obj  *obj = list.head;
+			if (__builtin_expect(obj == nullptr, false)) return _fetch(cls);
+			list.head = obj->next;
+			--list.length;
+			return obj;
+		}
+
+		void deallocate(void *ptr, size_t cls) {
+			_free_list &list = _lists[cls];
+			_free_obj  *obj = static_cast<_free_obj *>(ptr);
+			obj->next = list.head;
+			list.head = obj;
+			if (__builtin_expect(++list.length > list.max_length, false)) _list_too_long(cls);
+		}
+
+		static _thread_cache &get() {
+			thread_local _thread_cache cache;
+			return cache;
+		}
+
+		static bool destroyed() noexcept { return _destroyed_flag(); }
+
+		// 缓存已析构时从中心自由链表取出一个区块
+		static void *central_allocate(size_t cls) {
+			int n = 1;
+			return _central()[cls].remove_range(n, _size_class::size(cls));
+		}
+
+		// 缓存已析构时把一个区块直接还给中心自由链表
+		static void central_deallocate(void *ptr, size_t cls) {
+			_free_obj *obj = static_cast<_free_obj *>(ptr);
+			_central()[cls].insert_range(obj, obj, 1);
+		}
+	};
+
+	/**
+	 * @brief 线程缓存字节配置器，接口与 leestl::alloc 一致，
+	 * 	超过 1024 字节的区块直接交给第一级配置器
+	 */
+	class thread_alloc {
+	public:
+		static void *allocate(size_t n) {
+			if (n > size_t(_size_class::_MAX_BYTES)) return malloc_alloc::allocate(n);
+			const size_t cls = _size_class::index(n == 0 ? 1 : n);
+			if (__builtin_expect(_thread_cache::destroyed(), false))
+				return _thread_cache::central_allocate(cls);
+			return _thread_cache::get().allocate(cls);
+		}
+
+		static void deallocate(void *ptr, size_t n) {
+			if (ptr == nullptr) return;
+			if (n > size_t(_size_class::_MAX_BYTES)) return malloc_alloc::deallocate(ptr, n);
+			const size_t cls = _size_class::index(n == 0 ? 1 : n);
+			if (__builtin_expect(_thread_cache::destroyed(), false))
+				_thread_cache::central_deallocate(ptr, cls);
+			else _thread_cache::get().deallocate(ptr, cls);
+		}
+	};
+
+	// 使用线程缓存配置器的对象配置器，如 leestl::vector<int, leestl::thread_cache_allocator<int>>
+	template <typename T>
+	using thread_cache_allocator = pool_allocator<T, thread_alloc>;
+
+}    // namespace leestl
+
+#endif
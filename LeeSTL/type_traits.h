@@ -33,6 +33,29 @@ namespace leestl {
 	template <typename T>
 	constexpr bool is_byte_v = std::disjunction_v<
 	    std::is_same<T, char>, std::is_same<T, signed char>, std::is_same<T, unsigned char> >;
+
+	/**
+	 * @brief 判断类型能否“平凡重定位”，即移动构造到新地址再析构旧对象等价于按字节复制。
+	 * 	平凡可复制的类型默认满足；只持有堆指针、不含自引用的类型（如多数 string、vector 实现）
+	 * 	也满足，但无法自动推断，需要使用 LEESTL_TRIVIALLY_RELOCATABLE 显式声明
+	 *
+	 * @tparam T 要判断的类型
+	 */
+	template <typename T>
+	struct is_trivially_relocatable
+	    : std::integral_constant<
+	          bool, std::is_trivially_move_constructible<T>::value &&
+	                    std::is_trivially_destructible<T>::value> {};
+
+	template <typename T>
+	constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
 }    // namespace leestl
 
+// 声明用户类型可平凡重定位，需在全局命名空间中使用，例如 LEESTL_TRIVIALLY_RELOCATABLE(MyString)
+#define LEESTL_TRIVIALLY_RELOCATABLE(...)                                             \
+	namespace leestl {                                                                \
+		template <>                                                                   \
+		struct is_trivially_relocatable<__VA_ARGS__> : std::true_type {};             \
+	}
+
 #endif
@@ -49,8 +49,29 @@ namespace leestl {
 		    std::is_trivially_copy_assignable<typename iterator_traits<_FI>::value_type>{});
 	}
 
+	// 平凡类型的移动构造即复制
+	template <typename _II, typename _FI>
+	_FI _unchecked_uninit_move(_II first, _II last, _FI result, std::true_type) {
+		return leestl::copy(first, last, result);
+	}
+
+	// 逐个调用移动构造函数
+	template <typename _II, typename _FI>
+	_FI _unchecked_uninit_move(_II first, _II last, _FI result, std::false_type) {
+		auto curr = result;
+		try {
+			for (; first != last; ++first, (void)++curr)
+				leestl::construct(leestl::address_of(*curr), leestl::move(*first));
+			return curr;
+		} catch (...) {
+			leestl::destory(result, curr);
+			throw;
+		}
+	}
+
 	/**
-	 * @brief 移动（复制）构造方法，把 [first, last) 上的内容移动复制到以 result 为起始处的空间
+	 * @brief 移动构造方法，把 [first, last) 上的内容移动到以 result 为起始处的未初始化空间，
+	 * 	原对象处于“已被移动”的状态，仍需由调用者析构
 	 *
 	 * @tparam _II 原始空间的迭代器类型
 	 * @tparam _FI 目标空间的迭代器类型
@@ -61,7 +82,9 @@ namespace leestl {
 	 */
 	template <typename _II, typename _FI>
 	inline _FI uninitialized_move(_II first, _II last, _FI result) {
-		return uninitialized_copy(first, last, result);
+		return leestl::_unchecked_uninit_move(
+		    first, last, result,
+		    std::is_trivially_copy_assignable<typename iterator_traits<_FI>::value_type>{});
 	}
 
 	// 可直接使用 fill 的 unchecked_uninit_fill 实现
@@ -142,8 +165,27 @@ namespace leestl {
 		leestl::destory(leestl::address_of(*orig));
 	}
 
+	// 逐个移动并析构的 relocate 实现
+	template <typename _II, typename _FI>
+	inline _FI _relocate(_II first, _II last, _FI result, std::false_type) {
+		_FI curr = result;
+		for (; first != last; ++first, (void)++curr)
+			leestl::_relocate_object(leestl::address_of(*curr), leestl::address_of(*first));
+		return curr;
+	}
+
+	// 针对可平凡重定位类型的 relocate 实现，整段按字节复制，旧对象无需析构
+	template <typename T>
+	inline T *_relocate(T *first, T *last, T *result, std::true_type) {
+		const ptrdiff_t n = last - first;
+		if (n > 0)
+			__builtin_memmove(
+			    static_cast<void *>(result), static_cast<const void *>(first), n * sizeof(T));
+		return result + n;
+	}
+
 	/**
-	 * @brief 移动构造方法，把 [first, last) 上的内容移动到以 result 为起始处的空间
+	 * @brief 移动构造方法，把 [first, last) 上的内容移动到以 result 为起始处的空间，并析构原对象
 	 *
 	 * @tparam _II 原始空间的迭代器类型
 	 * @tparam _FI 目标空间的迭代器类型
@@ -160,11 +202,11 @@ namespace leestl {
 		    std::is_same<type1, type2>::value,
 		    "relocation is only possible for values of the same type");
 
-		_FI curr = result;
-		for (; first != last; ++first, (void)++curr)
-			leestl::_relocate_object(leestl::address_of(*curr), leestl::address_of(*first));
-
-		return curr;
+		return leestl::_relocate(
+		    first, last, result,
+		    std::integral_constant<
+		        bool, std::is_pointer<_II>::value && std::is_pointer<_FI>::value &&
+		                  leestl::is_trivially_relocatable<type1>::value>());
 	}
 
 }    // namespace leestl
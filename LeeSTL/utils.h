@@ -57,6 +57,21 @@ namespace leestl {
 		return &value;
 	}
 
+	/**
+	 * @brief 交换两个对象的值
+	 *
+	 * @tparam T 对象类型
+	 * @param a 第一个对象
+	 * @param b 第二个对象
+	 */
+	template <typename T>
+	inline void swap(T &a, T &b) noexcept(
+	    std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value) {
+		T tmp = leestl::move(a);
+		a = leestl::move(b);
+		b = leestl::move(tmp);
+	}
+
 }    // namespace leestl
 
 #endif
@@ -6,7 +6,9 @@
 #define _LEESTL_VECTOR_H_
 
 #include <initializer_list>
+#include <stdexcept>
 
+#include "alloc_traits.h"
 #include "allocator.h"
 #include "iterator_base_types.h"
 #include "utils.h"
@@ -14,49 +16,106 @@
 #include "algo.h"
 
 namespace leestl {
-	template <typename T>
+
+	/**
+	 * @brief vector 的 2 倍增长策略：给出当前元素个数 size 与至少需要追加的个数 n，返回新容量
+	 */
+	struct growth_factor_2 {
+		constexpr size_t operator()(size_t size, size_t n) const noexcept {
+			return size + leestl::max(size, n);
+		}
+	};
+
+	/**
+	 * @brief vector 的 1.5 倍增长策略，释放的旧空间有机会被之后的扩容复用
+	 */
+	struct growth_factor_1_5 {
+		constexpr size_t operator()(size_t size, size_t n) const noexcept {
+			return size + leestl::max(size / 2, n);
+		}
+	};
+
+	template <
+	    typename T, typename Alloc = leestl::allocator<T>,
+	    typename GrowthPolicy = leestl::growth_factor_2>
 	class vector {
 		static_assert(!std::is_same<bool, T>::value, "leestl's vector can't support bool!");
 
 	public:
-		typedef leestl::allocator<T> allocator_type;    // 配置器类型
-		typedef leestl::allocator<T> data_allocator;
+		typedef Alloc        allocator_type;    // 配置器类型
+		typedef GrowthPolicy growth_policy;     // 扩容策略
+		typedef typename leestl::allocator_traits<Alloc>::template rebind_alloc<T> data_allocator;
+
+	private:
+		typedef leestl::allocator_traits<data_allocator> _alloc_traits;
 
-		typedef typename allocator_type::value_type      value_type;
-		typedef typename allocator_type::size_type       size_type;
-		typedef typename allocator_type::difference_type difference_type;
-		typedef typename allocator_type::pointer         pointer;
-		typedef typename allocator_type::const_pointer   const_pointer;
-		typedef typename allocator_type::reference       reference;
-		typedef typename allocator_type::const_reference const_reference;
+	public:
+		typedef T                                       value_type;
+		typedef typename _alloc_traits::size_type       size_type;
+		typedef typename _alloc_traits::difference_type difference_type;
+		typedef typename _alloc_traits::pointer         pointer;
+		typedef const value_type*                       const_pointer;
+		typedef value_type&                             reference;
+		typedef const value_type&                       const_reference;
 
 		typedef value_type*                              iterator;
 		typedef const value_type*                        const_iterator;
 		typedef leestl::reverse_iterator<iterator>       reverse_iterator;
 		typedef leestl::reverse_iterator<const_iterator> const_reverse_iterator;
 
-		allocator_type get_allocator() { return data_allocator(); }
+		allocator_type get_allocator() const noexcept { return allocator_type(_get_alloc()); }
 
 	private:
-		iterator start;             // 当前已使用空间的起始点
-		iterator finish;            // 当前已使用空间的终止点
-		iterator end_of_storage;    // 已申请空间的尾部
+		// 继承配置器以利用空基类优化，无状态配置器不占用额外空间
+		struct _vector_impl : public data_allocator {
+			iterator start;             // 当前已使用空间的起始点
+			iterator finish;            // 当前已使用空间的终止点
+			iterator end_of_storage;    // 已申请空间的尾部
+
+			_vector_impl() noexcept(std::is_nothrow_default_constructible<data_allocator>::value) :
+			        data_allocator(), start(), finish(), end_of_storage() {}
+			_vector_impl(const data_allocator& a) noexcept :
+			        data_allocator(a), start(), finish(), end_of_storage() {}
+			_vector_impl(data_allocator&& a) noexcept :
+			        data_allocator(leestl::move(a)), start(), finish(), end_of_storage() {}
+
+			// 交换数据指针，不交换配置器
+			void _swap_data(_vector_impl& x) noexcept {
+				leestl::swap(start, x.start);
+				leestl::swap(finish, x.finish);
+				leestl::swap(end_of_storage, x.end_of_storage);
+			}
+		};
+
+		_vector_impl _impl;
+
+		data_allocator&       _get_alloc() noexcept { return _impl; }
+		const data_allocator& _get_alloc() const noexcept { return _impl; }
 
 	public:
 		/**
 		 * @brief vector 默认构造函数
 		 *
 		 */
-		vector() noexcept : start(), finish(), end_of_storage() {};
+		vector() = default;
+
+		/**
+		 * @brief 指定配置器的 vector 构造函数
+		 *
+		 * @param alloc 配置器
+		 */
+		explicit vector(const allocator_type& alloc) noexcept : _impl(data_allocator(alloc)) {}
 
 		/**
 		 * @brief 给出 大小的 vector 构造函数
 		 *
 		 * @param n    vector 的大小
+		 * @param alloc 配置器
 		 */
-		explicit vector(size_type n) {
+		explicit vector(size_type n, const allocator_type& alloc = allocator_type()) :
+		        _impl(data_allocator(alloc)) {
 			_create_storage(_check_init_len(n));
-			finish = uninitialized_fill_n(start, n, value_type());
+			_impl.finish = leestl::uninitialized_fill_n(_impl.start, n, value_type());
 		}
 
 		/**
@@ -64,26 +123,56 @@ namespace leestl {
 		 *
 		 * @param n vector 的大小
 		 * @param value 初始化值
+		 * @param alloc 配置器
 		 */
-		vector(size_type n, const value_type& value) {
+		vector(size_type n, const value_type& value, const allocator_type& alloc = allocator_type()) :
+		        _impl(data_allocator(alloc)) {
 			_create_storage(_check_init_len(n));
-			finish = uninitialized_fill_n(start, n, value);
+			_impl.finish = leestl::uninitialized_fill_n(_impl.start, n, value);
 		}
 
 		/**
-		 * @brief 复制构造函数
+		 * @brief 复制构造函数，配置器由 select_on_container_copy_construction 决定
 		 *
 		 * @param x 要复制的 vector
 		 */
-		vector(const vector& x) {
+		vector(const vector& x) :
+		        _impl(_alloc_traits::select_on_container_copy_construction(x._get_alloc())) {
 			_create_storage(x.size());
-			finish = uninitialized_copy(x.begin(), x.end(), start);
+			_impl.finish = leestl::uninitialized_copy(x.begin(), x.end(), _impl.start);
 		}
 
 		/**
-		 * @brief 移动构造函数
+		 * @brief 指定配置器的复制构造函数
+		 *
+		 * @param x 要复制的 vector
+		 * @param alloc 配置器
 		 */
-		vector(vector&&) noexcept = default;
+		vector(const vector& x, const allocator_type& alloc) : _impl(data_allocator(alloc)) {
+			_create_storage(x.size());
+			_impl.finish = leestl::uninitialized_copy(x.begin(), x.end(), _impl.start);
+		}
+
+		/**
+		 * @brief 移动构造函数，接管 x 的空间与配置器
+		 */
+		vector(vector&& x) noexcept : _impl(leestl::move(x._get_alloc())) { _impl._swap_data(x._impl); }
+
+		/**
+		 * @brief 指定配置器的移动构造函数，配置器不相等时只能逐个移动元素
+		 *
+		 * @param x 要移动的 vector
+		 * @param alloc 配置器
+		 */
+		vector(vector&& x, const allocator_type& alloc) : _impl(data_allocator(alloc)) {
+			if (_alloc_traits::equal(_get_alloc(), x._get_alloc())) {
+				_impl._swap_data(x._impl);
+			} else if (!x.empty()) {
+				_create_storage(x.size());
+				_impl.finish = leestl::uninitialized_move(x.begin(), x.end(), _impl.start);
+				x.clear();
+			}
+		}
 
 		/**
 		 * @brief 通过初始化列表构造 vector
@@ -91,7 +180,8 @@ namespace leestl {
 		 * @param il  初始化列表
 		 * @param alloc 配置器
 		 */
-		vector(std::initializer_list<value_type> il) {
+		vector(std::initializer_list<value_type> il, const allocator_type& alloc = allocator_type()) :
+		        _impl(data_allocator(alloc)) {
 			_range_initialize(il.begin(), il.end(), leestl::random_acess_interator_tag());
 		}
 
@@ -105,7 +195,8 @@ namespace leestl {
 		 * @param alloc
 		 */
 		template <typename _II, typename = leestl::RequireInputIterator<_II>>
-		vector(_II first, _II last) {
+		vector(_II first, _II last, const allocator_type& alloc = allocator_type()) :
+		        _impl(data_allocator(alloc)) {
 			_range_initialize(first, last, leestl::iterator_category_types<_II>());
 		}
 
@@ -113,41 +204,55 @@ namespace leestl {
 		 * @brief 析构函数
 		 */
 		~vector() noexcept {
-			leestl::destory(start, finish);
-			data_allocator::deallocate(start, capacity());
+			leestl::destory(_impl.start, _impl.finish);
+			_deallocate(_impl.start, capacity());
 		}
 
 		// 赋值操作符
-		// 复制赋值
+		// 复制赋值，propagate_on_container_copy_assignment 为真时同时复制配置器
 		vector& operator=(const vector& x) {
 			if (this != &x) {
+				if constexpr (_alloc_traits::propagate_on_container_copy_assignment::value) {
+					if (!_alloc_traits::equal(_get_alloc(), x._get_alloc())) {
+						// 旧配置器无法释放新配置器分配的空间，先用旧配置器释放全部空间
+						clear();
+						_deallocate(_impl.start, capacity());
+						_impl.start = _impl.finish = _impl.end_of_storage = nullptr;
+					}
+					_get_alloc() = x._get_alloc();
+				}
 				const size_type len = x.size();
 				if (len > capacity()) {
 					pointer new_start = _alloc_and_copy(len, x.begin(), x.end());
-					leestl::destory(start, finish);
-					data_allocator::deallocate(start, capacity());
-					start = new_start;
-					end_of_storage = start + len;
+					leestl::destory(_impl.start, _impl.finish);
+					_deallocate(_impl.start, capacity());
+					_impl.start = new_start;
+					_impl.end_of_storage = _impl.start + len;
 				} else if (len <= size()) {
-					leestl::destory(leestl::copy(x.begin(), x.end(), start), finish);
+					leestl::destory(leestl::copy(x.begin(), x.end(), _impl.start), _impl.finish);
 				} else {
-					leestl::copy(x.begin(), x.begin() + size(), start);
-					uninitialized_copy(x.begin() + size(), x.end(), finish);
+					leestl::copy(x.begin(), x.begin() + size(), _impl.start);
+					leestl::uninitialized_copy(x.begin() + size(), x.end(), _impl.finish);
 				}
-				finish = start + len;
+				_impl.finish = _impl.start + len;
 			}
 			return *this;
 		}
 
-		// 移动赋值
-		vector& operator=(vector&& x) noexcept {
+		// 移动赋值，配置器可传播或相等时直接接管空间，否则逐个移动元素
+		vector& operator=(vector&& x) noexcept(
+		    _alloc_traits::propagate_on_container_move_assignment::value ||
+		    _alloc_traits::is_always_equal::value) {
 			if (this != &x) {
-				leestl::destory(start, finish);
-				data_allocator::deallocate(start, capacity());
-				start = x.start;
-				finish = x.finish;
-				end_of_storage = x.end_of_storage;
-				x.start = x.finish = x.end_of_storage = nullptr;
+				if constexpr (_alloc_traits::propagate_on_container_move_assignment::value) {
+					_move_assign(x);
+					_get_alloc() = leestl::move(x._get_alloc());
+				} else if (_alloc_traits::equal(_get_alloc(), x._get_alloc())) {
+					_move_assign(x);
+				} else {
+					vector tmp(leestl::move(x), _get_alloc());    // 用本容器的配置器逐个移动元素
+					_move_assign(tmp);
+				}
 			}
 			return *this;
 		}
@@ -159,26 +264,135 @@ namespace leestl {
 		}
 
 		// 迭代器相关操作
-		iterator               begin() noexcept { return start; }
-		const_iterator         begin() const noexcept { return start; }
-		iterator               end() noexcept { return finish; }
-		const_iterator         end() const noexcept { return finish; }
-		reverse_iterator       rbegin() noexcept { return reverse_iterator(finish); }
-		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(finish); }
-		reverse_iterator       rend() noexcept { return reverse_iterator(start); }
-		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(start); }
-		const_iterator         cbegin() const noexcept { return start; }
-		const_iterator         cend() const noexcept { return finish; }
-		const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(finish); }
-		const_reverse_iterator crend() const noexcept { return const_reverse_iterator(start); }
+		iterator               begin() noexcept { return _impl.start; }
+		const_iterator         begin() const noexcept { return _impl.start; }
+		iterator               end() noexcept { return _impl.finish; }
+		const_iterator         end() const noexcept { return _impl.finish; }
+		reverse_iterator       rbegin() noexcept { return reverse_iterator(_impl.finish); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(_impl.finish); }
+		reverse_iterator       rend() noexcept { return reverse_iterator(_impl.start); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(_impl.start); }
+		const_iterator         cbegin() const noexcept { return _impl.start; }
+		const_iterator         cend() const noexcept { return _impl.finish; }
+		const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(_impl.finish); }
+		const_reverse_iterator crend() const noexcept { return const_reverse_iterator(_impl.start); }
 
 		// 容量相关操作
-		bool      empty() const noexcept { return start == finish; }
-		size_type size() const noexcept { return size_type(finish - start); }
+		bool      empty() const noexcept { return _impl.start == _impl.finish; }
+		size_type size() const noexcept { return size_type(_impl.finish - _impl.start); }
 		size_type max_size() const noexcept { return size_type(-1) / sizeof(T); }
-		size_type capacity() const noexcept { return size_type(end_of_storage - start); }
+		size_type capacity() const noexcept { return size_type(_impl.end_of_storage - _impl.start); }
+
+		/**
+		 * @brief 预留至少能容纳 n 个元素的空间，不改变元素个数
+		 *
+		 * @param n 需要的容量
+		 */
+		void reserve(size_type n) {
+			if (n > max_size()) throw std::length_error("vector::reserve");
+			if (capacity() < n) _reallocate(n);
+		}
+
+		/**
+		 * @brief 改变元素个数，新增的元素值初始化
+		 *
+		 * @param n 新的元素个数
+		 */
+		void resize(size_type n) {
+			if (n > size()) _default_append(n - size());
+			else if (n < size()) _erase_at_end(_impl.start + n);
+		}
+
+		/**
+		 * @brief 改变元素个数，新增的元素复制自 value
+		 *
+		 * @param n 新的元素个数
+		 * @param value 新增元素的初始值
+		 */
+		void resize(size_type n, const value_type& value) {
+			if (n > size()) _fill_insert(end(), n - size(), value);
+			else if (n < size()) _erase_at_end(_impl.start + n);
+		}
+
+		// 释放多余的容量，使 capacity() == size()
+		void shrink_to_fit() {
+			if (capacity() != size()) _reallocate(size());
+		}
+
+		// 元素访问相关操作
+		reference       operator[](size_type n) noexcept { return *(_impl.start + n); }
+		const_reference operator[](size_type n) const noexcept { return *(_impl.start + n); }
+
+		reference at(size_type n) {
+			_range_check(n);
+			return (*this)[n];
+		}
+		const_reference at(size_type n) const {
+			_range_check(n);
+			return (*this)[n];
+		}
+
+		reference       front() noexcept { return *begin(); }
+		const_reference front() const noexcept { return *begin(); }
+		reference       back() noexcept { return *(end() - 1); }
+		const_reference back() const noexcept { return *(end() - 1); }
+
+		value_type*       data() noexcept { return _impl.start; }
+		const value_type* data() const noexcept { return _impl.start; }
 
 		// 修改容器相关操作
+		// 尾部插入元素
+		void push_back(const value_type& value) { emplace_back(value); }
+		void push_back(value_type&& value) { emplace_back(leestl::move(value)); }
+
+		/**
+		 * @brief 在尾部直接构造元素，空间不足时在新空间的最终位置构造
+		 *
+		 * @param args 构造参数
+		 * @return reference 新元素的引用
+		 */
+		template <typename... Args>
+		reference emplace_back(Args&&... args) {
+			if (_impl.finish != _impl.end_of_storage) {
+				_alloc_traits::construct(_get_alloc(), _impl.finish, leestl::forward<Args>(args)...);
+				++_impl.finish;
+			} else {
+				_realloc_insert(end(), leestl::forward<Args>(args)...);
+			}
+			return back();
+		}
+
+		// 删除尾部元素
+		void pop_back() noexcept {
+			--_impl.finish;
+			leestl::destory(_impl.finish);
+		}
+
+		/**
+		 * @brief 在 pos 处直接构造元素
+		 *
+		 * @param pos 插入位置
+		 * @param args 构造参数
+		 * @return iterator 新元素的位置
+		 */
+		template <typename... Args>
+		iterator emplace(const_iterator pos, Args&&... args) {
+			const size_type n = pos - cbegin();
+			if (_impl.finish != _impl.end_of_storage) {
+				if (pos == cend()) {
+					_alloc_traits::construct(
+					    _get_alloc(), _impl.finish, leestl::forward<Args>(args)...);
+					++_impl.finish;
+				} else {
+					value_type tmp(leestl::forward<Args>(args)...);    // args 可能引用容器内元素
+					_insert_aux(begin() + n, leestl::move(tmp));
+				}
+			} else {
+				_realloc_insert(begin() + n, leestl::forward<Args>(args)...);
+			}
+			return begin() + n;
+		}
+
 		// 插入元素
 		iterator insert(const_iterator pos, const value_type& value);    // 复制插入
 
@@ -213,36 +427,118 @@ namespace leestl {
 		iterator erase(const_iterator pos);                           // 删除指定位置元素
 		iterator erase(const_iterator first, const_iterator last);    // 删除指定范围元素
 
+		// 交换两个 vector，propagate_on_container_swap 为真时同时交换配置器
 		void swap(vector& x) noexcept {
-			// leestl::swap(start, x.start);
-			// leestl::swap(finish, x.finish);
-			// leestl::swap(end_of_storage, x.end_of_storage);
+			_impl._swap_data(x._impl);
+			if constexpr (_alloc_traits::propagate_on_container_swap::value)
+				leestl::swap(_get_alloc(), x._get_alloc());
 		}
 
-		// void clear() noexcept { _erase_at_end(start); }
+		void clear() noexcept { _erase_at_end(_impl.start); }
 
 	private:
 		// 构造函数用该方法检查初始化长度是否合法
 		static size_type _check_init_len(size_type n) {
 			if (n > size_type(-1) / sizeof(T))
-				std::__throw_length_error("cannot create vector larger than max_size().");
+				throw std::length_error("cannot create vector larger than max_size().");
 			return n;
 		}
 
+		// 通过配置器实例分配、释放空间
+		pointer _allocate(size_type n) {
+			return n != 0 ? _alloc_traits::allocate(_get_alloc(), n) : pointer();
+		}
+
+		void _deallocate(pointer ptr, size_type n) {
+			if (ptr) _alloc_traits::deallocate(_get_alloc(), ptr, n);
+		}
+
+		// 接管 x 的空间，x 置空
+		void _move_assign(vector& x) noexcept {
+			vector tmp(_get_alloc());
+			_impl._swap_data(x._impl);
+			tmp._impl._swap_data(x._impl);
+		}
+
+		void _range_check(size_type n) const {
+			if (n >= size()) throw std::out_of_range("vector::_range_check: n >= size()");
+		}
+
+		// 重新分配大小为 n（不小于 size()）的空间并迁移元素，用于 reserve 与 shrink_to_fit
+		void _reallocate(size_type n) {
+			pointer old_start(_impl.start), old_finish(_impl.finish);
+			pointer new_start = _allocate(n);
+			pointer new_finish;
+			try {
+				new_finish = _migrate(old_start, old_finish, new_start);
+			} catch (...) {
+				_deallocate(new_start, n);
+				throw;
+			}
+			if constexpr (!_use_relocate) leestl::destory(old_start, old_finish);
+			_deallocate(old_start, capacity());
+			_impl.start = new_start;
+			_impl.finish = new_finish;
+			_impl.end_of_storage = new_start + n;
+		}
+
+		// 在尾部追加 n 个值初始化的元素
+		void _default_append(size_type n) {
+			if (size_type(_impl.end_of_storage - _impl.finish) >= n) {
+				_impl.finish = _default_construct_n(_impl.finish, n);
+				return;
+			}
+
+			const size_type len = _check_len(n, "vector::_default_append");
+			const size_type old_size = size();
+			pointer         old_start(_impl.start), old_finish(_impl.finish);
+			pointer         new_start = _allocate(len);
+			pointer         new_finish;
+			try {
+				_default_construct_n(new_start + old_size, n);
+				try {
+					new_finish = _migrate(old_start, old_finish, new_start) + n;
+				} catch (...) {
+					leestl::destory(new_start + old_size, new_start + old_size + n);
+					throw;
+				}
+			} catch (...) {
+				_deallocate(new_start, len);
+				throw;
+			}
+			if constexpr (!_use_relocate) leestl::destory(old_start, old_finish);
+			_deallocate(old_start, capacity());
+			_impl.start = new_start;
+			_impl.finish = new_finish;
+			_impl.end_of_storage = new_start + len;
+		}
+
+		// 在未初始化空间 [first, first + n) 上值初始化元素
+		pointer _default_construct_n(pointer first, size_type n) {
+			pointer curr = first;
+			try {
+				for (; n > 0; --n, ++curr) _alloc_traits::construct(_get_alloc(), curr);
+				return curr;
+			} catch (...) {
+				leestl::destory(first, curr);
+				throw;
+			}
+		}
+
 		// 创建空间
 		void _create_storage(size_type n) {
-			start = data_allocator::allocate(n);
-			finish = start;
-			end_of_storage = start + n;
+			_impl.start = _allocate(n);
+			_impl.finish = _impl.start;
+			_impl.end_of_storage = _impl.start + n;
 		}
 
 		// 适用于输入迭代器的范围初始化
 		template <typename _II>
 		void _range_initialize(_II first, _II last, input_interator_tag) {
 			try {
-				// for (; first != last; ++first) emplace_back(*first);// todo
+				for (; first != last; ++first) emplace_back(*first);
 			} catch (...) {
-				// clear();// todo
+				clear();
 				throw;
 			}
 		}
@@ -252,35 +548,48 @@ namespace leestl {
 		void _range_initialize(_FI first, _FI last, forward_interator_tag) {
 			const size_type n = leestl::distance(first, last);
 			_create_storage(_check_init_len(n));
-			finish = uninitialized_copy(first, last, start);
+			_impl.finish = leestl::uninitialized_copy(first, last, _impl.start);
 		}
 
 		// 重新分配空间时检查剩余空间并计算新空间大小
+		// 新容量由 GrowthPolicy 决定
 		size_type _check_len(size_type n, const char* s) const {
-			if (max_size() - size() < n) std::__throw_length_error(s);
+			if (max_size() - size() < n) throw std::length_error(s);
+
+			const size_type len = GrowthPolicy()(size(), n);
+			if (len < size() + n) return size() + n;    // 自定义策略给出的容量不足时按需分配
+			return len > max_size() ? max_size() : len;
+		}
+
+		// 重新分配空间时能否直接迁移（移动并析构）旧元素：迁移过程必须不抛出异常
+		static constexpr bool _use_relocate = leestl::is_trivially_relocatable<T>::value ||
+		                                      std::is_nothrow_move_constructible<T>::value;
 
-			const size_type len = size() + leestl::max(size(), n);
-			return (len < size() || len > max_size()) ? max_size() : len;
+		// 重新分配空间时把旧元素转移到新空间：可迁移时移动并析构（可平凡重定位时整段 memcpy），
+		// 否则复制以保证强异常安全，旧元素由调用者在全部成功后析构
+		static pointer _migrate(pointer first, pointer last, pointer result) {
+			if constexpr (_use_relocate) return leestl::relocate(first, last, result);
+			else return leestl::uninitialized_copy(first, last, result);
 		}
 
 		// 重新分配空间并复制元素
 		template <typename _FI>
 		pointer _alloc_and_copy(size_type n, _FI first, _FI last) {
-			pointer result = data_allocator::allocate(n);
+			pointer result = _allocate(n);
 			try {
 				leestl::uninitialized_copy(first, last, result);
 				return result;
 			} catch (...) {
-				data_allocator::deallocate(result, n);
+				_deallocate(result, n);
 				throw;
 			}
 		}
 
 		// 从 pos 处开始擦除元素
 		void _erase_at_end(pointer pos) {
-			if (size_type n = finish - pos) {
-				leestl::destory(pos, finish);
-				finish = pos;
+			if (size_type n = _impl.finish - pos) {
+				leestl::destory(pos, _impl.finish);
+				_impl.finish = pos;
 				// shrink_to_fit();
 			}
 		}
@@ -288,10 +597,10 @@ namespace leestl {
 		// 在 pos 处插入元素
 		template <typename _Arg>
 		void _insert_aux(iterator pos, _Arg&& arg) {
-			if (finish != end_of_storage) {
-				leestl::construct(leestl::address_of(*finish), leestl::move(*(finish - 1)));
-				++finish;
-				leestl::move_backward(pos, finish - 2, finish - 1);
+			if (_impl.finish != _impl.end_of_storage) {
+				leestl::construct(leestl::address_of(*_impl.finish), leestl::move(*(_impl.finish - 1)));
+				++_impl.finish;
+				leestl::move_backward(pos, _impl.finish - 2, _impl.finish - 1);
 				*pos = leestl::forward<_Arg>(arg);
 			} else {
 				_realloc_insert(pos, leestl::forward<_Arg>(arg));
@@ -304,7 +613,7 @@ namespace leestl {
 			if (pos == end()) {
 				for (; first != last; ++first) insert(end(), *first);
 			} else if (first != last) {
-				vector tmp(first, last);
+				vector tmp(first, last, get_allocator());
 				insert(pos, tmp.begin(), tmp.end());
 			}
 		}
@@ -314,47 +623,53 @@ namespace leestl {
 		void _range_insert(iterator pos, _FI first, _FI last, leestl::forward_interator_tag) {
 			if (first != last) {
 				const size_type n = leestl::distance(first, last);
-				if (size_type(end_of_storage - finish) >= n) {     // 空间足够
-					const size_type elems_after = finish - pos;    // pos 后的元素个数
-					pointer         old_finish(finish);
-					if (elems_after > n) {    // pos 到 finish 的空间足够容纳 n 个元素
-						finish = leestl::uninitialized_move(
-						    finish - n, finish,
-						    finish);    // 将后 n 个元素移动到未初始化的finish后面
+				if (size_type(_impl.end_of_storage - _impl.finish) >= n) {     // 空间足够
+					const size_type elems_after = _impl.finish - pos;    // pos 后的元素个数
+					pointer         old_finish(_impl.finish);
+					if (elems_after > n) {    // pos 到 _impl.finish 的空间足够容纳 n 个元素
+						_impl.finish = leestl::uninitialized_move(
+						    _impl.finish - n, _impl.finish,
+						    _impl.finish);    // 将后 n 个元素移动到未初始化的finish后面
 						leestl::move_backward(
 						    pos, old_finish - n,
 						    old_finish);    // 将剩余需要后移的元素移动到 old_finish 前面
 						leestl::copy(first, last, pos);    // 将新的 n 个元素插入到 pos 后面
-					} else {    // pos 到 finish 的空间不足容纳 n 个元素
+					} else {    // pos 到 _impl.finish 的空间不足容纳 n 个元素
 						_FI mid = first;
 						leestl::advance(mid, elems_after);
-						finish = uninitialized_copy(mid, last, finish);
-						finish = uninitialized_move(pos, old_finish, finish);
+						_impl.finish = leestl::uninitialized_copy(mid, last, _impl.finish);
+						_impl.finish = leestl::uninitialized_move(pos, old_finish, _impl.finish);
 						leestl::copy(first, mid, pos);
 					}
 				} else {
-					pointer old_start(start), old_finish(finish);
+					pointer old_start(_impl.start), old_finish(_impl.finish);
 
 					const size_type len = _check_len(n, "size of vector is too big.");
+					const size_type elems_before = pos - old_start;
 
-					pointer new_start = data_allocator::allocate(len);
+					pointer new_start = _allocate(len);
 					pointer new_finish(new_start);
 
 					try {
-						new_finish = leestl::uninitialized_move(old_start, pos, new_finish);
-						new_finish = leestl::uninitialized_copy(first, last, new_finish);
-						new_finish = leestl::uninitialized_move(pos, old_finish, new_finish);
+						// 先构造插入的元素，再迁移旧元素
+						leestl::uninitialized_copy(first, last, new_start + elems_before);
+						new_finish = pointer();
+						new_finish = _migrate(old_start, pos, new_start);
+						new_finish += n;
+						new_finish = _migrate(pos, old_finish, new_finish);
 					} catch (...) {
-						leestl::destory(new_start, new_finish);
-						data_allocator::deallocate(new_start, len);
+						if (!new_finish)
+							leestl::destory(new_start + elems_before, new_start + elems_before + n);
+						else leestl::destory(new_start, new_finish);
+						_deallocate(new_start, len);
 						throw;
 					}
 
-					leestl::destory(old_start, old_finish);
-					data_allocator::deallocate(old_start, capacity());
-					start = new_start;
-					finish = new_finish;
-					end_of_storage = new_start + len;
+					if constexpr (!_use_relocate) leestl::destory(old_start, old_finish);
+					_deallocate(old_start, capacity());
+					_impl.start = new_start;
+					_impl.finish = new_finish;
+					_impl.end_of_storage = new_start + len;
 				}
 			}
 		}
@@ -362,8 +677,8 @@ namespace leestl {
 		// 适用于输入迭代器的 vector 赋值
 		template <typename _II>
 		void _assign_aux(_II first, _II last, leestl::input_interator_tag) {
-			pointer cur = start;
-			for (; first != last && cur != finish; ++cur, (void)++first) *cur = *first;
+			pointer cur = _impl.start;
+			for (; first != last && cur != _impl.finish; ++cur, (void)++first) *cur = *first;
 			if (first == last) _erase_at_end(cur);
 			else _range_insert(end(), first, last, leestl::iterator_category_types<_II>());
 		}
@@ -374,17 +689,17 @@ namespace leestl {
 			const size_type len = leestl::distance(first, last);
 			if (len > capacity()) {
 				pointer new_start = _alloc_and_copy(len, first, last);
-				leestl::destory(start, finish);
-				data_allocator::deallocate(start, capacity());
-				start = new_start;
-				end_of_storage = finish = start + len;
+				leestl::destory(_impl.start, _impl.finish);
+				_deallocate(_impl.start, capacity());
+				_impl.start = new_start;
+				_impl.end_of_storage = _impl.finish = _impl.start + len;
 			} else if (size() >= len) {
-				_erase_at_end(leestl::copy(first, last, start));
+				_erase_at_end(leestl::copy(first, last, _impl.start));
 			} else {
 				_FI mid = first;
 				leestl::advance(mid, size());
-				leestl::copy(first, mid, start);
-				finish = uninitialized_copy(mid, last, finish);
+				leestl::copy(first, mid, _impl.start);
+				_impl.finish = leestl::uninitialized_copy(mid, last, _impl.finish);
 			}
 		}
 
@@ -395,47 +710,47 @@ namespace leestl {
 		// 在 pos 处插入右值
 		iterator _insert_rval(const_iterator pos, value_type&& value) {
 			const size_type n = pos - cbegin();
-			if (finish != end_of_storage) {
+			if (_impl.finish != _impl.end_of_storage) {
 				if (pos == cend()) {
-					data_allocator::construct(leestl::address_of(*finish), leestl::move(value));
-					++finish;
+					_alloc_traits::construct(_get_alloc(), leestl::address_of(*_impl.finish), leestl::move(value));
+					++_impl.finish;
 				} else {
-					_insert_aux(begin + n, leestl::move(value));
+					_insert_aux(begin() + n, leestl::move(value));
 				}
 			} else _realloc_insert(begin() + n, leestl::move(value));
 
-			return iterator(start + n);
+			return iterator(_impl.start + n);
 		}
 
 		// 填充插入
 		void _fill_insert(iterator _pos, size_type _n, const value_type& _x) {
 			if (_n != 0) {
-				if (size_type(end_of_storage - finish) >= _n) {    // 空间足够
+				if (size_type(_impl.end_of_storage - _impl.finish) >= _n) {    // 空间足够
 					const size_type _elems_after = end() - _pos;
 					value_type      _x_copy = _x;
-					pointer         _old_finish(finish);
+					pointer         _old_finish(_impl.finish);
 					if (_elems_after > _n) {
-						finish = uninitialized_move(finish - _n, finish, finish);
+						_impl.finish = leestl::uninitialized_move(_impl.finish - _n, _impl.finish, _impl.finish);
 						leestl::move_backward(_pos, _old_finish - _n, _old_finish);
 						leestl::fill(_pos, _pos + _n, _x_copy);
 					} else {
-						leestl::uninitialized_fill_n(finish, _n - _elems_after, _x_copy);
-						finish += _n - _elems_after;
-						finish = leestl::uninitialized_move(_pos, _old_finish, finish);
+						leestl::uninitialized_fill_n(_impl.finish, _n - _elems_after, _x_copy);
+						_impl.finish += _n - _elems_after;
+						_impl.finish = leestl::uninitialized_move(_pos, _old_finish, _impl.finish);
 						leestl::fill(_pos, _old_finish, _x_copy);
 					}
 				} else {
 					const size_type _new_len = _check_len(_n, "size of vector is too big.");
-					const size_type _elems_before = _pos - start;
+					const size_type _elems_before = _pos - _impl.start;
 
-					pointer _new_start = data_allocator::allocate(_new_len);
-					pointer _old_start(start), _old_finish(finish), _new_finish(_new_start);
+					pointer _new_start = _allocate(_new_len);
+					pointer _old_start(_impl.start), _old_finish(_impl.finish), _new_finish(_new_start);
 					try {
 						leestl::uninitialized_fill_n(_new_start + _elems_before, _n, _x);
 						_new_finish = pointer();
-						_new_finish = leestl::uninitialized_move(_old_start, _pos, _new_start);
+						_new_finish = _migrate(_old_start, _pos, _new_start);
 						_new_finish += _n;
-						_new_finish = leestl::uninitialized_move(_pos, _old_finish, _new_finish);
+						_new_finish = _migrate(_pos, _old_finish, _new_finish);
 					} catch (...) {
 						if (!_new_finish) {
 							leestl::destory(
@@ -443,54 +758,55 @@ namespace leestl {
 						} else {
 							leestl::destory(_new_start, _new_finish);
 						}
-						data_allocator::deallocate(_new_start, _new_len);
+						_deallocate(_new_start, _new_len);
 						throw;
 					}
-					leestl::destory(_old_start, _old_finish);
-					data_allocator::deallocate(_old_start, capacity());
-					start = _new_start;
-					finish = _new_finish;
-					end_of_storage = _new_start + _new_len;
+					if constexpr (!_use_relocate) leestl::destory(_old_start, _old_finish);
+					_deallocate(_old_start, capacity());
+					_impl.start = _new_start;
+					_impl.finish = _new_finish;
+					_impl.end_of_storage = _new_start + _new_len;
 				}
 			}
 		}
 	};
 
-	template <typename T>
+	template <typename T, typename Alloc, typename GrowthPolicy>
 	template <typename... Args>
-	void vector<T>::_realloc_insert(iterator pos, Args&&... args) {
+	void vector<T, Alloc, GrowthPolicy>::_realloc_insert(iterator pos, Args&&... args) {
 		const size_type new_len = _check_len(size_type(1), "size of vector is to big.");
-		const size_type old_size = pos - start;
+		const size_type elems_before = pos - _impl.start;
 
-		pointer new_start = data_allocator::allocate(new_len);    // 分配新空间
-		pointer old_start(start), old_finish(finish), new_finish(new_start);
+		pointer new_start = _allocate(new_len);    // 分配新空间
+		pointer old_start(_impl.start), old_finish(_impl.finish), new_finish(new_start);
 		try {
-			new_finish =
-			    leestl::relocate(old_start, pos, new_start);    // 移动并析构 pos 前的旧对象
-			data_allocator::construct(
-			    leestl::address_of(new_finish),
-			    leestl::forward<Args>(args)...);    // 在 pos 构造对象；
+			// 先在最终位置构造新对象，args 可能引用旧空间中的元素
+			_alloc_traits::construct(
+			    _get_alloc(), new_start + elems_before, leestl::forward<Args>(args)...);
+			new_finish = pointer();
+			new_finish = _migrate(old_start, pos, new_start);
 			++new_finish;
-			new_finish =
-			    leestl::relocate(pos, old_finish, new_finish);    // 移动并析构 pos 后的旧对象
+			new_finish = _migrate(pos, old_finish, new_finish);
 		} catch (...) {
-			leestl::destory(new_start, new_finish);
-			data_allocator::deallocate(new_start, new_len);
+			if (!new_finish) leestl::destory(new_start + elems_before);
+			else leestl::destory(new_start, new_finish);
+			_deallocate(new_start, new_len);
 			throw;
 		}
-		data_allocator::deallocate(old_start, old_size);    // 释放旧空间
-		start = new_start;
-		finish = new_finish;
-		end_of_storage = new_start + new_len;
+		if constexpr (!_use_relocate) leestl::destory(old_start, old_finish);
+		_deallocate(old_start, capacity());    // 释放旧空间
+		_impl.start = new_start;
+		_impl.finish = new_finish;
+		_impl.end_of_storage = new_start + new_len;
 	}
 
-	template <typename T>
-	typename vector<T>::iterator vector<T>::insert(const_iterator pos, const value_type& value) {
-		const size_type n = pos - start;
-		if (finish != end_of_storage) {
+	template <typename T, typename Alloc, typename GrowthPolicy>
+	typename vector<T, Alloc, GrowthPolicy>::iterator vector<T, Alloc, GrowthPolicy>::insert(const_iterator pos, const value_type& value) {
+		const size_type n = pos - _impl.start;
+		if (_impl.finish != _impl.end_of_storage) {
 			if (pos == end()) {
-				data_allocator::construct(leestl::address_of(*finish), value);
-				++finish;
+				_alloc_traits::construct(_get_alloc(), leestl::address_of(*_impl.finish), value);
+				++_impl.finish;
 			} else {
 				const auto _pos = begin() + (pos - cbegin());
 				auto       value_copy = value;
@@ -498,24 +814,38 @@ namespace leestl {
 			}
 		} else _realloc_insert(begin() + (pos - cbegin()), value);
 
-		return iterator(start + n);
+		return iterator(_impl.start + n);
 	}
 
-	template <typename T>
-	typename vector<T>::iterator vector<T>::erase(const_iterator _pos) {
-		if (_pos + 1 != end()) leestl::move(_pos + 1, end(), _pos);
-		--finish;
-		leestl::destory(leestl::address_of(*finish));
-		return iterator(_pos);
+	template <typename T, typename Alloc, typename GrowthPolicy>
+	typename vector<T, Alloc, GrowthPolicy>::iterator vector<T, Alloc, GrowthPolicy>::erase(const_iterator _pos) {
+		iterator pos = begin() + (_pos - cbegin());
+		if (pos + 1 != end()) leestl::move(pos + 1, end(), pos);
+		--_impl.finish;
+		leestl::destory(leestl::address_of(*_impl.finish));
+		return pos;
 	}
 
-	template <typename T>
-	typename vector<T>::iterator vector<T>::erase(const_iterator _first, const_iterator _last) {
-		if (_first != _last) {
-			if (_last != end()) leestl::move(_last, end(), _first);
-			_erase_at_end(start + (end() - _last));
+	template <typename T, typename Alloc, typename GrowthPolicy>
+	typename vector<T, Alloc, GrowthPolicy>::iterator vector<T, Alloc, GrowthPolicy>::erase(
+	    const_iterator _first, const_iterator _last) {
+		iterator first = begin() + (_first - cbegin()), last = begin() + (_last - cbegin());
+		if (first != last) {
+			if (last != end()) leestl::move(last, end(), first);
+			_erase_at_end(first + (end() - last));
 		}
-		return iterator(_first);
+		return first;
+	}
+
+	// vector 只持有指向堆空间的指针，配置器可平凡重定位时 vector 本身也可平凡重定位
+	template <typename T, typename Alloc, typename GrowthPolicy>
+	struct is_trivially_relocatable<vector<T, Alloc, GrowthPolicy>>
+	    : is_trivially_relocatable<typename vector<T, Alloc, GrowthPolicy>::data_allocator> {};
+
+	template <typename T, typename Alloc, typename GrowthPolicy>
+	inline void swap(
+	    vector<T, Alloc, GrowthPolicy>& x, vector<T, Alloc, GrowthPolicy>& y) noexcept {
+		x.swap(y);
 	}
 
 }    // namespace leestl